@@ -30,6 +30,9 @@
 #include <float.h>
 #include <vector>
 #include <type_traits>
+#include <algorithm>
+#include <functional>
+#include <cmath>
 
 #include "../../Platforms/interface/PlatformDefinitions.h"
 #include "../../Primitives/interface/FlagEnum.h"
@@ -1250,6 +1253,10 @@ bool CheckLineSectionOverlap(T Min0, T Max0, T Min1, T Max1)
 ///
 ///             The function does not check if the polygon is simple, e.g.
 ///             that it does not self-intersect.
+///
+///             Reflex vertices are binned into a uniform grid, so that ear tests
+///             only visit vertices near the candidate triangle. This keeps the
+///             triangulation of large polygons close to O(n log n).
 template <typename IndexType, typename ComponentType>
 std::vector<IndexType> TriangulatePolygon(const std::vector<Vector2<ComponentType>>& Polygon, bool VerifyEarAndConvexVerts = true)
 {
@@ -1309,9 +1316,14 @@ std::vector<IndexType> TriangulatePolygon(const std::vector<Vector2<ComponentTyp
         return {};
     }
 
-    std::vector<int> RemainingVertIds(VertCount);
+    // Remaining vertices form a doubly-linked list that preserves the original vertex order.
+    std::vector<int> PrevVert(VertCount);
+    std::vector<int> NextVert(VertCount);
     for (int i = 0; i < VertCount; ++i)
-        RemainingVertIds[i] = i;
+    {
+        PrevVert[i] = WrapIndex(i - 1, VertCount);
+        NextVert[i] = WrapIndex(i + 1, VertCount);
+    }
 
     //        Reflex
     //   Ear.   |   .Ear
@@ -1330,28 +1342,93 @@ std::vector<IndexType> TriangulatePolygon(const std::vector<Vector2<ComponentTyp
     };
     std::vector<VertexType> VertTypes(VertCount);
 
-    auto CheckConvex = [&](int vert_id) {
-        const auto RemainingVertCount = static_cast<int>(RemainingVertIds.size());
-
-        const auto Idx0 = RemainingVertIds[WrapIndex(vert_id - 1, RemainingVertCount)];
-        const auto Idx1 = RemainingVertIds[WrapIndex(vert_id + 0, RemainingVertCount)];
-        const auto Idx2 = RemainingVertIds[WrapIndex(vert_id + 1, RemainingVertCount)];
-
-        const auto& V0 = Polygon[Idx0];
+    auto CheckConvex = [&](int Idx1) {
+        const auto& V0 = Polygon[PrevVert[Idx1]];
         const auto& V1 = Polygon[Idx1];
-        const auto& V2 = Polygon[Idx2];
+        const auto& V2 = Polygon[NextVert[Idx1]];
 
-        return GetWinding(V0, V1, V2) * PolygonWinding < 0 ?
+        // Compare signs rather than multiplying the windings, which may overflow for integer types
+        const auto Winding = GetWinding(V0, V1, V2);
+        return (Winding < 0 && PolygonWinding > 0) || (Winding > 0 && PolygonWinding < 0) ?
             VertexType::Reflex :
             VertexType::Convexx;
     };
 
-    auto CheckEar = [&](int vert_id) {
-        const auto RemainingVertCount = static_cast<int>(RemainingVertIds.size());
+    // First label vertices as reflex or convex
+    int ReflexVertCount = 0;
+    for (int i = 0; i < VertCount; ++i)
+    {
+        VertTypes[i] = CheckConvex(i);
+        if (VertTypes[i] == VertexType::Reflex)
+            ++ReflexVertCount;
+    }
 
-        const auto Idx0 = RemainingVertIds[WrapIndex(vert_id - 1, RemainingVertCount)];
-        const auto Idx1 = RemainingVertIds[WrapIndex(vert_id + 0, RemainingVertCount)];
-        const auto Idx2 = RemainingVertIds[WrapIndex(vert_id + 1, RemainingVertCount)];
+    // Only reflex vertices may lie inside an ear. Since clipping an ear never turns a convex
+    // vertex into a reflex one, reflex vertices are binned into a uniform grid once, so that
+    // the ear test only needs to look at the cells overlapped by the triangle. Vertices that
+    // stop being reflex are skipped by the test.
+    double GridMinX = static_cast<double>(Polygon[0].x);
+    double GridMinY = static_cast<double>(Polygon[0].y);
+    double GridMaxX = GridMinX;
+    double GridMaxY = GridMinY;
+    for (const auto& Vert : Polygon)
+    {
+        GridMinX = (std::min)(GridMinX, static_cast<double>(Vert.x));
+        GridMinY = (std::min)(GridMinY, static_cast<double>(Vert.y));
+        GridMaxX = (std::max)(GridMaxX, static_cast<double>(Vert.x));
+        GridMaxY = (std::max)(GridMaxY, static_cast<double>(Vert.y));
+    }
+    // Non-collinear polygon always has non-degenerate bounds
+    VERIFY_EXPR(GridMaxX > GridMinX && GridMaxY > GridMinY);
+    const double GridWidth  = (std::max)(GridMaxX - GridMinX, DBL_MIN);
+    const double GridHeight = (std::max)(GridMaxY - GridMinY, DBL_MIN);
+
+    // Aim at about two reflex vertices per cell and keep the cells roughly square
+    const double TargetCellCount = (std::max)(ReflexVertCount / 2, 1);
+    const int    GridDimX        = static_cast<int>((std::min)((std::max)(std::sqrt(TargetCellCount * GridWidth / GridHeight), 1.0), TargetCellCount));
+    const int    GridDimY        = static_cast<int>((std::max)(TargetCellCount / GridDimX, 1.0));
+    const double CellScaleX      = GridDimX / GridWidth;
+    const double CellScaleY      = GridDimY / GridHeight;
+
+    auto GetCellX = [&](double x) {
+        return (std::max)((std::min)(static_cast<int>((x - GridMinX) * CellScaleX), GridDimX - 1), 0);
+    };
+    auto GetCellY = [&](double y) {
+        return (std::max)((std::min)(static_cast<int>((y - GridMinY) * CellScaleY), GridDimY - 1), 0);
+    };
+
+    // Reflex vertices of cell i are GridCellVerts[GridCellStart[i]] ... GridCellVerts[GridCellEnd[i] - 1].
+    // Vertices that are no longer reflex are moved past the end of the range when they are encountered.
+    std::vector<int> GridCellStart(static_cast<size_t>(GridDimX) * GridDimY + 1);
+    std::vector<int> GridCellVerts(ReflexVertCount);
+    {
+        std::vector<int> VertCells(VertCount);
+        for (int i = 0; i < VertCount; ++i)
+        {
+            if (VertTypes[i] != VertexType::Reflex)
+                continue;
+            VertCells[i] = GetCellX(static_cast<double>(Polygon[i].x)) + GetCellY(static_cast<double>(Polygon[i].y)) * GridDimX;
+            ++GridCellStart[VertCells[i] + 1];
+        }
+        for (size_t i = 1; i < GridCellStart.size(); ++i)
+            GridCellStart[i] += GridCellStart[i - 1];
+
+        std::vector<int> CellOffsets{GridCellStart.begin(), GridCellStart.end() - 1};
+        for (int i = 0; i < VertCount; ++i)
+        {
+            if (VertTypes[i] == VertexType::Reflex)
+                GridCellVerts[CellOffsets[VertCells[i]]++] = i;
+        }
+    }
+    std::vector<int> GridCellEnd{GridCellStart.begin() + 1, GridCellStart.end()};
+
+    // Vertices that become reflex after the grid has been built. This may only
+    // happen for degenerate or self-intersecting polygons.
+    std::vector<int> LateReflexVerts;
+
+    auto CheckEar = [&](int Idx1) {
+        const auto Idx0 = PrevVert[Idx1];
+        const auto Idx2 = NextVert[Idx1];
 
         VERIFY_EXPR(VertTypes[Idx1] == VertexType::Convexx);
 
@@ -1359,101 +1436,198 @@ std::vector<IndexType> TriangulatePolygon(const std::vector<Vector2<ComponentTyp
         const auto& V1 = Polygon[Idx1];
         const auto& V2 = Polygon[Idx2];
 
-        for (const auto Idx : RemainingVertIds)
+        auto IsReflexVertInside = [&](int Idx) {
+            if (VertTypes[Idx] != VertexType::Reflex || Idx == Idx0 || Idx == Idx2)
+                return false;
+
+            // Do not treat vertices exactly on the edge as inside the triangle,
+            // so that we can clip out degenerate triangles.
+            return IsPointInsideTriangle(V0, V1, V2, Polygon[Idx], /*AllowEdges = */ false);
+        };
+
+        const double TriX[] = {static_cast<double>(V0.x), static_cast<double>(V1.x), static_cast<double>(V2.x)};
+        const double TriY[] = {static_cast<double>(V0.y), static_cast<double>(V1.y), static_cast<double>(V2.y)};
+
+        // Long thin triangles are common, so rather than visiting all cells in the triangle's
+        // bounding box, compute the triangle's x extent within each row of cells.
+        // Slabs are slightly extended to be conservative with respect to rounding.
+        const double CellPadY = 1e-6 / CellScaleY;
+        const double CellPadX = 1e-6 / CellScaleX;
+
+        const auto CellY0 = GetCellY((std::min)((std::min)(TriY[0], TriY[1]), TriY[2]));
+        const auto CellY1 = GetCellY((std::max)((std::max)(TriY[0], TriY[1]), TriY[2]));
+        for (int y = CellY0; y <= CellY1; ++y)
         {
-            if (Idx == Idx0 || Idx == Idx1 || Idx == Idx2)
-                continue;
+            const double SlabY0 = GridMinY + y / CellScaleY - CellPadY;
+            const double SlabY1 = GridMinY + (y + 1) / CellScaleY + CellPadY;
 
-            if (VertTypes[Idx] == VertexType::Convexx || VertTypes[Idx] == VertexType::Ear)
+            double SpanX0 = +DBL_MAX;
+            double SpanX1 = -DBL_MAX;
+            for (int e = 0; e < 3; ++e)
             {
-                if (VerifyEarAndConvexVerts)
+                const double Ax = TriX[e];
+                const double Ay = TriY[e];
+                const double Bx = TriX[(e + 1) % 3];
+                const double By = TriY[(e + 1) % 3];
+
+                // Clip the edge against the slab
+                double t0 = 0;
+                double t1 = 1;
+                if (Ay != By)
                 {
-                    // This check may fail due to floating point imprecision if there are collinear vertices.
-                    // Fix your polygon or disable the check.
-                    VERIFY(!IsPointInsideTriangle(V0, V1, V2, Polygon[Idx], /*AllowEdges = */ false), "Convex and ear vertices must always be outside the triangle");
+                    const double tA = (SlabY0 - Ay) / (By - Ay);
+                    const double tB = (SlabY1 - Ay) / (By - Ay);
+                    t0              = (std::max)(t0, (std::min)(tA, tB));
+                    t1              = (std::min)(t1, (std::max)(tA, tB));
                 }
-                continue;
+                else if (Ay < SlabY0 || Ay > SlabY1)
+                {
+                    continue;
+                }
+                if (t0 > t1)
+                    continue;
+
+                const double X0 = Ax + (Bx - Ax) * t0;
+                const double X1 = Ax + (Bx - Ax) * t1;
+                SpanX0          = (std::min)(SpanX0, (std::min)(X0, X1));
+                SpanX1          = (std::max)(SpanX1, (std::max)(X0, X1));
             }
+            if (SpanX0 > SpanX1)
+                continue;
 
-            // Do not treat vertices exactly on the edge as inside the triangle,
-            // so that we can clip out degenerate triangles.
-            if (IsPointInsideTriangle(V0, V1, V2, Polygon[Idx], /*AllowEdges = */ false))
+            const auto CellX0 = GetCellX(SpanX0 - CellPadX);
+            const auto CellX1 = GetCellX(SpanX1 + CellPadX);
+            for (int x = CellX0; x <= CellX1; ++x)
             {
-                // The vertex is inside the triangle
+                const auto Cell = x + y * GridDimX;
+                for (int i = GridCellStart[Cell]; i < GridCellEnd[Cell];)
+                {
+                    const auto Idx = GridCellVerts[i];
+                    if (VertTypes[Idx] != VertexType::Reflex)
+                    {
+                        // Reflex vertex that became convex will never become reflex again
+                        std::swap(GridCellVerts[i], GridCellVerts[--GridCellEnd[Cell]]);
+                        continue;
+                    }
+                    if (IsReflexVertInside(Idx))
+                        return VertexType::Convexx;
+                    ++i;
+                }
+            }
+        }
+
+        for (const auto Idx : LateReflexVerts)
+        {
+            if (NextVert[Idx] >= 0 && IsReflexVertInside(Idx))
                 return VertexType::Convexx;
+        }
+
+#ifdef DILIGENT_DEBUG
+        // Convex and ear vertices may only be inside triangles that contain reflex vertices
+        if (VerifyEarAndConvexVerts)
+        {
+            for (int Idx = NextVert[Idx2]; Idx != Idx0; Idx = NextVert[Idx])
+            {
+                // This check may fail due to floating point imprecision if there are collinear vertices.
+                // Fix your polygon or disable the check.
+                VERIFY(VertTypes[Idx] == VertexType::Reflex || !IsPointInsideTriangle(V0, V1, V2, Polygon[Idx], /*AllowEdges = */ false),
+                       "Convex and ear vertices must always be outside the triangle");
             }
         }
+#endif
 
         return VertexType::Ear;
     };
 
-    // First label vertices as reflex or convex
-    for (int vert_id = 0; vert_id < VertCount; ++vert_id)
-    {
-        VertTypes[vert_id] = CheckConvex(vert_id);
-    }
+    // Ears are clipped in the order of their indices. The heap may contain
+    // stale entries that are skipped when they reach the top.
+    std::vector<int> Ears;
+    auto             PushEar = [&Ears](int Idx) {
+        Ears.push_back(Idx);
+        std::push_heap(Ears.begin(), Ears.end(), std::greater<int>{});
+    };
 
     // Next, check convex vertices for ears
-    for (int vert_id = 0; vert_id < VertCount; ++vert_id)
+    for (int i = 0; i < VertCount; ++i)
     {
-        auto& VertType = VertTypes[vert_id];
+        auto& VertType = VertTypes[i];
         if (VertType == VertexType::Convexx)
-            VertType = CheckEar(vert_id);
+        {
+            VertType = CheckEar(i);
+            if (VertType == VertexType::Ear)
+                PushEar(i);
+        }
     }
 
+    auto UpdateVertType = [&](int Idx) {
+        const auto PrevType = VertTypes[Idx];
+
+        VertTypes[Idx] = CheckConvex(Idx);
+        if (VertTypes[Idx] == VertexType::Convexx)
+        {
+            VertTypes[Idx] = CheckEar(Idx);
+            if (VertTypes[Idx] == VertexType::Ear)
+                PushEar(Idx);
+        }
+        else if (PrevType != VertexType::Reflex)
+        {
+            LateReflexVerts.push_back(Idx);
+        }
+    };
+
     std::vector<IndexType> Triangles;
     Triangles.reserve(TriangleCount * 3);
 
     // Clip ears one by one until only three vertices are left
-    while (RemainingVertIds.size() > 3)
+    int RemainingVertCount = VertCount;
+    int LastVert           = 0;
+    while (RemainingVertCount > 3)
     {
-        auto RemainingVertCount = static_cast<int>(RemainingVertIds.size());
-
-        // Find the first ear
-        int ear_vert_id = 0;
-        for (; ear_vert_id < RemainingVertCount; ++ear_vert_id)
+        // Find the ear with the smallest index
+        int Idx1 = -1;
+        while (!Ears.empty() && Idx1 < 0)
         {
-            const auto Idx = RemainingVertIds[ear_vert_id];
-            if (VertTypes[Idx] == VertexType::Ear)
-                break;
-        };
+            std::pop_heap(Ears.begin(), Ears.end(), std::greater<int>{});
+            const auto Idx = Ears.back();
+            Ears.pop_back();
+            // Skip clipped vertices and vertices that are no longer ears
+            if (NextVert[Idx] >= 0 && VertTypes[Idx] == VertexType::Ear)
+                Idx1 = Idx;
+        }
 
-        if (ear_vert_id == RemainingVertCount)
+        if (Idx1 < 0)
         {
             UNEXPECTED("Failed to find an ear.");
             return {};
         }
 
-        const auto Idx0 = RemainingVertIds[WrapIndex(ear_vert_id - 1, RemainingVertCount)];
-        const auto Idx1 = RemainingVertIds[ear_vert_id];
-        const auto Idx2 = RemainingVertIds[WrapIndex(ear_vert_id + 1, RemainingVertCount)];
+        const auto Idx0 = PrevVert[Idx1];
+        const auto Idx2 = NextVert[Idx1];
+
+        Triangles.emplace_back(static_cast<IndexType>(Idx0));
+        Triangles.emplace_back(static_cast<IndexType>(Idx1));
+        Triangles.emplace_back(static_cast<IndexType>(Idx2));
 
-        Triangles.emplace_back(Idx0);
-        Triangles.emplace_back(Idx1);
-        Triangles.emplace_back(Idx2);
-        RemainingVertIds.erase(RemainingVertIds.begin() + ear_vert_id);
+        NextVert[Idx0] = Idx2;
+        PrevVert[Idx2] = Idx0;
+        NextVert[Idx1] = -1;
+        PrevVert[Idx1] = -1;
+        LastVert       = Idx0;
 
         --RemainingVertCount;
         // Update adjacent vertices
         if (RemainingVertCount > 3)
         {
-            const auto IdxL = RemainingVertIds[WrapIndex(ear_vert_id - 1, RemainingVertCount)];
-            const auto IdxR = RemainingVertIds[WrapIndex(ear_vert_id, RemainingVertCount)];
-            // First check for convex vs reflex
-            VertTypes[IdxL] = CheckConvex(ear_vert_id - 1);
-            VertTypes[IdxR] = CheckConvex(ear_vert_id);
-
-            // Next, check for ears
-            if (VertTypes[IdxL] == VertexType::Convexx)
-                VertTypes[IdxL] = CheckEar(ear_vert_id - 1);
-            if (VertTypes[IdxR] == VertexType::Convexx)
-                VertTypes[IdxR] = CheckEar(ear_vert_id);
+            UpdateVertType(Idx0);
+            UpdateVertType(Idx2);
         }
     }
 
-    Triangles.emplace_back(RemainingVertIds[0]);
-    Triangles.emplace_back(RemainingVertIds[1]);
-    Triangles.emplace_back(RemainingVertIds[2]);
+    // Output the last triangle starting with the smallest index
+    const int Idx0 = (std::min)((std::min)(LastVert, NextVert[LastVert]), PrevVert[LastVert]);
+    Triangles.emplace_back(static_cast<IndexType>(Idx0));
+    Triangles.emplace_back(static_cast<IndexType>(NextVert[Idx0]));
+    Triangles.emplace_back(static_cast<IndexType>(NextVert[NextVert[Idx0]]));
 
     return Triangles;
 }
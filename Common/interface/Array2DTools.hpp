@@ -29,11 +29,15 @@
 /// \file
 /// 2D array processing utilities.
 
+#include <vector>
+
 #include "../../Primitives/interface/BasicTypes.h"
 
 namespace Diligent
 {
 
+class IThreadPool;
+
 /// Computes the minimum and the maximum value in a 2D floating-point array
 
 /// \param[in]  pData		   - A pointer to the array data.
@@ -42,11 +46,69 @@ namespace Diligent
 /// \param[in]  Height		   - 2D array height.
 /// \param[out] MinValue	   - Minimum value.
 /// \param[out] MaxValue	   - Maximum value.
+/// \param[in]  pThreadPool    - Optional thread pool to process the rows in parallel.
 void GetArray2DMinMaxValue(const float* pData,
                            size_t       StrideInFloats,
                            Uint32       Width,
                            Uint32       Height,
                            float&       MinValue,
-                           float&       MaxValue);
+                           float&       MaxValue,
+                           IThreadPool* pThreadPool = nullptr);
+
+
+/// Hierarchical min/max pyramid of a 2D floating-point array, e.g. a terrain height map.
+
+/// Every element of level 0 contains the minimum and the maximum value of the
+/// corresponding 2x2 block of the source array. Every next level is built the same
+/// way from the previous one, and the last level contains a single element.
+/// A level has (PrevWidth + 1) / 2 x (PrevHeight + 1) / 2 elements, so the blocks
+/// in the last column or row of a level with odd dimensions only cover one element.
+///
+/// As a result, element (x, y) of level L covers the source elements
+/// [x * 2^(L+1), (x + 1) * 2^(L+1)) x [y * 2^(L+1), (y + 1) * 2^(L+1)),
+/// clamped to the array dimensions.
+class Array2DMinMaxPyramid
+{
+public:
+    /// Builds the pyramid for the 2D array.
+
+    /// \param[in]  pData		   - A pointer to the array data.
+    /// \param[in]  StrideInFloats - Row stride in 32-bit floats.
+    /// \param[in]  Width		   - 2D array width.
+    /// \param[in]  Height		   - 2D array height.
+    /// \param[in]  pThreadPool    - Optional thread pool to process the rows of every level in parallel.
+    ///
+    /// \remarks    A 1x1 array produces a pyramid with a single 1x1 level.
+    void Build(const float* pData,
+               size_t       StrideInFloats,
+               Uint32       Width,
+               Uint32       Height,
+               IThreadPool* pThreadPool = nullptr);
+
+    /// Releases all levels.
+    void Clear();
+
+    Uint32 GetLevelCount() const { return static_cast<Uint32>(m_Levels.size()); }
+    Uint32 GetLevelWidth(Uint32 Level) const { return m_Levels[Level].Width; }
+    Uint32 GetLevelHeight(Uint32 Level) const { return m_Levels[Level].Height; }
+
+    /// Returns minimum values of the level. Rows are tightly packed, so the row stride is equal to the level width.
+    const float* GetMinValues(Uint32 Level) const { return &m_MinValues[m_Levels[Level].Offset]; }
+
+    /// Returns maximum values of the level. Rows are tightly packed, so the row stride is equal to the level width.
+    const float* GetMaxValues(Uint32 Level) const { return &m_MaxValues[m_Levels[Level].Offset]; }
+
+private:
+    struct LevelInfo
+    {
+        Uint32 Width  = 0;
+        Uint32 Height = 0;
+        size_t Offset = 0;
+    };
+    std::vector<LevelInfo> m_Levels;
+
+    std::vector<float> m_MinValues;
+    std::vector<float> m_MaxValues;
+};
 
 } // namespace Diligent
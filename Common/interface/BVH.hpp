@@ -0,0 +1,498 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Bounding volume hierarchy with binned SAH build and ray queries.
+
+#include <vector>
+
+#include "AdvancedMath.hpp"
+#include "BasicMathSIMD.hpp"
+#include "../../Platforms/interface/PlatformMisc.hpp"
+
+namespace Diligent
+{
+
+class IThreadPool;
+
+/// Bounding volume hierarchy node.
+struct BVHNode
+{
+    /// Node bounding box minimum.
+    float3 Min;
+
+    /// For internal nodes, the index of the left child. The right child
+    /// immediately follows the left one.
+    /// For leaf nodes, the index of the first primitive in the primitive index array.
+    Uint32 LeftOrFirst = 0;
+
+    /// Node bounding box maximum.
+    float3 Max;
+
+    /// The number of primitives in the leaf node, or zero for internal nodes.
+    Uint32 NumPrimitives = 0;
+
+    bool IsLeaf() const
+    {
+        return NumPrimitives != 0;
+    }
+};
+static_assert(sizeof(BVHNode) == 32, "BVHNode is expected to be 32 bytes");
+
+
+/// Ray used in BVH queries.
+struct BVHRay
+{
+    float3 Origin;
+    float3 Direction;
+
+    /// Only intersections at distances in [MinDist, MaxDist] are reported.
+    float MinDist = 0;
+    float MaxDist = +FLT_MAX;
+};
+
+/// Ray query result.
+struct BVHHit
+{
+    /// The index of the hit primitive, or InvalidPrimitive if there is no hit.
+    Uint32 PrimitiveIndex = InvalidPrimitive;
+
+    /// The distance along the ray to the hit point.
+    float Distance = +FLT_MAX;
+
+    static constexpr Uint32 InvalidPrimitive = ~0u;
+
+    explicit operator bool() const
+    {
+        return PrimitiveIndex != InvalidPrimitive;
+    }
+};
+
+
+/// Bounding volume hierarchy over an arbitrary set of primitives.
+
+/// The hierarchy is built from the primitive bounding boxes using the surface area heuristic (SAH)
+/// evaluated over a fixed number of bins. Ray queries take an intersector that is called as
+///
+///     float Intersector(Uint32 PrimitiveIndex, const BVHRay& Ray)
+///
+/// and returns the distance along the ray to the intersection with the primitive,
+/// or +FLT_MAX if there is no intersection (same as IntersectRayTriangle).
+/// See BVHTriangleIntersector and BVHBoxIntersector.
+class BoundingVolumeHierarchy
+{
+public:
+    struct CreateInfo
+    {
+        /// Primitive bounding boxes.
+        const BoundBox* pPrimitiveBounds = nullptr;
+
+        /// The number of primitives.
+        Uint32 NumPrimitives = 0;
+
+        /// The maximum number of primitives in a leaf node.
+        Uint32 MaxLeafSize = 4;
+
+        /// The number of bins used to evaluate the SAH.
+        Uint32 NumBins = 16;
+
+        /// The cost of traversing a node relative to the cost of intersecting a primitive.
+        float TraversalCost = 1.f;
+
+        /// Optional thread pool to build the hierarchy in parallel.
+        IThreadPool* pThreadPool = nullptr;
+
+        /// The minimum number of primitives in a subtree to build it as a separate task.
+        Uint32 MinParallelSubtreeSize = 4096;
+    };
+
+    /// Maximum depth of the hierarchy. Deeper splits use the object median instead of SAH,
+    /// which bounds the depth for any number of primitives.
+    static constexpr Uint32 MaxDepth = 64;
+
+    BoundingVolumeHierarchy() = default;
+
+    explicit BoundingVolumeHierarchy(const CreateInfo& CI)
+    {
+        Build(CI);
+    }
+
+    /// Builds the hierarchy, discarding the previous contents.
+    void Build(const CreateInfo& CI);
+
+    void Clear()
+    {
+        m_Nodes.clear();
+        m_PrimitiveIndices.clear();
+        m_Depth = 0;
+    }
+
+    bool IsEmpty() const
+    {
+        return m_Nodes.empty();
+    }
+
+    /// Returns the bounding box of all primitives.
+    BoundBox GetBounds() const
+    {
+        return !m_Nodes.empty() ? BoundBox{m_Nodes[0].Min, m_Nodes[0].Max} : BoundBox::Invalid();
+    }
+
+    /// Returns the nodes. The first node is the root.
+    const std::vector<BVHNode>& GetNodes() const { return m_Nodes; }
+
+    /// Returns the primitive indices referenced by the leaf nodes.
+    const std::vector<Uint32>& GetPrimitiveIndices() const { return m_PrimitiveIndices; }
+
+    /// Returns the depth of the hierarchy, where a single leaf has the depth of 1.
+    Uint32 GetDepth() const { return m_Depth; }
+
+    /// Finds the closest intersection of the ray with the primitives.
+    template <typename IntersectorType>
+    BVHHit IntersectClosest(const BVHRay& Ray, IntersectorType&& Intersector) const
+    {
+        return Traverse<false>(Ray, Intersector);
+    }
+
+    /// Finds any intersection of the ray with the primitives.
+    /// This is faster than IntersectClosest and is intended for visibility queries.
+    template <typename IntersectorType>
+    BVHHit IntersectAny(const BVHRay& Ray, IntersectorType&& Intersector) const
+    {
+        return Traverse<true>(Ray, Intersector);
+    }
+
+    /// Finds the closest intersections of four rays with the primitives.
+
+    /// The rays are traversed together and every node is tested against all of them at once,
+    /// which works best for coherent rays (e.g. neighboring pixels).
+    /// The results are the same as of four IntersectClosest calls.
+    template <typename IntersectorType>
+    void IntersectClosest4(const BVHRay Rays[4], BVHHit Hits[4], IntersectorType&& Intersector) const
+    {
+        TraversePacket<false>(Rays, Hits, Intersector);
+    }
+
+    /// Finds any intersection of each of four rays with the primitives.
+    template <typename IntersectorType>
+    void IntersectAny4(const BVHRay Rays[4], BVHHit Hits[4], IntersectorType&& Intersector) const
+    {
+        TraversePacket<true>(Rays, Hits, Intersector);
+    }
+
+private:
+    struct StackEntry
+    {
+        Uint32 NodeIdx;
+        float  EnterDist;
+    };
+
+    static float3 GetInverseDirection(const float3& Dir)
+    {
+        // Replace near-zero components with a small value of the same sign to avoid
+        // producing NaNs (0 * inf) in the slab test when the origin lies on the slab plane.
+        static constexpr float Epsilon = 1e-20f;
+
+        float3 InvDir;
+        for (int c = 0; c < 3; ++c)
+        {
+            const float d = std::abs(Dir[c]) > Epsilon ? Dir[c] : (Dir[c] < 0 ? -Epsilon : +Epsilon);
+            InvDir[c]     = 1.f / d;
+        }
+        return InvDir;
+    }
+
+    static bool IsHitInRange(float Dist, float MinDist, float MaxDist)
+    {
+        // +FLT_MAX indicates that there is no intersection
+        return Dist >= MinDist && Dist <= MaxDist && Dist != +FLT_MAX;
+    }
+
+    static bool IntersectNode(const BVHNode& Node,
+                              const float3&  Origin,
+                              const float3&  InvDir,
+                              float          MinDist,
+                              float          MaxDist,
+                              float&         EnterDist)
+    {
+        const float tx0 = (Node.Min.x - Origin.x) * InvDir.x;
+        const float tx1 = (Node.Max.x - Origin.x) * InvDir.x;
+        const float ty0 = (Node.Min.y - Origin.y) * InvDir.y;
+        const float ty1 = (Node.Max.y - Origin.y) * InvDir.y;
+        const float tz0 = (Node.Min.z - Origin.z) * InvDir.z;
+        const float tz1 = (Node.Max.z - Origin.z) * InvDir.z;
+
+        EnterDist      = (std::max)((std::max)(MinDist, (std::min)(tx0, tx1)), (std::max)((std::min)(ty0, ty1), (std::min)(tz0, tz1)));
+        float ExitDist = (std::min)((std::min)(MaxDist, (std::max)(tx0, tx1)), (std::min)((std::max)(ty0, ty1), (std::max)(tz0, tz1)));
+        return EnterDist <= ExitDist;
+    }
+
+    template <bool AnyHit, typename IntersectorType>
+    BVHHit Traverse(const BVHRay& Ray, IntersectorType& Intersector) const;
+
+    template <bool AnyHit, typename IntersectorType>
+    void TraversePacket(const BVHRay Rays[4], BVHHit Hits[4], IntersectorType& Intersector) const;
+
+private:
+    std::vector<BVHNode> m_Nodes;
+    std::vector<Uint32>  m_PrimitiveIndices;
+    Uint32               m_Depth = 0;
+};
+
+
+template <bool AnyHit, typename IntersectorType>
+BVHHit BoundingVolumeHierarchy::Traverse(const BVHRay& Ray, IntersectorType& Intersector) const
+{
+    BVHHit Hit;
+    if (m_Nodes.empty())
+        return Hit;
+
+    const float3 InvDir  = GetInverseDirection(Ray.Direction);
+    float        MaxDist = Ray.MaxDist;
+
+    float RootEnterDist = 0;
+    if (!IntersectNode(m_Nodes[0], Ray.Origin, InvDir, Ray.MinDist, MaxDist, RootEnterDist))
+        return Hit;
+
+    StackEntry Stack[MaxDepth + 1];
+    Uint32     StackSize = 0;
+    Stack[StackSize++]   = {0, RootEnterDist};
+    while (StackSize > 0)
+    {
+        const auto Entry = Stack[--StackSize];
+        // The node may have been pushed before a closer hit was found
+        if (Entry.EnterDist > MaxDist)
+            continue;
+
+        const auto& Node = m_Nodes[Entry.NodeIdx];
+        if (Node.IsLeaf())
+        {
+            for (Uint32 i = 0; i < Node.NumPrimitives; ++i)
+            {
+                const Uint32 PrimIdx = m_PrimitiveIndices[Node.LeftOrFirst + i];
+                const float  Dist    = Intersector(PrimIdx, Ray);
+                if (IsHitInRange(Dist, Ray.MinDist, MaxDist))
+                {
+                    Hit.PrimitiveIndex = PrimIdx;
+                    Hit.Distance       = Dist;
+                    if (AnyHit)
+                        return Hit;
+                    MaxDist = Dist;
+                }
+            }
+        }
+        else
+        {
+            Uint32 Near = Node.LeftOrFirst;
+            Uint32 Far  = Node.LeftOrFirst + 1;
+
+            float      NearDist = 0, FarDist = 0;
+            const bool NearHit = IntersectNode(m_Nodes[Near], Ray.Origin, InvDir, Ray.MinDist, MaxDist, NearDist);
+            const bool FarHit  = IntersectNode(m_Nodes[Far], Ray.Origin, InvDir, Ray.MinDist, MaxDist, FarDist);
+            if (NearHit && FarHit && FarDist < NearDist)
+            {
+                std::swap(Near, Far);
+                std::swap(NearDist, FarDist);
+            }
+
+            // Push the far child first so that the near child is processed next
+            if (FarHit)
+                Stack[StackSize++] = {Far, FarDist};
+            if (NearHit)
+                Stack[StackSize++] = {Near, NearDist};
+        }
+    }
+
+    return Hit;
+}
+
+template <bool AnyHit, typename IntersectorType>
+void BoundingVolumeHierarchy::TraversePacket(const BVHRay Rays[4], BVHHit Hits[4], IntersectorType& Intersector) const
+{
+    using namespace MathSIMD;
+
+    for (Uint32 r = 0; r < 4; ++r)
+        Hits[r] = {};
+
+    if (m_Nodes.empty())
+        return;
+
+    float InvDirs[3][4];
+    float Origins[3][4];
+    float MinDists[4];
+    float MaxDists[4];
+    for (Uint32 r = 0; r < 4; ++r)
+    {
+        const float3 InvDir = GetInverseDirection(Rays[r].Direction);
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            InvDirs[c][r] = InvDir[c];
+            Origins[c][r] = Rays[r].Origin[c];
+        }
+        MinDists[r] = Rays[r].MinDist;
+        MaxDists[r] = Rays[r].MaxDist;
+    }
+
+    const VecF4 InvDirX = LoadF4(InvDirs[0]);
+    const VecF4 InvDirY = LoadF4(InvDirs[1]);
+    const VecF4 InvDirZ = LoadF4(InvDirs[2]);
+    const VecF4 OrigX   = LoadF4(Origins[0]);
+    const VecF4 OrigY   = LoadF4(Origins[1]);
+    const VecF4 OrigZ   = LoadF4(Origins[2]);
+    const VecF4 MinDist = LoadF4(MinDists);
+
+    // Rays that have not found a hit yet (any-hit queries only)
+    Uint32 ActiveRays = 0xF;
+
+    // Tests the node against all rays and returns the mask of rays that hit it.
+    // The entry distance of the first hitting ray is returned in EnterDist.
+    auto IntersectNode4 = [&](const BVHNode& Node, float& EnterDist) {
+        const VecF4 tx0 = MulF4(SubF4(SetF4(Node.Min.x), OrigX), InvDirX);
+        const VecF4 tx1 = MulF4(SubF4(SetF4(Node.Max.x), OrigX), InvDirX);
+        const VecF4 ty0 = MulF4(SubF4(SetF4(Node.Min.y), OrigY), InvDirY);
+        const VecF4 ty1 = MulF4(SubF4(SetF4(Node.Max.y), OrigY), InvDirY);
+        const VecF4 tz0 = MulF4(SubF4(SetF4(Node.Min.z), OrigZ), InvDirZ);
+        const VecF4 tz1 = MulF4(SubF4(SetF4(Node.Max.z), OrigZ), InvDirZ);
+
+        const VecF4 Enter = MaxF4(MaxF4(MinDist, MinF4(tx0, tx1)), MaxF4(MinF4(ty0, ty1), MinF4(tz0, tz1)));
+        const VecF4 Exit  = MinF4(MinF4(LoadF4(MaxDists), MaxF4(tx0, tx1)), MinF4(MaxF4(ty0, ty1), MaxF4(tz0, tz1)));
+
+        const Uint32 Mask = static_cast<Uint32>(MoveMaskF4(CmpLeF4(Enter, Exit))) & ActiveRays;
+        if (Mask != 0)
+        {
+            float EnterDists[4];
+            StoreF4(EnterDists, Enter);
+            EnterDist = EnterDists[PlatformMisc::GetLSB(Mask)];
+        }
+        return Mask;
+    };
+
+    struct PacketStackEntry
+    {
+        Uint32 NodeIdx;
+        Uint32 RayMask;
+    };
+
+    float  RootEnterDist = 0;
+    Uint32 RootMask      = IntersectNode4(m_Nodes[0], RootEnterDist);
+    if (RootMask == 0)
+        return;
+
+    PacketStackEntry Stack[MaxDepth + 1];
+    Uint32           StackSize = 0;
+    Stack[StackSize++]         = {0, RootMask};
+    while (StackSize > 0 && ActiveRays != 0)
+    {
+        const auto  Entry = Stack[--StackSize];
+        const auto& Node  = m_Nodes[Entry.NodeIdx];
+        if (Node.IsLeaf())
+        {
+            for (Uint32 i = 0; i < Node.NumPrimitives; ++i)
+            {
+                const Uint32 PrimIdx = m_PrimitiveIndices[Node.LeftOrFirst + i];
+                for (Uint32 RayMask = Entry.RayMask & ActiveRays; RayMask != 0; RayMask &= RayMask - 1)
+                {
+                    const Uint32 r    = PlatformMisc::GetLSB(RayMask);
+                    const float  Dist = Intersector(PrimIdx, Rays[r]);
+                    if (IsHitInRange(Dist, Rays[r].MinDist, MaxDists[r]))
+                    {
+                        Hits[r].PrimitiveIndex = PrimIdx;
+                        Hits[r].Distance       = Dist;
+                        MaxDists[r]            = Dist;
+                        if (AnyHit)
+                            ActiveRays &= ~(1u << r);
+                    }
+                }
+            }
+        }
+        else
+        {
+            Uint32 Near = Node.LeftOrFirst;
+            Uint32 Far  = Node.LeftOrFirst + 1;
+
+            float  NearDist = 0, FarDist = 0;
+            Uint32 NearMask = IntersectNode4(m_Nodes[Near], NearDist);
+            Uint32 FarMask  = IntersectNode4(m_Nodes[Far], FarDist);
+            if (NearMask != 0 && FarMask != 0 && FarDist < NearDist)
+            {
+                std::swap(Near, Far);
+                std::swap(NearMask, FarMask);
+            }
+
+            if (FarMask != 0)
+                Stack[StackSize++] = {Far, FarMask};
+            if (NearMask != 0)
+                Stack[StackSize++] = {Near, NearMask};
+        }
+    }
+}
+
+
+/// Builds the bounding volume hierarchy over the triangle mesh.
+
+/// \param [in] pVertices    - Vertex positions.
+/// \param [in] pIndices     - Triangle list indices, three per triangle.
+/// \param [in] NumTriangles - The number of triangles.
+/// \param [in] CI           - Build parameters. pPrimitiveBounds and NumPrimitives are ignored.
+///
+/// \remarks    Primitive indices of the hierarchy are triangle indices.
+BoundingVolumeHierarchy CreateTriangleMeshBVH(const float3*                       pVertices,
+                                              const Uint32*                       pIndices,
+                                              Uint32                              NumTriangles,
+                                              BoundingVolumeHierarchy::CreateInfo CI = {});
+
+/// Intersector for triangle meshes that uses IntersectRayTriangle.
+struct BVHTriangleIntersector
+{
+    const float3* pVertices    = nullptr;
+    const Uint32* pIndices     = nullptr;
+    bool          CullBackFace = false;
+
+    float operator()(Uint32 TriangleIndex, const BVHRay& Ray) const
+    {
+        const Uint32* Tri = pIndices + size_t{TriangleIndex} * 3;
+        return IntersectRayTriangle(pVertices[Tri[0]], pVertices[Tri[1]], pVertices[Tri[2]], Ray.Origin, Ray.Direction, CullBackFace);
+    }
+};
+
+/// Intersector for axis-aligned boxes that uses IntersectRayAABB.
+/// The distance to the box is the entry distance, or zero if the ray starts inside the box.
+struct BVHBoxIntersector
+{
+    const BoundBox* pBoxes = nullptr;
+
+    float operator()(Uint32 BoxIndex, const BVHRay& Ray) const
+    {
+        float EnterDist = 0, ExitDist = 0;
+        if (!IntersectRayAABB(Ray.Origin, Ray.Direction, pBoxes[BoxIndex], EnterDist, ExitDist))
+            return +FLT_MAX;
+        return (std::max)(EnterDist, 0.f);
+    }
+};
+
+} // namespace Diligent
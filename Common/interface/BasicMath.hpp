@@ -53,6 +53,7 @@
 #include <iostream>
 
 #include "HashUtils.hpp"
+#include "BasicMathSIMD.hpp"
 
 #ifdef _MSC_VER
 #    pragma warning(push)
@@ -2253,6 +2254,21 @@ constexpr Vector2<T> operator*(const Matrix2x2<T>& m, const Vector2<T>& v)
     return out;
 }
 
+#if DILIGENT_MATH_SIMD != DILIGENT_MATH_SIMD_NONE && DILIGENT_MATH_SIMD_MATRIX_MUL
+
+// SIMD specialization of single-precision matrix multiplication, see DILIGENT_MATH_SIMD_MATRIX_MUL.
+// Note that the specialization is not constexpr.
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::Mul(const Matrix4x4<float>& m1, const Matrix4x4<float>& m2)
+{
+    Matrix4x4<float> mOut;
+    MathSIMD::MulMatrix4x4(&m1.m[0][0], &m2.m[0][0], &mOut.m[0][0]);
+    return mOut;
+}
+
+#endif
+
 // Common HLSL-compatible vector typedefs
 
 using uint  = uint32_t;
@@ -0,0 +1,527 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// SIMD primitives and kernels used by BasicMath.hpp and by the CPU algorithms in Common.
+///
+/// The instruction set is selected at compile time by the DILIGENT_MATH_SIMD macro.
+/// If the macro is not defined by the build system, it is set to the best instruction
+/// set enabled by the compiler flags. Define DILIGENT_MATH_SIMD to DILIGENT_MATH_SIMD_NONE
+/// to force the scalar implementation.
+///
+/// The kernels use unaligned loads and stores, so float4 and float4x4 keep their
+/// natural alignment and layout. The kernels perform exactly the same sequence of
+/// multiplications and additions as the scalar code (no fused multiply-add and no
+/// horizontal reductions), and produce bit-identical results.
+
+#define DILIGENT_MATH_SIMD_NONE 0
+#define DILIGENT_MATH_SIMD_SSE  1
+#define DILIGENT_MATH_SIMD_AVX  2
+#define DILIGENT_MATH_SIMD_NEON 3
+
+#ifndef DILIGENT_MATH_SIMD
+#    if defined(__AVX__)
+#        define DILIGENT_MATH_SIMD DILIGENT_MATH_SIMD_AVX
+#    elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#        define DILIGENT_MATH_SIMD DILIGENT_MATH_SIMD_SSE
+#    elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#        define DILIGENT_MATH_SIMD DILIGENT_MATH_SIMD_NEON
+#    else
+#        define DILIGENT_MATH_SIMD DILIGENT_MATH_SIMD_NONE
+#    endif
+#endif
+
+/// BasicMath.hpp only specializes float4x4 multiplication with SIMD when DILIGENT_MATH_SIMD_MATRIX_MUL is 1.
+/// The kernel is faster than the compiler-vectorized scalar code with AVX and is enabled by default there.
+/// With SSE2 it is on par, and vector-matrix products are not specialized at all, because compilers
+/// vectorize loops of scalar products across elements better than the per-call kernels.
+#ifndef DILIGENT_MATH_SIMD_MATRIX_MUL
+#    if DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_AVX
+#        define DILIGENT_MATH_SIMD_MATRIX_MUL 1
+#    else
+#        define DILIGENT_MATH_SIMD_MATRIX_MUL 0
+#    endif
+#endif
+
+#include <cmath>
+
+#if DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_AVX
+#    include <immintrin.h>
+#elif DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_SSE
+#    include <emmintrin.h>
+#elif DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_NEON
+#    include <arm_neon.h>
+#elif DILIGENT_MATH_SIMD != DILIGENT_MATH_SIMD_NONE
+#    error Unknown DILIGENT_MATH_SIMD value
+#endif
+
+namespace Diligent
+{
+
+namespace MathSIMD
+{
+
+#if DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_SSE || DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_AVX
+
+using VecF4 = __m128;
+
+inline VecF4 LoadF4(const float* p) { return _mm_loadu_ps(p); }
+inline void  StoreF4(float* p, VecF4 v) { _mm_storeu_ps(p, v); }
+inline VecF4 SetF4(float x) { return _mm_set1_ps(x); }
+// With AVX enabled, compiles to a single broadcast load that does not use the shuffle port
+inline VecF4 LoadSplatF4(const float* p) { return _mm_set1_ps(*p); }
+inline VecF4 SetF4(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+inline VecF4 AddF4(VecF4 a, VecF4 b) { return _mm_add_ps(a, b); }
+inline VecF4 SubF4(VecF4 a, VecF4 b) { return _mm_sub_ps(a, b); }
+inline VecF4 MulF4(VecF4 a, VecF4 b) { return _mm_mul_ps(a, b); }
+inline VecF4 DivF4(VecF4 a, VecF4 b) { return _mm_div_ps(a, b); }
+inline VecF4 MinF4(VecF4 a, VecF4 b) { return _mm_min_ps(a, b); }
+inline VecF4 MaxF4(VecF4 a, VecF4 b) { return _mm_max_ps(a, b); }
+inline VecF4 SqrtF4(VecF4 v) { return _mm_sqrt_ps(v); }
+
+/// Broadcasts the specified lane of v to all four lanes.
+template <int Lane>
+inline VecF4 SplatF4(VecF4 v)
+{
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+}
+
+inline void TransposeF4(VecF4& r0, VecF4& r1, VecF4& r2, VecF4& r3)
+{
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+}
+
+/// Splits eight consecutive values a0..a3, b0..b3 into even {a0, a2, b0, b2} and odd {a1, a3, b1, b3} elements.
+inline void DeinterleaveF4(VecF4 a, VecF4 b, VecF4& Even, VecF4& Odd)
+{
+    Even = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    Odd  = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+/// Lane mask produced by comparisons: all bits of a lane are set if the condition is true.
+using MaskF4 = __m128;
+
+inline VecF4  AbsF4(VecF4 v) { return _mm_andnot_ps(_mm_set1_ps(-0.f), v); }
+inline MaskF4 CmpLtF4(VecF4 a, VecF4 b) { return _mm_cmplt_ps(a, b); }
+inline MaskF4 CmpLeF4(VecF4 a, VecF4 b) { return _mm_cmple_ps(a, b); }
+inline MaskF4 CmpGtF4(VecF4 a, VecF4 b) { return _mm_cmpgt_ps(a, b); }
+inline MaskF4 CmpGeF4(VecF4 a, VecF4 b) { return _mm_cmpge_ps(a, b); }
+inline MaskF4 AndMaskF4(MaskF4 a, MaskF4 b) { return _mm_and_ps(a, b); }
+inline MaskF4 OrMaskF4(MaskF4 a, MaskF4 b) { return _mm_or_ps(a, b); }
+inline MaskF4 TrueMaskF4() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+inline MaskF4 FalseMaskF4() { return _mm_setzero_ps(); }
+/// Returns a where the mask is true, and b otherwise.
+inline VecF4 SelectF4(MaskF4 m, VecF4 a, VecF4 b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+/// Returns the 4-bit integer mask, where bit i is set if lane i of the mask is true.
+inline int MoveMaskF4(MaskF4 m) { return _mm_movemask_ps(m); }
+
+/// Rounds the values down to the nearest integer. Same semantics as FastFloor:
+/// values whose magnitude is at least 2^23 have no fractional part and are returned as is.
+inline VecF4 FloorF4(VecF4 x)
+{
+    const VecF4 Trunc = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+    const VecF4 Flr   = _mm_sub_ps(Trunc, _mm_and_ps(_mm_cmpgt_ps(Trunc, x), _mm_set1_ps(1.f)));
+    return SelectF4(_mm_cmpge_ps(AbsF4(x), _mm_set1_ps(8388608.f)), x, Flr);
+}
+/// Converts the values to integers, rounding toward zero, and stores them to p.
+inline void StoreI4(int* p, VecF4 v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_cvttps_epi32(v)); }
+
+#elif DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_NEON
+
+using VecF4 = float32x4_t;
+
+inline VecF4 LoadF4(const float* p) { return vld1q_f32(p); }
+inline void  StoreF4(float* p, VecF4 v) { vst1q_f32(p, v); }
+inline VecF4 SetF4(float x) { return vdupq_n_f32(x); }
+inline VecF4 LoadSplatF4(const float* p) { return vld1q_dup_f32(p); }
+inline VecF4 SetF4(float x, float y, float z, float w)
+{
+    const float v[] = {x, y, z, w};
+    return vld1q_f32(v);
+}
+inline VecF4 AddF4(VecF4 a, VecF4 b) { return vaddq_f32(a, b); }
+inline VecF4 SubF4(VecF4 a, VecF4 b) { return vsubq_f32(a, b); }
+// Note that vmlaq_f32 may be fused on some targets, so multiplication and addition are kept separate
+inline VecF4 MulF4(VecF4 a, VecF4 b) { return vmulq_f32(a, b); }
+#    if defined(__aarch64__) || defined(_M_ARM64)
+inline VecF4 DivF4(VecF4 a, VecF4 b)
+{
+    return vdivq_f32(a, b);
+}
+#    else
+inline VecF4 DivF4(VecF4 a, VecF4 b)
+{
+    // ARMv7 NEON has no division instruction
+    float fa[4], fb[4];
+    vst1q_f32(fa, a);
+    vst1q_f32(fb, b);
+    return SetF4(fa[0] / fb[0], fa[1] / fb[1], fa[2] / fb[2], fa[3] / fb[3]);
+}
+#    endif
+inline VecF4 MinF4(VecF4 a, VecF4 b)
+{
+    return vminq_f32(a, b);
+}
+inline VecF4 MaxF4(VecF4 a, VecF4 b) { return vmaxq_f32(a, b); }
+#    if defined(__aarch64__) || defined(_M_ARM64)
+inline VecF4 SqrtF4(VecF4 v)
+{
+    return vsqrtq_f32(v);
+}
+#    else
+inline VecF4 SqrtF4(VecF4 v)
+{
+    // ARMv7 NEON has no square root instruction
+    float f[4];
+    vst1q_f32(f, v);
+    return SetF4(std::sqrt(f[0]), std::sqrt(f[1]), std::sqrt(f[2]), std::sqrt(f[3]));
+}
+#    endif
+
+/// Broadcasts the specified lane of v to all four lanes.
+template <int Lane>
+inline VecF4 SplatF4(VecF4 v)
+{
+    return vdupq_n_f32(vgetq_lane_f32(v, Lane));
+}
+
+inline void TransposeF4(VecF4& r0, VecF4& r1, VecF4& r2, VecF4& r3)
+{
+    // t01.val[0] = {r0.x, r1.x, r0.z, r1.z}, t01.val[1] = {r0.y, r1.y, r0.w, r1.w}
+    const float32x4x2_t t01 = vtrnq_f32(r0, r1);
+    const float32x4x2_t t23 = vtrnq_f32(r2, r3);
+
+    r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+/// Splits eight consecutive values a0..a3, b0..b3 into even {a0, a2, b0, b2} and odd {a1, a3, b1, b3} elements.
+inline void DeinterleaveF4(VecF4 a, VecF4 b, VecF4& Even, VecF4& Odd)
+{
+    const float32x4x2_t r = vuzpq_f32(a, b);
+
+    Even = r.val[0];
+    Odd  = r.val[1];
+}
+
+/// Lane mask produced by comparisons: all bits of a lane are set if the condition is true.
+using MaskF4 = uint32x4_t;
+
+inline VecF4  AbsF4(VecF4 v) { return vabsq_f32(v); }
+inline MaskF4 CmpLtF4(VecF4 a, VecF4 b) { return vcltq_f32(a, b); }
+inline MaskF4 CmpLeF4(VecF4 a, VecF4 b) { return vcleq_f32(a, b); }
+inline MaskF4 CmpGtF4(VecF4 a, VecF4 b) { return vcgtq_f32(a, b); }
+inline MaskF4 CmpGeF4(VecF4 a, VecF4 b) { return vcgeq_f32(a, b); }
+inline MaskF4 AndMaskF4(MaskF4 a, MaskF4 b) { return vandq_u32(a, b); }
+inline MaskF4 OrMaskF4(MaskF4 a, MaskF4 b) { return vorrq_u32(a, b); }
+inline MaskF4 TrueMaskF4() { return vdupq_n_u32(~0u); }
+inline MaskF4 FalseMaskF4() { return vdupq_n_u32(0); }
+/// Returns a where the mask is true, and b otherwise.
+inline VecF4 SelectF4(MaskF4 m, VecF4 a, VecF4 b) { return vbslq_f32(m, a, b); }
+/// Returns the 4-bit integer mask, where bit i is set if lane i of the mask is true.
+inline int MoveMaskF4(MaskF4 m)
+{
+    static const uint32_t LaneBits[] = {1, 2, 4, 8};
+
+    const uint32x4_t Bits = vandq_u32(m, vld1q_u32(LaneBits));
+#    if defined(__aarch64__) || defined(_M_ARM64)
+    return static_cast<int>(vaddvq_u32(Bits));
+#    else
+    const uint32x2_t Sum = vadd_u32(vget_low_u32(Bits), vget_high_u32(Bits));
+    return static_cast<int>(vget_lane_u32(vpadd_u32(Sum, Sum), 0));
+#    endif
+}
+
+/// Rounds the values down to the nearest integer. Same semantics as FastFloor:
+/// values whose magnitude is at least 2^23 have no fractional part and are returned as is.
+#    if defined(__aarch64__) || defined(_M_ARM64)
+inline VecF4 FloorF4(VecF4 x)
+{
+    return vrndmq_f32(x);
+}
+#    else
+inline VecF4 FloorF4(VecF4 x)
+{
+    const VecF4 Trunc = vcvtq_f32_s32(vcvtq_s32_f32(x));
+    const VecF4 Flr   = vsubq_f32(Trunc, vbslq_f32(vcgtq_f32(Trunc, x), vdupq_n_f32(1.f), vdupq_n_f32(0.f)));
+    return vbslq_f32(vcgeq_f32(vabsq_f32(x), vdupq_n_f32(8388608.f)), x, Flr);
+}
+#    endif
+/// Converts the values to integers, rounding toward zero, and stores them to p.
+inline void StoreI4(int* p, VecF4 v) { vst1q_s32(p, vcvtq_s32_f32(v)); }
+
+#else
+
+// Scalar fallback that allows code written against the VecF4 primitives
+// to compile on platforms without SIMD support.
+struct VecF4
+{
+    float v[4];
+};
+
+inline VecF4 LoadF4(const float* p) { return VecF4{{p[0], p[1], p[2], p[3]}}; }
+inline void  StoreF4(float* p, VecF4 v)
+{
+    for (int i = 0; i < 4; ++i)
+        p[i] = v.v[i];
+}
+inline VecF4 SetF4(float x) { return VecF4{{x, x, x, x}}; }
+inline VecF4 LoadSplatF4(const float* p) { return SetF4(*p); }
+inline VecF4 SetF4(float x, float y, float z, float w) { return VecF4{{x, y, z, w}}; }
+inline VecF4 AddF4(VecF4 a, VecF4 b) { return VecF4{{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}}; }
+inline VecF4 SubF4(VecF4 a, VecF4 b) { return VecF4{{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}}; }
+inline VecF4 MulF4(VecF4 a, VecF4 b) { return VecF4{{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}}; }
+inline VecF4 DivF4(VecF4 a, VecF4 b) { return VecF4{{a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3]}}; }
+inline VecF4 MinF4(VecF4 a, VecF4 b)
+{
+    // Same semantics as _mm_min_ps: the second operand is returned if either value is NaN
+    return VecF4{{a.v[0] < b.v[0] ? a.v[0] : b.v[0], a.v[1] < b.v[1] ? a.v[1] : b.v[1], a.v[2] < b.v[2] ? a.v[2] : b.v[2], a.v[3] < b.v[3] ? a.v[3] : b.v[3]}};
+}
+inline VecF4 MaxF4(VecF4 a, VecF4 b)
+{
+    return VecF4{{a.v[0] > b.v[0] ? a.v[0] : b.v[0], a.v[1] > b.v[1] ? a.v[1] : b.v[1], a.v[2] > b.v[2] ? a.v[2] : b.v[2], a.v[3] > b.v[3] ? a.v[3] : b.v[3]}};
+}
+inline VecF4 SqrtF4(VecF4 v) { return VecF4{{std::sqrt(v.v[0]), std::sqrt(v.v[1]), std::sqrt(v.v[2]), std::sqrt(v.v[3])}}; }
+
+/// Broadcasts the specified lane of v to all four lanes.
+template <int Lane>
+inline VecF4 SplatF4(VecF4 v)
+{
+    return SetF4(v.v[Lane]);
+}
+
+inline void TransposeF4(VecF4& r0, VecF4& r1, VecF4& r2, VecF4& r3)
+{
+    const VecF4 c0{{r0.v[0], r1.v[0], r2.v[0], r3.v[0]}};
+    const VecF4 c1{{r0.v[1], r1.v[1], r2.v[1], r3.v[1]}};
+    const VecF4 c2{{r0.v[2], r1.v[2], r2.v[2], r3.v[2]}};
+    const VecF4 c3{{r0.v[3], r1.v[3], r2.v[3], r3.v[3]}};
+
+    r0 = c0;
+    r1 = c1;
+    r2 = c2;
+    r3 = c3;
+}
+
+/// Splits eight consecutive values a0..a3, b0..b3 into even {a0, a2, b0, b2} and odd {a1, a3, b1, b3} elements.
+inline void DeinterleaveF4(VecF4 a, VecF4 b, VecF4& Even, VecF4& Odd)
+{
+    Even = VecF4{{a.v[0], a.v[2], b.v[0], b.v[2]}};
+    Odd  = VecF4{{a.v[1], a.v[3], b.v[1], b.v[3]}};
+}
+
+/// Lane mask produced by comparisons.
+struct MaskF4
+{
+    bool m[4];
+};
+
+inline VecF4 AbsF4(VecF4 v)
+{
+    // Note that unlike std::abs, this does not clear the sign of -0.0, which is irrelevant for comparisons
+    return VecF4{{v.v[0] < 0 ? -v.v[0] : v.v[0], v.v[1] < 0 ? -v.v[1] : v.v[1], v.v[2] < 0 ? -v.v[2] : v.v[2], v.v[3] < 0 ? -v.v[3] : v.v[3]}};
+}
+inline MaskF4 CmpLtF4(VecF4 a, VecF4 b) { return MaskF4{{a.v[0] < b.v[0], a.v[1] < b.v[1], a.v[2] < b.v[2], a.v[3] < b.v[3]}}; }
+inline MaskF4 CmpLeF4(VecF4 a, VecF4 b) { return MaskF4{{a.v[0] <= b.v[0], a.v[1] <= b.v[1], a.v[2] <= b.v[2], a.v[3] <= b.v[3]}}; }
+inline MaskF4 CmpGtF4(VecF4 a, VecF4 b) { return MaskF4{{a.v[0] > b.v[0], a.v[1] > b.v[1], a.v[2] > b.v[2], a.v[3] > b.v[3]}}; }
+inline MaskF4 CmpGeF4(VecF4 a, VecF4 b) { return MaskF4{{a.v[0] >= b.v[0], a.v[1] >= b.v[1], a.v[2] >= b.v[2], a.v[3] >= b.v[3]}}; }
+inline MaskF4 AndMaskF4(MaskF4 a, MaskF4 b) { return MaskF4{{a.m[0] && b.m[0], a.m[1] && b.m[1], a.m[2] && b.m[2], a.m[3] && b.m[3]}}; }
+inline MaskF4 OrMaskF4(MaskF4 a, MaskF4 b) { return MaskF4{{a.m[0] || b.m[0], a.m[1] || b.m[1], a.m[2] || b.m[2], a.m[3] || b.m[3]}}; }
+inline MaskF4 TrueMaskF4() { return MaskF4{{true, true, true, true}}; }
+inline MaskF4 FalseMaskF4() { return MaskF4{{false, false, false, false}}; }
+/// Returns a where the mask is true, and b otherwise.
+inline VecF4 SelectF4(MaskF4 m, VecF4 a, VecF4 b) { return VecF4{{m.m[0] ? a.v[0] : b.v[0], m.m[1] ? a.v[1] : b.v[1], m.m[2] ? a.v[2] : b.v[2], m.m[3] ? a.v[3] : b.v[3]}}; }
+/// Returns the 4-bit integer mask, where bit i is set if lane i of the mask is true.
+inline int MoveMaskF4(MaskF4 m) { return (m.m[0] ? 1 : 0) | (m.m[1] ? 2 : 0) | (m.m[2] ? 4 : 0) | (m.m[3] ? 8 : 0); }
+
+/// Rounds the values down to the nearest integer. Same semantics as FastFloor:
+/// values whose magnitude is at least 2^23 have no fractional part and are returned as is.
+inline VecF4 FloorF4(VecF4 x)
+{
+    VecF4 r;
+    for (int i = 0; i < 4; ++i)
+    {
+        const float f = x.v[i];
+        if (f >= 8388608.f || f <= -8388608.f)
+        {
+            r.v[i] = f;
+        }
+        else
+        {
+            const float Trunc = static_cast<float>(static_cast<int>(f));
+            r.v[i]            = Trunc <= f ? Trunc : Trunc - 1.f;
+        }
+    }
+    return r;
+}
+/// Converts the values to integers, rounding toward zero, and stores them to p.
+inline void StoreI4(int* p, VecF4 v)
+{
+    for (int i = 0; i < 4; ++i)
+        p[i] = static_cast<int>(v.v[i]);
+}
+
+#endif
+
+
+/// Computes sin and cos of Angle in [-pi/4, pi/4] (Cephes sinf and cosf polynomials).
+inline void SinCosReducedF4(VecF4 Angle, VecF4& Sin, VecF4& Cos)
+{
+    const VecF4 a2 = MulF4(Angle, Angle);
+
+    VecF4 s = SetF4(-1.9515295891e-4f);
+    s       = AddF4(MulF4(s, a2), SetF4(8.3321608736e-3f));
+    s       = AddF4(MulF4(s, a2), SetF4(-1.6666654611e-1f));
+    Sin     = AddF4(MulF4(MulF4(s, a2), Angle), Angle);
+
+    VecF4 c = SetF4(2.443315711809948e-5f);
+    c       = AddF4(MulF4(c, a2), SetF4(-1.388731625493765e-3f));
+    c       = AddF4(MulF4(c, a2), SetF4(4.166664568298827e-2f));
+    Cos     = AddF4(SubF4(MulF4(MulF4(c, a2), a2), MulF4(a2, SetF4(0.5f))), SetF4(1.f));
+}
+
+/// Computes sin and cos of Angle.
+
+/// The angle is reduced to [-pi/4, pi/4] by subtracting the nearest multiple of pi/2
+/// split into three parts (Cody-Waite reduction), so the precision degrades for
+/// angles whose magnitude is much greater than a few thousand radians.
+inline void SinCosF4(VecF4 Angle, VecF4& Sin, VecF4& Cos)
+{
+    // Angle = q * pi/2 + r
+    const VecF4 q = FloorF4(AddF4(MulF4(Angle, SetF4(0.636619772367581343f)), SetF4(0.5f)));
+
+    VecF4 r = SubF4(Angle, MulF4(q, SetF4(1.5703125f)));
+    r       = SubF4(r, MulF4(q, SetF4(4.837512969970703125e-4f)));
+    r       = SubF4(r, MulF4(q, SetF4(7.54978995489188216e-8f)));
+
+    VecF4 SinR, CosR;
+    SinCosReducedF4(r, SinR, CosR);
+
+    // Quadrant index n = q mod 4:
+    //     n     sin(Angle)    cos(Angle)
+    //     0       sin(r)        cos(r)
+    //     1       cos(r)       -sin(r)
+    //     2      -sin(r)       -cos(r)
+    //     3      -cos(r)        sin(r)
+    const VecF4  n    = SubF4(q, MulF4(FloorF4(MulF4(q, SetF4(0.25f))), SetF4(4.f)));
+    const VecF4  Odd  = SubF4(n, MulF4(FloorF4(MulF4(n, SetF4(0.5f))), SetF4(2.f)));
+    const MaskF4 Swap = CmpGtF4(Odd, SetF4(0.5f));
+
+    const MaskF4 SinNeg = CmpGtF4(n, SetF4(1.5f));
+    const MaskF4 CosNeg = AndMaskF4(CmpGtF4(n, SetF4(0.5f)), CmpLtF4(n, SetF4(2.5f)));
+
+    Sin = MulF4(SelectF4(Swap, CosR, SinR), SelectF4(SinNeg, SetF4(-1.f), SetF4(1.f)));
+    Cos = MulF4(SelectF4(Swap, SinR, CosR), SelectF4(CosNeg, SetF4(-1.f), SetF4(1.f)));
+}
+
+
+/// Computes Out = v * M, where v is a row vector and M is a row-major 4x4 matrix.
+inline void MulVector4Matrix4x4(const float* v, const float* M, float* Out)
+{
+    VecF4 R = MulF4(LoadSplatF4(v + 0), LoadF4(M + 0));
+    R       = AddF4(R, MulF4(LoadSplatF4(v + 1), LoadF4(M + 4)));
+    R       = AddF4(R, MulF4(LoadSplatF4(v + 2), LoadF4(M + 8)));
+    R       = AddF4(R, MulF4(LoadSplatF4(v + 3), LoadF4(M + 12)));
+    StoreF4(Out, R);
+}
+
+/// Computes Out = M * v, where M is a row-major 4x4 matrix and v is a column vector.
+inline void MulMatrix4x4Vector4(const float* M, const float* v, float* Out)
+{
+    // Transpose the matrix so that the result is computed as a linear combination
+    // of columns, which avoids horizontal additions and keeps the scalar order of operations.
+    VecF4 C0 = LoadF4(M + 0);
+    VecF4 C1 = LoadF4(M + 4);
+    VecF4 C2 = LoadF4(M + 8);
+    VecF4 C3 = LoadF4(M + 12);
+    TransposeF4(C0, C1, C2, C3);
+
+    VecF4 R = MulF4(C0, LoadSplatF4(v + 0));
+    R       = AddF4(R, MulF4(C1, LoadSplatF4(v + 1)));
+    R       = AddF4(R, MulF4(C2, LoadSplatF4(v + 2)));
+    R       = AddF4(R, MulF4(C3, LoadSplatF4(v + 3)));
+    StoreF4(Out, R);
+}
+
+/// Computes Out = A * B, where all matrices are row-major 4x4 matrices.
+/// Out may alias A or B.
+inline void MulMatrix4x4(const float* A, const float* B, float* Out)
+{
+#if DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_AVX
+    // Process two rows of A at a time: the lower 128 bits hold row 2*i, the upper - row 2*i+1.
+    const __m128 b0 = _mm_loadu_ps(B + 0);
+    const __m128 b1 = _mm_loadu_ps(B + 4);
+    const __m128 b2 = _mm_loadu_ps(B + 8);
+    const __m128 b3 = _mm_loadu_ps(B + 12);
+
+    const __m256 B0 = _mm256_insertf128_ps(_mm256_castps128_ps256(b0), b0, 1);
+    const __m256 B1 = _mm256_insertf128_ps(_mm256_castps128_ps256(b1), b1, 1);
+    const __m256 B2 = _mm256_insertf128_ps(_mm256_castps128_ps256(b2), b2, 1);
+    const __m256 B3 = _mm256_insertf128_ps(_mm256_castps128_ps256(b3), b3, 1);
+
+    const __m256 A01 = _mm256_loadu_ps(A + 0);
+    const __m256 A23 = _mm256_loadu_ps(A + 8);
+
+    __m256 R01 = _mm256_mul_ps(_mm256_shuffle_ps(A01, A01, 0x00), B0);
+    R01        = _mm256_add_ps(R01, _mm256_mul_ps(_mm256_shuffle_ps(A01, A01, 0x55), B1));
+    R01        = _mm256_add_ps(R01, _mm256_mul_ps(_mm256_shuffle_ps(A01, A01, 0xAA), B2));
+    R01        = _mm256_add_ps(R01, _mm256_mul_ps(_mm256_shuffle_ps(A01, A01, 0xFF), B3));
+
+    __m256 R23 = _mm256_mul_ps(_mm256_shuffle_ps(A23, A23, 0x00), B0);
+    R23        = _mm256_add_ps(R23, _mm256_mul_ps(_mm256_shuffle_ps(A23, A23, 0x55), B1));
+    R23        = _mm256_add_ps(R23, _mm256_mul_ps(_mm256_shuffle_ps(A23, A23, 0xAA), B2));
+    R23        = _mm256_add_ps(R23, _mm256_mul_ps(_mm256_shuffle_ps(A23, A23, 0xFF), B3));
+
+    _mm256_storeu_ps(Out + 0, R01);
+    _mm256_storeu_ps(Out + 8, R23);
+#else
+    const VecF4 B0 = LoadF4(B + 0);
+    const VecF4 B1 = LoadF4(B + 4);
+    const VecF4 B2 = LoadF4(B + 8);
+    const VecF4 B3 = LoadF4(B + 12);
+
+    // Row i of A is read before row i of Out is written, so in-place multiplication is safe.
+    for (int i = 0; i < 4; ++i)
+    {
+        const float* Ai = A + i * 4;
+
+        VecF4 R = MulF4(LoadSplatF4(Ai + 0), B0);
+        R       = AddF4(R, MulF4(LoadSplatF4(Ai + 1), B1));
+        R       = AddF4(R, MulF4(LoadSplatF4(Ai + 2), B2));
+        R       = AddF4(R, MulF4(LoadSplatF4(Ai + 3), B3));
+        StoreF4(Out + i * 4, R);
+    }
+#endif
+}
+
+} // namespace MathSIMD
+
+} // namespace Diligent
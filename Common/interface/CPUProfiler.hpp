@@ -0,0 +1,279 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Lightweight scoped CPU profiler with Chrome trace export.
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+#ifndef DILIGENT_CPU_PROFILER_ENABLED
+#    define DILIGENT_CPU_PROFILER_ENABLED 0
+#endif
+
+namespace Diligent
+{
+
+/// CPU profiler event.
+struct CPUProfilerEvent
+{
+    /// Event name. Must be a string with static storage duration (e.g. a string literal).
+    const Char* Name = nullptr;
+
+    /// Event category. Must be a string with static storage duration (e.g. a string literal).
+    const Char* Category = nullptr;
+
+    /// Begin time, in nanoseconds since the profiler start.
+    Uint64 BeginTime = 0;
+
+    /// End time, in nanoseconds since the profiler start.
+    Uint64 EndTime = 0;
+};
+
+/// CPU profiler zone callbacks.
+
+/// The callbacks can be used to forward profiling zones to external telemetry
+/// or third-party profilers. They are called from the threads that execute the zones
+/// and must be thread-safe.
+class CPUProfilerCallbacks
+{
+public:
+    virtual ~CPUProfilerCallbacks() {}
+
+    /// Called when a profiling zone is entered.
+    virtual void OnZoneBegin(const Char* Name, const Char* Category) = 0;
+
+    /// Called when a profiling zone is exited. The times are in nanoseconds since the profiler start.
+    virtual void OnZoneEnd(const Char* Name, const Char* Category, Uint64 BeginTime, Uint64 EndTime) = 0;
+};
+
+/// Thread-safe CPU profiler.
+
+/// Every thread records events into its own ring buffer. When a buffer is full,
+/// the oldest events are overwritten. The recorded events can be exported to
+/// the Chrome trace event format that can be viewed in chrome://tracing or Perfetto UI.
+///
+/// When a thread exits, its ring buffer is shrunk to the recorded events. The events of the
+/// exited threads are kept up to the ring buffer size in total: when a new thread starts recording,
+/// the buffers of the threads that exited earliest are released. Clear() releases all of them.
+///
+/// The profiler is disabled by default and can be enabled at run time with SetEnabled().
+/// Profiling zones defined with the DILIGENT_PROFILE_SCOPE macros are compiled out
+/// unless DILIGENT_CPU_PROFILER_ENABLED is defined as 1 (see DILIGENT_ENABLE_CPU_PROFILER CMake option).
+class CPUProfiler
+{
+public:
+    static constexpr Uint32 DefaultRingBufferSize = 16384;
+
+    /// Returns the global profiler instance.
+    static CPUProfiler& Get();
+
+    CPUProfiler();
+    ~CPUProfiler();
+
+    // clang-format off
+    CPUProfiler           (const CPUProfiler&)  = delete;
+    CPUProfiler           (      CPUProfiler&&) = delete;
+    CPUProfiler& operator=(const CPUProfiler&)  = delete;
+    CPUProfiler& operator=(      CPUProfiler&&) = delete;
+    // clang-format on
+
+    void SetEnabled(bool Enabled) { m_Enabled.store(Enabled, std::memory_order_relaxed); }
+
+    bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+    /// Sets the callbacks that are called for every profiling zone, regardless of
+    /// whether the profiler itself is enabled. Pass null to remove the callbacks.
+
+    /// \remarks   The application must keep the callbacks object alive until all zones
+    ///             that started while it was set have ended.
+    void SetCallbacks(CPUProfilerCallbacks* pCallbacks) { m_pCallbacks.store(pCallbacks, std::memory_order_release); }
+
+    CPUProfilerCallbacks* GetCallbacks() const { return m_pCallbacks.load(std::memory_order_acquire); }
+
+    /// Returns true if profiling zones need to be tracked, i.e. if the profiler
+    /// is enabled or the callbacks are set.
+    bool IsActive() const { return IsEnabled() || GetCallbacks() != nullptr; }
+
+    /// Sets the number of events in the ring buffers of the threads that
+    /// record their first event after this call.
+    void SetRingBufferSize(Uint32 NumEvents);
+
+    /// Returns the time, in nanoseconds, elapsed since the profiler was created.
+    Uint64 GetTime() const;
+
+    /// Records an event in the calling thread's ring buffer.
+    void RecordEvent(const Char* Name, const Char* Category, Uint64 BeginTime, Uint64 EndTime);
+
+    /// Sets the name of the calling thread that is shown in the trace.
+    void SetThreadName(const Char* Name);
+
+    /// Copies all recorded events of all threads.
+
+    /// \param [in] Callback - Callback that is called for every thread with
+    ///                        the thread index, the thread name and the events
+    ///                        ordered from the oldest to the newest.
+    template <typename CallbackType>
+    void ProcessEvents(CallbackType&& Callback) const;
+
+    /// Returns the total number of recorded events in all threads.
+    size_t GetNumEvents() const;
+
+    /// Removes all recorded events.
+    void Clear();
+
+    /// Exports the recorded events as a Chrome trace event format JSON string.
+    std::string ExportChromeTrace() const;
+
+    /// Writes the recorded events to a Chrome trace event format JSON file.
+    bool ExportChromeTrace(const Char* FilePath) const;
+
+private:
+    struct ThreadEvents;
+    struct ThreadEventsOwner;
+
+    ThreadEvents& GetThreadEvents();
+
+    void GetAllThreadEvents(std::vector<std::shared_ptr<ThreadEvents>>& Threads) const;
+
+    // Releases the buffers of the threads that have exited, except for the most recently
+    // exited threads whose events fit into MaxDeadEvents. m_ThreadsMtx must be locked.
+    void ReleaseDeadThreads(size_t MaxDeadEvents);
+
+    // Copies the events of a single thread ordered from the oldest to the newest.
+    static void CopyEvents(ThreadEvents& Thread, std::string& Name, std::vector<CPUProfilerEvent>& Events);
+
+private:
+    std::atomic<bool>   m_Enabled{false};
+    std::atomic<Uint32> m_RingBufferSize{DefaultRingBufferSize};
+
+    std::atomic<CPUProfilerCallbacks*> m_pCallbacks{nullptr};
+
+    const Uint64 m_StartTime;
+
+    // Unique profiler identifier that is used to validate thread-local data
+    const Uint32 m_ProfilerId;
+
+    mutable std::mutex                         m_ThreadsMtx;
+    std::vector<std::shared_ptr<ThreadEvents>> m_Threads;
+    Uint32                                     m_NextThreadIdx = 0;
+};
+
+template <typename CallbackType>
+void CPUProfiler::ProcessEvents(CallbackType&& Callback) const
+{
+    std::vector<std::shared_ptr<ThreadEvents>> Threads;
+    GetAllThreadEvents(Threads);
+
+    std::string                   ThreadName;
+    std::vector<CPUProfilerEvent> Events;
+    for (size_t i = 0; i < Threads.size(); ++i)
+    {
+        CopyEvents(*Threads[i], ThreadName, Events);
+        Callback(static_cast<Uint32>(i), ThreadName, Events);
+    }
+}
+
+
+/// Records a CPU profiler event for the lifetime of the object
+/// and notifies the profiler callbacks, if any.
+class ScopedCPUProfilerZone
+{
+public:
+    ScopedCPUProfilerZone(const Char* Name, const Char* Category = nullptr, CPUProfiler& Profiler = CPUProfiler::Get()) :
+        m_Profiler{Profiler.IsActive() ? &Profiler : nullptr},
+        m_pCallbacks{m_Profiler != nullptr ? m_Profiler->GetCallbacks() : nullptr},
+        m_Name{Name},
+        m_Category{Category},
+        m_BeginTime{m_Profiler != nullptr ? m_Profiler->GetTime() : 0}
+    {
+        if (m_pCallbacks != nullptr)
+            m_pCallbacks->OnZoneBegin(m_Name, m_Category);
+    }
+
+    ~ScopedCPUProfilerZone()
+    {
+        if (m_Profiler == nullptr)
+            return;
+
+        const auto EndTime = m_Profiler->GetTime();
+        if (m_Profiler->IsEnabled())
+            m_Profiler->RecordEvent(m_Name, m_Category, m_BeginTime, EndTime);
+        if (m_pCallbacks != nullptr)
+            m_pCallbacks->OnZoneEnd(m_Name, m_Category, m_BeginTime, EndTime);
+    }
+
+    // clang-format off
+    ScopedCPUProfilerZone           (const ScopedCPUProfilerZone&)  = delete;
+    ScopedCPUProfilerZone           (      ScopedCPUProfilerZone&&) = delete;
+    ScopedCPUProfilerZone& operator=(const ScopedCPUProfilerZone&)  = delete;
+    ScopedCPUProfilerZone& operator=(      ScopedCPUProfilerZone&&) = delete;
+    // clang-format on
+
+private:
+    CPUProfiler* const          m_Profiler;
+    CPUProfilerCallbacks* const m_pCallbacks;
+    const Char* const           m_Name;
+    const Char* const           m_Category;
+    const Uint64                m_BeginTime;
+};
+
+} // namespace Diligent
+
+#if DILIGENT_CPU_PROFILER_ENABLED
+#    define DILIGENT_PROFILE_CONCAT_IMPL(a, b) a##b
+#    define DILIGENT_PROFILE_CONCAT(a, b)      DILIGENT_PROFILE_CONCAT_IMPL(a, b)
+#    define DILIGENT_PROFILE_SCOPE_CAT(Name, Category) \
+        ::Diligent::ScopedCPUProfilerZone DILIGENT_PROFILE_CONCAT(_ProfilerZone, __LINE__) { Name, Category }
+#    define DILIGENT_PROFILE_SCOPE(Name)           DILIGENT_PROFILE_SCOPE_CAT(Name, nullptr)
+#    define DILIGENT_PROFILE_FUNCTION()            DILIGENT_PROFILE_SCOPE(__FUNCTION__)
+#    define DILIGENT_PROFILE_SET_THREAD_NAME(Name) ::Diligent::CPUProfiler::Get().SetThreadName(Name)
+#else
+#    define DILIGENT_PROFILE_SCOPE_CAT(Name, Category) \
+        do                                             \
+        {                                              \
+        } while (false)
+#    define DILIGENT_PROFILE_SCOPE(Name) \
+        do                               \
+        {                                \
+        } while (false)
+#    define DILIGENT_PROFILE_FUNCTION() \
+        do                              \
+        {                               \
+        } while (false)
+#    define DILIGENT_PROFILE_SET_THREAD_NAME(Name) \
+        do                                         \
+        {                                          \
+        } while (false)
+#endif
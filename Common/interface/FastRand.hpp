@@ -28,7 +28,9 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 
+#include "../../Primitives/interface/BasicTypes.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 
 namespace Diligent
@@ -115,4 +117,52 @@ private:
     const int Range;
 };
 
+
+/// Random number generator that produces values in bulk.
+///
+/// The generator runs four xoshiro128++ streams side by side and advances them
+/// simultaneously with SIMD instructions. Each stream is a non-overlapping
+/// 2^64-long subsequence of the xoshiro128++ sequence.
+///
+/// The generator is not thread-safe. To generate random numbers in parallel,
+/// create one generator per thread with the same seed and distinct stream indices:
+/// the sequences produced by different streams do not overlap.
+///
+/// \note  Generation functions always consume random numbers in groups of four
+///        and discard the unused ones, so the sequence depends on the
+///        sizes of the requested arrays.
+class FastRandBatch
+{
+public:
+    /// Initializes the generator.
+    ///
+    /// \param [in] Seed   - Random seed.
+    /// \param [in] Stream - Stream index, for example the worker thread index.
+    ///                      Generators with the same seed and different stream
+    ///                      indices produce non-overlapping sequences.
+    ///                      Initialization time is proportional to the stream index.
+    explicit FastRandBatch(Uint64 Seed, Uint32 Stream = 0) noexcept;
+
+    /// Fills the array with uniformly distributed 32-bit unsigned integers.
+    void GenerateUint(Uint32* pValues, size_t Count);
+
+    /// Fills the array with integers uniformly distributed in [Min, Max] range.
+    void GenerateInt(int* pValues, size_t Count, int Min, int Max);
+
+    /// Fills the array with real numbers uniformly distributed in [Min, Max) range.
+    void GenerateFloat(float* pValues, size_t Count, float Min = 0, float Max = 1);
+
+    /// Fills the array with normally distributed real numbers.
+    ///
+    /// The values are generated by the Box-Muller transform, which is evaluated
+    /// with SIMD instructions using polynomial approximations of log, sin and cos.
+    void GenerateNormal(float* pValues, size_t Count, float Mean = 0, float StdDev = 1);
+
+    static constexpr size_t NumLanes = 4;
+
+private:
+    // State word-major layout: m_State[Word][Lane]
+    alignas(16) Uint32 m_State[4][NumLanes];
+};
+
 } // namespace Diligent
@@ -30,6 +30,7 @@
 #include "../../Platforms/interface/PlatformDefinitions.h"
 
 #include "BasicMath.hpp"
+#include "BasicMathSIMD.hpp"
 
 #include "../../Graphics/GraphicsEngine/interface/Sampler.h"
 
@@ -173,6 +174,126 @@ inline void _DbgVerifyFilterInfo<TEXTURE_ADDRESS_UNKNOWN>(const LinearTexFilterS
 }
 #endif
 
+/// Constants used by the batch versions of GetLinearTexFilterSampleInfo.
+struct _LinearTexFilterConstantsF4
+{
+    MathSIMD::VecF4 Width;
+    MathSIMD::VecF4 InvWidth;
+    MathSIMD::VecF4 MaxIndex;
+    MathSIMD::VecF4 DoubleWidth;
+    MathSIMD::VecF4 InvDoubleWidth;
+
+    explicit _LinearTexFilterConstantsF4(Uint32 _Width) :
+        // clang-format off
+        Width         {MathSIMD::SetF4(static_cast<float>(_Width))},
+        InvWidth      {MathSIMD::SetF4(1.f / static_cast<float>(_Width))},
+        MaxIndex      {MathSIMD::SetF4(static_cast<float>(_Width - 1))},
+        DoubleWidth   {MathSIMD::SetF4(static_cast<float>(_Width * 2))},
+        InvDoubleWidth{MathSIMD::SetF4(0.5f / static_cast<float>(_Width))}
+    // clang-format on
+    {}
+};
+
+/// Wraps integer-valued coordinates i to [0, Width - 1].
+///
+/// The quotient computed with the reciprocal may be off by one, which is corrected by the two
+/// selects. All intermediate values are exact as long as |i| < 2^24.
+inline MathSIMD::VecF4 _WrapCoordF4(MathSIMD::VecF4 i, MathSIMD::VecF4 Width, MathSIMD::VecF4 InvWidth)
+{
+    using namespace MathSIMD;
+
+    VecF4 r = SubF4(i, MulF4(FloorF4(MulF4(i, InvWidth)), Width));
+    r       = SelectF4(CmpLtF4(r, SetF4(0.f)), AddF4(r, Width), r);
+    r       = SelectF4(CmpGeF4(r, Width), SubF4(r, Width), r);
+    return r;
+}
+
+/// Computes linear texture filter sample info for four coordinates at once.
+/// Sample indices are written to i0 and i1, and the blend weights are returned.
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+MathSIMD::VecF4 _GetLinearTexFilterSampleInfoF4(const _LinearTexFilterConstantsF4& Consts, MathSIMD::VecF4 u, Int32* i0, Int32* i1)
+{
+    using namespace MathSIMD;
+
+    const VecF4 x  = IsNormalizedCoord ? MulF4(u, Consts.Width) : u;
+    const VecF4 xc = SubF4(x, SetF4(0.5f));
+    const VecF4 x0 = FloorF4(xc);
+    const VecF4 w  = SubF4(xc, x0);
+
+    VecF4 fi0 = x0;
+    VecF4 fi1 = AddF4(x0, SetF4(1.f));
+    switch (AddressMode)
+    {
+        case TEXTURE_ADDRESS_UNKNOWN:
+            // do nothing
+            break;
+
+        case TEXTURE_ADDRESS_WRAP:
+            fi0 = _WrapCoordF4(fi0, Consts.Width, Consts.InvWidth);
+            fi1 = _WrapCoordF4(fi1, Consts.Width, Consts.InvWidth);
+            break;
+
+        case TEXTURE_ADDRESS_MIRROR:
+        {
+            const VecF4 MirrorBase = SubF4(Consts.DoubleWidth, SetF4(1.f));
+
+            fi0 = _WrapCoordF4(fi0, Consts.DoubleWidth, Consts.InvDoubleWidth);
+            fi1 = _WrapCoordF4(fi1, Consts.DoubleWidth, Consts.InvDoubleWidth);
+            fi0 = SelectF4(CmpGeF4(fi0, Consts.Width), SubF4(MirrorBase, fi0), fi0);
+            fi1 = SelectF4(CmpGeF4(fi1, Consts.Width), SubF4(MirrorBase, fi1), fi1);
+            break;
+        }
+
+        case TEXTURE_ADDRESS_CLAMP:
+            fi0 = MinF4(MaxF4(fi0, SetF4(0.f)), Consts.MaxIndex);
+            fi1 = MinF4(MaxF4(fi1, SetF4(0.f)), Consts.MaxIndex);
+            break;
+
+        default:
+            UNEXPECTED("Unexpected texture address mode");
+    }
+
+    StoreI4(i0, fi0);
+    StoreI4(i1, fi1);
+
+    return w;
+}
+
+/// Computes linear texture filter sample info for an array of coordinates, see Diligent::LinearTexFilterSampleInfo.
+///
+/// \tparam AddressMode       - Texture addressing mode, see Diligent::TEXTURE_ADDRESS_MODE.
+/// \tparam IsNormalizedCoord - Whether sample coordinates are normalized.
+///
+/// \param [in]  Width        - Texture width.
+/// \param [in]  pu           - Array of NumSamples texture sample coordinates.
+/// \param [in]  NumSamples   - The number of samples.
+/// \param [out] pSampleInfo  - Array of NumSamples elements that receives the sample information.
+///
+/// \remarks   Four coordinates are processed at a time using SIMD instructions. The results are
+///            identical to the ones returned by the scalar version of the function as long as
+///            unnormalized coordinates are within (-2^23, 2^23).
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void GetLinearTexFilterSampleInfo(Uint32                     Width,
+                                  const float*               pu,
+                                  size_t                     NumSamples,
+                                  LinearTexFilterSampleInfo* pSampleInfo)
+{
+    const _LinearTexFilterConstantsF4 Consts{Width};
+
+    size_t s = 0;
+    for (; s + 4 <= NumSamples; s += 4)
+    {
+        Int32 i0[4], i1[4];
+        float w[4];
+        MathSIMD::StoreF4(w, _GetLinearTexFilterSampleInfoF4<AddressMode, IsNormalizedCoord>(Consts, MathSIMD::LoadF4(pu + s), i0, i1));
+        for (size_t i = 0; i < 4; ++i)
+            pSampleInfo[s + i] = LinearTexFilterSampleInfo{i0[i], i1[i], w[i]};
+    }
+
+    for (; s < NumSamples; ++s)
+        pSampleInfo[s] = GetLinearTexFilterSampleInfo<AddressMode, IsNormalizedCoord>(Width, pu[s]);
+}
+
 /// Samples 2D texture using bilinear filter.
 ///
 /// \tparam SrcType           - Source pixel type.
@@ -245,4 +366,151 @@ DstType FilterTexture2DBilinearClampUC(Uint32         Width,
     return FilterTexture2DBilinear<SrcType, DstType, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, false>(Width, Height, pData, Stride, u, v);
 }
 
+/// Blends four bilinear samples. Generic version that works with any destination type.
+template <typename SrcType, typename DstType>
+void _BlendBilinearSamplesF4(const SrcType*  pData,
+                             size_t          Stride,
+                             const Int32*    ui0,
+                             const Int32*    ui1,
+                             MathSIMD::VecF4 uw,
+                             const Int32*    vi0,
+                             const Int32*    vi1,
+                             MathSIMD::VecF4 vw,
+                             DstType*        pDst)
+{
+    float UW[4], VW[4];
+    MathSIMD::StoreF4(UW, uw);
+    MathSIMD::StoreF4(VW, vw);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        auto S00 = static_cast<DstType>(pData[ui0[i] + vi0[i] * Stride]);
+        auto S10 = static_cast<DstType>(pData[ui1[i] + vi0[i] * Stride]);
+        auto S01 = static_cast<DstType>(pData[ui0[i] + vi1[i] * Stride]);
+        auto S11 = static_cast<DstType>(pData[ui1[i] + vi1[i] * Stride]);
+        pDst[i]  = lerp(lerp(S00, S10, UW[i]), lerp(S01, S11, UW[i]), VW[i]);
+    }
+}
+
+/// Blends four bilinear samples. Float destination version that blends all samples with SIMD instructions.
+template <typename SrcType>
+void _BlendBilinearSamplesF4(const SrcType*  pData,
+                             size_t          Stride,
+                             const Int32*    ui0,
+                             const Int32*    ui1,
+                             MathSIMD::VecF4 uw,
+                             const Int32*    vi0,
+                             const Int32*    vi1,
+                             MathSIMD::VecF4 vw,
+                             float*          pDst)
+{
+    using namespace MathSIMD;
+
+    const SrcType* pRow0[4] = {pData + vi0[0] * Stride, pData + vi0[1] * Stride, pData + vi0[2] * Stride, pData + vi0[3] * Stride};
+    const SrcType* pRow1[4] = {pData + vi1[0] * Stride, pData + vi1[1] * Stride, pData + vi1[2] * Stride, pData + vi1[3] * Stride};
+
+    // clang-format off
+    const VecF4 S00 = SetF4(static_cast<float>(pRow0[0][ui0[0]]), static_cast<float>(pRow0[1][ui0[1]]), static_cast<float>(pRow0[2][ui0[2]]), static_cast<float>(pRow0[3][ui0[3]]));
+    const VecF4 S10 = SetF4(static_cast<float>(pRow0[0][ui1[0]]), static_cast<float>(pRow0[1][ui1[1]]), static_cast<float>(pRow0[2][ui1[2]]), static_cast<float>(pRow0[3][ui1[3]]));
+    const VecF4 S01 = SetF4(static_cast<float>(pRow1[0][ui0[0]]), static_cast<float>(pRow1[1][ui0[1]]), static_cast<float>(pRow1[2][ui0[2]]), static_cast<float>(pRow1[3][ui0[3]]));
+    const VecF4 S11 = SetF4(static_cast<float>(pRow1[0][ui1[0]]), static_cast<float>(pRow1[1][ui1[1]]), static_cast<float>(pRow1[2][ui1[2]]), static_cast<float>(pRow1[3][ui1[3]]));
+    // clang-format on
+
+    // Same operations as lerp(): Left * (1 - w) + Right * w
+    const VecF4 One  = SetF4(1.f);
+    const VecF4 uw1  = SubF4(One, uw);
+    const VecF4 Row0 = AddF4(MulF4(S00, uw1), MulF4(S10, uw));
+    const VecF4 Row1 = AddF4(MulF4(S01, uw1), MulF4(S11, uw));
+    StoreF4(pDst, AddF4(MulF4(Row0, SubF4(One, vw)), MulF4(Row1, vw)));
+}
+
+/// Samples 2D texture at multiple locations using bilinear filter.
+///
+/// \tparam SrcType           - Source pixel type.
+/// \tparam DstType           - Destination type.
+/// \tparam AddressModeU      - U coordinate address mode.
+/// \tparam AddressModeV      - V coordinate address mode.
+/// \tparam IsNormalizedCoord - Whether sample coordinates are normalized.
+///
+/// \param [in]  Width        - Texture width.
+/// \param [in]  Height       - Texture height.
+/// \param [in]  pData        - Pointer to the texture data.
+/// \param [in]  Stride       - Data stride, in pixels.
+/// \param [in]  pu           - Array of NumSamples u coordinates.
+/// \param [in]  pv           - Array of NumSamples v coordinates.
+/// \param [in]  NumSamples   - The number of samples.
+/// \param [out] pDst         - Array of NumSamples elements that receives the filtered samples.
+///
+/// \remarks   Sample information is computed for four samples at a time using SIMD instructions.
+///            When DstType is float, the samples are also blended with SIMD instructions.
+///            Otherwise, the samples are blended the same way as FilterTexture2DBilinear does.
+template <typename SrcType,
+          typename DstType,
+          TEXTURE_ADDRESS_MODE AddressModeU,
+          TEXTURE_ADDRESS_MODE AddressModeV,
+          bool                 IsNormalizedCoord>
+void FilterTexture2DBilinear(Uint32         Width,
+                             Uint32         Height,
+                             const SrcType* pData,
+                             size_t         Stride,
+                             const float*   pu,
+                             const float*   pv,
+                             size_t         NumSamples,
+                             DstType*       pDst)
+{
+    const _LinearTexFilterConstantsF4 UConsts{Width};
+    const _LinearTexFilterConstantsF4 VConsts{Height};
+
+    size_t s = 0;
+    for (; s + 4 <= NumSamples; s += 4)
+    {
+        Int32 ui0[4], ui1[4], vi0[4], vi1[4];
+
+        const MathSIMD::VecF4 uw = _GetLinearTexFilterSampleInfoF4<AddressModeU, IsNormalizedCoord>(UConsts, MathSIMD::LoadF4(pu + s), ui0, ui1);
+        const MathSIMD::VecF4 vw = _GetLinearTexFilterSampleInfoF4<AddressModeV, IsNormalizedCoord>(VConsts, MathSIMD::LoadF4(pv + s), vi0, vi1);
+
+#ifdef DILIGENT_DEBUG
+        for (size_t i = 0; i < 4; ++i)
+        {
+            _DbgVerifyFilterInfo<AddressModeU>(LinearTexFilterSampleInfo{ui0[i], ui1[i], 0}, Width, "horizontal", pu[s + i]);
+            _DbgVerifyFilterInfo<AddressModeV>(LinearTexFilterSampleInfo{vi0[i], vi1[i], 0}, Height, "vertical", pv[s + i]);
+        }
+#endif
+
+        _BlendBilinearSamplesF4(pData, Stride, ui0, ui1, uw, vi0, vi1, vw, pDst + s);
+    }
+
+    for (; s < NumSamples; ++s)
+        pDst[s] = FilterTexture2DBilinear<SrcType, DstType, AddressModeU, AddressModeV, IsNormalizedCoord>(Width, Height, pData, Stride, pu[s], pv[s]);
+}
+
+/// Specialization of the batch FilterTexture2DBilinear function that uses CLAMP texture address mode
+/// and takes normalized texture coordinates.
+template <typename SrcType, typename DstType>
+void FilterTexture2DBilinearClamp(Uint32         Width,
+                                  Uint32         Height,
+                                  const SrcType* pData,
+                                  size_t         Stride,
+                                  const float*   pu,
+                                  const float*   pv,
+                                  size_t         NumSamples,
+                                  DstType*       pDst)
+{
+    FilterTexture2DBilinear<SrcType, DstType, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, true>(Width, Height, pData, Stride, pu, pv, NumSamples, pDst);
+}
+
+/// Specialization of the batch FilterTexture2DBilinear function that uses CLAMP texture address mode
+/// and takes unnormalized texture coordinates.
+template <typename SrcType, typename DstType>
+void FilterTexture2DBilinearClampUC(Uint32         Width,
+                                    Uint32         Height,
+                                    const SrcType* pData,
+                                    size_t         Stride,
+                                    const float*   pu,
+                                    const float*   pv,
+                                    size_t         NumSamples,
+                                    DstType*       pDst)
+{
+    FilterTexture2DBilinear<SrcType, DstType, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, false>(Width, Height, pData, Stride, pu, pv, NumSamples, pDst);
+}
+
 } // namespace Diligent
@@ -0,0 +1,134 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Conversion between 32-bit and 16-bit (half-precision) floating point values.
+///
+/// All conversions round to the nearest even value. Values that are too large
+/// for half precision are converted to infinity, and NaNs are preserved.
+
+#include <cstddef>
+#include <cstring>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Converts a 32-bit floating point value to a 16-bit floating point value.
+inline Uint16 Float32ToFloat16(float f) noexcept
+{
+    Uint32 x = 0;
+    std::memcpy(&x, &f, sizeof(x));
+
+    const Uint32 Sign = x & 0x80000000u;
+    x ^= Sign;
+
+    Uint32 h = 0;
+    if (x >= 0x47800000u)
+    {
+        // Infinity or NaN (all exponent bits set)
+        h = x > 0x7F800000u ? 0x7E00u : 0x7C00u;
+    }
+    else if (x < 0x38800000u)
+    {
+        // Subnormal or zero: use the magic value to align 10 mantissa bits at
+        // the bottom of the float, which also rounds the mantissa.
+        constexpr Uint32 DenormMagicBits = ((127 - 15) + (23 - 10) + 1) << 23;
+
+        float DenormMagic = 0;
+        std::memcpy(&DenormMagic, &DenormMagicBits, sizeof(DenormMagic));
+
+        float fx = 0;
+        std::memcpy(&fx, &x, sizeof(fx));
+        fx += DenormMagic;
+        std::memcpy(&x, &fx, sizeof(x));
+        h = x - DenormMagicBits;
+    }
+    else
+    {
+        const Uint32 MantOdd = (x >> 13) & 1u;
+        // Rebias the exponent and round the mantissa
+        x += (static_cast<Uint32>(15 - 127) << 23) + 0xFFFu;
+        x += MantOdd;
+        h = x >> 13;
+    }
+
+    return static_cast<Uint16>(h | (Sign >> 16));
+}
+
+/// Converts a 16-bit floating point value to a 32-bit floating point value.
+inline float Float16ToFloat32(Uint16 h) noexcept
+{
+    constexpr Uint32 ShiftedExp = 0x7C00u << 13;
+
+    Uint32       x   = (h & 0x7FFFu) << 13;
+    const Uint32 Exp = x & ShiftedExp;
+    x += (127 - 15) << 23;
+    float f = 0;
+    if (Exp == ShiftedExp)
+    {
+        // Infinity or NaN
+        x += (128 - 16) << 23;
+        std::memcpy(&f, &x, sizeof(f));
+    }
+    else if (Exp == 0)
+    {
+        // Zero or subnormal: renormalize
+        constexpr Uint32 MagicBits = 113 << 23;
+
+        float Magic = 0;
+        std::memcpy(&Magic, &MagicBits, sizeof(Magic));
+        x += 1 << 23;
+        std::memcpy(&f, &x, sizeof(f));
+        f -= Magic;
+    }
+    else
+    {
+        std::memcpy(&f, &x, sizeof(f));
+    }
+
+    if (h & 0x8000u)
+        f = -f;
+    return f;
+}
+
+/// Converts an array of 32-bit floating point values to 16-bit floating point values.
+///
+/// \remarks    The function uses F16C instructions on x86 when they are enabled by the
+///             compiler, SSE2 integer arithmetic otherwise, and conversion instructions
+///             on ARM64. The results are identical to the ones of the scalar version,
+///             except for the NaN payloads.
+void Float32ToFloat16(const float* pSrc, Uint16* pDst, size_t Count);
+
+/// Converts an array of 16-bit floating point values to 32-bit floating point values.
+///
+/// \remarks    See remarks for Float32ToFloat16.
+void Float16ToFloat32(const Uint16* pSrc, float* pDst, size_t Count);
+
+} // namespace Diligent
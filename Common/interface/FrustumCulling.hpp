@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Batched view frustum culling of bounding boxes stored in structure-of-arrays layout.
+
+#include "AdvancedMath.hpp"
+
+namespace Diligent
+{
+
+class IThreadPool;
+
+/// Axis-aligned bounding boxes stored in structure-of-arrays layout.
+
+/// Every member points to an array of BatchBoxVisibilityAttribs::NumBoxes floats.
+/// The i-th box is {MinX[i], MinY[i], MinZ[i]} - {MaxX[i], MaxY[i], MaxZ[i]}.
+struct BoundBoxSOA
+{
+    const float* MinX = nullptr;
+    const float* MinY = nullptr;
+    const float* MinZ = nullptr;
+    const float* MaxX = nullptr;
+    const float* MaxY = nullptr;
+    const float* MaxZ = nullptr;
+};
+
+/// Oriented bounding boxes stored in structure-of-arrays layout.
+
+/// Every member points to an array of BatchBoxVisibilityAttribs::NumBoxes floats.
+/// The i-th box is defined the same way as OrientedBoundingBox:
+///
+///     Center      = {CenterX[i], CenterY[i], CenterZ[i]}
+///     Axes[a]     = {AxisX[a][i], AxisY[a][i], AxisZ[a][i]}
+///     HalfExtents = {HalfExtents[0][i], HalfExtents[1][i], HalfExtents[2][i]}
+struct OrientedBoundingBoxSOA
+{
+    const float* CenterX = nullptr;
+    const float* CenterY = nullptr;
+    const float* CenterZ = nullptr;
+
+    const float* AxisX[3] = {};
+    const float* AxisY[3] = {};
+    const float* AxisZ[3] = {};
+
+    const float* HalfExtents[3] = {};
+};
+
+/// Batched box visibility test attributes.
+struct BatchBoxVisibilityAttribs
+{
+    /// The number of boxes to test.
+    size_t NumBoxes = 0;
+
+    /// Output visibility bit mask, must contain at least (NumBoxes + 31) / 32 elements.
+
+    /// Bit (i % 32) of the element i / 32 is set if the i-th box is not
+    /// BoxVisibility::Invisible. Unused bits of the last element are cleared.
+    Uint32* pVisibilityMask = nullptr;
+
+    /// Optional array of NumBoxes elements that receives the visibility of every box.
+    BoxVisibility* pVisibility = nullptr;
+
+    /// Frustum planes to test the boxes against.
+    FRUSTUM_PLANE_FLAGS PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM;
+
+    /// Optional thread pool to distribute the work across.
+    IThreadPool* pThreadPool = nullptr;
+
+    /// The number of boxes processed by one task. Rounded up to a multiple of 32.
+    Uint32 ChunkSize = 8192;
+
+    /// The maximum number of tasks to enqueue into the thread pool.
+    /// If zero, the number of hardware threads is used.
+    Uint32 NumWorkerTasks = 0;
+};
+
+/// Tests a batch of axis-aligned bounding boxes against the view frustum.
+
+/// \return     The number of boxes that are not invisible.
+///
+/// \remarks    The result for every box is identical to the result of
+///             GetBoxVisibility(const ViewFrustum&, const BoundBox&, FRUSTUM_PLANE_FLAGS).
+///             The boxes are processed 4 (8 in AVX builds) at a time.
+size_t GetBoxVisibilityBatch(const ViewFrustum&               Frustum,
+                             const BoundBoxSOA&               Boxes,
+                             const BatchBoxVisibilityAttribs& Attribs);
+
+/// Tests a batch of axis-aligned bounding boxes against the view frustum, and additionally
+/// tests the frustum corners against the boxes.
+
+/// \return     The number of boxes that are not invisible.
+///
+/// \remarks    The result for every box is identical to the result of
+///             GetBoxVisibility(const ViewFrustumExt&, const BoundBox&, FRUSTUM_PLANE_FLAGS).
+size_t GetBoxVisibilityBatch(const ViewFrustumExt&            FrustumExt,
+                             const BoundBoxSOA&               Boxes,
+                             const BatchBoxVisibilityAttribs& Attribs);
+
+/// Tests a batch of oriented bounding boxes against the view frustum planes.
+
+/// \return     The number of boxes that are not invisible.
+///
+/// \remarks    The result for every box is identical to the result of
+///             GetBoxVisibility(const ViewFrustum&, const OrientedBoundingBox&, FRUSTUM_PLANE_FLAGS).
+///             The frustum corners test that the ViewFrustumExt overload of GetBoxVisibility
+///             performs for oriented boxes is not done, so a ViewFrustumExt argument is
+///             treated as ViewFrustum.
+size_t GetBoxVisibilityBatch(const ViewFrustum&               Frustum,
+                             const OrientedBoundingBoxSOA&    Boxes,
+                             const BatchBoxVisibilityAttribs& Attribs);
+
+} // namespace Diligent
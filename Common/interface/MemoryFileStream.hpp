@@ -30,6 +30,9 @@
 /// \file
 /// Implementation of the MemoryFileStream class
 
+#include <memory>
+#include <vector>
+
 #include "../../Primitives/interface/FileStream.h"
 #include "../../Primitives/interface/DataBlob.h"
 #include "ObjectBase.hpp"
@@ -39,14 +42,29 @@ namespace Diligent
 {
 
 /// Memory file stream implementation
+
+/// The stream works in one of two modes:
+/// - Blob mode: the data is stored in a single contiguous data blob that is
+///   resized every time a write goes past the end of the stream.
+/// - Chunked mode: the data is stored in a list of fixed-size chunks. Growing
+///   the stream never copies the data that has already been written. The chunks
+///   are flattened into a contiguous blob only when GetDataBlob() is called, and
+///   can be written to another stream or a file without flattening.
 class MemoryFileStream final : public ObjectBase<IFileStream>
 {
 public:
     typedef ObjectBase<IFileStream> TBase;
 
+    static constexpr size_t DefaultChunkSize = size_t{1} << 20;
+
+    /// Creates a memory stream in blob mode that reads from and writes to pData.
     MemoryFileStream(IReferenceCounters* pRefCounters,
                      IDataBlob*          pData);
 
+    /// Creates an empty memory stream in chunked mode.
+    MemoryFileStream(IReferenceCounters* pRefCounters,
+                     size_t              ChunkSize);
+
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final;
 
     /// Reads data from the stream
@@ -64,9 +82,44 @@ public:
 
     static RefCntAutoPtr<MemoryFileStream> Create(IDataBlob* pData);
 
+    static RefCntAutoPtr<MemoryFileStream> CreateChunked(size_t ChunkSize = DefaultChunkSize);
+
+    bool IsChunked() const { return m_ChunkSize != 0; }
+
+    /// Returns the current read/write position.
+    size_t GetPos() const { return m_CurrentOffset; }
+
+    /// Sets the read/write position. The position may not exceed the stream size.
+    bool SetPos(size_t Offset);
+
+    /// Returns the stream data as a contiguous data blob.
+
+    /// In chunked mode, the chunks are copied into a new data blob and released,
+    /// after which the stream switches to blob mode. This way the data is
+    /// flattened at most once.
+    RefCntAutoPtr<IDataBlob> GetDataBlob();
+
+    /// Writes the entire stream contents to another stream.
+    /// In chunked mode, the data is written chunk by chunk and is not flattened.
+    bool WriteTo(IFileStream* pStream);
+
+    /// Writes the entire stream contents to a file, overwriting it.
+    /// In chunked mode, the data is written chunk by chunk and is not flattened.
+    bool WriteToFile(const Char* FilePath);
+
+private:
+    template <typename HandlerType>
+    bool ProcessChunks(HandlerType&& Handler) const;
+
 private:
     RefCntAutoPtr<IDataBlob> m_DataBlob;
     size_t                   m_CurrentOffset = 0;
+
+    // Chunked mode
+    size_t m_ChunkSize = 0;
+
+    size_t                                m_ChunkedSize = 0;
+    std::vector<std::unique_ptr<Uint8[]>> m_Chunks;
 };
 
 } // namespace Diligent
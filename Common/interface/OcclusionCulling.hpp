@@ -0,0 +1,185 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Software depth rasterizer for CPU occlusion culling.
+
+#include <vector>
+
+#include "FrustumCulling.hpp"
+
+namespace Diligent
+{
+
+/// Occluder mesh attributes, see SoftwareOcclusionBuffer::RasterizeOccluder().
+struct OccluderMeshAttribs
+{
+    /// Pointer to the position of the first vertex. Every position is three floats.
+    const void* pVertices = nullptr;
+
+    /// The distance in bytes between two consecutive vertex positions.
+    Uint32 VertexStride = sizeof(float3);
+
+    /// The number of vertices.
+    Uint32 NumVertices = 0;
+
+    /// Triangle list indices, must contain 3 * NumTriangles elements.
+    /// If null, every three consecutive vertices form a triangle.
+    const Uint32* pIndices = nullptr;
+
+    /// The number of triangles.
+    Uint32 NumTriangles = 0;
+
+    /// The matrix that transforms vertex positions to clip space.
+    float4x4 WorldViewProj;
+
+    /// Whether to skip back-facing triangles.
+
+    /// Back faces of closed meshes are always hidden by front faces,
+    /// so skipping them halves the rasterization cost.
+    bool CullBackFaces = true;
+
+    /// Whether triangles with counter-clockwise screen-space winding are front-facing.
+    /// Same as RasterizerStateDesc::FrontCounterClockwise.
+    bool FrontCounterClockwise = false;
+};
+
+/// Coarse depth buffer for CPU occlusion culling.
+
+/// Occluder meshes are rasterized into a low-resolution depth buffer, after which
+/// bounding boxes of potentially hidden objects are tested against it, so that draw
+/// calls for the objects that are fully occluded can be skipped.
+///
+/// The buffer is split into TileWidth x TileHeight tiles, and every tile keeps the
+/// farthest depth of its pixels. The rasterizer uses it to skip tiles where a triangle
+/// is behind all previously rendered occluders, while the box test uses it to reject
+/// whole tiles at once. Within a tile, triangles are rasterized four pixels at a time
+/// by evaluating edge functions at pixel centers.
+///
+/// Depth values are NDC depths in [0, 1] range, where 0 is the near plane.
+/// Reverse depth projections are not supported.
+///
+/// The object is not thread-safe. Box tests may be performed from multiple
+/// threads as long as no occluders are being rasterized at the same time.
+class SoftwareOcclusionBuffer
+{
+public:
+    static constexpr Uint32 TileWidth  = 8;
+    static constexpr Uint32 TileHeight = 4;
+
+    /// \param [in] Width             - Buffer width in pixels.
+    /// \param [in] Height            - Buffer height in pixels.
+    /// \param [in] NegativeOneToOneZ - Whether the clip-space depth range is [-w, w] (OpenGL)
+    ///                                 rather than [0, w].
+    SoftwareOcclusionBuffer(Uint32 Width, Uint32 Height, bool NegativeOneToOneZ = false);
+
+    /// Resizes the buffer and clears it.
+    void Resize(Uint32 Width, Uint32 Height);
+
+    /// Resets all pixels to the far plane depth.
+    void Clear();
+
+    /// Rasterizes occluder triangles into the depth buffer.
+
+    /// Triangles are clipped against the near plane. Triangles that intersect the
+    /// side planes are clipped against a guard band, and pixels outside of the
+    /// buffer are discarded.
+    void RasterizeOccluder(const OccluderMeshAttribs& Attribs);
+
+    /// Tests whether any part of the bounding box may be visible.
+
+    /// \param [in] ViewProj - The matrix that transforms the box to clip space.
+    /// \param [in] Box      - The bounding box to test.
+    ///
+    /// \return     false if the box is entirely hidden by the occluders rendered so far,
+    ///             or if it does not overlap the buffer area; true otherwise.
+    ///
+    /// \remarks    The test is conservative: the box is projected to the screen-space
+    ///             rectangle that contains it, and the nearest depth of the box is
+    ///             compared with every pixel of the rectangle. Boxes that intersect
+    ///             the near plane are always considered visible.
+    bool IsBoxVisible(const float4x4& ViewProj, const BoundBox& Box) const;
+
+    /// Tests a batch of bounding boxes.
+
+    /// \param [in]     ViewProj        - The matrix that transforms the boxes to clip space.
+    /// \param [in]     Boxes           - Bounding boxes in structure-of-arrays layout.
+    /// \param [in]     NumBoxes        - The number of boxes.
+    /// \param [in,out] pVisibilityMask - Visibility bit mask of (NumBoxes + 31) / 32 elements
+    ///                                   in the same format as BatchBoxVisibilityAttribs::pVisibilityMask.
+    ///                                   Only the boxes whose bits are set are tested, and the bits
+    ///                                   of the boxes that are occluded are cleared. This allows
+    ///                                   passing the output of GetBoxVisibilityBatch() directly.
+    ///
+    /// \return     The number of boxes that remain visible.
+    size_t TestBoxes(const float4x4& ViewProj, const BoundBoxSOA& Boxes, size_t NumBoxes, Uint32* pVisibilityMask) const;
+
+    /// Copies the depth buffer to a Width x Height array with the top row first.
+    void ReadDepth(float* pDepth) const;
+
+    Uint32 GetWidth() const { return m_Width; }
+    Uint32 GetHeight() const { return m_Height; }
+    bool   IsNegativeOneToOneZ() const { return m_NegativeOneToOneZ; }
+
+private:
+    // Screen-space vertex: pixel coordinates and NDC depth
+    struct ScreenVertex
+    {
+        float x;
+        float y;
+        float z;
+    };
+
+    ScreenVertex ToScreen(const float4& ClipPos) const;
+
+    void RasterizeClippedPolygon(const float4* pClipVerts, Uint32 NumVerts, int FrontFaceSign);
+    void RasterizeScreenTriangle(ScreenVertex V0, ScreenVertex V1, ScreenVertex V2, int FrontFaceSign);
+
+    bool IsScreenRectVisible(float MinX, float MinY, float MaxX, float MaxY, float MinZ) const;
+
+    float*       GetTileDepth(Uint32 TileX, Uint32 TileY) { return &m_Depth[(TileX + TileY * m_TilesX) * TileWidth * TileHeight]; }
+    const float* GetTileDepth(Uint32 TileX, Uint32 TileY) const { return &m_Depth[(TileX + TileY * m_TilesX) * TileWidth * TileHeight]; }
+
+private:
+    Uint32 m_Width  = 0;
+    Uint32 m_Height = 0;
+    Uint32 m_TilesX = 0;
+    Uint32 m_TilesY = 0;
+
+    const bool m_NegativeOneToOneZ;
+
+    // Tile-major depth: TileWidth x TileHeight row-major block for every tile
+    std::vector<float> m_Depth;
+    // The farthest depth of every tile
+    std::vector<float> m_TileMaxDepth;
+
+    // Clip-space positions of the vertices of the current occluder
+    std::vector<float4> m_ClipVerts;
+};
+
+} // namespace Diligent
@@ -27,8 +27,11 @@
 #pragma once
 
 #include <atomic>
+#include <algorithm>
 #include <functional>
+#include <memory>
 #include <thread>
+#include <vector>
 
 #include "../../Primitives/interface/Object.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
@@ -397,4 +400,79 @@ RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool, HanlderType
     return pTask;
 }
 
+
+/// Processes a range of chunks in parallel using the thread pool.
+
+/// \param [in] pThreadPool    - Thread pool to use. If null, all chunks are processed
+///                              sequentially on the calling thread.
+/// \param [in] NumChunks      - The number of chunks to process.
+/// \param [in] Handler        - Chunk handler that is called as Handler(ChunkIndex) exactly once
+///                              for every chunk index in [0, NumChunks). The handler is called
+///                              concurrently from multiple threads and must not throw.
+/// \param [in] NumWorkerTasks - The maximum number of tasks to enqueue into the thread pool.
+///                              If zero, the number of hardware threads is used.
+///
+/// \remarks   The function returns when all chunks have been processed.
+///
+///            The calling thread processes chunks as well, so the function makes progress
+///            even if all threads in the pool are busy, and it is safe to call it from
+///            a worker thread of the same pool.
+template <typename HandlerType>
+void ParallelFor(IThreadPool* pThreadPool, Uint32 NumChunks, const HandlerType& Handler, Uint32 NumWorkerTasks = 0)
+{
+    if (NumChunks == 0)
+        return;
+
+    if (pThreadPool == nullptr || NumChunks == 1)
+    {
+        for (Uint32 i = 0; i < NumChunks; ++i)
+            Handler(i);
+        return;
+    }
+
+    struct SharedState
+    {
+        std::atomic<Uint32> NextChunk{0};
+        std::atomic<Uint32> NumProcessedChunks{0};
+    };
+    // Tasks that start after all chunks have been processed access the shared state only,
+    // so it must outlive this function.
+    auto pState = std::make_shared<SharedState>();
+
+    // The handler is only accessed while there are unprocessed chunks, which
+    // guarantees that it is still alive.
+    const HandlerType* pHandler      = &Handler;
+    auto               ProcessChunks = [pState, pHandler, NumChunks]() {
+        for (Uint32 Chunk = pState->NextChunk.fetch_add(1); Chunk < NumChunks; Chunk = pState->NextChunk.fetch_add(1))
+        {
+            (*pHandler)(Chunk);
+            pState->NumProcessedChunks.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    if (NumWorkerTasks == 0)
+        NumWorkerTasks = std::max(std::thread::hardware_concurrency(), 1u);
+    // The calling thread processes chunks too
+    NumWorkerTasks = std::min(NumWorkerTasks, NumChunks - 1);
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    Tasks.reserve(NumWorkerTasks);
+    for (Uint32 i = 0; i < NumWorkerTasks; ++i)
+    {
+        Tasks.emplace_back(EnqueueAsyncWork(pThreadPool, [ProcessChunks](Uint32) {
+            ProcessChunks();
+        }));
+    }
+
+    ProcessChunks();
+
+    // Remove the tasks that have not started yet - there is no work left for them.
+    for (auto& pTask : Tasks)
+        pThreadPool->RemoveTask(pTask);
+
+    // Wait for the chunks that are being processed by other threads
+    while (pState->NumProcessedChunks.load(std::memory_order_acquire) < NumChunks)
+        std::this_thread::yield();
+}
+
 } // namespace Diligent
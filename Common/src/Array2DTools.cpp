@@ -29,6 +29,8 @@
 #include <algorithm>
 
 #include "Intrinsics.hpp"
+#include "BasicMathSIMD.hpp"
+#include "ThreadPool.hpp"
 #include "DebugUtilities.hpp"
 #include "Align.hpp"
 
@@ -38,6 +40,7 @@ namespace Diligent
 namespace
 {
 
+#if DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_NONE
 void GetArray2DMinMaxValueGeneric(const float* pData,
                                   size_t       StrideInFloats,
                                   Uint32       Width,
@@ -56,6 +59,59 @@ void GetArray2DMinMaxValueGeneric(const float* pData,
         }
     }
 }
+#else
+void GetArray2DMinMaxValueSIMD(const float* pData,
+                               size_t       StrideInFloats,
+                               Uint32       Width,
+                               Uint32       Height,
+                               float&       MinValue,
+                               float&       MaxValue)
+{
+    using namespace MathSIMD;
+
+    // Use independent accumulators to hide the latency of min/max instructions
+    VecF4 Min[4] = {SetF4(MinValue), SetF4(MinValue), SetF4(MinValue), SetF4(MinValue)};
+    VecF4 Max[4] = {SetF4(MaxValue), SetF4(MaxValue), SetF4(MaxValue), SetF4(MaxValue)};
+    for (size_t row = 0; row < Height; ++row)
+    {
+        const float* Ptr     = pData + row * StrideInFloats;
+        const float* pRowEnd = Ptr + Width;
+        for (; Ptr + 16 <= pRowEnd; Ptr += 16)
+        {
+            for (size_t i = 0; i < 4; ++i)
+            {
+                const VecF4 Val = LoadF4(Ptr + i * 4);
+
+                Min[i] = MinF4(Min[i], Val);
+                Max[i] = MaxF4(Max[i], Val);
+            }
+        }
+        for (; Ptr + 4 <= pRowEnd; Ptr += 4)
+        {
+            const VecF4 Val = LoadF4(Ptr);
+
+            Min[0] = MinF4(Min[0], Val);
+            Max[0] = MaxF4(Max[0], Val);
+        }
+        for (; Ptr < pRowEnd; ++Ptr)
+        {
+            // Ternary operators compile to branchless min/max instructions
+            MinValue = *Ptr < MinValue ? *Ptr : MinValue;
+            MaxValue = *Ptr > MaxValue ? *Ptr : MaxValue;
+        }
+    }
+
+    float Min4[4];
+    float Max4[4];
+    StoreF4(Min4, MinF4(MinF4(Min[0], Min[1]), MinF4(Min[2], Min[3])));
+    StoreF4(Max4, MaxF4(MaxF4(Max[0], Max[1]), MaxF4(Max[2], Max[3])));
+    for (size_t i = 0; i < 4; ++i)
+    {
+        MinValue = std::min(MinValue, Min4[i]);
+        MaxValue = std::max(MaxValue, Max4[i]);
+    }
+}
+#endif
 
 #if DILIGENT_AVX2_ENABLED
 bool GetArray2DMinMaxValueAVX2(const float* pData,
@@ -65,18 +121,15 @@ bool GetArray2DMinMaxValueAVX2(const float* pData,
                                float&       MinValue,
                                float&       MaxValue)
 {
-    MinValue   = pData[0];
-    MaxValue   = pData[0];
     auto mmMin = _mm256_set1_ps(MinValue);
     auto mmMax = _mm256_set1_ps(MaxValue);
     for (size_t row = 0; row < Height; ++row)
     {
         const float* pRowStart = pData + row * StrideInFloats;
         const float* pRowEnd   = pRowStart + Width;
-        const float* pAVXEnd   = pRowEnd - 8;
 
         const float* Ptr = pRowStart;
-        for (; Ptr < pAVXEnd; Ptr += 8)
+        for (; Ptr + 8 <= pRowEnd; Ptr += 8)
         {
             // NOTE: MSVC generates vmovups when using _mm256_load_ps regardless,
             //       so no reason to bother with aligning the pointer.
@@ -127,6 +180,84 @@ bool GetArray2DMinMaxValueAVX2(const float* pData,
 }
 #endif
 
+void GetArray2DMinMaxValueRows(const float* pData,
+                               size_t       StrideInFloats,
+                               Uint32       Width,
+                               Uint32       Height,
+                               float&       MinValue,
+                               float&       MaxValue)
+{
+    MinValue = MaxValue = pData[0];
+#if DILIGENT_AVX2_ENABLED
+    if (GetArray2DMinMaxValueAVX2(pData, StrideInFloats, Width, Height, MinValue, MaxValue))
+        return;
+#endif
+
+#if DILIGENT_MATH_SIMD != DILIGENT_MATH_SIMD_NONE
+    GetArray2DMinMaxValueSIMD(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+#else
+    GetArray2DMinMaxValueGeneric(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+#endif
+}
+
+// The number of elements processed by one parallel task
+constexpr size_t ParallelChunkSize = size_t{1} << 18;
+
+// Returns the number of rows per parallel task
+Uint32 GetRowsPerChunk(Uint32 Width)
+{
+    return static_cast<Uint32>(std::max(ParallelChunkSize / std::max(Width, 1u), size_t{1}));
+}
+
+// Computes min and max values of 2x2 blocks of two source rows. Min and max
+// values may come from the same rows, which is the case for the source array.
+void ReduceMinMaxRows(const float* pSrcMin0,
+                      const float* pSrcMin1,
+                      const float* pSrcMax0,
+                      const float* pSrcMax1,
+                      Uint32       SrcWidth,
+                      float*       pDstMin,
+                      float*       pDstMax)
+{
+    const Uint32 NumPairs = SrcWidth / 2;
+
+    Uint32 x = 0;
+#if DILIGENT_MATH_SIMD != DILIGENT_MATH_SIMD_NONE
+    using namespace MathSIMD;
+    for (; x + 4 <= NumPairs; x += 4)
+    {
+        VecF4 Even, Odd;
+
+        const VecF4 Min0 = MinF4(LoadF4(pSrcMin0 + x * 2 + 0), LoadF4(pSrcMin1 + x * 2 + 0));
+        const VecF4 Min1 = MinF4(LoadF4(pSrcMin0 + x * 2 + 4), LoadF4(pSrcMin1 + x * 2 + 4));
+        DeinterleaveF4(Min0, Min1, Even, Odd);
+        StoreF4(pDstMin + x, MinF4(Even, Odd));
+
+        const VecF4 Max0 = MaxF4(LoadF4(pSrcMax0 + x * 2 + 0), LoadF4(pSrcMax1 + x * 2 + 0));
+        const VecF4 Max1 = MaxF4(LoadF4(pSrcMax0 + x * 2 + 4), LoadF4(pSrcMax1 + x * 2 + 4));
+        DeinterleaveF4(Max0, Max1, Even, Odd);
+        StoreF4(pDstMax + x, MaxF4(Even, Odd));
+    }
+#endif
+
+    auto Min = [](float a, float b) {
+        return a < b ? a : b;
+    };
+    auto Max = [](float a, float b) {
+        return a > b ? a : b;
+    };
+    for (; x < NumPairs; ++x)
+    {
+        pDstMin[x] = Min(Min(pSrcMin0[x * 2], pSrcMin0[x * 2 + 1]), Min(pSrcMin1[x * 2], pSrcMin1[x * 2 + 1]));
+        pDstMax[x] = Max(Max(pSrcMax0[x * 2], pSrcMax0[x * 2 + 1]), Max(pSrcMax1[x * 2], pSrcMax1[x * 2 + 1]));
+    }
+    if (SrcWidth % 2 != 0)
+    {
+        pDstMin[NumPairs] = Min(pSrcMin0[SrcWidth - 1], pSrcMin1[SrcWidth - 1]);
+        pDstMax[NumPairs] = Max(pSrcMax0[SrcWidth - 1], pSrcMax1[SrcWidth - 1]);
+    }
+}
+
 } // namespace
 
 void GetArray2DMinMaxValue(const float* pData,
@@ -134,7 +265,8 @@ void GetArray2DMinMaxValue(const float* pData,
                            Uint32       Width,
                            Uint32       Height,
                            float&       MinValue,
-                           float&       MaxValue)
+                           float&       MaxValue,
+                           IThreadPool* pThreadPool)
 {
     if (Width == 0 || Height == 0)
         return;
@@ -143,13 +275,95 @@ void GetArray2DMinMaxValue(const float* pData,
     DEV_CHECK_ERR(Height == 1 || StrideInFloats >= Width, "Row stride (", StrideInFloats, ") must be at least ", Width);
     DEV_CHECK_ERR(AlignDown(pData, alignof(float)) == pData, "Data pointer is not naturally aligned");
 
-    MinValue = MaxValue = pData[0];
-#if DILIGENT_AVX2_ENABLED
-    if (GetArray2DMinMaxValueAVX2(pData, StrideInFloats, Width, Height, MinValue, MaxValue))
+    const Uint32 RowsPerChunk = GetRowsPerChunk(Width);
+    const Uint32 NumChunks    = (Height + RowsPerChunk - 1) / RowsPerChunk;
+    if (pThreadPool == nullptr || NumChunks == 1)
+    {
+        GetArray2DMinMaxValueRows(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
         return;
-#endif
+    }
 
-    GetArray2DMinMaxValueGeneric(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+    std::vector<float> ChunkMin(NumChunks);
+    std::vector<float> ChunkMax(NumChunks);
+    ParallelFor(pThreadPool, NumChunks,
+                [&](Uint32 Chunk) {
+                    const Uint32 StartRow = Chunk * RowsPerChunk;
+                    const Uint32 NumRows  = std::min(RowsPerChunk, Height - StartRow);
+                    GetArray2DMinMaxValueRows(pData + StartRow * StrideInFloats, StrideInFloats, Width, NumRows, ChunkMin[Chunk], ChunkMax[Chunk]);
+                });
+
+    MinValue = *std::min_element(ChunkMin.begin(), ChunkMin.end());
+    MaxValue = *std::max_element(ChunkMax.begin(), ChunkMax.end());
+}
+
+
+void Array2DMinMaxPyramid::Build(const float* pData,
+                                 size_t       StrideInFloats,
+                                 Uint32       Width,
+                                 Uint32       Height,
+                                 IThreadPool* pThreadPool)
+{
+    Clear();
+    if (Width == 0 || Height == 0)
+        return;
+
+    DEV_CHECK_ERR(pData != nullptr, "Data pointer must not be null");
+    DEV_CHECK_ERR(Height == 1 || StrideInFloats >= Width, "Row stride (", StrideInFloats, ") must be at least ", Width);
+
+    size_t TotalSize = 0;
+    for (Uint32 LevelWidth = Width, LevelHeight = Height; m_Levels.empty() || LevelWidth > 1 || LevelHeight > 1;)
+    {
+        LevelInfo Level;
+        Level.Width  = (LevelWidth + 1) / 2;
+        Level.Height = (LevelHeight + 1) / 2;
+        Level.Offset = TotalSize;
+        m_Levels.push_back(Level);
+
+        TotalSize += size_t{Level.Width} * Level.Height;
+        LevelWidth  = Level.Width;
+        LevelHeight = Level.Height;
+    }
+    m_MinValues.resize(TotalSize);
+    m_MaxValues.resize(TotalSize);
+
+    for (Uint32 l = 0; l < GetLevelCount(); ++l)
+    {
+        const LevelInfo& Dst = m_Levels[l];
+
+        // Level 0 is built from the source array, other levels from the previous level
+        const float* pSrcMin   = l == 0 ? pData : GetMinValues(l - 1);
+        const float* pSrcMax   = l == 0 ? pData : GetMaxValues(l - 1);
+        const size_t SrcStride = l == 0 ? StrideInFloats : m_Levels[l - 1].Width;
+        const Uint32 SrcWidth  = l == 0 ? Width : m_Levels[l - 1].Width;
+        const Uint32 SrcHeight = l == 0 ? Height : m_Levels[l - 1].Height;
+
+        float* pDstMin = &m_MinValues[Dst.Offset];
+        float* pDstMax = &m_MaxValues[Dst.Offset];
+
+        const Uint32 RowsPerChunk = GetRowsPerChunk(SrcWidth);
+        const Uint32 NumChunks    = (Dst.Height + RowsPerChunk - 1) / RowsPerChunk;
+        ParallelFor(NumChunks > 1 ? pThreadPool : nullptr, NumChunks,
+                    [&](Uint32 Chunk) {
+                        const Uint32 StartRow = Chunk * RowsPerChunk;
+                        const Uint32 EndRow   = std::min(StartRow + RowsPerChunk, Dst.Height);
+                        for (Uint32 y = StartRow; y < EndRow; ++y)
+                        {
+                            const size_t SrcRow0 = size_t{y} * 2;
+                            // The last row of an array with odd height is paired with itself
+                            const size_t SrcRow1 = std::min(SrcRow0 + 1, size_t{SrcHeight} - 1);
+                            ReduceMinMaxRows(pSrcMin + SrcRow0 * SrcStride, pSrcMin + SrcRow1 * SrcStride,
+                                             pSrcMax + SrcRow0 * SrcStride, pSrcMax + SrcRow1 * SrcStride,
+                                             SrcWidth, pDstMin + size_t{y} * Dst.Width, pDstMax + size_t{y} * Dst.Width);
+                        }
+                    });
+    }
+}
+
+void Array2DMinMaxPyramid::Clear()
+{
+    m_Levels.clear();
+    m_MinValues.clear();
+    m_MaxValues.clear();
 }
 
 } // namespace Diligent
@@ -0,0 +1,426 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BVH.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#include "ThreadPool.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+constexpr Uint32 BVHHit::InvalidPrimitive;
+constexpr Uint32 BoundingVolumeHierarchy::MaxDepth;
+
+namespace
+{
+
+// Half of the box surface area
+float GetHalfArea(const BoundBox& Box)
+{
+    const float3 Size = Box.Max - Box.Min;
+    return Size.x * Size.y + Size.y * Size.z + Size.z * Size.x;
+}
+
+class BVHBuilder
+{
+public:
+    using CreateInfo = BoundingVolumeHierarchy::CreateInfo;
+
+    static constexpr Uint32 MaxBins = 64;
+
+    BVHBuilder(const CreateInfo&     CI,
+               std::vector<BVHNode>& Nodes,
+               std::vector<Uint32>&  PrimIndices) :
+        m_CI{CI},
+        m_NumBins{std::min(std::max(CI.NumBins, 2u), Uint32{MaxBins})},
+        m_MaxLeafSize{std::max(CI.MaxLeafSize, 1u)},
+        m_Nodes{Nodes},
+        m_PrimIndices{PrimIndices}
+    {
+        m_Refs.resize(CI.NumPrimitives);
+        for (Uint32 i = 0; i < CI.NumPrimitives; ++i)
+        {
+            const auto& Bounds = CI.pPrimitiveBounds[i];
+            m_Refs[i]          = {Bounds.Min, i, Bounds.Max, 0};
+        }
+        // A binary tree with N leaves has 2N-1 nodes
+        m_Nodes.resize(size_t{CI.NumPrimitives} * 2 - 1);
+    }
+
+    Uint32 Build()
+    {
+        const WorkItem Root{0, 0, m_CI.NumPrimitives, 1};
+        if (m_CI.pThreadPool != nullptr && m_CI.NumPrimitives > m_CI.MinParallelSubtreeSize)
+        {
+            // Build the top of the tree on this thread and defer the subtrees
+            // that are small enough to the thread pool.
+            const Uint32 NumThreads  = std::max(std::thread::hardware_concurrency(), 1u);
+            const Uint32 SubtreeSize = std::max(m_CI.MinParallelSubtreeSize, m_CI.NumPrimitives / (NumThreads * 8));
+
+            std::vector<WorkItem> Subtrees;
+            BuildSubtree(Root, &Subtrees, SubtreeSize);
+
+            ParallelFor(m_CI.pThreadPool, static_cast<Uint32>(Subtrees.size()), [&](Uint32 i) {
+                BuildSubtree(Subtrees[i], nullptr, 0);
+            });
+        }
+        else
+        {
+            BuildSubtree(Root, nullptr, 0);
+        }
+
+        m_Nodes.resize(m_NumNodes.load());
+
+        m_PrimIndices.resize(m_Refs.size());
+        for (size_t i = 0; i < m_Refs.size(); ++i)
+            m_PrimIndices[i] = m_Refs[i].PrimIdx;
+
+        return m_Depth.load();
+    }
+
+private:
+    // Primitive reference that is reordered during the build. Keeping the bounds next to
+    // the index makes binning and partitioning access the memory sequentially.
+    struct PrimitiveRef
+    {
+        float3 Min;
+        Uint32 PrimIdx;
+        float3 Max;
+        Uint32 Padding;
+
+        float3 GetCentroid() const
+        {
+            return (Min + Max) * 0.5f;
+        }
+    };
+    static_assert(sizeof(PrimitiveRef) == 32, "PrimitiveRef is expected to be 32 bytes");
+
+    struct WorkItem
+    {
+        Uint32 NodeIdx;
+        Uint32 First;
+        Uint32 Count;
+        Uint32 Depth;
+    };
+
+    // Bin bounds are stored as SIMD vectors: this makes the bin array trivially constructible, so that
+    // only the bins that are actually used are initialized, and avoids branches in min/max.
+    struct BinInfo
+    {
+        MathSIMD::VecF4 Min;
+        MathSIMD::VecF4 Max;
+        Uint32          Count;
+
+        void Reset()
+        {
+            Min   = MathSIMD::SetF4(+FLT_MAX);
+            Max   = MathSIMD::SetF4(-FLT_MAX);
+            Count = 0;
+        }
+
+        void Add(const PrimitiveRef& Ref)
+        {
+            // The fourth components are PrimIdx and Padding, which are ignored
+            Min = MathSIMD::MinF4(Min, MathSIMD::LoadF4(&Ref.Min.x));
+            Max = MathSIMD::MaxF4(Max, MathSIMD::LoadF4(&Ref.Max.x));
+            ++Count;
+        }
+
+        void Add(const BinInfo& Bin)
+        {
+            Min = MathSIMD::MinF4(Min, Bin.Min);
+            Max = MathSIMD::MaxF4(Max, Bin.Max);
+            Count += Bin.Count;
+        }
+
+        // Returns the bin bounds half area multiplied by the number of primitives
+        float GetCost() const
+        {
+            if (Count == 0)
+                return 0;
+
+            float Size[4];
+            MathSIMD::StoreF4(Size, MathSIMD::SubF4(Max, Min));
+            return (Size[0] * Size[1] + Size[1] * Size[2] + Size[2] * Size[0]) * static_cast<float>(Count);
+        }
+    };
+
+    struct SplitInfo
+    {
+        int    Axis      = -1;
+        Uint32 Bin       = 0;
+        float  Cost      = FLT_MAX;
+        float  Min       = 0;
+        float  Scale     = 0;
+        float  MaxOffset = 0;
+    };
+
+    static Uint32 GetBin(float Centroid, float Min, float Scale, float MaxOffset)
+    {
+        // The clamping is written so that it compiles to branchless min/max instructions
+        // and also handles NaN and infinity that may result from a tiny extent.
+        float Offset = (Centroid - Min) * Scale;
+        Offset       = Offset > 0.f ? Offset : 0.f;
+        Offset       = Offset < MaxOffset ? Offset : MaxOffset;
+        return static_cast<Uint32>(Offset);
+    }
+
+    // Evaluates the SAH for all bin boundaries along all axes and returns the best split
+    SplitInfo FindSAHSplit(const WorkItem& Item, const BoundBox& CentroidBounds) const
+    {
+        // Small nodes do not need many bins
+        const Uint32 NumBins   = std::min(std::max(Item.Count, 4u), m_NumBins);
+        const float  MaxOffset = static_cast<float>(NumBins - 1);
+
+        float Min[3]   = {};
+        float Scale[3] = {};
+        bool  Valid[3] = {};
+        for (int Axis = 0; Axis < 3; ++Axis)
+        {
+            const float Extent = CentroidBounds.Max[Axis] - CentroidBounds.Min[Axis];
+            Valid[Axis]        = Extent > 0;
+            Min[Axis]          = CentroidBounds.Min[Axis];
+            Scale[Axis]        = Valid[Axis] ? static_cast<float>(NumBins) / Extent : 0;
+        }
+
+        BinInfo Bins[3][MaxBins];
+        for (int Axis = 0; Axis < 3; ++Axis)
+        {
+            for (Uint32 b = 0; b < NumBins; ++b)
+                Bins[Axis][b].Reset();
+        }
+
+        // Bin all axes in a single pass over the references
+        for (Uint32 i = Item.First; i < Item.First + Item.Count; ++i)
+        {
+            const auto&  Ref      = m_Refs[i];
+            const float3 Centroid = Ref.GetCentroid();
+            for (int Axis = 0; Axis < 3; ++Axis)
+            {
+                if (!Valid[Axis])
+                    continue;
+
+                Bins[Axis][GetBin(Centroid[Axis], Min[Axis], Scale[Axis], MaxOffset)].Add(Ref);
+            }
+        }
+
+        SplitInfo BestSplit;
+        for (int Axis = 0; Axis < 3; ++Axis)
+        {
+            if (!Valid[Axis])
+                continue;
+
+            const auto& AxisBins = Bins[Axis];
+
+            // Sweep from the right to compute the cost of the right part for every split
+            std::array<float, MaxBins> RightCost;
+            BinInfo                    Right;
+            Right.Reset();
+            for (Uint32 b = NumBins - 1; b > 0; --b)
+            {
+                Right.Add(AxisBins[b]);
+                RightCost[b - 1] = Right.GetCost();
+            }
+
+            // Split after bin b
+            BinInfo Left;
+            Left.Reset();
+            for (Uint32 b = 0; b + 1 < NumBins; ++b)
+            {
+                Left.Add(AxisBins[b]);
+                if (Left.Count == 0 || Left.Count == Item.Count)
+                    continue;
+
+                const float Cost = Left.GetCost() + RightCost[b];
+                if (Cost < BestSplit.Cost)
+                {
+                    BestSplit.Axis      = Axis;
+                    BestSplit.Bin       = b;
+                    BestSplit.Cost      = Cost;
+                    BestSplit.Min       = Min[Axis];
+                    BestSplit.Scale     = Scale[Axis];
+                    BestSplit.MaxOffset = MaxOffset;
+                }
+            }
+        }
+        return BestSplit;
+    }
+
+    // Splits the primitives of the node and returns the number of primitives in the left child,
+    // or zero if the node should be a leaf.
+    Uint32 SplitNode(const WorkItem& Item, const BoundBox& NodeBounds, const BoundBox& CentroidBounds)
+    {
+        if (Item.Count <= 1)
+            return 0;
+
+        const bool ForceSplit = Item.Count > m_MaxLeafSize;
+
+        auto* const pFirst = m_Refs.data() + Item.First;
+        auto* const pLast  = pFirst + Item.Count;
+
+        // Use SAH in the upper half of the maximum depth. Object median splits below it
+        // guarantee that the tree depth does not exceed MaxDepth.
+        if (Item.Depth < BoundingVolumeHierarchy::MaxDepth / 2)
+        {
+            const SplitInfo Split = FindSAHSplit(Item, CentroidBounds);
+
+            // Costs are not normalized by the node area:
+            //   SplitCost = TraversalCost * Area + LeftArea * LeftCount + RightArea * RightCount
+            //   LeafCost  = Area * Count
+            const float Area      = GetHalfArea(NodeBounds);
+            const float LeafCost  = Area * static_cast<float>(Item.Count);
+            const float SplitCost = m_CI.TraversalCost * Area + Split.Cost;
+            if (Split.Axis >= 0 && (ForceSplit || SplitCost < LeafCost))
+            {
+                auto* pMid = std::partition(pFirst, pLast, [&](const PrimitiveRef& Ref) {
+                    return GetBin(Ref.GetCentroid()[Split.Axis], Split.Min, Split.Scale, Split.MaxOffset) <= Split.Bin;
+                });
+
+                const Uint32 NumLeft = static_cast<Uint32>(pMid - pFirst);
+                VERIFY_EXPR(NumLeft > 0 && NumLeft < Item.Count);
+                if (NumLeft > 0 && NumLeft < Item.Count)
+                    return NumLeft;
+            }
+        }
+
+        if (!ForceSplit)
+            return 0;
+
+        // Object median split along the largest centroid extent. This also handles
+        // primitives with coincident centroids that can't be separated by the SAH.
+        const float3 Extent = CentroidBounds.Max - CentroidBounds.Min;
+        const int    Axis   = (Extent.x >= Extent.y && Extent.x >= Extent.z) ? 0 : (Extent.y >= Extent.z ? 1 : 2);
+
+        const Uint32 NumLeft = Item.Count / 2;
+        std::nth_element(pFirst, pFirst + NumLeft, pLast, [Axis](const PrimitiveRef& Ref0, const PrimitiveRef& Ref1) {
+            return Ref0.GetCentroid()[Axis] < Ref1.GetCentroid()[Axis];
+        });
+        return NumLeft;
+    }
+
+    void BuildSubtree(const WorkItem& Root, std::vector<WorkItem>* pDeferred, Uint32 DeferSize)
+    {
+        std::vector<WorkItem> Stack{Root};
+        Uint32                MaxDepth = 0;
+        while (!Stack.empty())
+        {
+            const WorkItem Item = Stack.back();
+            Stack.pop_back();
+
+            if (pDeferred != nullptr && Item.Count <= DeferSize)
+            {
+                pDeferred->push_back(Item);
+                continue;
+            }
+
+            BoundBox NodeBounds     = BoundBox::Invalid();
+            BoundBox CentroidBounds = BoundBox::Invalid();
+            for (Uint32 i = Item.First; i < Item.First + Item.Count; ++i)
+            {
+                const auto& Ref = m_Refs[i];
+                NodeBounds      = BoundBox{(std::min)(NodeBounds.Min, Ref.Min), (std::max)(NodeBounds.Max, Ref.Max)};
+                CentroidBounds  = CentroidBounds.Enclose(Ref.GetCentroid());
+            }
+
+            auto& Node = m_Nodes[Item.NodeIdx];
+            Node.Min   = NodeBounds.Min;
+            Node.Max   = NodeBounds.Max;
+
+            const Uint32 NumLeft = SplitNode(Item, NodeBounds, CentroidBounds);
+            if (NumLeft == 0)
+            {
+                Node.LeftOrFirst   = Item.First;
+                Node.NumPrimitives = Item.Count;
+                MaxDepth           = std::max(MaxDepth, Item.Depth);
+                continue;
+            }
+
+            const Uint32 LeftIdx = m_NumNodes.fetch_add(2);
+            Node.LeftOrFirst     = LeftIdx;
+            Node.NumPrimitives   = 0;
+
+            VERIFY_EXPR(Item.Depth < BoundingVolumeHierarchy::MaxDepth);
+            Stack.push_back({LeftIdx + 1, Item.First + NumLeft, Item.Count - NumLeft, Item.Depth + 1});
+            Stack.push_back({LeftIdx, Item.First, NumLeft, Item.Depth + 1});
+        }
+
+        Uint32 CurrDepth = m_Depth.load();
+        while (CurrDepth < MaxDepth && !m_Depth.compare_exchange_weak(CurrDepth, MaxDepth))
+        {
+        }
+    }
+
+private:
+    const CreateInfo& m_CI;
+    const Uint32      m_NumBins;
+    const Uint32      m_MaxLeafSize;
+
+    std::vector<PrimitiveRef> m_Refs;
+    std::vector<BVHNode>&     m_Nodes;
+    std::vector<Uint32>&      m_PrimIndices;
+
+    std::atomic<Uint32> m_NumNodes{1};
+    std::atomic<Uint32> m_Depth{0};
+};
+
+} // namespace
+
+void BoundingVolumeHierarchy::Build(const CreateInfo& CI)
+{
+    Clear();
+    if (CI.NumPrimitives == 0)
+        return;
+
+    DEV_CHECK_ERR(CI.pPrimitiveBounds != nullptr, "Primitive bounds must not be null");
+    DEV_CHECK_ERR(CI.NumPrimitives <= 0x7FFFFFFFu, "Too many primitives");
+
+    BVHBuilder Builder{CI, m_Nodes, m_PrimitiveIndices};
+    m_Depth = Builder.Build();
+}
+
+BoundingVolumeHierarchy CreateTriangleMeshBVH(const float3*                       pVertices,
+                                              const Uint32*                       pIndices,
+                                              Uint32                              NumTriangles,
+                                              BoundingVolumeHierarchy::CreateInfo CI)
+{
+    std::vector<BoundBox> Bounds(NumTriangles);
+    for (Uint32 i = 0; i < NumTriangles; ++i)
+    {
+        const Uint32* Tri = pIndices + size_t{i} * 3;
+        Bounds[i]         = BoundBox{pVertices[Tri[0]], pVertices[Tri[0]]}.Enclose(pVertices[Tri[1]]).Enclose(pVertices[Tri[2]]);
+    }
+
+    CI.pPrimitiveBounds = Bounds.data();
+    CI.NumPrimitives    = NumTriangles;
+    return BoundingVolumeHierarchy{CI};
+}
+
+} // namespace Diligent
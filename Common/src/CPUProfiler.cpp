@@ -0,0 +1,327 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include "CPUProfiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <utility>
+
+#include "SpinLock.hpp"
+
+namespace Diligent
+{
+
+struct CPUProfiler::ThreadEvents
+{
+    Threading::SpinLock Lock;
+
+    std::string                   Name;
+    std::vector<CPUProfilerEvent> Events;
+
+    // The total number of events recorded into the ring buffer
+    Uint64 NumRecorded = 0;
+
+    // False when the thread has exited. The buffer then only contains the recorded events.
+    bool IsAlive = true;
+
+    // Called when the thread exits: releases the unused part of the ring buffer.
+    void OnThreadExit()
+    {
+        Threading::SpinLockGuard Guard{Lock};
+
+        std::string                   ThreadName;
+        std::vector<CPUProfilerEvent> RecordedEvents;
+        CopyEvents(*this, ThreadName, RecordedEvents);
+
+        Events      = std::move(RecordedEvents);
+        NumRecorded = Events.size();
+        IsAlive     = false;
+    }
+
+    // Copies the events ordered from the oldest to the newest. The lock must be held.
+    static void CopyEvents(const ThreadEvents& Thread, std::string& Name, std::vector<CPUProfilerEvent>& Events)
+    {
+        Name = Thread.Name;
+
+        const auto BufferSize = Thread.Events.size();
+        const auto NumEvents  = static_cast<size_t>(std::min(Thread.NumRecorded, Uint64{BufferSize}));
+        const auto FirstEvent = BufferSize != 0 ? static_cast<size_t>((Thread.NumRecorded - NumEvents) % BufferSize) : 0;
+
+        Events.resize(NumEvents);
+        for (size_t i = 0; i < NumEvents; ++i)
+            Events[i] = Thread.Events[(FirstEvent + i) % BufferSize];
+    }
+};
+
+namespace
+{
+
+Uint64 GetSteadyClockTime()
+{
+    return static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+Uint32 GetNextProfilerId()
+{
+    static std::atomic<Uint32> NextId{0};
+    return NextId.fetch_add(1) + 1;
+}
+
+void WriteJSONString(std::stringstream& ss, const Char* Str)
+{
+    ss << '"';
+    for (const Char* c = Str; *c != '\0'; ++c)
+    {
+        switch (*c)
+        {
+            case '"': ss << "\\\""; break;
+            case '\\': ss << "\\\\"; break;
+            case '\n': ss << "\\n"; break;
+            case '\r': ss << "\\r"; break;
+            case '\t': ss << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20)
+                {
+                    static constexpr char HexDigits[] = "0123456789abcdef";
+                    ss << "\\u00" << HexDigits[(*c >> 4) & 0xF] << HexDigits[*c & 0xF];
+                }
+                else
+                {
+                    ss << *c;
+                }
+        }
+    }
+    ss << '"';
+}
+
+// Writes nanoseconds as microseconds with three decimal digits
+void WriteMicroseconds(std::stringstream& ss, Uint64 Nanoseconds)
+{
+    const auto Fraction = Nanoseconds % 1000;
+    ss << Nanoseconds / 1000 << '.' << static_cast<char>('0' + Fraction / 100) << static_cast<char>('0' + (Fraction / 10) % 10) << static_cast<char>('0' + Fraction % 10);
+}
+
+} // namespace
+
+CPUProfiler& CPUProfiler::Get()
+{
+    static CPUProfiler Profiler;
+    return Profiler;
+}
+
+CPUProfiler::CPUProfiler() :
+    m_StartTime{GetSteadyClockTime()},
+    m_ProfilerId{GetNextProfilerId()}
+{
+}
+
+CPUProfiler::~CPUProfiler()
+{
+}
+
+void CPUProfiler::SetRingBufferSize(Uint32 NumEvents)
+{
+    DEV_CHECK_ERR(NumEvents > 0, "Ring buffer size must not be zero");
+    m_RingBufferSize.store(std::max(NumEvents, 1u));
+}
+
+Uint64 CPUProfiler::GetTime() const
+{
+    return GetSteadyClockTime() - m_StartTime;
+}
+
+// Every thread keeps references to its event buffers in all profilers it recorded events to.
+// The buffers are shared with the profilers, so they outlive both the thread and the profiler.
+// When the thread exits, the buffers are marked as dead, so that the profilers can release them.
+struct CPUProfiler::ThreadEventsOwner
+{
+    std::vector<std::pair<Uint32, std::shared_ptr<ThreadEvents>>> Entries;
+
+    ~ThreadEventsOwner()
+    {
+        for (auto& Entry : Entries)
+            Entry.second->OnThreadExit();
+    }
+};
+
+CPUProfiler::ThreadEvents& CPUProfiler::GetThreadEvents()
+{
+    thread_local ThreadEventsOwner tlsOwner;
+    for (const auto& it : tlsOwner.Entries)
+    {
+        if (it.first == m_ProfilerId)
+            return *it.second;
+    }
+
+    auto pThreadEvents = std::make_shared<ThreadEvents>();
+    pThreadEvents->Events.resize(m_RingBufferSize.load());
+    {
+        std::lock_guard<std::mutex> Lock{m_ThreadsMtx};
+        ReleaseDeadThreads(m_RingBufferSize.load());
+        pThreadEvents->Name = "Thread " + std::to_string(m_NextThreadIdx++);
+        m_Threads.emplace_back(pThreadEvents);
+    }
+    tlsOwner.Entries.emplace_back(m_ProfilerId, pThreadEvents);
+    return *pThreadEvents;
+}
+
+void CPUProfiler::ReleaseDeadThreads(size_t MaxDeadEvents)
+{
+    // Keep the events of the most recently exited threads, up to MaxDeadEvents in total
+    size_t NumDeadEvents = 0;
+    for (size_t i = m_Threads.size(); i > 0; --i)
+    {
+        auto& pThread = m_Threads[i - 1];
+
+        bool Release = false;
+        {
+            Threading::SpinLockGuard Guard{pThread->Lock};
+            if (!pThread->IsAlive)
+            {
+                NumDeadEvents += pThread->Events.size();
+                Release = pThread->Events.empty() || NumDeadEvents > MaxDeadEvents;
+            }
+        }
+        if (Release)
+            pThread.reset();
+    }
+    m_Threads.erase(std::remove(m_Threads.begin(), m_Threads.end(), nullptr), m_Threads.end());
+}
+
+void CPUProfiler::RecordEvent(const Char* Name, const Char* Category, Uint64 BeginTime, Uint64 EndTime)
+{
+    VERIFY_EXPR(Name != nullptr);
+    auto& Thread = GetThreadEvents();
+
+    Threading::SpinLockGuard Guard{Thread.Lock};
+
+    auto& Event     = Thread.Events[Thread.NumRecorded % Thread.Events.size()];
+    Event.Name      = Name;
+    Event.Category  = Category;
+    Event.BeginTime = BeginTime;
+    Event.EndTime   = EndTime;
+    ++Thread.NumRecorded;
+}
+
+void CPUProfiler::SetThreadName(const Char* Name)
+{
+    auto& Thread = GetThreadEvents();
+
+    Threading::SpinLockGuard Guard{Thread.Lock};
+    Thread.Name = Name != nullptr ? Name : "";
+}
+
+void CPUProfiler::GetAllThreadEvents(std::vector<std::shared_ptr<ThreadEvents>>& Threads) const
+{
+    std::lock_guard<std::mutex> Lock{m_ThreadsMtx};
+    Threads = m_Threads;
+}
+
+void CPUProfiler::CopyEvents(ThreadEvents& Thread, std::string& Name, std::vector<CPUProfilerEvent>& Events)
+{
+    Threading::SpinLockGuard Guard{Thread.Lock};
+    ThreadEvents::CopyEvents(Thread, Name, Events);
+}
+
+size_t CPUProfiler::GetNumEvents() const
+{
+    size_t NumEvents = 0;
+    ProcessEvents([&NumEvents](Uint32, const std::string&, const std::vector<CPUProfilerEvent>& Events) {
+        NumEvents += Events.size();
+    });
+    return NumEvents;
+}
+
+void CPUProfiler::Clear()
+{
+    std::lock_guard<std::mutex> Lock{m_ThreadsMtx};
+    ReleaseDeadThreads(0);
+    for (auto& pThread : m_Threads)
+    {
+        Threading::SpinLockGuard Guard{pThread->Lock};
+        pThread->NumRecorded = 0;
+    }
+}
+
+std::string CPUProfiler::ExportChromeTrace() const
+{
+    // https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+    std::stringstream ss;
+    ss << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool IsFirst = true;
+    ProcessEvents([&](Uint32 ThreadIdx, const std::string& ThreadName, const std::vector<CPUProfilerEvent>& Events) {
+        if (!IsFirst)
+            ss << ',';
+        IsFirst = false;
+
+        ss << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ThreadIdx << ",\"args\":{\"name\":";
+        WriteJSONString(ss, ThreadName.c_str());
+        ss << "}}";
+
+        for (const auto& Event : Events)
+        {
+            ss << ",\n{\"name\":";
+            WriteJSONString(ss, Event.Name);
+            if (Event.Category != nullptr)
+            {
+                ss << ",\"cat\":";
+                WriteJSONString(ss, Event.Category);
+            }
+            ss << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << ThreadIdx << ",\"ts\":";
+            WriteMicroseconds(ss, Event.BeginTime);
+            ss << ",\"dur\":";
+            WriteMicroseconds(ss, Event.EndTime >= Event.BeginTime ? Event.EndTime - Event.BeginTime : 0);
+            ss << '}';
+        }
+    });
+
+    ss << "\n]}\n";
+    return ss.str();
+}
+
+bool CPUProfiler::ExportChromeTrace(const Char* FilePath) const
+{
+    DEV_CHECK_ERR(FilePath != nullptr, "File path must not be null");
+    if (FilePath == nullptr)
+        return false;
+
+    FileWrapper File{FilePath, EFileAccessMode::Overwrite};
+    if (!File)
+    {
+        LOG_ERROR_MESSAGE("Failed to open file ", FilePath);
+        return false;
+    }
+
+    const auto Trace = ExportChromeTrace();
+    return File->Write(Trace.data(), Trace.size());
+}
+
+} // namespace Diligent
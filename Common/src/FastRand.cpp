@@ -0,0 +1,428 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FastRand.hpp"
+
+#include <cstring>
+
+#include "BasicMathSIMD.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+using namespace MathSIMD;
+
+#if DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_SSE || DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_AVX
+
+using VecU4 = __m128i;
+
+inline VecU4 LoadU4(const Uint32* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+inline void  StoreU4(Uint32* p, VecU4 v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+inline void  StoreUnalignedU4(Uint32* p, VecU4 v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+inline VecU4 SetU4(Uint32 x) { return _mm_set1_epi32(static_cast<int>(x)); }
+inline VecU4 AddU4(VecU4 a, VecU4 b) { return _mm_add_epi32(a, b); }
+inline VecU4 SubU4(VecU4 a, VecU4 b) { return _mm_sub_epi32(a, b); }
+inline VecU4 XorU4(VecU4 a, VecU4 b) { return _mm_xor_si128(a, b); }
+inline VecU4 AndU4(VecU4 a, VecU4 b) { return _mm_and_si128(a, b); }
+inline VecU4 OrU4(VecU4 a, VecU4 b) { return _mm_or_si128(a, b); }
+template <int N>
+inline VecU4 ShlU4(VecU4 v) { return _mm_slli_epi32(v, N); }
+template <int N>
+inline VecU4 ShrU4(VecU4 v) { return _mm_srli_epi32(v, N); }
+/// Reinterprets the bits as floats.
+inline VecF4 AsF4(VecU4 v) { return _mm_castsi128_ps(v); }
+inline VecU4 AsU4(VecF4 v) { return _mm_castps_si128(v); }
+/// Converts signed 32-bit integers to floats.
+inline VecF4 ConvertI4ToF4(VecU4 v) { return _mm_cvtepi32_ps(v); }
+
+#elif DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_NEON
+
+using VecU4 = uint32x4_t;
+
+inline VecU4 LoadU4(const Uint32* p) { return vld1q_u32(p); }
+inline void  StoreU4(Uint32* p, VecU4 v) { vst1q_u32(p, v); }
+inline void  StoreUnalignedU4(Uint32* p, VecU4 v) { vst1q_u32(p, v); }
+inline VecU4 SetU4(Uint32 x) { return vdupq_n_u32(x); }
+inline VecU4 AddU4(VecU4 a, VecU4 b) { return vaddq_u32(a, b); }
+inline VecU4 SubU4(VecU4 a, VecU4 b) { return vsubq_u32(a, b); }
+inline VecU4 XorU4(VecU4 a, VecU4 b) { return veorq_u32(a, b); }
+inline VecU4 AndU4(VecU4 a, VecU4 b) { return vandq_u32(a, b); }
+inline VecU4 OrU4(VecU4 a, VecU4 b) { return vorrq_u32(a, b); }
+template <int N>
+inline VecU4 ShlU4(VecU4 v) { return vshlq_n_u32(v, N); }
+template <int N>
+inline VecU4 ShrU4(VecU4 v) { return vshrq_n_u32(v, N); }
+/// Reinterprets the bits as floats.
+inline VecF4 AsF4(VecU4 v) { return vreinterpretq_f32_u32(v); }
+inline VecU4 AsU4(VecF4 v) { return vreinterpretq_u32_f32(v); }
+/// Converts signed 32-bit integers to floats.
+inline VecF4 ConvertI4ToF4(VecU4 v) { return vcvtq_f32_s32(vreinterpretq_s32_u32(v)); }
+
+#else
+
+struct VecU4
+{
+    Uint32 v[4];
+};
+
+inline VecU4 LoadU4(const Uint32* p) { return VecU4{{p[0], p[1], p[2], p[3]}}; }
+inline void  StoreU4(Uint32* p, VecU4 v)
+{
+    for (int i = 0; i < 4; ++i)
+        p[i] = v.v[i];
+}
+inline void  StoreUnalignedU4(Uint32* p, VecU4 v) { StoreU4(p, v); }
+inline VecU4 SetU4(Uint32 x) { return VecU4{{x, x, x, x}}; }
+inline VecU4 AddU4(VecU4 a, VecU4 b) { return VecU4{{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}}; }
+inline VecU4 SubU4(VecU4 a, VecU4 b) { return VecU4{{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}}; }
+inline VecU4 XorU4(VecU4 a, VecU4 b) { return VecU4{{a.v[0] ^ b.v[0], a.v[1] ^ b.v[1], a.v[2] ^ b.v[2], a.v[3] ^ b.v[3]}}; }
+inline VecU4 AndU4(VecU4 a, VecU4 b) { return VecU4{{a.v[0] & b.v[0], a.v[1] & b.v[1], a.v[2] & b.v[2], a.v[3] & b.v[3]}}; }
+inline VecU4 OrU4(VecU4 a, VecU4 b) { return VecU4{{a.v[0] | b.v[0], a.v[1] | b.v[1], a.v[2] | b.v[2], a.v[3] | b.v[3]}}; }
+template <int N>
+inline VecU4 ShlU4(VecU4 v) { return VecU4{{v.v[0] << N, v.v[1] << N, v.v[2] << N, v.v[3] << N}}; }
+template <int N>
+inline VecU4 ShrU4(VecU4 v) { return VecU4{{v.v[0] >> N, v.v[1] >> N, v.v[2] >> N, v.v[3] >> N}}; }
+/// Reinterprets the bits as floats.
+inline VecF4 AsF4(VecU4 v)
+{
+    VecF4 f;
+    std::memcpy(f.v, v.v, sizeof(f.v));
+    return f;
+}
+inline VecU4 AsU4(VecF4 f)
+{
+    VecU4 v;
+    std::memcpy(v.v, f.v, sizeof(v.v));
+    return v;
+}
+/// Converts signed 32-bit integers to floats.
+inline VecF4 ConvertI4ToF4(VecU4 v)
+{
+    return VecF4{{static_cast<float>(static_cast<Int32>(v.v[0])), static_cast<float>(static_cast<Int32>(v.v[1])),
+                  static_cast<float>(static_cast<Int32>(v.v[2])), static_cast<float>(static_cast<Int32>(v.v[3]))}};
+}
+
+#endif
+
+template <int N>
+inline VecU4 RotlU4(VecU4 v)
+{
+    return OrU4(ShlU4<N>(v), ShrU4<32 - N>(v));
+}
+
+inline Uint32 Rotl(Uint32 x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+/// Advances the scalar xoshiro128++ state by one step.
+inline void Xoshiro128Next(Uint32 s[4])
+{
+    const Uint32 t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = Rotl(s[3], 11);
+}
+
+/// Advances the scalar xoshiro128++ state by the number of steps defined by the jump polynomial.
+void Xoshiro128Jump(Uint32 s[4], const Uint32 JumpPoly[4])
+{
+    Uint32 s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int b = 0; b < 32; ++b)
+        {
+            if (JumpPoly[i] & (Uint32{1} << b))
+            {
+                s0 ^= s[0];
+                s1 ^= s[1];
+                s2 ^= s[2];
+                s3 ^= s[3];
+            }
+            Xoshiro128Next(s);
+        }
+    }
+    s[0] = s0;
+    s[1] = s1;
+    s[2] = s2;
+    s[3] = s3;
+}
+
+// Equivalent to 2^64 calls to the generator
+constexpr Uint32 Xoshiro128JumpPoly[] = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+// Equivalent to 2^96 calls to the generator
+constexpr Uint32 Xoshiro128LongJumpPoly[] = {0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662};
+
+inline Uint64 SplitMix64(Uint64& x)
+{
+    Uint64 z = (x += Uint64{0x9e3779b97f4a7c15});
+    z        = (z ^ (z >> 30)) * Uint64{0xbf58476d1ce4e5b9};
+    z        = (z ^ (z >> 27)) * Uint64{0x94d049bb133111eb};
+    return z ^ (z >> 31);
+}
+
+/// Four xoshiro128++ streams advanced in SIMD lanes.
+struct Xoshiro128x4
+{
+    VecU4 s0, s1, s2, s3;
+
+    explicit Xoshiro128x4(const Uint32 State[4][FastRandBatch::NumLanes]) :
+        s0{LoadU4(State[0])},
+        s1{LoadU4(State[1])},
+        s2{LoadU4(State[2])},
+        s3{LoadU4(State[3])}
+    {}
+
+    void Store(Uint32 State[4][FastRandBatch::NumLanes]) const
+    {
+        StoreU4(State[0], s0);
+        StoreU4(State[1], s1);
+        StoreU4(State[2], s2);
+        StoreU4(State[3], s3);
+    }
+
+    VecU4 Next()
+    {
+        const VecU4 Result = AddU4(RotlU4<7>(AddU4(s0, s3)), s0);
+        const VecU4 t      = ShlU4<9>(s1);
+
+        s2 = XorU4(s2, s0);
+        s3 = XorU4(s3, s1);
+        s1 = XorU4(s1, s2);
+        s0 = XorU4(s0, s3);
+        s2 = XorU4(s2, t);
+        s3 = RotlU4<11>(s3);
+
+        return Result;
+    }
+};
+
+/// Converts random bits to floats uniformly distributed in [0, 1).
+inline VecF4 UnitFloatF4(VecU4 Bits)
+{
+    // Use the upper 24 bits that are exactly representable as float
+    return MulF4(ConvertI4ToF4(ShrU4<8>(Bits)), SetF4(1.f / 16777216.f));
+}
+
+/// Computes the natural logarithm of positive normalized values (Cephes logf).
+inline VecF4 LogF4(VecF4 x)
+{
+    const VecU4 Bits = AsU4(x);
+
+    // Split x into the mantissa m in [0.5, 1) and the exponent e so that x = m * 2^e
+    VecF4       e = ConvertI4ToF4(SubU4(ShrU4<23>(Bits), SetU4(126)));
+    const VecF4 m = AsF4(OrU4(AndU4(Bits, SetU4(0x007FFFFF)), SetU4(0x3F000000)));
+
+    // Move m to [sqrt(0.5), sqrt(2)) and compute f = m - 1
+    const MaskF4 Small = CmpLtF4(m, SetF4(0.707106781186547524f));
+    e                  = SubF4(e, SelectF4(Small, SetF4(1.f), SetF4(0.f)));
+    const VecF4 f      = SubF4(SelectF4(Small, AddF4(m, m), m), SetF4(1.f));
+
+    const VecF4 z = MulF4(f, f);
+
+    VecF4 y = SetF4(7.0376836292e-2f);
+    y       = AddF4(MulF4(y, f), SetF4(-1.1514610310e-1f));
+    y       = AddF4(MulF4(y, f), SetF4(1.1676998740e-1f));
+    y       = AddF4(MulF4(y, f), SetF4(-1.2420140846e-1f));
+    y       = AddF4(MulF4(y, f), SetF4(1.4249322787e-1f));
+    y       = AddF4(MulF4(y, f), SetF4(-1.6668057665e-1f));
+    y       = AddF4(MulF4(y, f), SetF4(2.0000714765e-1f));
+    y       = AddF4(MulF4(y, f), SetF4(-2.4999993993e-1f));
+    y       = AddF4(MulF4(y, f), SetF4(3.3333331174e-1f));
+    y       = MulF4(MulF4(y, f), z);
+
+    y = AddF4(y, MulF4(e, SetF4(-2.12194440e-4f)));
+    y = SubF4(y, MulF4(z, SetF4(0.5f)));
+
+    return AddF4(AddF4(f, y), MulF4(e, SetF4(0.693359375f)));
+}
+
+/// Generates eight standard normally distributed values using the Box-Muller transform.
+inline void NormalF4x2(Xoshiro128x4& Rng, VecF4& n0, VecF4& n1)
+{
+    const VecU4 Bits0 = Rng.Next();
+    const VecU4 Bits1 = Rng.Next();
+
+    // u in (0, 1], so that log(u) is finite
+    const VecF4 u = MulF4(ConvertI4ToF4(AddU4(ShrU4<8>(Bits0), SetU4(1))), SetF4(1.f / 16777216.f));
+    const VecF4 r = SqrtF4(MulF4(LogF4(u), SetF4(-2.f)));
+
+    // The angle theta = Quadrant * pi/2 + a is uniformly distributed when the quadrant is
+    // uniformly distributed in {0, 1, 2, 3} and a is uniformly distributed in [-pi/4, pi/4).
+    const VecF4 a = MulF4(SubF4(UnitFloatF4(Bits1), SetF4(0.5f)), SetF4(1.57079632679489662f));
+
+    VecF4 SinA, CosA;
+    SinCosReducedF4(a, SinA, CosA);
+
+    // Use the two lowest bits as the quadrant index:
+    //  Quadrant     sin(theta)    cos(theta)
+    //     0           sin(a)        cos(a)
+    //     1           cos(a)       -sin(a)
+    //     2          -sin(a)       -cos(a)
+    //     3          -cos(a)        sin(a)
+    const VecU4  Bit0 = AndU4(Bits1, SetU4(1));
+    const VecU4  Bit1 = AndU4(ShrU4<1>(Bits1), SetU4(1));
+    const MaskF4 Swap = CmpGtF4(ConvertI4ToF4(Bit0), SetF4(0.5f));
+
+    const VecF4 Sin = SelectF4(Swap, CosA, SinA);
+    const VecF4 Cos = SelectF4(Swap, SinA, CosA);
+
+    const VecU4 SinSign = ShlU4<31>(Bit1);
+    const VecU4 CosSign = ShlU4<31>(XorU4(Bit0, Bit1));
+
+    n0 = MulF4(r, AsF4(XorU4(AsU4(Sin), SinSign)));
+    n1 = MulF4(r, AsF4(XorU4(AsU4(Cos), CosSign)));
+}
+
+} // namespace
+
+constexpr size_t FastRandBatch::NumLanes;
+
+FastRandBatch::FastRandBatch(Uint64 Seed, Uint32 Stream) noexcept
+{
+    Uint32 s[4];
+    {
+        const Uint64 s01 = SplitMix64(Seed);
+        const Uint64 s23 = SplitMix64(Seed);
+
+        s[0] = static_cast<Uint32>(s01);
+        s[1] = static_cast<Uint32>(s01 >> 32);
+        s[2] = static_cast<Uint32>(s23);
+        s[3] = static_cast<Uint32>(s23 >> 32);
+        if ((s[0] | s[1] | s[2] | s[3]) == 0)
+            s[0] = 1; // All-zero state is not allowed
+    }
+
+    // Every stream is 2^96 steps apart, and every lane within the stream is 2^64 steps apart
+    for (Uint32 i = 0; i < Stream; ++i)
+        Xoshiro128Jump(s, Xoshiro128LongJumpPoly);
+
+    for (size_t Lane = 0; Lane < NumLanes; ++Lane)
+    {
+        if (Lane > 0)
+            Xoshiro128Jump(s, Xoshiro128JumpPoly);
+        for (size_t Word = 0; Word < 4; ++Word)
+            m_State[Word][Lane] = s[Word];
+    }
+}
+
+void FastRandBatch::GenerateUint(Uint32* pValues, size_t Count)
+{
+    Xoshiro128x4 Rng{m_State};
+
+    size_t i = 0;
+    for (; i + NumLanes <= Count; i += NumLanes)
+        StoreUnalignedU4(pValues + i, Rng.Next());
+
+    if (i < Count)
+    {
+        alignas(16) Uint32 Tail[NumLanes];
+        StoreU4(Tail, Rng.Next());
+        for (size_t j = 0; i < Count; ++i, ++j)
+            pValues[i] = Tail[j];
+    }
+
+    Rng.Store(m_State);
+}
+
+void FastRandBatch::GenerateInt(int* pValues, size_t Count, int Min, int Max)
+{
+    DEV_CHECK_ERR(Min <= Max, "Min (", Min, ") must not be greater than Max (", Max, ")");
+
+    // Signed and unsigned variants of the same type may alias each other
+    Uint32* pBits = reinterpret_cast<Uint32*>(pValues);
+    GenerateUint(pBits, Count);
+
+    // Map to the range using multiplication instead of modulo, which avoids division and
+    // is less biased (Lemire, "Fast Random Integer Generation in an Interval").
+    const Uint64 Range = static_cast<Uint64>(static_cast<Int64>(Max) - static_cast<Int64>(Min)) + 1;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const Uint32 Offset = static_cast<Uint32>((Uint64{pBits[i]} * Range) >> 32);
+        pValues[i]          = static_cast<int>(static_cast<Int64>(Min) + Offset);
+    }
+}
+
+void FastRandBatch::GenerateFloat(float* pValues, size_t Count, float Min, float Max)
+{
+    Xoshiro128x4 Rng{m_State};
+
+    const VecF4 MinVal   = SetF4(Min);
+    const VecF4 RangeVal = SetF4(Max - Min);
+
+    size_t i = 0;
+    for (; i + NumLanes <= Count; i += NumLanes)
+        StoreF4(pValues + i, AddF4(MulF4(UnitFloatF4(Rng.Next()), RangeVal), MinVal));
+
+    if (i < Count)
+    {
+        float Tail[NumLanes];
+        StoreF4(Tail, AddF4(MulF4(UnitFloatF4(Rng.Next()), RangeVal), MinVal));
+        for (size_t j = 0; i < Count; ++i, ++j)
+            pValues[i] = Tail[j];
+    }
+
+    Rng.Store(m_State);
+}
+
+void FastRandBatch::GenerateNormal(float* pValues, size_t Count, float Mean, float StdDev)
+{
+    Xoshiro128x4 Rng{m_State};
+
+    const VecF4 MeanVal   = SetF4(Mean);
+    const VecF4 StdDevVal = SetF4(StdDev);
+
+    size_t i = 0;
+    for (; i + NumLanes * 2 <= Count; i += NumLanes * 2)
+    {
+        VecF4 n0, n1;
+        NormalF4x2(Rng, n0, n1);
+        StoreF4(pValues + i, AddF4(MulF4(n0, StdDevVal), MeanVal));
+        StoreF4(pValues + i + NumLanes, AddF4(MulF4(n1, StdDevVal), MeanVal));
+    }
+
+    if (i < Count)
+    {
+        float Tail[NumLanes * 2];
+        VecF4 n0, n1;
+        NormalF4x2(Rng, n0, n1);
+        StoreF4(Tail, AddF4(MulF4(n0, StdDevVal), MeanVal));
+        StoreF4(Tail + NumLanes, AddF4(MulF4(n1, StdDevVal), MeanVal));
+        for (size_t j = 0; i < Count; ++i, ++j)
+            pValues[i] = Tail[j];
+    }
+
+    Rng.Store(m_State);
+}
+
+} // namespace Diligent
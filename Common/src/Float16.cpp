@@ -0,0 +1,165 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "Float16.hpp"
+
+#include "Intrinsics.hpp"
+#include "BasicMathSIMD.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+#if DILIGENT_F16C_ENABLED
+
+inline void Float32ToFloat16x8(const float* pSrc, Uint16* pDst)
+{
+    const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(pSrc), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), h);
+}
+
+inline void Float16ToFloat32x8(const Uint16* pSrc, float* pDst)
+{
+    const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+    _mm256_storeu_ps(pDst, _mm256_cvtph_ps(h));
+}
+
+#elif DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_SSE || DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_AVX
+
+// SSE2 versions of the scalar conversions, see
+// https://gist.github.com/rygorous/2156668
+
+inline __m128i Float32ToFloat16x4(__m128 f)
+{
+    const __m128i SignMask     = _mm_set1_epi32(0x80000000);
+    const __m128i F16Max       = _mm_set1_epi32((127 + 16) << 23); // All values >= this round to infinity
+    const __m128i MinNormal    = _mm_set1_epi32((127 - 14) << 23); // Smallest value that yields a normalized half
+    const __m128i SubnormMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i NormalBias   = _mm_set1_epi32(0xFFF - ((127 - 15) << 23)); // Rebias exponent and round mantissa
+    const __m128i InfinityBits = _mm_set1_epi32(0x7C00);
+    const __m128i QuietNaNBit  = _mm_set1_epi32(0x0200);
+    const __m128  Sign         = _mm_and_ps(_mm_castsi128_ps(SignMask), f);
+    const __m128  AbsF         = _mm_xor_ps(f, Sign);
+    const __m128i AbsBits      = _mm_castps_si128(AbsF);
+    const __m128i IsNaN        = _mm_castps_si128(_mm_cmpunord_ps(AbsF, AbsF));
+    const __m128i IsRegular    = _mm_cmpgt_epi32(F16Max, AbsBits);
+    const __m128i InfOrNaN     = _mm_or_si128(_mm_and_si128(IsNaN, QuietNaNBit), InfinityBits);
+    const __m128i IsSubnormal  = _mm_cmpgt_epi32(MinNormal, AbsBits);
+    const __m128i Subnormal    = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(AbsF, _mm_castsi128_ps(SubnormMagic))), SubnormMagic);
+    const __m128i MantOdd      = _mm_srai_epi32(_mm_slli_epi32(AbsBits, 31 - 13), 31); // -1 if half mantissa is odd
+    const __m128i Normal       = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(AbsBits, NormalBias), MantOdd), 13);
+    const __m128i NonSpecial   = _mm_or_si128(_mm_and_si128(IsSubnormal, Subnormal), _mm_andnot_si128(IsSubnormal, Normal));
+    const __m128i Joined       = _mm_or_si128(_mm_and_si128(IsRegular, NonSpecial), _mm_andnot_si128(IsRegular, InfOrNaN));
+    // Arithmetic shift keeps the values within the signed 16-bit range, which is required for _mm_packs_epi32
+    return _mm_or_si128(Joined, _mm_srai_epi32(_mm_castps_si128(Sign), 16));
+}
+
+inline __m128 Float16ToFloat32x4(__m128i h)
+{
+    const __m128i NoSignMask = _mm_set1_epi32(0x7FFF);
+    const __m128i MaxFinite  = _mm_set1_epi32(0x7BFF);
+    const __m128  Magic      = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+    const __m128  InfNaNExp  = _mm_castsi128_ps(_mm_set1_epi32(255 << 23));
+
+    const __m128i ExpMant = _mm_and_si128(NoSignMask, h);
+    const __m128i Sign    = _mm_slli_epi32(_mm_xor_si128(h, ExpMant), 16);
+    // Multiplication by the magic value rebiases the exponent and renormalizes subnormals
+    const __m128  Scaled    = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(ExpMant, 13)), Magic);
+    const __m128i WasInfNaN = _mm_cmpgt_epi32(ExpMant, MaxFinite);
+    return _mm_or_ps(Scaled, _mm_or_ps(_mm_castsi128_ps(Sign), _mm_and_ps(_mm_castsi128_ps(WasInfNaN), InfNaNExp)));
+}
+
+inline void Float32ToFloat16x8(const float* pSrc, Uint16* pDst)
+{
+    const __m128i h0 = Float32ToFloat16x4(_mm_loadu_ps(pSrc));
+    const __m128i h1 = Float32ToFloat16x4(_mm_loadu_ps(pSrc + 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_packs_epi32(h0, h1));
+}
+
+inline void Float16ToFloat32x8(const Uint16* pSrc, float* pDst)
+{
+    const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+    _mm_storeu_ps(pDst, Float16ToFloat32x4(_mm_unpacklo_epi16(h, _mm_setzero_si128())));
+    _mm_storeu_ps(pDst + 4, Float16ToFloat32x4(_mm_unpackhi_epi16(h, _mm_setzero_si128())));
+}
+
+#elif DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_NEON && (defined(__aarch64__) || defined(_M_ARM64))
+
+inline void Float32ToFloat16x8(const float* pSrc, Uint16* pDst)
+{
+    const float16x4_t h0 = vcvt_f16_f32(vld1q_f32(pSrc));
+    const float16x4_t h1 = vcvt_f16_f32(vld1q_f32(pSrc + 4));
+    vst1q_u16(pDst, vcombine_u16(vreinterpret_u16_f16(h0), vreinterpret_u16_f16(h1)));
+}
+
+inline void Float16ToFloat32x8(const Uint16* pSrc, float* pDst)
+{
+    const uint16x8_t h = vld1q_u16(pSrc);
+    vst1q_f32(pDst, vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(h))));
+    vst1q_f32(pDst + 4, vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(h))));
+}
+
+#else
+
+inline void Float32ToFloat16x8(const float* pSrc, Uint16* pDst)
+{
+    for (size_t i = 0; i < 8; ++i)
+        pDst[i] = Float32ToFloat16(pSrc[i]);
+}
+
+inline void Float16ToFloat32x8(const Uint16* pSrc, float* pDst)
+{
+    for (size_t i = 0; i < 8; ++i)
+        pDst[i] = Float16ToFloat32(pSrc[i]);
+}
+
+#endif
+
+} // namespace
+
+void Float32ToFloat16(const float* pSrc, Uint16* pDst, size_t Count)
+{
+    size_t i = 0;
+    for (; i + 8 <= Count; i += 8)
+        Float32ToFloat16x8(pSrc + i, pDst + i);
+
+    for (; i < Count; ++i)
+        pDst[i] = Float32ToFloat16(pSrc[i]);
+}
+
+void Float16ToFloat32(const Uint16* pSrc, float* pDst, size_t Count)
+{
+    size_t i = 0;
+    for (; i + 8 <= Count; i += 8)
+        Float16ToFloat32x8(pSrc + i, pDst + i);
+
+    for (; i < Count; ++i)
+        pDst[i] = Float16ToFloat32(pSrc[i]);
+}
+
+} // namespace Diligent
@@ -0,0 +1,467 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FrustumCulling.hpp"
+
+#include <algorithm>
+
+#include "BasicMathSIMD.hpp"
+#include "ThreadPool.hpp"
+#include "Align.hpp"
+#include "PlatformMisc.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct SIMD4
+{
+    using Vec  = MathSIMD::VecF4;
+    using Mask = MathSIMD::MaskF4;
+
+    static constexpr Uint32 Width = 4;
+
+    static Vec    Load(const float* p) { return MathSIMD::LoadF4(p); }
+    static Vec    Set(float x) { return MathSIMD::SetF4(x); }
+    static Vec    Add(Vec a, Vec b) { return MathSIMD::AddF4(a, b); }
+    static Vec    Sub(Vec a, Vec b) { return MathSIMD::SubF4(a, b); }
+    static Vec    Mul(Vec a, Vec b) { return MathSIMD::MulF4(a, b); }
+    static Vec    Abs(Vec v) { return MathSIMD::AbsF4(v); }
+    static Mask   CmpLt(Vec a, Vec b) { return MathSIMD::CmpLtF4(a, b); }
+    static Mask   CmpLe(Vec a, Vec b) { return MathSIMD::CmpLeF4(a, b); }
+    static Mask   CmpGt(Vec a, Vec b) { return MathSIMD::CmpGtF4(a, b); }
+    static Mask   CmpGe(Vec a, Vec b) { return MathSIMD::CmpGeF4(a, b); }
+    static Mask   And(Mask a, Mask b) { return MathSIMD::AndMaskF4(a, b); }
+    static Mask   Or(Mask a, Mask b) { return MathSIMD::OrMaskF4(a, b); }
+    static Mask   True() { return MathSIMD::TrueMaskF4(); }
+    static Mask   False() { return MathSIMD::FalseMaskF4(); }
+    static Uint32 MoveMask(Mask m) { return static_cast<Uint32>(MathSIMD::MoveMaskF4(m)); }
+};
+
+#if DILIGENT_MATH_SIMD == DILIGENT_MATH_SIMD_AVX
+struct SIMD8
+{
+    using Vec  = __m256;
+    using Mask = __m256;
+
+    static constexpr Uint32 Width = 8;
+
+    static Vec    Load(const float* p) { return _mm256_loadu_ps(p); }
+    static Vec    Set(float x) { return _mm256_set1_ps(x); }
+    static Vec    Add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+    static Vec    Sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+    static Vec    Mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+    static Vec    Abs(Vec v) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), v); }
+    static Mask   CmpLt(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Mask   CmpLe(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static Mask   CmpGt(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static Mask   CmpGe(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static Mask   And(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+    static Mask   Or(Mask a, Mask b) { return _mm256_or_ps(a, b); }
+    static Mask   True() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+    static Mask   False() { return _mm256_setzero_ps(); }
+    static Uint32 MoveMask(Mask m) { return static_cast<Uint32>(_mm256_movemask_ps(m)); }
+};
+using SIMDBatch = SIMD8;
+#else
+using SIMDBatch = SIMD4;
+#endif
+
+// Frustum planes selected by the plane flags, broadcast to all lanes
+template <typename S>
+struct FrustumPlanesLanes
+{
+    FrustumPlanesLanes(const ViewFrustum& Frustum, FRUSTUM_PLANE_FLAGS PlaneFlags)
+    {
+        for (Uint32 plane_idx = 0; plane_idx < ViewFrustum::NUM_PLANES; ++plane_idx)
+        {
+            if ((PlaneFlags & (1u << plane_idx)) == 0)
+                continue;
+
+            const Plane3D& Plane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(plane_idx));
+
+            auto& Lanes = Planes[NumPlanes++];
+            Lanes.Nx    = S::Set(Plane.Normal.x);
+            Lanes.Ny    = S::Set(Plane.Normal.y);
+            Lanes.Nz    = S::Set(Plane.Normal.z);
+            Lanes.AbsNx = S::Set(std::abs(Plane.Normal.x));
+            Lanes.AbsNy = S::Set(std::abs(Plane.Normal.y));
+            Lanes.AbsNz = S::Set(std::abs(Plane.Normal.z));
+            Lanes.D     = S::Set(Plane.Distance);
+        }
+    }
+
+    // Frustum plane broadcast to all lanes
+    struct PlaneLanes
+    {
+        typename S::Vec Nx, Ny, Nz;
+        typename S::Vec AbsNx, AbsNy, AbsNz;
+        typename S::Vec D;
+    };
+
+    PlaneLanes Planes[ViewFrustum::NUM_PLANES];
+    Uint32     NumPlanes = 0;
+};
+
+// Frustum AABB computed from the frustum corners, broadcast to all lanes
+template <typename S>
+struct FrustumBoundsLanes
+{
+    explicit FrustumBoundsLanes(const ViewFrustumExt& FrustumExt)
+    {
+        float3 FrustMin = FrustumExt.FrustumCorners[0];
+        float3 FrustMax = FrustumExt.FrustumCorners[0];
+        for (Uint32 i = 1; i < 8; ++i)
+        {
+            FrustMin = (std::min)(FrustMin, FrustumExt.FrustumCorners[i]);
+            FrustMax = (std::max)(FrustMax, FrustumExt.FrustumCorners[i]);
+        }
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            Min[c] = S::Set(FrustMin[c]);
+            Max[c] = S::Set(FrustMax[c]);
+        }
+    }
+
+    typename S::Vec Min[3];
+    typename S::Vec Max[3];
+};
+
+// Tests S::Width boxes against the frustum planes.
+// OutsideBits receives the boxes that are outside of at least one plane,
+// InsideBits receives the boxes that are inside all planes.
+template <typename S>
+void TestBoundBoxes(const FrustumPlanesLanes<S>& Planes,
+                    const float*                 Coords[6],
+                    Uint32&                      OutsideBits,
+                    Uint32&                      InsideBits)
+{
+    const auto MinX = S::Load(Coords[0]);
+    const auto MinY = S::Load(Coords[1]);
+    const auto MinZ = S::Load(Coords[2]);
+    const auto MaxX = S::Load(Coords[3]);
+    const auto MaxY = S::Load(Coords[4]);
+    const auto MaxZ = S::Load(Coords[5]);
+
+    // Same operation order as in GetBoxVisibilityAgainstPlane(const Plane3D&, const BoundBox&)
+    // so that the results are identical
+    const auto SumX  = S::Add(MaxX, MinX);
+    const auto SumY  = S::Add(MaxY, MinY);
+    const auto SumZ  = S::Add(MaxZ, MinZ);
+    const auto DiffX = S::Sub(MaxX, MinX);
+    const auto DiffY = S::Sub(MaxY, MinY);
+    const auto DiffZ = S::Sub(MaxZ, MinZ);
+    const auto Half  = S::Set(0.5f);
+    const auto Zero  = S::Set(0.f);
+
+    const Uint32 AllLanes = (1u << S::Width) - 1u;
+
+    auto Outside = S::False();
+    auto Inside  = S::True();
+    for (Uint32 i = 0; i < Planes.NumPlanes; ++i)
+    {
+        const auto& Plane = Planes.Planes[i];
+
+        const auto DistanceToCenter = S::Add(S::Mul(S::Add(S::Add(S::Mul(SumX, Plane.Nx), S::Mul(SumY, Plane.Ny)), S::Mul(SumZ, Plane.Nz)), Half), Plane.D);
+        const auto ProjHalfLen      = S::Mul(S::Add(S::Add(S::Mul(DiffX, Plane.AbsNx), S::Mul(DiffY, Plane.AbsNy)), S::Mul(DiffZ, Plane.AbsNz)), Half);
+
+        Outside = S::Or(Outside, S::CmpLt(DistanceToCenter, S::Sub(Zero, ProjHalfLen)));
+        Inside  = S::And(Inside, S::CmpGt(DistanceToCenter, ProjHalfLen));
+
+        if (S::MoveMask(Outside) == AllLanes)
+            break;
+    }
+
+    OutsideBits = S::MoveMask(Outside);
+    InsideBits  = S::MoveMask(Inside) & ~OutsideBits;
+}
+
+// Tests S::Width boxes against the frustum bounds and returns the boxes
+// that are fully outside of the frustum AABB.
+template <typename S>
+Uint32 TestBoundBoxesAgainstFrustumBounds(const FrustumBoundsLanes<S>& Bounds,
+                                          const float*                 Coords[6])
+{
+    // The whole frustum is outside of the box plane if all corners are outside of it, which is
+    // equivalent to the frustum bound being outside of the plane.
+    auto Outside = S::False();
+    for (Uint32 c = 0; c < 3; ++c)
+    {
+        Outside = S::Or(Outside, S::CmpLe(Bounds.Max[c], S::Load(Coords[c])));
+        Outside = S::Or(Outside, S::CmpGe(Bounds.Min[c], S::Load(Coords[3 + c])));
+    }
+    return S::MoveMask(Outside);
+}
+
+template <typename S>
+void TestOrientedBoxes(const FrustumPlanesLanes<S>&  Planes,
+                       const OrientedBoundingBoxSOA& Boxes,
+                       size_t                        Offset,
+                       Uint32&                       OutsideBits,
+                       Uint32&                       InsideBits)
+{
+    const auto CX = S::Load(Boxes.CenterX + Offset);
+    const auto CY = S::Load(Boxes.CenterY + Offset);
+    const auto CZ = S::Load(Boxes.CenterZ + Offset);
+
+    typename S::Vec AX[3], AY[3], AZ[3], H[3];
+    for (Uint32 a = 0; a < 3; ++a)
+    {
+        AX[a] = S::Load(Boxes.AxisX[a] + Offset);
+        AY[a] = S::Load(Boxes.AxisY[a] + Offset);
+        AZ[a] = S::Load(Boxes.AxisZ[a] + Offset);
+        H[a]  = S::Load(Boxes.HalfExtents[a] + Offset);
+    }
+
+    const auto   Zero     = S::Set(0.f);
+    const Uint32 AllLanes = (1u << S::Width) - 1u;
+
+    auto Outside = S::False();
+    auto Inside  = S::True();
+    for (Uint32 i = 0; i < Planes.NumPlanes; ++i)
+    {
+        const auto& Plane = Planes.Planes[i];
+
+        // Same operation order as in GetBoxVisibilityAgainstPlane(const Plane3D&, const OrientedBoundingBox&)
+        const auto Distance = S::Add(S::Add(S::Add(S::Mul(CX, Plane.Nx), S::Mul(CY, Plane.Ny)), S::Mul(CZ, Plane.Nz)), Plane.D);
+
+        typename S::Vec ProjHalfExtents = Zero;
+        for (Uint32 a = 0; a < 3; ++a)
+        {
+            const auto AxisProj = S::Abs(S::Add(S::Add(S::Mul(AX[a], Plane.Nx), S::Mul(AY[a], Plane.Ny)), S::Mul(AZ[a], Plane.Nz)));
+            const auto Proj     = S::Mul(AxisProj, H[a]);
+            ProjHalfExtents     = a == 0 ? Proj : S::Add(ProjHalfExtents, Proj);
+        }
+
+        Outside = S::Or(Outside, S::CmpLt(Distance, S::Sub(Zero, ProjHalfExtents)));
+        Inside  = S::And(Inside, S::CmpGt(Distance, ProjHalfExtents));
+
+        if (S::MoveMask(Outside) == AllLanes)
+            break;
+    }
+
+    OutsideBits = S::MoveMask(Outside);
+    InsideBits  = S::MoveMask(Inside) & ~OutsideBits;
+}
+
+void WriteVisibility(const BatchBoxVisibilityAttribs& Attribs,
+                     size_t                           FirstBox,
+                     Uint32                           NumBoxes,
+                     Uint32                           OutsideBits,
+                     Uint32                           InsideBits)
+{
+    const Uint32 VisibleBits = ~OutsideBits & ((1u << NumBoxes) - 1u);
+
+    // Groups never straddle mask words since the chunk size is a multiple of 32 and
+    // the group size is a power of two not greater than 32.
+    VERIFY_EXPR(FirstBox / 32 == (FirstBox + NumBoxes - 1) / 32);
+    Attribs.pVisibilityMask[FirstBox / 32] |= VisibleBits << (FirstBox % 32);
+
+    if (Attribs.pVisibility != nullptr)
+    {
+        for (Uint32 i = 0; i < NumBoxes; ++i)
+        {
+            const Uint32 Bit = 1u << i;
+            Attribs.pVisibility[FirstBox + i] =
+                (OutsideBits & Bit) ? BoxVisibility::Invisible :
+                                      ((InsideBits & Bit) ? BoxVisibility::FullyVisible : BoxVisibility::Intersecting);
+        }
+    }
+}
+
+// Processes all boxes in the chunk. The handler is called as
+// Handler(const float* Coords[], Offset, OutsideBits, InsideBits), where Offset is
+// the index of the first box in Coords arrays.
+template <typename S, Uint32 NumComponents, typename HandlerType>
+void ProcessChunk(const BatchBoxVisibilityAttribs& Attribs,
+                  const float* const               Components[],
+                  size_t                           StartBox,
+                  size_t                           EndBox,
+                  HandlerType&&                    Handler)
+{
+    // Clear the mask words of the chunk. StartBox is always a multiple of 32.
+    VERIFY_EXPR(StartBox % 32 == 0);
+    for (size_t w = StartBox / 32; w < (EndBox + 31) / 32; ++w)
+        Attribs.pVisibilityMask[w] = 0;
+
+    size_t box = StartBox;
+    for (; box + S::Width <= EndBox; box += S::Width)
+    {
+        Uint32 OutsideBits = 0, InsideBits = 0;
+        Handler(Components, box, OutsideBits, InsideBits);
+        WriteVisibility(Attribs, box, S::Width, OutsideBits, InsideBits);
+    }
+
+    if (box < EndBox)
+    {
+        // Copy the remaining boxes to zero-padded arrays
+        const Uint32 NumRemaining = static_cast<Uint32>(EndBox - box);
+
+        float        Padded[NumComponents][S::Width] = {};
+        const float* PaddedComponents[NumComponents];
+        for (Uint32 c = 0; c < NumComponents; ++c)
+        {
+            for (Uint32 i = 0; i < NumRemaining; ++i)
+                Padded[c][i] = Components[c][box + i];
+            PaddedComponents[c] = Padded[c];
+        }
+
+        Uint32 OutsideBits = 0, InsideBits = 0;
+        Handler(PaddedComponents, 0, OutsideBits, InsideBits);
+        WriteVisibility(Attribs, box, NumRemaining, OutsideBits, InsideBits);
+    }
+}
+
+template <typename ChunkHandlerType>
+size_t ProcessBoxes(const BatchBoxVisibilityAttribs& Attribs, const ChunkHandlerType& ChunkHandler)
+{
+    if (Attribs.NumBoxes == 0)
+        return 0;
+
+    DEV_CHECK_ERR(Attribs.pVisibilityMask != nullptr, "Visibility mask must not be null");
+
+    const size_t ChunkSize = AlignUp(std::max<size_t>(Attribs.ChunkSize, 32), size_t{32});
+    const size_t NumChunks = (Attribs.NumBoxes + ChunkSize - 1) / ChunkSize;
+    DEV_CHECK_ERR(NumChunks <= UINT32_MAX, "Too many chunks");
+
+    ParallelFor(
+        Attribs.pThreadPool, static_cast<Uint32>(NumChunks),
+        [&](Uint32 Chunk) {
+            const size_t StartBox = Chunk * ChunkSize;
+            const size_t EndBox   = std::min(StartBox + ChunkSize, Attribs.NumBoxes);
+            ChunkHandler(StartBox, EndBox);
+        },
+        Attribs.NumWorkerTasks);
+
+    size_t NumVisible = 0;
+    for (size_t w = 0; w < (Attribs.NumBoxes + 31) / 32; ++w)
+        NumVisible += PlatformMisc::CountOneBits(Attribs.pVisibilityMask[w]);
+
+    return NumVisible;
+}
+
+} // namespace
+
+size_t GetBoxVisibilityBatch(const ViewFrustum&               Frustum,
+                             const BoundBoxSOA&               Boxes,
+                             const BatchBoxVisibilityAttribs& Attribs)
+{
+    using S = SIMDBatch;
+
+    const FrustumPlanesLanes<S> Planes{Frustum, Attribs.PlaneFlags};
+
+    const float* const Components[] = {Boxes.MinX, Boxes.MinY, Boxes.MinZ, Boxes.MaxX, Boxes.MaxY, Boxes.MaxZ};
+    return ProcessBoxes(Attribs, [&](size_t StartBox, size_t EndBox) {
+        ProcessChunk<S, 6>(Attribs, Components, StartBox, EndBox,
+                           [&](const float* const Comps[], size_t Offset, Uint32& OutsideBits, Uint32& InsideBits) {
+                               const float* Coords[6];
+                               for (Uint32 c = 0; c < 6; ++c)
+                                   Coords[c] = Comps[c] + Offset;
+                               TestBoundBoxes(Planes, Coords, OutsideBits, InsideBits);
+                           });
+    });
+}
+
+size_t GetBoxVisibilityBatch(const ViewFrustumExt&            FrustumExt,
+                             const BoundBoxSOA&               Boxes,
+                             const BatchBoxVisibilityAttribs& Attribs)
+{
+    using S = SIMDBatch;
+
+    if ((Attribs.PlaneFlags & FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) != FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+    {
+        // The frustum corners are only tested against the boxes when all planes are enabled
+        return GetBoxVisibilityBatch(static_cast<const ViewFrustum&>(FrustumExt), Boxes, Attribs);
+    }
+
+    const FrustumPlanesLanes<S> Planes{FrustumExt, Attribs.PlaneFlags};
+    const FrustumBoundsLanes<S> Bounds{FrustumExt};
+
+    const float* const Components[] = {Boxes.MinX, Boxes.MinY, Boxes.MinZ, Boxes.MaxX, Boxes.MaxY, Boxes.MaxZ};
+    return ProcessBoxes(Attribs, [&](size_t StartBox, size_t EndBox) {
+        ProcessChunk<S, 6>(Attribs, Components, StartBox, EndBox,
+                           [&](const float* const Comps[], size_t Offset, Uint32& OutsideBits, Uint32& InsideBits) {
+                               const float* Coords[6];
+                               for (Uint32 c = 0; c < 6; ++c)
+                                   Coords[c] = Comps[c] + Offset;
+                               TestBoundBoxes(Planes, Coords, OutsideBits, InsideBits);
+
+                               // Only intersecting boxes are tested against the frustum bounds
+                               const Uint32 IntersectingBits = ~(OutsideBits | InsideBits) & ((1u << S::Width) - 1u);
+                               if (IntersectingBits != 0)
+                                   OutsideBits |= TestBoundBoxesAgainstFrustumBounds(Bounds, Coords) & IntersectingBits;
+                           });
+    });
+}
+
+size_t GetBoxVisibilityBatch(const ViewFrustum&               Frustum,
+                             const OrientedBoundingBoxSOA&    Boxes,
+                             const BatchBoxVisibilityAttribs& Attribs)
+{
+    using S = SIMDBatch;
+
+    const FrustumPlanesLanes<S> Planes{Frustum, Attribs.PlaneFlags};
+
+    const float* const Components[] = {
+        Boxes.CenterX,
+        Boxes.CenterY,
+        Boxes.CenterZ,
+        Boxes.AxisX[0],
+        Boxes.AxisX[1],
+        Boxes.AxisX[2],
+        Boxes.AxisY[0],
+        Boxes.AxisY[1],
+        Boxes.AxisY[2],
+        Boxes.AxisZ[0],
+        Boxes.AxisZ[1],
+        Boxes.AxisZ[2],
+        Boxes.HalfExtents[0],
+        Boxes.HalfExtents[1],
+        Boxes.HalfExtents[2],
+    };
+    return ProcessBoxes(Attribs, [&](size_t StartBox, size_t EndBox) {
+        ProcessChunk<S, 15>(Attribs, Components, StartBox, EndBox,
+                            [&](const float* const Comps[], size_t Offset, Uint32& OutsideBits, Uint32& InsideBits) {
+                                OrientedBoundingBoxSOA Group;
+                                Group.CenterX = Comps[0];
+                                Group.CenterY = Comps[1];
+                                Group.CenterZ = Comps[2];
+                                for (Uint32 a = 0; a < 3; ++a)
+                                {
+                                    Group.AxisX[a]       = Comps[3 + a];
+                                    Group.AxisY[a]       = Comps[6 + a];
+                                    Group.AxisZ[a]       = Comps[9 + a];
+                                    Group.HalfExtents[a] = Comps[12 + a];
+                                }
+                                TestOrientedBoxes(Planes, Group, Offset, OutsideBits, InsideBits);
+                            });
+    });
+}
+
+} // namespace Diligent
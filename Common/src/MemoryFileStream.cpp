@@ -29,6 +29,7 @@
 #include "pch.h"
 
 #include "MemoryFileStream.hpp"
+#include "DataBlobImpl.hpp"
 
 namespace Diligent
 {
@@ -38,6 +39,11 @@ RefCntAutoPtr<MemoryFileStream> MemoryFileStream::Create(IDataBlob* pData)
     return RefCntAutoPtr<MemoryFileStream>{MakeNewRCObj<MemoryFileStream>()(pData)};
 }
 
+RefCntAutoPtr<MemoryFileStream> MemoryFileStream::CreateChunked(size_t ChunkSize)
+{
+    return RefCntAutoPtr<MemoryFileStream>{MakeNewRCObj<MemoryFileStream>()(ChunkSize)};
+}
+
 MemoryFileStream::MemoryFileStream(IReferenceCounters* pRefCounters,
                                    IDataBlob*          pData) :
     TBase{pRefCounters},
@@ -45,10 +51,39 @@ MemoryFileStream::MemoryFileStream(IReferenceCounters* pRefCounters,
 {
 }
 
+MemoryFileStream::MemoryFileStream(IReferenceCounters* pRefCounters,
+                                   size_t              ChunkSize) :
+    TBase{pRefCounters},
+    m_ChunkSize{ChunkSize}
+{
+    VERIFY(m_ChunkSize != 0, "Chunk size must not be zero");
+    if (m_ChunkSize == 0)
+        m_ChunkSize = DefaultChunkSize;
+}
+
 IMPLEMENT_QUERY_INTERFACE(MemoryFileStream, IID_FileStream, TBase)
 
 bool MemoryFileStream::Read(void* Data, size_t Size)
 {
+    if (IsChunked())
+    {
+        VERIFY_EXPR(m_CurrentOffset <= m_ChunkedSize);
+        const auto BytesToRead = std::min(m_ChunkedSize - m_CurrentOffset, Size);
+
+        auto* pDst = reinterpret_cast<Uint8*>(Data);
+        for (size_t BytesLeft = BytesToRead; BytesLeft > 0;)
+        {
+            const auto ChunkIdx    = m_CurrentOffset / m_ChunkSize;
+            const auto ChunkOffset = m_CurrentOffset % m_ChunkSize;
+            const auto CopySize    = std::min(BytesLeft, m_ChunkSize - ChunkOffset);
+            memcpy(pDst, m_Chunks[ChunkIdx].get() + ChunkOffset, CopySize);
+            pDst += CopySize;
+            m_CurrentOffset += CopySize;
+            BytesLeft -= CopySize;
+        }
+        return Size == BytesToRead;
+    }
+
     VERIFY_EXPR(m_CurrentOffset <= m_DataBlob->GetSize());
     auto  BytesLeft   = m_DataBlob->GetSize() - m_CurrentOffset;
     auto  BytesToRead = std::min(BytesLeft, Size);
@@ -60,7 +95,7 @@ bool MemoryFileStream::Read(void* Data, size_t Size)
 
 void MemoryFileStream::ReadBlob(IDataBlob* pData)
 {
-    auto BytesLeft = m_DataBlob->GetSize() - m_CurrentOffset;
+    auto BytesLeft = GetSize() - m_CurrentOffset;
     pData->Resize(BytesLeft);
     auto res = Read(pData->GetDataPtr(), pData->GetSize());
     VERIFY_EXPR(res);
@@ -69,6 +104,27 @@ void MemoryFileStream::ReadBlob(IDataBlob* pData)
 
 bool MemoryFileStream::Write(const void* Data, size_t Size)
 {
+    if (IsChunked())
+    {
+        const auto EndOffset = m_CurrentOffset + Size;
+        while (m_Chunks.size() * m_ChunkSize < EndOffset)
+            m_Chunks.emplace_back(new Uint8[m_ChunkSize]);
+
+        const auto* pSrc = reinterpret_cast<const Uint8*>(Data);
+        for (size_t BytesLeft = Size; BytesLeft > 0;)
+        {
+            const auto ChunkIdx    = m_CurrentOffset / m_ChunkSize;
+            const auto ChunkOffset = m_CurrentOffset % m_ChunkSize;
+            const auto CopySize    = std::min(BytesLeft, m_ChunkSize - ChunkOffset);
+            memcpy(m_Chunks[ChunkIdx].get() + ChunkOffset, pSrc, CopySize);
+            pSrc += CopySize;
+            m_CurrentOffset += CopySize;
+            BytesLeft -= CopySize;
+        }
+        m_ChunkedSize = std::max(m_ChunkedSize, EndOffset);
+        return true;
+    }
+
     if (m_CurrentOffset + Size > m_DataBlob->GetSize())
     {
         m_DataBlob->Resize(m_CurrentOffset + Size);
@@ -81,12 +137,85 @@ bool MemoryFileStream::Write(const void* Data, size_t Size)
 
 bool MemoryFileStream::IsValid()
 {
-    return !!m_DataBlob;
+    return IsChunked() || !!m_DataBlob;
 }
 
 size_t MemoryFileStream::GetSize()
 {
-    return m_DataBlob->GetSize();
+    return IsChunked() ? m_ChunkedSize : m_DataBlob->GetSize();
+}
+
+bool MemoryFileStream::SetPos(size_t Offset)
+{
+    if (Offset > GetSize())
+        return false;
+
+    m_CurrentOffset = Offset;
+    return true;
+}
+
+template <typename HandlerType>
+bool MemoryFileStream::ProcessChunks(HandlerType&& Handler) const
+{
+    if (!IsChunked())
+        return Handler(m_DataBlob->GetConstDataPtr(), m_DataBlob->GetSize());
+
+    for (size_t Offset = 0; Offset < m_ChunkedSize; Offset += m_ChunkSize)
+    {
+        if (!Handler(m_Chunks[Offset / m_ChunkSize].get(), std::min(m_ChunkSize, m_ChunkedSize - Offset)))
+            return false;
+    }
+    return true;
+}
+
+RefCntAutoPtr<IDataBlob> MemoryFileStream::GetDataBlob()
+{
+    if (IsChunked())
+    {
+        auto  pDataBlob = DataBlobImpl::Create(m_ChunkedSize);
+        auto* pDst      = pDataBlob->GetDataPtr<Uint8>();
+        ProcessChunks([&pDst](const void* pData, size_t Size) {
+            memcpy(pDst, pData, Size);
+            pDst += Size;
+            return true;
+        });
+
+        m_Chunks.clear();
+        m_ChunkedSize = 0;
+        m_ChunkSize   = 0;
+        m_DataBlob    = std::move(pDataBlob);
+    }
+
+    return m_DataBlob;
+}
+
+bool MemoryFileStream::WriteTo(IFileStream* pStream)
+{
+    DEV_CHECK_ERR(pStream != nullptr, "Stream must not be null");
+    if (pStream == nullptr)
+        return false;
+
+    return ProcessChunks([pStream](const void* pData, size_t Size) {
+        return Size == 0 || pStream->Write(pData, Size);
+    });
+}
+
+bool MemoryFileStream::WriteToFile(const Char* FilePath)
+{
+    DEV_CHECK_ERR(FilePath != nullptr, "File path must not be null");
+    if (FilePath == nullptr)
+        return false;
+
+    FileWrapper File{FilePath, EFileAccessMode::Overwrite};
+    if (!File)
+    {
+        LOG_ERROR_MESSAGE("Failed to open file ", FilePath);
+        return false;
+    }
+
+    return ProcessChunks([&File](const void* pData, size_t Size) {
+        return Size == 0 || File->Write(pData, Size);
+    });
 }
 
 } // namespace Diligent
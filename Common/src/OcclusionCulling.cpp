@@ -0,0 +1,543 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "OcclusionCulling.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "BasicMathSIMD.hpp"
+#include "PlatformMisc.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+constexpr Uint32 SoftwareOcclusionBuffer::TileWidth;
+constexpr Uint32 SoftwareOcclusionBuffer::TileHeight;
+
+namespace
+{
+
+using namespace MathSIMD;
+
+static_assert(SoftwareOcclusionBuffer::TileWidth == 8, "Rasterization loops process tile rows as two 4-pixel vectors");
+
+// Triangles that cross the side planes are clipped against a guard band that is this many
+// times larger than the viewport. This keeps screen-space coordinates small enough for the
+// edge functions to remain precise, while most triangles never need clipping.
+constexpr float GuardBandScale = 4.f;
+
+enum CLIP_PLANE : Uint32
+{
+    CLIP_PLANE_NEAR = 0,
+    CLIP_PLANE_LEFT,
+    CLIP_PLANE_RIGHT,
+    CLIP_PLANE_BOTTOM,
+    CLIP_PLANE_TOP,
+    CLIP_PLANE_COUNT
+};
+
+// Returns the distance to the clip plane, which is non-negative for points inside
+float GetClipPlaneDistance(const float4& Pos, Uint32 Plane, bool NegativeOneToOneZ)
+{
+    switch (Plane)
+    {
+        case CLIP_PLANE_NEAR: return NegativeOneToOneZ ? Pos.z + Pos.w : Pos.z;
+        case CLIP_PLANE_LEFT: return Pos.x + GuardBandScale * Pos.w;
+        case CLIP_PLANE_RIGHT: return GuardBandScale * Pos.w - Pos.x;
+        case CLIP_PLANE_BOTTOM: return Pos.y + GuardBandScale * Pos.w;
+        case CLIP_PLANE_TOP: return GuardBandScale * Pos.w - Pos.y;
+        default:
+            UNEXPECTED("Unexpected clip plane");
+            return 0;
+    }
+}
+
+Uint32 GetClipOutcode(const float4& Pos, bool NegativeOneToOneZ)
+{
+    Uint32 Outcode = 0;
+    for (Uint32 Plane = 0; Plane < CLIP_PLANE_COUNT; ++Plane)
+    {
+        if (GetClipPlaneDistance(Pos, Plane, NegativeOneToOneZ) < 0)
+            Outcode |= 1u << Plane;
+    }
+    return Outcode;
+}
+
+// Clips a convex polygon against the plane. Returns the number of output vertices.
+Uint32 ClipPolygon(const float4* pSrc, Uint32 NumSrcVerts, float4* pDst, Uint32 Plane, bool NegativeOneToOneZ)
+{
+    Uint32 NumDstVerts = 0;
+    for (Uint32 i = 0; i < NumSrcVerts; ++i)
+    {
+        const float4& V0 = pSrc[i];
+        const float4& V1 = pSrc[(i + 1) % NumSrcVerts];
+
+        const float D0 = GetClipPlaneDistance(V0, Plane, NegativeOneToOneZ);
+        const float D1 = GetClipPlaneDistance(V1, Plane, NegativeOneToOneZ);
+        if (D0 >= 0)
+            pDst[NumDstVerts++] = V0;
+        if ((D0 >= 0) != (D1 >= 0))
+            pDst[NumDstVerts++] = lerp(V0, V1, D0 / (D0 - D1));
+    }
+    return NumDstVerts;
+}
+
+float HorizontalMax(VecF4 v)
+{
+    float f[4];
+    StoreF4(f, v);
+    return std::max(std::max(f[0], f[1]), std::max(f[2], f[3]));
+}
+
+float HorizontalMin(VecF4 v)
+{
+    float f[4];
+    StoreF4(f, v);
+    return std::min(std::min(f[0], f[1]), std::min(f[2], f[3]));
+}
+
+} // namespace
+
+SoftwareOcclusionBuffer::SoftwareOcclusionBuffer(Uint32 Width, Uint32 Height, bool NegativeOneToOneZ) :
+    m_NegativeOneToOneZ{NegativeOneToOneZ}
+{
+    Resize(Width, Height);
+}
+
+void SoftwareOcclusionBuffer::Resize(Uint32 Width, Uint32 Height)
+{
+    DEV_CHECK_ERR(Width > 0 && Height > 0, "Buffer dimensions must not be zero");
+
+    m_Width  = Width;
+    m_Height = Height;
+    m_TilesX = (Width + TileWidth - 1) / TileWidth;
+    m_TilesY = (Height + TileHeight - 1) / TileHeight;
+
+    m_Depth.resize(size_t{m_TilesX} * m_TilesY * TileWidth * TileHeight);
+    m_TileMaxDepth.resize(size_t{m_TilesX} * m_TilesY);
+
+    Clear();
+}
+
+void SoftwareOcclusionBuffer::Clear()
+{
+    std::fill(m_Depth.begin(), m_Depth.end(), 1.f);
+    std::fill(m_TileMaxDepth.begin(), m_TileMaxDepth.end(), 1.f);
+
+    // Pixels in the partial tiles that are outside of the buffer are set to the near plane:
+    // they are never updated by the rasterizer or read by the box test, and do not affect
+    // the tile's farthest depth.
+    if (m_Width % TileWidth != 0)
+    {
+        for (Uint32 ty = 0; ty < m_TilesY; ++ty)
+        {
+            float* pTile = GetTileDepth(m_TilesX - 1, ty);
+            for (Uint32 y = 0; y < TileHeight; ++y)
+            {
+                for (Uint32 x = m_Width % TileWidth; x < TileWidth; ++x)
+                    pTile[y * TileWidth + x] = 0;
+            }
+        }
+    }
+    if (m_Height % TileHeight != 0)
+    {
+        for (Uint32 tx = 0; tx < m_TilesX; ++tx)
+        {
+            float* pTile = GetTileDepth(tx, m_TilesY - 1);
+            for (Uint32 y = m_Height % TileHeight; y < TileHeight; ++y)
+            {
+                for (Uint32 x = 0; x < TileWidth; ++x)
+                    pTile[y * TileWidth + x] = 0;
+            }
+        }
+    }
+}
+
+SoftwareOcclusionBuffer::ScreenVertex SoftwareOcclusionBuffer::ToScreen(const float4& ClipPos) const
+{
+    const float HalfWidth  = static_cast<float>(m_Width) * 0.5f;
+    const float HalfHeight = static_cast<float>(m_Height) * 0.5f;
+    const float InvW       = 1.f / ClipPos.w;
+
+    ScreenVertex V;
+    V.x = ClipPos.x * InvW * HalfWidth + HalfWidth;
+    V.y = HalfHeight - ClipPos.y * InvW * HalfHeight;
+    V.z = m_NegativeOneToOneZ ? ClipPos.z * InvW * 0.5f + 0.5f : ClipPos.z * InvW;
+    return V;
+}
+
+void SoftwareOcclusionBuffer::RasterizeOccluder(const OccluderMeshAttribs& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.pVertices != nullptr || Attribs.NumVertices == 0, "Vertices must not be null");
+    DEV_CHECK_ERR(Attribs.VertexStride >= sizeof(float3), "Vertex stride (", Attribs.VertexStride, ") must be at least ", sizeof(float3));
+    DEV_CHECK_ERR(Attribs.pIndices != nullptr || Attribs.NumTriangles * 3 <= Attribs.NumVertices,
+                  "Non-indexed occluder has ", Attribs.NumTriangles, " triangles, but only ", Attribs.NumVertices, " vertices");
+
+    m_ClipVerts.resize(Attribs.NumVertices);
+    const Uint8* pVertexData = static_cast<const Uint8*>(Attribs.pVertices);
+    for (Uint32 v = 0; v < Attribs.NumVertices; ++v)
+    {
+        const float* pPos   = reinterpret_cast<const float*>(pVertexData + size_t{v} * Attribs.VertexStride);
+        const float  Pos[4] = {pPos[0], pPos[1], pPos[2], 1.f};
+        MulVector4Matrix4x4(Pos, Attribs.WorldViewProj.Data(), &m_ClipVerts[v].x);
+    }
+
+    // In screen space, y points down, so clockwise triangles have positive area
+    const int FrontFaceSign = !Attribs.CullBackFaces ? 0 : (Attribs.FrontCounterClockwise ? -1 : +1);
+
+    for (Uint32 t = 0; t < Attribs.NumTriangles; ++t)
+    {
+        Uint32 Idx[3] = {t * 3 + 0, t * 3 + 1, t * 3 + 2};
+        if (Attribs.pIndices != nullptr)
+        {
+            for (Uint32 i = 0; i < 3; ++i)
+            {
+                Idx[i] = Attribs.pIndices[t * 3 + i];
+                DEV_CHECK_ERR(Idx[i] < Attribs.NumVertices, "Index ", Idx[i], " is out of range");
+            }
+        }
+
+        const float4 Tri[3] = {m_ClipVerts[Idx[0]], m_ClipVerts[Idx[1]], m_ClipVerts[Idx[2]]};
+        RasterizeClippedPolygon(Tri, 3, FrontFaceSign);
+    }
+}
+
+void SoftwareOcclusionBuffer::RasterizeClippedPolygon(const float4* pClipVerts, Uint32 NumVerts, int FrontFaceSign)
+{
+    VERIFY_EXPR(NumVerts == 3);
+
+    const Uint32 Outcodes[3] = {
+        GetClipOutcode(pClipVerts[0], m_NegativeOneToOneZ),
+        GetClipOutcode(pClipVerts[1], m_NegativeOneToOneZ),
+        GetClipOutcode(pClipVerts[2], m_NegativeOneToOneZ),
+    };
+    if ((Outcodes[0] & Outcodes[1] & Outcodes[2]) != 0)
+    {
+        // All vertices are outside of the same plane
+        return;
+    }
+
+    const Uint32 ClipMask = Outcodes[0] | Outcodes[1] | Outcodes[2];
+    if (ClipMask == 0)
+    {
+        RasterizeScreenTriangle(ToScreen(pClipVerts[0]), ToScreen(pClipVerts[1]), ToScreen(pClipVerts[2]), FrontFaceSign);
+        return;
+    }
+
+    // Every plane may add at most one vertex to a convex polygon
+    float4 Polygon[2][3 + CLIP_PLANE_COUNT];
+    std::copy(pClipVerts, pClipVerts + NumVerts, Polygon[0]);
+
+    Uint32 Src = 0;
+    for (Uint32 Plane = 0; Plane < CLIP_PLANE_COUNT && NumVerts >= 3; ++Plane)
+    {
+        if ((ClipMask & (1u << Plane)) == 0)
+            continue;
+
+        NumVerts = ClipPolygon(Polygon[Src], NumVerts, Polygon[1 - Src], Plane, m_NegativeOneToOneZ);
+        Src      = 1 - Src;
+    }
+    if (NumVerts < 3)
+        return;
+
+    const ScreenVertex V0 = ToScreen(Polygon[Src][0]);
+    ScreenVertex       V1 = ToScreen(Polygon[Src][1]);
+    for (Uint32 i = 2; i < NumVerts; ++i)
+    {
+        const ScreenVertex V2 = ToScreen(Polygon[Src][i]);
+        RasterizeScreenTriangle(V0, V1, V2, FrontFaceSign);
+        V1 = V2;
+    }
+}
+
+void SoftwareOcclusionBuffer::RasterizeScreenTriangle(ScreenVertex V0, ScreenVertex V1, ScreenVertex V2, int FrontFaceSign)
+{
+    float Area = (V1.x - V0.x) * (V2.y - V0.y) - (V2.x - V0.x) * (V1.y - V0.y);
+    if (Area == 0 || Area * static_cast<float>(FrontFaceSign) < 0)
+        return;
+
+    if (Area < 0)
+    {
+        std::swap(V1, V2);
+        Area = -Area;
+    }
+
+    // Pixels whose centers are inside the triangle bounding box
+    const float MinX = std::min(std::min(V0.x, V1.x), V2.x);
+    const float MaxX = std::max(std::max(V0.x, V1.x), V2.x);
+    const float MinY = std::min(std::min(V0.y, V1.y), V2.y);
+    const float MaxY = std::max(std::max(V0.y, V1.y), V2.y);
+
+    const int PixelX0 = static_cast<int>(std::max(std::ceil(MinX - 0.5f), 0.f));
+    const int PixelX1 = static_cast<int>(std::min(std::floor(MaxX - 0.5f), static_cast<float>(m_Width - 1)));
+    const int PixelY0 = static_cast<int>(std::max(std::ceil(MinY - 0.5f), 0.f));
+    const int PixelY1 = static_cast<int>(std::min(std::floor(MaxY - 0.5f), static_cast<float>(m_Height - 1)));
+    if (PixelX0 > PixelX1 || PixelY0 > PixelY1)
+        return;
+
+    const float MinZ = std::min(std::min(V0.z, V1.z), V2.z);
+
+    // Edge function E(x, y) = A * (x - Start.x) + B * (y - Start.y) is non-negative inside the triangle
+    struct Edge
+    {
+        float A;
+        float B;
+        float StartX;
+        float StartY;
+    };
+    const Edge Edges[3] = {
+        {V0.y - V1.y, V1.x - V0.x, V0.x, V0.y},
+        {V1.y - V2.y, V2.x - V1.x, V1.x, V1.y},
+        {V2.y - V0.y, V0.x - V2.x, V2.x, V2.y},
+    };
+
+    // Depth plane
+    const float DzDx = ((V1.z - V0.z) * (V2.y - V0.y) - (V2.z - V0.z) * (V1.y - V0.y)) / Area;
+    const float DzDy = ((V2.z - V0.z) * (V1.x - V0.x) - (V1.z - V0.z) * (V2.x - V0.x)) / Area;
+
+    const VecF4 PixelOffsets[2] = {SetF4(0, 1, 2, 3), SetF4(4, 5, 6, 7)};
+    const VecF4 DzDxOffsets[2]  = {MulF4(SetF4(DzDx), PixelOffsets[0]), MulF4(SetF4(DzDx), PixelOffsets[1])};
+
+    constexpr float MaxTileOffsetX = static_cast<float>(TileWidth - 1);
+    constexpr float MaxTileOffsetY = static_cast<float>(TileHeight - 1);
+
+    for (Uint32 TileY = PixelY0 / TileHeight; TileY <= PixelY1 / TileHeight; ++TileY)
+    {
+        for (Uint32 TileX = PixelX0 / TileWidth; TileX <= PixelX1 / TileWidth; ++TileX)
+        {
+            float& TileMaxDepth = m_TileMaxDepth[TileX + TileY * m_TilesX];
+            if (MinZ >= TileMaxDepth)
+            {
+                // The triangle is behind all pixels of the tile
+                continue;
+            }
+
+            // Center of the tile's first pixel
+            const float X = static_cast<float>(TileX * TileWidth) + 0.5f;
+            const float Y = static_cast<float>(TileY * TileHeight) + 0.5f;
+
+            float EdgeValues[3];
+            bool  IsOutside      = false;
+            bool  IsFullyCovered = true;
+            for (Uint32 e = 0; e < 3; ++e)
+            {
+                const Edge& E = Edges[e];
+                EdgeValues[e] = E.A * (X - E.StartX) + E.B * (Y - E.StartY);
+
+                // The edge function is linear, so its extremes are at the tile corners
+                const float MaxValue = EdgeValues[e] + std::max(E.A, 0.f) * MaxTileOffsetX + std::max(E.B, 0.f) * MaxTileOffsetY;
+                const float MinValue = EdgeValues[e] + std::min(E.A, 0.f) * MaxTileOffsetX + std::min(E.B, 0.f) * MaxTileOffsetY;
+                IsOutside            = IsOutside || MaxValue < 0;
+                IsFullyCovered       = IsFullyCovered && MinValue >= 0;
+            }
+            if (IsOutside)
+                continue;
+
+            const float Z = V0.z + DzDx * (X - V0.x) + DzDy * (Y - V0.y);
+
+            float* pDepth   = GetTileDepth(TileX, TileY);
+            VecF4  MaxDepth = SetF4(0);
+            for (Uint32 row = 0; row < TileHeight; ++row)
+            {
+                const float RowZ = Z + DzDy * static_cast<float>(row);
+                for (Uint32 half = 0; half < 2; ++half)
+                {
+                    MaskF4 Inside = TrueMaskF4();
+                    if (!IsFullyCovered)
+                    {
+                        for (Uint32 e = 0; e < 3; ++e)
+                        {
+                            const float RowValue = EdgeValues[e] + Edges[e].B * static_cast<float>(row);
+                            const VecF4 Values   = AddF4(SetF4(RowValue), MulF4(SetF4(Edges[e].A), PixelOffsets[half]));
+                            Inside               = AndMaskF4(Inside, CmpGeF4(Values, SetF4(0)));
+                        }
+                    }
+
+                    float*      pPixels = pDepth + row * TileWidth + half * 4;
+                    const VecF4 Depth   = LoadF4(pPixels);
+                    const VecF4 TriZ    = AddF4(SetF4(RowZ), DzDxOffsets[half]);
+                    const VecF4 NewZ    = SelectF4(Inside, MinF4(Depth, TriZ), Depth);
+                    StoreF4(pPixels, NewZ);
+                    MaxDepth = MaxF4(MaxDepth, NewZ);
+                }
+            }
+            TileMaxDepth = HorizontalMax(MaxDepth);
+        }
+    }
+}
+
+bool SoftwareOcclusionBuffer::IsScreenRectVisible(float MinX, float MinY, float MaxX, float MaxY, float MinZ) const
+{
+    // Pixels that overlap the rectangle
+    const int PixelX0 = static_cast<int>(std::max(std::floor(MinX), 0.f));
+    const int PixelX1 = static_cast<int>(std::min(std::ceil(MaxX) - 1.f, static_cast<float>(m_Width - 1)));
+    const int PixelY0 = static_cast<int>(std::max(std::floor(MinY), 0.f));
+    const int PixelY1 = static_cast<int>(std::min(std::ceil(MaxY) - 1.f, static_cast<float>(m_Height - 1)));
+    if (PixelX0 > PixelX1 || PixelY0 > PixelY1)
+        return false;
+
+    const VecF4 BoxZ = SetF4(MinZ);
+    for (Uint32 TileY = PixelY0 / TileHeight; TileY <= PixelY1 / TileHeight; ++TileY)
+    {
+        const int Y    = static_cast<int>(TileY * TileHeight);
+        const int Row0 = std::max(PixelY0 - Y, 0);
+        const int Row1 = std::min(PixelY1 - Y, static_cast<int>(TileHeight) - 1);
+        for (Uint32 TileX = PixelX0 / TileWidth; TileX <= PixelX1 / TileWidth; ++TileX)
+        {
+            if (m_TileMaxDepth[TileX + TileY * m_TilesX] < MinZ)
+            {
+                // All pixels of the tile are closer than the box
+                continue;
+            }
+
+            // Columns of the tile that are inside the rectangle
+            const float  X = static_cast<float>(TileX * TileWidth);
+            const MaskF4 Columns[2] =
+                {
+                    AndMaskF4(CmpGeF4(SetF4(X + 0, X + 1, X + 2, X + 3), SetF4(static_cast<float>(PixelX0))),
+                              CmpLeF4(SetF4(X + 0, X + 1, X + 2, X + 3), SetF4(static_cast<float>(PixelX1)))),
+                    AndMaskF4(CmpGeF4(SetF4(X + 4, X + 5, X + 6, X + 7), SetF4(static_cast<float>(PixelX0))),
+                              CmpLeF4(SetF4(X + 4, X + 5, X + 6, X + 7), SetF4(static_cast<float>(PixelX1)))),
+                };
+
+            const float* pDepth = GetTileDepth(TileX, TileY);
+            for (int row = Row0; row <= Row1; ++row)
+            {
+                for (Uint32 half = 0; half < 2; ++half)
+                {
+                    const VecF4  Depth   = LoadF4(pDepth + row * TileWidth + half * 4);
+                    const MaskF4 Visible = AndMaskF4(CmpGeF4(Depth, BoxZ), Columns[half]);
+                    if (MoveMaskF4(Visible) != 0)
+                        return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+bool SoftwareOcclusionBuffer::IsBoxVisible(const float4x4& ViewProj, const BoundBox& Box) const
+{
+    const float* M = ViewProj.Data();
+
+    // Clip-space position of a corner is the sum of the scaled matrix rows
+    const VecF4 Row0[2] = {MulF4(SetF4(Box.Min.x), LoadF4(M + 0)), MulF4(SetF4(Box.Max.x), LoadF4(M + 0))};
+    const VecF4 Row1[2] = {MulF4(SetF4(Box.Min.y), LoadF4(M + 4)), MulF4(SetF4(Box.Max.y), LoadF4(M + 4))};
+    const VecF4 Row2[2] = {AddF4(MulF4(SetF4(Box.Min.z), LoadF4(M + 8)), LoadF4(M + 12)),
+                           AddF4(MulF4(SetF4(Box.Max.z), LoadF4(M + 8)), LoadF4(M + 12))};
+
+    const float HalfWidth  = static_cast<float>(m_Width) * 0.5f;
+    const float HalfHeight = static_cast<float>(m_Height) * 0.5f;
+
+    VecF4  MinX                      = SetF4(+FLT_MAX);
+    VecF4  MinY                      = SetF4(+FLT_MAX);
+    VecF4  MaxX                      = SetF4(-FLT_MAX);
+    VecF4  MaxY                      = SetF4(-FLT_MAX);
+    VecF4  MinZ                      = SetF4(+FLT_MAX);
+    Uint32 NumCornersBehindNearPlane = 0;
+    for (Uint32 z = 0; z < 2; ++z)
+    {
+        // Clip-space positions of the corners (0, 0), (1, 0), (0, 1) and (1, 1).
+        // After the transpose, X, Y, Z and W contain the components of the four corners.
+        VecF4 X = AddF4(AddF4(Row0[0], Row1[0]), Row2[z]);
+        VecF4 Y = AddF4(AddF4(Row0[1], Row1[0]), Row2[z]);
+        VecF4 Z = AddF4(AddF4(Row0[0], Row1[1]), Row2[z]);
+        VecF4 W = AddF4(AddF4(Row0[1], Row1[1]), Row2[z]);
+        TransposeF4(X, Y, Z, W);
+
+        const VecF4 NearDist = m_NegativeOneToOneZ ? AddF4(Z, W) : Z;
+        NumCornersBehindNearPlane += PlatformMisc::CountOneBits(static_cast<Uint32>(MoveMaskF4(CmpLtF4(NearDist, SetF4(0)))));
+
+        const VecF4 InvW = DivF4(SetF4(1), W);
+        const VecF4 SX   = AddF4(MulF4(MulF4(X, InvW), SetF4(HalfWidth)), SetF4(HalfWidth));
+        const VecF4 SY   = SubF4(SetF4(HalfHeight), MulF4(MulF4(Y, InvW), SetF4(HalfHeight)));
+        const VecF4 SZ   = m_NegativeOneToOneZ ?
+            AddF4(MulF4(MulF4(Z, InvW), SetF4(0.5f)), SetF4(0.5f)) :
+            MulF4(Z, InvW);
+
+        MinX = MinF4(MinX, SX);
+        MinY = MinF4(MinY, SY);
+        MaxX = MaxF4(MaxX, SX);
+        MaxY = MaxF4(MaxY, SY);
+        MinZ = MinF4(MinZ, SZ);
+    }
+
+    if (NumCornersBehindNearPlane == 8)
+        return false;
+    if (NumCornersBehindNearPlane > 0)
+    {
+        // The box intersects the near plane
+        return true;
+    }
+
+    return IsScreenRectVisible(HorizontalMin(MinX), HorizontalMin(MinY), HorizontalMax(MaxX), HorizontalMax(MaxY), HorizontalMin(MinZ));
+}
+
+size_t SoftwareOcclusionBuffer::TestBoxes(const float4x4& ViewProj, const BoundBoxSOA& Boxes, size_t NumBoxes, Uint32* pVisibilityMask) const
+{
+    DEV_CHECK_ERR(pVisibilityMask != nullptr || NumBoxes == 0, "Visibility mask must not be null");
+
+    size_t NumVisible = 0;
+    for (size_t Word = 0; Word < (NumBoxes + 31) / 32; ++Word)
+    {
+        Uint32 Bits = pVisibilityMask[Word];
+        while (Bits != 0)
+        {
+            const Uint32 Bit = PlatformMisc::GetLSB(Bits);
+            Bits &= Bits - 1;
+
+            const size_t i = Word * 32 + Bit;
+            if (i >= NumBoxes)
+                break;
+
+            const BoundBox Box{
+                float3{Boxes.MinX[i], Boxes.MinY[i], Boxes.MinZ[i]},
+                float3{Boxes.MaxX[i], Boxes.MaxY[i], Boxes.MaxZ[i]},
+            };
+            if (IsBoxVisible(ViewProj, Box))
+                ++NumVisible;
+            else
+                pVisibilityMask[Word] &= ~(1u << Bit);
+        }
+    }
+    return NumVisible;
+}
+
+void SoftwareOcclusionBuffer::ReadDepth(float* pDepth) const
+{
+    for (Uint32 y = 0; y < m_Height; ++y)
+    {
+        for (Uint32 x = 0; x < m_Width; ++x)
+        {
+            pDepth[x + y * m_Width] = GetTileDepth(x / TileWidth, y / TileHeight)[(y % TileHeight) * TileWidth + x % TileWidth];
+        }
+    }
+}
+
+} // namespace Diligent
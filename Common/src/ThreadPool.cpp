@@ -25,6 +25,7 @@
  */
 
 #include "ThreadPool.hpp"
+#include "CPUProfiler.hpp"
 
 #include <mutex>
 #include <thread>
@@ -109,7 +110,10 @@ public:
         if (pTask)
         {
             pTask->SetStatus(ASYNC_TASK_STATUS_RUNNING);
-            pTask->Run(ThreadId);
+            {
+                DILIGENT_PROFILE_SCOPE_CAT("ThreadPool::RunTask", "ThreadPool");
+                pTask->Run(ThreadId);
+            }
             DEV_CHECK_ERR((pTask->GetStatus() == ASYNC_TASK_STATUS_COMPLETE ||
                            pTask->GetStatus() == ASYNC_TASK_STATUS_CANCELLED),
                           "Finished tasks must be in COMPLETE or CANCELLED state");
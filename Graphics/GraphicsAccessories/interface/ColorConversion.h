@@ -47,6 +47,34 @@ inline float GammaToLinear(float x)
 float LinearToGamma(Uint8 x);
 float GammaToLinear(Uint8 x);
 
+/// Converts an array of gamma-encoded 8-bit values to linear values using a lookup table.
+void GammaToLinear(const Uint8* pGamma, float* pLinear, size_t Count);
+
+/// Converts an array of linear values to gamma-encoded 8-bit values.
+
+/// The result is the same as rounding LinearToGamma(x) * 255 to the nearest integer,
+/// but is computed with lookup tables. Values are clamped to [0, 1], NaN is mapped to 0.
+void LinearToGamma(const float* pLinear, Uint8* pGamma, size_t Count);
+
+/// Converts an array of gamma-encoded values to linear values.
+
+/// Values in [0, 1] are converted with a polynomial approximation with the relative error
+/// less than 1e-5. Other values are converted with GammaToLinear(float).
+void GammaToLinear(const float* pGamma, float* pLinear, size_t Count);
+
+/// Converts an array of linear values to gamma-encoded values.
+
+/// Values in [0, 1] are converted with a polynomial approximation with the absolute error
+/// less than 1e-5. Other values are converted with LinearToGamma(float).
+void LinearToGamma(const float* pLinear, float* pGamma, size_t Count);
+
+/// Converts an array of sRGB-encoded RGBA8 texels to linear RGBA values. Alpha is not gamma-encoded.
+void SRGBA8ToLinear(const Uint8* pSRGBA, float* pLinearRGBA, size_t NumTexels);
+
+/// Converts an array of linear RGBA values to sRGB-encoded RGBA8 texels, see LinearToGamma(const float*, Uint8*, size_t).
+/// Alpha is not gamma-encoded.
+void LinearToSRGBA8(const float* pLinearRGBA, Uint8* pSRGBA, size_t NumTexels);
+
 inline float FastLinearToGamma(float x)
 {
     return x < 0.0031308f ? 12.92f * x : 1.13005f * sqrtf(std::abs(x - 0.00228f)) - 0.13448f * x + 0.005719f;
@@ -0,0 +1,247 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of Diligent::ConcurrentRingBuffer class
+
+#include <atomic>
+#include <deque>
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Common/interface/Align.hpp"
+#include "../../../Common/interface/STDAllocator.hpp"
+
+namespace Diligent
+{
+/// Ring buffer that allows multiple threads to allocate space concurrently without locks.
+
+/// The buffer follows the same frame-based reclamation scheme as RingBuffer: allocations
+/// made before FinishCurrentFrame() are released by ReleaseCompletedFrames() once the GPU
+/// has reached the frame's fence value.
+///
+/// Allocate() may be called from any number of threads simultaneously. Space is reserved
+/// by advancing an atomic head with compare-exchange. FinishCurrentFrame() and ReleaseCompletedFrames()
+/// must not be called simultaneously with each other; they may, however, run in parallel with Allocate().
+/// ReleaseCompletedFrames() only frees space, so concurrent allocations may at worst fail to see
+/// the space that is being released. Allocations that are in flight while FinishCurrentFrame()
+/// is executed may be attributed to either frame, so all allocations that are referenced by
+/// the commands of the frame must complete before the frame is finished.
+///
+/// Internally, head and tail are stored as a pair of the lap (the number of times the position
+/// has wrapped around the end of the buffer) and the physical offset packed into a single 64-bit value.
+/// This way, the used size can be computed as the distance between the head and the tail
+/// without a division in the allocation path.
+class ConcurrentRingBuffer
+{
+public:
+    using OffsetType = size_t;
+    struct FrameHeadAttribs
+    {
+        // clang-format off
+        FrameHeadAttribs(Uint64 fv, Uint64 hd) noexcept :
+            FenceValue{fv},
+            Head      {hd}
+        {}
+        // clang-format on
+
+        // Fence value associated with the command list in which
+        // the allocation could have been referenced last time
+        Uint64 FenceValue;
+
+        // Packed head position at the end of the frame
+        Uint64 Head;
+    };
+    static constexpr const OffsetType InvalidOffset = static_cast<OffsetType>(-1);
+
+    ConcurrentRingBuffer(OffsetType MaxSize, IMemoryAllocator& Allocator) noexcept :
+        m_CompletedFrameHeads(STD_ALLOCATOR_RAW_MEM(FrameHeadAttribs, Allocator, "Allocator for deque<FrameHeadAttribs>")),
+        m_MaxSize{MaxSize}
+    {
+        DEV_CHECK_ERR(Uint64{MaxSize} <= PhysOffsetMask, "Ring buffer size (", MaxSize, ") is too large");
+    }
+
+    // clang-format off
+    ConcurrentRingBuffer             (const ConcurrentRingBuffer&)  = delete;
+    ConcurrentRingBuffer             (      ConcurrentRingBuffer&&) = delete;
+    ConcurrentRingBuffer& operator = (const ConcurrentRingBuffer&)  = delete;
+    ConcurrentRingBuffer& operator = (      ConcurrentRingBuffer&&) = delete;
+    // clang-format on
+
+    ~ConcurrentRingBuffer()
+    {
+        VERIFY(GetUsedSize() == 0, "All space in the ring buffer must be released");
+    }
+
+    /// Allocates Size bytes with the given alignment. The method is thread-safe.
+
+    /// \return Offset of the allocation in the buffer, or InvalidOffset if there is not enough space.
+    OffsetType Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        Size = AlignUp(Size, Alignment);
+
+        if (Size > m_MaxSize)
+            return InvalidOffset;
+
+        Uint64 Head = m_Head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const auto PhysHead    = static_cast<OffsetType>(Head & PhysOffsetMask);
+            const auto AlignedHead = AlignUp(PhysHead, Alignment);
+
+            OffsetType Offset  = 0;
+            Uint64     NewHead = 0;
+            if (AlignedHead + Size <= m_MaxSize)
+            {
+                //                                         AlignedHead
+                //                     Tail          Head  |            MaxSize
+                //                     |                |  |            |
+                //  [                  xxxxxxxxxxxxxxxxx...             ]
+                //
+                Offset  = AlignedHead;
+                NewHead = Head + (AlignedHead - PhysHead + Size);
+            }
+            else
+            {
+                // Skip the remaining space at the end and allocate from the beginning of the buffer
+                //
+                // Offset              Tail          Head               MaxSize
+                //  |                  |                |<---Skipped--->|
+                //  [                  xxxxxxxxxxxxxxxxx++++++++++++++++]
+                //
+                Offset  = 0;
+                NewHead = PackPosition((Head >> PhysOffsetBits) + 1, Size);
+            }
+
+            // The tail only moves forward, so a stale value may only result in a spurious failure
+            // when the buffer is almost full.
+            const auto Tail = m_Tail.load(std::memory_order_acquire);
+            if (GetDistance(Tail, Head) < 0)
+            {
+                // The head was advanced and released by other threads since it was loaded
+                Head = m_Head.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (GetDistance(Tail, NewHead) > static_cast<Int64>(m_MaxSize))
+                return InvalidOffset;
+
+            if (m_Head.compare_exchange_weak(Head, NewHead, std::memory_order_relaxed))
+                return Offset;
+        }
+    }
+
+    /// Finishes the current frame. The method must not be called simultaneously with ReleaseCompletedFrames().
+
+    /// FenceValue is the fence value associated with the command list in which the head
+    /// could have been referenced last time.
+    /// See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+    void FinishCurrentFrame(Uint64 FenceValue)
+    {
+#ifdef DILIGENT_DEBUG
+        if (!m_CompletedFrameHeads.empty())
+            VERIFY(FenceValue >= m_CompletedFrameHeads.back().FenceValue, "Current frame fence value (", FenceValue, ") is lower than the fence value of the previous frame (", m_CompletedFrameHeads.back().FenceValue, ")");
+#endif
+        const auto Head = m_Head.load(std::memory_order_relaxed);
+        // Ignore zero-size frames
+        if (Head != m_LastFrameHead)
+        {
+            m_CompletedFrameHeads.emplace_back(FenceValue, Head);
+            m_LastFrameHead = Head;
+        }
+    }
+
+    /// Releases the space of all frames whose fence value is less than or equal to CompletedFenceValue.
+    /// The method must not be called simultaneously with FinishCurrentFrame().
+
+    /// CompletedFenceValue indicates GPU progress.
+    /// See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+    void ReleaseCompletedFrames(Uint64 CompletedFenceValue)
+    {
+        // We can release all heads whose associated fence value is less than or equal to CompletedFenceValue
+        Uint64 NewTail = m_Tail.load(std::memory_order_relaxed);
+        while (!m_CompletedFrameHeads.empty() && m_CompletedFrameHeads.front().FenceValue <= CompletedFenceValue)
+        {
+            VERIFY_EXPR(GetDistance(NewTail, m_CompletedFrameHeads.front().Head) >= 0);
+            NewTail = m_CompletedFrameHeads.front().Head;
+            m_CompletedFrameHeads.pop_front();
+        }
+        m_Tail.store(NewTail, std::memory_order_release);
+    }
+
+    // clang-format off
+    OffsetType GetMaxSize() const { return m_MaxSize; }
+    bool       IsFull()     const { return GetUsedSize() == m_MaxSize; };
+    bool       IsEmpty()    const { return GetUsedSize() == 0; };
+    // clang-format on
+
+    /// Returns the size of the space that is currently in use, including the space skipped
+    /// due to alignment and wrapping. The value may be out of date if other threads are allocating.
+    OffsetType GetUsedSize() const
+    {
+        // The tail never passes the head, so it must be loaded first
+        const auto Tail = m_Tail.load(std::memory_order_acquire);
+        const auto Head = m_Head.load(std::memory_order_acquire);
+        const auto Dist = GetDistance(Tail, Head);
+        VERIFY_EXPR(Dist >= 0 && Dist <= static_cast<Int64>(m_MaxSize));
+        return static_cast<OffsetType>(Dist);
+    }
+
+private:
+    // The lower bits of a position store the physical offset, the upper bits store the lap.
+    // The lap is allowed to overflow: the distance between the head and the tail never exceeds
+    // one buffer size, so the laps are compared modulo the lap range.
+    static constexpr Uint32 PhysOffsetBits = 40;
+    static constexpr Uint64 PhysOffsetMask = (Uint64{1} << PhysOffsetBits) - 1;
+    static constexpr Uint64 LapMask        = (Uint64{1} << (64 - PhysOffsetBits)) - 1;
+
+    static Uint64 PackPosition(Uint64 Lap, Uint64 PhysOffset)
+    {
+        return (Lap << PhysOffsetBits) | PhysOffset;
+    }
+
+    // Returns the signed distance from position From to position To
+    Int64 GetDistance(Uint64 From, Uint64 To) const
+    {
+        auto LapDiff = static_cast<Int64>(((To >> PhysOffsetBits) - (From >> PhysOffsetBits)) & LapMask);
+        if (LapDiff > static_cast<Int64>(LapMask / 2))
+            LapDiff -= static_cast<Int64>(LapMask + 1);
+        return LapDiff * static_cast<Int64>(m_MaxSize) + static_cast<Int64>(To & PhysOffsetMask) - static_cast<Int64>(From & PhysOffsetMask);
+    }
+
+    std::deque<FrameHeadAttribs, STDAllocatorRawMem<FrameHeadAttribs>> m_CompletedFrameHeads;
+
+    const OffsetType m_MaxSize;
+
+    std::atomic<Uint64> m_Head{0};
+    std::atomic<Uint64> m_Tail{0};
+
+    // Head position at the end of the last finished frame. Only accessed by FinishCurrentFrame().
+    Uint64 m_LastFrameHead = 0;
+};
+} // namespace Diligent
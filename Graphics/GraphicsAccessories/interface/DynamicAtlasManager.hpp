@@ -98,7 +98,24 @@ public:
         };
     };
 
-    DynamicAtlasManager(Uint32 Width, Uint32 Height);
+    /// Strategy that defines how a free region is selected for a new allocation and how the remaining space is split.
+    enum class PackingStrategy : Uint8
+    {
+        /// Selects the smallest-area region among the free regions with the best-fitting width and height.
+        BestAreaFit = 0,
+
+        /// Guillotine best short side fit: selects the free region that minimizes the shorter leftover side,
+        /// and splits the remaining space along the shorter leftover axis.
+        BestShortSideFit,
+
+        /// Skyline bottom-left rule: selects the position with the lowest top edge, then the leftmost one.
+        /// The remaining space is split horizontally, which keeps rows of equal-height regions.
+        BottomLeft,
+
+        Count
+    };
+
+    DynamicAtlasManager(Uint32 Width, Uint32 Height, PackingStrategy Strategy = PackingStrategy::BestAreaFit);
     ~DynamicAtlasManager();
 
     // clang-format off
@@ -109,7 +126,22 @@ public:
     // clang-format on
 
     Region Allocate(Uint32 Width, Uint32 Height);
-    void   Free(Region&& R);
+
+    /// Allocates multiple regions at once.
+
+    /// \param [in, out] pRegions   - Array of NumRegions regions. On input, width and height of every
+    ///                               region define the requested size. On output, the array contains
+    ///                               the allocated regions in the same order. Regions that could not be
+    ///                               allocated are empty.
+    /// \param [in]      NumRegions - The number of regions.
+    /// \return          The number of regions that were successfully allocated.
+    ///
+    /// \remarks    The requests are processed in the order of decreasing longer side, which
+    ///             typically packs considerably better than allocating regions one by one in
+    ///             arbitrary order.
+    Uint32 Allocate(Region* pRegions, Uint32 NumRegions);
+
+    void Free(Region&& R);
 
     Uint32 GetFreeRegionCount() const
     {
@@ -117,6 +149,8 @@ public:
         return static_cast<Uint32>(m_FreeRegionsByWidth.size());
     }
 
+    PackingStrategy GetPackingStrategy() const { return m_Strategy; }
+
     Uint32 GetWidth() const { return m_Width; }
     Uint32 GetHeight() const { return m_Height; }
     Uint64 GetTotalFreeArea() const { return m_TotalFreeArea; }
@@ -169,6 +203,8 @@ private:
     const Uint32 m_Width;
     const Uint32 m_Height;
 
+    const PackingStrategy m_Strategy;
+
     Uint64 m_TotalFreeArea = 0;
 
     struct Node
@@ -223,6 +259,10 @@ private:
     void RegisterNode(Node& N);
     void UnregisterNode(const Node& N);
 
+    Node* FindBestAreaFit(Uint32 Width, Uint32 Height) const;
+    Node* FindBestShortSideFit(Uint32 Width, Uint32 Height) const;
+    Node* FindBottomLeft(Uint32 Width, Uint32 Height) const;
+
     // Free regions ordered by width->height->x->y
     std::map<Region, Node*, WidthFirstCompare> m_FreeRegionsByWidth;
     // Free regions ordered by height->width->y->x
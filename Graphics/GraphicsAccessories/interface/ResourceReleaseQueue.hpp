@@ -36,6 +36,10 @@
 #include <mutex>
 #include <deque>
 #include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <condition_variable>
 
 #include "../../../Primitives/interface/MemoryAllocator.h"
 #include "../../../Common/interface/STDAllocator.hpp"
@@ -211,6 +215,29 @@ private:
     ResourceType m_StaleResource;
 };
 
+/// Resource release queue statistics, see ResourceReleaseQueue::GetStats().
+struct ResourceReleaseQueueStats
+{
+    /// The number of resources waiting for the command list to be submitted.
+    size_t StaleResourceCount = 0;
+
+    /// The number of resources waiting for the GPU to reach their fence value.
+    size_t PendingReleaseResourceCount = 0;
+
+    /// The number of resources whose fence value has been reached, but that have not been
+    /// destroyed yet by the background release worker.
+    size_t BackgroundReleaseResourceCount = 0;
+
+    /// The total number of destroyed resources.
+    Uint64 ReleasedResourceCount = 0;
+
+    /// Average time, in seconds, between a resource being added to the release queue and its destruction.
+    double AvgReleaseLatency = 0;
+
+    /// Maximum time, in seconds, between a resource being added to the release queue and its destruction.
+    double MaxReleaseLatency = 0;
+};
+
 /// Facilitates safe resource destruction in D3D12 and Vulkan
 
 /// Resource destruction is a two-stage process:
@@ -220,6 +247,12 @@ private:
 ///   the command list
 /// * Resources are removed and actually destroyed from the queue when fence is signaled and the queue is Purged
 ///
+/// Destroying a large number of resources at once (e.g. after a level is unloaded) may take a long time.
+/// To avoid frame spikes, the number of resources destroyed by a single Purge() call can be limited
+/// with SetMaxResourcesPerPurge(). Alternatively, destruction can be offloaded to a background thread
+/// with EnableBackgroundRelease(). In both cases, resources are only destroyed after their fence value
+/// has been reached, and in the same order in which they were added to the release queue.
+///
 /// \tparam ResourceWrapperType -  Type of the resource wrapper used by the release queue.
 template <typename ResourceWrapperType>
 class ResourceReleaseQueue
@@ -227,17 +260,71 @@ class ResourceReleaseQueue
 public:
     // clang-format off
     ResourceReleaseQueue(IMemoryAllocator& Allocator) :
-        m_ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
-        m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
+        m_ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(PendingResource,      Allocator, "Allocator for deque<PendingResource>")),
+        m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
+        m_WorkerQueue   (STD_ALLOCATOR_RAW_MEM(PendingResource,      Allocator, "Allocator for deque<PendingResource>"))
     {}
     // clang-format on
 
     ~ResourceReleaseQueue()
     {
+        StopBackgroundWorker();
         DEV_CHECK_ERR(m_StaleResources.empty(), "Not all stale objects were destroyed");
         DEV_CHECK_ERR(m_ReleaseQueue.empty(), "Release queue is not empty");
     }
 
+    // clang-format off
+    ResourceReleaseQueue             (const ResourceReleaseQueue&)  = delete;
+    ResourceReleaseQueue             (      ResourceReleaseQueue&&) = delete;
+    ResourceReleaseQueue& operator = (const ResourceReleaseQueue&)  = delete;
+    ResourceReleaseQueue& operator = (      ResourceReleaseQueue&&) = delete;
+    // clang-format on
+
+    /// Sets the maximum number of resources that a single Purge() call destroys on the calling thread.
+    /// \param [in] MaxResources - Maximum number of resources to destroy, or 0 to destroy all completed resources.
+    ///
+    /// \remarks  Completed resources that exceed the budget remain in the queue and are destroyed
+    ///           by subsequent Purge() calls. The budget does not apply to Flush() and to the
+    ///           background release worker.
+    void SetMaxResourcesPerPurge(Uint32 MaxResources)
+    {
+        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
+        m_MaxResourcesPerPurge = MaxResources;
+    }
+
+    /// Enables or disables the background release worker.
+    /// \param [in] Enable - Whether to enable the worker.
+    ///
+    /// \remarks  When the worker is enabled, Purge() hands all completed resources to
+    ///           the worker thread that destroys them. Disabling the worker waits until
+    ///           it has destroyed all resources handed to it.
+    ///           Resource wrappers must be safe to destroy on another thread.
+    void EnableBackgroundRelease(bool Enable)
+    {
+        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
+        if (Enable == m_WorkerThread.joinable())
+            return;
+
+        if (Enable)
+        {
+            m_StopWorker   = false;
+            m_WorkerThread = std::thread{[this]() {
+                WorkerThreadFunc();
+            }};
+        }
+        else
+        {
+            StopBackgroundWorker();
+        }
+    }
+
+    /// Returns true if the background release worker is enabled.
+    bool IsBackgroundReleaseEnabled()
+    {
+        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
+        return m_WorkerThread.joinable();
+    }
+
     /// Creates a resource wrapper for the specific resource type
     /// \param [in] Resource      - Resource to be released
     /// \param [in] NumReferences - Number of references to the resource
@@ -289,7 +376,7 @@ public:
     void DiscardResource(ResourceWrapperType&& Wrapper, Uint64 FenceValue)
     {
         std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, std::move(Wrapper));
+        m_ReleaseQueue.emplace_back(FenceValue, std::move(Wrapper), ClockType::now());
     }
 
     /// Adds a copy of the resource wrapper directly to the release queue
@@ -298,7 +385,7 @@ public:
     void DiscardResource(const ResourceWrapperType& Wrapper, Uint64 FenceValue)
     {
         std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, Wrapper);
+        m_ReleaseQueue.emplace_back(FenceValue, Wrapper, ClockType::now());
     }
 
     /// Adds multiple resources directly to the release queue
@@ -309,9 +396,10 @@ public:
     {
         std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
         ResourceType                Resource;
+        const auto                  DiscardTime = ClockType::now();
         while (Iterator(Resource))
         {
-            m_ReleaseQueue.emplace_back(FenceValue, CreateWrapper(std::move(Resource), 1));
+            m_ReleaseQueue.emplace_back(FenceValue, CreateWrapper(std::move(Resource), 1), DiscardTime);
         }
     }
 
@@ -328,12 +416,13 @@ public:
         // was executed
         std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
         std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
+        const auto                  DiscardTime = ClockType::now();
         while (!m_StaleResources.empty())
         {
             auto& FirstStaleObj = m_StaleResources.front();
             if (FirstStaleObj.first <= SubmittedCmdBuffNumber)
             {
-                m_ReleaseQueue.emplace_back(FenceValue, std::move(FirstStaleObj.second));
+                m_ReleaseQueue.emplace_back(FenceValue, std::move(FirstStaleObj.second), DiscardTime);
                 m_StaleResources.pop_front();
             }
             else
@@ -345,19 +434,31 @@ public:
     /// Removes all objects from the release queue whose fence value is
     /// less than or equal to CompletedFenceValue
     /// \param [in] CompletedFenceValue  -  Value of the fence that has been completed by the GPU
+    ///
+    /// \remarks  If the background release worker is enabled, the objects are handed to the worker.
+    ///           Otherwise, at most the number of objects set by SetMaxResourcesPerPurge() are destroyed.
     void Purge(Uint64 CompletedFenceValue)
     {
         std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
+        ReleaseCompletedResources(CompletedFenceValue, m_MaxResourcesPerPurge);
+    }
 
-        // Release all objects whose associated fence value is at most CompletedFenceValue
-        // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
-        while (!m_ReleaseQueue.empty())
+    /// Removes all objects from the release queue whose fence value is less than or equal to
+    /// CompletedFenceValue ignoring the purge budget, and waits until the background release worker,
+    /// if enabled, has destroyed all objects.
+    /// \param [in] CompletedFenceValue  -  Value of the fence that has been completed by the GPU
+    ///
+    /// \remarks  The method waits for the background release worker while holding the release queue mutex.
+    ///           Resource wrappers must therefore never call DiscardResource() on the same queue from their
+    ///           destructor as this will deadlock.
+    void Flush(Uint64 CompletedFenceValue)
+    {
+        std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
+        ReleaseCompletedResources(CompletedFenceValue, 0);
+        if (m_WorkerThread.joinable())
         {
-            auto& FirstObj = m_ReleaseQueue.front();
-            if (FirstObj.first <= CompletedFenceValue)
-                m_ReleaseQueue.pop_front();
-            else
-                break;
+            std::unique_lock<std::mutex> WorkerLock{m_WorkerMutex};
+            m_WorkerCondVar.wait(WorkerLock, [this]() { return m_WorkerQueue.empty() && m_NumResourcesInWorkerBatch == 0; });
         }
     }
 
@@ -373,13 +474,199 @@ public:
         return m_ReleaseQueue.size();
     }
 
+    /// Returns the queue statistics
+    ResourceReleaseQueueStats GetStats()
+    {
+        ResourceReleaseQueueStats Stats;
+        {
+            std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
+            Stats.StaleResourceCount = m_StaleResources.size();
+        }
+        {
+            std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
+            Stats.PendingReleaseResourceCount = m_ReleaseQueue.size();
+        }
+        {
+            std::lock_guard<std::mutex> WorkerLock{m_WorkerMutex};
+            Stats.BackgroundReleaseResourceCount = m_WorkerQueue.size() + m_NumResourcesInWorkerBatch;
+        }
+        {
+            std::lock_guard<std::mutex> StatsLock{m_StatsMutex};
+            Stats.ReleasedResourceCount = m_ReleasedResourceCount;
+            Stats.AvgReleaseLatency     = m_ReleasedResourceCount > 0 ? m_TotalReleaseLatency / static_cast<double>(m_ReleasedResourceCount) : 0;
+            Stats.MaxReleaseLatency     = m_MaxReleaseLatency;
+        }
+        return Stats;
+    }
+
 private:
-    std::mutex m_ReleaseQueueMutex;
-    using ReleaseQueueElemType = std::pair<Uint64, ResourceWrapperType>;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_ReleaseQueue;
+    using ClockType = std::chrono::steady_clock;
+
+    struct PendingResource
+    {
+        template <typename WrapperArgType>
+        PendingResource(Uint64 _FenceValue, WrapperArgType&& _Wrapper, ClockType::time_point _DiscardTime) :
+            FenceValue{_FenceValue},
+            DiscardTime{_DiscardTime},
+            Wrapper{std::forward<WrapperArgType>(_Wrapper)}
+        {}
+
+        PendingResource(PendingResource&&) = default;
+
+        Uint64                FenceValue;
+        ClockType::time_point DiscardTime;
+        ResourceWrapperType   Wrapper;
+    };
+    using PendingResourceQueueType = std::deque<PendingResource, STDAllocatorRawMem<PendingResource>>;
+
+    // Accumulates release latencies of a batch of resources so that the statistics
+    // mutex is locked once per batch.
+    struct ReleaseStatsAccumulator
+    {
+        Uint64 Count        = 0;
+        double TotalLatency = 0;
+        double MaxLatency   = 0;
 
+        void operator()(const ClockType::time_point& DiscardTime)
+        {
+            const auto Latency = std::chrono::duration<double>(ClockType::now() - DiscardTime).count();
+            ++Count;
+            TotalLatency += Latency;
+            MaxLatency = std::max(MaxLatency, Latency);
+        }
+    };
+
+    void CommitReleaseStats(const ReleaseStatsAccumulator& Acc)
+    {
+        if (Acc.Count == 0)
+            return;
+
+        std::lock_guard<std::mutex> StatsLock{m_StatsMutex};
+        m_ReleasedResourceCount += Acc.Count;
+        m_TotalReleaseLatency += Acc.TotalLatency;
+        m_MaxReleaseLatency = std::max(m_MaxReleaseLatency, Acc.MaxLatency);
+    }
+
+    // m_ReleaseQueueMutex must be locked
+    void ReleaseCompletedResources(Uint64 CompletedFenceValue, Uint32 MaxResources)
+    {
+        // Release all objects whose associated fence value is at most CompletedFenceValue
+        // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+        if (m_WorkerThread.joinable())
+        {
+            // Completed resources are handed to the worker in the release queue order, so that the
+            // worker destroys them in the same order as they would have been destroyed by this thread.
+            // The resources are collected without holding the worker mutex to not block the worker.
+            PendingResourceQueueType Completed{m_ReleaseQueue.get_allocator()};
+            while (!m_ReleaseQueue.empty() && m_ReleaseQueue.front().FenceValue <= CompletedFenceValue)
+            {
+                Completed.emplace_back(std::move(m_ReleaseQueue.front()));
+                m_ReleaseQueue.pop_front();
+            }
+            if (Completed.empty())
+                return;
+
+            {
+                std::lock_guard<std::mutex> WorkerLock{m_WorkerMutex};
+                if (m_WorkerQueue.empty())
+                {
+                    m_WorkerQueue.swap(Completed);
+                }
+                else
+                {
+                    for (auto& Res : Completed)
+                        m_WorkerQueue.emplace_back(std::move(Res));
+                }
+            }
+            m_WorkerCondVar.notify_all();
+            return;
+        }
+
+        ReleaseStatsAccumulator Acc;
+        while (!m_ReleaseQueue.empty() && (MaxResources == 0 || Acc.Count < MaxResources))
+        {
+            auto& FirstObj = m_ReleaseQueue.front();
+            if (FirstObj.FenceValue > CompletedFenceValue)
+                break;
+
+            const auto DiscardTime = FirstObj.DiscardTime;
+            m_ReleaseQueue.pop_front();
+            Acc(DiscardTime);
+        }
+        CommitReleaseStats(Acc);
+    }
+
+    void WorkerThreadFunc()
+    {
+        PendingResourceQueueType Batch{m_WorkerQueue.get_allocator()};
+
+        std::unique_lock<std::mutex> WorkerLock{m_WorkerMutex};
+        for (;;)
+        {
+            m_WorkerCondVar.wait(WorkerLock, [this]() { return !m_WorkerQueue.empty() || m_StopWorker; });
+            if (m_WorkerQueue.empty())
+            {
+                // The worker is only stopped once all resources have been destroyed
+                VERIFY_EXPR(m_StopWorker);
+                break;
+            }
+
+            Batch.swap(m_WorkerQueue);
+            m_NumResourcesInWorkerBatch = Batch.size();
+            WorkerLock.unlock();
+
+            ReleaseStatsAccumulator Acc;
+            while (!Batch.empty())
+            {
+                const auto DiscardTime = Batch.front().DiscardTime;
+                Batch.pop_front();
+                Acc(DiscardTime);
+            }
+            CommitReleaseStats(Acc);
+
+            WorkerLock.lock();
+            m_NumResourcesInWorkerBatch = 0;
+            // Wake up threads waiting in Flush()
+            m_WorkerCondVar.notify_all();
+        }
+    }
+
+    // m_ReleaseQueueMutex must be locked or the queue must be being destroyed
+    void StopBackgroundWorker()
+    {
+        if (!m_WorkerThread.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> WorkerLock{m_WorkerMutex};
+            m_StopWorker = true;
+        }
+        m_WorkerCondVar.notify_all();
+        m_WorkerThread.join();
+        VERIFY_EXPR(m_WorkerQueue.empty());
+    }
+
+private:
+    std::mutex               m_ReleaseQueueMutex;
+    PendingResourceQueueType m_ReleaseQueue;
+    Uint32                   m_MaxResourcesPerPurge = 0;
+
+    using ReleaseQueueElemType = std::pair<Uint64, ResourceWrapperType>;
     std::mutex                                                                 m_StaleObjectsMutex;
     std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_StaleResources;
+
+    // Background release worker
+    std::thread              m_WorkerThread;
+    std::mutex               m_WorkerMutex;
+    std::condition_variable  m_WorkerCondVar;
+    PendingResourceQueueType m_WorkerQueue;
+    size_t                   m_NumResourcesInWorkerBatch = 0;
+    bool                     m_StopWorker                = false;
+
+    std::mutex m_StatsMutex;
+    Uint64     m_ReleasedResourceCount = 0;
+    double     m_TotalReleaseLatency   = 0;
+    double     m_MaxReleaseLatency     = 0;
 };
 
 } // namespace Diligent
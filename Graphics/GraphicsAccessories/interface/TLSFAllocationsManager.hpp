@@ -0,0 +1,793 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+// Two-level segregated fit (TLSF) free block manager that is a drop-in alternative to VariableSizeAllocationsManager.
+// See M. Masmano, I. Ripoll, A. Crespo, J. Real, "TLSF: a New Dynamic Memory Allocator for Real-Time Systems", 2004.
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Platforms/interface/PlatformMisc.hpp"
+#include "../../../Common/interface/Align.hpp"
+#include "../../../Common/interface/STDAllocator.hpp"
+#include "VariableSizeAllocationsManager.hpp"
+
+namespace Diligent
+{
+
+// The class handles free memory block management to accommodate variable-size allocation requests
+// and exposes the same interface as VariableSizeAllocationsManager, but both Allocate() and Free()
+// run in constant time and do not allocate memory in the steady state.
+//
+// Free blocks are segregated into size classes. The first level splits the size range into power-of-two
+// intervals, and the second level linearly subdivides every interval into SLCount classes. Each class keeps
+// a doubly-linked list of free blocks, and two bitmaps track which classes are not empty, so that
+// a suitable class is found with two bit scans:
+//
+//       FL bitmap         SL bitmaps                 Free lists
+//
+//    FL=5 [64, 128)  1   0 0 1 0 ... 0   ----->  [72, 76) -> {Offset=512, Size=74} -> {Offset=8, Size=73}
+//    FL=4 [32, 64)   0   0 0 0 0 ... 0
+//    FL=3 [16, 32)   1   0 1 0 0 ... 1   --.-->  [18, 20) -> {Offset=128, Size=19}
+//     ...                                   '->  [30, 32) -> {Offset=256, Size=31}
+//
+// Unlike a general-purpose TLSF allocator, the managed memory is not accessible (it is typically GPU memory),
+// so block headers cannot be stored in-band. Instead, block descriptors are kept in a pool, and two open-addressing
+// hash tables map the start and the end offsets of every free block to its descriptor. This allows Free() to
+// locate and merge adjacent free blocks in constant time given only the offset and the size of the allocation.
+//
+// Allocate() first looks for a class whose every block is large enough (good fit). If there is none, it falls back to
+// scanning the list of the class the requested size belongs to, so that the manager can be filled completely.
+class TLSFAllocationsManager
+{
+public:
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+    using CreateInfo = VariableSizeAllocationsManager::CreateInfo;
+    using Allocation = VariableSizeAllocationsManager::Allocation;
+
+    using DefragmentationMove    = VariableSizeAllocationsManager::DefragmentationMove;
+    using DefragmentationAttribs = VariableSizeAllocationsManager::DefragmentationAttribs;
+
+    // The number of second-level classes per first-level interval is 2^SLCountLog2
+    static constexpr Uint32 SLCountLog2 = 4;
+    static constexpr Uint32 SLCount     = 1u << SLCountLog2;
+    // Sizes below SmallBlockSize are linearly mapped to the classes of the first interval
+    static constexpr OffsetType SmallBlockSize = OffsetType{1} << SLCountLog2;
+    static constexpr Uint32     FLCount        = sizeof(OffsetType) * 8 - SLCountLog2 + 1;
+
+private:
+    using IndexType = Uint32;
+
+    static constexpr IndexType InvalidIndex = ~IndexType{0};
+
+    struct FreeBlockInfo
+    {
+        OffsetType Offset = 0;
+        OffsetType Size   = 0;
+
+        // Links in the free list of the block's size class.
+        // For unused descriptors, NextFree links the pool's free list.
+        IndexType PrevFree = InvalidIndex;
+        IndexType NextFree = InvalidIndex;
+    };
+
+    // Open-addressing hash table with linear probing that maps offsets to block indices
+    class OffsetHashTable
+    {
+    public:
+        explicit OffsetHashTable(IMemoryAllocator& Allocator) :
+            m_Slots(STD_ALLOCATOR_RAW_MEM(Slot, Allocator, "Allocator for vector<TLSFAllocationsManager::OffsetHashTable::Slot>"))
+        {}
+
+        IndexType Find(OffsetType Key) const
+        {
+            if (m_Slots.empty())
+                return InvalidIndex;
+
+            for (size_t i = GetHomeSlot(Key);; i = (i + 1) & m_Mask)
+            {
+                const auto& Slot = m_Slots[i];
+                if (Slot.Key == Key)
+                    return Slot.Value;
+                if (Slot.Key == EmptyKey)
+                    return InvalidIndex;
+            }
+        }
+
+        void Insert(OffsetType Key, IndexType Value)
+        {
+            VERIFY_EXPR(Key != EmptyKey);
+            if ((m_Count + 1) * 2 > m_Slots.size())
+                Rehash((std::max)(m_Slots.size() * 2, size_t{16}));
+
+            size_t i = GetHomeSlot(Key);
+            while (m_Slots[i].Key != EmptyKey)
+            {
+                VERIFY(m_Slots[i].Key != Key, "Key ", Key, " is already present in the table");
+                i = (i + 1) & m_Mask;
+            }
+            m_Slots[i] = Slot{Key, Value};
+            ++m_Count;
+        }
+
+        void Erase(OffsetType Key)
+        {
+            VERIFY_EXPR(!m_Slots.empty());
+            size_t i = GetHomeSlot(Key);
+            while (m_Slots[i].Key != Key)
+            {
+                VERIFY(m_Slots[i].Key != EmptyKey, "Key ", Key, " is not found in the table");
+                i = (i + 1) & m_Mask;
+            }
+
+            // Backward-shift deletion: move subsequent entries of the probe sequence into the hole
+            // so that lookups never need tombstones.
+            for (size_t j = (i + 1) & m_Mask;; j = (j + 1) & m_Mask)
+            {
+                const auto& Slot = m_Slots[j];
+                if (Slot.Key == EmptyKey)
+                    break;
+
+                // The entry may only be moved to the hole if the hole lies between its home slot and j (cyclically)
+                const size_t Home = GetHomeSlot(Slot.Key);
+                if (((j - Home) & m_Mask) >= ((j - i) & m_Mask))
+                {
+                    m_Slots[i] = Slot;
+                    i          = j;
+                }
+            }
+            m_Slots[i].Key = EmptyKey;
+            --m_Count;
+        }
+
+        size_t GetCount() const { return m_Count; }
+
+    private:
+        static constexpr OffsetType EmptyKey = ~OffsetType{0};
+
+        struct Slot
+        {
+            OffsetType Key   = EmptyKey;
+            IndexType  Value = InvalidIndex;
+
+            Slot() noexcept {}
+            Slot(OffsetType _Key, IndexType _Value) noexcept :
+                Key{_Key}, Value{_Value}
+            {}
+        };
+
+        size_t GetHomeSlot(OffsetType Key) const
+        {
+            // Fibonacci hashing spreads aligned offsets that share low bits across the table
+            return static_cast<size_t>((static_cast<Uint64>(Key) * Uint64{0x9E3779B97F4A7C15}) >> m_Shift);
+        }
+
+        void Rehash(size_t NewSize)
+        {
+            VERIFY_EXPR(IsPowerOfTwo(NewSize));
+            std::vector<Slot, STDAllocatorRawMem<Slot>> OldSlots{NewSize, Slot{}, m_Slots.get_allocator()};
+            std::swap(OldSlots, m_Slots);
+
+            m_Mask  = NewSize - 1;
+            m_Shift = 64 - PlatformMisc::GetMSB(static_cast<Uint64>(NewSize));
+            m_Count = 0;
+            for (const auto& Slot : OldSlots)
+            {
+                if (Slot.Key != EmptyKey)
+                    Insert(Slot.Key, Slot.Value);
+            }
+        }
+
+        std::vector<Slot, STDAllocatorRawMem<Slot>> m_Slots;
+
+        size_t m_Mask  = 0;
+        Uint32 m_Shift = 64;
+        size_t m_Count = 0;
+    };
+
+public:
+    explicit TLSFAllocationsManager(const CreateInfo& CI) :
+        // clang-format off
+        m_Blocks       {STD_ALLOCATOR_RAW_MEM(FreeBlockInfo, CI.Allocator, "Allocator for vector<TLSFAllocationsManager::FreeBlockInfo>")},
+        m_BlocksByStart{CI.Allocator},
+        m_BlocksByEnd  {CI.Allocator},
+        m_MaxSize      {CI.MaxSize},
+        m_FreeSize     {CI.MaxSize}
+#ifdef DILIGENT_DEBUG
+        , m_DbgDisableDebugValidation{CI.DbgDisableDebugValidation}
+#endif
+    // clang-format on
+    {
+        for (auto& Heads : m_FreeListHeads)
+            std::fill(std::begin(Heads), std::end(Heads), IndexType{InvalidIndex});
+
+        // Insert single maximum-size block
+        if (m_MaxSize > 0)
+            AddNewBlock(0, m_MaxSize);
+        ResetCurrAlignment();
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+    }
+
+    TLSFAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
+        TLSFAllocationsManager{CreateInfo{Allocator, MaxSize}}
+    {}
+
+    ~TLSFAllocationsManager()
+    {
+#ifdef DILIGENT_DEBUG
+        if (m_NumFreeBlocks != 0)
+        {
+            VERIFY(m_NumFreeBlocks == 1, "Single free block is expected");
+            const auto BlockIdx = m_BlocksByStart.Find(0);
+            VERIFY(BlockIdx != InvalidIndex, "Head chunk offset is expected to be 0");
+            if (BlockIdx != InvalidIndex)
+                VERIFY(m_Blocks[BlockIdx].Size == m_MaxSize, "Head chunk size is expected to be ", m_MaxSize);
+        }
+#endif
+    }
+
+    // clang-format off
+    TLSFAllocationsManager(TLSFAllocationsManager&& rhs) noexcept
+        : m_Blocks        {std::move(rhs.m_Blocks)       }
+        , m_BlocksByStart {std::move(rhs.m_BlocksByStart)}
+        , m_BlocksByEnd   {std::move(rhs.m_BlocksByEnd)  }
+        , m_FirstUnusedBlock{rhs.m_FirstUnusedBlock}
+        , m_FLBitmap      {rhs.m_FLBitmap     }
+        , m_NumFreeBlocks {rhs.m_NumFreeBlocks}
+        , m_MaxSize       {rhs.m_MaxSize      }
+        , m_FreeSize      {rhs.m_FreeSize     }
+        , m_CurrAlignment {rhs.m_CurrAlignment}
+#ifdef DILIGENT_DEBUG
+        , m_DbgDisableDebugValidation{rhs.m_DbgDisableDebugValidation}
+#endif
+    {
+        // clang-format on
+        for (Uint32 FL = 0; FL < FLCount; ++FL)
+        {
+            m_SLBitmaps[FL] = rhs.m_SLBitmaps[FL];
+            std::copy(std::begin(rhs.m_FreeListHeads[FL]), std::end(rhs.m_FreeListHeads[FL]), std::begin(m_FreeListHeads[FL]));
+
+            rhs.m_SLBitmaps[FL] = 0;
+            std::fill(std::begin(rhs.m_FreeListHeads[FL]), std::end(rhs.m_FreeListHeads[FL]), IndexType{InvalidIndex});
+        }
+        rhs.m_FirstUnusedBlock = InvalidIndex;
+        rhs.m_FLBitmap         = 0;
+        rhs.m_NumFreeBlocks    = 0;
+        rhs.m_MaxSize          = 0;
+        rhs.m_FreeSize         = 0;
+        rhs.m_CurrAlignment    = 0;
+    }
+
+    // clang-format off
+    TLSFAllocationsManager& operator = (      TLSFAllocationsManager&&) = delete;
+    TLSFAllocationsManager             (const TLSFAllocationsManager&)  = delete;
+    TLSFAllocationsManager& operator = (const TLSFAllocationsManager&)  = delete;
+    // clang-format on
+
+    // Offset returned by Allocate() may not be aligned, but the size of the allocation
+    // is sufficient to properly align it
+    Allocation Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        Size = AlignUp(Size, Alignment);
+        if (m_FreeSize < Size)
+            return Allocation::InvalidAllocation();
+
+        const auto AlignmentReserve = (Alignment > m_CurrAlignment) ? Alignment - m_CurrAlignment : 0;
+
+        const auto BlockIdx = FindSuitableBlock(Size + AlignmentReserve);
+        if (BlockIdx == InvalidIndex)
+            return Allocation::InvalidAllocation();
+
+        VERIFY_EXPR(Size + AlignmentReserve <= m_Blocks[BlockIdx].Size);
+
+        auto NewAllocation = AllocateFromBlock(BlockIdx, Size, Alignment);
+        VERIFY_EXPR(NewAllocation.Size <= Size + AlignmentReserve);
+        return NewAllocation;
+    }
+
+    void Free(Allocation&& allocation)
+    {
+        VERIFY_EXPR(allocation.IsValid());
+        Free(allocation.UnalignedOffset, allocation.Size);
+        allocation = Allocation{};
+    }
+
+    void Free(OffsetType Offset, OffsetType Size)
+    {
+        VERIFY_EXPR(Offset != Allocation::InvalidOffset && Size > 0 && Offset + Size <= m_MaxSize);
+        VERIFY(m_BlocksByStart.Find(Offset) == InvalidIndex, "Block at offset ", Offset, " is already free");
+
+        auto NewOffset = Offset;
+        auto NewSize   = Size;
+
+        //   PrevBlock.Offset           Offset            NextBlock.Offset
+        //     |                          |                    |
+        //     |<-----PrevBlock.Size----->|<------Size-------->|<-----NextBlock.Size----->|
+        //
+        const auto PrevBlockIdx = m_BlocksByEnd.Find(Offset);
+        if (PrevBlockIdx != InvalidIndex)
+        {
+            NewOffset = m_Blocks[PrevBlockIdx].Offset;
+            NewSize += m_Blocks[PrevBlockIdx].Size;
+            RemoveBlock(PrevBlockIdx);
+        }
+
+        const auto NextBlockIdx = m_BlocksByStart.Find(Offset + Size);
+        if (NextBlockIdx != InvalidIndex)
+        {
+            NewSize += m_Blocks[NextBlockIdx].Size;
+            RemoveBlock(NextBlockIdx);
+        }
+
+        AddNewBlock(NewOffset, NewSize);
+
+        m_FreeSize += Size;
+        VERIFY_EXPR(m_FreeSize <= m_MaxSize);
+        if (IsEmpty())
+        {
+            // Reset current alignment
+            VERIFY_EXPR(GetNumFreeBlocks() == 1);
+            ResetCurrAlignment();
+        }
+
+#ifdef DILIGENT_DEBUG
+        if (!m_DbgDisableDebugValidation)
+            DbgVerifyList();
+#endif
+    }
+
+    // clang-format off
+    bool IsFull() const{ return m_FreeSize==0; };
+    bool IsEmpty()const{ return m_FreeSize==m_MaxSize; };
+    OffsetType GetMaxSize() const{return m_MaxSize;}
+    OffsetType GetFreeSize()const{return m_FreeSize;}
+    OffsetType GetUsedSize()const{return m_MaxSize - m_FreeSize;}
+    // clang-format on
+
+    size_t GetNumFreeBlocks() const
+    {
+        return m_NumFreeBlocks;
+    }
+
+    OffsetType GetMaxFreeBlockSize() const
+    {
+        if (m_FLBitmap == 0)
+            return 0;
+
+        // The largest block is in the highest non-empty class, but the list is not sorted
+        const auto FL = PlatformMisc::GetMSB(m_FLBitmap);
+        const auto SL = PlatformMisc::GetMSB(m_SLBitmaps[FL]);
+
+        OffsetType MaxSize = 0;
+        for (auto BlockIdx = m_FreeListHeads[FL][SL]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+            MaxSize = (std::max)(MaxSize, m_Blocks[BlockIdx].Size);
+        return MaxSize;
+    }
+
+    void Extend(size_t ExtraSize)
+    {
+        auto NewBlockOffset = m_MaxSize;
+        auto NewBlockSize   = OffsetType{ExtraSize};
+
+        const auto LastBlockIdx = m_BlocksByEnd.Find(m_MaxSize);
+        if (LastBlockIdx != InvalidIndex)
+        {
+            // Extend the last block
+            NewBlockOffset = m_Blocks[LastBlockIdx].Offset;
+            NewBlockSize += m_Blocks[LastBlockIdx].Size;
+            RemoveBlock(LastBlockIdx);
+        }
+
+        if (NewBlockSize > 0)
+            AddNewBlock(NewBlockOffset, NewBlockSize);
+
+        m_MaxSize += ExtraSize;
+        m_FreeSize += ExtraSize;
+
+#ifdef DILIGENT_DEBUG
+        if (!m_DbgDisableDebugValidation)
+            DbgVerifyList();
+#endif
+    }
+
+    // Produces a list of moves that relocate allocations from the end of the managed space into
+    // the free blocks that precede them. The semantics and the contract are the same as those of
+    // VariableSizeAllocationsManager::PlanDefragmentation().
+    //
+    // Free blocks are not ordered by offset, so unlike Allocate() and Free(), the method is not
+    // constant-time: it sorts the free blocks once and scans them for every allocation.
+    std::vector<DefragmentationMove> PlanDefragmentation(const DefragmentationAttribs& Attribs)
+    {
+        std::vector<DefragmentationMove> Moves;
+        if (Attribs.NumAllocations == 0 || Attribs.MaxMoves == 0 || m_NumFreeBlocks == 0)
+            return Moves;
+        DEV_CHECK_ERR(Attribs.pAllocations != nullptr, "pAllocations must not be null");
+
+        // Process allocations from the end of the space towards the beginning
+        std::vector<size_t> Order(Attribs.NumAllocations);
+        for (size_t i = 0; i < Order.size(); ++i)
+            Order[i] = i;
+        std::sort(Order.begin(), Order.end(),
+                  [&Attribs](size_t lhs, size_t rhs) {
+                      return Attribs.pAllocations[lhs].UnalignedOffset > Attribs.pAllocations[rhs].UnalignedOffset;
+                  });
+
+        // Free blocks ordered by offset. Blocks are only split from the start while the plan is made,
+        // so the order is preserved when the entries are updated in place.
+        struct FreeBlockRange
+        {
+            OffsetType Offset;
+            OffsetType Size;
+        };
+        std::vector<FreeBlockRange> FreeBlocks;
+        FreeBlocks.reserve(m_NumFreeBlocks);
+        for (Uint32 FL = 0; FL < FLCount; ++FL)
+        {
+            for (Uint32 SL = 0; SL < SLCount; ++SL)
+            {
+                for (auto BlockIdx = m_FreeListHeads[FL][SL]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+                    FreeBlocks.push_back({m_Blocks[BlockIdx].Offset, m_Blocks[BlockIdx].Size});
+            }
+        }
+        std::sort(FreeBlocks.begin(), FreeBlocks.end(),
+                  [](const FreeBlockRange& lhs, const FreeBlockRange& rhs) {
+                      return lhs.Offset < rhs.Offset;
+                  });
+
+        OffsetType BytesToMove = 0;
+        for (auto AllocIdx : Order)
+        {
+            if (Moves.size() >= Attribs.MaxMoves || FreeBlocks.empty())
+                break;
+
+            const auto& Alloc = Attribs.pAllocations[AllocIdx];
+            VERIFY_EXPR(Alloc.IsValid() && Alloc.UnalignedOffset + Alloc.Size <= m_MaxSize);
+
+            // All remaining allocations precede the first free block, so they are already compacted
+            if (FreeBlocks.front().Offset > Alloc.UnalignedOffset)
+                break;
+
+            const auto Alignment = Attribs.pAlignments != nullptr ? Attribs.pAlignments[AllocIdx] : OffsetType{1};
+            VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+
+            const auto SrcOffset = AlignUp(Alloc.UnalignedOffset, Alignment);
+            const auto CopySize  = Alloc.UnalignedOffset + Alloc.Size - SrcOffset;
+            VERIFY((CopySize & (Alignment - 1)) == 0, "Allocation size is not a multiple of its alignment. Are the alignments correct?");
+            if (CopySize > Attribs.MaxBytesToMove - BytesToMove)
+                continue;
+
+            for (auto BlockIt = FreeBlocks.begin(); BlockIt != FreeBlocks.end() && BlockIt->Offset < Alloc.UnalignedOffset; ++BlockIt)
+            {
+                VERIFY(BlockIt->Offset + BlockIt->Size <= Alloc.UnalignedOffset, "Allocation overlaps with a free block");
+                if (AlignUp(BlockIt->Offset, Alignment) + CopySize > BlockIt->Offset + BlockIt->Size)
+                    continue;
+
+                const auto BlockIdx = m_BlocksByStart.Find(BlockIt->Offset);
+                VERIFY_EXPR(BlockIdx != InvalidIndex && m_Blocks[BlockIdx].Size == BlockIt->Size);
+
+                DefragmentationMove Move;
+                Move.AllocationIndex = AllocIdx;
+                Move.NewAllocation   = AllocateFromBlock(BlockIdx, CopySize, Alignment);
+                Move.SrcOffset       = SrcOffset;
+                Move.DstOffset       = AlignUp(Move.NewAllocation.UnalignedOffset, Alignment);
+                Move.CopySize        = CopySize;
+                VERIFY_EXPR(Move.DstOffset + CopySize <= Alloc.UnalignedOffset);
+                Moves.push_back(Move);
+
+                BlockIt->Offset += Move.NewAllocation.Size;
+                BlockIt->Size -= Move.NewAllocation.Size;
+                if (BlockIt->Size == 0)
+                    FreeBlocks.erase(BlockIt);
+
+                BytesToMove += CopySize;
+                break;
+            }
+        }
+
+        return Moves;
+    }
+
+private:
+    // Returns the first- and second-level indices of the class the block of the given size belongs to
+    static void MapSize(OffsetType Size, Uint32& FL, Uint32& SL)
+    {
+        VERIFY_EXPR(Size > 0);
+        if (Size < SmallBlockSize)
+        {
+            FL = 0;
+            SL = static_cast<Uint32>(Size);
+        }
+        else
+        {
+            const auto MSB = PlatformMisc::GetMSB(static_cast<Uint64>(Size));
+            FL             = MSB - SLCountLog2 + 1;
+            SL             = static_cast<Uint32>(Size >> (MSB - SLCountLog2)) ^ SLCount;
+        }
+        VERIFY_EXPR(FL < FLCount && SL < SLCount);
+    }
+
+    // Finds a free block that can accommodate Size bytes
+    IndexType FindSuitableBlock(OffsetType Size) const
+    {
+        Uint32 FL = 0, SL = 0;
+        MapSize(Size, FL, SL);
+        const auto ExactFL = FL;
+        const auto ExactSL = SL;
+
+        // All blocks in the classes above the one Size belongs to are large enough
+        if (++SL == SLCount)
+        {
+            SL = 0;
+            ++FL;
+        }
+
+        IndexType BlockIdx = InvalidIndex;
+        if (FL < FLCount)
+        {
+            auto SLMap = m_SLBitmaps[FL] & (~Uint32{0} << SL);
+            if (SLMap == 0)
+            {
+                const auto FLMap = FL + 1 < FLCount ? m_FLBitmap & (~Uint64{0} << (FL + 1)) : 0;
+                if (FLMap != 0)
+                {
+                    FL    = PlatformMisc::GetLSB(FLMap);
+                    SLMap = m_SLBitmaps[FL];
+                    VERIFY_EXPR(SLMap != 0);
+                }
+            }
+            if (SLMap != 0)
+            {
+                SL       = PlatformMisc::GetLSB(SLMap);
+                BlockIdx = m_FreeListHeads[FL][SL];
+                VERIFY_EXPR(BlockIdx != InvalidIndex && m_Blocks[BlockIdx].Size >= Size);
+            }
+        }
+
+        if (BlockIdx == InvalidIndex)
+        {
+            // Blocks in the class Size belongs to may still be large enough.
+            // This is the only non-constant-time path, and it is only taken when the manager is nearly full.
+            for (BlockIdx = m_FreeListHeads[ExactFL][ExactSL]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+            {
+                if (m_Blocks[BlockIdx].Size >= Size)
+                    break;
+            }
+        }
+
+        return BlockIdx;
+    }
+
+    Allocation AllocateFromBlock(IndexType BlockIdx, OffsetType Size, OffsetType Alignment)
+    {
+        const auto Offset    = m_Blocks[BlockIdx].Offset;
+        const auto BlockSize = m_Blocks[BlockIdx].Size;
+        VERIFY_EXPR(Offset % m_CurrAlignment == 0);
+
+        //        Offset                       Offset + BlockSize
+        //        |                                  |
+        //        |<-----------BlockSize------------>|
+        //        |<--AdjustedSize-->|<---NewSize--->|
+        //                           |
+        //                       NewOffset
+        //
+        const auto AlignedOffset = AlignUp(Offset, Alignment);
+        const auto AdjustedSize  = Size + (AlignedOffset - Offset);
+        VERIFY_EXPR(AdjustedSize <= BlockSize);
+
+        RemoveBlock(BlockIdx);
+        if (BlockSize > AdjustedSize)
+        {
+            AddNewBlock(Offset + AdjustedSize, BlockSize - AdjustedSize);
+        }
+
+        m_FreeSize -= AdjustedSize;
+
+        if ((Size & (m_CurrAlignment - 1)) != 0)
+        {
+            if (IsPowerOfTwo(Size))
+            {
+                VERIFY_EXPR(Size >= Alignment && Size < m_CurrAlignment);
+                m_CurrAlignment = Size;
+            }
+            else
+            {
+                m_CurrAlignment = (std::min)(m_CurrAlignment, Alignment);
+            }
+        }
+
+#ifdef DILIGENT_DEBUG
+        if (!m_DbgDisableDebugValidation)
+            DbgVerifyList();
+#endif
+        return Allocation{Offset, AdjustedSize};
+    }
+
+    void AddNewBlock(OffsetType Offset, OffsetType Size)
+    {
+        IndexType BlockIdx = m_FirstUnusedBlock;
+        if (BlockIdx != InvalidIndex)
+        {
+            m_FirstUnusedBlock = m_Blocks[BlockIdx].NextFree;
+        }
+        else
+        {
+            BlockIdx = static_cast<IndexType>(m_Blocks.size());
+            m_Blocks.emplace_back();
+        }
+
+        Uint32 FL = 0, SL = 0;
+        MapSize(Size, FL, SL);
+
+        auto& Block    = m_Blocks[BlockIdx];
+        Block.Offset   = Offset;
+        Block.Size     = Size;
+        Block.PrevFree = InvalidIndex;
+        Block.NextFree = m_FreeListHeads[FL][SL];
+        if (Block.NextFree != InvalidIndex)
+            m_Blocks[Block.NextFree].PrevFree = BlockIdx;
+        m_FreeListHeads[FL][SL] = BlockIdx;
+
+        m_FLBitmap |= Uint64{1} << FL;
+        m_SLBitmaps[FL] |= 1u << SL;
+
+        m_BlocksByStart.Insert(Offset, BlockIdx);
+        m_BlocksByEnd.Insert(Offset + Size, BlockIdx);
+        ++m_NumFreeBlocks;
+    }
+
+    void RemoveBlock(IndexType BlockIdx)
+    {
+        auto& Block = m_Blocks[BlockIdx];
+
+        Uint32 FL = 0, SL = 0;
+        MapSize(Block.Size, FL, SL);
+
+        if (Block.PrevFree != InvalidIndex)
+        {
+            m_Blocks[Block.PrevFree].NextFree = Block.NextFree;
+        }
+        else
+        {
+            VERIFY_EXPR(m_FreeListHeads[FL][SL] == BlockIdx);
+            m_FreeListHeads[FL][SL] = Block.NextFree;
+            if (Block.NextFree == InvalidIndex)
+            {
+                m_SLBitmaps[FL] &= ~(1u << SL);
+                if (m_SLBitmaps[FL] == 0)
+                    m_FLBitmap &= ~(Uint64{1} << FL);
+            }
+        }
+        if (Block.NextFree != InvalidIndex)
+            m_Blocks[Block.NextFree].PrevFree = Block.PrevFree;
+
+        m_BlocksByStart.Erase(Block.Offset);
+        m_BlocksByEnd.Erase(Block.Offset + Block.Size);
+        VERIFY_EXPR(m_NumFreeBlocks > 0);
+        --m_NumFreeBlocks;
+
+        Block.PrevFree     = InvalidIndex;
+        Block.NextFree     = m_FirstUnusedBlock;
+        m_FirstUnusedBlock = BlockIdx;
+    }
+
+    void ResetCurrAlignment()
+    {
+        for (m_CurrAlignment = 1; m_CurrAlignment * 2 <= m_MaxSize; m_CurrAlignment *= 2)
+        {}
+    }
+
+#ifdef DILIGENT_DEBUG
+    void DbgVerifyList()
+    {
+        VERIFY_EXPR(IsPowerOfTwo(m_CurrAlignment));
+
+        std::vector<const FreeBlockInfo*> FreeBlocks;
+        FreeBlocks.reserve(m_NumFreeBlocks);
+        for (Uint32 FL = 0; FL < FLCount; ++FL)
+        {
+            VERIFY_EXPR(((m_FLBitmap >> FL) & 1) == (m_SLBitmaps[FL] != 0 ? Uint64{1} : Uint64{0}));
+            for (Uint32 SL = 0; SL < SLCount; ++SL)
+            {
+                VERIFY_EXPR(((m_SLBitmaps[FL] >> SL) & 1) == (m_FreeListHeads[FL][SL] != InvalidIndex ? 1u : 0u));
+
+                auto PrevIdx = InvalidIndex;
+                for (auto BlockIdx = m_FreeListHeads[FL][SL]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+                {
+                    const auto& Block = m_Blocks[BlockIdx];
+                    VERIFY_EXPR(Block.PrevFree == PrevIdx);
+
+                    Uint32 BlockFL = 0, BlockSL = 0;
+                    MapSize(Block.Size, BlockFL, BlockSL);
+                    VERIFY(BlockFL == FL && BlockSL == SL, "Block of size ", Block.Size, " is in the wrong free list");
+                    VERIFY_EXPR(m_BlocksByStart.Find(Block.Offset) == BlockIdx);
+                    VERIFY_EXPR(m_BlocksByEnd.Find(Block.Offset + Block.Size) == BlockIdx);
+
+                    FreeBlocks.push_back(&Block);
+                    PrevIdx = BlockIdx;
+                }
+            }
+        }
+        VERIFY_EXPR(FreeBlocks.size() == m_NumFreeBlocks);
+        VERIFY_EXPR(m_BlocksByStart.GetCount() == m_NumFreeBlocks && m_BlocksByEnd.GetCount() == m_NumFreeBlocks);
+
+        std::sort(FreeBlocks.begin(), FreeBlocks.end(),
+                  [](const FreeBlockInfo* lhs, const FreeBlockInfo* rhs) {
+                      return lhs->Offset < rhs->Offset;
+                  });
+
+        OffsetType           TotalFreeSize = 0;
+        const FreeBlockInfo* pPrevBlock    = nullptr;
+        for (const auto* pBlock : FreeBlocks)
+        {
+            VERIFY_EXPR(pBlock->Offset + pBlock->Size <= m_MaxSize);
+            VERIFY((pBlock->Offset & (m_CurrAlignment - 1)) == 0, "Block offset (", pBlock->Offset, ") is not ", m_CurrAlignment, "-aligned");
+            if (pBlock->Offset + pBlock->Size < m_MaxSize)
+                VERIFY((pBlock->Size & (m_CurrAlignment - 1)) == 0, "All block sizes except for the last one must be ", m_CurrAlignment, "-aligned");
+            VERIFY(pPrevBlock == nullptr || pBlock->Offset > pPrevBlock->Offset + pPrevBlock->Size, "Unmerged adjacent or overlapping blocks detected");
+            TotalFreeSize += pBlock->Size;
+            pPrevBlock = pBlock;
+        }
+
+        VERIFY_EXPR(TotalFreeSize == m_FreeSize);
+    }
+#endif
+
+    // Free block descriptors. Descriptors of removed blocks are linked into
+    // a list starting at m_FirstUnusedBlock and reused.
+    std::vector<FreeBlockInfo, STDAllocatorRawMem<FreeBlockInfo>> m_Blocks;
+
+    // Free block start offset -> block index
+    OffsetHashTable m_BlocksByStart;
+    // Free block end offset -> block index
+    OffsetHashTable m_BlocksByEnd;
+
+    IndexType m_FirstUnusedBlock = InvalidIndex;
+
+    Uint64    m_FLBitmap                        = 0;
+    Uint32    m_SLBitmaps[FLCount]              = {};
+    IndexType m_FreeListHeads[FLCount][SLCount] = {};
+
+    size_t m_NumFreeBlocks = 0;
+
+    OffsetType m_MaxSize       = 0;
+    OffsetType m_FreeSize      = 0;
+    OffsetType m_CurrAlignment = 0;
+#ifdef DILIGENT_DEBUG
+    bool m_DbgDisableDebugValidation = false;
+#endif
+    // When adding new members, do not forget to update move ctor
+};
+
+} // namespace Diligent
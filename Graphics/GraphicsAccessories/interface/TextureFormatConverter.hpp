@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// CPU conversion of texture data between texture formats.
+
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+
+namespace Diligent
+{
+
+class IThreadPool;
+
+/// Attributes of the ConvertTextureData function.
+struct ConvertTextureDataAttribs
+{
+    /// Width of the region to convert, in texels.
+    Uint32 Width = 0;
+
+    /// Height of the region to convert, in texels.
+    Uint32 Height = 0;
+
+    /// Source texture format.
+    TEXTURE_FORMAT SrcFormat = TEX_FORMAT_UNKNOWN;
+
+    /// A pointer to the source data.
+    const void* pSrcData = nullptr;
+
+    /// Source row stride, in bytes.
+    size_t SrcStride = 0;
+
+    /// Destination texture format.
+    TEXTURE_FORMAT DstFormat = TEX_FORMAT_UNKNOWN;
+
+    /// A pointer to the destination data.
+    void* pDstData = nullptr;
+
+    /// Destination row stride, in bytes.
+    size_t DstStride = 0;
+
+    /// Optional thread pool to convert the rows in parallel.
+    IThreadPool* pThreadPool = nullptr;
+};
+
+/// Checks if texture data can be converted from SrcFormat to DstFormat by ConvertTextureData.
+
+/// Uncompressed formats with normalized, floating-point and depth components as well as
+/// packed formats (RGB10A2, R11G11B10, RGB9E5, B5G6R5, B5G5R5A1) can be converted to each other.
+/// Integer formats can only be converted to integer formats. Typeless, compressed and
+/// depth-stencil formats are not supported, except for the copy between identical formats.
+bool IsTextureFormatConversionSupported(TEXTURE_FORMAT SrcFormat, TEXTURE_FORMAT DstFormat);
+
+/// Converts texture data from one format to another.
+
+/// \param[in]  Attribs - Conversion attributes, see Diligent::ConvertTextureDataAttribs.
+///
+/// \return     true if the data was converted successfully, and false if the conversion
+///             is not supported, see IsTextureFormatConversionSupported.
+///
+/// \remarks    The source texels are decoded to linear floating-point RGBA values and then
+///             encoded to the destination format. Components that are missing in the source
+///             format are set to 0, and alpha is set to 1. sRGB components are converted to
+///             linear space and back. Normalized and integer components are clamped to the
+///             range of the destination format, and normalized values are rounded to the nearest.
+///
+///             Identical formats, RGBA8 <-> BGRA8 swizzles and 16-bit <-> 32-bit float conversions
+///             with the same number of components use dedicated fast paths.
+///
+///             Source and destination must not overlap.
+bool ConvertTextureData(const ConvertTextureDataAttribs& Attribs);
+
+} // namespace Diligent
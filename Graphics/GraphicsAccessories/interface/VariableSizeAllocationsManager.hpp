@@ -31,7 +31,9 @@
 #pragma once
 
 #include <map>
+#include <vector>
 #include <algorithm>
+#include <numeric>
 
 #include "../../../Primitives/interface/MemoryAllocator.h"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
@@ -222,50 +224,11 @@ public:
         auto SmallestBlockIt = SmallestBlockItIt->second;
         VERIFY_EXPR(Size + AlignmentReserve <= SmallestBlockIt->second.Size);
         VERIFY_EXPR(SmallestBlockIt->second.Size == SmallestBlockItIt->first);
-
-        //     SmallestBlockIt.Offset
-        //        |                                  |
-        //        |<------SmallestBlockIt.Size------>|
-        //        |<------Size------>|<---NewSize--->|
-        //        |                  |
-        //      Offset              NewOffset
-        //
-        auto Offset = SmallestBlockIt->first;
-        VERIFY_EXPR(Offset % m_CurrAlignment == 0);
-        auto AlignedOffset = AlignUp(Offset, Alignment);
-        auto AdjustedSize  = Size + (AlignedOffset - Offset);
-        VERIFY_EXPR(AdjustedSize <= Size + AlignmentReserve);
-        auto NewOffset = Offset + AdjustedSize;
-        auto NewSize   = SmallestBlockIt->second.Size - AdjustedSize;
         VERIFY_EXPR(SmallestBlockItIt == SmallestBlockIt->second.OrderBySizeIt);
-        m_FreeBlocksBySize.erase(SmallestBlockItIt);
-        m_FreeBlocksByOffset.erase(SmallestBlockIt);
-        if (NewSize > 0)
-        {
-            AddNewBlock(NewOffset, NewSize);
-        }
-
-        m_FreeSize -= AdjustedSize;
-
-        if ((Size & (m_CurrAlignment - 1)) != 0)
-        {
-            if (IsPowerOfTwo(Size))
-            {
-                VERIFY_EXPR(Size >= Alignment && Size < m_CurrAlignment);
-                m_CurrAlignment = Size;
-            }
-            else
-            {
-                m_CurrAlignment = (std::min)(m_CurrAlignment, Alignment);
-            }
-        }
 
-#ifdef DILIGENT_DEBUG
-        VERIFY_EXPR(m_FreeBlocksByOffset.size() == m_FreeBlocksBySize.size());
-        if (!m_DbgDisableDebugValidation)
-            DbgVerifyList();
-#endif
-        return Allocation{Offset, AdjustedSize};
+        auto NewAllocation = AllocateFromBlock(SmallestBlockIt, Size, Alignment);
+        VERIFY_EXPR(NewAllocation.Size <= Size + AlignmentReserve);
+        return NewAllocation;
     }
 
     void Free(Allocation&& allocation)
@@ -428,7 +391,167 @@ public:
 #endif
     }
 
+    struct DefragmentationMove
+    {
+        // Index of the allocation in DefragmentationAttribs::pAllocations
+        size_t AllocationIndex = 0;
+
+        // New allocation that replaces the original one
+        Allocation NewAllocation;
+
+        // Aligned offset of the data in the original allocation
+        OffsetType SrcOffset = 0;
+
+        // Aligned offset of the data in the new allocation
+        OffsetType DstOffset = 0;
+
+        // The number of bytes to copy
+        OffsetType CopySize = 0;
+    };
+
+    struct DefragmentationAttribs
+    {
+        // Live allocations that may be relocated
+        const Allocation* pAllocations = nullptr;
+
+        // Alignments that were requested for the allocations.
+        // If null, all allocations are assumed to have been made with alignment 1.
+        const OffsetType* pAlignments = nullptr;
+
+        size_t NumAllocations = 0;
+
+        // The maximum number of moves to produce
+        size_t MaxMoves = ~size_t{0};
+
+        // The maximum total number of bytes to copy
+        OffsetType MaxBytesToMove = ~OffsetType{0};
+    };
+
+    // Produces a list of moves that relocate allocations from the end of the managed space
+    // into the free blocks that precede them, so that free space is compacted towards the end.
+    //
+    // Allocations are processed starting from the one with the largest offset, and each is moved
+    // to the first free block that can accommodate it. The destination and source regions never overlap.
+    // The number of moves and the number of bytes to copy are bounded by Attribs.MaxMoves and
+    // Attribs.MaxBytesToMove, so that the defragmentation can be performed incrementally
+    // over several frames by calling the method repeatedly.
+    //
+    // Destination regions are allocated from the manager before the method returns, while the
+    // original allocations remain allocated. For every move, the caller must copy CopySize bytes
+    // from SrcOffset to DstOffset, start using NewAllocation in place of the original allocation, and
+    // free the original allocation once the copy is complete (e.g. when the GPU fence is signaled).
+    std::vector<DefragmentationMove> PlanDefragmentation(const DefragmentationAttribs& Attribs)
+    {
+        std::vector<DefragmentationMove> Moves;
+        if (Attribs.NumAllocations == 0 || Attribs.MaxMoves == 0)
+            return Moves;
+        DEV_CHECK_ERR(Attribs.pAllocations != nullptr, "pAllocations must not be null");
+
+        // Process allocations from the end of the space towards the beginning
+        std::vector<size_t> Order(Attribs.NumAllocations);
+        std::iota(Order.begin(), Order.end(), size_t{0});
+        std::sort(Order.begin(), Order.end(),
+                  [&Attribs](size_t lhs, size_t rhs) {
+                      return Attribs.pAllocations[lhs].UnalignedOffset > Attribs.pAllocations[rhs].UnalignedOffset;
+                  });
+
+        OffsetType BytesToMove = 0;
+        for (auto AllocIdx : Order)
+        {
+            if (Moves.size() >= Attribs.MaxMoves || m_FreeBlocksByOffset.empty())
+                break;
+
+            const auto& Alloc = Attribs.pAllocations[AllocIdx];
+            VERIFY_EXPR(Alloc.IsValid() && Alloc.UnalignedOffset + Alloc.Size <= m_MaxSize);
+
+            // All remaining allocations precede the first free block, so they are already compacted
+            if (m_FreeBlocksByOffset.begin()->first > Alloc.UnalignedOffset)
+                break;
+
+            const auto Alignment = Attribs.pAlignments != nullptr ? Attribs.pAlignments[AllocIdx] : OffsetType{1};
+            VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+
+            //   UnalignedOffset   SrcOffset
+            //        |              |
+            //        |<----------Alloc.Size---------->|
+            //                       |<---CopySize---->|
+            //
+            const auto SrcOffset = AlignUp(Alloc.UnalignedOffset, Alignment);
+            const auto CopySize  = Alloc.UnalignedOffset + Alloc.Size - SrcOffset;
+            VERIFY((CopySize & (Alignment - 1)) == 0, "Allocation size is not a multiple of its alignment. Are the alignments correct?");
+            if (CopySize > Attribs.MaxBytesToMove - BytesToMove || CopySize + (Alignment - 1) > GetMaxFreeBlockSize())
+                continue;
+
+            for (auto BlockIt = m_FreeBlocksByOffset.begin(); BlockIt != m_FreeBlocksByOffset.end() && BlockIt->first < Alloc.UnalignedOffset; ++BlockIt)
+            {
+                VERIFY(BlockIt->first + BlockIt->second.Size <= Alloc.UnalignedOffset, "Allocation overlaps with a free block");
+                if (AlignUp(BlockIt->first, Alignment) + CopySize > BlockIt->first + BlockIt->second.Size)
+                    continue;
+
+                DefragmentationMove Move;
+                Move.AllocationIndex = AllocIdx;
+                Move.NewAllocation   = AllocateFromBlock(BlockIt, CopySize, Alignment);
+                Move.SrcOffset       = SrcOffset;
+                Move.DstOffset       = AlignUp(Move.NewAllocation.UnalignedOffset, Alignment);
+                Move.CopySize        = CopySize;
+                VERIFY_EXPR(Move.DstOffset + CopySize <= Alloc.UnalignedOffset);
+                Moves.push_back(Move);
+
+                BytesToMove += CopySize;
+                break;
+            }
+        }
+
+        return Moves;
+    }
+
 private:
+    Allocation AllocateFromBlock(TFreeBlocksByOffsetMap::iterator BlockIt, OffsetType Size, OffsetType Alignment)
+    {
+        //        BlockIt.Offset
+        //        |                                  |
+        //        |<-----------BlockIt.Size--------->|
+        //        |<--AdjustedSize-->|<---NewSize--->|
+        //        |                  |
+        //      Offset              NewOffset
+        //
+        auto Offset = BlockIt->first;
+        VERIFY_EXPR(Offset % m_CurrAlignment == 0);
+        auto AlignedOffset = AlignUp(Offset, Alignment);
+        auto AdjustedSize  = Size + (AlignedOffset - Offset);
+        VERIFY_EXPR(AdjustedSize <= BlockIt->second.Size);
+        auto NewOffset = Offset + AdjustedSize;
+        auto NewSize   = BlockIt->second.Size - AdjustedSize;
+        m_FreeBlocksBySize.erase(BlockIt->second.OrderBySizeIt);
+        m_FreeBlocksByOffset.erase(BlockIt);
+        if (NewSize > 0)
+        {
+            AddNewBlock(NewOffset, NewSize);
+        }
+
+        m_FreeSize -= AdjustedSize;
+
+        if ((Size & (m_CurrAlignment - 1)) != 0)
+        {
+            if (IsPowerOfTwo(Size))
+            {
+                VERIFY_EXPR(Size >= Alignment && Size < m_CurrAlignment);
+                m_CurrAlignment = Size;
+            }
+            else
+            {
+                m_CurrAlignment = (std::min)(m_CurrAlignment, Alignment);
+            }
+        }
+
+#ifdef DILIGENT_DEBUG
+        VERIFY_EXPR(m_FreeBlocksByOffset.size() == m_FreeBlocksBySize.size());
+        if (!m_DbgDisableDebugValidation)
+            DbgVerifyList();
+#endif
+        return Allocation{Offset, AdjustedSize};
+    }
+
     void AddNewBlock(OffsetType Offset, OffsetType Size)
     {
         auto NewBlockIt = m_FreeBlocksByOffset.emplace(Offset, Size);
@@ -33,13 +33,21 @@
 
 #include <deque>
 #include "VariableSizeAllocationsManager.hpp"
+#include "TLSFAllocationsManager.hpp"
 
 namespace Diligent
 {
 // Class extends basic variable-size memory block allocator by deferring deallocation
-// of freed blocks until the corresponding frame is completed
-class VariableSizeGPUAllocationsManager : public VariableSizeAllocationsManager
+// of freed blocks until the corresponding frame is completed.
+// AllocationsManagerType is the underlying free block manager (VariableSizeAllocationsManager
+// or TLSFAllocationsManager).
+template <typename AllocationsManagerType>
+class GPUAllocationsManager : public AllocationsManagerType
 {
+public:
+    using OffsetType = typename AllocationsManagerType::OffsetType;
+    using Allocation = typename AllocationsManagerType::Allocation;
+
 private:
     struct StaleAllocationAttribs
     {
@@ -52,20 +60,20 @@ private:
     };
 
 public:
-    VariableSizeGPUAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
-        VariableSizeAllocationsManager{MaxSize, Allocator},
+    GPUAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
+        AllocationsManagerType{MaxSize, Allocator},
         m_StaleAllocations{0, StaleAllocationAttribs(0, 0, 0), STD_ALLOCATOR_RAW_MEM(StaleAllocationAttribs, Allocator, "Allocator for deque<StaleAllocationAttribs>")}
     {}
 
-    ~VariableSizeGPUAllocationsManager()
+    ~GPUAllocationsManager()
     {
         VERIFY(m_StaleAllocations.empty(), "Not all stale allocations released");
         VERIFY(m_StaleAllocationsSize == 0, "Not all stale allocations released");
     }
 
     // = default causes compiler error when instantiating std::vector::emplace_back() in Visual Studio 2015 (Version 14.0.23107.0 D14REL)
-    VariableSizeGPUAllocationsManager(VariableSizeGPUAllocationsManager&& rhs) noexcept :
-        VariableSizeAllocationsManager(std::move(rhs)),
+    GPUAllocationsManager(GPUAllocationsManager&& rhs) noexcept :
+        AllocationsManagerType(std::move(rhs)),
         m_StaleAllocations(std::move(rhs.m_StaleAllocations)),
         m_StaleAllocationsSize(rhs.m_StaleAllocationsSize)
     {
@@ -73,15 +81,15 @@ public:
     }
 
     // clang-format off
-	VariableSizeGPUAllocationsManager& operator = (VariableSizeGPUAllocationsManager&& rhs) = delete;
-    VariableSizeGPUAllocationsManager(const VariableSizeGPUAllocationsManager&) = delete;
-    VariableSizeGPUAllocationsManager& operator = (const VariableSizeGPUAllocationsManager&) = delete;
+    GPUAllocationsManager& operator = (GPUAllocationsManager&& rhs) = delete;
+    GPUAllocationsManager(const GPUAllocationsManager&) = delete;
+    GPUAllocationsManager& operator = (const GPUAllocationsManager&) = delete;
     // clang-format on
 
-    void Free(VariableSizeAllocationsManager::Allocation&& allocation, Uint64 FenceValue)
+    void Free(Allocation&& allocation, Uint64 FenceValue)
     {
         Free(allocation.UnalignedOffset, allocation.Size, FenceValue);
-        allocation = VariableSizeAllocationsManager::Allocation{};
+        allocation = Allocation{};
     }
 
     void Free(OffsetType Offset, OffsetType Size, Uint64 FenceValue)
@@ -102,7 +110,7 @@ public:
         while (!m_StaleAllocations.empty() && m_StaleAllocations.front().FenceValue <= LastCompletedFenceValue)
         {
             auto& OldestAllocation = m_StaleAllocations.front();
-            VariableSizeAllocationsManager::Free(OldestAllocation.Offset, OldestAllocation.Size);
+            AllocationsManagerType::Free(OldestAllocation.Offset, OldestAllocation.Size);
             m_StaleAllocationsSize -= OldestAllocation.Size;
             m_StaleAllocations.pop_front();
         }
@@ -114,4 +122,8 @@ private:
     std::deque<StaleAllocationAttribs, STDAllocatorRawMem<StaleAllocationAttribs>> m_StaleAllocations;
     size_t                                                                         m_StaleAllocationsSize = 0;
 };
+
+using VariableSizeGPUAllocationsManager = GPUAllocationsManager<VariableSizeAllocationsManager>;
+using TLSFGPUAllocationsManager         = GPUAllocationsManager<TLSFAllocationsManager>;
+
 } // namespace Diligent
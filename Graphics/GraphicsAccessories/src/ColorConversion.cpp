@@ -28,6 +28,8 @@
 #include <array>
 #include <algorithm>
 #include "ColorConversion.h"
+#include "BasicMathSIMD.hpp"
+#include "DebugUtilities.hpp"
 
 namespace Diligent
 {
@@ -75,18 +77,226 @@ private:
     std::array<float, 256> m_ToLinear;
 };
 
+// Converts linear values to the nearest 8-bit gamma codes
+class LinearToGamma8Map
+{
+public:
+    LinearToGamma8Map() noexcept
+    {
+        // Linear values at the midpoints between adjacent gamma codes. The last
+        // threshold is never reached and removes the range check in operator().
+        for (Uint32 i = 0; i < m_Thresholds.size(); ++i)
+            m_Thresholds[i] = i < 255 ? GammaToLinear((static_cast<float>(i) + 0.5f) / 255.f) : 2.f;
+
+        // The first code of every bucket. The smallest distance between the thresholds
+        // (~3e-4 near zero) is greater than the bucket size, so every bucket contains
+        // at most one threshold and a single comparison finds the exact code.
+        Uint32 Code = 0;
+        for (Uint32 i = 0; i < m_BucketStart.size(); ++i)
+        {
+            const float BucketMin = static_cast<float>(i) / NumBuckets;
+            while (m_Thresholds[Code] < BucketMin)
+                ++Code;
+            m_BucketStart[i] = static_cast<Uint8>(Code);
+            VERIFY_EXPR(Code == 255 || i == NumBuckets || m_Thresholds[Code + 1] >= static_cast<float>(i + 1) / NumBuckets);
+        }
+    }
+
+    // Linear must be in [0, 1], Bucket must be Linear * NumBuckets rounded down
+    Uint8 operator()(float Linear, Uint32 Bucket) const
+    {
+        const Uint32 Code = m_BucketStart[Bucket];
+        return static_cast<Uint8>(Code + (Linear >= m_Thresholds[Code] ? 1 : 0));
+    }
+
+    static constexpr Uint32 NumBuckets = 4096;
+
+private:
+    std::array<float, 256>            m_Thresholds;
+    std::array<Uint8, NumBuckets + 1> m_BucketStart;
+};
+
+const LinearToGammaMap& GetLinearToGammaMap()
+{
+    static const LinearToGammaMap map;
+    return map;
+}
+
+const GammaToLinearMap& GetGammaToLinearMap()
+{
+    static const GammaToLinearMap map;
+    return map;
+}
+
+const LinearToGamma8Map& GetLinearToGamma8Map()
+{
+    static const LinearToGamma8Map map;
+    return map;
+}
+
+using namespace MathSIMD;
+
+// Clamps the values to [0, 1], NaN is mapped to 0
+inline VecF4 SaturateF4(VecF4 v)
+{
+    return SelectF4(CmpGtF4(v, SetF4(0.f)), MinF4(v, SetF4(1.f)), SetF4(0.f));
+}
+
+inline float Saturate(float v)
+{
+    return v > 0.f ? (v < 1.f ? v : 1.f) : 0.f;
+}
+
+// Evaluates c[0] + c[1] * x + ... + c[N-1] * x^(N-1) using Horner's scheme
+template <size_t N>
+inline VecF4 EvalPolynomialF4(VecF4 x, const float (&c)[N])
+{
+    VecF4 r = SetF4(c[N - 1]);
+    for (size_t i = N - 1; i > 0; --i)
+        r = AddF4(MulF4(r, x), SetF4(c[i - 1]));
+    return r;
+}
+
+inline VecF4 GammaToLinearF4(VecF4 x)
+{
+    // For x > 0.04045, ((x + 0.055) / 1.055)^2.4 = y^2 * y^0.4, where y^0.4 = sqrt(y)^0.8
+    // is approximated by a polynomial of sqrt(y) in [0.301, 1] with the minimax relative error.
+    static constexpr float Pow0_8Coeffs[] = {0.031182409f, 1.38846308f, -1.04094945f, 1.32141213f, -1.15461312f, 0.579628949f, -0.12512634f};
+
+    const VecF4 y      = MulF4(AddF4(x, SetF4(0.055f)), SetF4(1.f / 1.055f));
+    const VecF4 Pow0_4 = EvalPolynomialF4(SqrtF4(y), Pow0_8Coeffs);
+    return SelectF4(CmpLeF4(x, SetF4(0.04045f)), MulF4(x, SetF4(1.f / 12.92f)), MulF4(MulF4(y, y), Pow0_4));
+}
+
+inline VecF4 LinearToGammaF4(VecF4 x)
+{
+    // For x > 0.0031308, 1.055 * x^(1/2.4) - 0.055 is approximated by a minimax
+    // polynomial of x^(1/4) in [0.2365, 1].
+    static constexpr float GammaCoeffs[] = {-0.061340216f, 0.16202626f, 1.2554045f, -0.57748284f, 0.28953312f, -0.068147350f};
+
+    const VecF4 Gamma = EvalPolynomialF4(SqrtF4(SqrtF4(MaxF4(x, SetF4(0.f)))), GammaCoeffs);
+    return SelectF4(CmpLeF4(x, SetF4(0.0031308f)), MulF4(x, SetF4(12.92f)), Gamma);
+}
+
+// Applies ConvertF4 to the values in [0, 1] and ConvertScalar to all other values
+template <typename ConvertF4Type, typename ConvertScalarType>
+void ConvertFloats(const float* pSrc, float* pDst, size_t Count, ConvertF4Type ConvertF4, ConvertScalarType ConvertScalar)
+{
+    size_t i = 0;
+    for (; i + 4 <= Count; i += 4)
+    {
+        const VecF4 v = LoadF4(pSrc + i);
+        StoreF4(pDst + i, ConvertF4(v));
+
+        // Note that NaN fails both comparisons
+        const int InRange = MoveMaskF4(AndMaskF4(CmpGeF4(v, SetF4(0.f)), CmpLeF4(v, SetF4(1.f))));
+        if (InRange != 0xF)
+        {
+            for (size_t j = 0; j < 4; ++j)
+            {
+                if ((InRange & (1 << j)) == 0)
+                    pDst[i + j] = ConvertScalar(pSrc[i + j]);
+            }
+        }
+    }
+    if (i < Count)
+    {
+        // Process the tail the same way to get identical results
+        float Tail[4] = {};
+        std::copy(pSrc + i, pSrc + Count, Tail);
+        StoreF4(Tail, ConvertF4(LoadF4(Tail)));
+        for (size_t j = 0; i + j < Count; ++j)
+            pDst[i + j] = (pSrc[i + j] >= 0.f && pSrc[i + j] <= 1.f) ? Tail[j] : ConvertScalar(pSrc[i + j]);
+    }
+}
+
 } // namespace
 
 float LinearToGamma(Uint8 x)
 {
-    static const LinearToGammaMap map;
-    return map[x];
+    return GetLinearToGammaMap()[x];
 }
 
 float GammaToLinear(Uint8 x)
 {
-    static const GammaToLinearMap map;
-    return map[x];
+    return GetGammaToLinearMap()[x];
+}
+
+void GammaToLinear(const Uint8* pGamma, float* pLinear, size_t Count)
+{
+    const GammaToLinearMap& Map = GetGammaToLinearMap();
+    for (size_t i = 0; i < Count; ++i)
+        pLinear[i] = Map[pGamma[i]];
+}
+
+void LinearToGamma(const float* pLinear, Uint8* pGamma, size_t Count)
+{
+    const LinearToGamma8Map& Map        = GetLinearToGamma8Map();
+    const VecF4              NumBuckets = SetF4(static_cast<float>(LinearToGamma8Map::NumBuckets));
+
+    float  Values[4];
+    int    Buckets[4];
+    size_t i = 0;
+    for (; i + 4 <= Count; i += 4)
+    {
+        const VecF4 v = SaturateF4(LoadF4(pLinear + i));
+        StoreF4(Values, v);
+        StoreI4(Buckets, MulF4(v, NumBuckets));
+        for (size_t j = 0; j < 4; ++j)
+            pGamma[i + j] = Map(Values[j], static_cast<Uint32>(Buckets[j]));
+    }
+    for (; i < Count; ++i)
+    {
+        const float v = Saturate(pLinear[i]);
+        pGamma[i]     = Map(v, static_cast<Uint32>(v * LinearToGamma8Map::NumBuckets));
+    }
+}
+
+void GammaToLinear(const float* pGamma, float* pLinear, size_t Count)
+{
+    ConvertFloats(pGamma, pLinear, Count, GammaToLinearF4, static_cast<float (*)(float)>(GammaToLinear));
+}
+
+void LinearToGamma(const float* pLinear, float* pGamma, size_t Count)
+{
+    ConvertFloats(pLinear, pGamma, Count, LinearToGammaF4, static_cast<float (*)(float)>(LinearToGamma));
+}
+
+void SRGBA8ToLinear(const Uint8* pSRGBA, float* pLinearRGBA, size_t NumTexels)
+{
+    const GammaToLinearMap& Map = GetGammaToLinearMap();
+    for (size_t i = 0; i < NumTexels * 4; i += 4)
+    {
+        pLinearRGBA[i + 0] = Map[pSRGBA[i + 0]];
+        pLinearRGBA[i + 1] = Map[pSRGBA[i + 1]];
+        pLinearRGBA[i + 2] = Map[pSRGBA[i + 2]];
+        pLinearRGBA[i + 3] = static_cast<float>(pSRGBA[i + 3]) / 255.f;
+    }
+}
+
+void LinearToSRGBA8(const float* pLinearRGBA, Uint8* pSRGBA, size_t NumTexels)
+{
+    const LinearToGamma8Map& Map = GetLinearToGamma8Map();
+
+    // Color channels are converted to the table buckets, alpha is quantized with rounding to the nearest
+    const VecF4 Scale = SetF4(static_cast<float>(LinearToGamma8Map::NumBuckets),
+                              static_cast<float>(LinearToGamma8Map::NumBuckets),
+                              static_cast<float>(LinearToGamma8Map::NumBuckets),
+                              255.f);
+    const VecF4 Bias  = SetF4(0.f, 0.f, 0.f, 0.5f);
+
+    float Values[4];
+    int   Buckets[4];
+    for (size_t i = 0; i < NumTexels * 4; i += 4)
+    {
+        const VecF4 v = SaturateF4(LoadF4(pLinearRGBA + i));
+        StoreF4(Values, v);
+        StoreI4(Buckets, AddF4(MulF4(v, Scale), Bias));
+        pSRGBA[i + 0] = Map(Values[0], static_cast<Uint32>(Buckets[0]));
+        pSRGBA[i + 1] = Map(Values[1], static_cast<Uint32>(Buckets[1]));
+        pSRGBA[i + 2] = Map(Values[2], static_cast<Uint32>(Buckets[2]));
+        pSRGBA[i + 3] = static_cast<Uint8>(Buckets[3]);
+    }
 }
 
 } // namespace Diligent
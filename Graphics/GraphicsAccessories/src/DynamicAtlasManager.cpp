@@ -28,6 +28,8 @@
 #include "DynamicAtlasManager.hpp"
 
 #include <climits>
+#include <algorithm>
+#include <vector>
 
 #include "AdvancedMath.hpp"
 
@@ -110,9 +112,10 @@ void DynamicAtlasManager::Node::MergeChildren()
 }
 
 
-DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height) :
+DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height, PackingStrategy Strategy) :
     m_Width{Width},
     m_Height{Height},
+    m_Strategy{Strategy},
     m_TotalFreeArea{Uint64{Width} * Uint64{Height}}
 {
     m_Root->R = Region{0, 0, Width, Height};
@@ -182,7 +185,7 @@ void DynamicAtlasManager::UnregisterNode(const Node& N)
 
 
 
-DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 Height)
+DynamicAtlasManager::Node* DynamicAtlasManager::FindBestAreaFit(Uint32 Width, Uint32 Height) const
 {
     auto it_w = m_FreeRegionsByWidth.lower_bound(Region{0, 0, Width, 0});
     while (it_w != m_FreeRegionsByWidth.end() && it_w->first.height < Height)
@@ -199,31 +202,134 @@ DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 H
     VERIFY_EXPR(AreaW == 0 || AreaW >= Width * Height);
     VERIFY_EXPR(AreaH == 0 || AreaH >= Width * Height);
 
-    Node* pSrcNode = nullptr;
     // Use the smaller area source region
     if (AreaW > 0 && AreaH > 0)
     {
-        pSrcNode = AreaW < AreaH ? it_w->second : it_h->second;
+        return AreaW < AreaH ? it_w->second : it_h->second;
     }
     else if (AreaW > 0)
     {
-        pSrcNode = it_w->second;
+        return it_w->second;
     }
     else if (AreaH > 0)
     {
-        pSrcNode = it_h->second;
+        return it_h->second;
     }
     else
     {
-        return Region{};
+        return nullptr;
+    }
+}
+
+DynamicAtlasManager::Node* DynamicAtlasManager::FindBestShortSideFit(Uint32 Width, Uint32 Height) const
+{
+    Node*  pBestNode     = nullptr;
+    Uint32 BestShortSide = UINT_MAX;
+    Uint32 BestLongSide  = UINT_MAX;
+    auto   ProcessRegion = [&](const Region& R, Node* pNode) {
+        if (R.width < Width || R.height < Height)
+            return;
+
+        const auto LeftoverW = R.width - Width;
+        const auto LeftoverH = R.height - Height;
+        const auto ShortSide = std::min(LeftoverW, LeftoverH);
+        const auto LongSide  = std::max(LeftoverW, LeftoverH);
+        if (ShortSide < BestShortSide || (ShortSide == BestShortSide && LongSide < BestLongSide))
+        {
+            pBestNode     = pNode;
+            BestShortSide = ShortSide;
+            BestLongSide  = LongSide;
+        }
+    };
+
+    // A region can only improve the current best fit if either its leftover width or its leftover
+    // height does not exceed the best short side, so both maps only need to be scanned up to that bound.
+    for (auto it = m_FreeRegionsByWidth.lower_bound(Region{0, 0, Width, 0});
+         it != m_FreeRegionsByWidth.end() && it->first.width - Width <= BestShortSide; ++it)
+    {
+        ProcessRegion(it->first, it->second);
     }
+    for (auto it = m_FreeRegionsByHeight.lower_bound(Region{0, 0, 0, Height});
+         it != m_FreeRegionsByHeight.end() && it->first.height - Height <= BestShortSide; ++it)
+    {
+        ProcessRegion(it->first, it->second);
+    }
+
+    return pBestNode;
+}
+
+DynamicAtlasManager::Node* DynamicAtlasManager::FindBottomLeft(Uint32 Width, Uint32 Height) const
+{
+    Node*  pBestNode = nullptr;
+    Uint32 BestTop   = UINT_MAX;
+    Uint32 BestX     = UINT_MAX;
+    for (auto it = m_FreeRegionsByWidth.lower_bound(Region{0, 0, Width, 0}); it != m_FreeRegionsByWidth.end(); ++it)
+    {
+        const auto& R = it->first;
+        if (R.height < Height)
+            continue;
+
+        const auto Top = R.y + Height;
+        if (Top < BestTop || (Top == BestTop && R.x < BestX))
+        {
+            pBestNode = it->second;
+            BestTop   = Top;
+            BestX     = R.x;
+        }
+    }
+    return pBestNode;
+}
+
+DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 Height)
+{
+    Node* pSrcNode = nullptr;
+    switch (m_Strategy)
+    {
+        case PackingStrategy::BestAreaFit:
+            pSrcNode = FindBestAreaFit(Width, Height);
+            break;
+
+        case PackingStrategy::BestShortSideFit:
+            pSrcNode = FindBestShortSideFit(Width, Height);
+            break;
+
+        case PackingStrategy::BottomLeft:
+            pSrcNode = FindBottomLeft(Width, Height);
+            break;
+
+        default:
+            UNEXPECTED("Unexpected packing strategy");
+    }
+    if (pSrcNode == nullptr)
+        return Region{};
 
     UnregisterNode(*pSrcNode);
 
     auto R = pSrcNode->R;
     if (R.width > Width && R.height > Height)
     {
-        if (R.width > R.height)
+        bool SplitVertically = false;
+        switch (m_Strategy)
+        {
+            case PackingStrategy::BestAreaFit:
+                // Split along the longer side of the source region
+                SplitVertically = R.width > R.height;
+                break;
+
+            case PackingStrategy::BestShortSideFit:
+                // Split along the shorter leftover axis so that the larger leftover region stays as large as possible
+                SplitVertically = R.width - Width > R.height - Height;
+                break;
+
+            case PackingStrategy::BottomLeft:
+                SplitVertically = false;
+                break;
+
+            default:
+                UNEXPECTED("Unexpected packing strategy");
+        }
+
+        if (SplitVertically)
         {
             //    _____________________
             //   |       |             |
@@ -327,6 +433,41 @@ DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 H
 }
 
 
+Uint32 DynamicAtlasManager::Allocate(Region* pRegions, Uint32 NumRegions)
+{
+    if (NumRegions == 0)
+        return 0;
+    DEV_CHECK_ERR(pRegions != nullptr, "pRegions must not be null");
+
+    // Place large regions first and fill the gaps with smaller ones
+    std::vector<Uint32> Order(NumRegions);
+    for (Uint32 i = 0; i < NumRegions; ++i)
+        Order[i] = i;
+    std::stable_sort(Order.begin(), Order.end(),
+                     [pRegions](Uint32 i0, Uint32 i1) {
+                         const auto& R0 = pRegions[i0];
+                         const auto& R1 = pRegions[i1];
+
+                         const auto LongSide0 = std::max(R0.width, R0.height);
+                         const auto LongSide1 = std::max(R1.width, R1.height);
+                         if (LongSide0 != LongSide1)
+                             return LongSide0 > LongSide1;
+                         return std::min(R0.width, R0.height) > std::min(R1.width, R1.height);
+                     });
+
+    Uint32 NumAllocated = 0;
+    for (auto Idx : Order)
+    {
+        auto& R = pRegions[Idx];
+        R       = !R.IsEmpty() ? Allocate(R.width, R.height) : Region{};
+        if (!R.IsEmpty())
+            ++NumAllocated;
+    }
+
+    return NumAllocated;
+}
+
+
 void DynamicAtlasManager::Free(Region&& R)
 {
 #if DILIGENT_DEBUG
@@ -0,0 +1,949 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TextureFormatConverter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "GraphicsAccessories.hpp"
+#include "ColorConversion.h"
+#include "Float16.hpp"
+#include "BasicMathSIMD.hpp"
+#include "ThreadPool.hpp"
+#include "DebugUtilities.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+using namespace MathSIMD;
+
+// The number of texels processed by a single parallel task
+constexpr Uint32 ParallelChunkSize = 1u << 16;
+
+enum class ComponentEncoding : Uint8
+{
+    Unknown,
+    UNorm,
+    SNorm,
+    SRGB,
+    Float,
+    UInt,
+    SInt,
+    RGB10A2_UNorm,
+    RGB10A2_UInt,
+    R11G11B10_Float,
+    RGB9E5_SharedExp,
+    B5G6R5_UNorm,
+    B5G5R5A1_UNorm,
+};
+
+struct FormatLayout
+{
+    ComponentEncoding Encoding = ComponentEncoding::Unknown;
+
+    // Component size in bytes. For packed formats, this is the texel size.
+    Uint32 ComponentSize = 0;
+
+    // The number of components in memory. Packed formats have a single component.
+    Uint32 NumComponents = 0;
+
+    // Component i in memory holds channel Swizzle[i] (0 - R, 1 - G, 2 - B, 3 - A).
+    std::array<Uint8, 4> Swizzle = {0, 1, 2, 3};
+
+    // If true, the alpha component is ignored when reading and is set to the maximum value when writing (BGRX formats).
+    bool IgnoreAlpha = false;
+
+    bool IsSupported() const { return Encoding != ComponentEncoding::Unknown; }
+
+    bool IsInteger() const
+    {
+        return Encoding == ComponentEncoding::UInt || Encoding == ComponentEncoding::SInt || Encoding == ComponentEncoding::RGB10A2_UInt;
+    }
+
+    bool IsPacked() const
+    {
+        return Encoding >= ComponentEncoding::RGB10A2_UNorm;
+    }
+
+    // Returns true if the components can be read to and written from RGBA values directly
+    bool IsRGBA() const
+    {
+        return NumComponents == 4 && Swizzle[0] == 0 && Swizzle[1] == 1 && Swizzle[2] == 2 && Swizzle[3] == 3 && !IgnoreAlpha;
+    }
+};
+
+FormatLayout GetFormatLayout(TEXTURE_FORMAT Format)
+{
+    FormatLayout Layout;
+
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(Format);
+    if (FmtAttribs.IsTypeless)
+        return Layout;
+
+    Layout.ComponentSize = FmtAttribs.ComponentSize;
+    Layout.NumComponents = FmtAttribs.NumComponents;
+    switch (Format)
+    {
+        // clang-format off
+        case TEX_FORMAT_RGB10A2_UNORM:    Layout.Encoding = ComponentEncoding::RGB10A2_UNorm;    return Layout;
+        case TEX_FORMAT_RGB10A2_UINT:     Layout.Encoding = ComponentEncoding::RGB10A2_UInt;     return Layout;
+        case TEX_FORMAT_R11G11B10_FLOAT:  Layout.Encoding = ComponentEncoding::R11G11B10_Float;  return Layout;
+        case TEX_FORMAT_RGB9E5_SHAREDEXP: Layout.Encoding = ComponentEncoding::RGB9E5_SharedExp; return Layout;
+        case TEX_FORMAT_B5G6R5_UNORM:     Layout.Encoding = ComponentEncoding::B5G6R5_UNorm;     return Layout;
+        case TEX_FORMAT_B5G5R5A1_UNORM:   Layout.Encoding = ComponentEncoding::B5G5R5A1_UNorm;   return Layout;
+            // clang-format on
+
+        case TEX_FORMAT_R1_UNORM:
+        case TEX_FORMAT_RG8_B8G8_UNORM:
+        case TEX_FORMAT_G8R8_G8B8_UNORM:
+        case TEX_FORMAT_R10G10B10_XR_BIAS_A2_UNORM:
+            return Layout;
+
+        default:
+            break;
+    }
+
+    ComponentEncoding Encoding = ComponentEncoding::Unknown;
+    switch (FmtAttribs.ComponentType)
+    {
+        case COMPONENT_TYPE_UNORM:
+            if (Layout.ComponentSize <= 2)
+                Encoding = ComponentEncoding::UNorm;
+            break;
+
+        case COMPONENT_TYPE_SNORM:
+            if (Layout.ComponentSize <= 2)
+                Encoding = ComponentEncoding::SNorm;
+            break;
+
+        case COMPONENT_TYPE_UNORM_SRGB:
+            if (Layout.ComponentSize == 1)
+                Encoding = ComponentEncoding::SRGB;
+            break;
+
+        case COMPONENT_TYPE_FLOAT:
+            if (Layout.ComponentSize == 2 || Layout.ComponentSize == 4)
+                Encoding = ComponentEncoding::Float;
+            break;
+
+        case COMPONENT_TYPE_UINT:
+            Encoding = ComponentEncoding::UInt;
+            break;
+
+        case COMPONENT_TYPE_SINT:
+            Encoding = ComponentEncoding::SInt;
+            break;
+
+        case COMPONENT_TYPE_DEPTH:
+            // D16_UNORM or D32_FLOAT
+            Encoding = Layout.ComponentSize == 2 ? ComponentEncoding::UNorm : ComponentEncoding::Float;
+            break;
+
+        default:
+            break;
+    }
+    if (Encoding == ComponentEncoding::Unknown)
+        return Layout;
+
+    Layout.Encoding = Encoding;
+    if (Format == TEX_FORMAT_BGRA8_UNORM || Format == TEX_FORMAT_BGRA8_UNORM_SRGB ||
+        Format == TEX_FORMAT_BGRX8_UNORM || Format == TEX_FORMAT_BGRX8_UNORM_SRGB)
+    {
+        Layout.Swizzle     = {2, 1, 0, 3};
+        Layout.IgnoreAlpha = Format == TEX_FORMAT_BGRX8_UNORM || Format == TEX_FORMAT_BGRX8_UNORM_SRGB;
+    }
+    else if (Format == TEX_FORMAT_A8_UNORM)
+    {
+        Layout.Swizzle[0] = 3;
+    }
+
+    return Layout;
+}
+
+template <typename DstType, typename SrcType>
+DstType BitCast(SrcType Src)
+{
+    static_assert(sizeof(DstType) == sizeof(SrcType), "Sizes must match");
+    DstType Dst;
+    std::memcpy(&Dst, &Src, sizeof(Dst));
+    return Dst;
+}
+
+template <typename T>
+void DecodeUNorm(const T* pSrc, size_t Count, float* pDst)
+{
+    constexpr float MaxValue = static_cast<float>(std::numeric_limits<T>::max());
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = static_cast<float>(pSrc[i]) / MaxValue;
+}
+
+template <typename T>
+void DecodeSNorm(const T* pSrc, size_t Count, float* pDst)
+{
+    constexpr float MaxValue = static_cast<float>(std::numeric_limits<T>::max());
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = std::max(static_cast<float>(pSrc[i]) / MaxValue, -1.f);
+}
+
+// Quantizes four values to the [0, Scale] range with rounding to the nearest
+inline void QuantizeUNormF4(VecF4 v, VecF4 Scale, int* pDst)
+{
+    v = MinF4(MaxF4(v, SetF4(0.f)), SetF4(1.f));
+    v = AddF4(MulF4(v, Scale), SetF4(0.5f));
+    StoreI4(pDst, v);
+}
+
+// Quantizes four values to the [-Scale, Scale] range with rounding to the nearest, away from zero
+inline void QuantizeSNormF4(VecF4 v, VecF4 Scale, int* pDst)
+{
+    v = MulF4(MinF4(MaxF4(v, SetF4(-1.f)), SetF4(1.f)), Scale);
+    v = SelectF4(CmpLtF4(v, SetF4(0.f)), SubF4(v, SetF4(0.5f)), AddF4(v, SetF4(0.5f)));
+    StoreI4(pDst, v);
+}
+
+template <typename T, typename QuantizeFuncType>
+void EncodeNorm(const float* pSrc, size_t Count, T* pDst, QuantizeFuncType Quantize)
+{
+    const VecF4 Scale = SetF4(static_cast<float>(std::numeric_limits<T>::max()));
+
+    int    q[4];
+    size_t i = 0;
+    for (; i + 4 <= Count; i += 4)
+    {
+        Quantize(LoadF4(pSrc + i), Scale, q);
+        pDst[i + 0] = static_cast<T>(q[0]);
+        pDst[i + 1] = static_cast<T>(q[1]);
+        pDst[i + 2] = static_cast<T>(q[2]);
+        pDst[i + 3] = static_cast<T>(q[3]);
+    }
+    if (i < Count)
+    {
+        // Process the tail the same way to get identical results
+        float Tail[4] = {};
+        std::copy(pSrc + i, pSrc + Count, Tail);
+        Quantize(LoadF4(Tail), Scale, q);
+        for (size_t j = 0; i + j < Count; ++j)
+            pDst[i + j] = static_cast<T>(q[j]);
+    }
+}
+
+template <typename T>
+void DecodeInt(const T* pSrc, size_t Count, Int64* pDst)
+{
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = static_cast<Int64>(pSrc[i]);
+}
+
+template <typename T>
+void EncodeInt(const Int64* pSrc, size_t Count, T* pDst)
+{
+    constexpr Int64 MinValue = static_cast<Int64>(std::numeric_limits<T>::min());
+    constexpr Int64 MaxValue = static_cast<Int64>(std::numeric_limits<T>::max());
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = static_cast<T>(std::min(std::max(pSrc[i], MinValue), MaxValue));
+}
+
+// Writes the components to the RGBA texels according to the swizzle.
+// The channels that are missing in the format get default values (0, 0, 0, AlphaMax).
+template <typename T>
+void ScatterComponents(const FormatLayout& Layout, const T* pComps, Uint32 Width, T AlphaMax, T* pRGBA)
+{
+    const Uint32 NumComps = Layout.NumComponents;
+    for (Uint32 x = 0; x < Width; ++x)
+    {
+        T Texel[4] = {0, 0, 0, AlphaMax};
+        for (Uint32 c = 0; c < NumComps; ++c)
+        {
+            const Uint32 Channel = Layout.Swizzle[c];
+            if (Channel != 3 || !Layout.IgnoreAlpha)
+                Texel[Channel] = pComps[x * NumComps + c];
+        }
+        std::copy(Texel, Texel + 4, pRGBA + size_t{x} * 4);
+    }
+}
+
+// Reads the components from the RGBA texels according to the swizzle.
+template <typename T>
+void GatherComponents(const FormatLayout& Layout, const T* pRGBA, Uint32 Width, T AlphaMax, T* pComps)
+{
+    const Uint32 NumComps = Layout.NumComponents;
+    for (Uint32 x = 0; x < Width; ++x)
+    {
+        for (Uint32 c = 0; c < NumComps; ++c)
+        {
+            const Uint32 Channel     = Layout.Swizzle[c];
+            pComps[x * NumComps + c] = (Channel == 3 && Layout.IgnoreAlpha) ? AlphaMax : pRGBA[size_t{x} * 4 + Channel];
+        }
+    }
+}
+
+inline Uint32 QuantizeUNorm(float v, float Scale)
+{
+    // Note that NaN is mapped to 0
+    v = v > 0.f ? (v < 1.f ? v : 1.f) : 0.f;
+    return static_cast<Uint32>(v * Scale + 0.5f);
+}
+
+// Converts a 16-bit float to an unsigned float with the given number of mantissa bits (6 for float11, 5 for float10).
+// Negative values are clamped to zero.
+template <Uint32 MantissaBits>
+Uint32 Float16ToUFloat(Uint32 Half)
+{
+    constexpr Uint32 Shift   = 10 - MantissaBits;
+    constexpr Uint32 ExpMask = 0x1Fu << MantissaBits;
+    if (Half & 0x8000u)
+        return 0;
+    if ((Half & 0x7C00u) == 0x7C00u)
+        return (Half & 0x3FFu) != 0 ? (ExpMask | (1u << (MantissaBits - 1))) : ExpMask; // NaN or Inf
+    // Round to the nearest even. Carry to the exponent is handled naturally.
+    const Uint32 Rounded = (Half + (1u << (Shift - 1)) - 1u + ((Half >> Shift) & 1u)) >> Shift;
+    // Clamp finite values to the maximum finite value
+    return std::min(Rounded, ExpMask - 1u);
+}
+
+class RowConverter
+{
+public:
+    RowConverter(const FormatLayout& SrcLayout, const FormatLayout& DstLayout, Uint32 Width) :
+        m_Src{SrcLayout},
+        m_Dst{DstLayout},
+        m_Width{Width}
+    {
+        if (m_Src.IsInteger())
+        {
+            m_IntRGBA.resize(size_t{Width} * 4);
+            m_IntComps.resize(size_t{Width} * 4);
+        }
+        else
+        {
+            m_RGBA.resize(size_t{Width} * 4);
+            m_Comps.resize(size_t{Width} * 4);
+            m_Half.resize(size_t{Width} * 4);
+            m_RGBA8.resize(size_t{Width} * 4);
+        }
+    }
+
+    void operator()(const void* pSrc, void* pDst)
+    {
+        if (m_Src.IsInteger())
+        {
+            DecodeIntRow(pSrc);
+            EncodeIntRow(pDst);
+        }
+        else
+        {
+            DecodeRow(pSrc);
+            EncodeRow(pDst);
+        }
+    }
+
+private:
+    void DecodeRow(const void* pSrc);
+    void EncodeRow(void* pDst);
+    void DecodeIntRow(const void* pSrc);
+    void EncodeIntRow(void* pDst);
+
+    void DecodePackedRow(const void* pSrc);
+    void EncodePackedRow(void* pDst);
+
+private:
+    const FormatLayout& m_Src;
+    const FormatLayout& m_Dst;
+    const Uint32        m_Width;
+
+    std::vector<float>  m_RGBA;
+    std::vector<float>  m_Comps;
+    std::vector<Uint16> m_Half;
+    std::vector<Uint8>  m_RGBA8;
+    std::vector<Int64>  m_IntRGBA;
+    std::vector<Int64>  m_IntComps;
+};
+
+void RowConverter::DecodeRow(const void* pSrc)
+{
+    if (m_Src.IsPacked())
+    {
+        DecodePackedRow(pSrc);
+        return;
+    }
+
+    if (m_Src.Encoding == ComponentEncoding::SRGB)
+    {
+        // All sRGB formats have four 8-bit components
+        VERIFY_EXPR(m_Src.NumComponents == 4);
+        const Uint8* pRGBA8 = static_cast<const Uint8*>(pSrc);
+        if (!m_Src.IsRGBA())
+        {
+            ScatterComponents(m_Src, pRGBA8, m_Width, Uint8{255}, m_RGBA8.data());
+            pRGBA8 = m_RGBA8.data();
+        }
+        SRGBA8ToLinear(pRGBA8, m_RGBA.data(), m_Width);
+        return;
+    }
+
+    const size_t Count  = size_t{m_Width} * m_Src.NumComponents;
+    float*       pComps = m_Src.IsRGBA() ? m_RGBA.data() : m_Comps.data();
+    switch (m_Src.Encoding)
+    {
+        case ComponentEncoding::UNorm:
+            if (m_Src.ComponentSize == 1)
+                DecodeUNorm(static_cast<const Uint8*>(pSrc), Count, pComps);
+            else
+                DecodeUNorm(static_cast<const Uint16*>(pSrc), Count, pComps);
+            break;
+
+        case ComponentEncoding::SNorm:
+            if (m_Src.ComponentSize == 1)
+                DecodeSNorm(static_cast<const Int8*>(pSrc), Count, pComps);
+            else
+                DecodeSNorm(static_cast<const Int16*>(pSrc), Count, pComps);
+            break;
+
+        case ComponentEncoding::Float:
+            if (m_Src.ComponentSize == 2)
+                Float16ToFloat32(static_cast<const Uint16*>(pSrc), pComps, Count);
+            else
+                std::memcpy(pComps, pSrc, Count * sizeof(float));
+            break;
+
+        default:
+            UNEXPECTED("Unexpected component encoding");
+    }
+
+    if (pComps != m_RGBA.data())
+        ScatterComponents(m_Src, pComps, m_Width, 1.f, m_RGBA.data());
+}
+
+void RowConverter::EncodeRow(void* pDst)
+{
+    if (m_Dst.IsPacked())
+    {
+        EncodePackedRow(pDst);
+        return;
+    }
+
+    if (m_Dst.Encoding == ComponentEncoding::SRGB)
+    {
+        VERIFY_EXPR(m_Dst.NumComponents == 4);
+        if (m_Dst.IsRGBA())
+        {
+            LinearToSRGBA8(m_RGBA.data(), static_cast<Uint8*>(pDst), m_Width);
+        }
+        else
+        {
+            LinearToSRGBA8(m_RGBA.data(), m_RGBA8.data(), m_Width);
+            GatherComponents(m_Dst, m_RGBA8.data(), m_Width, Uint8{255}, static_cast<Uint8*>(pDst));
+        }
+        return;
+    }
+
+    const size_t Count  = size_t{m_Width} * m_Dst.NumComponents;
+    const float* pComps = m_RGBA.data();
+    if (!m_Dst.IsRGBA())
+    {
+        GatherComponents(m_Dst, m_RGBA.data(), m_Width, 1.f, m_Comps.data());
+        pComps = m_Comps.data();
+    }
+
+    switch (m_Dst.Encoding)
+    {
+        case ComponentEncoding::UNorm:
+            if (m_Dst.ComponentSize == 1)
+                EncodeNorm(pComps, Count, static_cast<Uint8*>(pDst), QuantizeUNormF4);
+            else
+                EncodeNorm(pComps, Count, static_cast<Uint16*>(pDst), QuantizeUNormF4);
+            break;
+
+        case ComponentEncoding::SNorm:
+            if (m_Dst.ComponentSize == 1)
+                EncodeNorm(pComps, Count, static_cast<Int8*>(pDst), QuantizeSNormF4);
+            else
+                EncodeNorm(pComps, Count, static_cast<Int16*>(pDst), QuantizeSNormF4);
+            break;
+
+        case ComponentEncoding::Float:
+            if (m_Dst.ComponentSize == 2)
+                Float32ToFloat16(pComps, static_cast<Uint16*>(pDst), Count);
+            else
+                std::memcpy(pDst, pComps, Count * sizeof(float));
+            break;
+
+        default:
+            UNEXPECTED("Unexpected component encoding");
+    }
+}
+
+void RowConverter::DecodePackedRow(const void* pSrc)
+{
+    float* pRGBA = m_RGBA.data();
+    switch (m_Src.Encoding)
+    {
+        case ComponentEncoding::RGB10A2_UNorm:
+        {
+            const Uint32* pTexels = static_cast<const Uint32*>(pSrc);
+            const VecF4   Scale   = SetF4(1.f / 1023.f, 1.f / 1023.f, 1.f / 1023.f, 1.f / 3.f);
+            for (Uint32 x = 0; x < m_Width; ++x)
+            {
+                const Uint32 v = pTexels[x];
+                const VecF4  c = SetF4(static_cast<float>(v & 0x3FFu), static_cast<float>((v >> 10u) & 0x3FFu), static_cast<float>((v >> 20u) & 0x3FFu), static_cast<float>(v >> 30u));
+                StoreF4(pRGBA + size_t{x} * 4, MulF4(c, Scale));
+            }
+            break;
+        }
+
+        case ComponentEncoding::R11G11B10_Float:
+        {
+            // Float11 and float10 are 16-bit floats with fewer mantissa bits and no sign,
+            // so the values are expanded to 16-bit floats and converted in bulk.
+            const Uint32* pTexels = static_cast<const Uint32*>(pSrc);
+            Uint16*       pHalf   = m_Half.data();
+            for (Uint32 x = 0; x < m_Width; ++x)
+            {
+                const Uint32 v   = pTexels[x];
+                pHalf[x * 4 + 0] = static_cast<Uint16>((v & 0x7FFu) << 4u);
+                pHalf[x * 4 + 1] = static_cast<Uint16>(((v >> 11u) & 0x7FFu) << 4u);
+                pHalf[x * 4 + 2] = static_cast<Uint16>(((v >> 22u) & 0x3FFu) << 5u);
+                pHalf[x * 4 + 3] = 0x3C00u; // 1.0
+            }
+            Float16ToFloat32(pHalf, pRGBA, size_t{m_Width} * 4);
+            break;
+        }
+
+        case ComponentEncoding::RGB9E5_SharedExp:
+        {
+            const Uint32* pTexels = static_cast<const Uint32*>(pSrc);
+            for (Uint32 x = 0; x < m_Width; ++x)
+            {
+                const Uint32 v = pTexels[x];
+                // 2^(Exp - 15 - 9)
+                const float Scale = BitCast<float>(((v >> 27u) + 127u - 24u) << 23u);
+                const VecF4 c     = SetF4(static_cast<float>(v & 0x1FFu), static_cast<float>((v >> 9u) & 0x1FFu), static_cast<float>((v >> 18u) & 0x1FFu), 0.f);
+                StoreF4(pRGBA + size_t{x} * 4, MulF4(c, SetF4(Scale)));
+                pRGBA[x * 4 + 3] = 1.f;
+            }
+            break;
+        }
+
+        case ComponentEncoding::B5G6R5_UNorm:
+        {
+            const Uint16* pTexels = static_cast<const Uint16*>(pSrc);
+            const VecF4   Scale   = SetF4(1.f / 31.f, 1.f / 63.f, 1.f / 31.f, 1.f);
+            for (Uint32 x = 0; x < m_Width; ++x)
+            {
+                const Uint32 v = pTexels[x];
+                const VecF4  c = SetF4(static_cast<float>(v >> 11u), static_cast<float>((v >> 5u) & 0x3Fu), static_cast<float>(v & 0x1Fu), 1.f);
+                StoreF4(pRGBA + size_t{x} * 4, MulF4(c, Scale));
+            }
+            break;
+        }
+
+        case ComponentEncoding::B5G5R5A1_UNorm:
+        {
+            const Uint16* pTexels = static_cast<const Uint16*>(pSrc);
+            const VecF4   Scale   = SetF4(1.f / 31.f, 1.f / 31.f, 1.f / 31.f, 1.f);
+            for (Uint32 x = 0; x < m_Width; ++x)
+            {
+                const Uint32 v = pTexels[x];
+                const VecF4  c = SetF4(static_cast<float>((v >> 10u) & 0x1Fu), static_cast<float>((v >> 5u) & 0x1Fu), static_cast<float>(v & 0x1Fu), static_cast<float>(v >> 15u));
+                StoreF4(pRGBA + size_t{x} * 4, MulF4(c, Scale));
+            }
+            break;
+        }
+
+        default:
+            UNEXPECTED("Unexpected packed format encoding");
+    }
+}
+
+void RowConverter::EncodePackedRow(void* pDst)
+{
+    const float* pRGBA = m_RGBA.data();
+    switch (m_Dst.Encoding)
+    {
+        case ComponentEncoding::RGB10A2_UNorm:
+        {
+            Uint32*     pTexels = static_cast<Uint32*>(pDst);
+            const VecF4 Scale   = SetF4(1023.f, 1023.f, 1023.f, 3.f);
+            for (Uint32 x = 0; x < m_Width; ++x)
+            {
+                int q[4];
+                QuantizeUNormF4(LoadF4(pRGBA + size_t{x} * 4), Scale, q);
+                pTexels[x] = static_cast<Uint32>(q[0]) | (static_cast<Uint32>(q[1]) << 10u) | (static_cast<Uint32>(q[2]) << 20u) | (static_cast<Uint32>(q[3]) << 30u);
+            }
+            break;
+        }
+
+        case ComponentEncoding::R11G11B10_Float:
+        {
+            Uint32* pTexels = static_cast<Uint32*>(pDst);
+            Uint16* pHalf   = m_Half.data();
+            Float32ToFloat16(pRGBA, pHalf, size_t{m_Width} * 4);
+            for (Uint32 x = 0; x < m_Width; ++x)
+            {
+                pTexels[x] = Float16ToUFloat<6>(pHalf[x * 4 + 0]) |
+                    (Float16ToUFloat<6>(pHalf[x * 4 + 1]) << 11u) |
+                    (Float16ToUFloat<5>(pHalf[x * 4 + 2]) << 22u);
+            }
+            break;
+        }
+
+        case ComponentEncoding::RGB9E5_SharedExp:
+        {
+            constexpr float MaxValue = static_cast<float>(0x1FFu << 7u);    // 511/512 * 2^16
+            constexpr float MinValue = 1.f / static_cast<float>(1u << 16u); // 2^-16
+
+            Uint32* pTexels = static_cast<Uint32*>(pDst);
+            for (Uint32 x = 0; x < m_Width; ++x)
+            {
+                float rgb[3];
+                for (Uint32 c = 0; c < 3; ++c)
+                {
+                    // Note that NaN is mapped to 0
+                    const float v = pRGBA[x * 4 + c];
+                    rgb[c]        = v > 0.f ? (v < MaxValue ? v : MaxValue) : 0.f;
+                }
+                const float MaxComp = std::max(std::max(std::max(rgb[0], rgb[1]), rgb[2]), MinValue);
+
+                // Round the maximum component to 9 mantissa bits (including the implicit one)
+                // to compute the shared exponent.
+                const Uint32 Exp = (BitCast<Uint32>(MaxComp) + 0x4000u) >> 23u;
+                // 2^(135 - Exp), which maps the maximum component to [256, 512)
+                const float Scale = BitCast<float>((262u - Exp) << 23u);
+
+                Uint32 Texel = (Exp - 111u) << 27u;
+                for (Uint32 c = 0; c < 3; ++c)
+                    Texel |= std::min(static_cast<Uint32>(rgb[c] * Scale + 0.5f), 0x1FFu) << (c * 9u);
+                pTexels[x] = Texel;
+            }
+            break;
+        }
+
+        case ComponentEncoding::B5G6R5_UNorm:
+        {
+            Uint16*     pTexels = static_cast<Uint16*>(pDst);
+            const VecF4 Scale   = SetF4(31.f, 63.f, 31.f, 0.f);
+            for (Uint32 x = 0; x < m_Width; ++x)
+            {
+                int q[4];
+                QuantizeUNormF4(LoadF4(pRGBA + size_t{x} * 4), Scale, q);
+                pTexels[x] = static_cast<Uint16>((q[0] << 11) | (q[1] << 5) | q[2]);
+            }
+            break;
+        }
+
+        case ComponentEncoding::B5G5R5A1_UNorm:
+        {
+            Uint16*     pTexels = static_cast<Uint16*>(pDst);
+            const VecF4 Scale   = SetF4(31.f, 31.f, 31.f, 1.f);
+            for (Uint32 x = 0; x < m_Width; ++x)
+            {
+                int q[4];
+                QuantizeUNormF4(LoadF4(pRGBA + size_t{x} * 4), Scale, q);
+                pTexels[x] = static_cast<Uint16>((q[3] << 15) | (q[0] << 10) | (q[1] << 5) | q[2]);
+            }
+            break;
+        }
+
+        default:
+            UNEXPECTED("Unexpected packed format encoding");
+    }
+}
+
+void RowConverter::DecodeIntRow(const void* pSrc)
+{
+    Int64* pRGBA = m_IntRGBA.data();
+    if (m_Src.Encoding == ComponentEncoding::RGB10A2_UInt)
+    {
+        const Uint32* pTexels = static_cast<const Uint32*>(pSrc);
+        for (Uint32 x = 0; x < m_Width; ++x)
+        {
+            const Uint32 v   = pTexels[x];
+            pRGBA[x * 4 + 0] = v & 0x3FFu;
+            pRGBA[x * 4 + 1] = (v >> 10u) & 0x3FFu;
+            pRGBA[x * 4 + 2] = (v >> 20u) & 0x3FFu;
+            pRGBA[x * 4 + 3] = v >> 30u;
+        }
+        return;
+    }
+
+    const size_t Count  = size_t{m_Width} * m_Src.NumComponents;
+    Int64*       pComps = m_Src.IsRGBA() ? pRGBA : m_IntComps.data();
+    const bool   IsUInt = m_Src.Encoding == ComponentEncoding::UInt;
+    switch (m_Src.ComponentSize)
+    {
+        // clang-format off
+        case 1: IsUInt ? DecodeInt(static_cast<const Uint8* >(pSrc), Count, pComps) : DecodeInt(static_cast<const Int8* >(pSrc), Count, pComps); break;
+        case 2: IsUInt ? DecodeInt(static_cast<const Uint16*>(pSrc), Count, pComps) : DecodeInt(static_cast<const Int16*>(pSrc), Count, pComps); break;
+        case 4: IsUInt ? DecodeInt(static_cast<const Uint32*>(pSrc), Count, pComps) : DecodeInt(static_cast<const Int32*>(pSrc), Count, pComps); break;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected component size");
+    }
+
+    if (pComps != pRGBA)
+        ScatterComponents(m_Src, pComps, m_Width, Int64{1}, pRGBA);
+}
+
+void RowConverter::EncodeIntRow(void* pDst)
+{
+    const Int64* pRGBA = m_IntRGBA.data();
+    if (m_Dst.Encoding == ComponentEncoding::RGB10A2_UInt)
+    {
+        Uint32* pTexels = static_cast<Uint32*>(pDst);
+        for (Uint32 x = 0; x < m_Width; ++x)
+        {
+            Uint32 Texel = 0;
+            for (Uint32 c = 0; c < 4; ++c)
+            {
+                const Int64 MaxValue = c < 3 ? 0x3FF : 0x3;
+                Texel |= static_cast<Uint32>(std::min(std::max(pRGBA[x * 4 + c], Int64{0}), MaxValue)) << (c * 10u);
+            }
+            pTexels[x] = Texel;
+        }
+        return;
+    }
+
+    const size_t Count  = size_t{m_Width} * m_Dst.NumComponents;
+    const Int64* pComps = pRGBA;
+    if (!m_Dst.IsRGBA())
+    {
+        GatherComponents(m_Dst, pRGBA, m_Width, Int64{1}, m_IntComps.data());
+        pComps = m_IntComps.data();
+    }
+
+    const bool IsUInt = m_Dst.Encoding == ComponentEncoding::UInt;
+    switch (m_Dst.ComponentSize)
+    {
+        // clang-format off
+        case 1: IsUInt ? EncodeInt(pComps, Count, static_cast<Uint8* >(pDst)) : EncodeInt(pComps, Count, static_cast<Int8* >(pDst)); break;
+        case 2: IsUInt ? EncodeInt(pComps, Count, static_cast<Uint16*>(pDst)) : EncodeInt(pComps, Count, static_cast<Int16*>(pDst)); break;
+        case 4: IsUInt ? EncodeInt(pComps, Count, static_cast<Uint32*>(pDst)) : EncodeInt(pComps, Count, static_cast<Int32*>(pDst)); break;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected component size");
+    }
+}
+
+
+// Returns 0 for RGBA8, 1 for BGRA8 and 2 for BGRX8 formats of the same color space
+// as Format, and -1 for all other formats.
+int GetRGBA8Order(TEXTURE_FORMAT Format, bool IsSRGB)
+{
+    switch (Format)
+    {
+        // clang-format off
+        case TEX_FORMAT_RGBA8_UNORM:      return !IsSRGB ? 0 : -1;
+        case TEX_FORMAT_BGRA8_UNORM:      return !IsSRGB ? 1 : -1;
+        case TEX_FORMAT_BGRX8_UNORM:      return !IsSRGB ? 2 : -1;
+        case TEX_FORMAT_RGBA8_UNORM_SRGB: return  IsSRGB ? 0 : -1;
+        case TEX_FORMAT_BGRA8_UNORM_SRGB: return  IsSRGB ? 1 : -1;
+        case TEX_FORMAT_BGRX8_UNORM_SRGB: return  IsSRGB ? 2 : -1;
+        // clang-format on
+        default:
+            return -1;
+    }
+}
+
+bool IsRGBA8Swizzle(TEXTURE_FORMAT SrcFormat, TEXTURE_FORMAT DstFormat)
+{
+    const bool IsSRGB = GetTextureFormatAttribs(SrcFormat).ComponentType == COMPONENT_TYPE_UNORM_SRGB;
+    return GetRGBA8Order(SrcFormat, IsSRGB) >= 0 && GetRGBA8Order(DstFormat, IsSRGB) >= 0;
+}
+
+void SwizzleRGBA8Row(const Uint8* pSrc, Uint8* pDst, Uint32 Width, bool SwapRB, Uint32 AlphaMask)
+{
+    for (Uint32 x = 0; x < Width; ++x)
+    {
+        Uint32 Texel;
+        std::memcpy(&Texel, pSrc + x * 4, 4);
+        if (SwapRB)
+            Texel = (Texel & 0xFF00FF00u) | ((Texel >> 16u) & 0xFFu) | ((Texel & 0xFFu) << 16u);
+        Texel |= AlphaMask;
+        std::memcpy(pDst + x * 4, &Texel, 4);
+    }
+}
+
+// Returns true if the formats have identical memory layout and the data can be copied, e.g. D32_FLOAT and R32_FLOAT
+bool IsSameLayout(const FormatLayout& SrcLayout, const FormatLayout& DstLayout)
+{
+    return (SrcLayout.Encoding == DstLayout.Encoding &&
+            SrcLayout.ComponentSize == DstLayout.ComponentSize &&
+            SrcLayout.NumComponents == DstLayout.NumComponents &&
+            SrcLayout.Swizzle == DstLayout.Swizzle &&
+            SrcLayout.IgnoreAlpha == DstLayout.IgnoreAlpha);
+}
+
+bool IsFloat16To32Conversion(const FormatLayout& SrcLayout, const FormatLayout& DstLayout)
+{
+    return (SrcLayout.Encoding == ComponentEncoding::Float &&
+            DstLayout.Encoding == ComponentEncoding::Float &&
+            SrcLayout.ComponentSize != DstLayout.ComponentSize &&
+            SrcLayout.NumComponents == DstLayout.NumComponents);
+}
+
+} // namespace
+
+
+bool IsTextureFormatConversionSupported(TEXTURE_FORMAT SrcFormat, TEXTURE_FORMAT DstFormat)
+{
+    if (SrcFormat == TEX_FORMAT_UNKNOWN || DstFormat == TEX_FORMAT_UNKNOWN)
+        return false;
+
+    if (SrcFormat == DstFormat)
+        return true;
+
+    const FormatLayout SrcLayout = GetFormatLayout(SrcFormat);
+    const FormatLayout DstLayout = GetFormatLayout(DstFormat);
+    return SrcLayout.IsSupported() && DstLayout.IsSupported() && SrcLayout.IsInteger() == DstLayout.IsInteger();
+}
+
+bool ConvertTextureData(const ConvertTextureDataAttribs& Attribs)
+{
+    if (!IsTextureFormatConversionSupported(Attribs.SrcFormat, Attribs.DstFormat))
+        return false;
+
+    if (Attribs.Width == 0 || Attribs.Height == 0)
+        return true;
+
+    DEV_CHECK_ERR(Attribs.pSrcData != nullptr, "Source data must not be null");
+    DEV_CHECK_ERR(Attribs.pDstData != nullptr, "Destination data must not be null");
+
+    const TextureFormatAttribs& SrcFmtAttribs = GetTextureFormatAttribs(Attribs.SrcFormat);
+    const TextureFormatAttribs& DstFmtAttribs = GetTextureFormatAttribs(Attribs.DstFormat);
+
+    Uint32 Width  = Attribs.Width;
+    Uint32 Height = Attribs.Height;
+    if (SrcFmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+    {
+        // Copy block rows
+        Width  = (Width + SrcFmtAttribs.BlockWidth - 1) / SrcFmtAttribs.BlockWidth;
+        Height = (Height + SrcFmtAttribs.BlockHeight - 1) / SrcFmtAttribs.BlockHeight;
+    }
+
+    const size_t SrcRowSize = size_t{Width} * SrcFmtAttribs.GetElementSize();
+    const size_t DstRowSize = size_t{Width} * DstFmtAttribs.GetElementSize();
+    DEV_CHECK_ERR(Height == 1 || Attribs.SrcStride >= SrcRowSize, "Source stride (", Attribs.SrcStride, ") must be at least ", SrcRowSize);
+    DEV_CHECK_ERR(Height == 1 || Attribs.DstStride >= DstRowSize, "Destination stride (", Attribs.DstStride, ") must be at least ", DstRowSize);
+
+    const Uint8* const pSrcData = static_cast<const Uint8*>(Attribs.pSrcData);
+    Uint8* const       pDstData = static_cast<Uint8*>(Attribs.pDstData);
+
+    const Uint32 RowsPerChunk = std::max(ParallelChunkSize / Width, 1u);
+    const Uint32 NumChunks    = (Height + RowsPerChunk - 1) / RowsPerChunk;
+
+    // Calls RowHandler(pSrcRow, pDstRow) for every row, processing chunks of rows in parallel.
+    // RowHandlerFactory creates a handler for every chunk so that handlers may use scratch memory.
+    auto ProcessRows = [&](const auto& RowHandlerFactory) {
+        ParallelFor(NumChunks > 1 ? Attribs.pThreadPool : nullptr, NumChunks,
+                    [&](Uint32 Chunk) {
+                        auto         RowHandler = RowHandlerFactory();
+                        const Uint32 StartRow   = Chunk * RowsPerChunk;
+                        const Uint32 EndRow     = std::min(StartRow + RowsPerChunk, Height);
+                        for (Uint32 y = StartRow; y < EndRow; ++y)
+                            RowHandler(pSrcData + y * Attribs.SrcStride, pDstData + y * Attribs.DstStride);
+                    });
+    };
+
+    auto CopyRows = [&]() {
+        ProcessRows([SrcRowSize]() {
+            return [SrcRowSize](const Uint8* pSrc, Uint8* pDst) {
+                std::memcpy(pDst, pSrc, SrcRowSize);
+            };
+        });
+    };
+
+    if (Attribs.SrcFormat == Attribs.DstFormat)
+    {
+        CopyRows();
+        return true;
+    }
+
+    if (IsRGBA8Swizzle(Attribs.SrcFormat, Attribs.DstFormat))
+    {
+        const bool   IsSRGB    = SrcFmtAttribs.ComponentType == COMPONENT_TYPE_UNORM_SRGB;
+        const int    SrcOrder  = GetRGBA8Order(Attribs.SrcFormat, IsSRGB);
+        const int    DstOrder  = GetRGBA8Order(Attribs.DstFormat, IsSRGB);
+        const bool   SwapRB    = (SrcOrder == 0) != (DstOrder == 0);
+        const Uint32 AlphaMask = (SrcOrder == 2 || DstOrder == 2) ? 0xFF000000u : 0u;
+        ProcessRows([Width, SwapRB, AlphaMask]() {
+            return [Width, SwapRB, AlphaMask](const Uint8* pSrc, Uint8* pDst) {
+                SwizzleRGBA8Row(pSrc, pDst, Width, SwapRB, AlphaMask);
+            };
+        });
+        return true;
+    }
+
+    const FormatLayout SrcLayout = GetFormatLayout(Attribs.SrcFormat);
+    const FormatLayout DstLayout = GetFormatLayout(Attribs.DstFormat);
+    DEV_CHECK_ERR(AlignDown(pSrcData, SrcLayout.ComponentSize) == pSrcData && (Height == 1 || Attribs.SrcStride % SrcLayout.ComponentSize == 0),
+                  "Source data and stride must be aligned by the component size (", SrcLayout.ComponentSize, ")");
+    DEV_CHECK_ERR(AlignDown(pDstData, DstLayout.ComponentSize) == pDstData && (Height == 1 || Attribs.DstStride % DstLayout.ComponentSize == 0),
+                  "Destination data and stride must be aligned by the component size (", DstLayout.ComponentSize, ")");
+
+    if (IsSameLayout(SrcLayout, DstLayout))
+    {
+        CopyRows();
+        return true;
+    }
+
+    if (IsFloat16To32Conversion(SrcLayout, DstLayout))
+    {
+        const size_t Count = size_t{Width} * SrcLayout.NumComponents;
+        if (SrcLayout.ComponentSize == 2)
+        {
+            ProcessRows([Count]() {
+                return [Count](const Uint8* pSrc, Uint8* pDst) {
+                    Float16ToFloat32(reinterpret_cast<const Uint16*>(pSrc), reinterpret_cast<float*>(pDst), Count);
+                };
+            });
+        }
+        else
+        {
+            ProcessRows([Count]() {
+                return [Count](const Uint8* pSrc, Uint8* pDst) {
+                    Float32ToFloat16(reinterpret_cast<const float*>(pSrc), reinterpret_cast<Uint16*>(pDst), Count);
+                };
+            });
+        }
+        return true;
+    }
+
+    ProcessRows([&]() {
+        return RowConverter{SrcLayout, DstLayout, Width};
+    });
+
+    return true;
+}
+
+} // namespace Diligent
@@ -49,6 +49,7 @@
 #include "BasicMath.hpp"
 #include "PlatformMisc.hpp"
 #include "Align.hpp"
+#include "CPUProfiler.hpp"
 
 namespace Diligent
 {
@@ -3420,6 +3420,20 @@ struct EngineCreateInfo
     /// Validation options, see Diligent::VALIDATION_FLAGS.
     VALIDATION_FLAGS    ValidationFlags             DEFAULT_INITIALIZER(VALIDATION_FLAG_NONE);
 
+    /// The maximum number of stale resources that a single release queue purge
+    /// (e.g. in IDeviceContext::FinishFrame) destroys. 0 means no limit.
+
+    /// \remarks   Resources over the limit are destroyed by the next purges, which spreads
+    ///            the cost of releasing many resources at once over several frames.
+    ///            This member is only used by Direct3D12 and Vulkan backends.
+    Uint32              MaxResourcesPerPurge        DEFAULT_INITIALIZER(0);
+
+    /// Whether to destroy stale resources on a background thread.
+
+    /// \remarks   Resources are handed to the background thread only after the GPU
+    ///            is done with them. This member is only used by Direct3D12 and Vulkan backends.
+    Bool                EnableBackgroundResourceRelease DEFAULT_INITIALIZER(false);
+
     /// Pointer to the raw memory allocator that will be used for all memory allocation/deallocation
     /// operations in the engine
     struct IMemoryAllocator* pRawMemAllocator       DEFAULT_INITIALIZER(nullptr);
@@ -3832,6 +3846,24 @@ struct VulkanDescriptorPoolSize
 typedef struct VulkanDescriptorPoolSize VulkanDescriptorPoolSize;
 
 
+/// Algorithm used to manage the free space of memory pages and pools that are suballocated.
+DILIGENT_TYPED_ENUM(SUBALLOCATION_ALGORITHM, Uint8)
+{
+    /// Free blocks are ordered by offset and by size, and every allocation
+    /// takes the smallest block that is large enough (best fit).
+    /// Allocation and release take logarithmic time.
+    SUBALLOCATION_ALGORITHM_BEST_FIT = 0,
+
+    /// Two-level segregated fit. Free blocks are grouped into size classes, and
+    /// allocation and release take constant time at the cost of slightly worse
+    /// packing than SUBALLOCATION_ALGORITHM_BEST_FIT.
+    SUBALLOCATION_ALGORITHM_TLSF,
+
+    /// Helper value that stores the total number of algorithms in the enumeration.
+    SUBALLOCATION_ALGORITHM_COUNT
+};
+
+
 /// Attributes specific to Vulkan engine
 struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 
@@ -3911,6 +3943,10 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// pages when resources are released.
     Uint32 HostVisibleMemoryReserveSize     DEFAULT_INITIALIZER(256 << 20);
 
+    /// Algorithm used to suballocate resources from device-local and host-visible memory pages,
+    /// see Diligent::SUBALLOCATION_ALGORITHM.
+    SUBALLOCATION_ALGORITHM MemoryPageSuballocationAlgorithm DEFAULT_INITIALIZER(SUBALLOCATION_ALGORITHM_BEST_FIT);
+
     /// Page size of the upload heap that is allocated by immediate/deferred
     /// contexts from the global memory manager to perform lock-free dynamic
     /// suballocations.
@@ -27,6 +27,7 @@
 #include "DearchiverBase.hpp"
 #include "PipelineStateBase.hpp"
 #include "PSOSerializer.hpp"
+#include "CPUProfiler.hpp"
 
 namespace Diligent
 {
@@ -703,6 +704,8 @@ bool DearchiverBase::LoadArchive(const IDataBlob* pArchiveData, Uint32 ContentVe
 
 void DearchiverBase::UnpackPipelineState(const PipelineStateUnpackInfo& UnpackInfo, IPipelineState** ppPSO)
 {
+    DILIGENT_PROFILE_SCOPE_CAT("DearchiverBase::UnpackPipelineState", "Dearchiver");
+
     if (!VerifyPipelineStateUnpackInfo(UnpackInfo, ppPSO))
         return;
 
@@ -30,6 +30,8 @@
 #include <vector>
 #include <mutex>
 #include <atomic>
+#include <algorithm>
+#include <iomanip>
 
 #include "PrivateConstants.h"
 #include "EngineFactory.h"
@@ -68,6 +70,8 @@ public:
         m_CommandQueues = ALLOCATE(this->m_RawMemAllocator, "Raw memory for the device command/release queues", CommandQueue, m_CmdQueueCount);
         for (size_t q = 0; q < m_CmdQueueCount; ++q)
             new (m_CommandQueues + q) CommandQueue{RefCntAutoPtr<CommandQueueType>(Queues[q]), this->m_RawMemAllocator};
+
+        ConfigureReleaseQueues(EngineCI.MaxResourcesPerPurge, EngineCI.EnableBackgroundResourceRelease);
     }
 
     ~RenderDeviceNextGenBase()
@@ -151,9 +155,16 @@ public:
     void PurgeReleaseQueue(SoftwareQueueIndex QueueInd, bool ForceRelease = false)
     {
         VERIFY_EXPR(QueueInd < m_CmdQueueCount);
-        auto& Queue               = m_CommandQueues[QueueInd];
-        auto  CompletedFenceValue = ForceRelease ? std::numeric_limits<Uint64>::max() : Queue.CmdQueue->GetCompletedFenceValue();
-        Queue.ReleaseQueue.Purge(CompletedFenceValue);
+        auto& Queue = m_CommandQueues[QueueInd];
+        if (ForceRelease)
+        {
+            // Ignore the purge budget and wait for the background release worker
+            Queue.ReleaseQueue.Flush(std::numeric_limits<Uint64>::max());
+        }
+        else
+        {
+            Queue.ReleaseQueue.Purge(Queue.CmdQueue->GetCompletedFenceValue());
+        }
     }
 
     void IdleCommandQueue(SoftwareQueueIndex QueueInd, bool ReleaseResources)
@@ -181,7 +192,7 @@ public:
         if (ReleaseResources)
         {
             Queue.ReleaseQueue.DiscardStaleResources(CmdBufferNumber, FenceValue);
-            Queue.ReleaseQueue.Purge(Queue.CmdQueue->GetCompletedFenceValue());
+            Queue.ReleaseQueue.Flush(Queue.CmdQueue->GetCompletedFenceValue());
         }
     }
 
@@ -241,6 +252,44 @@ public:
         return m_CommandQueues[QueueInd].ReleaseQueue;
     }
 
+    /// Configures the release queues of all command queues.
+
+    /// \param [in] MaxResourcesPerPurge    - The maximum number of resources destroyed by a single
+    ///                                      release queue purge, see ResourceReleaseQueue::SetMaxResourcesPerPurge().
+    /// \param [in] EnableBackgroundRelease - Whether to destroy resources on a background thread,
+    ///                                      see ResourceReleaseQueue::EnableBackgroundRelease().
+    void ConfigureReleaseQueues(Uint32 MaxResourcesPerPurge, bool EnableBackgroundRelease)
+    {
+        for (size_t q = 0; q < m_CmdQueueCount; ++q)
+        {
+            auto& ReleaseQueue = m_CommandQueues[q].ReleaseQueue;
+            ReleaseQueue.SetMaxResourcesPerPurge(MaxResourcesPerPurge);
+            ReleaseQueue.EnableBackgroundRelease(EnableBackgroundRelease);
+        }
+    }
+
+    /// Returns the release queue statistics accumulated over all command queues.
+    ResourceReleaseQueueStats GetReleaseQueueStats()
+    {
+        ResourceReleaseQueueStats TotalStats;
+
+        double TotalReleaseLatency = 0;
+        for (size_t q = 0; q < m_CmdQueueCount; ++q)
+        {
+            const auto Stats = m_CommandQueues[q].ReleaseQueue.GetStats();
+            TotalStats.StaleResourceCount += Stats.StaleResourceCount;
+            TotalStats.PendingReleaseResourceCount += Stats.PendingReleaseResourceCount;
+            TotalStats.BackgroundReleaseResourceCount += Stats.BackgroundReleaseResourceCount;
+            TotalStats.ReleasedResourceCount += Stats.ReleasedResourceCount;
+            TotalStats.MaxReleaseLatency = std::max(TotalStats.MaxReleaseLatency, Stats.MaxReleaseLatency);
+            TotalReleaseLatency += Stats.AvgReleaseLatency * static_cast<double>(Stats.ReleasedResourceCount);
+        }
+        if (TotalStats.ReleasedResourceCount > 0)
+            TotalStats.AvgReleaseLatency = TotalReleaseLatency / static_cast<double>(TotalStats.ReleasedResourceCount);
+
+        return TotalStats;
+    }
+
     const CommandQueueType& GetCommandQueue(SoftwareQueueIndex CommandQueueInd) const
     {
         VERIFY_EXPR(CommandQueueInd < m_CmdQueueCount);
@@ -286,6 +335,13 @@ protected:
     {
         if (m_CommandQueues != nullptr)
         {
+            const auto Stats = GetReleaseQueueStats();
+            LOG_INFO_MESSAGE("Resource release queue stats:\n"
+                             "                       Released resources: ",
+                             Stats.ReleasedResourceCount,
+                             ". Avg release latency: ", std::fixed, std::setprecision(1), Stats.AvgReleaseLatency * 1000.0,
+                             " ms. Max release latency: ", Stats.MaxReleaseLatency * 1000.0, " ms");
+
             for (size_t q = 0; q < m_CmdQueueCount; ++q)
             {
                 auto& Queue = m_CommandQueues[q];
@@ -87,6 +87,8 @@ void DeviceContextGLImpl::Begin(Uint32 ImmediateContextId)
 
 void DeviceContextGLImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
+    DILIGENT_PROFILE_SCOPE_CAT("DeviceContextGLImpl::SetPipelineState", "DeviceContext");
+
     VERIFY_EXPR(pPipelineState != nullptr);
 
     RefCntAutoPtr<PipelineStateGLImpl> pPipelineStateGLImpl{pPipelineState, PipelineStateGLImpl::IID_InternalImpl};
@@ -176,6 +178,8 @@ void DeviceContextGLImpl::TransitionShaderResources(IShaderResourceBinding* pSha
 
 void DeviceContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    DILIGENT_PROFILE_SCOPE_CAT("DeviceContextGLImpl::CommitShaderResources", "DeviceContext");
+
     DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0);
 
     auto* const pShaderResBindingGL = ClassPtrCast<ShaderResourceBindingGLImpl>(pShaderResourceBinding);
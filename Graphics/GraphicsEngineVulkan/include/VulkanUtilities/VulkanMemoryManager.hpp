@@ -32,8 +32,11 @@
 #include <unordered_map>
 #include <atomic>
 #include <string>
+#include <memory>
 #include "MemoryAllocator.h"
+#include "GraphicsTypes.h"
 #include "VariableSizeAllocationsManager.hpp"
+#include "TLSFAllocationsManager.hpp"
 #include "VulkanUtilities/VulkanPhysicalDevice.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
@@ -114,7 +117,8 @@ public:
     // clang-format off
     VulkanMemoryPage(VulkanMemoryPage&& rhs)noexcept :
         m_ParentMemoryMgr {rhs.m_ParentMemoryMgr         },
-        m_AllocationMgr   {std::move(rhs.m_AllocationMgr)},
+        m_pBestFitMgr     {std::move(rhs.m_pBestFitMgr)  },
+        m_pTLSFMgr        {std::move(rhs.m_pTLSFMgr)     },
         m_VkMemory        {std::move(rhs.m_VkMemory)     },
         m_CPUMemory       {rhs.m_CPUMemory               }
     {
@@ -125,10 +129,10 @@ public:
     VulkanMemoryPage& operator= (VulkanMemoryPage&)       = delete;
     VulkanMemoryPage& operator= (VulkanMemoryPage&& rhs)  = delete;
 
-    bool IsEmpty() const { return m_AllocationMgr.IsEmpty(); }
-    bool IsFull()  const { return m_AllocationMgr.IsFull();  }
-    VkDeviceSize GetPageSize() const { return m_AllocationMgr.GetMaxSize();  }
-    VkDeviceSize GetUsedSize() const { return m_AllocationMgr.GetUsedSize(); }
+    bool IsEmpty() const { return m_pTLSFMgr ? m_pTLSFMgr->IsEmpty() : m_pBestFitMgr->IsEmpty(); }
+    bool IsFull()  const { return m_pTLSFMgr ? m_pTLSFMgr->IsFull()  : m_pBestFitMgr->IsFull();  }
+    VkDeviceSize GetPageSize() const { return m_pTLSFMgr ? m_pTLSFMgr->GetMaxSize()  : m_pBestFitMgr->GetMaxSize();  }
+    VkDeviceSize GetUsedSize() const { return m_pTLSFMgr ? m_pTLSFMgr->GetUsedSize() : m_pBestFitMgr->GetUsedSize(); }
 
     // clang-format on
 
@@ -145,33 +149,40 @@ private:
     // Memory is reclaimed immediately. The application is responsible to ensure it is not in use by the GPU
     void Free(VulkanMemoryAllocation&& Allocation);
 
-    VulkanMemoryManager&                     m_ParentMemoryMgr;
-    std::mutex                               m_Mutex;
-    Diligent::VariableSizeAllocationsManager m_AllocationMgr;
-    VulkanUtilities::DeviceMemoryWrapper     m_VkMemory;
-    void*                                    m_CPUMemory = nullptr;
+    VulkanMemoryManager& m_ParentMemoryMgr;
+    std::mutex           m_Mutex;
+
+    // Only one of the managers is created, depending on the
+    // suballocation algorithm selected by the parent memory manager.
+    std::unique_ptr<Diligent::VariableSizeAllocationsManager> m_pBestFitMgr;
+    std::unique_ptr<Diligent::TLSFAllocationsManager>         m_pTLSFMgr;
+
+    VulkanUtilities::DeviceMemoryWrapper m_VkMemory;
+    void*                                m_CPUMemory = nullptr;
 };
 
 class VulkanMemoryManager
 {
 public:
     // clang-format off
-	VulkanMemoryManager(std::string                  MgrName,
-                        const VulkanLogicalDevice&   LogicalDevice,
-                        const VulkanPhysicalDevice&  PhysicalDevice,
-                        Diligent::IMemoryAllocator&  Allocator,
-                        VkDeviceSize                 DeviceLocalPageSize,
-                        VkDeviceSize                 HostVisiblePageSize,
-                        VkDeviceSize                 DeviceLocalReserveSize,
-                        VkDeviceSize                 HostVisibleReserveSize) :
-        m_MgrName               {std::move(MgrName)    },
-        m_LogicalDevice         {LogicalDevice         },
-        m_PhysicalDevice        {PhysicalDevice        },
-        m_Allocator             {Allocator             },
-        m_DeviceLocalPageSize   {DeviceLocalPageSize   },
-        m_HostVisiblePageSize   {HostVisiblePageSize   },
-        m_DeviceLocalReserveSize{DeviceLocalReserveSize},
-        m_HostVisibleReserveSize{HostVisibleReserveSize}
+	VulkanMemoryManager(std::string                       MgrName,
+                        const VulkanLogicalDevice&        LogicalDevice,
+                        const VulkanPhysicalDevice&       PhysicalDevice,
+                        Diligent::IMemoryAllocator&       Allocator,
+                        VkDeviceSize                      DeviceLocalPageSize,
+                        VkDeviceSize                      HostVisiblePageSize,
+                        VkDeviceSize                      DeviceLocalReserveSize,
+                        VkDeviceSize                      HostVisibleReserveSize,
+                        Diligent::SUBALLOCATION_ALGORITHM PageSuballocationAlgorithm) :
+        m_MgrName                   {std::move(MgrName)        },
+        m_LogicalDevice             {LogicalDevice             },
+        m_PhysicalDevice            {PhysicalDevice            },
+        m_Allocator                 {Allocator                 },
+        m_DeviceLocalPageSize       {DeviceLocalPageSize       },
+        m_HostVisiblePageSize       {HostVisiblePageSize       },
+        m_DeviceLocalReserveSize    {DeviceLocalReserveSize    },
+        m_HostVisibleReserveSize    {HostVisibleReserveSize    },
+        m_PageSuballocationAlgorithm{PageSuballocationAlgorithm}
     {}
 
 
@@ -185,10 +196,11 @@ public:
         m_Allocator       {rhs.m_Allocator         },
         m_Pages           {std::move(rhs.m_Pages)  },
 
-        m_DeviceLocalPageSize    {rhs.m_DeviceLocalPageSize   },
-        m_HostVisiblePageSize    {rhs.m_HostVisiblePageSize   },
-        m_DeviceLocalReserveSize {rhs.m_DeviceLocalReserveSize},
-        m_HostVisibleReserveSize {rhs.m_HostVisibleReserveSize},
+        m_DeviceLocalPageSize        {rhs.m_DeviceLocalPageSize       },
+        m_HostVisiblePageSize        {rhs.m_HostVisiblePageSize       },
+        m_DeviceLocalReserveSize     {rhs.m_DeviceLocalReserveSize    },
+        m_HostVisibleReserveSize     {rhs.m_HostVisibleReserveSize    },
+        m_PageSuballocationAlgorithm {rhs.m_PageSuballocationAlgorithm},
 
         //m_CurrUsedSize      {rhs.m_CurrUsedSize},
         m_PeakUsedSize      {rhs.m_PeakUsedSize     },
@@ -264,6 +276,8 @@ protected:
     const VkDeviceSize m_DeviceLocalReserveSize;
     const VkDeviceSize m_HostVisibleReserveSize;
 
+    const Diligent::SUBALLOCATION_ALGORITHM m_PageSuballocationAlgorithm;
+
     void OnFreeAllocation(VkDeviceSize Size, bool IsHostVisible);
 
     // 0 == Device local, 1 == Host-visible
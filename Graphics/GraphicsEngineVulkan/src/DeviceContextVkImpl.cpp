@@ -274,6 +274,8 @@ inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(SoftwareQueueIndex CmdQ
 
 void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
+    DILIGENT_PROFILE_SCOPE_CAT("DeviceContextVkImpl::SetPipelineState", "DeviceContext");
+
     RefCntAutoPtr<PipelineStateVkImpl> pPipelineStateVk{pPipelineState, PipelineStateVkImpl::IID_InternalImpl};
     VERIFY(pPipelineState == nullptr || pPipelineStateVk != nullptr, "Unknown pipeline state object implementation");
     if (PipelineStateVkImpl::IsSameObject(m_pPipelineState, pPipelineStateVk))
@@ -534,6 +536,8 @@ void DeviceContextVkImpl::TransitionShaderResources(IShaderResourceBinding* pSha
 
 void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    DILIGENT_PROFILE_SCOPE_CAT("DeviceContextVkImpl::CommitShaderResources", "DeviceContext");
+
     TDeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/);
 
     auto* pResBindingVkImpl = ClassPtrCast<ShaderResourceBindingVkImpl>(pShaderResourceBinding);
@@ -727,6 +731,8 @@ void DeviceContextVkImpl::DvpLogRenderPass_PSOMismatch()
 
 void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
 {
+    DILIGENT_PROFILE_SCOPE_CAT("DeviceContextVkImpl::PrepareForDraw", "DeviceContext");
+
     if (m_vkFramebuffer == VK_NULL_HANDLE && m_State.NullRenderTargets)
     {
         DEV_CHECK_ERR(m_FramebufferWidth > 0 && m_FramebufferHeight > 0,
@@ -51,6 +51,7 @@
 #include "VulkanTypeConversions.hpp"
 #include "EngineMemory.h"
 #include "QueryManagerVk.hpp"
+#include "CPUProfiler.hpp"
 
 namespace Diligent
 {
@@ -134,7 +135,8 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         EngineCI.DeviceLocalMemoryPageSize,
         EngineCI.HostVisibleMemoryPageSize,
         EngineCI.DeviceLocalMemoryReserveSize,
-        EngineCI.HostVisibleMemoryReserveSize
+        EngineCI.HostVisibleMemoryReserveSize,
+        EngineCI.MemoryPageSuballocationAlgorithm
     },
     m_DynamicMemoryManager
     {
@@ -564,16 +566,19 @@ void RenderDeviceVkImpl::TestTextureFormat(TEXTURE_FORMAT TexFormat)
 
 void RenderDeviceVkImpl::CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
+    DILIGENT_PROFILE_SCOPE_CAT("RenderDeviceVkImpl::CreateGraphicsPipelineState", "RenderDevice");
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
 }
 
 void RenderDeviceVkImpl::CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
+    DILIGENT_PROFILE_SCOPE_CAT("RenderDeviceVkImpl::CreateComputePipelineState", "RenderDevice");
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
 }
 
 void RenderDeviceVkImpl::CreateRayTracingPipelineState(const RayTracingPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
+    DILIGENT_PROFILE_SCOPE_CAT("RenderDeviceVkImpl::CreateRayTracingPipelineState", "RenderDevice");
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
 }
 
@@ -592,6 +597,8 @@ void RenderDeviceVkImpl::CreateShader(const ShaderCreateInfo& ShaderCI,
                                       IShader**               ppShader,
                                       IDataBlob**             ppCompilerOutput)
 {
+    DILIGENT_PROFILE_SCOPE_CAT("RenderDeviceVkImpl::CreateShader", "RenderDevice");
+
     const ShaderVkImpl::CreateInfo VkShaderCI{
         GetDxCompiler(),
         GetDeviceInfo(),
@@ -46,14 +46,27 @@ VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&  ParentMemoryMgr,
                                    bool                  IsHostVisible,
                                    VkMemoryAllocateFlags AllocateFlags) :
     // clang-format off
-    m_ParentMemoryMgr{ParentMemoryMgr},
-    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator}
+    m_ParentMemoryMgr{ParentMemoryMgr}
 // clang-format on
 {
     VERIFY(PageSize <= std::numeric_limits<AllocationsMgrOffsetType>::max(),
            "PageSize (", PageSize, ") exceeds maximum allowed value ",
            std::numeric_limits<AllocationsMgrOffsetType>::max());
 
+    switch (ParentMemoryMgr.m_PageSuballocationAlgorithm)
+    {
+        case Diligent::SUBALLOCATION_ALGORITHM_BEST_FIT:
+            m_pBestFitMgr = std::make_unique<Diligent::VariableSizeAllocationsManager>(static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator);
+            break;
+
+        case Diligent::SUBALLOCATION_ALGORITHM_TLSF:
+            m_pTLSFMgr = std::make_unique<Diligent::TLSFAllocationsManager>(static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator);
+            break;
+
+        default:
+            LOG_ERROR_AND_THROW("Unknown suballocation algorithm ", Diligent::Uint32{ParentMemoryMgr.m_PageSuballocationAlgorithm});
+    }
+
     VkMemoryAllocateInfo      MemAlloc    = {};
     VkMemoryAllocateFlagsInfo MemFlagInfo = {};
 
@@ -102,7 +115,9 @@ VulkanMemoryAllocation VulkanMemoryPage::Allocate(VkDeviceSize size, VkDeviceSiz
     VERIFY(size <= std::numeric_limits<AllocationsMgrOffsetType>::max(),
            "Allocation size (", size, ") exceeds maximum allowed value ",
            std::numeric_limits<AllocationsMgrOffsetType>::max());
-    auto Allocation = m_AllocationMgr.Allocate(static_cast<AllocationsMgrOffsetType>(size), static_cast<AllocationsMgrOffsetType>(alignment));
+    auto Allocation = m_pTLSFMgr ?
+        m_pTLSFMgr->Allocate(static_cast<AllocationsMgrOffsetType>(size), static_cast<AllocationsMgrOffsetType>(alignment)) :
+        m_pBestFitMgr->Allocate(static_cast<AllocationsMgrOffsetType>(size), static_cast<AllocationsMgrOffsetType>(alignment));
     if (Allocation.IsValid())
     {
         // Offset may not necessarily be aligned, but the allocation is guaranteed to be large enough
@@ -122,7 +137,10 @@ void VulkanMemoryPage::Free(VulkanMemoryAllocation&& Allocation)
     std::lock_guard<std::mutex> Lock{m_Mutex};
     VERIFY_EXPR(Allocation.UnalignedOffset <= std::numeric_limits<AllocationsMgrOffsetType>::max());
     VERIFY_EXPR(Allocation.Size <= std::numeric_limits<AllocationsMgrOffsetType>::max());
-    m_AllocationMgr.Free(static_cast<AllocationsMgrOffsetType>(Allocation.UnalignedOffset), static_cast<AllocationsMgrOffsetType>(Allocation.Size));
+    if (m_pTLSFMgr)
+        m_pTLSFMgr->Free(static_cast<AllocationsMgrOffsetType>(Allocation.UnalignedOffset), static_cast<AllocationsMgrOffsetType>(Allocation.Size));
+    else
+        m_pBestFitMgr->Free(static_cast<AllocationsMgrOffsetType>(Allocation.UnalignedOffset), static_cast<AllocationsMgrOffsetType>(Allocation.Size));
     Allocation = VulkanMemoryAllocation{};
 }
 
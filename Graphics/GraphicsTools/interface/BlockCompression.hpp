@@ -0,0 +1,160 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// CPU block compression and decompression of texture data.
+
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+
+namespace Diligent
+{
+
+class IThreadPool;
+
+/// Block compression quality.
+enum BLOCK_COMPRESSION_QUALITY : Uint8
+{
+    /// Endpoints are derived from the bounding box of the block colors.
+    BLOCK_COMPRESSION_QUALITY_FAST = 0,
+
+    /// Endpoints are fitted along the principal axis of the block colors and
+    /// refined with least squares. BC7 also tries two-subset partitions for opaque blocks.
+    BLOCK_COMPRESSION_QUALITY_HIGH,
+
+    BLOCK_COMPRESSION_QUALITY_COUNT
+};
+
+/// Attributes of the CompressTextureData function.
+struct CompressTextureDataAttribs
+{
+    /// Texture width, in texels.
+    Uint32 Width = 0;
+
+    /// Texture height, in texels.
+    Uint32 Height = 0;
+
+    /// Source data format.
+    ///
+    /// \remarks    Any format that can be converted by ConvertTextureData to RGBA8_UNORM (BC1, BC2, BC3, BC7),
+    ///             RGBA8_UNORM_SRGB (sRGB formats), R8_UNORM/R8_SNORM (BC4) or RG8_UNORM/RG8_SNORM (BC5) is supported.
+    ///             Note that sRGB formats are compressed in gamma space.
+    TEXTURE_FORMAT SrcFormat = TEX_FORMAT_UNKNOWN;
+
+    /// A pointer to the source data.
+    const void* pSrcData = nullptr;
+
+    /// Source row stride, in bytes.
+    size_t SrcStride = 0;
+
+    /// Compressed format, see IsBlockCompressionSupported.
+    TEXTURE_FORMAT DstFormat = TEX_FORMAT_UNKNOWN;
+
+    /// A pointer to the compressed data.
+    void* pDstData = nullptr;
+
+    /// Distance between the rows of blocks in the compressed data, in bytes.
+    size_t DstStride = 0;
+
+    /// Compression quality.
+    BLOCK_COMPRESSION_QUALITY Quality = BLOCK_COMPRESSION_QUALITY_FAST;
+
+    /// Optional thread pool to compress the rows of blocks in parallel.
+    IThreadPool* pThreadPool = nullptr;
+};
+
+/// Attributes of the DecompressTextureData function.
+struct DecompressTextureDataAttribs
+{
+    /// Texture width, in texels.
+    Uint32 Width = 0;
+
+    /// Texture height, in texels.
+    Uint32 Height = 0;
+
+    /// Compressed format, see IsBlockDecompressionSupported.
+    TEXTURE_FORMAT SrcFormat = TEX_FORMAT_UNKNOWN;
+
+    /// A pointer to the compressed data.
+    const void* pSrcData = nullptr;
+
+    /// Distance between the rows of blocks in the compressed data, in bytes.
+    size_t SrcStride = 0;
+
+    /// Destination data format.
+    ///
+    /// \remarks    Blocks are decoded to the same 8-bit formats that CompressTextureData
+    ///             uses as the source (see CompressTextureDataAttribs::SrcFormat), or to
+    ///             RGBA16_FLOAT for BC6H, and are then converted to DstFormat by ConvertTextureData.
+    TEXTURE_FORMAT DstFormat = TEX_FORMAT_UNKNOWN;
+
+    /// A pointer to the destination data.
+    void* pDstData = nullptr;
+
+    /// Destination row stride, in bytes.
+    size_t DstStride = 0;
+
+    /// Optional thread pool to decompress the rows of blocks in parallel.
+    IThreadPool* pThreadPool = nullptr;
+};
+
+/// Checks if the format can be compressed by CompressTextureData and decompressed by DecompressTextureData.
+
+/// BC1, BC2, BC3, BC4, BC5 and BC7 formats are supported. BC6H and typeless formats are not supported.
+bool IsBlockCompressionSupported(TEXTURE_FORMAT Format);
+
+/// Checks if the format can be decompressed by DecompressTextureData.
+
+/// All formats supported by IsBlockCompressionSupported as well as BC6H_UF16 and BC6H_SF16
+/// are supported. Typeless formats are not supported.
+bool IsBlockDecompressionSupported(TEXTURE_FORMAT Format);
+
+/// Compresses texture data, for instance a mip level computed by ComputeMipLevel.
+
+/// \param[in]  Attribs - Compression attributes, see Diligent::CompressTextureDataAttribs.
+///
+/// \return     true if the data was compressed successfully, and false if the formats are not supported.
+///
+/// \remarks    If the texture size is not a multiple of the block size, the edge texels
+///             are replicated to fill the last blocks.
+///
+///             BC1 blocks that contain texels with alpha less than 0.5 use the three-color mode
+///             with transparent black texels. BC7 blocks are encoded with mode 6 and,
+///             in high quality mode, also with mode 1 for opaque blocks.
+bool CompressTextureData(const CompressTextureDataAttribs& Attribs);
+
+/// Decompresses texture data.
+
+/// \param[in]  Attribs - Decompression attributes, see Diligent::DecompressTextureDataAttribs.
+///
+/// \return     true if the data was decompressed successfully, and false if the formats are not supported.
+///
+/// \remarks    Interpolated values are rounded to 8 bits and may differ from the values
+///             computed by the GPU by one. BC6H blocks are decoded exactly to 16-bit floats.
+bool DecompressTextureData(const DecompressTextureDataAttribs& Attribs);
+
+} // namespace Diligent
@@ -30,6 +30,8 @@
 /// \file
 /// Declaration of BufferSuballocator interface and related data structures
 
+#include <algorithm>
+
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 #include "../../GraphicsEngine/interface/DeviceContext.h"
 #include "../../GraphicsEngine/interface/Buffer.h"
@@ -97,20 +99,61 @@ struct BufferSuballocatorUsageStats
     /// The total memory size used by all allocations, in bytes.
     Uint64 UsedSize = 0;
 
+    /// The total size of free memory available to the allocations, in bytes.
+
+    /// \remarks   This may be less than CommittedSize - UsedSize, for instance when the size
+    ///            of the buffer is aligned up by the memory page size.
+    Uint64 FreeSize = 0;
+
     /// The maximum size of the continuous free chunk in the buffer, in bytes.
     Uint64 MaxFreeChunkSize = 0;
 
     /// The current number of allocations.
     Uint32 AllocationCount = 0;
 
+    /// The number of continuous free chunks in the buffer.
+    Uint32 FreeChunkCount = 0;
+
     BufferSuballocatorUsageStats& operator+=(const BufferSuballocatorUsageStats& rhs)
     {
         CommittedSize += rhs.CommittedSize;
         UsedSize += rhs.UsedSize;
+        FreeSize += rhs.FreeSize;
         MaxFreeChunkSize = std::max(MaxFreeChunkSize, rhs.MaxFreeChunkSize);
         AllocationCount += rhs.AllocationCount;
+        FreeChunkCount += rhs.FreeChunkCount;
         return *this;
     }
+
+    /// Returns the fragmentation of the free space, a value in [0, 1] range.
+
+    /// The fragmentation is computed as 1 - MaxFreeChunkSize / FreeSize. Zero means
+    /// that all free memory is available as a single chunk, while values close to one
+    /// indicate that large allocations are likely to fail even though there is enough
+    /// free memory in total.
+    double GetFragmentation() const
+    {
+        return FreeSize > 0 ? 1.0 - static_cast<double>(std::min(MaxFreeChunkSize, FreeSize)) / static_cast<double>(FreeSize) : 0.0;
+    }
+};
+
+/// Buffer suballocator defragmentation attributes, see IBufferSuballocator::PlanDefragmentation().
+struct BufferSuballocatorDefragmentationAttribs
+{
+    /// A pointer to the array of suballocations that may be relocated.
+
+    /// All suballocations must have been created by the suballocator
+    /// that performs the defragmentation.
+    IBufferSuballocation* const* ppSuballocations = nullptr;
+
+    /// The number of elements in the ppSuballocations array.
+    Uint32 NumSuballocations = 0;
+
+    /// The maximum number of suballocations to relocate.
+    Uint32 MaxMoves = ~0u;
+
+    /// The maximum total number of bytes to copy.
+    Uint64 MaxBytesToMove = ~Uint64{0};
 };
 
 /// Buffer suballocator.
@@ -156,6 +199,34 @@ struct IBufferSuballocator : public IObject
     /// Returns the internal buffer version. The version is incremented every time
     /// the buffer is expanded.
     virtual Uint32 GetVersion() const = 0;
+
+
+    /// Plans the defragmentation of the buffer.
+
+    /// \param[in]  Attribs             - Defragmentation attributes, see Diligent::BufferSuballocatorDefragmentationAttribs.
+    /// \param[out] ppNewSuballocations - A pointer to the array of Attribs.NumSuballocations elements.
+    ///                                   For every suballocation that is relocated, the new suballocation
+    ///                                   is written to the element with the same index. All other elements
+    ///                                   are set to null.
+    ///
+    /// \return     The number of relocated suballocations.
+    ///
+    /// \remarks    Suballocations are moved from the end of the buffer into the free chunks that precede
+    ///             them, so that the free space is compacted towards the end of the buffer.
+    ///             The new suballocations are reserved before the method returns, while the original
+    ///             suballocations remain valid. To commit the defragmentation, the application must
+    ///             copy GetSize() bytes of every relocated suballocation from the original offset to the
+    ///             new one, replace all references to the original suballocation with the new one, and
+    ///             release the original suballocation once the GPU no longer uses it.
+    ///             The source and destination regions never overlap.
+    ///
+    ///             The user data of the original suballocation is copied to the new one.
+    ///
+    ///             Use MaxMoves and MaxBytesToMove to spread the defragmentation over several frames.
+    ///
+    ///             The method is thread-safe and can be called from multiple threads simultaneously.
+    virtual Uint32 PlanDefragmentation(const BufferSuballocatorDefragmentationAttribs& Attribs,
+                                       IBufferSuballocation**                          ppNewSuballocations) = 0;
 };
 
 /// Buffer suballocator create information.
@@ -177,6 +248,9 @@ struct BufferSuballocatorCreateInfo
     /// \remarks    If MaxSize is zero, the buffer will not be expanded beyond the initial size.
     Uint64 MaxSize = 0;
 
+    /// Algorithm used to manage the free space of the buffer, see Diligent::SUBALLOCATION_ALGORITHM.
+    SUBALLOCATION_ALGORITHM Algorithm = SUBALLOCATION_ALGORITHM_BEST_FIT;
+
     /// Whether to disable debug validation of the internal buffer structure.
 
     /// \remarks    By default, internal buffer structure is validated in debug
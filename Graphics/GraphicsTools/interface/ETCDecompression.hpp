@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// CPU decompression of ETC2 and EAC texture data.
+
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+#include "BlockCompression.hpp"
+
+namespace Diligent
+{
+
+struct IRenderDevice;
+
+/// ETC2 and EAC compressed formats.
+
+/// The formats have no TEXTURE_FORMAT counterparts, so ETC2 assets are decompressed
+/// on the CPU with DecompressETCData before they are uploaded to the GPU.
+enum ETC_FORMAT : Uint8
+{
+    ETC_FORMAT_UNKNOWN = 0,
+
+    /// RGB, 8 bytes per block. ETC1 data is a subset of this format.
+    ETC_FORMAT_ETC2_RGB8,
+    ETC_FORMAT_ETC2_RGB8_SRGB,
+
+    /// RGB with 1-bit punch-through alpha, 8 bytes per block.
+    ETC_FORMAT_ETC2_RGB8A1,
+    ETC_FORMAT_ETC2_RGB8A1_SRGB,
+
+    /// RGB with EAC alpha, 16 bytes per block.
+    ETC_FORMAT_ETC2_RGBA8,
+    ETC_FORMAT_ETC2_RGBA8_SRGB,
+
+    /// Single 11-bit channel, 8 bytes per block.
+    ETC_FORMAT_EAC_R11_UNORM,
+    ETC_FORMAT_EAC_R11_SNORM,
+
+    /// Two 11-bit channels, 16 bytes per block.
+    ETC_FORMAT_EAC_RG11_UNORM,
+    ETC_FORMAT_EAC_RG11_SNORM,
+
+    ETC_FORMAT_COUNT
+};
+
+/// Returns the size of a 4x4 block of the ETC format, in bytes.
+Uint32 GetETCBlockSize(ETC_FORMAT Format);
+
+/// Attributes of the DecompressETCData function.
+struct DecompressETCDataAttribs
+{
+    /// Texture width, in texels.
+    Uint32 Width = 0;
+
+    /// Texture height, in texels.
+    Uint32 Height = 0;
+
+    /// Compressed format.
+    ETC_FORMAT SrcFormat = ETC_FORMAT_UNKNOWN;
+
+    /// A pointer to the compressed data.
+    const void* pSrcData = nullptr;
+
+    /// Distance between the rows of blocks in the compressed data, in bytes.
+    size_t SrcStride = 0;
+
+    /// Destination format.
+    ///
+    /// \remarks    ETC2 blocks are decoded to RGBA8_UNORM (or RGBA8_UNORM_SRGB for sRGB formats),
+    ///             and EAC blocks are decoded to R16/RG16 UNORM or SNORM. The texels are then
+    ///             converted to DstFormat by ConvertTextureData or, if DstFormat is a block-compressed
+    ///             format supported by CompressTextureData, compressed to DstFormat.
+    ///             See GetETCFallbackFormat.
+    TEXTURE_FORMAT DstFormat = TEX_FORMAT_UNKNOWN;
+
+    /// A pointer to the destination data.
+    void* pDstData = nullptr;
+
+    /// Destination row stride, in bytes. For block-compressed formats, this is the distance between the rows of blocks.
+    size_t DstStride = 0;
+
+    /// Compression quality that is used when DstFormat is a block-compressed format.
+    BLOCK_COMPRESSION_QUALITY Quality = BLOCK_COMPRESSION_QUALITY_FAST;
+
+    /// Optional thread pool to decompress the rows of blocks in parallel.
+    IThreadPool* pThreadPool = nullptr;
+};
+
+/// Decompresses ETC2 or EAC texture data.
+
+/// \param[in]  Attribs - Decompression attributes, see Diligent::DecompressETCDataAttribs.
+///
+/// \return     true if the data was decompressed successfully, and false if the formats are not supported.
+bool DecompressETCData(const DecompressETCDataAttribs& Attribs);
+
+/// Returns the format that ETC data should be decompressed to for the device.
+
+/// \param[in]  Format  - ETC format.
+/// \param[in]  pDevice - Render device. If null, an uncompressed format is returned.
+///
+/// \return     BC7 if the device supports it and RGBA8 otherwise for ETC2 formats;
+///             R16/RG16 if the device supports it and R8/RG8 otherwise for EAC formats.
+TEXTURE_FORMAT GetETCFallbackFormat(ETC_FORMAT Format, IRenderDevice* pDevice);
+
+} // namespace Diligent
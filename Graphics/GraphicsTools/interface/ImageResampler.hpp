@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// CPU resampling of images to arbitrary sizes.
+
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+
+namespace Diligent
+{
+
+class IThreadPool;
+
+/// Image resampling filter.
+enum RESAMPLE_FILTER : Uint8
+{
+    /// Box filter that averages the source texels covered by the destination texel.
+    /// When magnifying, the filter replicates the nearest source texel.
+    RESAMPLE_FILTER_BOX = 0,
+
+    /// Triangle (tent) filter. When magnifying, this is bilinear interpolation.
+    RESAMPLE_FILTER_BILINEAR,
+
+    /// Catmull-Rom cubic filter.
+    RESAMPLE_FILTER_BICUBIC,
+
+    /// Lanczos filter with three lobes.
+    RESAMPLE_FILTER_LANCZOS,
+
+    /// Kaiser-windowed sinc filter with three lobes (alpha = 4).
+    RESAMPLE_FILTER_KAISER,
+
+    RESAMPLE_FILTER_COUNT
+};
+
+/// Attributes of the ResampleImage function.
+struct ResampleImageAttribs
+{
+    /// Source image width, in texels.
+    Uint32 SrcWidth = 0;
+
+    /// Source image height, in texels.
+    Uint32 SrcHeight = 0;
+
+    /// Source data format.
+    ///
+    /// \remarks    Any format that ConvertTextureData can convert to RGBA32_FLOAT is supported.
+    ///             Integer, compressed and typeless formats are not supported.
+    TEXTURE_FORMAT SrcFormat = TEX_FORMAT_UNKNOWN;
+
+    /// A pointer to the source data.
+    const void* pSrcData = nullptr;
+
+    /// Source row stride, in bytes.
+    size_t SrcStride = 0;
+
+    /// Destination image width, in texels.
+    Uint32 DstWidth = 0;
+
+    /// Destination image height, in texels.
+    Uint32 DstHeight = 0;
+
+    /// Destination data format.
+    ///
+    /// \remarks    Any format that ConvertTextureData can convert RGBA32_FLOAT to is supported.
+    TEXTURE_FORMAT DstFormat = TEX_FORMAT_UNKNOWN;
+
+    /// A pointer to the destination data.
+    void* pDstData = nullptr;
+
+    /// Destination row stride, in bytes.
+    size_t DstStride = 0;
+
+    /// Resampling filter.
+    RESAMPLE_FILTER Filter = RESAMPLE_FILTER_BILINEAR;
+
+    /// Whether sRGB images are filtered in linear space.
+    bool GammaCorrect = true;
+
+    /// Optional thread pool to process rows in parallel.
+    IThreadPool* pThreadPool = nullptr;
+};
+
+/// Checks if the formats are supported by ResampleImage.
+bool IsImageResamplingSupported(TEXTURE_FORMAT SrcFormat, TEXTURE_FORMAT DstFormat);
+
+/// Resamples an image to an arbitrary size, for instance to create a thumbnail.
+
+/// \param[in]  Attribs - Resampling attributes, see Diligent::ResampleImageAttribs.
+///
+/// \return     true if the image was resampled successfully, and false if the formats are not supported.
+///
+/// \remarks    The image is filtered horizontally and then vertically in 32-bit floating-point precision.
+///             When minifying, the filter is widened to cover the destination texel footprint.
+///             Texels outside of the image are clamped to the edge.
+///             If the size does not change, the image is only converted to the destination format.
+bool ResampleImage(const ResampleImageAttribs& Attribs);
+
+} // namespace Diligent
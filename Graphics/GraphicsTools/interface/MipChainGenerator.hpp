@@ -0,0 +1,126 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// CPU generation of the full mip chain of a texture.
+
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+
+namespace Diligent
+{
+
+class IThreadPool;
+
+/// Mip chain downsampling filter.
+enum MIP_CHAIN_FILTER : Uint8
+{
+    /// Box filter that averages the fine texels covered by the coarse texel.
+    MIP_CHAIN_FILTER_BOX = 0,
+
+    /// Kaiser-windowed sinc filter with three lobes (alpha = 4).
+    /// Produces sharper mip levels than the box filter with little ringing.
+    MIP_CHAIN_FILTER_KAISER,
+
+    /// Lanczos filter with three lobes.
+    /// Sharper than the Kaiser filter, but may produce more ringing at hard edges.
+    MIP_CHAIN_FILTER_LANCZOS,
+
+    MIP_CHAIN_FILTER_COUNT
+};
+
+/// Data of a single mip level.
+struct MipLevelData
+{
+    /// A pointer to the mip level data.
+    void* pData = nullptr;
+
+    /// Row stride, in bytes.
+    size_t Stride = 0;
+};
+
+/// Attributes of the ComputeMipChain function.
+struct ComputeMipChainAttribs
+{
+    /// Texture format.
+    ///
+    /// \remarks    Any format that ConvertTextureData can convert to and from RGBA32_FLOAT is supported.
+    ///             Integer, compressed and typeless formats are not supported.
+    TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+
+    /// Width of the most detailed mip level.
+    Uint32 Width = 0;
+
+    /// Height of the most detailed mip level.
+    Uint32 Height = 0;
+
+    /// A pointer to the most detailed mip level data.
+    const void* pSrcData = nullptr;
+
+    /// Row stride of the most detailed mip level, in bytes.
+    size_t SrcStride = 0;
+
+    /// The number of coarse mip levels to compute.
+    ///
+    /// \remarks    The number must not exceed ComputeMipLevelsCount(Width, Height) - 1.
+    Uint32 NumMipLevels = 0;
+
+    /// Coarse mip levels, starting with mip level 1. The array must contain NumMipLevels elements.
+    ///
+    /// \remarks    The size of mip level i is max(Width >> i, 1) x max(Height >> i, 1).
+    const MipLevelData* pMipLevels = nullptr;
+
+    /// Downsampling filter.
+    MIP_CHAIN_FILTER Filter = MIP_CHAIN_FILTER_BOX;
+
+    /// Whether sRGB textures are filtered in linear space.
+    bool GammaCorrect = true;
+
+    /// Alpha test reference value.
+    ///
+    /// \remarks    When AlphaCutoff is not 0, alpha of every coarse mip level is scaled so that
+    ///             the fraction of texels with alpha greater than AlphaCutoff is the same as in
+    ///             the most detailed level. This keeps alpha-tested geometry, e.g. foliage,
+    ///             from thinning out in the distance.
+    float AlphaCutoff = 0;
+
+    /// Optional thread pool to process rows in parallel.
+    IThreadPool* pThreadPool = nullptr;
+};
+
+/// Computes the mip chain of a texture.
+
+/// \param[in]  Attribs - Mip chain attributes, see Diligent::ComputeMipChainAttribs.
+///
+/// \return     true if the mip chain was computed successfully, and false if the format is not supported.
+///
+/// \remarks    Every mip level is computed from the previous level with a separable filter in 32-bit floating-point
+///             precision, so that the rounding errors do not accumulate. Unlike ComputeMipLevel, the function
+///             handles odd sizes by resampling the whole level rather than clamping the 2x2 footprint.
+bool ComputeMipChain(const ComputeMipChainAttribs& Attribs);
+
+} // namespace Diligent
@@ -29,6 +29,8 @@
 /// \file
 /// Declaration of the IVertexPool interface and related data structures.
 
+#include <algorithm>
+
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 #include "../../GraphicsEngine/interface/DeviceContext.h"
 #include "../../GraphicsEngine/interface/Buffer.h"
@@ -105,6 +107,12 @@ struct VertexPoolUsageStats
     /// The number of allocations.
     Uint32 AllocationCount = 0;
 
+    /// The maximum number of vertices in a continuous free chunk of the pool.
+    Uint64 MaxFreeChunkVertexCount = 0;
+
+    /// The number of continuous free chunks in the pool.
+    Uint32 FreeChunkCount = 0;
+
     VertexPoolUsageStats& operator+=(const VertexPoolUsageStats& RHS)
     {
         TotalVertexCount += RHS.TotalVertexCount;
@@ -112,8 +120,20 @@ struct VertexPoolUsageStats
         CommittedMemorySize += RHS.CommittedMemorySize;
         UsedMemorySize += RHS.UsedMemorySize;
         AllocationCount += RHS.AllocationCount;
+        MaxFreeChunkVertexCount = std::max(MaxFreeChunkVertexCount, RHS.MaxFreeChunkVertexCount);
+        FreeChunkCount += RHS.FreeChunkCount;
         return *this;
     }
+
+    /// Returns the fragmentation of the free space, a value in [0, 1] range.
+
+    /// The fragmentation is computed as 1 - MaxFreeChunkVertexCount / FreeVertexCount,
+    /// where FreeVertexCount is the total number of free vertices in the pool.
+    double GetFragmentation() const
+    {
+        const Uint64 FreeVertexCount = TotalVertexCount > AllocatedVertexCount ? TotalVertexCount - AllocatedVertexCount : 0;
+        return FreeVertexCount > 0 ? 1.0 - static_cast<double>(std::min(MaxFreeChunkVertexCount, FreeVertexCount)) / static_cast<double>(FreeVertexCount) : 0.0;
+    }
 };
 
 
@@ -205,6 +225,25 @@ struct VertexPoolDesc
     }
 };
 
+/// Vertex pool defragmentation attributes, see IVertexPool::PlanDefragmentation().
+struct VertexPoolDefragmentationAttribs
+{
+    /// A pointer to the array of allocations that may be relocated.
+
+    /// All allocations must have been created by the pool
+    /// that performs the defragmentation.
+    IVertexPoolAllocation* const* ppAllocations = nullptr;
+
+    /// The number of elements in the ppAllocations array.
+    Uint32 NumAllocations = 0;
+
+    /// The maximum number of allocations to relocate.
+    Uint32 MaxMoves = ~0u;
+
+    /// The maximum total number of vertices to copy.
+    Uint64 MaxVerticesToMove = ~Uint64{0};
+};
+
 /// Vertex pool interface.
 ///
 /// The vertex pool is a collection of dynamic buffers that can be used to store vertex data.
@@ -259,6 +298,34 @@ struct IVertexPool : public IObject
 
     /// Returns the pool description.
     virtual const VertexPoolDesc& GetDesc() const = 0;
+
+
+    /// Plans the defragmentation of the pool.
+
+    /// \param[in]  Attribs          - Defragmentation attributes, see Diligent::VertexPoolDefragmentationAttribs.
+    /// \param[out] ppNewAllocations - A pointer to the array of Attribs.NumAllocations elements.
+    ///                                For every allocation that is relocated, the new allocation
+    ///                                is written to the element with the same index. All other elements
+    ///                                are set to null.
+    ///
+    /// \return     The number of relocated allocations.
+    ///
+    /// \remarks    Allocations are moved from the end of the pool into the free chunks that precede
+    ///             them, so that the free space is compacted towards the end of the pool.
+    ///             The new allocations are reserved before the method returns, while the original
+    ///             allocations remain valid. To commit the defragmentation, the application must
+    ///             copy the vertices of every relocated allocation in every internal buffer from the
+    ///             original start vertex to the new one, replace all references to the original allocation
+    ///             with the new one, and release the original allocation once the GPU no longer uses it.
+    ///             The source and destination regions never overlap.
+    ///
+    ///             The user data of the original allocation is copied to the new one.
+    ///
+    ///             Use MaxMoves and MaxVerticesToMove to spread the defragmentation over several frames.
+    ///
+    ///             The method is thread-safe and can be called from multiple threads simultaneously.
+    virtual Uint32 PlanDefragmentation(const VertexPoolDefragmentationAttribs& Attribs,
+                                       IVertexPoolAllocation**                 ppNewAllocations) = 0;
 };
 
 
@@ -279,6 +346,9 @@ struct VertexPoolCreateInfo
     /// If zero, the number of vertices is unlimited.
     Uint32 MaxVertexCount = 0;
 
+    /// Algorithm used to manage the free space of the pool, see Diligent::SUBALLOCATION_ALGORITHM.
+    SUBALLOCATION_ALGORITHM Algorithm = SUBALLOCATION_ALGORITHM_BEST_FIT;
+
     /// Whether to disable debug validation of the internal pool structure.
 
     /// \remarks    By default, internal pool structure is validated in debug
@@ -294,6 +364,7 @@ struct VertexPoolCreateInfo
         return Desc == RHS.Desc &&
             ExtraVertexCount == RHS.ExtraVertexCount &&
             MaxVertexCount == RHS.MaxVertexCount &&
+            Algorithm == RHS.Algorithm &&
             DisableDebugValidation == RHS.DisableDebugValidation;
     }
 
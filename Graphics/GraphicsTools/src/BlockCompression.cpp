@@ -0,0 +1,1832 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BlockCompression.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "GraphicsAccessories.hpp"
+#include "TextureFormatConverter.hpp"
+#include "BasicMathSIMD.hpp"
+#include "ThreadPool.hpp"
+#include "DebugUtilities.hpp"
+#include "PlatformMisc.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+using namespace MathSIMD;
+
+// The number of blocks processed by a single parallel task
+constexpr Uint32 CompressChunkSize   = 1u << 10;
+constexpr Uint32 DecompressChunkSize = 1u << 14;
+
+constexpr Uint32 BlockDim       = 4;
+constexpr Uint32 TexelsPerBlock = BlockDim * BlockDim;
+constexpr Uint32 AllTexelsMask  = 0xFFFFu;
+
+// Texels of a 4x4 block, stored as an array of channels.
+// UNORM values are in [0, 255] range, SNORM values are in [-127, 127] range.
+struct BlockTexels
+{
+    float Ch[4][TexelsPerBlock];
+};
+
+template <typename T>
+T Clamp(T Val, T Min, T Max)
+{
+    return std::min(std::max(Val, Min), Max);
+}
+
+int RoundToInt(float Val)
+{
+    return static_cast<int>(std::floor(Val + 0.5f));
+}
+
+// Finds the nearest palette entry for every texel of the block. Channels points to the first
+// channel to compare. Writes the entry indices to pIndices and the squared errors to pErrors.
+void FindNearestPaletteEntries(const float (*Channels)[TexelsPerBlock],
+                               Uint32 NumChannels,
+                               const float (*Palette)[4],
+                               Uint32 PaletteSize,
+                               Uint8* pIndices,
+                               float* pErrors)
+{
+    for (Uint32 i = 0; i < TexelsPerBlock; i += 4)
+    {
+        VecF4 Texel[4];
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            Texel[c] = LoadF4(&Channels[c][i]);
+
+        VecF4 BestErr = SetF4(FLT_MAX);
+        VecF4 BestIdx = SetF4(0.f);
+        for (Uint32 k = 0; k < PaletteSize; ++k)
+        {
+            VecF4 Err = SetF4(0.f);
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                const VecF4 Diff = SubF4(Texel[c], SetF4(Palette[k][c]));
+                Err              = AddF4(Err, MulF4(Diff, Diff));
+            }
+            const MaskF4 IsBetter = CmpLtF4(Err, BestErr);
+
+            BestErr = SelectF4(IsBetter, Err, BestErr);
+            BestIdx = SelectF4(IsBetter, SetF4(static_cast<float>(k)), BestIdx);
+        }
+
+        int Indices[4];
+        StoreI4(Indices, BestIdx);
+        StoreF4(&pErrors[i], BestErr);
+        for (Uint32 j = 0; j < 4; ++j)
+            pIndices[i + j] = static_cast<Uint8>(Indices[j]);
+    }
+}
+
+float GetMaskedError(const float* pErrors, Uint32 Mask)
+{
+    float Error = 0;
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        if (Mask & (1u << i))
+            Error += pErrors[i];
+    }
+    return Error;
+}
+
+// Computes the endpoints from the bounding box of the texels selected by Mask.
+// The diagonal of the box is selected by the signs of the covariance with the channel
+// that has the largest range. Inset moves the endpoints toward each other by the given
+// fraction of the range to compensate for the interpolated palette entries.
+void FitBoundingBox(const BlockTexels& Block, Uint32 NumChannels, Uint32 Mask, float Inset, float E0[4], float E1[4])
+{
+    float  Min[4]  = {FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX};
+    float  Max[4]  = {-FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX};
+    float  Mean[4] = {};
+    Uint32 Count   = 0;
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        if ((Mask & (1u << i)) == 0)
+            continue;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+        {
+            Min[c] = std::min(Min[c], Block.Ch[c][i]);
+            Max[c] = std::max(Max[c], Block.Ch[c][i]);
+            Mean[c] += Block.Ch[c][i];
+        }
+        ++Count;
+    }
+    VERIFY_EXPR(Count > 0);
+
+    Uint32 RefChannel = 0;
+    for (Uint32 c = 0; c < NumChannels; ++c)
+    {
+        Mean[c] /= static_cast<float>(Count);
+        if (Max[c] - Min[c] > Max[RefChannel] - Min[RefChannel])
+            RefChannel = c;
+    }
+
+    for (Uint32 c = 0; c < NumChannels; ++c)
+    {
+        float Covariance = 0;
+        for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+        {
+            if (Mask & (1u << i))
+                Covariance += (Block.Ch[c][i] - Mean[c]) * (Block.Ch[RefChannel][i] - Mean[RefChannel]);
+        }
+
+        const float Delta = (Max[c] - Min[c]) * Inset;
+        E0[c]             = Min[c] + Delta;
+        E1[c]             = Max[c] - Delta;
+        if (Covariance < 0)
+            std::swap(E0[c], E1[c]);
+    }
+}
+
+// Computes the endpoints as the extremes of the projections of the texels selected by Mask
+// onto their principal axis. The axis is found by the power iteration of the covariance matrix.
+void FitPrincipalAxis(const BlockTexels& Block, Uint32 NumChannels, Uint32 Mask, float E0[4], float E1[4])
+{
+    float  Mean[4] = {};
+    Uint32 Count   = 0;
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        if ((Mask & (1u << i)) == 0)
+            continue;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            Mean[c] += Block.Ch[c][i];
+        ++Count;
+    }
+    VERIFY_EXPR(Count > 0);
+    for (Uint32 c = 0; c < NumChannels; ++c)
+        Mean[c] /= static_cast<float>(Count);
+
+    float Cov[4][4] = {};
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        if ((Mask & (1u << i)) == 0)
+            continue;
+        for (Uint32 c0 = 0; c0 < NumChannels; ++c0)
+        {
+            for (Uint32 c1 = c0; c1 < NumChannels; ++c1)
+                Cov[c0][c1] += (Block.Ch[c0][i] - Mean[c0]) * (Block.Ch[c1][i] - Mean[c1]);
+        }
+    }
+    for (Uint32 c0 = 0; c0 < NumChannels; ++c0)
+    {
+        for (Uint32 c1 = 0; c1 < c0; ++c1)
+            Cov[c0][c1] = Cov[c1][c0];
+    }
+
+    // Start with the row of the channel with the largest variance
+    Uint32 MaxVarChannel = 0;
+    for (Uint32 c = 1; c < NumChannels; ++c)
+    {
+        if (Cov[c][c] > Cov[MaxVarChannel][MaxVarChannel])
+            MaxVarChannel = c;
+    }
+
+    float Axis[4] = {};
+    for (Uint32 c = 0; c < NumChannels; ++c)
+        Axis[c] = Cov[MaxVarChannel][c];
+
+    for (Uint32 Iter = 0; Iter < 8; ++Iter)
+    {
+        float NewAxis[4] = {};
+        float MaxComp    = 0;
+        for (Uint32 c0 = 0; c0 < NumChannels; ++c0)
+        {
+            for (Uint32 c1 = 0; c1 < NumChannels; ++c1)
+                NewAxis[c0] += Cov[c0][c1] * Axis[c1];
+            MaxComp = std::max(MaxComp, std::abs(NewAxis[c0]));
+        }
+        if (MaxComp < 1e-6f)
+            break;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            Axis[c] = NewAxis[c] / MaxComp;
+    }
+
+    float AxisLenSq = 0;
+    for (Uint32 c = 0; c < NumChannels; ++c)
+        AxisLenSq += Axis[c] * Axis[c];
+
+    if (AxisLenSq < 1e-6f)
+    {
+        // All texels are the same
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            E0[c] = E1[c] = Mean[c];
+        return;
+    }
+
+    float MinT = FLT_MAX;
+    float MaxT = -FLT_MAX;
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        if ((Mask & (1u << i)) == 0)
+            continue;
+        float t = 0;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            t += (Block.Ch[c][i] - Mean[c]) * Axis[c];
+        MinT = std::min(MinT, t);
+        MaxT = std::max(MaxT, t);
+    }
+    for (Uint32 c = 0; c < NumChannels; ++c)
+    {
+        E0[c] = Mean[c] + Axis[c] * MinT / AxisLenSq;
+        E1[c] = Mean[c] + Axis[c] * MaxT / AxisLenSq;
+    }
+}
+
+// Finds the endpoints that minimize the squared error for the given indices with the least squares.
+// Weights[Idx] is the weight of the second endpoint for the index.
+// Returns false if the system is degenerate, for instance when all texels use the same index.
+bool RefineEndpoints(const BlockTexels& Block, Uint32 NumChannels, Uint32 Mask, const Uint8* pIndices, const float* Weights, float E0[4], float E1[4])
+{
+    float AA = 0, AB = 0, BB = 0;
+    float AX[4] = {};
+    float BX[4] = {};
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        if ((Mask & (1u << i)) == 0)
+            continue;
+        const float b = Weights[pIndices[i]];
+        const float a = 1.f - b;
+        AA += a * a;
+        AB += a * b;
+        BB += b * b;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+        {
+            AX[c] += a * Block.Ch[c][i];
+            BX[c] += b * Block.Ch[c][i];
+        }
+    }
+
+    const float Det = AA * BB - AB * AB;
+    if (std::abs(Det) < 1e-4f)
+        return false;
+
+    const float InvDet = 1.f / Det;
+    for (Uint32 c = 0; c < NumChannels; ++c)
+    {
+        E0[c] = (BB * AX[c] - AB * BX[c]) * InvDet;
+        E1[c] = (AA * BX[c] - AB * AX[c]) * InvDet;
+    }
+    return true;
+}
+
+
+// BC1 color block: two 5:6:5 endpoints followed by 2-bit indices.
+// If c0 > c1 or the block is part of BC2/BC3, the block uses four colors: c0, c1, 2/3 c0 + 1/3 c1, 1/3 c0 + 2/3 c1.
+// Otherwise, the block uses three colors: c0, c1, 1/2 c0 + 1/2 c1, and index 3 is transparent black.
+void UnpackRGB565(Uint32 Color, Uint32 RGB[3])
+{
+    const Uint32 R = (Color >> 11) & 0x1F;
+    const Uint32 G = (Color >> 5) & 0x3F;
+    const Uint32 B = Color & 0x1F;
+
+    RGB[0] = (R << 3) | (R >> 2);
+    RGB[1] = (G << 2) | (G >> 4);
+    RGB[2] = (B << 3) | (B >> 2);
+}
+
+Uint32 PackRGB565(const float RGB[3])
+{
+    const Uint32 R = static_cast<Uint32>(Clamp(RoundToInt(RGB[0] * (31.f / 255.f)), 0, 31));
+    const Uint32 G = static_cast<Uint32>(Clamp(RoundToInt(RGB[1] * (63.f / 255.f)), 0, 63));
+    const Uint32 B = static_cast<Uint32>(Clamp(RoundToInt(RGB[2] * (31.f / 255.f)), 0, 31));
+    return (R << 11) | (G << 5) | B;
+}
+
+void GetBC1Palette(Uint32 Color0, Uint32 Color1, bool ForceFourColors, Uint8 Palette[4][4])
+{
+    Uint32 C0[3], C1[3];
+    UnpackRGB565(Color0, C0);
+    UnpackRGB565(Color1, C1);
+
+    const bool FourColors = ForceFourColors || Color0 > Color1;
+    for (Uint32 c = 0; c < 3; ++c)
+    {
+        Palette[0][c] = static_cast<Uint8>(C0[c]);
+        Palette[1][c] = static_cast<Uint8>(C1[c]);
+        if (FourColors)
+        {
+            Palette[2][c] = static_cast<Uint8>((2 * C0[c] + C1[c] + 1) / 3);
+            Palette[3][c] = static_cast<Uint8>((C0[c] + 2 * C1[c] + 1) / 3);
+        }
+        else
+        {
+            Palette[2][c] = static_cast<Uint8>((C0[c] + C1[c] + 1) / 2);
+            Palette[3][c] = 0;
+        }
+    }
+    Palette[0][3] = Palette[1][3] = Palette[2][3] = 255;
+    Palette[3][3]                                 = FourColors ? 255 : 0;
+}
+
+void WriteBC1ColorBlock(Uint32 Color0, Uint32 Color1, const Uint8* pIndices, Uint8* pBlock)
+{
+    Uint32 Indices = 0;
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+        Indices |= Uint32{pIndices[i]} << (2 * i);
+
+    pBlock[0] = static_cast<Uint8>(Color0 & 0xFF);
+    pBlock[1] = static_cast<Uint8>(Color0 >> 8);
+    pBlock[2] = static_cast<Uint8>(Color1 & 0xFF);
+    pBlock[3] = static_cast<Uint8>(Color1 >> 8);
+    for (Uint32 i = 0; i < 4; ++i)
+        pBlock[4 + i] = static_cast<Uint8>(Indices >> (8 * i));
+}
+
+// Encodes the RGB channels of the block as a BC1 color block.
+// If AllowTransparent is true, texels with alpha less than 128 are encoded as transparent black.
+void EncodeBC1ColorBlock(const BlockTexels& Block, bool AllowTransparent, BLOCK_COMPRESSION_QUALITY Quality, Uint8* pBlock)
+{
+    Uint32 OpaqueMask = AllTexelsMask;
+    if (AllowTransparent)
+    {
+        for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+        {
+            if (Block.Ch[3][i] < 128.f)
+                OpaqueMask &= ~(1u << i);
+        }
+    }
+
+    Uint8 BestIndices[TexelsPerBlock] = {};
+    if (OpaqueMask == 0)
+    {
+        // Three-color mode with all texels using the transparent index
+        std::fill_n(BestIndices, TexelsPerBlock, Uint8{3});
+        WriteBC1ColorBlock(0, 0, BestIndices, pBlock);
+        return;
+    }
+
+    // The block must use the three-color mode if it has transparent texels
+    const bool ThreeColors = OpaqueMask != AllTexelsMask;
+
+    float  BestError  = FLT_MAX;
+    Uint32 BestColor0 = 0;
+    Uint32 BestColor1 = 0;
+
+    auto TryEndpoints = [&](const float E0[4], const float E1[4]) {
+        Uint32 Color0 = PackRGB565(E0);
+        Uint32 Color1 = PackRGB565(E1);
+        if (ThreeColors ? Color0 > Color1 : Color0 < Color1)
+            std::swap(Color0, Color1);
+
+        Uint8 Palette8[4][4];
+        GetBC1Palette(Color0, Color1, !AllowTransparent, Palette8);
+
+        float Palette[4][4];
+        for (Uint32 k = 0; k < 4; ++k)
+        {
+            for (Uint32 c = 0; c < 4; ++c)
+                Palette[k][c] = Palette8[k][c];
+        }
+
+        // In BC1, identical endpoints select the three-color mode, so the last entry must not be used.
+        const Uint32 PaletteSize = (ThreeColors || (AllowTransparent && Color0 == Color1)) ? 3 : 4;
+
+        Uint8 Indices[TexelsPerBlock];
+        float Errors[TexelsPerBlock];
+        FindNearestPaletteEntries(Block.Ch, 3, Palette, PaletteSize, Indices, Errors);
+
+        const float Error = GetMaskedError(Errors, OpaqueMask);
+        if (Error < BestError)
+        {
+            BestError  = Error;
+            BestColor0 = Color0;
+            BestColor1 = Color1;
+            for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+                BestIndices[i] = (OpaqueMask & (1u << i)) ? Indices[i] : Uint8{3};
+        }
+    };
+
+    float E0[4], E1[4];
+    if (Quality == BLOCK_COMPRESSION_QUALITY_FAST)
+    {
+        FitBoundingBox(Block, 3, OpaqueMask, 1.f / 16.f, E0, E1);
+        TryEndpoints(E0, E1);
+    }
+    else
+    {
+        FitBoundingBox(Block, 3, OpaqueMask, 0.f, E0, E1);
+        TryEndpoints(E0, E1);
+        FitPrincipalAxis(Block, 3, OpaqueMask, E0, E1);
+        TryEndpoints(E0, E1);
+
+        static constexpr float FourColorWeights[]  = {0.f, 1.f, 1.f / 3.f, 2.f / 3.f};
+        static constexpr float ThreeColorWeights[] = {0.f, 1.f, 1.f / 2.f, 0.f};
+        for (Uint32 Iter = 0; Iter < 2; ++Iter)
+        {
+            const bool   IsFourColor = !ThreeColors && BestColor0 > BestColor1;
+            const float* Weights     = IsFourColor ? FourColorWeights : ThreeColorWeights;
+            if (!RefineEndpoints(Block, 3, OpaqueMask, BestIndices, Weights, E0, E1))
+                break;
+            TryEndpoints(E0, E1);
+        }
+    }
+
+    WriteBC1ColorBlock(BestColor0, BestColor1, BestIndices, pBlock);
+}
+
+void DecodeBC1ColorBlock(const Uint8* pBlock, bool ForceFourColors, Uint8 (*pTexels)[4])
+{
+    const Uint32 Color0  = pBlock[0] | (Uint32{pBlock[1]} << 8);
+    const Uint32 Color1  = pBlock[2] | (Uint32{pBlock[3]} << 8);
+    const Uint32 Indices = pBlock[4] | (Uint32{pBlock[5]} << 8) | (Uint32{pBlock[6]} << 16) | (Uint32{pBlock[7]} << 24);
+
+    Uint8 Palette[4][4];
+    GetBC1Palette(Color0, Color1, ForceFourColors, Palette);
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        const Uint32 Idx = (Indices >> (2 * i)) & 0x03;
+        std::memcpy(pTexels[i], Palette[Idx], 4);
+    }
+}
+
+
+// BC2 alpha block: explicit 4-bit alpha values.
+void EncodeBC2AlphaBlock(const BlockTexels& Block, Uint8* pBlock)
+{
+    for (Uint32 i = 0; i < TexelsPerBlock; i += 2)
+    {
+        const Uint32 A0 = static_cast<Uint32>(Clamp(RoundToInt(Block.Ch[3][i] * (15.f / 255.f)), 0, 15));
+        const Uint32 A1 = static_cast<Uint32>(Clamp(RoundToInt(Block.Ch[3][i + 1] * (15.f / 255.f)), 0, 15));
+        pBlock[i / 2]   = static_cast<Uint8>(A0 | (A1 << 4));
+    }
+}
+
+void DecodeBC2AlphaBlock(const Uint8* pBlock, Uint8 (*pTexels)[4])
+{
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        const Uint32 A = (pBlock[i / 2] >> (4 * (i & 0x01))) & 0x0F;
+        pTexels[i][3]  = static_cast<Uint8>(A * 17);
+    }
+}
+
+
+// BC4 block: two 8-bit endpoints followed by 3-bit indices.
+// If e0 > e1, the block uses eight values: e0, e1 and six interpolated values.
+// Otherwise, the block uses six values: e0, e1, four interpolated values, and the minimum and maximum of the range.
+void GetBC4Palette(int E0, int E1, bool IsSigned, int Palette[8])
+{
+    Palette[0] = E0;
+    Palette[1] = E1;
+    if (E0 > E1)
+    {
+        for (int i = 1; i < 7; ++i)
+            Palette[i + 1] = RoundToInt(static_cast<float>((7 - i) * E0 + i * E1) / 7.f);
+    }
+    else
+    {
+        for (int i = 1; i < 5; ++i)
+            Palette[i + 1] = RoundToInt(static_cast<float>((5 - i) * E0 + i * E1) / 5.f);
+        Palette[6] = IsSigned ? -127 : 0;
+        Palette[7] = IsSigned ? 127 : 255;
+    }
+}
+
+// Encodes one channel of the block as a BC4 block
+void EncodeBC4Block(const BlockTexels& Block, Uint32 Channel, bool IsSigned, BLOCK_COMPRESSION_QUALITY Quality, Uint8* pBlock)
+{
+    const int   RangeMin = IsSigned ? -127 : 0;
+    const int   RangeMax = IsSigned ? 127 : 255;
+    const auto* Values   = Block.Ch[Channel];
+
+    float BestError                   = FLT_MAX;
+    int   BestE0                      = 0;
+    int   BestE1                      = 0;
+    Uint8 BestIndices[TexelsPerBlock] = {};
+
+    auto TryEndpoints = [&](int E0, int E1) {
+        E0 = Clamp(E0, RangeMin, RangeMax);
+        E1 = Clamp(E1, RangeMin, RangeMax);
+
+        int Palette8[8];
+        GetBC4Palette(E0, E1, IsSigned, Palette8);
+
+        float Palette[8][4];
+        for (Uint32 k = 0; k < 8; ++k)
+            Palette[k][0] = static_cast<float>(Palette8[k]);
+
+        Uint8 Indices[TexelsPerBlock];
+        float Errors[TexelsPerBlock];
+        FindNearestPaletteEntries(&Block.Ch[Channel], 1, Palette, 8, Indices, Errors);
+
+        const float Error = GetMaskedError(Errors, AllTexelsMask);
+        if (Error < BestError)
+        {
+            BestError = Error;
+            BestE0    = E0;
+            BestE1    = E1;
+            std::memcpy(BestIndices, Indices, sizeof(Indices));
+        }
+    };
+
+    float Min = FLT_MAX;
+    float Max = -FLT_MAX;
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        Min = std::min(Min, Values[i]);
+        Max = std::max(Max, Values[i]);
+    }
+
+    // Eight-value mode
+    TryEndpoints(RoundToInt(Max), RoundToInt(Min));
+
+    if (Quality != BLOCK_COMPRESSION_QUALITY_FAST && BestError > 0)
+    {
+        // Six-value mode: the range extremes are encoded explicitly, so exclude them from the endpoints.
+        float InnerMin = FLT_MAX;
+        float InnerMax = -FLT_MAX;
+        for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+        {
+            const int Val = RoundToInt(Values[i]);
+            if (Val != RangeMin && Val != RangeMax)
+            {
+                InnerMin = std::min(InnerMin, Values[i]);
+                InnerMax = std::max(InnerMax, Values[i]);
+            }
+        }
+        if (InnerMin <= InnerMax)
+            TryEndpoints(RoundToInt(InnerMin), RoundToInt(InnerMax));
+
+        // Refine the eight-value mode endpoints
+        static constexpr float Weights[] = {0.f, 1.f, 1.f / 7.f, 2.f / 7.f, 3.f / 7.f, 4.f / 7.f, 5.f / 7.f, 6.f / 7.f};
+        for (Uint32 Iter = 0; Iter < 2 && BestE0 > BestE1; ++Iter)
+        {
+            float E0[4], E1[4];
+            if (!RefineEndpoints(Block, Channel + 1, AllTexelsMask, BestIndices, Weights, E0, E1))
+                break;
+            const int NewE0 = RoundToInt(E0[Channel]);
+            const int NewE1 = RoundToInt(E1[Channel]);
+            if (NewE0 == BestE0 && NewE1 == BestE1)
+                break;
+            TryEndpoints(std::max(NewE0, NewE1), std::min(NewE0, NewE1));
+        }
+    }
+
+    Uint64 Indices = 0;
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+        Indices |= Uint64{BestIndices[i]} << (3 * i);
+
+    pBlock[0] = static_cast<Uint8>(BestE0);
+    pBlock[1] = static_cast<Uint8>(BestE1);
+    for (Uint32 i = 0; i < 6; ++i)
+        pBlock[2 + i] = static_cast<Uint8>(Indices >> (8 * i));
+}
+
+// Decodes a BC4 block to every TexelStride-th byte starting with pValues
+void DecodeBC4Block(const Uint8* pBlock, bool IsSigned, Uint8* pValues, Uint32 TexelStride)
+{
+    int E0 = pBlock[0];
+    int E1 = pBlock[1];
+    if (IsSigned)
+    {
+        // -128 is mapped to -127
+        E0 = std::max(static_cast<int>(static_cast<Int8>(E0)), -127);
+        E1 = std::max(static_cast<int>(static_cast<Int8>(E1)), -127);
+    }
+
+    int Palette[8];
+    GetBC4Palette(E0, E1, IsSigned, Palette);
+
+    Uint64 Indices = 0;
+    for (Uint32 i = 0; i < 6; ++i)
+        Indices |= Uint64{pBlock[2 + i]} << (8 * i);
+
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        const Uint32 Idx         = static_cast<Uint32>(Indices >> (3 * i)) & 0x07;
+        pValues[i * TexelStride] = static_cast<Uint8>(Palette[Idx]);
+    }
+}
+
+
+// BC7 modes, see https://learn.microsoft.com/en-us/windows/win32/direct3d11/bc7-format-mode-reference
+struct BC7ModeInfo
+{
+    Uint8 NumSubsets;
+    Uint8 PartitionBits;
+    Uint8 RotationBits;
+    Uint8 IndexSelectionBits;
+    Uint8 ColorBits;
+    Uint8 AlphaBits;
+    Uint8 EndpointPBits;
+    Uint8 SharedPBits;
+    Uint8 IndexBits;
+    Uint8 SecondaryIndexBits;
+};
+
+// clang-format off
+constexpr BC7ModeInfo BC7Modes[8] =
+{
+    // NS  PB  RB ISB  CB  AB EPB SPB  IB IB2
+    {  3,  4,  0,  0,  4,  0,  1,  0,  3,  0},
+    {  2,  6,  0,  0,  6,  0,  0,  1,  3,  0},
+    {  3,  6,  0,  0,  5,  0,  0,  0,  2,  0},
+    {  2,  6,  0,  0,  7,  0,  1,  0,  2,  0},
+    {  1,  0,  2,  1,  5,  6,  0,  0,  2,  3},
+    {  1,  0,  2,  0,  7,  8,  0,  0,  2,  2},
+    {  1,  0,  0,  0,  7,  7,  1,  0,  4,  0},
+    {  2,  6,  0,  0,  5,  5,  1,  0,  2,  0},
+};
+
+// Two-subset partitions. Bit i is set if texel i belongs to subset 1.
+constexpr Uint16 BC7Partitions2[64] =
+{
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+// Three-subset partitions. Bits 2i and 2i+1 contain the subset of texel i.
+constexpr Uint32 BC7Partitions3[64] =
+{
+    0xAA685050u, 0x6A5A5040u, 0x5A5A4200u, 0x5450A0A8u,
+    0xA5A50000u, 0xA0A05050u, 0x5555A0A0u, 0x5A5A5050u,
+    0xAA550000u, 0xAA555500u, 0xAAAA5500u, 0x90909090u,
+    0x94949494u, 0xA4A4A4A4u, 0xA9A59450u, 0x2A0A4250u,
+    0xA5945040u, 0x0A425054u, 0xA5A5A500u, 0x55A0A0A0u,
+    0xA8A85454u, 0x6A6A4040u, 0xA4A45000u, 0x1A1A0500u,
+    0x0050A4A4u, 0xAAA59090u, 0x14696914u, 0x69691400u,
+    0xA08585A0u, 0xAA821414u, 0x50A4A450u, 0x6A5A0200u,
+    0xA9A58000u, 0x5090A0A8u, 0xA8A09050u, 0x24242424u,
+    0x00AA5500u, 0x24924924u, 0x24499224u, 0x50A50A50u,
+    0x500AA550u, 0xAAAA4444u, 0x66660000u, 0xA5A0A5A0u,
+    0x50A050A0u, 0x69286928u, 0x44AAAA44u, 0x66666600u,
+    0xAA444444u, 0x54A854A8u, 0x95809580u, 0x96969600u,
+    0xA85454A8u, 0x80959580u, 0xAA141414u, 0x96960000u,
+    0xAAAA1414u, 0xA05050A0u, 0xA0A5A5A0u, 0x96000000u,
+    0x40804080u, 0xA9A8A9A8u, 0xAAAAAA44u, 0x2A4A5254u,
+};
+
+// Anchor texels of the second subset of two-subset partitions
+constexpr Uint8 BC7Anchors2[64] =
+{
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+    15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+     6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+};
+
+// Anchor texels of the second subset of three-subset partitions
+constexpr Uint8 BC7Anchors3_1[64] =
+{
+     3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+     3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+     8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+     3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+};
+
+// Anchor texels of the third subset of three-subset partitions
+constexpr Uint8 BC7Anchors3_2[64] =
+{
+    15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+    15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+    15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+    15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+};
+
+constexpr Uint8 BC7Weights2[4]  = {0, 21, 43, 64};
+constexpr Uint8 BC7Weights3[8]  = {0, 9, 18, 27, 37, 46, 55, 64};
+constexpr Uint8 BC7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+// clang-format on
+
+const Uint8* GetBC7Weights(Uint32 IndexBits)
+{
+    switch (IndexBits)
+    {
+        case 2: return BC7Weights2;
+        case 3: return BC7Weights3;
+        case 4: return BC7Weights4;
+        default:
+            UNEXPECTED("Unexpected index bit count");
+            return BC7Weights2;
+    }
+}
+
+Uint32 GetBC7Subset(Uint32 NumSubsets, Uint32 Partition, Uint32 Texel)
+{
+    switch (NumSubsets)
+    {
+        case 1: return 0;
+        case 2: return (BC7Partitions2[Partition] >> Texel) & 0x01;
+        case 3: return (BC7Partitions3[Partition] >> (2 * Texel)) & 0x03;
+        default:
+            UNEXPECTED("Unexpected number of subsets");
+            return 0;
+    }
+}
+
+// The anchor texel is the first texel of the subset. Its index is stored with one bit less,
+// and the most significant bit is implicitly zero.
+bool IsBC7AnchorTexel(Uint32 NumSubsets, Uint32 Partition, Uint32 Texel)
+{
+    if (Texel == 0)
+        return true;
+    if (NumSubsets == 2)
+        return Texel == BC7Anchors2[Partition];
+    if (NumSubsets == 3)
+        return Texel == BC7Anchors3_1[Partition] || Texel == BC7Anchors3_2[Partition];
+    return false;
+}
+
+Uint32 InterpolateBC7(Uint32 E0, Uint32 E1, Uint32 Weight)
+{
+    return ((64 - Weight) * E0 + Weight * E1 + 32) >> 6;
+}
+
+Uint32 ExpandBC7Endpoint(Uint32 Value, Uint32 Bits)
+{
+    return (Value << (8 - Bits)) | (Value >> (2 * Bits - 8));
+}
+
+class BC7BitReader
+{
+public:
+    explicit BC7BitReader(const Uint8* pBlock) :
+        m_pBlock{pBlock}
+    {}
+
+    Uint32 Read(Uint32 NumBits)
+    {
+        Uint32 Value = 0;
+        for (Uint32 i = 0; i < NumBits; ++i, ++m_Pos)
+            Value |= ((m_pBlock[m_Pos >> 3] >> (m_Pos & 0x07)) & 0x01) << i;
+        return Value;
+    }
+
+private:
+    const Uint8* const m_pBlock;
+    Uint32             m_Pos = 0;
+};
+
+class BC7BitWriter
+{
+public:
+    explicit BC7BitWriter(Uint8* pBlock) :
+        m_pBlock{pBlock}
+    {
+        std::memset(m_pBlock, 0, 16);
+    }
+
+    void Write(Uint32 Value, Uint32 NumBits)
+    {
+        VERIFY_EXPR(NumBits == 32 || Value < (1u << NumBits));
+        for (Uint32 i = 0; i < NumBits; ++i, ++m_Pos)
+            m_pBlock[m_Pos >> 3] |= static_cast<Uint8>(((Value >> i) & 0x01) << (m_Pos & 0x07));
+    }
+
+    Uint32 GetPosition() const { return m_Pos; }
+
+private:
+    Uint8* const m_pBlock;
+    Uint32       m_Pos = 0;
+};
+
+void DecodeBC7Block(const Uint8* pBlock, Uint8 (*pTexels)[4])
+{
+    Uint32 Mode = 0;
+    while (Mode < 8 && (pBlock[0] & (1u << Mode)) == 0)
+        ++Mode;
+    if (Mode == 8)
+    {
+        // Reserved mode
+        std::memset(pTexels, 0, TexelsPerBlock * 4);
+        return;
+    }
+
+    const BC7ModeInfo& Info = BC7Modes[Mode];
+
+    BC7BitReader Reader{pBlock};
+    Reader.Read(Mode + 1);
+    const Uint32 Partition      = Reader.Read(Info.PartitionBits);
+    const Uint32 Rotation       = Reader.Read(Info.RotationBits);
+    const Uint32 IndexSelection = Reader.Read(Info.IndexSelectionBits);
+
+    const Uint32 NumEndpoints = Info.NumSubsets * 2u;
+
+    Uint32 Endpoints[6][4];
+    for (Uint32 c = 0; c < 3; ++c)
+    {
+        for (Uint32 e = 0; e < NumEndpoints; ++e)
+            Endpoints[e][c] = Reader.Read(Info.ColorBits);
+    }
+    for (Uint32 e = 0; e < NumEndpoints; ++e)
+        Endpoints[e][3] = Info.AlphaBits > 0 ? Reader.Read(Info.AlphaBits) : 255;
+
+    Uint32 ColorBits = Info.ColorBits;
+    Uint32 AlphaBits = Info.AlphaBits;
+    if (Info.EndpointPBits != 0 || Info.SharedPBits != 0)
+    {
+        Uint32 PBits[6] = {};
+        if (Info.EndpointPBits != 0)
+        {
+            for (Uint32 e = 0; e < NumEndpoints; ++e)
+                PBits[e] = Reader.Read(1);
+        }
+        else
+        {
+            for (Uint32 s = 0; s < Info.NumSubsets; ++s)
+                PBits[s * 2] = PBits[s * 2 + 1] = Reader.Read(1);
+        }
+
+        for (Uint32 e = 0; e < NumEndpoints; ++e)
+        {
+            for (Uint32 c = 0; c < 3; ++c)
+                Endpoints[e][c] = (Endpoints[e][c] << 1) | PBits[e];
+            if (Info.AlphaBits > 0)
+                Endpoints[e][3] = (Endpoints[e][3] << 1) | PBits[e];
+        }
+        ++ColorBits;
+        if (AlphaBits > 0)
+            ++AlphaBits;
+    }
+
+    for (Uint32 e = 0; e < NumEndpoints; ++e)
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+            Endpoints[e][c] = ExpandBC7Endpoint(Endpoints[e][c], ColorBits);
+        if (AlphaBits > 0)
+            Endpoints[e][3] = ExpandBC7Endpoint(Endpoints[e][3], AlphaBits);
+    }
+
+    Uint32 Indices[TexelsPerBlock];
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+        Indices[i] = Reader.Read(Info.IndexBits - (IsBC7AnchorTexel(Info.NumSubsets, Partition, i) ? 1 : 0));
+
+    Uint32 SecondaryIndices[TexelsPerBlock] = {};
+    if (Info.SecondaryIndexBits != 0)
+    {
+        for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+            SecondaryIndices[i] = Reader.Read(Info.SecondaryIndexBits - (i == 0 ? 1 : 0));
+    }
+
+    const Uint8* ColorWeights = GetBC7Weights(Info.IndexBits);
+    const Uint8* AlphaWeights = ColorWeights;
+    const auto*  ColorIndices = Indices;
+    const auto*  AlphaIndices = Indices;
+    if (Info.SecondaryIndexBits != 0)
+    {
+        const Uint8* SecondaryWeights = GetBC7Weights(Info.SecondaryIndexBits);
+        if (IndexSelection == 0)
+        {
+            AlphaWeights = SecondaryWeights;
+            AlphaIndices = SecondaryIndices;
+        }
+        else
+        {
+            ColorWeights = SecondaryWeights;
+            ColorIndices = SecondaryIndices;
+        }
+    }
+
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        const Uint32  Subset = GetBC7Subset(Info.NumSubsets, Partition, i);
+        const Uint32* E0     = Endpoints[Subset * 2];
+        const Uint32* E1     = Endpoints[Subset * 2 + 1];
+
+        Uint8* pTexel = pTexels[i];
+        for (Uint32 c = 0; c < 3; ++c)
+            pTexel[c] = static_cast<Uint8>(InterpolateBC7(E0[c], E1[c], ColorWeights[ColorIndices[i]]));
+        pTexel[3] = static_cast<Uint8>(InterpolateBC7(E0[3], E1[3], AlphaWeights[AlphaIndices[i]]));
+
+        if (Rotation != 0)
+            std::swap(pTexel[Rotation - 1], pTexel[3]);
+    }
+}
+
+// Writes a BC7 block in the mode that has no rotation and no secondary indices.
+// Endpoints contain the quantized values without p-bits.
+void WriteBC7Block(Uint32 Mode, Uint32 Partition, const Uint32 (*Endpoints)[4], const Uint32* PBits, const Uint8* pIndices, Uint8* pBlock)
+{
+    const BC7ModeInfo& Info = BC7Modes[Mode];
+    VERIFY_EXPR(Info.RotationBits == 0 && Info.IndexSelectionBits == 0 && Info.SecondaryIndexBits == 0);
+
+    const Uint32 NumEndpoints = Info.NumSubsets * 2u;
+
+    BC7BitWriter Writer{pBlock};
+    Writer.Write(1u << Mode, Mode + 1);
+    Writer.Write(Partition, Info.PartitionBits);
+    for (Uint32 c = 0; c < 3; ++c)
+    {
+        for (Uint32 e = 0; e < NumEndpoints; ++e)
+            Writer.Write(Endpoints[e][c], Info.ColorBits);
+    }
+    if (Info.AlphaBits > 0)
+    {
+        for (Uint32 e = 0; e < NumEndpoints; ++e)
+            Writer.Write(Endpoints[e][3], Info.AlphaBits);
+    }
+    if (Info.EndpointPBits != 0)
+    {
+        for (Uint32 e = 0; e < NumEndpoints; ++e)
+            Writer.Write(PBits[e], 1);
+    }
+    else if (Info.SharedPBits != 0)
+    {
+        for (Uint32 s = 0; s < Info.NumSubsets; ++s)
+            Writer.Write(PBits[s], 1);
+    }
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+        Writer.Write(pIndices[i], Info.IndexBits - (IsBC7AnchorTexel(Info.NumSubsets, Partition, i) ? 1 : 0));
+    VERIFY_EXPR(Writer.GetPosition() == 128);
+}
+
+// Quantized endpoints of a BC7 subset
+struct BC7SubsetEndpoints
+{
+    Uint32 Values[2][4] = {}; // Without p-bits
+    Uint32 PBits[2]     = {};
+    Uint32 Expanded[2][4]; // 8-bit values
+};
+
+// Quantizes the endpoints to ColorBits with a p-bit per endpoint (SharedPBit == false)
+// or a p-bit shared by both endpoints (SharedPBit == true).
+BC7SubsetEndpoints QuantizeBC7Endpoints(const float E0[4], const float E1[4], Uint32 NumChannels, Uint32 ColorBits, bool SharedPBit)
+{
+    const Uint32 MaxValue = (1u << ColorBits) - 1;
+    const float* E[2]     = {E0, E1};
+
+    BC7SubsetEndpoints Res;
+    float              PBitErrors[2][2] = {};
+    Uint32             Values[2][2][4]  = {};
+    for (Uint32 e = 0; e < 2; ++e)
+    {
+        for (Uint32 p = 0; p < 2; ++p)
+        {
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                // Full-precision value is (Value << 1) | p, expanded to 8 bits
+                const float Target  = Clamp(E[e][c], 0.f, 255.f);
+                const int   Guess   = RoundToInt((Target * static_cast<float>(2 * MaxValue + 1) / 255.f - static_cast<float>(p)) / 2.f);
+                float       BestErr = FLT_MAX;
+                for (int v = Guess - 1; v <= Guess + 1; ++v)
+                {
+                    if (v < 0 || v > static_cast<int>(MaxValue))
+                        continue;
+                    const Uint32 Expanded = ExpandBC7Endpoint((static_cast<Uint32>(v) << 1) | p, ColorBits + 1);
+                    const float  Err      = (static_cast<float>(Expanded) - Target) * (static_cast<float>(Expanded) - Target);
+                    if (Err < BestErr)
+                    {
+                        BestErr         = Err;
+                        Values[e][p][c] = static_cast<Uint32>(v);
+                    }
+                }
+                PBitErrors[e][p] += BestErr;
+            }
+        }
+    }
+
+    for (Uint32 e = 0; e < 2; ++e)
+    {
+        if (SharedPBit)
+            Res.PBits[e] = (PBitErrors[0][1] + PBitErrors[1][1] < PBitErrors[0][0] + PBitErrors[1][0]) ? 1 : 0;
+        else
+            Res.PBits[e] = PBitErrors[e][1] < PBitErrors[e][0] ? 1 : 0;
+
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            Res.Values[e][c]   = c < NumChannels ? Values[e][Res.PBits[e]][c] : MaxValue;
+            Res.Expanded[e][c] = ExpandBC7Endpoint((Res.Values[e][c] << 1) | Res.PBits[e], ColorBits + 1);
+        }
+    }
+    return Res;
+}
+
+// Finds the indices for the texels of the subset and returns the squared error
+float EvaluateBC7Subset(const BlockTexels& Block, Uint32 NumChannels, Uint32 Mask, const BC7SubsetEndpoints& Endpoints, Uint32 IndexBits, Uint8* pIndices)
+{
+    const Uint8* Weights     = GetBC7Weights(IndexBits);
+    const Uint32 PaletteSize = 1u << IndexBits;
+
+    float Palette[16][4];
+    for (Uint32 k = 0; k < PaletteSize; ++k)
+    {
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            Palette[k][c] = static_cast<float>(InterpolateBC7(Endpoints.Expanded[0][c], Endpoints.Expanded[1][c], Weights[k]));
+    }
+
+    Uint8 Indices[TexelsPerBlock];
+    float Errors[TexelsPerBlock];
+    FindNearestPaletteEntries(Block.Ch, NumChannels, Palette, PaletteSize, Indices, Errors);
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        if (Mask & (1u << i))
+            pIndices[i] = Indices[i];
+    }
+    return GetMaskedError(Errors, Mask);
+}
+
+// Fits, quantizes and optionally refines the endpoints of a BC7 subset. Returns the squared error.
+float EncodeBC7Subset(const BlockTexels&        Block,
+                      Uint32                    NumChannels,
+                      Uint32                    Mask,
+                      Uint32                    ColorBits,
+                      bool                      SharedPBit,
+                      Uint32                    IndexBits,
+                      BLOCK_COMPRESSION_QUALITY Quality,
+                      BC7SubsetEndpoints&       Endpoints,
+                      Uint8*                    pIndices)
+{
+    float E0[4], E1[4];
+    if (Quality == BLOCK_COMPRESSION_QUALITY_FAST)
+        FitBoundingBox(Block, NumChannels, Mask, 0.f, E0, E1);
+    else
+        FitPrincipalAxis(Block, NumChannels, Mask, E0, E1);
+
+    Endpoints   = QuantizeBC7Endpoints(E0, E1, NumChannels, ColorBits, SharedPBit);
+    float Error = EvaluateBC7Subset(Block, NumChannels, Mask, Endpoints, IndexBits, pIndices);
+
+    if (Quality != BLOCK_COMPRESSION_QUALITY_FAST)
+    {
+        const Uint8* Weights8 = GetBC7Weights(IndexBits);
+        float        Weights[16];
+        for (Uint32 k = 0; k < (1u << IndexBits); ++k)
+            Weights[k] = static_cast<float>(Weights8[k]) / 64.f;
+
+        for (Uint32 Iter = 0; Iter < 2 && Error > 0; ++Iter)
+        {
+            if (!RefineEndpoints(Block, NumChannels, Mask, pIndices, Weights, E0, E1))
+                break;
+
+            const BC7SubsetEndpoints NewEndpoints = QuantizeBC7Endpoints(E0, E1, NumChannels, ColorBits, SharedPBit);
+
+            Uint8       NewIndices[TexelsPerBlock];
+            const float NewError = EvaluateBC7Subset(Block, NumChannels, Mask, NewEndpoints, IndexBits, NewIndices);
+            if (NewError >= Error)
+                break;
+
+            Error     = NewError;
+            Endpoints = NewEndpoints;
+            for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+            {
+                if (Mask & (1u << i))
+                    pIndices[i] = NewIndices[i];
+            }
+        }
+    }
+
+    return Error;
+}
+
+// Swaps the endpoints of the subset if the index of its anchor texel has the most significant bit set
+void FixBC7AnchorIndex(Uint32 Mask, Uint32 AnchorTexel, Uint32 IndexBits, BC7SubsetEndpoints& Endpoints, Uint8* pIndices)
+{
+    const Uint32 MaxIndex = (1u << IndexBits) - 1;
+    if (pIndices[AnchorTexel] <= (MaxIndex >> 1))
+        return;
+
+    std::swap(Endpoints.Values[0], Endpoints.Values[1]);
+    std::swap(Endpoints.PBits[0], Endpoints.PBits[1]);
+    std::swap(Endpoints.Expanded[0], Endpoints.Expanded[1]);
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        if (Mask & (1u << i))
+            pIndices[i] = static_cast<Uint8>(MaxIndex - pIndices[i]);
+    }
+}
+
+// Mode 6: one subset, 7-bit RGBA endpoints with a p-bit per endpoint, 4-bit indices
+float EncodeBC7Mode6(const BlockTexels& Block, BLOCK_COMPRESSION_QUALITY Quality, Uint8* pBlock)
+{
+    BC7SubsetEndpoints Endpoints;
+    Uint8              Indices[TexelsPerBlock];
+
+    const float Error = EncodeBC7Subset(Block, 4, AllTexelsMask, 7, false, 4, Quality, Endpoints, Indices);
+    FixBC7AnchorIndex(AllTexelsMask, 0, 4, Endpoints, Indices);
+    WriteBC7Block(6, 0, Endpoints.Values, Endpoints.PBits, Indices, pBlock);
+    return Error;
+}
+
+// Mode 1: two subsets, 6-bit RGB endpoints with a shared p-bit per subset, 3-bit indices.
+// Partitions are ranked by the residual of the line fit, and the best candidates are fully encoded.
+float EncodeBC7Mode1(const BlockTexels& Block, BLOCK_COMPRESSION_QUALITY Quality, Uint8* pBlock)
+{
+    constexpr Uint32 NumCandidates = 4;
+
+    // Moments of every texel: count, R, G, B, RR, RG, RB, GG, GB, BB.
+    // The moments of a subset are the sums of the moments of its texels.
+    constexpr Uint32 NumMoments = 10;
+
+    float TexelMoments[TexelsPerBlock][NumMoments];
+    float TotalMoments[NumMoments] = {};
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        const float R = Block.Ch[0][i];
+        const float G = Block.Ch[1][i];
+        const float B = Block.Ch[2][i];
+
+        const float Moments[NumMoments] = {1, R, G, B, R * R, R * G, R * B, G * G, G * B, B * B};
+        for (Uint32 m = 0; m < NumMoments; ++m)
+        {
+            TexelMoments[i][m] = Moments[m];
+            TotalMoments[m] += Moments[m];
+        }
+    }
+
+    // Residual of the line fit is the sum of the variances minus the largest eigenvalue of the covariance matrix.
+    auto GetLineFitResidual = [](const float M[NumMoments]) {
+        if (M[0] == 0)
+            return 0.f;
+
+        const float InvCount = 1.f / M[0];
+
+        float Cov[3][3];
+        Cov[0][0] = M[4] - M[1] * M[1] * InvCount;
+        Cov[0][1] = Cov[1][0] = M[5] - M[1] * M[2] * InvCount;
+        Cov[0][2] = Cov[2][0] = M[6] - M[1] * M[3] * InvCount;
+        Cov[1][1]             = M[7] - M[2] * M[2] * InvCount;
+        Cov[1][2] = Cov[2][1] = M[8] - M[2] * M[3] * InvCount;
+        Cov[2][2]             = M[9] - M[3] * M[3] * InvCount;
+
+        // Power iteration starting with the column of the largest variance. The Rayleigh quotient
+        // does not depend on the axis length, so the axis is not normalized between the iterations.
+        const Uint32 MaxVarChannel = (Cov[0][0] >= Cov[1][1] && Cov[0][0] >= Cov[2][2]) ? 0 : (Cov[1][1] >= Cov[2][2] ? 1 : 2);
+
+        float Axis[3] = {Cov[0][MaxVarChannel], Cov[1][MaxVarChannel], Cov[2][MaxVarChannel]};
+        for (Uint32 Iter = 0; Iter < 2; ++Iter)
+        {
+            const float NewAxis[3] = {
+                Cov[0][0] * Axis[0] + Cov[0][1] * Axis[1] + Cov[0][2] * Axis[2],
+                Cov[1][0] * Axis[0] + Cov[1][1] * Axis[1] + Cov[1][2] * Axis[2],
+                Cov[2][0] * Axis[0] + Cov[2][1] * Axis[1] + Cov[2][2] * Axis[2],
+            };
+            Axis[0] = NewAxis[0];
+            Axis[1] = NewAxis[1];
+            Axis[2] = NewAxis[2];
+        }
+
+        float Num = 0, Den = 0;
+        for (Uint32 c0 = 0; c0 < 3; ++c0)
+        {
+            const float CovAxis = Cov[c0][0] * Axis[0] + Cov[c0][1] * Axis[1] + Cov[c0][2] * Axis[2];
+            Num += Axis[c0] * CovAxis;
+            Den += Axis[c0] * Axis[c0];
+        }
+        const float Trace = Cov[0][0] + Cov[1][1] + Cov[2][2];
+        if (Den < 1e-6f)
+            return Trace;
+        return std::max(Trace - Num / Den, 0.f);
+    };
+
+    Uint32 Candidates[NumCandidates] = {};
+    float  CandidateResiduals[NumCandidates];
+    std::fill_n(CandidateResiduals, NumCandidates, FLT_MAX);
+    for (Uint32 Partition = 0; Partition < 64; ++Partition)
+    {
+        float Moments1[NumMoments] = {};
+        for (Uint32 Mask1 = BC7Partitions2[Partition]; Mask1 != 0; Mask1 &= Mask1 - 1)
+        {
+            const float* pTexelMoments = TexelMoments[PlatformMisc::GetLSB(Mask1)];
+            for (Uint32 m = 0; m < NumMoments; ++m)
+                Moments1[m] += pTexelMoments[m];
+        }
+        float Moments0[NumMoments];
+        for (Uint32 m = 0; m < NumMoments; ++m)
+            Moments0[m] = TotalMoments[m] - Moments1[m];
+
+        const float Residual = GetLineFitResidual(Moments0) + GetLineFitResidual(Moments1);
+
+        // Insert into the sorted candidate list
+        Uint32 Pos = NumCandidates;
+        while (Pos > 0 && Residual < CandidateResiduals[Pos - 1])
+            --Pos;
+        if (Pos == NumCandidates)
+            continue;
+        for (Uint32 i = NumCandidates - 1; i > Pos; --i)
+        {
+            Candidates[i]         = Candidates[i - 1];
+            CandidateResiduals[i] = CandidateResiduals[i - 1];
+        }
+        Candidates[Pos]         = Partition;
+        CandidateResiduals[Pos] = Residual;
+    }
+
+    float              BestError     = FLT_MAX;
+    Uint32             BestPartition = 0;
+    BC7SubsetEndpoints BestEndpoints[2];
+    Uint8              BestIndices[TexelsPerBlock] = {};
+    for (Uint32 Partition : Candidates)
+    {
+        const Uint32 Masks[2] = {AllTexelsMask & ~Uint32{BC7Partitions2[Partition]}, Uint32{BC7Partitions2[Partition]}};
+
+        BC7SubsetEndpoints Endpoints[2];
+        Uint8              Indices[TexelsPerBlock];
+        float              Error = 0;
+        for (Uint32 s = 0; s < 2; ++s)
+            Error += EncodeBC7Subset(Block, 3, Masks[s], 6, true, 3, Quality, Endpoints[s], Indices);
+
+        if (Error < BestError)
+        {
+            BestError        = Error;
+            BestPartition    = Partition;
+            BestEndpoints[0] = Endpoints[0];
+            BestEndpoints[1] = Endpoints[1];
+            std::memcpy(BestIndices, Indices, sizeof(Indices));
+        }
+    }
+
+    const Uint32 Mask1 = BC7Partitions2[BestPartition];
+    FixBC7AnchorIndex(AllTexelsMask & ~Mask1, 0, 3, BestEndpoints[0], BestIndices);
+    FixBC7AnchorIndex(Mask1, BC7Anchors2[BestPartition], 3, BestEndpoints[1], BestIndices);
+
+    const Uint32 Endpoints[4][4] =
+        {
+            {BestEndpoints[0].Values[0][0], BestEndpoints[0].Values[0][1], BestEndpoints[0].Values[0][2], 0},
+            {BestEndpoints[0].Values[1][0], BestEndpoints[0].Values[1][1], BestEndpoints[0].Values[1][2], 0},
+            {BestEndpoints[1].Values[0][0], BestEndpoints[1].Values[0][1], BestEndpoints[1].Values[0][2], 0},
+            {BestEndpoints[1].Values[1][0], BestEndpoints[1].Values[1][1], BestEndpoints[1].Values[1][2], 0},
+        };
+    const Uint32 PBits[2] = {BestEndpoints[0].PBits[0], BestEndpoints[1].PBits[0]};
+    WriteBC7Block(1, BestPartition, Endpoints, PBits, BestIndices, pBlock);
+    return BestError;
+}
+
+void EncodeBC7Block(const BlockTexels& Block, BLOCK_COMPRESSION_QUALITY Quality, Uint8* pBlock)
+{
+    const float Mode6Error = EncodeBC7Mode6(Block, Quality, pBlock);
+    if (Quality == BLOCK_COMPRESSION_QUALITY_FAST || Mode6Error == 0)
+        return;
+
+    bool IsOpaque = true;
+    for (Uint32 i = 0; i < TexelsPerBlock && IsOpaque; ++i)
+        IsOpaque = Block.Ch[3][i] == 255.f;
+    if (!IsOpaque)
+        return;
+
+    Uint8 Mode1Block[16];
+    if (EncodeBC7Mode1(Block, Quality, Mode1Block) < Mode6Error)
+        std::memcpy(pBlock, Mode1Block, sizeof(Mode1Block));
+}
+
+
+// BC6H endpoint components: w and x are the endpoints of the first region,
+// y and z are the endpoints of the second region.
+// clang-format off
+enum BC6H_COMPONENT : Uint8
+{
+    Rw, Gw, Bw,
+    Rx, Gx, Bx,
+    Ry, Gy, By,
+    Rz, Gz, Bz
+};
+// clang-format on
+
+// A run of endpoint bits stored in the block: NumBits bits of the component starting with bit Shift
+struct BC6HField
+{
+    Uint8 Component;
+    Uint8 Shift;
+    Uint8 NumBits;
+};
+
+// BC6H modes, see https://learn.microsoft.com/en-us/windows/win32/direct3d11/bc6h-format
+struct BC6HModeInfo
+{
+    Uint8     Mode;
+    Uint8     NumRegions;
+    bool      IsTransformed;
+    Uint8     EndpointBits;
+    Uint8     DeltaBits[3];
+    BC6HField Layout[24];
+};
+
+// clang-format off
+constexpr BC6HModeInfo BC6HModes[14] =
+{
+    // Mode NR    T    EB   Delta bits
+    {0x00, 2, true,  10, {5, 5, 5},
+        {{Gy, 4, 1}, {By, 4, 1}, {Bz, 4, 1}, {Rw, 0, 10}, {Gw, 0, 10}, {Bw, 0, 10}, {Rx, 0, 5}, {Gz, 4, 1}, {Gy, 0, 4}, {Gx, 0, 5},
+         {Bz, 0, 1}, {Gz, 0, 4}, {Bx, 0, 5}, {Bz, 1, 1}, {By, 0, 4}, {Ry, 0, 5}, {Bz, 2, 1}, {Rz, 0, 5}, {Bz, 3, 1}}},
+    {0x01, 2, true,   7, {6, 6, 6},
+        {{Gy, 5, 1}, {Gz, 4, 2}, {Rw, 0, 7}, {Bz, 0, 2}, {By, 4, 1}, {Gw, 0, 7}, {By, 5, 1}, {Bz, 2, 1}, {Gy, 4, 1}, {Bw, 0, 7},
+         {Bz, 3, 1}, {Bz, 5, 1}, {Bz, 4, 1}, {Rx, 0, 6}, {Gy, 0, 4}, {Gx, 0, 6}, {Gz, 0, 4}, {Bx, 0, 6}, {By, 0, 4}, {Ry, 0, 6},
+         {Rz, 0, 6}}},
+    {0x02, 2, true,  11, {5, 4, 4},
+        {{Rw, 0, 10}, {Gw, 0, 10}, {Bw, 0, 10}, {Rx, 0, 5}, {Rw, 10, 1}, {Gy, 0, 4}, {Gx, 0, 4}, {Gw, 10, 1}, {Bz, 0, 1}, {Gz, 0, 4},
+         {Bx, 0, 4}, {Bw, 10, 1}, {Bz, 1, 1}, {By, 0, 4}, {Ry, 0, 5}, {Bz, 2, 1}, {Rz, 0, 5}, {Bz, 3, 1}}},
+    {0x06, 2, true,  11, {4, 5, 4},
+        {{Rw, 0, 10}, {Gw, 0, 10}, {Bw, 0, 10}, {Rx, 0, 4}, {Rw, 10, 1}, {Gz, 4, 1}, {Gy, 0, 4}, {Gx, 0, 5}, {Gw, 10, 1}, {Gz, 0, 4},
+         {Bx, 0, 4}, {Bw, 10, 1}, {Bz, 1, 1}, {By, 0, 4}, {Ry, 0, 4}, {Bz, 0, 1}, {Bz, 2, 1}, {Rz, 0, 4}, {Gy, 4, 1}, {Bz, 3, 1}}},
+    {0x0A, 2, true,  11, {4, 4, 5},
+        {{Rw, 0, 10}, {Gw, 0, 10}, {Bw, 0, 10}, {Rx, 0, 4}, {Rw, 10, 1}, {By, 4, 1}, {Gy, 0, 4}, {Gx, 0, 4}, {Gw, 10, 1}, {Bz, 0, 1},
+         {Gz, 0, 4}, {Bx, 0, 5}, {Bw, 10, 1}, {By, 0, 4}, {Ry, 0, 4}, {Bz, 1, 2}, {Rz, 0, 4}, {Bz, 4, 1}, {Bz, 3, 1}}},
+    {0x0E, 2, true,   9, {5, 5, 5},
+        {{Rw, 0, 9}, {By, 4, 1}, {Gw, 0, 9}, {Gy, 4, 1}, {Bw, 0, 9}, {Bz, 4, 1}, {Rx, 0, 5}, {Gz, 4, 1}, {Gy, 0, 4}, {Gx, 0, 5},
+         {Bz, 0, 1}, {Gz, 0, 4}, {Bx, 0, 5}, {Bz, 1, 1}, {By, 0, 4}, {Ry, 0, 5}, {Bz, 2, 1}, {Rz, 0, 5}, {Bz, 3, 1}}},
+    {0x12, 2, true,   8, {6, 5, 5},
+        {{Rw, 0, 8}, {Gz, 4, 1}, {By, 4, 1}, {Gw, 0, 8}, {Bz, 2, 1}, {Gy, 4, 1}, {Bw, 0, 8}, {Bz, 3, 2}, {Rx, 0, 6}, {Gy, 0, 4},
+         {Gx, 0, 5}, {Bz, 0, 1}, {Gz, 0, 4}, {Bx, 0, 5}, {Bz, 1, 1}, {By, 0, 4}, {Ry, 0, 6}, {Rz, 0, 6}}},
+    {0x16, 2, true,   8, {5, 6, 5},
+        {{Rw, 0, 8}, {Bz, 0, 1}, {By, 4, 1}, {Gw, 0, 8}, {Gy, 5, 1}, {Gy, 4, 1}, {Bw, 0, 8}, {Gz, 5, 1}, {Bz, 4, 1}, {Rx, 0, 5},
+         {Gz, 4, 1}, {Gy, 0, 4}, {Gx, 0, 6}, {Gz, 0, 4}, {Bx, 0, 5}, {Bz, 1, 1}, {By, 0, 4}, {Ry, 0, 5}, {Bz, 2, 1}, {Rz, 0, 5},
+         {Bz, 3, 1}}},
+    {0x1A, 2, true,   8, {5, 5, 6},
+        {{Rw, 0, 8}, {Bz, 1, 1}, {By, 4, 1}, {Gw, 0, 8}, {By, 5, 1}, {Gy, 4, 1}, {Bw, 0, 8}, {Bz, 5, 1}, {Bz, 4, 1}, {Rx, 0, 5},
+         {Gz, 4, 1}, {Gy, 0, 4}, {Gx, 0, 5}, {Bz, 0, 1}, {Gz, 0, 4}, {Bx, 0, 6}, {By, 0, 4}, {Ry, 0, 5}, {Bz, 2, 1}, {Rz, 0, 5},
+         {Bz, 3, 1}}},
+    {0x1E, 2, false,  6, {6, 6, 6},
+        {{Rw, 0, 6}, {Gz, 4, 1}, {Bz, 0, 2}, {By, 4, 1}, {Gw, 0, 6}, {Gy, 5, 1}, {By, 5, 1}, {Bz, 2, 1}, {Gy, 4, 1}, {Bw, 0, 6},
+         {Gz, 5, 1}, {Bz, 3, 1}, {Bz, 5, 1}, {Bz, 4, 1}, {Rx, 0, 6}, {Gy, 0, 4}, {Gx, 0, 6}, {Gz, 0, 4}, {Bx, 0, 6}, {By, 0, 4},
+         {Ry, 0, 6}, {Rz, 0, 6}}},
+    {0x03, 1, false, 10, {10, 10, 10},
+        {{Rw, 0, 10}, {Gw, 0, 10}, {Bw, 0, 10}, {Rx, 0, 10}, {Gx, 0, 10}, {Bx, 0, 10}}},
+    {0x07, 1, true,  11, {9, 9, 9},
+        {{Rw, 0, 10}, {Gw, 0, 10}, {Bw, 0, 10}, {Rx, 0, 9}, {Rw, 10, 1}, {Gx, 0, 9}, {Gw, 10, 1}, {Bx, 0, 9}, {Bw, 10, 1}}},
+    // The most significant bits of w are stored in reverse order
+    {0x0B, 1, true,  12, {8, 8, 8},
+        {{Rw, 0, 10}, {Gw, 0, 10}, {Bw, 0, 10}, {Rx, 0, 8}, {Rw, 11, 1}, {Rw, 10, 1}, {Gx, 0, 8}, {Gw, 11, 1}, {Gw, 10, 1}, {Bx, 0, 8},
+         {Bw, 11, 1}, {Bw, 10, 1}}},
+    {0x0F, 1, true,  16, {4, 4, 4},
+        {{Rw, 0, 10}, {Gw, 0, 10}, {Bw, 0, 10},
+         {Rx, 0, 4}, {Rw, 15, 1}, {Rw, 14, 1}, {Rw, 13, 1}, {Rw, 12, 1}, {Rw, 11, 1}, {Rw, 10, 1},
+         {Gx, 0, 4}, {Gw, 15, 1}, {Gw, 14, 1}, {Gw, 13, 1}, {Gw, 12, 1}, {Gw, 11, 1}, {Gw, 10, 1},
+         {Bx, 0, 4}, {Bw, 15, 1}, {Bw, 14, 1}, {Bw, 13, 1}, {Bw, 12, 1}, {Bw, 11, 1}, {Bw, 10, 1}}},
+};
+// clang-format on
+
+int SignExtend(int Value, Uint32 Bits)
+{
+    const int SignBit = 1 << (Bits - 1);
+    return ((Value & ((1 << Bits) - 1)) ^ SignBit) - SignBit;
+}
+
+// Expands the endpoint component to 16 bits (unsigned) or 15 bits plus sign (signed)
+int UnquantizeBC6HEndpoint(int Value, Uint32 Bits, bool IsSigned)
+{
+    if (!IsSigned)
+    {
+        if (Bits >= 15 || Value == 0)
+            return Value;
+        if (Value == (1 << Bits) - 1)
+            return 0xFFFF;
+        return ((Value << 16) + 0x8000) >> Bits;
+    }
+
+    if (Bits >= 16)
+        return Value;
+
+    const bool IsNegative = Value < 0;
+    const int  Magnitude  = IsNegative ? -Value : Value;
+
+    int Unquantized = 0;
+    if (Magnitude == 0)
+        Unquantized = 0;
+    else if (Magnitude >= (1 << (Bits - 1)) - 1)
+        Unquantized = 0x7FFF;
+    else
+        Unquantized = ((Magnitude << 15) + 0x4000) >> (Bits - 1);
+    return IsNegative ? -Unquantized : Unquantized;
+}
+
+// Scales the interpolated value to the half-precision float range and returns its bit pattern
+Uint16 FinishUnquantizeBC6H(int Value, bool IsSigned)
+{
+    if (!IsSigned)
+        return static_cast<Uint16>((Value * 31) >> 6);
+
+    return Value < 0 ?
+        static_cast<Uint16>(0x8000 | (((-Value) * 31) >> 5)) :
+        static_cast<Uint16>((Value * 31) >> 5);
+}
+
+// Decodes the block to RGBA16_FLOAT texels
+void DecodeBC6HBlock(const Uint8* pBlock, bool IsSigned, Uint16 (*pTexels)[4])
+{
+    static constexpr Uint16 HalfOne = 0x3C00;
+
+    BC7BitReader Reader{pBlock};
+
+    Uint32 Mode = Reader.Read(2);
+    if (Mode >= 2)
+        Mode |= Reader.Read(3) << 2;
+
+    const BC6HModeInfo* pInfo = nullptr;
+    for (const BC6HModeInfo& Info : BC6HModes)
+    {
+        if (Info.Mode == Mode)
+            pInfo = &Info;
+    }
+    if (pInfo == nullptr)
+    {
+        // Reserved mode
+        for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+        {
+            pTexels[i][0] = pTexels[i][1] = pTexels[i][2] = 0;
+            pTexels[i][3]                                 = HalfOne;
+        }
+        return;
+    }
+    const BC6HModeInfo& Info = *pInfo;
+
+    int Endpoints[4][3] = {};
+    for (const BC6HField& Field : Info.Layout)
+    {
+        if (Field.NumBits == 0)
+            break;
+        Endpoints[Field.Component / 3][Field.Component % 3] |= static_cast<int>(Reader.Read(Field.NumBits) << Field.Shift);
+    }
+    const Uint32 Partition    = Info.NumRegions > 1 ? Reader.Read(5) : 0;
+    const Uint32 NumEndpoints = Info.NumRegions * 2u;
+
+    for (Uint32 c = 0; c < 3; ++c)
+    {
+        if (IsSigned)
+            Endpoints[0][c] = SignExtend(Endpoints[0][c], Info.EndpointBits);
+
+        // Transformed modes store the other endpoints as signed deltas from the first one
+        if (IsSigned || Info.IsTransformed)
+        {
+            const Uint32 Bits = Info.IsTransformed ? Info.DeltaBits[c] : Info.EndpointBits;
+            for (Uint32 e = 1; e < NumEndpoints; ++e)
+                Endpoints[e][c] = SignExtend(Endpoints[e][c], Bits);
+        }
+
+        if (Info.IsTransformed)
+        {
+            for (Uint32 e = 1; e < NumEndpoints; ++e)
+            {
+                Endpoints[e][c] = (Endpoints[0][c] + Endpoints[e][c]) & ((1 << Info.EndpointBits) - 1);
+                if (IsSigned)
+                    Endpoints[e][c] = SignExtend(Endpoints[e][c], Info.EndpointBits);
+            }
+        }
+
+        for (Uint32 e = 0; e < NumEndpoints; ++e)
+            Endpoints[e][c] = UnquantizeBC6HEndpoint(Endpoints[e][c], Info.EndpointBits, IsSigned);
+    }
+
+    const Uint32 IndexBits = Info.NumRegions > 1 ? 3 : 4;
+    const Uint8* Weights   = GetBC7Weights(IndexBits);
+    for (Uint32 i = 0; i < TexelsPerBlock; ++i)
+    {
+        const Uint32 Index  = Reader.Read(IndexBits - (IsBC7AnchorTexel(Info.NumRegions, Partition, i) ? 1 : 0));
+        const Uint32 Region = GetBC7Subset(Info.NumRegions, Partition, i);
+        const int*   E0     = Endpoints[Region * 2];
+        const int*   E1     = Endpoints[Region * 2 + 1];
+        const int    Weight = Weights[Index];
+        for (Uint32 c = 0; c < 3; ++c)
+            pTexels[i][c] = FinishUnquantizeBC6H(((64 - Weight) * E0[c] + Weight * E1[c] + 32) >> 6, IsSigned);
+        pTexels[i][3] = HalfOne;
+    }
+}
+
+
+// The format of the uncompressed texels that are encoded into the blocks
+TEXTURE_FORMAT GetUncompressedBlockFormat(TEXTURE_FORMAT Format)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_UNORM:
+        case TEX_FORMAT_BC2_UNORM:
+        case TEX_FORMAT_BC3_UNORM:
+        case TEX_FORMAT_BC7_UNORM:
+            return TEX_FORMAT_RGBA8_UNORM;
+
+        case TEX_FORMAT_BC1_UNORM_SRGB:
+        case TEX_FORMAT_BC2_UNORM_SRGB:
+        case TEX_FORMAT_BC3_UNORM_SRGB:
+        case TEX_FORMAT_BC7_UNORM_SRGB:
+            return TEX_FORMAT_RGBA8_UNORM_SRGB;
+
+        case TEX_FORMAT_BC4_UNORM: return TEX_FORMAT_R8_UNORM;
+        case TEX_FORMAT_BC4_SNORM: return TEX_FORMAT_R8_SNORM;
+        case TEX_FORMAT_BC5_UNORM: return TEX_FORMAT_RG8_UNORM;
+        case TEX_FORMAT_BC5_SNORM: return TEX_FORMAT_RG8_SNORM;
+
+        default:
+            return TEX_FORMAT_UNKNOWN;
+    }
+}
+
+// The format of the texels that the blocks are decoded to. Unlike GetUncompressedBlockFormat,
+// includes the formats that can only be decoded.
+TEXTURE_FORMAT GetDecodedBlockFormat(TEXTURE_FORMAT Format)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BC6H_UF16:
+        case TEX_FORMAT_BC6H_SF16:
+            return TEX_FORMAT_RGBA16_FLOAT;
+
+        default:
+            return GetUncompressedBlockFormat(Format);
+    }
+}
+
+void LoadBlockTexels(const Uint8* pTexels, size_t Stride, Uint32 NumChannels, bool IsSigned, BlockTexels& Block)
+{
+    for (Uint32 y = 0; y < BlockDim; ++y)
+    {
+        const Uint8* pRow = pTexels + y * Stride;
+        for (Uint32 x = 0; x < BlockDim; ++x)
+        {
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                const Uint8 Val               = pRow[x * NumChannels + c];
+                Block.Ch[c][y * BlockDim + x] = IsSigned ?
+                    static_cast<float>(std::max(static_cast<int>(static_cast<Int8>(Val)), -127)) :
+                    static_cast<float>(Val);
+            }
+        }
+    }
+}
+
+void EncodeBlock(TEXTURE_FORMAT Format, const BlockTexels& Block, BLOCK_COMPRESSION_QUALITY Quality, Uint8* pBlock)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_UNORM:
+        case TEX_FORMAT_BC1_UNORM_SRGB:
+            EncodeBC1ColorBlock(Block, true, Quality, pBlock);
+            break;
+
+        case TEX_FORMAT_BC2_UNORM:
+        case TEX_FORMAT_BC2_UNORM_SRGB:
+            EncodeBC2AlphaBlock(Block, pBlock);
+            EncodeBC1ColorBlock(Block, false, Quality, pBlock + 8);
+            break;
+
+        case TEX_FORMAT_BC3_UNORM:
+        case TEX_FORMAT_BC3_UNORM_SRGB:
+            EncodeBC4Block(Block, 3, false, Quality, pBlock);
+            EncodeBC1ColorBlock(Block, false, Quality, pBlock + 8);
+            break;
+
+        case TEX_FORMAT_BC4_UNORM:
+        case TEX_FORMAT_BC4_SNORM:
+            EncodeBC4Block(Block, 0, Format == TEX_FORMAT_BC4_SNORM, Quality, pBlock);
+            break;
+
+        case TEX_FORMAT_BC5_UNORM:
+        case TEX_FORMAT_BC5_SNORM:
+            EncodeBC4Block(Block, 0, Format == TEX_FORMAT_BC5_SNORM, Quality, pBlock);
+            EncodeBC4Block(Block, 1, Format == TEX_FORMAT_BC5_SNORM, Quality, pBlock + 8);
+            break;
+
+        case TEX_FORMAT_BC7_UNORM:
+        case TEX_FORMAT_BC7_UNORM_SRGB:
+            EncodeBC7Block(Block, Quality, pBlock);
+            break;
+
+        default:
+            UNEXPECTED("Unexpected block-compressed format");
+    }
+}
+
+// Copies the first NumChannels components of every texel to the rows of the texel data
+template <typename ComponentType>
+void StoreBlockTexels(const ComponentType (*RGBA)[4], Uint32 NumChannels, Uint8* pTexels, size_t Stride)
+{
+    const size_t TexelSize = sizeof(ComponentType) * NumChannels;
+    for (Uint32 y = 0; y < BlockDim; ++y)
+    {
+        Uint8* pRow = pTexels + y * Stride;
+        for (Uint32 x = 0; x < BlockDim; ++x)
+            std::memcpy(pRow + x * TexelSize, RGBA[y * BlockDim + x], TexelSize);
+    }
+}
+
+// Decodes the block to the decoded block format
+void DecodeBlock(TEXTURE_FORMAT Format, const Uint8* pBlock, Uint8* pTexels, size_t Stride)
+{
+    const Uint32 NumChannels = GetTextureFormatAttribs(GetDecodedBlockFormat(Format)).NumComponents;
+    if (Format == TEX_FORMAT_BC6H_UF16 || Format == TEX_FORMAT_BC6H_SF16)
+    {
+        Uint16 RGBA[TexelsPerBlock][4];
+        DecodeBC6HBlock(pBlock, Format == TEX_FORMAT_BC6H_SF16, RGBA);
+        StoreBlockTexels(RGBA, NumChannels, pTexels, Stride);
+        return;
+    }
+
+    Uint8 RGBA[TexelsPerBlock][4];
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_UNORM:
+        case TEX_FORMAT_BC1_UNORM_SRGB:
+            DecodeBC1ColorBlock(pBlock, false, RGBA);
+            break;
+
+        case TEX_FORMAT_BC2_UNORM:
+        case TEX_FORMAT_BC2_UNORM_SRGB:
+            DecodeBC1ColorBlock(pBlock + 8, true, RGBA);
+            DecodeBC2AlphaBlock(pBlock, RGBA);
+            break;
+
+        case TEX_FORMAT_BC3_UNORM:
+        case TEX_FORMAT_BC3_UNORM_SRGB:
+            DecodeBC1ColorBlock(pBlock + 8, true, RGBA);
+            DecodeBC4Block(pBlock, false, &RGBA[0][3], 4);
+            break;
+
+        case TEX_FORMAT_BC4_UNORM:
+        case TEX_FORMAT_BC4_SNORM:
+            DecodeBC4Block(pBlock, Format == TEX_FORMAT_BC4_SNORM, &RGBA[0][0], 4);
+            break;
+
+        case TEX_FORMAT_BC5_UNORM:
+        case TEX_FORMAT_BC5_SNORM:
+            DecodeBC4Block(pBlock, Format == TEX_FORMAT_BC5_SNORM, &RGBA[0][0], 4);
+            DecodeBC4Block(pBlock + 8, Format == TEX_FORMAT_BC5_SNORM, &RGBA[0][1], 4);
+            break;
+
+        case TEX_FORMAT_BC7_UNORM:
+        case TEX_FORMAT_BC7_UNORM_SRGB:
+            DecodeBC7Block(pBlock, RGBA);
+            break;
+
+        default:
+            UNEXPECTED("Unexpected block-compressed format");
+            std::memset(RGBA, 0, sizeof(RGBA));
+    }
+    StoreBlockTexels(RGBA, NumChannels, pTexels, Stride);
+}
+
+} // namespace
+
+
+bool IsBlockCompressionSupported(TEXTURE_FORMAT Format)
+{
+    return GetUncompressedBlockFormat(Format) != TEX_FORMAT_UNKNOWN;
+}
+
+bool IsBlockDecompressionSupported(TEXTURE_FORMAT Format)
+{
+    return GetDecodedBlockFormat(Format) != TEX_FORMAT_UNKNOWN;
+}
+
+bool CompressTextureData(const CompressTextureDataAttribs& Attribs)
+{
+    const TEXTURE_FORMAT BlockTexelFormat = GetUncompressedBlockFormat(Attribs.DstFormat);
+    if (BlockTexelFormat == TEX_FORMAT_UNKNOWN || !IsTextureFormatConversionSupported(Attribs.SrcFormat, BlockTexelFormat))
+        return false;
+
+    if (Attribs.Width == 0 || Attribs.Height == 0)
+        return true;
+
+    DEV_CHECK_ERR(Attribs.pSrcData != nullptr, "Source data must not be null");
+    DEV_CHECK_ERR(Attribs.pDstData != nullptr, "Destination data must not be null");
+    DEV_CHECK_ERR(Attribs.Quality < BLOCK_COMPRESSION_QUALITY_COUNT, "Invalid compression quality");
+
+    const TextureFormatAttribs& DstFmtAttribs = GetTextureFormatAttribs(Attribs.DstFormat);
+
+    const Uint32 Width        = Attribs.Width;
+    const Uint32 Height       = Attribs.Height;
+    const Uint32 NumBlocksX   = (Width + BlockDim - 1) / BlockDim;
+    const Uint32 NumBlocksY   = (Height + BlockDim - 1) / BlockDim;
+    const Uint32 BlockSize    = DstFmtAttribs.GetElementSize();
+    const Uint32 NumChannels  = GetTextureFormatAttribs(BlockTexelFormat).NumComponents;
+    const bool   IsSigned     = GetTextureFormatAttribs(BlockTexelFormat).ComponentType == COMPONENT_TYPE_SNORM;
+    const size_t TexelsStride = size_t{NumBlocksX} * BlockDim * NumChannels;
+    DEV_CHECK_ERR(NumBlocksY == 1 || Attribs.DstStride >= size_t{NumBlocksX} * BlockSize,
+                  "Destination stride (", Attribs.DstStride, ") must be at least ", size_t{NumBlocksX} * BlockSize);
+
+    const Uint8* const pSrcData = static_cast<const Uint8*>(Attribs.pSrcData);
+    Uint8* const       pDstData = static_cast<Uint8*>(Attribs.pDstData);
+
+    const Uint32 RowsPerChunk = std::max(CompressChunkSize / NumBlocksX, 1u);
+    const Uint32 NumChunks    = (NumBlocksY + RowsPerChunk - 1) / RowsPerChunk;
+
+    ParallelFor(NumChunks > 1 ? Attribs.pThreadPool : nullptr, NumChunks,
+                [&](Uint32 Chunk) {
+                    std::vector<Uint8> Texels(TexelsStride * BlockDim);
+
+                    const Uint32 StartRow = Chunk * RowsPerChunk;
+                    const Uint32 EndRow   = std::min(StartRow + RowsPerChunk, NumBlocksY);
+                    for (Uint32 by = StartRow; by < EndRow; ++by)
+                    {
+                        const Uint32 NumRows = std::min(Height - by * BlockDim, BlockDim);
+
+                        ConvertTextureDataAttribs ConvertAttribs;
+                        ConvertAttribs.Width     = Width;
+                        ConvertAttribs.Height    = NumRows;
+                        ConvertAttribs.SrcFormat = Attribs.SrcFormat;
+                        ConvertAttribs.pSrcData  = pSrcData + size_t{by} * BlockDim * Attribs.SrcStride;
+                        ConvertAttribs.SrcStride = Attribs.SrcStride;
+                        ConvertAttribs.DstFormat = BlockTexelFormat;
+                        ConvertAttribs.pDstData  = Texels.data();
+                        ConvertAttribs.DstStride = TexelsStride;
+                        if (!ConvertTextureData(ConvertAttribs))
+                            UNEXPECTED("Conversion is expected to be supported");
+
+                        // Replicate the edge texels to fill the partial blocks
+                        for (Uint32 y = 0; y < NumRows; ++y)
+                        {
+                            Uint8* pRow = &Texels[y * TexelsStride];
+                            for (Uint32 x = Width; x < NumBlocksX * BlockDim; ++x)
+                                std::memcpy(pRow + x * NumChannels, pRow + (Width - 1) * NumChannels, NumChannels);
+                        }
+                        for (Uint32 y = NumRows; y < BlockDim; ++y)
+                            std::memcpy(&Texels[y * TexelsStride], &Texels[(NumRows - 1) * TexelsStride], TexelsStride);
+
+                        Uint8* pDstRow = pDstData + size_t{by} * Attribs.DstStride;
+                        for (Uint32 bx = 0; bx < NumBlocksX; ++bx)
+                        {
+                            BlockTexels Block;
+                            LoadBlockTexels(&Texels[bx * BlockDim * NumChannels], TexelsStride, NumChannels, IsSigned, Block);
+                            EncodeBlock(Attribs.DstFormat, Block, Attribs.Quality, pDstRow + bx * BlockSize);
+                        }
+                    }
+                });
+
+    return true;
+}
+
+bool DecompressTextureData(const DecompressTextureDataAttribs& Attribs)
+{
+    const TEXTURE_FORMAT BlockTexelFormat = GetDecodedBlockFormat(Attribs.SrcFormat);
+    if (BlockTexelFormat == TEX_FORMAT_UNKNOWN || !IsTextureFormatConversionSupported(BlockTexelFormat, Attribs.DstFormat))
+        return false;
+
+    if (Attribs.Width == 0 || Attribs.Height == 0)
+        return true;
+
+    DEV_CHECK_ERR(Attribs.pSrcData != nullptr, "Source data must not be null");
+    DEV_CHECK_ERR(Attribs.pDstData != nullptr, "Destination data must not be null");
+
+    const TextureFormatAttribs& SrcFmtAttribs = GetTextureFormatAttribs(Attribs.SrcFormat);
+
+    const Uint32 Width        = Attribs.Width;
+    const Uint32 Height       = Attribs.Height;
+    const Uint32 NumBlocksX   = (Width + BlockDim - 1) / BlockDim;
+    const Uint32 NumBlocksY   = (Height + BlockDim - 1) / BlockDim;
+    const Uint32 BlockSize    = SrcFmtAttribs.GetElementSize();
+    const Uint32 TexelSize    = GetTextureFormatAttribs(BlockTexelFormat).GetElementSize();
+    const size_t TexelsStride = size_t{NumBlocksX} * BlockDim * TexelSize;
+    DEV_CHECK_ERR(NumBlocksY == 1 || Attribs.SrcStride >= size_t{NumBlocksX} * BlockSize,
+                  "Source stride (", Attribs.SrcStride, ") must be at least ", size_t{NumBlocksX} * BlockSize);
+
+    const Uint8* const pSrcData = static_cast<const Uint8*>(Attribs.pSrcData);
+    Uint8* const       pDstData = static_cast<Uint8*>(Attribs.pDstData);
+
+    const Uint32 RowsPerChunk = std::max(DecompressChunkSize / NumBlocksX, 1u);
+    const Uint32 NumChunks    = (NumBlocksY + RowsPerChunk - 1) / RowsPerChunk;
+
+    ParallelFor(NumChunks > 1 ? Attribs.pThreadPool : nullptr, NumChunks,
+                [&](Uint32 Chunk) {
+                    std::vector<Uint8> Texels(TexelsStride * BlockDim);
+
+                    const Uint32 StartRow = Chunk * RowsPerChunk;
+                    const Uint32 EndRow   = std::min(StartRow + RowsPerChunk, NumBlocksY);
+                    for (Uint32 by = StartRow; by < EndRow; ++by)
+                    {
+                        const Uint8* pSrcRow = pSrcData + size_t{by} * Attribs.SrcStride;
+                        for (Uint32 bx = 0; bx < NumBlocksX; ++bx)
+                            DecodeBlock(Attribs.SrcFormat, pSrcRow + bx * BlockSize, &Texels[bx * BlockDim * TexelSize], TexelsStride);
+
+                        ConvertTextureDataAttribs ConvertAttribs;
+                        ConvertAttribs.Width     = Width;
+                        ConvertAttribs.Height    = std::min(Height - by * BlockDim, BlockDim);
+                        ConvertAttribs.SrcFormat = BlockTexelFormat;
+                        ConvertAttribs.pSrcData  = Texels.data();
+                        ConvertAttribs.SrcStride = TexelsStride;
+                        ConvertAttribs.DstFormat = Attribs.DstFormat;
+                        ConvertAttribs.pDstData  = pDstData + size_t{by} * BlockDim * Attribs.DstStride;
+                        ConvertAttribs.DstStride = Attribs.DstStride;
+                        if (!ConvertTextureData(ConvertAttribs))
+                            UNEXPECTED("Conversion is expected to be supported");
+                    }
+                });
+
+    return true;
+}
+
+} // namespace Diligent
@@ -29,12 +29,14 @@
 
 #include <mutex>
 #include <atomic>
+#include <vector>
 
 #include "DebugUtilities.hpp"
 #include "ObjectBase.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "DynamicBuffer.hpp"
 #include "VariableSizeAllocationsManager.hpp"
+#include "TLSFAllocationsManager.hpp"
 #include "Align.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
@@ -42,23 +44,29 @@
 namespace Diligent
 {
 
+template <typename AllocationsManagerType>
 class BufferSuballocatorImpl;
 
+template <typename AllocationsManagerType>
 class BufferSuballocationImpl final : public ObjectBase<IBufferSuballocation>
 {
 public:
-    using TBase = ObjectBase<IBufferSuballocation>;
+    using TBase                  = ObjectBase<IBufferSuballocation>;
+    using BufferSuballocatorType = BufferSuballocatorImpl<AllocationsManagerType>;
+
     BufferSuballocationImpl(IReferenceCounters*                          pRefCounters,
-                            BufferSuballocatorImpl*                      pParentAllocator,
+                            BufferSuballocatorType*                      pParentAllocator,
                             Uint32                                       Offset,
                             Uint32                                       Size,
+                            Uint32                                       Alignment,
                             VariableSizeAllocationsManager::Allocation&& Subregion) :
         // clang-format off
         TBase             {pRefCounters},
         m_pParentAllocator{pParentAllocator},
         m_Subregion       {std::move(Subregion)},
         m_Offset          {Offset},
-        m_Size            {Size}
+        m_Size            {Size},
+        m_Alignment       {Alignment}
     // clang-format on
     {
         VERIFY_EXPR(m_pParentAllocator);
@@ -71,7 +79,7 @@ public:
 
     virtual ReferenceCounterValueType DILIGENT_CALL_TYPE Release() override final
     {
-        RefCntAutoPtr<BufferSuballocatorImpl> pParent;
+        RefCntAutoPtr<BufferSuballocatorType> pParent;
         return TBase::Release(
             [&]() //
             {
@@ -107,21 +115,34 @@ public:
         return m_pUserData;
     }
 
+    const VariableSizeAllocationsManager::Allocation& GetSubregion() const
+    {
+        return m_Subregion;
+    }
+
+    Uint32 GetAlignment() const
+    {
+        return m_Alignment;
+    }
+
 private:
-    RefCntAutoPtr<BufferSuballocatorImpl> m_pParentAllocator;
+    RefCntAutoPtr<BufferSuballocatorType> m_pParentAllocator;
 
     VariableSizeAllocationsManager::Allocation m_Subregion;
 
     const Uint32 m_Offset;
     const Uint32 m_Size;
+    const Uint32 m_Alignment;
 
     RefCntAutoPtr<IObject> m_pUserData;
 };
 
+template <typename AllocationsManagerType>
 class BufferSuballocatorImpl final : public ObjectBase<IBufferSuballocator>
 {
 public:
-    using TBase = ObjectBase<IBufferSuballocator>;
+    using TBase                   = ObjectBase<IBufferSuballocator>;
+    using BufferSuballocationType = BufferSuballocationImpl<AllocationsManagerType>;
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_BufferSuballocator, TBase)
 
@@ -162,8 +183,8 @@ public:
         m_BufferSize{m_Buffer.GetDesc().Size},
         m_SuballocationsAllocator{
             DefaultRawMemoryAllocator::GetAllocator(),
-            sizeof(BufferSuballocationImpl),
-            1024u / Uint32{sizeof(BufferSuballocationImpl)} // Use 1 Kb pages.
+            sizeof(BufferSuballocationType),
+            1024u / Uint32{sizeof(BufferSuballocationType)} // Use 1 Kb pages.
         }
     {
     }
@@ -257,12 +278,13 @@ public:
         if (Subregion.IsValid())
         {
             // clang-format off
-            BufferSuballocationImpl* pSuballocation{
-                NEW_RC_OBJ(m_SuballocationsAllocator, "BufferSuballocationImpl instance", BufferSuballocationImpl)
+            BufferSuballocationType* pSuballocation{
+                NEW_RC_OBJ(m_SuballocationsAllocator, "BufferSuballocationImpl instance", BufferSuballocationType)
                 (
                     this,
                     AlignUp(static_cast<Uint32>(Subregion.UnalignedOffset), Alignment),
                     Size,
+                    Alignment,
                     std::move(Subregion)
                 )
             };
@@ -286,28 +308,126 @@ public:
         return m_Buffer.GetVersion();
     }
 
+    virtual Uint32 PlanDefragmentation(const BufferSuballocatorDefragmentationAttribs& Attribs,
+                                       IBufferSuballocation**                          ppNewSuballocations) override final
+    {
+        if (Attribs.NumSuballocations == 0)
+            return 0;
+
+        if (Attribs.ppSuballocations == nullptr)
+        {
+            UNEXPECTED("ppSuballocations must not be null");
+            return 0;
+        }
+
+        if (ppNewSuballocations == nullptr)
+        {
+            UNEXPECTED("ppNewSuballocations must not be null");
+            return 0;
+        }
+
+        std::vector<VariableSizeAllocationsManager::Allocation> Subregions(Attribs.NumSuballocations);
+        std::vector<VariableSizeAllocationsManager::OffsetType> Alignments(Attribs.NumSuballocations);
+        for (Uint32 i = 0; i < Attribs.NumSuballocations; ++i)
+        {
+            DEV_CHECK_ERR(ppNewSuballocations[i] == nullptr, "Overwriting reference to existing object may cause memory leaks");
+            ppNewSuballocations[i] = nullptr;
+
+            auto* pSuballocation = Attribs.ppSuballocations[i];
+            if (pSuballocation == nullptr || pSuballocation->GetAllocator() != this)
+            {
+                UNEXPECTED("Suballocation ", i, " is null or was not created by this suballocator");
+                return 0;
+            }
+
+            const auto* pSuballocImpl = ClassPtrCast<BufferSuballocationType>(pSuballocation);
+            Subregions[i]             = pSuballocImpl->GetSubregion();
+            Alignments[i]             = pSuballocImpl->GetAlignment();
+        }
+
+        VariableSizeAllocationsManager::DefragmentationAttribs MgrAttribs;
+        MgrAttribs.pAllocations   = Subregions.data();
+        MgrAttribs.pAlignments    = Alignments.data();
+        MgrAttribs.NumAllocations = Subregions.size();
+        MgrAttribs.MaxMoves       = Attribs.MaxMoves;
+        MgrAttribs.MaxBytesToMove = StaticCast<VariableSizeAllocationsManager::OffsetType>(std::min(Attribs.MaxBytesToMove, Uint64{~VariableSizeAllocationsManager::OffsetType{0}}));
+
+        std::vector<VariableSizeAllocationsManager::DefragmentationMove> Moves;
+        {
+            std::lock_guard<std::mutex> Lock{m_MgrMtx};
+            Moves = m_Mgr.PlanDefragmentation(MgrAttribs);
+            UpdateUsageStats();
+        }
+
+        for (auto& Move : Moves)
+        {
+            const auto* pSrcSuballoc = ClassPtrCast<const BufferSuballocationType>(Attribs.ppSuballocations[Move.AllocationIndex]);
+            VERIFY_EXPR(Move.DstOffset == AlignUp(Move.NewAllocation.UnalignedOffset, Alignments[Move.AllocationIndex]));
+
+            // clang-format off
+            BufferSuballocationType* pSuballocation{
+                NEW_RC_OBJ(m_SuballocationsAllocator, "BufferSuballocationImpl instance", BufferSuballocationType)
+                (
+                    this,
+                    static_cast<Uint32>(Move.DstOffset),
+                    pSrcSuballoc->GetSize(),
+                    pSrcSuballoc->GetAlignment(),
+                    std::move(Move.NewAllocation)
+                )
+            };
+            // clang-format on
+            pSuballocation->SetUserData(pSrcSuballoc->GetUserData());
+
+            pSuballocation->QueryInterface(IID_BufferSuballocation, reinterpret_cast<IObject**>(&ppNewSuballocations[Move.AllocationIndex]));
+            m_AllocationCount.fetch_add(1);
+        }
+
+        return static_cast<Uint32>(Moves.size());
+    }
+
     virtual void GetUsageStats(BufferSuballocatorUsageStats& UsageStats) override final
     {
-        // NB: mutex must not be locked here to avoid stalling render thread
+        // NB: mutex must not be waited for here to avoid stalling render thread
         UsageStats.CommittedSize    = m_BufferSize.load();
         UsageStats.UsedSize         = m_UsedSize.load();
-        UsageStats.MaxFreeChunkSize = m_MaxFreeBlockSize.load();
+        UsageStats.FreeSize         = m_FreeSize.load();
+        UsageStats.MaxFreeChunkSize = GetMaxFreeBlockSize();
         UsageStats.AllocationCount  = m_AllocationCount.load();
+        UsageStats.FreeChunkCount   = m_FreeBlockCount.load();
     }
 
 private:
+    // The maximum free block size is not updated by every allocation as it may be expensive
+    // to compute (the TLSF manager scans the free blocks of the largest size class). Instead,
+    // it is recomputed when the stats are requested. If the manager is busy, the last value is returned.
+    Uint64 GetMaxFreeBlockSize()
+    {
+        if (m_MaxFreeBlockSizeDirty.load())
+        {
+            std::unique_lock<std::mutex> Lock{m_MgrMtx, std::try_to_lock};
+            if (Lock.owns_lock())
+            {
+                m_MaxFreeBlockSize.store(m_Mgr.GetMaxFreeBlockSize());
+                m_MaxFreeBlockSizeDirty.store(false);
+            }
+        }
+        return m_MaxFreeBlockSize.load();
+    }
+
     void UpdateUsageStats()
     {
         m_UsedSize.store(m_Mgr.GetUsedSize());
-        m_MaxFreeBlockSize.store(m_Mgr.GetMaxFreeBlockSize());
+        m_FreeSize.store(m_Mgr.GetFreeSize());
+        m_MaxFreeBlockSizeDirty.store(true);
+        m_FreeBlockCount.store(static_cast<Uint32>(m_Mgr.GetNumFreeBlocks()));
     }
 
 private:
     const Uint64 m_MaxSize;
     const Uint32 m_ExpansionSize;
 
-    std::mutex                     m_MgrMtx;
-    VariableSizeAllocationsManager m_Mgr;
+    std::mutex             m_MgrMtx;
+    AllocationsManagerType m_Mgr;
 
     std::atomic<VariableSizeAllocationsManager::OffsetType> m_MgrSize{0};
 
@@ -316,28 +436,35 @@ private:
 
     std::atomic<Int32>  m_AllocationCount{0};
     std::atomic<Uint64> m_UsedSize{0};
+    std::atomic<Uint64> m_FreeSize{0};
     std::atomic<Uint64> m_MaxFreeBlockSize{0};
+    std::atomic<bool>   m_MaxFreeBlockSizeDirty{true};
+    std::atomic<Uint32> m_FreeBlockCount{0};
 
     FixedBlockMemoryAllocator m_SuballocationsAllocator;
 };
 
 
-BufferSuballocationImpl::~BufferSuballocationImpl()
+template <typename AllocationsManagerType>
+BufferSuballocationImpl<AllocationsManagerType>::~BufferSuballocationImpl()
 {
     m_pParentAllocator->Free(std::move(m_Subregion));
 }
 
-IBufferSuballocator* BufferSuballocationImpl::GetAllocator()
+template <typename AllocationsManagerType>
+IBufferSuballocator* BufferSuballocationImpl<AllocationsManagerType>::GetAllocator()
 {
     return m_pParentAllocator;
 }
 
-IBuffer* BufferSuballocationImpl::Update(IRenderDevice* pDevice, IDeviceContext* pContext)
+template <typename AllocationsManagerType>
+IBuffer* BufferSuballocationImpl<AllocationsManagerType>::Update(IRenderDevice* pDevice, IDeviceContext* pContext)
 {
     return m_pParentAllocator->Update(pDevice, pContext);
 }
 
-IBuffer* BufferSuballocationImpl::GetBuffer() const
+template <typename AllocationsManagerType>
+IBuffer* BufferSuballocationImpl<AllocationsManagerType>::GetBuffer() const
 {
     return m_pParentAllocator->GetBuffer();
 }
@@ -349,7 +476,20 @@ void CreateBufferSuballocator(IRenderDevice*                      pDevice,
 {
     try
     {
-        auto* pAllocator = MakeNewRCObj<BufferSuballocatorImpl>()(pDevice, CreateInfo);
+        IBufferSuballocator* pAllocator = nullptr;
+        switch (CreateInfo.Algorithm)
+        {
+            case SUBALLOCATION_ALGORITHM_BEST_FIT:
+                pAllocator = MakeNewRCObj<BufferSuballocatorImpl<VariableSizeAllocationsManager>>()(pDevice, CreateInfo);
+                break;
+
+            case SUBALLOCATION_ALGORITHM_TLSF:
+                pAllocator = MakeNewRCObj<BufferSuballocatorImpl<TLSFAllocationsManager>>()(pDevice, CreateInfo);
+                break;
+
+            default:
+                LOG_ERROR_AND_THROW("Unknown suballocation algorithm ", Uint32{CreateInfo.Algorithm});
+        }
         pAllocator->QueryInterface(IID_BufferSuballocator, reinterpret_cast<IObject**>(ppBufferSuballocator));
     }
     catch (...)
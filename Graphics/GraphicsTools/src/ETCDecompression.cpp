@@ -0,0 +1,570 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ETCDecompression.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "RenderDevice.h"
+#include "GraphicsAccessories.hpp"
+#include "TextureFormatConverter.hpp"
+#include "ThreadPool.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// The number of blocks processed by a single parallel task
+constexpr Uint32 DecompressChunkSize = 1u << 12;
+
+constexpr Uint32 BlockDim       = 4;
+constexpr Uint32 TexelsPerBlock = BlockDim * BlockDim;
+
+// clang-format off
+// Intensity modifiers of the individual and differential modes
+constexpr int ETCModifiers[8][4] =
+{
+    { 2,   8,  -2,   -8},
+    { 5,  17,  -5,  -17},
+    { 9,  29,  -9,  -29},
+    {13,  42, -13,  -42},
+    {18,  60, -18,  -60},
+    {24,  80, -24,  -80},
+    {33, 106, -33, -106},
+    {47, 183, -47, -183},
+};
+
+// Distances of the T and H modes
+constexpr int ETCDistances[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+// EAC modifiers
+constexpr int EACModifiers[16][8] =
+{
+    {-3, -6,  -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5,  -8, -13, 1, 4, 7, 12},
+    {-2, -4,  -6, -13, 1, 3, 5, 12},
+    {-3, -6,  -8, -12, 2, 5, 7, 11},
+    {-3, -7,  -9, -11, 2, 6, 8, 10},
+    {-4, -7,  -8, -11, 3, 6, 7, 10},
+    {-3, -5,  -8, -11, 2, 4, 7, 10},
+    {-2, -6,  -8, -10, 1, 5, 7,  9},
+    {-2, -5,  -8, -10, 1, 4, 7,  9},
+    {-2, -4,  -8, -10, 1, 3, 7,  9},
+    {-2, -5,  -7, -10, 1, 4, 6,  9},
+    {-3, -4,  -7, -10, 2, 3, 6,  9},
+    {-1, -2,  -3, -10, 0, 1, 2,  9},
+    {-4, -6,  -8,  -9, 3, 5, 7,  8},
+    {-3, -5,  -7,  -9, 2, 4, 6,  8},
+};
+// clang-format on
+
+// ETC blocks are stored as big-endian 64-bit values
+Uint64 ReadBigEndian64(const Uint8* pData)
+{
+    Uint64 Value = 0;
+    for (Uint32 i = 0; i < 8; ++i)
+        Value = (Value << 8) | pData[i];
+    return Value;
+}
+
+int GetBits(Uint64 Block, Uint32 Offset, Uint32 Count)
+{
+    return static_cast<int>((Block >> Offset) & ((Uint64{1} << Count) - 1));
+}
+
+int Extend4(int Value) { return (Value << 4) | Value; }
+int Extend5(int Value) { return (Value << 3) | (Value >> 2); }
+int Extend6(int Value) { return (Value << 2) | (Value >> 4); }
+int Extend7(int Value) { return (Value << 1) | (Value >> 6); }
+
+Uint8 ClampToUint8(int Value)
+{
+    return static_cast<Uint8>(std::min(std::max(Value, 0), 255));
+}
+
+// Decodes the ETC2 RGB block. Texels are stored row by row.
+// If PunchThroughAlpha is true, the differential bit is the opaque bit.
+void DecodeETC2ColorBlock(const Uint8* pBlock, bool PunchThroughAlpha, Uint8 (*pTexels)[4])
+{
+    const Uint64 Block = ReadBigEndian64(pBlock);
+
+    // Texel indices are stored column by column: the most significant bits
+    // are in bits 16-31, and the least significant bits are in bits 0-15.
+    auto GetIndex = [Block](Uint32 x, Uint32 y) {
+        const Uint32 k = x * BlockDim + y;
+        return (GetBits(Block, k + 16, 1) << 1) | GetBits(Block, k, 1);
+    };
+
+    auto WriteTexel = [pTexels](Uint32 x, Uint32 y, int R, int G, int B, Uint8 A) {
+        Uint8* pTexel = pTexels[y * BlockDim + x];
+        pTexel[0]     = ClampToUint8(R);
+        pTexel[1]     = ClampToUint8(G);
+        pTexel[2]     = ClampToUint8(B);
+        pTexel[3]     = A;
+    };
+
+    // Punch-through alpha blocks with the opaque bit not set use index 2 for transparent black texels
+    const bool DiffBit      = GetBits(Block, 33, 1) != 0;
+    const bool IsOpaque     = !PunchThroughAlpha || DiffBit;
+    const bool Differential = PunchThroughAlpha || DiffBit;
+
+    auto DecodePaintColors = [&](const int(*PaintColors)[3]) {
+        for (Uint32 y = 0; y < BlockDim; ++y)
+        {
+            for (Uint32 x = 0; x < BlockDim; ++x)
+            {
+                const int Idx = GetIndex(x, y);
+                if (!IsOpaque && Idx == 2)
+                    WriteTexel(x, y, 0, 0, 0, 0);
+                else
+                    WriteTexel(x, y, PaintColors[Idx][0], PaintColors[Idx][1], PaintColors[Idx][2], 255);
+            }
+        }
+    };
+
+    int BaseColors[2][3];
+    if (!Differential)
+    {
+        // Individual mode: two 4-bit base colors
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            BaseColors[0][c] = Extend4(GetBits(Block, 60 - c * 8, 4));
+            BaseColors[1][c] = Extend4(GetBits(Block, 56 - c * 8, 4));
+        }
+    }
+    else
+    {
+        // Differential mode: 5-bit base color and 3-bit signed delta
+        int Colors[3], Deltas[3];
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            Colors[c] = GetBits(Block, 59 - c * 8, 5);
+            Deltas[c] = GetBits(Block, 56 - c * 8, 3);
+            if (Deltas[c] >= 4)
+                Deltas[c] -= 8;
+        }
+
+        auto IsOverflow = [&](Uint32 c) {
+            const int Sum = Colors[c] + Deltas[c];
+            return Sum < 0 || Sum > 31;
+        };
+
+        if (IsOverflow(0))
+        {
+            // T mode
+            const int C0[3] = {
+                Extend4((GetBits(Block, 59, 2) << 2) | GetBits(Block, 56, 2)),
+                Extend4(GetBits(Block, 52, 4)),
+                Extend4(GetBits(Block, 48, 4)),
+            };
+            const int C1[3] = {
+                Extend4(GetBits(Block, 44, 4)),
+                Extend4(GetBits(Block, 40, 4)),
+                Extend4(GetBits(Block, 36, 4)),
+            };
+            const int Distance = ETCDistances[(GetBits(Block, 34, 2) << 1) | GetBits(Block, 32, 1)];
+
+            const int PaintColors[4][3] = {
+                {C0[0], C0[1], C0[2]},
+                {C1[0] + Distance, C1[1] + Distance, C1[2] + Distance},
+                {C1[0], C1[1], C1[2]},
+                {C1[0] - Distance, C1[1] - Distance, C1[2] - Distance},
+            };
+            DecodePaintColors(PaintColors);
+            return;
+        }
+
+        if (IsOverflow(1))
+        {
+            // H mode
+            const int C0[3] = {
+                Extend4(GetBits(Block, 59, 4)),
+                Extend4((GetBits(Block, 56, 3) << 1) | GetBits(Block, 52, 1)),
+                Extend4((GetBits(Block, 51, 1) << 3) | GetBits(Block, 47, 3)),
+            };
+            const int C1[3] = {
+                Extend4(GetBits(Block, 43, 4)),
+                Extend4(GetBits(Block, 39, 4)),
+                Extend4(GetBits(Block, 35, 4)),
+            };
+
+            // The least significant bit of the distance index is given by the order of the base colors
+            const int Value0            = (C0[0] << 16) | (C0[1] << 8) | C0[2];
+            const int Value1            = (C1[0] << 16) | (C1[1] << 8) | C1[2];
+            const int Distance          = ETCDistances[(GetBits(Block, 34, 1) << 2) | (GetBits(Block, 32, 1) << 1) | (Value0 >= Value1 ? 1 : 0)];
+            const int PaintColors[4][3] = {
+                {C0[0] + Distance, C0[1] + Distance, C0[2] + Distance},
+                {C0[0] - Distance, C0[1] - Distance, C0[2] - Distance},
+                {C1[0] + Distance, C1[1] + Distance, C1[2] + Distance},
+                {C1[0] - Distance, C1[1] - Distance, C1[2] - Distance},
+            };
+            DecodePaintColors(PaintColors);
+            return;
+        }
+
+        if (IsOverflow(2))
+        {
+            // Planar mode: the colors are interpolated between the origin, horizontal and vertical colors.
+            // The mode ignores the opaque bit.
+            const int O[3] = {
+                Extend6(GetBits(Block, 57, 6)),
+                Extend7((GetBits(Block, 56, 1) << 6) | GetBits(Block, 49, 6)),
+                Extend6((GetBits(Block, 48, 1) << 5) | (GetBits(Block, 43, 2) << 3) | GetBits(Block, 39, 3)),
+            };
+            const int H[3] = {
+                Extend6((GetBits(Block, 34, 5) << 1) | GetBits(Block, 32, 1)),
+                Extend7(GetBits(Block, 25, 7)),
+                Extend6(GetBits(Block, 19, 6)),
+            };
+            const int V[3] = {
+                Extend6(GetBits(Block, 13, 6)),
+                Extend7(GetBits(Block, 6, 7)),
+                Extend6(GetBits(Block, 0, 6)),
+            };
+            for (Uint32 y = 0; y < BlockDim; ++y)
+            {
+                for (Uint32 x = 0; x < BlockDim; ++x)
+                {
+                    int Color[3];
+                    for (Uint32 c = 0; c < 3; ++c)
+                        Color[c] = (static_cast<int>(x) * (H[c] - O[c]) + static_cast<int>(y) * (V[c] - O[c]) + 4 * O[c] + 2) >> 2;
+                    WriteTexel(x, y, Color[0], Color[1], Color[2], 255);
+                }
+            }
+            return;
+        }
+
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            BaseColors[0][c] = Extend5(Colors[c]);
+            BaseColors[1][c] = Extend5(Colors[c] + Deltas[c]);
+        }
+    }
+
+    // Two 2x4 (flip bit is 0) or 4x2 (flip bit is 1) subblocks with their own base colors and modifier tables
+    const int  Tables[2] = {GetBits(Block, 37, 3), GetBits(Block, 34, 3)};
+    const bool Flip      = GetBits(Block, 32, 1) != 0;
+    for (Uint32 y = 0; y < BlockDim; ++y)
+    {
+        for (Uint32 x = 0; x < BlockDim; ++x)
+        {
+            const Uint32 Subblock = Flip ? (y >= 2 ? 1 : 0) : (x >= 2 ? 1 : 0);
+            const int    Idx      = GetIndex(x, y);
+            if (!IsOpaque && Idx == 2)
+            {
+                WriteTexel(x, y, 0, 0, 0, 0);
+                continue;
+            }
+
+            const int  Modifier = (!IsOpaque && Idx == 0) ? 0 : ETCModifiers[Tables[Subblock]][Idx];
+            const int* Base     = BaseColors[Subblock];
+            WriteTexel(x, y, Base[0] + Modifier, Base[1] + Modifier, Base[2] + Modifier, 255);
+        }
+    }
+}
+
+// Returns the EAC index of texel (x, y). Indices are stored column by column, starting with the most significant bits.
+int GetEACIndex(Uint64 Block, Uint32 x, Uint32 y)
+{
+    const Uint32 k = x * BlockDim + y;
+    return GetBits(Block, 45 - k * 3, 3);
+}
+
+// Decodes the EAC alpha block of the ETC2 RGBA8 format
+void DecodeEACAlphaBlock(const Uint8* pBlock, Uint8 (*pTexels)[4])
+{
+    const Uint64 Block      = ReadBigEndian64(pBlock);
+    const int    Base       = GetBits(Block, 56, 8);
+    const int    Multiplier = GetBits(Block, 52, 4);
+    const int*   Modifiers  = EACModifiers[GetBits(Block, 48, 4)];
+    for (Uint32 y = 0; y < BlockDim; ++y)
+    {
+        for (Uint32 x = 0; x < BlockDim; ++x)
+            pTexels[y * BlockDim + x][3] = ClampToUint8(Base + Modifiers[GetEACIndex(Block, x, y)] * Multiplier);
+    }
+}
+
+// Decodes the 11-bit EAC block to 16-bit UNORM or SNORM values, writing every TexelStride-th value starting with pValues
+void DecodeEAC11Block(const Uint8* pBlock, bool IsSigned, Uint16* pValues, Uint32 TexelStride)
+{
+    const Uint64 Block      = ReadBigEndian64(pBlock);
+    const int    Multiplier = GetBits(Block, 52, 4);
+    const int*   Modifiers  = EACModifiers[GetBits(Block, 48, 4)];
+
+    // Multiplier 0 uses the modifiers without scaling
+    const int Scale = Multiplier != 0 ? Multiplier * 8 : 1;
+
+    int Base = GetBits(Block, 56, 8);
+    if (IsSigned)
+    {
+        // -128 is mapped to -127
+        Base = std::max(static_cast<int>(static_cast<Int8>(Base)), -127) * 8;
+    }
+    else
+    {
+        Base = Base * 8 + 4;
+    }
+
+    for (Uint32 y = 0; y < BlockDim; ++y)
+    {
+        for (Uint32 x = 0; x < BlockDim; ++x)
+        {
+            const int Value = Base + Modifiers[GetEACIndex(Block, x, y)] * Scale;
+
+            // Extend 11-bit values to 16 bits by replicating the most significant bits
+            Uint16 Value16 = 0;
+            if (IsSigned)
+            {
+                const int Abs   = std::min(std::abs(Value), 1023);
+                const int Abs16 = (Abs << 5) | (Abs >> 5);
+                Value16         = static_cast<Uint16>(static_cast<Int16>(Value < 0 ? -Abs16 : Abs16));
+            }
+            else
+            {
+                const int Clamped = std::min(std::max(Value, 0), 2047);
+                Value16           = static_cast<Uint16>((Clamped << 5) | (Clamped >> 6));
+            }
+            pValues[(y * BlockDim + x) * TexelStride] = Value16;
+        }
+    }
+}
+
+struct ETCFormatInfo
+{
+    Uint32         BlockSize;
+    TEXTURE_FORMAT DecodedFormat;
+};
+
+ETCFormatInfo GetETCFormatInfo(ETC_FORMAT Format)
+{
+    switch (Format)
+    {
+        // clang-format off
+        case ETC_FORMAT_ETC2_RGB8:        return {8,  TEX_FORMAT_RGBA8_UNORM};
+        case ETC_FORMAT_ETC2_RGB8_SRGB:   return {8,  TEX_FORMAT_RGBA8_UNORM_SRGB};
+        case ETC_FORMAT_ETC2_RGB8A1:      return {8,  TEX_FORMAT_RGBA8_UNORM};
+        case ETC_FORMAT_ETC2_RGB8A1_SRGB: return {8,  TEX_FORMAT_RGBA8_UNORM_SRGB};
+        case ETC_FORMAT_ETC2_RGBA8:       return {16, TEX_FORMAT_RGBA8_UNORM};
+        case ETC_FORMAT_ETC2_RGBA8_SRGB:  return {16, TEX_FORMAT_RGBA8_UNORM_SRGB};
+        case ETC_FORMAT_EAC_R11_UNORM:    return {8,  TEX_FORMAT_R16_UNORM};
+        case ETC_FORMAT_EAC_R11_SNORM:    return {8,  TEX_FORMAT_R16_SNORM};
+        case ETC_FORMAT_EAC_RG11_UNORM:   return {16, TEX_FORMAT_RG16_UNORM};
+        case ETC_FORMAT_EAC_RG11_SNORM:   return {16, TEX_FORMAT_RG16_SNORM};
+        default:                          return {0,  TEX_FORMAT_UNKNOWN};
+            // clang-format on
+    }
+}
+
+// Decodes the block to the decoded format of the ETC format
+void DecodeETCBlock(ETC_FORMAT Format, const Uint8* pBlock, Uint8* pTexels, size_t Stride)
+{
+    Uint8  RGBA[TexelsPerBlock][4];
+    Uint16 RG[TexelsPerBlock][2];
+
+    const void* pBlockTexels = RGBA;
+    Uint32      TexelSize    = sizeof(RGBA[0]);
+    switch (Format)
+    {
+        case ETC_FORMAT_ETC2_RGB8:
+        case ETC_FORMAT_ETC2_RGB8_SRGB:
+            DecodeETC2ColorBlock(pBlock, false, RGBA);
+            break;
+
+        case ETC_FORMAT_ETC2_RGB8A1:
+        case ETC_FORMAT_ETC2_RGB8A1_SRGB:
+            DecodeETC2ColorBlock(pBlock, true, RGBA);
+            break;
+
+        case ETC_FORMAT_ETC2_RGBA8:
+        case ETC_FORMAT_ETC2_RGBA8_SRGB:
+            DecodeETC2ColorBlock(pBlock + 8, false, RGBA);
+            DecodeEACAlphaBlock(pBlock, RGBA);
+            break;
+
+        case ETC_FORMAT_EAC_R11_UNORM:
+        case ETC_FORMAT_EAC_R11_SNORM:
+            DecodeEAC11Block(pBlock, Format == ETC_FORMAT_EAC_R11_SNORM, &RG[0][0], 1);
+            pBlockTexels = RG;
+            TexelSize    = sizeof(RG[0][0]);
+            break;
+
+        case ETC_FORMAT_EAC_RG11_UNORM:
+        case ETC_FORMAT_EAC_RG11_SNORM:
+            DecodeEAC11Block(pBlock, Format == ETC_FORMAT_EAC_RG11_SNORM, &RG[0][0], 2);
+            DecodeEAC11Block(pBlock + 8, Format == ETC_FORMAT_EAC_RG11_SNORM, &RG[0][1], 2);
+            pBlockTexels = RG;
+            TexelSize    = sizeof(RG[0]);
+            break;
+
+        default:
+            UNEXPECTED("Unexpected ETC format");
+            return;
+    }
+
+    for (Uint32 y = 0; y < BlockDim; ++y)
+    {
+        for (Uint32 x = 0; x < BlockDim; ++x)
+        {
+            std::memcpy(pTexels + y * Stride + x * TexelSize,
+                        static_cast<const Uint8*>(pBlockTexels) + (y * BlockDim + x) * TexelSize,
+                        TexelSize);
+        }
+    }
+}
+
+} // namespace
+
+
+Uint32 GetETCBlockSize(ETC_FORMAT Format)
+{
+    return GetETCFormatInfo(Format).BlockSize;
+}
+
+bool DecompressETCData(const DecompressETCDataAttribs& Attribs)
+{
+    const ETCFormatInfo FmtInfo = GetETCFormatInfo(Attribs.SrcFormat);
+    if (FmtInfo.DecodedFormat == TEX_FORMAT_UNKNOWN)
+        return false;
+
+    // All decoded formats can be converted to the texel formats of block-compressed formats
+    const bool CompressDst = IsBlockCompressionSupported(Attribs.DstFormat);
+    if (!CompressDst && !IsTextureFormatConversionSupported(FmtInfo.DecodedFormat, Attribs.DstFormat))
+        return false;
+
+    if (Attribs.Width == 0 || Attribs.Height == 0)
+        return true;
+
+    DEV_CHECK_ERR(Attribs.pSrcData != nullptr, "Source data must not be null");
+    DEV_CHECK_ERR(Attribs.pDstData != nullptr, "Destination data must not be null");
+
+    const Uint32 Width        = Attribs.Width;
+    const Uint32 Height       = Attribs.Height;
+    const Uint32 NumBlocksX   = (Width + BlockDim - 1) / BlockDim;
+    const Uint32 NumBlocksY   = (Height + BlockDim - 1) / BlockDim;
+    const Uint32 TexelSize    = GetTextureFormatAttribs(FmtInfo.DecodedFormat).GetElementSize();
+    const size_t TexelsStride = size_t{NumBlocksX} * BlockDim * TexelSize;
+    DEV_CHECK_ERR(NumBlocksY == 1 || Attribs.SrcStride >= size_t{NumBlocksX} * FmtInfo.BlockSize,
+                  "Source stride (", Attribs.SrcStride, ") must be at least ", size_t{NumBlocksX} * FmtInfo.BlockSize);
+
+    const Uint8* const pSrcData = static_cast<const Uint8*>(Attribs.pSrcData);
+    Uint8* const       pDstData = static_cast<Uint8*>(Attribs.pDstData);
+
+    const Uint32 RowsPerChunk = std::max(DecompressChunkSize / NumBlocksX, 1u);
+    const Uint32 NumChunks    = (NumBlocksY + RowsPerChunk - 1) / RowsPerChunk;
+
+    ParallelFor(NumChunks > 1 ? Attribs.pThreadPool : nullptr, NumChunks,
+                [&](Uint32 Chunk) {
+                    const Uint32 StartRow = Chunk * RowsPerChunk;
+                    const Uint32 EndRow   = std::min(StartRow + RowsPerChunk, NumBlocksY);
+
+                    std::vector<Uint8> Texels(TexelsStride * BlockDim * (EndRow - StartRow));
+                    for (Uint32 by = StartRow; by < EndRow; ++by)
+                    {
+                        const Uint8* pSrcRow = pSrcData + size_t{by} * Attribs.SrcStride;
+                        Uint8*       pTexels = &Texels[(by - StartRow) * BlockDim * TexelsStride];
+                        for (Uint32 bx = 0; bx < NumBlocksX; ++bx)
+                            DecodeETCBlock(Attribs.SrcFormat, pSrcRow + bx * FmtInfo.BlockSize, pTexels + bx * BlockDim * TexelSize, TexelsStride);
+                    }
+
+                    const Uint32 ChunkHeight = std::min(EndRow * BlockDim, Height) - StartRow * BlockDim;
+                    if (CompressDst)
+                    {
+                        CompressTextureDataAttribs CompressAttribs;
+                        CompressAttribs.Width     = Width;
+                        CompressAttribs.Height    = ChunkHeight;
+                        CompressAttribs.SrcFormat = FmtInfo.DecodedFormat;
+                        CompressAttribs.pSrcData  = Texels.data();
+                        CompressAttribs.SrcStride = TexelsStride;
+                        CompressAttribs.DstFormat = Attribs.DstFormat;
+                        CompressAttribs.pDstData  = pDstData + size_t{StartRow} * Attribs.DstStride;
+                        CompressAttribs.DstStride = Attribs.DstStride;
+                        CompressAttribs.Quality   = Attribs.Quality;
+                        if (!CompressTextureData(CompressAttribs))
+                            UNEXPECTED("Compression is expected to be supported");
+                    }
+                    else
+                    {
+                        ConvertTextureDataAttribs ConvertAttribs;
+                        ConvertAttribs.Width     = Width;
+                        ConvertAttribs.Height    = ChunkHeight;
+                        ConvertAttribs.SrcFormat = FmtInfo.DecodedFormat;
+                        ConvertAttribs.pSrcData  = Texels.data();
+                        ConvertAttribs.SrcStride = TexelsStride;
+                        ConvertAttribs.DstFormat = Attribs.DstFormat;
+                        ConvertAttribs.pDstData  = pDstData + size_t{StartRow} * BlockDim * Attribs.DstStride;
+                        ConvertAttribs.DstStride = Attribs.DstStride;
+                        if (!ConvertTextureData(ConvertAttribs))
+                            UNEXPECTED("Conversion is expected to be supported");
+                    }
+                });
+
+    return true;
+}
+
+TEXTURE_FORMAT GetETCFallbackFormat(ETC_FORMAT Format, IRenderDevice* pDevice)
+{
+    auto IsSupported = [pDevice](TEXTURE_FORMAT Fmt) {
+        return pDevice->GetTextureFormatInfo(Fmt).Supported;
+    };
+
+    switch (Format)
+    {
+        case ETC_FORMAT_ETC2_RGB8:
+        case ETC_FORMAT_ETC2_RGB8A1:
+        case ETC_FORMAT_ETC2_RGBA8:
+            return pDevice != nullptr && IsSupported(TEX_FORMAT_BC7_UNORM) ? TEX_FORMAT_BC7_UNORM : TEX_FORMAT_RGBA8_UNORM;
+
+        case ETC_FORMAT_ETC2_RGB8_SRGB:
+        case ETC_FORMAT_ETC2_RGB8A1_SRGB:
+        case ETC_FORMAT_ETC2_RGBA8_SRGB:
+            return pDevice != nullptr && IsSupported(TEX_FORMAT_BC7_UNORM_SRGB) ? TEX_FORMAT_BC7_UNORM_SRGB : TEX_FORMAT_RGBA8_UNORM_SRGB;
+
+        case ETC_FORMAT_EAC_R11_UNORM:
+            return pDevice == nullptr || IsSupported(TEX_FORMAT_R16_UNORM) ? TEX_FORMAT_R16_UNORM : TEX_FORMAT_R8_UNORM;
+
+        case ETC_FORMAT_EAC_R11_SNORM:
+            return pDevice == nullptr || IsSupported(TEX_FORMAT_R16_SNORM) ? TEX_FORMAT_R16_SNORM : TEX_FORMAT_R8_SNORM;
+
+        case ETC_FORMAT_EAC_RG11_UNORM:
+            return pDevice == nullptr || IsSupported(TEX_FORMAT_RG16_UNORM) ? TEX_FORMAT_RG16_UNORM : TEX_FORMAT_RG8_UNORM;
+
+        case ETC_FORMAT_EAC_RG11_SNORM:
+            return pDevice == nullptr || IsSupported(TEX_FORMAT_RG16_SNORM) ? TEX_FORMAT_RG16_SNORM : TEX_FORMAT_RG8_SNORM;
+
+        default:
+            UNEXPECTED("Unexpected ETC format");
+            return TEX_FORMAT_UNKNOWN;
+    }
+}
+
+} // namespace Diligent
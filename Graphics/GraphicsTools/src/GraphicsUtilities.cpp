@@ -28,12 +28,14 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <vector>
 
 #include "GraphicsUtilities.h"
 #include "DebugUtilities.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ColorConversion.h"
 #include "RefCntAutoPtr.hpp"
+#include "Float16.hpp"
 
 #define PI_F 3.1415926f
 
@@ -286,11 +288,14 @@ ChannelType MostFrequentSelector(ChannelType c0, ChannelType c1, ChannelType c2,
     }
 }
 
+// FirstCoarseRow is the index of the first coarse row in the full mip level and is passed
+// to the filter when the level is filtered in parts.
 template <typename ChannelType,
           typename FilterType>
 void FilterMipLevel(const ComputeMipLevelAttribs& Attribs,
                     Uint32                        NumChannels,
-                    FilterType                    Filter)
+                    FilterType                    Filter,
+                    Uint32                        FirstCoarseRow = 0)
 {
     VERIFY_EXPR(Attribs.FineMipWidth > 0 && Attribs.FineMipHeight > 0);
     DEV_CHECK_ERR(Attribs.FineMipHeight == 1 || Attribs.FineMipStride >= Attribs.FineMipWidth * sizeof(ChannelType) * NumChannels, "Fine mip level stride is too small");
@@ -322,7 +327,7 @@ void FilterMipLevel(const ComputeMipLevelAttribs& Attribs,
 
                 auto& DstCol = reinterpret_cast<ChannelType*>(reinterpret_cast<Uint8*>(Attribs.pCoarseMipData) + row * Attribs.CoarseMipStride)[col * NumChannels + c];
 
-                DstCol = Filter(Chnl00, Chnl10, Chnl01, Chnl11, col, row);
+                DstCol = Filter(Chnl00, Chnl10, Chnl01, Chnl11, col, FirstCoarseRow + row);
             }
         }
     }
@@ -355,7 +360,8 @@ void RemapAlpha(const ComputeMipLevelAttribs& Attribs,
 
 template <typename ChannelType>
 void ComputeMipLevelInternal(const ComputeMipLevelAttribs& Attribs,
-                             const TextureFormatAttribs&   FmtAttribs)
+                             const TextureFormatAttribs&   FmtAttribs,
+                             Uint32                        FirstCoarseRow = 0)
 {
     auto FilterType = Attribs.FilterType;
     if (FilterType == MIP_FILTER_TYPE_DEFAULT)
@@ -368,7 +374,49 @@ void ComputeMipLevelInternal(const ComputeMipLevelAttribs& Attribs,
     FilterMipLevel<ChannelType>(Attribs, FmtAttribs.NumComponents,
                                 FilterType == MIP_FILTER_TYPE_BOX_AVERAGE ?
                                     LinearAverage<ChannelType> :
-                                    MostFrequentSelector<ChannelType>);
+                                    MostFrequentSelector<ChannelType>,
+                                FirstCoarseRow);
+}
+
+// Converts every pair of fine mip rows to 32-bit floats, filters them, and converts
+// the resulting coarse row back to 16-bit floats.
+void ComputeMipLevelFloat16(const ComputeMipLevelAttribs& Attribs,
+                            const TextureFormatAttribs&   FmtAttribs)
+{
+    const auto CoarseMipWidth  = std::max(Attribs.FineMipWidth / Uint32{2}, Uint32{1});
+    const auto CoarseMipHeight = std::max(Attribs.FineMipHeight / Uint32{2}, Uint32{1});
+
+    const size_t FineRowSize   = size_t{Attribs.FineMipWidth} * FmtAttribs.NumComponents;
+    const size_t CoarseRowSize = size_t{CoarseMipWidth} * FmtAttribs.NumComponents;
+
+    DEV_CHECK_ERR(Attribs.FineMipHeight == 1 || Attribs.FineMipStride >= FineRowSize * sizeof(Uint16), "Fine mip level stride is too small");
+    VERIFY(CoarseMipHeight == 1 || Attribs.CoarseMipStride >= CoarseRowSize * sizeof(Uint16), "Coarse mip level stride is too small");
+
+    std::vector<Float32> FineRows(FineRowSize * 2);
+    std::vector<Float32> CoarseRow(CoarseRowSize);
+
+    ComputeMipLevelAttribs RowAttribs{Attribs};
+    RowAttribs.FineMipHeight   = 2;
+    RowAttribs.pFineMipData    = FineRows.data();
+    RowAttribs.FineMipStride   = FineRowSize * sizeof(Float32);
+    RowAttribs.pCoarseMipData  = CoarseRow.data();
+    RowAttribs.CoarseMipStride = CoarseRowSize * sizeof(Float32);
+
+    for (Uint32 row = 0; row < CoarseMipHeight; ++row)
+    {
+        const auto src_row0 = row * 2;
+        const auto src_row1 = std::min(row * 2 + 1, Attribs.FineMipHeight - 1);
+
+        const auto* pSrcRow0 = reinterpret_cast<const Uint16*>(reinterpret_cast<const Uint8*>(Attribs.pFineMipData) + src_row0 * Attribs.FineMipStride);
+        const auto* pSrcRow1 = reinterpret_cast<const Uint16*>(reinterpret_cast<const Uint8*>(Attribs.pFineMipData) + src_row1 * Attribs.FineMipStride);
+        Float16ToFloat32(pSrcRow0, &FineRows[0], FineRowSize);
+        Float16ToFloat32(pSrcRow1, &FineRows[FineRowSize], FineRowSize);
+
+        ComputeMipLevelInternal<Float32>(RowAttribs, FmtAttribs, row);
+
+        auto* pDstRow = reinterpret_cast<Uint16*>(reinterpret_cast<Uint8*>(Attribs.pCoarseMipData) + row * Attribs.CoarseMipStride);
+        Float32ToFloat16(CoarseRow.data(), pDstRow, CoarseRowSize);
+    }
 }
 
 void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
@@ -446,8 +494,19 @@ void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
             break;
 
         case COMPONENT_TYPE_FLOAT:
-            VERIFY(FmtAttribs.ComponentSize == 4, "Only 32-bit float formats are currently supported");
-            ComputeMipLevelInternal<Float32>(Attribs, FmtAttribs);
+            switch (FmtAttribs.ComponentSize)
+            {
+                case 2:
+                    ComputeMipLevelFloat16(Attribs, FmtAttribs);
+                    break;
+
+                case 4:
+                    ComputeMipLevelInternal<Float32>(Attribs, FmtAttribs);
+                    break;
+
+                default:
+                    UNEXPECTED("Unexpected component size (", FmtAttribs.ComponentSize, ") for FLOAT texture format");
+            }
             break;
 
         default:
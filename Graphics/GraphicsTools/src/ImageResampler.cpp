@@ -0,0 +1,383 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ImageResampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "GraphicsAccessories.hpp"
+#include "TextureFormatConverter.hpp"
+#include "BasicMathSIMD.hpp"
+#include "ThreadPool.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+using namespace MathSIMD;
+
+// The number of texels processed by a single parallel task
+constexpr Uint32 ParallelChunkSize = 1u << 14;
+
+// The number of lobes of the Kaiser and Lanczos filters
+constexpr double SincRadius = 3;
+
+// Kaiser window shape parameter
+constexpr double KaiserAlpha = 4;
+
+double Sinc(double x)
+{
+    x *= 3.14159265358979323846;
+    return std::abs(x) < 1e-6 ? 1.0 : std::sin(x) / x;
+}
+
+// Modified Bessel function of the first kind of order zero
+double BesselI0(double x)
+{
+    double Sum  = 1;
+    double Term = 1;
+    for (int k = 1; k < 64 && Term > Sum * 1e-12; ++k)
+    {
+        const double f = x / (2.0 * k);
+        Term *= f * f;
+        Sum += Term;
+    }
+    return Sum;
+}
+
+// Returns the filter kernel radius, in source texels
+double GetFilterRadius(RESAMPLE_FILTER Filter)
+{
+    switch (Filter)
+    {
+        // clang-format off
+        case RESAMPLE_FILTER_BILINEAR: return 1;
+        case RESAMPLE_FILTER_BICUBIC:  return 2;
+        case RESAMPLE_FILTER_LANCZOS:  return SincRadius;
+        case RESAMPLE_FILTER_KAISER:   return SincRadius;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected filter");
+            return 0;
+    }
+}
+
+// Evaluates the filter kernel at the distance t from the center
+double EvalKernel(RESAMPLE_FILTER Filter, double t)
+{
+    t = std::abs(t);
+    if (t >= GetFilterRadius(Filter))
+        return 0;
+
+    switch (Filter)
+    {
+        case RESAMPLE_FILTER_BILINEAR:
+            return 1 - t;
+
+        case RESAMPLE_FILTER_BICUBIC:
+            // Catmull-Rom spline (Keys cubic with a = -0.5)
+            return t < 1 ?
+                (1.5 * t - 2.5) * t * t + 1 :
+                ((-0.5 * t + 2.5) * t - 4) * t + 2;
+
+        case RESAMPLE_FILTER_LANCZOS:
+            return Sinc(t) * Sinc(t / SincRadius);
+
+        case RESAMPLE_FILTER_KAISER:
+        {
+            const double r = t / SincRadius;
+            return Sinc(t) * BesselI0(KaiserAlpha * std::sqrt(1 - r * r)) / BesselI0(KaiserAlpha);
+        }
+
+        default:
+            UNEXPECTED("Unexpected filter");
+            return 0;
+    }
+}
+
+// Weights of the source texels that contribute to every destination texel.
+// Every destination texel uses NumTaps weights; unused taps have zero weights.
+struct FilterWeights
+{
+    Uint32              NumTaps = 0;
+    std::vector<Uint32> Indices;
+    std::vector<float>  Weights;
+};
+
+FilterWeights ComputeFilterWeights(Uint32 SrcSize, Uint32 DstSize, RESAMPLE_FILTER Filter)
+{
+    VERIFY_EXPR(SrcSize > 0 && DstSize > 0);
+
+    // Source texel i covers [i, i + 1], destination texel x covers [x * Scale, (x + 1) * Scale]
+    const double Scale = static_cast<double>(SrcSize) / static_cast<double>(DstSize);
+    // When minifying, the kernel is stretched to the destination texel footprint
+    const double FilterScale = std::max(Scale, 1.0);
+
+    std::vector<std::vector<std::pair<Uint32, double>>> Taps(DstSize);
+    for (Uint32 x = 0; x < DstSize; ++x)
+    {
+        auto& XTaps = Taps[x];
+
+        // Taps outside of the image are clamped to the edge. Indices are non-decreasing, so
+        // the weights of the clamped taps are merged with the previous tap.
+        auto AddTap = [&](int i, double w) {
+            const Uint32 Idx = static_cast<Uint32>(std::min(std::max(i, 0), static_cast<int>(SrcSize) - 1));
+            if (!XTaps.empty() && XTaps.back().first == Idx)
+                XTaps.back().second += w;
+            else if (w != 0)
+                XTaps.emplace_back(Idx, w);
+        };
+
+        if (Filter == RESAMPLE_FILTER_BOX)
+        {
+            // The weight of every source texel is the length of its overlap with the destination texel
+            const double Start = x * Scale;
+            const double End   = (x + 1) * Scale;
+            for (int i = static_cast<int>(std::floor(Start)); i < static_cast<int>(std::ceil(End)); ++i)
+                AddTap(i, std::min(End, i + 1.0) - std::max(Start, static_cast<double>(i)));
+        }
+        else
+        {
+            const double Center  = (x + 0.5) * Scale;
+            const double Support = GetFilterRadius(Filter) * FilterScale;
+            for (int i = static_cast<int>(std::floor(Center - Support)); i <= static_cast<int>(std::ceil(Center + Support)); ++i)
+                AddTap(i, EvalKernel(Filter, (i + 0.5 - Center) / FilterScale));
+        }
+
+        double Sum = 0;
+        for (const auto& Tap : XTaps)
+            Sum += Tap.second;
+        VERIFY_EXPR(Sum > 0);
+        for (auto& Tap : XTaps)
+            Tap.second /= Sum;
+    }
+
+    FilterWeights Weights;
+    for (const auto& XTaps : Taps)
+        Weights.NumTaps = std::max(Weights.NumTaps, static_cast<Uint32>(XTaps.size()));
+
+    Weights.Indices.resize(size_t{DstSize} * Weights.NumTaps);
+    Weights.Weights.resize(size_t{DstSize} * Weights.NumTaps);
+    for (Uint32 x = 0; x < DstSize; ++x)
+    {
+        const auto& XTaps = Taps[x];
+        for (Uint32 k = 0; k < Weights.NumTaps; ++k)
+        {
+            const size_t Idx = size_t{x} * Weights.NumTaps + k;
+            if (k < XTaps.size())
+            {
+                Weights.Indices[Idx] = XTaps[k].first;
+                Weights.Weights[Idx] = static_cast<float>(XTaps[k].second);
+            }
+            else
+            {
+                Weights.Indices[Idx] = XTaps.back().first;
+                Weights.Weights[Idx] = 0;
+            }
+        }
+    }
+    return Weights;
+}
+
+// Calls the handler for every row, processing chunks of rows in parallel
+template <typename HandlerType>
+void ProcessRows(IThreadPool* pThreadPool, Uint32 Width, Uint32 Height, const HandlerType& RowHandler)
+{
+    const Uint32 RowsPerChunk = std::max(ParallelChunkSize / Width, 1u);
+    const Uint32 NumChunks    = (Height + RowsPerChunk - 1) / RowsPerChunk;
+    ParallelFor(NumChunks > 1 ? pThreadPool : nullptr, NumChunks,
+                [&](Uint32 Chunk) {
+                    const Uint32 EndRow = std::min((Chunk + 1) * RowsPerChunk, Height);
+                    for (Uint32 y = Chunk * RowsPerChunk; y < EndRow; ++y)
+                        RowHandler(y);
+                });
+}
+
+// Resamples an RGBA32_FLOAT image: filters every source row horizontally, then every column vertically.
+void ResampleFloatImage(const float*    pSrc,
+                        size_t          SrcStride,
+                        Uint32          SrcWidth,
+                        Uint32          SrcHeight,
+                        float*          pDst,
+                        size_t          DstStride,
+                        Uint32          DstWidth,
+                        Uint32          DstHeight,
+                        RESAMPLE_FILTER Filter,
+                        IThreadPool*    pThreadPool)
+{
+    const FilterWeights HorzWeights = ComputeFilterWeights(SrcWidth, DstWidth, Filter);
+    const FilterWeights VertWeights = ComputeFilterWeights(SrcHeight, DstHeight, Filter);
+
+    const size_t       RowSize = size_t{DstWidth} * 4;
+    std::vector<float> HorzFiltered(RowSize * SrcHeight);
+
+    ProcessRows(pThreadPool, DstWidth, SrcHeight, [&](Uint32 y) {
+        const float*  pSrcRow  = reinterpret_cast<const float*>(reinterpret_cast<const Uint8*>(pSrc) + SrcStride * y);
+        float*        pDstRow  = &HorzFiltered[RowSize * y];
+        const Uint32  NumTaps  = HorzWeights.NumTaps;
+        const Uint32* pIndices = HorzWeights.Indices.data();
+        const float*  pWeights = HorzWeights.Weights.data();
+        for (Uint32 x = 0; x < DstWidth; ++x, pIndices += NumTaps, pWeights += NumTaps)
+        {
+            VecF4 Sum = SetF4(0.f);
+            for (Uint32 k = 0; k < NumTaps; ++k)
+                Sum = AddF4(Sum, MulF4(LoadF4(pSrcRow + size_t{pIndices[k]} * 4), SetF4(pWeights[k])));
+            StoreF4(pDstRow + size_t{x} * 4, Sum);
+        }
+    });
+
+    ProcessRows(pThreadPool, DstWidth, DstHeight, [&](Uint32 y) {
+        const Uint32  NumTaps  = VertWeights.NumTaps;
+        const Uint32* pIndices = &VertWeights.Indices[size_t{y} * NumTaps];
+        const float*  pWeights = &VertWeights.Weights[size_t{y} * NumTaps];
+        float*        pDstRow  = reinterpret_cast<float*>(reinterpret_cast<Uint8*>(pDst) + DstStride * y);
+        for (size_t i = 0; i < RowSize; i += 4)
+        {
+            VecF4 Sum = SetF4(0.f);
+            for (Uint32 k = 0; k < NumTaps; ++k)
+                Sum = AddF4(Sum, MulF4(LoadF4(&HorzFiltered[RowSize * pIndices[k] + i]), SetF4(pWeights[k])));
+            StoreF4(pDstRow + i, Sum);
+        }
+    });
+}
+
+// Returns the format that is used to convert the texels to and from floating-point values
+TEXTURE_FORMAT GetFilteringFormat(TEXTURE_FORMAT Format, bool GammaCorrect)
+{
+    if (GammaCorrect)
+        return Format;
+
+    // Filter sRGB images in gamma space
+    switch (Format)
+    {
+        // clang-format off
+        case TEX_FORMAT_RGBA8_UNORM_SRGB: return TEX_FORMAT_RGBA8_UNORM;
+        case TEX_FORMAT_BGRA8_UNORM_SRGB: return TEX_FORMAT_BGRA8_UNORM;
+        case TEX_FORMAT_BGRX8_UNORM_SRGB: return TEX_FORMAT_BGRX8_UNORM;
+        // clang-format on
+        default:
+            return Format;
+    }
+}
+
+} // namespace
+
+
+bool IsImageResamplingSupported(TEXTURE_FORMAT SrcFormat, TEXTURE_FORMAT DstFormat)
+{
+    return IsTextureFormatConversionSupported(SrcFormat, TEX_FORMAT_RGBA32_FLOAT) &&
+        IsTextureFormatConversionSupported(TEX_FORMAT_RGBA32_FLOAT, DstFormat);
+}
+
+bool ResampleImage(const ResampleImageAttribs& Attribs)
+{
+    const TEXTURE_FORMAT SrcFormat = GetFilteringFormat(Attribs.SrcFormat, Attribs.GammaCorrect);
+    const TEXTURE_FORMAT DstFormat = GetFilteringFormat(Attribs.DstFormat, Attribs.GammaCorrect);
+    if (!IsImageResamplingSupported(SrcFormat, DstFormat))
+        return false;
+
+    if (Attribs.SrcWidth == 0 || Attribs.SrcHeight == 0 || Attribs.DstWidth == 0 || Attribs.DstHeight == 0)
+        return true;
+
+    DEV_CHECK_ERR(Attribs.pSrcData != nullptr, "Source data must not be null");
+    DEV_CHECK_ERR(Attribs.pDstData != nullptr, "Destination data must not be null");
+    DEV_CHECK_ERR(Attribs.Filter < RESAMPLE_FILTER_COUNT, "Invalid filter");
+
+    auto Convert = [&Attribs](Uint32         Width,
+                              Uint32         Height,
+                              TEXTURE_FORMAT SrcFmt,
+                              const void*    pSrcData,
+                              size_t         SrcStride,
+                              TEXTURE_FORMAT DstFmt,
+                              void*          pDstData,
+                              size_t         DstStride) {
+        ConvertTextureDataAttribs ConvertAttribs;
+        ConvertAttribs.Width       = Width;
+        ConvertAttribs.Height      = Height;
+        ConvertAttribs.SrcFormat   = SrcFmt;
+        ConvertAttribs.pSrcData    = pSrcData;
+        ConvertAttribs.SrcStride   = SrcStride;
+        ConvertAttribs.DstFormat   = DstFmt;
+        ConvertAttribs.pDstData    = pDstData;
+        ConvertAttribs.DstStride   = DstStride;
+        ConvertAttribs.pThreadPool = Attribs.pThreadPool;
+        if (!ConvertTextureData(ConvertAttribs))
+            UNEXPECTED("Conversion is expected to be supported");
+    };
+
+    // All filters have unit weight at the texel center and zero weights at the other texel centers,
+    // so the image only needs to be converted when the size does not change.
+    const bool IsSameSize = Attribs.SrcWidth == Attribs.DstWidth && Attribs.SrcHeight == Attribs.DstHeight;
+    if (IsSameSize && (SrcFormat == TEX_FORMAT_RGBA32_FLOAT || DstFormat == TEX_FORMAT_RGBA32_FLOAT))
+    {
+        Convert(Attribs.SrcWidth, Attribs.SrcHeight, SrcFormat, Attribs.pSrcData, Attribs.SrcStride, DstFormat, Attribs.pDstData, Attribs.DstStride);
+        return true;
+    }
+
+    // RGBA32_FLOAT data is filtered in place, other formats are converted
+    const float*       pSrc      = static_cast<const float*>(Attribs.pSrcData);
+    size_t             SrcStride = Attribs.SrcStride;
+    std::vector<float> SrcTexels;
+    if (SrcFormat != TEX_FORMAT_RGBA32_FLOAT)
+    {
+        SrcTexels.resize(size_t{Attribs.SrcWidth} * Attribs.SrcHeight * 4);
+        pSrc      = SrcTexels.data();
+        SrcStride = size_t{Attribs.SrcWidth} * 16;
+        Convert(Attribs.SrcWidth, Attribs.SrcHeight, SrcFormat, Attribs.pSrcData, Attribs.SrcStride, TEX_FORMAT_RGBA32_FLOAT, SrcTexels.data(), SrcStride);
+    }
+
+    if (IsSameSize)
+    {
+        Convert(Attribs.DstWidth, Attribs.DstHeight, TEX_FORMAT_RGBA32_FLOAT, pSrc, SrcStride, DstFormat, Attribs.pDstData, Attribs.DstStride);
+        return true;
+    }
+
+    float*             pDst      = static_cast<float*>(Attribs.pDstData);
+    size_t             DstStride = Attribs.DstStride;
+    std::vector<float> DstTexels;
+    if (DstFormat != TEX_FORMAT_RGBA32_FLOAT)
+    {
+        DstTexels.resize(size_t{Attribs.DstWidth} * Attribs.DstHeight * 4);
+        pDst      = DstTexels.data();
+        DstStride = size_t{Attribs.DstWidth} * 16;
+    }
+
+    ResampleFloatImage(pSrc, SrcStride, Attribs.SrcWidth, Attribs.SrcHeight,
+                       pDst, DstStride, Attribs.DstWidth, Attribs.DstHeight,
+                       Attribs.Filter, Attribs.pThreadPool);
+
+    if (DstFormat != TEX_FORMAT_RGBA32_FLOAT)
+        Convert(Attribs.DstWidth, Attribs.DstHeight, TEX_FORMAT_RGBA32_FLOAT, DstTexels.data(), DstStride, DstFormat, Attribs.pDstData, Attribs.DstStride);
+
+    return true;
+}
+
+} // namespace Diligent
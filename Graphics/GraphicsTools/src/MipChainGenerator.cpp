@@ -0,0 +1,228 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "MipChainGenerator.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "GraphicsAccessories.hpp"
+#include "ImageResampler.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+RESAMPLE_FILTER GetResampleFilter(MIP_CHAIN_FILTER Filter)
+{
+    switch (Filter)
+    {
+        // clang-format off
+        case MIP_CHAIN_FILTER_BOX:     return RESAMPLE_FILTER_BOX;
+        case MIP_CHAIN_FILTER_KAISER:  return RESAMPLE_FILTER_KAISER;
+        case MIP_CHAIN_FILTER_LANCZOS: return RESAMPLE_FILTER_LANCZOS;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected filter");
+            return RESAMPLE_FILTER_BOX;
+    }
+}
+
+// RGBA32_FLOAT image
+struct FloatImage
+{
+    Uint32             Width  = 0;
+    Uint32             Height = 0;
+    std::vector<float> Texels;
+
+    FloatImage() = default;
+
+    FloatImage(Uint32 _Width, Uint32 _Height) :
+        Width{_Width},
+        Height{_Height},
+        Texels(size_t{_Width} * _Height * 4)
+    {}
+};
+
+// Returns the fraction of texels with alpha greater than the cutoff
+double ComputeAlphaCoverage(const FloatImage& Image, float AlphaCutoff)
+{
+    size_t NumCovered = 0;
+    for (size_t i = 3; i < Image.Texels.size(); i += 4)
+        NumCovered += Image.Texels[i] > AlphaCutoff ? 1 : 0;
+    return static_cast<double>(NumCovered) / static_cast<double>(Image.Texels.size() / 4);
+}
+
+// Scales alpha so that the alpha coverage matches the given value
+void PreserveAlphaCoverage(FloatImage& Image, double Coverage, float AlphaCutoff)
+{
+    std::vector<float> Alpha(Image.Texels.size() / 4);
+    for (size_t i = 0; i < Alpha.size(); ++i)
+        Alpha[i] = Image.Texels[i * 4 + 3];
+
+    const size_t NumCovered = static_cast<size_t>(Coverage * static_cast<double>(Alpha.size()) + 0.5);
+    if (NumCovered == 0)
+        return;
+
+    // Find the alpha value of the least covered texel and map the value between it and
+    // the next distinct alpha value to the cutoff. Texels with equal alpha values can't be
+    // separated, so either all or none of them are covered, whichever is closer to the target.
+    std::nth_element(Alpha.begin(), Alpha.begin() + (NumCovered - 1), Alpha.end(), std::greater<float>{});
+    const float MinCovered = Alpha[NumCovered - 1];
+
+    size_t NumGreater  = 0;
+    size_t NumEqual    = 0;
+    float  NextGreater = 1;
+    float  NextLess    = 0;
+    for (float a : Alpha)
+    {
+        if (a > MinCovered)
+        {
+            ++NumGreater;
+            NextGreater = std::min(NextGreater, a);
+        }
+        else if (a == MinCovered)
+        {
+            ++NumEqual;
+        }
+        else
+        {
+            NextLess = std::max(NextLess, a);
+        }
+    }
+
+    const float Threshold = (NumCovered - NumGreater <= NumGreater + NumEqual - NumCovered) ?
+        (MinCovered + std::max(NextGreater, MinCovered)) * 0.5f :
+        (MinCovered + NextLess) * 0.5f;
+    if (Threshold <= 0)
+        return;
+
+    const float Scale = AlphaCutoff / Threshold;
+    for (size_t i = 3; i < Image.Texels.size(); i += 4)
+        Image.Texels[i] = std::min(Image.Texels[i] * Scale, 1.f);
+}
+
+// Converts a mip level between the texture format and RGBA32_FLOAT.
+// The resampler decodes and encodes sRGB formats according to GammaCorrect.
+void ConvertLevel(const ComputeMipChainAttribs& Attribs,
+                  Uint32                        Width,
+                  Uint32                        Height,
+                  TEXTURE_FORMAT                SrcFormat,
+                  const void*                   pSrcData,
+                  size_t                        SrcStride,
+                  TEXTURE_FORMAT                DstFormat,
+                  void*                         pDstData,
+                  size_t                        DstStride)
+{
+    ResampleImageAttribs ResampleAttribs;
+    ResampleAttribs.SrcWidth     = Width;
+    ResampleAttribs.SrcHeight    = Height;
+    ResampleAttribs.SrcFormat    = SrcFormat;
+    ResampleAttribs.pSrcData     = pSrcData;
+    ResampleAttribs.SrcStride    = SrcStride;
+    ResampleAttribs.DstWidth     = Width;
+    ResampleAttribs.DstHeight    = Height;
+    ResampleAttribs.DstFormat    = DstFormat;
+    ResampleAttribs.pDstData     = pDstData;
+    ResampleAttribs.DstStride    = DstStride;
+    ResampleAttribs.GammaCorrect = Attribs.GammaCorrect;
+    ResampleAttribs.pThreadPool  = Attribs.pThreadPool;
+    if (!ResampleImage(ResampleAttribs))
+        UNEXPECTED("Conversion is expected to be supported");
+}
+
+} // namespace
+
+
+bool ComputeMipChain(const ComputeMipChainAttribs& Attribs)
+{
+    if (!IsImageResamplingSupported(Attribs.Format, Attribs.Format))
+        return false;
+
+    if (Attribs.Width == 0 || Attribs.Height == 0 || Attribs.NumMipLevels == 0)
+        return true;
+
+    DEV_CHECK_ERR(Attribs.pSrcData != nullptr, "Source data must not be null");
+    DEV_CHECK_ERR(Attribs.pMipLevels != nullptr, "Mip levels must not be null");
+    DEV_CHECK_ERR(Attribs.NumMipLevels < ComputeMipLevelsCount(Attribs.Width, Attribs.Height),
+                  "The number of mip levels (", Attribs.NumMipLevels, ") must be less than the number of mip levels in the full chain (",
+                  ComputeMipLevelsCount(Attribs.Width, Attribs.Height), ")");
+    DEV_CHECK_ERR(Attribs.Filter < MIP_CHAIN_FILTER_COUNT, "Invalid filter");
+    DEV_CHECK_ERR(Attribs.AlphaCutoff >= 0 && Attribs.AlphaCutoff < 1, "Alpha cutoff (", Attribs.AlphaCutoff, ") must be in [0, 1) range");
+
+    FloatImage Level{Attribs.Width, Attribs.Height};
+    ConvertLevel(Attribs, Attribs.Width, Attribs.Height,
+                 Attribs.Format, Attribs.pSrcData, Attribs.SrcStride,
+                 TEX_FORMAT_RGBA32_FLOAT, Level.Texels.data(), size_t{Attribs.Width} * 16);
+
+    const double AlphaCoverage = Attribs.AlphaCutoff > 0 ? ComputeAlphaCoverage(Level, Attribs.AlphaCutoff) : 0;
+
+    for (Uint32 Mip = 1; Mip <= Attribs.NumMipLevels; ++Mip)
+    {
+        // Every level is computed from the previous one before alpha is scaled
+        FloatImage CoarseLevel{std::max(Attribs.Width >> Mip, 1u), std::max(Attribs.Height >> Mip, 1u)};
+        {
+            ResampleImageAttribs ResampleAttribs;
+            ResampleAttribs.SrcWidth    = Level.Width;
+            ResampleAttribs.SrcHeight   = Level.Height;
+            ResampleAttribs.SrcFormat   = TEX_FORMAT_RGBA32_FLOAT;
+            ResampleAttribs.pSrcData    = Level.Texels.data();
+            ResampleAttribs.SrcStride   = size_t{Level.Width} * 16;
+            ResampleAttribs.DstWidth    = CoarseLevel.Width;
+            ResampleAttribs.DstHeight   = CoarseLevel.Height;
+            ResampleAttribs.DstFormat   = TEX_FORMAT_RGBA32_FLOAT;
+            ResampleAttribs.pDstData    = CoarseLevel.Texels.data();
+            ResampleAttribs.DstStride   = size_t{CoarseLevel.Width} * 16;
+            ResampleAttribs.Filter      = GetResampleFilter(Attribs.Filter);
+            ResampleAttribs.pThreadPool = Attribs.pThreadPool;
+            ResampleImage(ResampleAttribs);
+        }
+        Level = std::move(CoarseLevel);
+
+        FloatImage ScaledAlphaLevel;
+        if (Attribs.AlphaCutoff > 0)
+        {
+            ScaledAlphaLevel = Level;
+            PreserveAlphaCoverage(ScaledAlphaLevel, AlphaCoverage, Attribs.AlphaCutoff);
+        }
+        const FloatImage& DstLevel = Attribs.AlphaCutoff > 0 ? ScaledAlphaLevel : Level;
+
+        const MipLevelData& MipData = Attribs.pMipLevels[Mip - 1];
+        DEV_CHECK_ERR(MipData.pData != nullptr, "Data of mip level ", Mip, " must not be null");
+
+        ConvertLevel(Attribs, DstLevel.Width, DstLevel.Height,
+                     TEX_FORMAT_RGBA32_FLOAT, DstLevel.Texels.data(), size_t{DstLevel.Width} * 16,
+                     Attribs.Format, MipData.pData, MipData.Stride);
+    }
+
+    return true;
+}
+
+} // namespace Diligent
@@ -50,6 +50,7 @@
 #include "CallbackWrapper.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ShaderSourceFactoryUtils.hpp"
+#include "CPUProfiler.hpp"
 
 namespace Diligent
 {
@@ -561,6 +562,8 @@ RenderStateCacheImpl::RenderStateCacheImpl(IReferenceCounters*               pRe
 bool RenderStateCacheImpl::CreateShader(const ShaderCreateInfo& ShaderCI,
                                         IShader**               ppShader)
 {
+    DILIGENT_PROFILE_SCOPE_CAT("RenderStateCache::CreateShader", "RenderStateCache");
+
     if (ppShader == nullptr)
     {
         DEV_ERROR("ppShader must not be null");
@@ -1030,6 +1033,8 @@ template <typename CreateInfoType>
 bool RenderStateCacheImpl::CreatePipelineState(const CreateInfoType& PSOCreateInfo,
                                                IPipelineState**      ppPipelineState)
 {
+    DILIGENT_PROFILE_SCOPE_CAT("RenderStateCache::CreatePipelineState", "RenderStateCache");
+
     if (ppPipelineState == nullptr)
     {
         DEV_ERROR("ppPipelineState must not be null");
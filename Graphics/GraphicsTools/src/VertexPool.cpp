@@ -29,12 +29,14 @@
 #include <mutex>
 #include <atomic>
 #include <memory>
+#include <vector>
 
 #include "DebugUtilities.hpp"
 #include "ObjectBase.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "DynamicBuffer.hpp"
 #include "VariableSizeAllocationsManager.hpp"
+#include "TLSFAllocationsManager.hpp"
 #include "Align.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
@@ -42,14 +44,18 @@
 namespace Diligent
 {
 
+template <typename AllocationsManagerType>
 class VertexPoolImpl;
 
+template <typename AllocationsManagerType>
 class VertexPoolAllocationImpl final : public ObjectBase<IVertexPoolAllocation>
 {
 public:
-    using TBase = ObjectBase<IVertexPoolAllocation>;
+    using TBase          = ObjectBase<IVertexPoolAllocation>;
+    using VertexPoolType = VertexPoolImpl<AllocationsManagerType>;
+
     VertexPoolAllocationImpl(IReferenceCounters*                          pRefCounters,
-                             VertexPoolImpl*                              pParentPool,
+                             VertexPoolType*                              pParentPool,
                              Uint32                                       StartVertex,
                              Uint32                                       VertexCount,
                              VariableSizeAllocationsManager::Allocation&& Region) :
@@ -71,7 +77,7 @@ public:
 
     virtual ReferenceCounterValueType DILIGENT_CALL_TYPE Release() override final
     {
-        RefCntAutoPtr<VertexPoolImpl> pParent;
+        RefCntAutoPtr<VertexPoolType> pParent;
         return TBase::Release(
             [&]() //
             {
@@ -107,8 +113,13 @@ public:
         return m_pUserData;
     }
 
+    const VariableSizeAllocationsManager::Allocation& GetRegion() const
+    {
+        return m_Region;
+    }
+
 private:
-    RefCntAutoPtr<VertexPoolImpl> m_pParentPool;
+    RefCntAutoPtr<VertexPoolType> m_pParentPool;
 
     VariableSizeAllocationsManager::Allocation m_Region;
 
@@ -118,10 +129,12 @@ private:
     RefCntAutoPtr<IObject> m_pUserData;
 };
 
+template <typename AllocationsManagerType>
 class VertexPoolImpl final : public ObjectBase<IVertexPool>
 {
 public:
-    using TBase = ObjectBase<IVertexPool>;
+    using TBase                    = ObjectBase<IVertexPool>;
+    using VertexPoolAllocationType = VertexPoolAllocationImpl<AllocationsManagerType>;
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_VertexPool, TBase)
 
@@ -158,8 +171,8 @@ public:
         },
         m_AllocationObjAllocator{
             DefaultRawMemoryAllocator::GetAllocator(),
-            sizeof(VertexPoolAllocationImpl),
-            1024u / Uint32{sizeof(VertexPoolAllocationImpl)} // Use 1 Kb pages.
+            sizeof(VertexPoolAllocationType),
+            1024u / Uint32{sizeof(VertexPoolAllocationType)} // Use 1 Kb pages.
         }
     {
         m_Desc.Name      = m_Name.c_str();
@@ -316,8 +329,8 @@ public:
         if (Region.IsValid())
         {
             // clang-format off
-            VertexPoolAllocationImpl* pSuballocation{
-                NEW_RC_OBJ(m_AllocationObjAllocator, "VertexPoolAllocationImpl instance", VertexPoolAllocationImpl)
+            VertexPoolAllocationType* pSuballocation{
+                NEW_RC_OBJ(m_AllocationObjAllocator, "VertexPoolAllocationImpl instance", VertexPoolAllocationType)
                 (
                     this,
                     static_cast<Uint32>(Region.UnalignedOffset),
@@ -353,9 +366,81 @@ public:
         return m_Desc;
     }
 
+    virtual Uint32 PlanDefragmentation(const VertexPoolDefragmentationAttribs& Attribs,
+                                       IVertexPoolAllocation**                 ppNewAllocations) override final
+    {
+        if (Attribs.NumAllocations == 0)
+            return 0;
+
+        if (Attribs.ppAllocations == nullptr)
+        {
+            UNEXPECTED("ppAllocations must not be null");
+            return 0;
+        }
+
+        if (ppNewAllocations == nullptr)
+        {
+            UNEXPECTED("ppNewAllocations must not be null");
+            return 0;
+        }
+
+        std::vector<VariableSizeAllocationsManager::Allocation> Regions(Attribs.NumAllocations);
+        for (Uint32 i = 0; i < Attribs.NumAllocations; ++i)
+        {
+            DEV_CHECK_ERR(ppNewAllocations[i] == nullptr, "Overwriting reference to existing object may cause memory leaks");
+            ppNewAllocations[i] = nullptr;
+
+            auto* pAllocation = Attribs.ppAllocations[i];
+            if (pAllocation == nullptr || pAllocation->GetPool() != this)
+            {
+                UNEXPECTED("Allocation ", i, " is null or was not created by this pool");
+                return 0;
+            }
+
+            Regions[i] = ClassPtrCast<VertexPoolAllocationType>(pAllocation)->GetRegion();
+        }
+
+        VariableSizeAllocationsManager::DefragmentationAttribs MgrAttribs;
+        MgrAttribs.pAllocations   = Regions.data();
+        MgrAttribs.NumAllocations = Regions.size();
+        MgrAttribs.MaxMoves       = Attribs.MaxMoves;
+        MgrAttribs.MaxBytesToMove = StaticCast<VariableSizeAllocationsManager::OffsetType>(std::min(Attribs.MaxVerticesToMove, Uint64{~VariableSizeAllocationsManager::OffsetType{0}}));
+
+        std::vector<VariableSizeAllocationsManager::DefragmentationMove> Moves;
+        {
+            std::lock_guard<std::mutex> Lock{m_MgrMtx};
+            Moves = m_Mgr.PlanDefragmentation(MgrAttribs);
+            UpdateUsageStats();
+        }
+
+        for (auto& Move : Moves)
+        {
+            const auto* pSrcAllocation = ClassPtrCast<const VertexPoolAllocationType>(Attribs.ppAllocations[Move.AllocationIndex]);
+            VERIFY_EXPR(Move.CopySize == pSrcAllocation->GetVertexCount());
+
+            // clang-format off
+            VertexPoolAllocationType* pAllocation{
+                NEW_RC_OBJ(m_AllocationObjAllocator, "VertexPoolAllocationImpl instance", VertexPoolAllocationType)
+                (
+                    this,
+                    static_cast<Uint32>(Move.DstOffset),
+                    pSrcAllocation->GetVertexCount(),
+                    std::move(Move.NewAllocation)
+                )
+            };
+            // clang-format on
+            pAllocation->SetUserData(pSrcAllocation->GetUserData());
+
+            pAllocation->QueryInterface(IID_VertexPoolAllocation, reinterpret_cast<IObject**>(&ppNewAllocations[Move.AllocationIndex]));
+            m_AllocationCount.fetch_add(1);
+        }
+
+        return static_cast<Uint32>(Moves.size());
+    }
+
     virtual void GetUsageStats(VertexPoolUsageStats& UsageStats) override final
     {
-        // NB: mutex must not be locked here to avoid stalling render thread
+        // NB: mutex must not be waited for here to avoid stalling render thread
         UsageStats.TotalVertexCount     = m_TotalVertexCount.load();
         UsageStats.AllocatedVertexCount = m_AllocatedVertexCount.load();
         UsageStats.CommittedMemorySize  = m_CommittedMemorySize.load();
@@ -365,14 +450,35 @@ public:
             VertexSize += m_Desc.pElements[Elem].Size;
         UsageStats.UsedMemorySize = UsageStats.AllocatedVertexCount * VertexSize;
 
-        UsageStats.AllocationCount = m_AllocationCount.load();
+        UsageStats.AllocationCount         = m_AllocationCount.load();
+        UsageStats.MaxFreeChunkVertexCount = GetMaxFreeBlockSize();
+        UsageStats.FreeChunkCount          = m_FreeBlockCount.load();
     }
 
 private:
+    // The maximum free block size is not updated by every allocation as it may be expensive
+    // to compute (the TLSF manager scans the free blocks of the largest size class). Instead,
+    // it is recomputed when the stats are requested. If the manager is busy, the last value is returned.
+    Uint64 GetMaxFreeBlockSize()
+    {
+        if (m_MaxFreeBlockSizeDirty.load())
+        {
+            std::unique_lock<std::mutex> Lock{m_MgrMtx, std::try_to_lock};
+            if (Lock.owns_lock())
+            {
+                m_MaxFreeBlockSize.store(m_Mgr.GetMaxFreeBlockSize());
+                m_MaxFreeBlockSizeDirty.store(false);
+            }
+        }
+        return m_MaxFreeBlockSize.load();
+    }
+
     void UpdateUsageStats()
     {
         m_AllocatedVertexCount.store(m_Mgr.GetUsedSize());
         m_TotalVertexCount.store(m_Mgr.GetMaxSize());
+        m_MaxFreeBlockSizeDirty.store(true);
+        m_FreeBlockCount.store(static_cast<Uint32>(m_Mgr.GetNumFreeBlocks()));
         UpdateCommittedMemorySize();
     }
     void UpdateCommittedMemorySize()
@@ -389,8 +495,8 @@ private:
 
     VertexPoolDesc m_Desc;
 
-    std::mutex                     m_MgrMtx;
-    VariableSizeAllocationsManager m_Mgr;
+    std::mutex             m_MgrMtx;
+    AllocationsManagerType m_Mgr;
 
     std::atomic<VariableSizeAllocationsManager::OffsetType> m_MgrSize{0};
 
@@ -404,27 +510,34 @@ private:
     std::atomic<Uint64> m_AllocatedVertexCount{0};
     std::atomic<Uint64> m_CommittedMemorySize{0};
     std::atomic<Uint64> m_TotalVertexCount{0};
+    std::atomic<Uint64> m_MaxFreeBlockSize{0};
+    std::atomic<bool>   m_MaxFreeBlockSizeDirty{true};
+    std::atomic<Uint32> m_FreeBlockCount{0};
 
     FixedBlockMemoryAllocator m_AllocationObjAllocator;
 };
 
 
-VertexPoolAllocationImpl::~VertexPoolAllocationImpl()
+template <typename AllocationsManagerType>
+VertexPoolAllocationImpl<AllocationsManagerType>::~VertexPoolAllocationImpl()
 {
     m_pParentPool->Free(std::move(m_Region));
 }
 
-IVertexPool* VertexPoolAllocationImpl::GetPool()
+template <typename AllocationsManagerType>
+IVertexPool* VertexPoolAllocationImpl<AllocationsManagerType>::GetPool()
 {
     return m_pParentPool;
 }
 
-IBuffer* VertexPoolAllocationImpl::Update(Uint32 Index, IRenderDevice* pDevice, IDeviceContext* pContext)
+template <typename AllocationsManagerType>
+IBuffer* VertexPoolAllocationImpl<AllocationsManagerType>::Update(Uint32 Index, IRenderDevice* pDevice, IDeviceContext* pContext)
 {
     return m_pParentPool->Update(Index, pDevice, pContext);
 }
 
-IBuffer* VertexPoolAllocationImpl::GetBuffer(Uint32 Index) const
+template <typename AllocationsManagerType>
+IBuffer* VertexPoolAllocationImpl<AllocationsManagerType>::GetBuffer(Uint32 Index) const
 {
     return m_pParentPool->GetBuffer(Index);
 }
@@ -435,7 +548,20 @@ void CreateVertexPool(IRenderDevice*              pDevice,
 {
     try
     {
-        auto* pPool = MakeNewRCObj<VertexPoolImpl>()(pDevice, CreateInfo);
+        IVertexPool* pPool = nullptr;
+        switch (CreateInfo.Algorithm)
+        {
+            case SUBALLOCATION_ALGORITHM_BEST_FIT:
+                pPool = MakeNewRCObj<VertexPoolImpl<VariableSizeAllocationsManager>>()(pDevice, CreateInfo);
+                break;
+
+            case SUBALLOCATION_ALGORITHM_TLSF:
+                pPool = MakeNewRCObj<VertexPoolImpl<TLSFAllocationsManager>>()(pDevice, CreateInfo);
+                break;
+
+            default:
+                LOG_ERROR_AND_THROW("Unknown suballocation algorithm ", Uint32{CreateInfo.Algorithm});
+        }
         pPool->QueryInterface(IID_VertexPool, reinterpret_cast<IObject**>(ppVertexPool));
     }
     catch (...)
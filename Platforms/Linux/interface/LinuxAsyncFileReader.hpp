@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Asynchronous file reader that uses io_uring when available and falls back to a thread pool otherwise.
+
+#include <memory>
+#include <vector>
+#include <string>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Asynchronous file read request.
+struct AsyncFileReadRequest
+{
+    /// Path to the file to read. Must not be null.
+    const Char* FilePath = nullptr;
+
+    /// Offset, in bytes, from the beginning of the file.
+    Uint64 Offset = 0;
+
+    /// The number of bytes to read.
+    /// If Size is ~size_t{0}, the file is read to the end.
+    size_t Size = ~size_t{0};
+
+    /// User-defined value that is returned with the read result.
+    Uint64 UserData = 0;
+};
+
+/// Asynchronous file read result.
+struct AsyncFileReadResult
+{
+    /// Path to the file, as given in the request.
+    String FilePath;
+
+    /// User-defined value from the request.
+    Uint64 UserData = 0;
+
+    /// File data. If the end of the file was reached before
+    /// all requested bytes were read, the data is truncated.
+    std::vector<Uint8> Data;
+
+    /// errno value. Zero indicates success.
+    int Error = 0;
+
+    bool Succeeded() const { return Error == 0; }
+};
+
+/// Asynchronous file reader create info.
+struct AsyncFileReaderCreateInfo
+{
+    /// The maximum number of reads that are in flight at the same time.
+    Uint32 QueueDepth = 64;
+
+    /// The number of worker threads that are used when io_uring is not available.
+    Uint32 NumFallbackThreads = 4;
+
+    /// Always use the worker threads, even if the kernel supports io_uring.
+    bool ForceThreadFallback = false;
+};
+
+/// Reads many files in parallel.
+
+/// The reader uses io_uring when the kernel supports it (Linux 5.1+) and the
+/// syscalls are not blocked. Otherwise, it falls back to a small pool of worker
+/// threads that use pread().
+///
+/// \remarks    The reader is not thread-safe: Submit, Poll and Wait must be
+///             called from the same thread or externally synchronized.
+class LinuxAsyncFileReader
+{
+public:
+    explicit LinuxAsyncFileReader(const AsyncFileReaderCreateInfo& CI);
+    ~LinuxAsyncFileReader();
+
+    // clang-format off
+    LinuxAsyncFileReader           (const LinuxAsyncFileReader&)  = delete;
+    LinuxAsyncFileReader           (      LinuxAsyncFileReader&&) = delete;
+    LinuxAsyncFileReader& operator=(const LinuxAsyncFileReader&)  = delete;
+    LinuxAsyncFileReader& operator=(      LinuxAsyncFileReader&&) = delete;
+    // clang-format on
+
+    /// Submits a batch of read requests.
+
+    /// \param [in] pRequests   - Pointer to the array of requests.
+    /// \param [in] NumRequests - The number of requests in the array.
+    ///
+    /// \remarks    Files are opened synchronously, and data is read asynchronously.
+    ///             Requests whose files fail to open complete immediately with an error.
+    void Submit(const AsyncFileReadRequest* pRequests, size_t NumRequests);
+
+    /// Appends all completed requests to Results without blocking and
+    /// returns the number of appended results.
+    size_t Poll(std::vector<AsyncFileReadResult>& Results);
+
+    /// Blocks until at least MinCompletions requests complete (or no requests are pending),
+    /// appends all completed requests to Results and returns the number of appended results.
+    size_t Wait(std::vector<AsyncFileReadResult>& Results, size_t MinCompletions = 1);
+
+    /// Blocks until all submitted requests complete and appends them to Results.
+    size_t WaitAll(std::vector<AsyncFileReadResult>& Results);
+
+    /// Returns the number of requests that have been submitted, but not yet returned
+    /// by Poll or Wait.
+    size_t GetNumPendingRequests() const;
+
+    /// Returns true if the reader uses io_uring, and false if it uses the worker threads.
+    bool IsUsingIOUring() const;
+
+    class Backend;
+
+private:
+    std::unique_ptr<Backend> m_pBackend;
+};
+
+} // namespace Diligent
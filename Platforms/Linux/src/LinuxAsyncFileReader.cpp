@@ -0,0 +1,681 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "LinuxAsyncFileReader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#if defined(__has_include)
+#    if __has_include(<linux/io_uring.h>)
+#        include <linux/io_uring.h>
+#        define DILIGENT_HAS_IO_URING 1
+#    endif
+#endif
+
+#ifndef DILIGENT_HAS_IO_URING
+#    define DILIGENT_HAS_IO_URING 0
+#endif
+
+#include "Errors.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct ReadOp
+{
+    String             FilePath;
+    Uint64             UserData = 0;
+    int                fd       = -1;
+    Uint64             Offset   = 0;
+    std::vector<Uint8> Data;
+    size_t             BytesRead = 0;
+    int                Error     = 0;
+    iovec              IOVec     = {};
+
+    ~ReadOp()
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+
+    bool IsComplete() const
+    {
+        return Error != 0 || BytesRead == Data.size();
+    }
+
+    // Called when a read returned Res bytes. Returns true if the operation is complete.
+    bool OnRead(ssize_t Res)
+    {
+        if (Res < 0)
+        {
+            Error = static_cast<int>(-Res);
+        }
+        else if (Res == 0)
+        {
+            // End of file - truncate the data
+            Data.resize(BytesRead);
+        }
+        else
+        {
+            BytesRead += static_cast<size_t>(Res);
+        }
+        return IsComplete();
+    }
+
+    AsyncFileReadResult ToResult()
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+            fd = -1;
+        }
+
+        AsyncFileReadResult Result;
+        Result.FilePath = std::move(FilePath);
+        Result.UserData = UserData;
+        Result.Error    = Error;
+        if (Error == 0)
+            Result.Data = std::move(Data);
+        return Result;
+    }
+};
+
+std::unique_ptr<ReadOp> OpenReadOp(const AsyncFileReadRequest& Request)
+{
+    std::unique_ptr<ReadOp> Op{new ReadOp};
+    Op->FilePath = Request.FilePath != nullptr ? Request.FilePath : "";
+    Op->UserData = Request.UserData;
+    Op->Offset   = Request.Offset;
+
+    if (Request.FilePath == nullptr)
+    {
+        UNEXPECTED("File path must not be null");
+        Op->Error = EINVAL;
+        return Op;
+    }
+
+    Op->fd = open(Request.FilePath, O_RDONLY | O_CLOEXEC);
+    if (Op->fd < 0)
+    {
+        Op->Error = errno;
+        return Op;
+    }
+
+    size_t Size = Request.Size;
+    if (Size == ~size_t{0})
+    {
+        struct stat StatBuff;
+        if (fstat(Op->fd, &StatBuff) != 0)
+        {
+            Op->Error = errno;
+            return Op;
+        }
+        const auto FileSize = static_cast<Uint64>(StatBuff.st_size);
+        Size                = FileSize > Request.Offset ? static_cast<size_t>(FileSize - Request.Offset) : 0;
+    }
+
+    try
+    {
+        Op->Data.resize(Size);
+    }
+    catch (const std::bad_alloc&)
+    {
+        Op->Error = ENOMEM;
+    }
+
+    return Op;
+}
+
+} // namespace
+
+
+class LinuxAsyncFileReader::Backend
+{
+public:
+    virtual ~Backend() {}
+
+    virtual bool IsIOUring() const = 0;
+
+    void Submit(const AsyncFileReadRequest* pRequests, size_t NumRequests)
+    {
+        for (size_t i = 0; i < NumRequests; ++i)
+        {
+            auto Op = OpenReadOp(pRequests[i]);
+            if (Op->IsComplete())
+                m_Completed.emplace_back(Op->ToResult());
+            else
+                Enqueue(std::move(Op));
+        }
+        Flush();
+        m_NumPending += NumRequests;
+    }
+
+    size_t Wait(std::vector<AsyncFileReadResult>& Results, size_t MinCompletions)
+    {
+        MinCompletions = std::min(MinCompletions, m_NumPending);
+
+        size_t NumCompleted = m_Completed.size();
+        for (auto& Result : m_Completed)
+            Results.emplace_back(std::move(Result));
+        m_Completed.clear();
+
+        NumCompleted += Reap(Results, MinCompletions > NumCompleted ? MinCompletions - NumCompleted : 0);
+
+        VERIFY_EXPR(NumCompleted <= m_NumPending);
+        m_NumPending -= NumCompleted;
+        return NumCompleted;
+    }
+
+    size_t GetNumPending() const { return m_NumPending; }
+
+protected:
+    // Adds an opened operation to the queue.
+    virtual void Enqueue(std::unique_ptr<ReadOp> Op) = 0;
+
+    // Starts processing the queued operations.
+    virtual void Flush() {}
+
+    // Appends completed operations to Results, blocking until at least MinCompletions are available.
+    virtual size_t Reap(std::vector<AsyncFileReadResult>& Results, size_t MinCompletions) = 0;
+
+private:
+    std::vector<AsyncFileReadResult> m_Completed;
+
+    size_t m_NumPending = 0;
+};
+
+
+namespace
+{
+
+class ThreadPoolBackend final : public LinuxAsyncFileReader::Backend
+{
+public:
+    explicit ThreadPoolBackend(Uint32 NumThreads)
+    {
+        NumThreads = std::max(NumThreads, 1u);
+        m_Workers.reserve(NumThreads);
+        for (Uint32 i = 0; i < NumThreads; ++i)
+        {
+            m_Workers.emplace_back([this]() { WorkerThreadFunc(); });
+        }
+    }
+
+    ~ThreadPoolBackend()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_QueueMtx};
+            m_Stop = true;
+        }
+        m_QueueCV.notify_all();
+        for (auto& Worker : m_Workers)
+            Worker.join();
+    }
+
+    virtual bool IsIOUring() const override final { return false; }
+
+protected:
+    virtual void Enqueue(std::unique_ptr<ReadOp> Op) override final
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_QueueMtx};
+            m_Queue.emplace_back(std::move(Op));
+        }
+        m_QueueCV.notify_one();
+    }
+
+    virtual size_t Reap(std::vector<AsyncFileReadResult>& Results, size_t MinCompletions) override final
+    {
+        std::unique_lock<std::mutex> Lock{m_DoneMtx};
+        if (MinCompletions > 0)
+            m_DoneCV.wait(Lock, [&]() { return m_Done.size() >= MinCompletions; });
+
+        const size_t NumCompleted = m_Done.size();
+        for (auto& Op : m_Done)
+            Results.emplace_back(Op->ToResult());
+        m_Done.clear();
+        return NumCompleted;
+    }
+
+private:
+    void WorkerThreadFunc()
+    {
+        while (true)
+        {
+            std::unique_ptr<ReadOp> Op;
+            {
+                std::unique_lock<std::mutex> Lock{m_QueueMtx};
+                m_QueueCV.wait(Lock, [this]() { return m_Stop || !m_Queue.empty(); });
+                if (m_Stop)
+                    return;
+
+                Op = std::move(m_Queue.front());
+                m_Queue.pop_front();
+            }
+
+            while (!Op->IsComplete())
+            {
+                const auto Res = pread(Op->fd, Op->Data.data() + Op->BytesRead, Op->Data.size() - Op->BytesRead,
+                                       static_cast<off_t>(Op->Offset + Op->BytesRead));
+                if (Res < 0 && errno == EINTR)
+                    continue;
+                Op->OnRead(Res < 0 ? -errno : Res);
+            }
+
+            {
+                std::lock_guard<std::mutex> Lock{m_DoneMtx};
+                m_Done.emplace_back(std::move(Op));
+            }
+            m_DoneCV.notify_all();
+        }
+    }
+
+    std::vector<std::thread> m_Workers;
+
+    std::mutex                          m_QueueMtx;
+    std::condition_variable             m_QueueCV;
+    std::deque<std::unique_ptr<ReadOp>> m_Queue;
+    bool                                m_Stop = false;
+
+    std::mutex                           m_DoneMtx;
+    std::condition_variable              m_DoneCV;
+    std::vector<std::unique_ptr<ReadOp>> m_Done;
+};
+
+
+#if DILIGENT_HAS_IO_URING && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+
+// Minimal io_uring wrapper that uses raw syscalls, so that liburing is not required.
+class IOUringBackend final : public LinuxAsyncFileReader::Backend
+{
+public:
+    static std::unique_ptr<IOUringBackend> Create(Uint32 QueueDepth)
+    {
+        std::unique_ptr<IOUringBackend> pBackend{new IOUringBackend};
+        if (!pBackend->Initialize(std::max(QueueDepth, 1u)))
+            pBackend.reset();
+        return pBackend;
+    }
+
+    ~IOUringBackend()
+    {
+        // Wait for all in-flight operations as the kernel may still write to their buffers.
+        // Completions must be reaped before waiting: if the last ones are already in the
+        // completion queue, io_uring_enter would block forever.
+        while (m_NumInFlight > 0)
+        {
+            ProcessCompletions(nullptr);
+            if (m_NumInFlight == 0)
+                break;
+            if (EnterRing(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+                break;
+        }
+
+        if (m_SQEs != nullptr)
+            munmap(m_SQEs, m_SQEsSize);
+        if (m_CQRing != nullptr && m_CQRing != m_SQRing)
+            munmap(m_CQRing, m_CQRingSize);
+        if (m_SQRing != nullptr)
+            munmap(m_SQRing, m_SQRingSize);
+        if (m_RingFd >= 0)
+            close(m_RingFd);
+    }
+
+    virtual bool IsIOUring() const override final { return true; }
+
+protected:
+    virtual void Enqueue(std::unique_ptr<ReadOp> Op) override final
+    {
+        m_Queue.emplace_back(std::move(Op));
+    }
+
+    virtual void Flush() override final
+    {
+        SubmitQueued();
+    }
+
+    virtual size_t Reap(std::vector<AsyncFileReadResult>& Results, size_t MinCompletions) override final
+    {
+        size_t NumCompleted = 0;
+        while (true)
+        {
+            SubmitQueued();
+            NumCompleted += ProcessCompletions(&Results);
+            if (NumCompleted >= MinCompletions || (m_NumInFlight == 0 && m_Queue.empty()))
+                break;
+
+            if (m_NumInFlight == 0)
+                continue; // Resubmit requeued operations
+
+            if (EnterRing(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+            {
+                LOG_ERROR_MESSAGE("io_uring_enter failed: ", strerror(errno));
+                break;
+            }
+        }
+        return NumCompleted;
+    }
+
+private:
+    IOUringBackend() {}
+
+    int EnterRing(unsigned ToSubmit, unsigned MinComplete, unsigned Flags)
+    {
+        return static_cast<int>(syscall(__NR_io_uring_enter, m_RingFd, ToSubmit, MinComplete, Flags, nullptr, 0));
+    }
+
+    bool Initialize(Uint32 QueueDepth)
+    {
+        io_uring_params Params = {};
+
+        m_RingFd = static_cast<int>(syscall(__NR_io_uring_setup, QueueDepth, &Params));
+        if (m_RingFd < 0)
+            return false;
+
+        m_SQRingSize = Params.sq_off.array + Params.sq_entries * sizeof(__u32);
+        m_CQRingSize = Params.cq_off.cqes + Params.cq_entries * sizeof(io_uring_cqe);
+
+        const bool SingleMMap = (Params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (SingleMMap)
+            m_SQRingSize = m_CQRingSize = std::max(m_SQRingSize, m_CQRingSize);
+
+        m_SQRing = MapRing(m_SQRingSize, IORING_OFF_SQ_RING);
+        if (m_SQRing == nullptr)
+            return false;
+
+        m_CQRing = SingleMMap ? m_SQRing : MapRing(m_CQRingSize, IORING_OFF_CQ_RING);
+        if (m_CQRing == nullptr)
+            return false;
+
+        m_SQEsSize = Params.sq_entries * sizeof(io_uring_sqe);
+        m_SQEs     = static_cast<io_uring_sqe*>(MapRing(m_SQEsSize, IORING_OFF_SQES));
+        if (m_SQEs == nullptr)
+            return false;
+
+        auto* SQ    = static_cast<Uint8*>(m_SQRing);
+        m_SQTail    = reinterpret_cast<__u32*>(SQ + Params.sq_off.tail);
+        m_SQMask    = *reinterpret_cast<__u32*>(SQ + Params.sq_off.ring_mask);
+        m_SQArray   = reinterpret_cast<__u32*>(SQ + Params.sq_off.array);
+        auto* CQ    = static_cast<Uint8*>(m_CQRing);
+        m_CQHead    = reinterpret_cast<__u32*>(CQ + Params.cq_off.head);
+        m_CQTail    = reinterpret_cast<__u32*>(CQ + Params.cq_off.tail);
+        m_CQMask    = *reinterpret_cast<__u32*>(CQ + Params.cq_off.ring_mask);
+        m_CQEs      = reinterpret_cast<io_uring_cqe*>(CQ + Params.cq_off.cqes);
+        m_SQEntries = Params.sq_entries;
+
+        // The number of in-flight operations never exceeds the number of SQ entries,
+        // and the CQ is at least as large as the SQ, so the CQ can't overflow.
+        m_Slots.resize(m_SQEntries);
+        m_FreeSlots.reserve(m_SQEntries);
+        for (Uint32 i = 0; i < m_SQEntries; ++i)
+            m_FreeSlots.push_back(m_SQEntries - 1 - i);
+
+        return true;
+    }
+
+    void* MapRing(size_t Size, off_t Offset)
+    {
+        void* Ptr = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_RingFd, Offset);
+        return Ptr != MAP_FAILED ? Ptr : nullptr;
+    }
+
+    void SubmitQueued()
+    {
+        unsigned ToSubmit = 0;
+
+        __u32 Tail = *m_SQTail;
+        while (!m_Queue.empty() && !m_FreeSlots.empty())
+        {
+            const auto Slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+
+            auto& Op           = m_Slots[Slot];
+            Op                 = std::move(m_Queue.front());
+            Op->IOVec.iov_base = Op->Data.data() + Op->BytesRead;
+            Op->IOVec.iov_len  = Op->Data.size() - Op->BytesRead;
+            m_Queue.pop_front();
+
+            const auto    Idx = Tail & m_SQMask;
+            io_uring_sqe& SQE = m_SQEs[Idx];
+            memset(&SQE, 0, sizeof(SQE));
+            SQE.opcode    = IORING_OP_READV;
+            SQE.fd        = Op->fd;
+            SQE.off       = Op->Offset + Op->BytesRead;
+            SQE.addr      = reinterpret_cast<__u64>(&Op->IOVec);
+            SQE.len       = 1;
+            SQE.user_data = Slot;
+
+            m_SQArray[Idx] = Idx;
+            ++Tail;
+            ++ToSubmit;
+        }
+
+        if (ToSubmit == 0)
+            return;
+
+        __atomic_store_n(m_SQTail, Tail, __ATOMIC_RELEASE);
+
+        while (ToSubmit > 0)
+        {
+            const auto Res = EnterRing(ToSubmit, 0, 0);
+            if (Res < 0)
+            {
+                const int Error = errno;
+                if (Error == EINTR || Error == EAGAIN || Error == EBUSY)
+                {
+                    // Reap completions to make room and retry
+                    ProcessCompletions(nullptr);
+                    continue;
+                }
+                LOG_ERROR_MESSAGE("io_uring_enter failed: ", strerror(Error));
+                FailUnsubmitted(Tail, ToSubmit, Error);
+                break;
+            }
+
+            // The kernel consumes the entries in order
+            const auto NumAccepted = std::min(ToSubmit, static_cast<unsigned>(Res));
+            m_NumInFlight += NumAccepted;
+            ToSubmit -= NumAccepted;
+        }
+    }
+
+    // Withdraws the last NumEntries entries from the submission queue that ends at Tail
+    // and completes their operations with the given error.
+    void FailUnsubmitted(__u32 Tail, unsigned NumEntries, int Error)
+    {
+        // The kernel only reads the SQ tail in io_uring_enter (the ring is not created with
+        // IORING_SETUP_SQPOLL), so the entries it has not consumed can be taken back.
+        __atomic_store_n(m_SQTail, Tail - NumEntries, __ATOMIC_RELEASE);
+
+        for (__u32 i = Tail - NumEntries; i != Tail; ++i)
+        {
+            const auto Slot = static_cast<Uint32>(m_SQEs[m_SQArray[i & m_SQMask]].user_data);
+            VERIFY_EXPR(Slot < m_Slots.size() && m_Slots[Slot]);
+
+            auto Op = std::move(m_Slots[Slot]);
+            m_FreeSlots.push_back(Slot);
+            Op->OnRead(-Error);
+            m_Deferred.emplace_back(std::move(Op));
+        }
+    }
+
+    // Processes all available completion queue entries. Completed operations are appended to
+    // pResults, or to m_Deferred if pResults is null. Returns the number of appended results.
+    size_t ProcessCompletions(std::vector<AsyncFileReadResult>* pResults)
+    {
+        size_t NumCompleted = 0;
+        if (pResults != nullptr)
+        {
+            NumCompleted = m_Deferred.size();
+            for (auto& Op : m_Deferred)
+                pResults->emplace_back(Op->ToResult());
+            m_Deferred.clear();
+        }
+
+        __u32       Head = *m_CQHead;
+        const __u32 Tail = __atomic_load_n(m_CQTail, __ATOMIC_ACQUIRE);
+        for (; Head != Tail; ++Head)
+        {
+            const io_uring_cqe& CQE  = m_CQEs[Head & m_CQMask];
+            const auto          Slot = static_cast<Uint32>(CQE.user_data);
+            VERIFY_EXPR(Slot < m_Slots.size() && m_Slots[Slot]);
+
+            auto Op = std::move(m_Slots[Slot]);
+            m_FreeSlots.push_back(Slot);
+            VERIFY_EXPR(m_NumInFlight > 0);
+            --m_NumInFlight;
+
+            if (CQE.res == -EINTR || CQE.res == -EAGAIN)
+            {
+                // Resubmit the operation
+                m_Queue.emplace_front(std::move(Op));
+            }
+            else if (!Op->OnRead(CQE.res))
+            {
+                // Short read - queue the remaining part
+                m_Queue.emplace_back(std::move(Op));
+            }
+            else if (pResults != nullptr)
+            {
+                pResults->emplace_back(Op->ToResult());
+                ++NumCompleted;
+            }
+            else
+            {
+                m_Deferred.emplace_back(std::move(Op));
+            }
+        }
+        __atomic_store_n(m_CQHead, Head, __ATOMIC_RELEASE);
+
+        return NumCompleted;
+    }
+
+private:
+    int m_RingFd = -1;
+
+    void*  m_SQRing     = nullptr;
+    size_t m_SQRingSize = 0;
+    void*  m_CQRing     = nullptr;
+    size_t m_CQRingSize = 0;
+
+    io_uring_sqe* m_SQEs     = nullptr;
+    size_t        m_SQEsSize = 0;
+
+    __u32*        m_SQTail    = nullptr;
+    __u32         m_SQMask    = 0;
+    __u32*        m_SQArray   = nullptr;
+    __u32*        m_CQHead    = nullptr;
+    __u32*        m_CQTail    = nullptr;
+    __u32         m_CQMask    = 0;
+    io_uring_cqe* m_CQEs      = nullptr;
+    Uint32        m_SQEntries = 0;
+
+    // Operations indexed by the SQE user data
+    std::vector<std::unique_ptr<ReadOp>> m_Slots;
+    std::vector<Uint32>                  m_FreeSlots;
+    size_t                               m_NumInFlight = 0;
+
+    // Operations that wait for a free submission slot
+    std::deque<std::unique_ptr<ReadOp>> m_Queue;
+
+    // Operations completed while making room for new submissions
+    std::vector<std::unique_ptr<ReadOp>> m_Deferred;
+};
+
+#endif
+
+} // namespace
+
+
+LinuxAsyncFileReader::LinuxAsyncFileReader(const AsyncFileReaderCreateInfo& CI)
+{
+#if DILIGENT_HAS_IO_URING && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+    if (!CI.ForceThreadFallback)
+    {
+        m_pBackend = IOUringBackend::Create(CI.QueueDepth);
+        if (!m_pBackend)
+            LOG_INFO_MESSAGE("io_uring is not available. Asynchronous file reads will use worker threads.");
+    }
+#endif
+
+    if (!m_pBackend)
+        m_pBackend.reset(new ThreadPoolBackend{CI.NumFallbackThreads});
+}
+
+LinuxAsyncFileReader::~LinuxAsyncFileReader()
+{
+}
+
+void LinuxAsyncFileReader::Submit(const AsyncFileReadRequest* pRequests, size_t NumRequests)
+{
+    m_pBackend->Submit(pRequests, NumRequests);
+}
+
+size_t LinuxAsyncFileReader::Poll(std::vector<AsyncFileReadResult>& Results)
+{
+    return m_pBackend->Wait(Results, 0);
+}
+
+size_t LinuxAsyncFileReader::Wait(std::vector<AsyncFileReadResult>& Results, size_t MinCompletions)
+{
+    return m_pBackend->Wait(Results, MinCompletions);
+}
+
+size_t LinuxAsyncFileReader::WaitAll(std::vector<AsyncFileReadResult>& Results)
+{
+    return m_pBackend->Wait(Results, m_pBackend->GetNumPending());
+}
+
+size_t LinuxAsyncFileReader::GetNumPendingRequests() const
+{
+    return m_pBackend->GetNumPending();
+}
+
+bool LinuxAsyncFileReader::IsUsingIOUring() const
+{
+    return m_pBackend->IsIOUring();
+}
+
+} // namespace Diligent
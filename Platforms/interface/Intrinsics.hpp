@@ -34,3 +34,8 @@
 #if DILIGENT_AVX2_SUPPORTED && defined(__AVX2__)
 #    define DILIGENT_AVX2_ENABLED 1
 #endif
+
+// MSVC does not define __F16C__, but /arch:AVX2 enables F16C instructions
+#if DILIGENT_AVX2_SUPPORTED && (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+#    define DILIGENT_F16C_ENABLED 1
+#endif
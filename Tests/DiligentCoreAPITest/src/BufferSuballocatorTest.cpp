@@ -153,4 +153,110 @@ TEST(BufferSuballocatorTest, Allocate)
     }
 }
 
+void TestDefragmentation(SUBALLOCATION_ALGORITHM Algorithm)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    BufferSuballocatorCreateInfo CI;
+    CI.Desc.Name      = "Buffer Suballocator Defragmentation Test";
+    CI.Desc.BindFlags = BIND_VERTEX_BUFFER;
+    CI.Desc.Size      = 1024;
+    CI.Algorithm      = Algorithm;
+
+    RefCntAutoPtr<IBufferSuballocator> pAllocator;
+    CreateBufferSuballocator(pDevice, CI, &pAllocator);
+    ASSERT_NE(pAllocator, nullptr);
+
+    constexpr Uint32 AllocSize      = 48;
+    constexpr Uint32 NumAllocations = 16;
+
+    std::vector<RefCntAutoPtr<IBufferSuballocation>> Allocs(NumAllocations);
+    for (auto& Alloc : Allocs)
+    {
+        pAllocator->Allocate(AllocSize, 16, &Alloc);
+        ASSERT_NE(Alloc, nullptr);
+    }
+
+    // Release every other allocation
+    for (size_t i = 0; i < Allocs.size(); i += 2)
+        Allocs[i].Release();
+    Allocs.erase(std::remove_if(Allocs.begin(), Allocs.end(), [](const RefCntAutoPtr<IBufferSuballocation>& Alloc) { return !Alloc; }), Allocs.end());
+    ASSERT_EQ(Allocs.size(), size_t{NumAllocations / 2});
+
+    for (auto& Alloc : Allocs)
+        Alloc->SetUserData(pAllocator);
+
+    BufferSuballocatorUsageStats Stats;
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.FreeChunkCount, NumAllocations / 2 + 1);
+    EXPECT_EQ(Stats.UsedSize + Stats.FreeSize, CI.Desc.Size);
+    EXPECT_GT(Stats.GetFragmentation(), 0.25);
+
+    auto* pBuffer = pAllocator->Update(pDevice, pContext);
+    EXPECT_NE(pBuffer, nullptr);
+
+    Uint32 NumPlans = 0;
+    for (;; ++NumPlans)
+    {
+        std::vector<IBufferSuballocation*> pSuballocations(Allocs.size());
+        for (size_t i = 0; i < Allocs.size(); ++i)
+            pSuballocations[i] = Allocs[i];
+        std::vector<IBufferSuballocation*> pNewSuballocations(Allocs.size());
+
+        BufferSuballocatorDefragmentationAttribs Attribs;
+        Attribs.ppSuballocations  = pSuballocations.data();
+        Attribs.NumSuballocations = static_cast<Uint32>(pSuballocations.size());
+        Attribs.MaxMoves          = 2;
+
+        const auto NumMoves = pAllocator->PlanDefragmentation(Attribs, pNewSuballocations.data());
+        EXPECT_LE(NumMoves, Attribs.MaxMoves);
+        if (NumMoves == 0)
+            break;
+
+        Uint32 NumNewSuballocations = 0;
+        for (size_t i = 0; i < Allocs.size(); ++i)
+        {
+            auto* pNewSuballoc = pNewSuballocations[i];
+            if (pNewSuballoc == nullptr)
+                continue;
+
+            ++NumNewSuballocations;
+            auto& pOldSuballoc = Allocs[i];
+            EXPECT_EQ(pNewSuballoc->GetAllocator(), pAllocator.RawPtr());
+            EXPECT_EQ(pNewSuballoc->GetSize(), pOldSuballoc->GetSize());
+            EXPECT_EQ(pNewSuballoc->GetOffset() % 16, 0u);
+            EXPECT_LE(pNewSuballoc->GetOffset() + pNewSuballoc->GetSize(), pOldSuballoc->GetOffset());
+            EXPECT_EQ(pNewSuballoc->GetUserData(), pOldSuballoc->GetUserData());
+
+            // Replace the original suballocation with the new one
+            pOldSuballoc = pNewSuballoc;
+            pNewSuballoc->Release();
+        }
+        EXPECT_EQ(NumNewSuballocations, NumMoves);
+    }
+    EXPECT_EQ(NumPlans, 2u);
+
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, NumAllocations / 2);
+    EXPECT_EQ(Stats.FreeChunkCount, 1u);
+    EXPECT_EQ(Stats.GetFragmentation(), 0.0);
+
+    for (auto& Alloc : Allocs)
+        EXPECT_LT(Alloc->GetOffset(), AllocSize * NumAllocations / 2);
+}
+
+TEST(BufferSuballocatorTest, Defragmentation)
+{
+    TestDefragmentation(SUBALLOCATION_ALGORITHM_BEST_FIT);
+}
+
+TEST(BufferSuballocatorTest, Defragmentation_TLSF)
+{
+    TestDefragmentation(SUBALLOCATION_ALGORITHM_TLSF);
+}
+
 } // namespace
@@ -183,4 +183,113 @@ TEST(VertexPoolTest, Allocate)
     }
 }
 
+void TestDefragmentation(SUBALLOCATION_ALGORITHM Algorithm)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    constexpr VertexPoolElementDesc Elements[] =
+        {
+            VertexPoolElementDesc{16},
+            VertexPoolElementDesc{24, BIND_SHADER_RESOURCE, USAGE_DEFAULT, BUFFER_MODE_STRUCTURED, CPU_ACCESS_NONE},
+        };
+    VertexPoolCreateInfo CI;
+    CI.Desc.Name        = "Test vertex pool";
+    CI.Desc.pElements   = Elements;
+    CI.Desc.NumElements = _countof(Elements);
+    CI.Desc.VertexCount = 1024;
+    CI.Algorithm        = Algorithm;
+
+    RefCntAutoPtr<IVertexPool> pVtxPool;
+    CreateVertexPool(pDevice, CI, &pVtxPool);
+    ASSERT_NE(pVtxPool, nullptr);
+
+    constexpr Uint32 AllocVertexCount = 32;
+    constexpr Uint32 NumAllocations   = 16;
+
+    std::vector<RefCntAutoPtr<IVertexPoolAllocation>> Allocs(NumAllocations);
+    for (auto& Alloc : Allocs)
+    {
+        pVtxPool->Allocate(AllocVertexCount, &Alloc);
+        ASSERT_NE(Alloc, nullptr);
+    }
+
+    // Release every other allocation
+    for (size_t i = 0; i < Allocs.size(); i += 2)
+        Allocs[i].Release();
+    Allocs.erase(std::remove_if(Allocs.begin(), Allocs.end(), [](const RefCntAutoPtr<IVertexPoolAllocation>& Alloc) { return !Alloc; }), Allocs.end());
+    ASSERT_EQ(Allocs.size(), size_t{NumAllocations / 2});
+
+    for (auto& Alloc : Allocs)
+        Alloc->SetUserData(pVtxPool);
+
+    VertexPoolUsageStats Stats;
+    pVtxPool->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.FreeChunkCount, NumAllocations / 2 + 1);
+    EXPECT_GT(Stats.GetFragmentation(), 0.25);
+
+    pVtxPool->UpdateAll(pDevice, pContext);
+
+    Uint32 NumPlans = 0;
+    for (;; ++NumPlans)
+    {
+        std::vector<IVertexPoolAllocation*> pAllocations(Allocs.size());
+        for (size_t i = 0; i < Allocs.size(); ++i)
+            pAllocations[i] = Allocs[i];
+        std::vector<IVertexPoolAllocation*> pNewAllocations(Allocs.size());
+
+        VertexPoolDefragmentationAttribs Attribs;
+        Attribs.ppAllocations  = pAllocations.data();
+        Attribs.NumAllocations = static_cast<Uint32>(pAllocations.size());
+        Attribs.MaxMoves       = 2;
+
+        const auto NumMoves = pVtxPool->PlanDefragmentation(Attribs, pNewAllocations.data());
+        EXPECT_LE(NumMoves, Attribs.MaxMoves);
+        if (NumMoves == 0)
+            break;
+
+        Uint32 NumNewAllocations = 0;
+        for (size_t i = 0; i < Allocs.size(); ++i)
+        {
+            auto* pNewAlloc = pNewAllocations[i];
+            if (pNewAlloc == nullptr)
+                continue;
+
+            ++NumNewAllocations;
+            auto& pOldAlloc = Allocs[i];
+            EXPECT_EQ(pNewAlloc->GetPool(), pVtxPool.RawPtr());
+            EXPECT_EQ(pNewAlloc->GetVertexCount(), pOldAlloc->GetVertexCount());
+            EXPECT_LE(pNewAlloc->GetStartVertex() + pNewAlloc->GetVertexCount(), pOldAlloc->GetStartVertex());
+            EXPECT_EQ(pNewAlloc->GetUserData(), pOldAlloc->GetUserData());
+
+            // Replace the original allocation with the new one
+            pOldAlloc = pNewAlloc;
+            pNewAlloc->Release();
+        }
+        EXPECT_EQ(NumNewAllocations, NumMoves);
+    }
+    EXPECT_EQ(NumPlans, 2u);
+
+    pVtxPool->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, NumAllocations / 2);
+    EXPECT_EQ(Stats.FreeChunkCount, 1u);
+    EXPECT_EQ(Stats.GetFragmentation(), 0.0);
+
+    for (auto& Alloc : Allocs)
+        EXPECT_LT(Alloc->GetStartVertex(), AllocVertexCount * NumAllocations / 2);
+}
+
+TEST(VertexPoolTest, Defragmentation)
+{
+    TestDefragmentation(SUBALLOCATION_ALGORITHM_BEST_FIT);
+}
+
+TEST(VertexPoolTest, Defragmentation_TLSF)
+{
+    TestDefragmentation(SUBALLOCATION_ALGORITHM_TLSF);
+}
+
 } // namespace
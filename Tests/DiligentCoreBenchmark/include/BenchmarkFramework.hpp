@@ -0,0 +1,252 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Lightweight micro-benchmark framework used by DiligentCoreBenchmark.
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+#include <initializer_list>
+#include <atomic>
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+namespace Benchmark
+{
+
+/// Benchmark state that is passed to every benchmark function.
+
+/// A benchmark function must run its measured loop while KeepRunning() returns true:
+///
+///     void LRUCache_Get(Benchmark::State& State)
+///     {
+///         // Set-up code is not timed
+///         while (State.KeepRunning())
+///         {
+///             // Measured code
+///         }
+///         State.SetItemsProcessed(State.GetIterations());
+///     }
+///     DILIGENT_BENCHMARK(LRUCache_Get);
+class State
+{
+public:
+    State(Uint64 MaxIterations, Int64 Arg) noexcept :
+        m_MaxIterations{MaxIterations},
+        m_Arg{Arg}
+    {}
+
+    /// Returns true if the benchmark loop should run one more iteration.
+
+    /// The timer is started on the first call and stopped when the method returns false.
+    bool KeepRunning()
+    {
+        if (m_Iteration < m_MaxIterations)
+        {
+            if (m_Iteration == 0)
+                ResumeTiming();
+            ++m_Iteration;
+            return true;
+        }
+
+        if (m_IsRunning)
+            PauseTiming();
+        return false;
+    }
+
+    /// Stops the timer, e.g. to exclude per-iteration set-up work from the measurement.
+    void PauseTiming()
+    {
+        if (m_IsRunning)
+        {
+            m_ElapsedTime += std::chrono::high_resolution_clock::now() - m_StartTime;
+            m_IsRunning = false;
+        }
+    }
+
+    /// Restarts the timer stopped by PauseTiming().
+    void ResumeTiming()
+    {
+        if (!m_IsRunning)
+        {
+            m_StartTime = std::chrono::high_resolution_clock::now();
+            m_IsRunning = true;
+        }
+    }
+
+    /// Returns the benchmark argument, or 0 if the benchmark was registered without arguments.
+    Int64 GetArg() const { return m_Arg; }
+
+    /// Returns the number of iterations the benchmark loop runs.
+    Uint64 GetIterations() const { return m_MaxIterations; }
+
+    /// Sets the total number of items processed by all iterations.
+    /// The runner reports the value as items per second.
+    void SetItemsProcessed(Uint64 Items) { m_ItemsProcessed = Items; }
+
+    /// Sets the total number of bytes processed by all iterations.
+    /// The runner reports the value as bytes per second.
+    void SetBytesProcessed(Uint64 Bytes) { m_BytesProcessed = Bytes; }
+
+    /// Sets a user-defined counter, e.g. the quality of the result produced by the benchmarked code.
+    /// The runner reports the value as is, under the given name.
+    void SetCounter(const char* Name, double Value)
+    {
+        for (auto& Counter : m_Counters)
+        {
+            if (Counter.first == Name)
+            {
+                Counter.second = Value;
+                return;
+            }
+        }
+        m_Counters.emplace_back(Name, Value);
+    }
+
+    Uint64 GetItemsProcessed() const { return m_ItemsProcessed; }
+    Uint64 GetBytesProcessed() const { return m_BytesProcessed; }
+
+    const std::vector<std::pair<std::string, double>>& GetCounters() const { return m_Counters; }
+
+    /// Returns the total measured time, in seconds.
+    double GetElapsedTime() const
+    {
+        return std::chrono::duration<double>{m_ElapsedTime}.count();
+    }
+
+private:
+    const Uint64 m_MaxIterations;
+    const Int64  m_Arg;
+
+    Uint64 m_Iteration      = 0;
+    Uint64 m_ItemsProcessed = 0;
+    Uint64 m_BytesProcessed = 0;
+    bool   m_IsRunning      = false;
+
+    std::vector<std::pair<std::string, double>> m_Counters;
+
+    std::chrono::high_resolution_clock::time_point m_StartTime;
+    std::chrono::high_resolution_clock::duration   m_ElapsedTime{0};
+};
+
+
+using BenchmarkFunctionType = void (*)(State&);
+
+/// Registers the benchmark function in the global registry.
+
+/// \param [in] Name - Benchmark name.
+/// \param [in] Func - Benchmark function.
+/// \param [in] Args - Optional list of arguments. The benchmark is executed
+///                    once for every argument, and the argument value is
+///                    appended to the benchmark name (e.g. "LRUCache_Get/1024").
+///
+/// \return     The number of registered benchmarks.
+///
+/// \remarks    The function is intended to be called by the DILIGENT_BENCHMARK
+///             macros during static initialization.
+int RegisterBenchmark(const char* Name, BenchmarkFunctionType Func, std::initializer_list<Int64> Args = {});
+
+
+/// Benchmark runner settings.
+struct RunSettings
+{
+    /// Only benchmarks whose names contain this string are executed.
+    std::string Filter;
+
+    /// Minimum time, in seconds, that a single benchmark run should take.
+    /// The number of iterations is increased until this time is reached.
+    double MinTime = 0.5;
+
+    /// The number of times every benchmark is repeated.
+    /// When greater than one, mean, median and min aggregates are reported.
+    Uint32 Repetitions = 1;
+
+    /// Path to the output JSON file. If empty, JSON is written to the standard output.
+    std::string OutputFile;
+
+    /// If true, progress is printed to the standard error.
+    bool Verbose = true;
+};
+
+/// Runs all registered benchmarks that match the filter and writes the results as JSON.
+
+/// \return     true if the results were successfully written, and false otherwise.
+bool RunBenchmarks(const RunSettings& Settings);
+
+/// Returns the names of all registered benchmarks, including the argument suffixes.
+std::vector<std::string> GetBenchmarkNames();
+
+
+/// Prevents the compiler from optimizing away the computation of Value.
+template <typename T>
+inline void DoNotOptimize(const T& Value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile(""
+                 :
+                 : "r,m"(Value)
+                 : "memory");
+#else
+    static volatile const void* volatile Sink;
+    Sink = &Value;
+#endif
+}
+
+/// Forces the compiler to assume that all memory may have been read or written.
+inline void ClobberMemory()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile(""
+                 :
+                 :
+                 : "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_acq_rel);
+#endif
+}
+
+} // namespace Benchmark
+
+} // namespace Diligent
+
+#define DILIGENT_BENCHMARK_CONCAT_IMPL(X, Y) X##Y
+#define DILIGENT_BENCHMARK_CONCAT(X, Y)      DILIGENT_BENCHMARK_CONCAT_IMPL(X, Y)
+
+/// Registers a benchmark function.
+#define DILIGENT_BENCHMARK(Func) \
+    static const int DILIGENT_BENCHMARK_CONCAT(Func, _Registered) = ::Diligent::Benchmark::RegisterBenchmark(#Func, Func)
+
+/// Registers a benchmark function that is executed once for every argument in the list.
+#define DILIGENT_BENCHMARK_ARGS(Func, ...) \
+    static const int DILIGENT_BENCHMARK_CONCAT(Func, _Registered) = ::Diligent::Benchmark::RegisterBenchmark(#Func, Func, {__VA_ARGS__})
@@ -0,0 +1,362 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BenchmarkFramework.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <thread>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace Benchmark
+{
+
+namespace
+{
+
+struct BenchmarkInfo
+{
+    std::string           Name;
+    BenchmarkFunctionType Func = nullptr;
+    Int64                 Arg  = 0;
+};
+
+std::vector<BenchmarkInfo>& GetRegistry()
+{
+    // Function-local static avoids the static initialization order problem,
+    // since benchmarks are registered from static initializers in other translation units.
+    static std::vector<BenchmarkInfo> Registry;
+    return Registry;
+}
+
+struct RunResult
+{
+    std::string Name;
+    std::string RunName;
+    std::string AggregateName;
+    Uint32      RepetitionIndex = 0;
+    Uint64      Iterations      = 0;
+    double      RealTime        = 0; // Time per iteration, in nanoseconds
+    double      ItemsPerSecond  = 0;
+    double      BytesPerSecond  = 0;
+
+    std::vector<std::pair<std::string, double>> Counters;
+};
+
+RunResult RunOnce(const BenchmarkInfo& Info, Uint64 Iterations)
+{
+    State BenchState{Iterations, Info.Arg};
+    Info.Func(BenchState);
+
+    const double ElapsedTime = std::max(BenchState.GetElapsedTime(), 1e-12);
+
+    RunResult Res;
+    Res.Name       = Info.Name;
+    Res.RunName    = Info.Name;
+    Res.Iterations = Iterations;
+    Res.RealTime   = ElapsedTime * 1e+9 / static_cast<double>(Iterations);
+    if (BenchState.GetItemsProcessed() != 0)
+        Res.ItemsPerSecond = static_cast<double>(BenchState.GetItemsProcessed()) / ElapsedTime;
+    if (BenchState.GetBytesProcessed() != 0)
+        Res.BytesPerSecond = static_cast<double>(BenchState.GetBytesProcessed()) / ElapsedTime;
+    Res.Counters = BenchState.GetCounters();
+    return Res;
+}
+
+// Finds the number of iterations required for the benchmark to run for at least MinTime seconds,
+// and returns the result of the first run that satisfies this requirement.
+RunResult CalibrateAndRun(const BenchmarkInfo& Info, double MinTime)
+{
+    static constexpr Uint64 MaxIterations = Uint64{1} << 40;
+
+    Uint64 Iterations = 1;
+    while (true)
+    {
+        const auto   Res         = RunOnce(Info, Iterations);
+        const double ElapsedTime = Res.RealTime * 1e-9 * static_cast<double>(Iterations);
+        if (ElapsedTime >= MinTime || Iterations >= MaxIterations)
+            return Res;
+
+        // Predict the number of iterations with a 40% safety margin, but do not grow
+        // by more than 10x at a time as very short runs are not reliable.
+        double Multiplier = ElapsedTime > 0 ? MinTime * 1.4 / ElapsedTime : 10.0;
+        Multiplier        = std::min(std::max(Multiplier, 2.0), 10.0);
+        Iterations        = std::min(static_cast<Uint64>(static_cast<double>(Iterations) * Multiplier), MaxIterations);
+    }
+}
+
+RunResult ComputeAggregate(const std::vector<RunResult>& Runs, const char* AggregateName)
+{
+    VERIFY_EXPR(!Runs.empty());
+
+    auto Aggregate = [&](std::vector<double> Values) {
+        if (strcmp(AggregateName, "mean") == 0)
+        {
+            double Sum = 0;
+            for (auto Val : Values)
+                Sum += Val;
+            return Sum / static_cast<double>(Values.size());
+        }
+        else if (strcmp(AggregateName, "median") == 0)
+        {
+            std::sort(Values.begin(), Values.end());
+            const size_t Mid = Values.size() / 2;
+            return (Values.size() % 2 != 0) ? Values[Mid] : (Values[Mid - 1] + Values[Mid]) * 0.5;
+        }
+        else
+        {
+            VERIFY_EXPR(strcmp(AggregateName, "min") == 0);
+            return *std::min_element(Values.begin(), Values.end());
+        }
+    };
+
+    auto Select = [&](double RunResult::*Member) {
+        std::vector<double> Values;
+        Values.reserve(Runs.size());
+        for (const auto& Run : Runs)
+            Values.push_back(Run.*Member);
+        return Aggregate(std::move(Values));
+    };
+
+    RunResult Res;
+    Res.Name           = Runs[0].Name + "_" + AggregateName;
+    Res.RunName        = Runs[0].Name;
+    Res.AggregateName  = AggregateName;
+    Res.Iterations     = Runs[0].Iterations;
+    Res.RealTime       = Select(&RunResult::RealTime);
+    Res.ItemsPerSecond = Select(&RunResult::ItemsPerSecond);
+    Res.BytesPerSecond = Select(&RunResult::BytesPerSecond);
+    for (size_t i = 0; i < Runs[0].Counters.size(); ++i)
+    {
+        // All repetitions run the same code and set the same counters
+        std::vector<double> Values;
+        Values.reserve(Runs.size());
+        for (const auto& Run : Runs)
+        {
+            VERIFY_EXPR(i < Run.Counters.size() && Run.Counters[i].first == Runs[0].Counters[i].first);
+            Values.push_back(i < Run.Counters.size() ? Run.Counters[i].second : 0);
+        }
+        Res.Counters.emplace_back(Runs[0].Counters[i].first, Aggregate(std::move(Values)));
+    }
+    return Res;
+}
+
+std::string EscapeJsonString(const std::string& Str)
+{
+    std::string Res;
+    Res.reserve(Str.size() + 2);
+    for (char c : Str)
+    {
+        switch (c)
+        {
+            case '"': Res += "\\\""; break;
+            case '\\': Res += "\\\\"; break;
+            case '\n': Res += "\\n"; break;
+            case '\r': Res += "\\r"; break;
+            case '\t': Res += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char Buff[8];
+                    snprintf(Buff, sizeof(Buff), "\\u%04x", static_cast<unsigned int>(c));
+                    Res += Buff;
+                }
+                else
+                {
+                    Res += c;
+                }
+        }
+    }
+    return Res;
+}
+
+std::string GetDateString()
+{
+    const std::time_t Now = std::time(nullptr);
+    std::tm           LocalTime{};
+#ifdef _MSC_VER
+    localtime_s(&LocalTime, &Now);
+#else
+    localtime_r(&Now, &LocalTime);
+#endif
+    char Buff[64];
+    std::strftime(Buff, sizeof(Buff), "%Y-%m-%dT%H:%M:%S", &LocalTime);
+    return Buff;
+}
+
+void WriteJson(std::ostream& Stream, const RunSettings& Settings, const std::vector<RunResult>& Results)
+{
+    // Use max_digits10 to make sure the values round-trip without loss
+    Stream.precision(17);
+
+    Stream << "{\n"
+           << "  \"context\": {\n"
+           << "    \"date\": \"" << GetDateString() << "\",\n"
+           << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef DILIGENT_DEBUG
+           << "    \"library_build_type\": \"debug\",\n"
+#else
+           << "    \"library_build_type\": \"release\",\n"
+#endif
+           << "    \"min_time\": " << Settings.MinTime << ",\n"
+           << "    \"repetitions\": " << Settings.Repetitions << "\n"
+           << "  },\n"
+           << "  \"benchmarks\": [";
+
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Res = Results[i];
+        Stream << (i > 0 ? ",\n" : "\n")
+               << "    {\n"
+               << "      \"name\": \"" << EscapeJsonString(Res.Name) << "\",\n"
+               << "      \"run_name\": \"" << EscapeJsonString(Res.RunName) << "\",\n";
+        if (Res.AggregateName.empty())
+        {
+            Stream << "      \"run_type\": \"iteration\",\n"
+                   << "      \"repetition_index\": " << Res.RepetitionIndex << ",\n";
+        }
+        else
+        {
+            Stream << "      \"run_type\": \"aggregate\",\n"
+                   << "      \"aggregate_name\": \"" << Res.AggregateName << "\",\n";
+        }
+        Stream << "      \"iterations\": " << Res.Iterations << ",\n"
+               << "      \"real_time\": " << Res.RealTime << ",\n"
+               << "      \"time_unit\": \"ns\"";
+        if (Res.ItemsPerSecond != 0)
+            Stream << ",\n      \"items_per_second\": " << Res.ItemsPerSecond;
+        if (Res.BytesPerSecond != 0)
+            Stream << ",\n      \"bytes_per_second\": " << Res.BytesPerSecond;
+        for (const auto& Counter : Res.Counters)
+            Stream << ",\n      \"" << EscapeJsonString(Counter.first) << "\": " << Counter.second;
+        Stream << "\n    }";
+    }
+    Stream << "\n  ]\n}\n";
+}
+
+} // namespace
+
+
+int RegisterBenchmark(const char* Name, BenchmarkFunctionType Func, std::initializer_list<Int64> Args)
+{
+    auto& Registry = GetRegistry();
+    if (Args.size() == 0)
+    {
+        Registry.push_back({Name, Func, 0});
+    }
+    else
+    {
+        for (auto Arg : Args)
+            Registry.push_back({std::string{Name} + "/" + std::to_string(Arg), Func, Arg});
+    }
+    return static_cast<int>(Registry.size());
+}
+
+std::vector<std::string> GetBenchmarkNames()
+{
+    std::vector<std::string> Names;
+    for (const auto& Info : GetRegistry())
+        Names.push_back(Info.Name);
+    return Names;
+}
+
+bool RunBenchmarks(const RunSettings& Settings)
+{
+    const Uint32 Repetitions = std::max(Settings.Repetitions, 1u);
+
+    std::vector<RunResult> Results;
+    for (const auto& Info : GetRegistry())
+    {
+        if (!Settings.Filter.empty() && Info.Name.find(Settings.Filter) == std::string::npos)
+            continue;
+
+        std::vector<RunResult> Runs;
+        Runs.reserve(Repetitions);
+        Runs.emplace_back(CalibrateAndRun(Info, Settings.MinTime));
+        for (Uint32 rep = 1; rep < Repetitions; ++rep)
+        {
+            Runs.emplace_back(RunOnce(Info, Runs[0].Iterations));
+            Runs.back().RepetitionIndex = rep;
+        }
+
+        for (const auto& Run : Runs)
+        {
+            if (Settings.Verbose)
+            {
+                std::cerr << std::left;
+                std::cerr.width(48);
+                std::cerr << Run.Name << ' ';
+                std::cerr << std::right;
+                std::cerr.width(14);
+                std::cerr << static_cast<Uint64>(std::round(Run.RealTime)) << " ns ";
+                std::cerr.width(12);
+                std::cerr << Run.Iterations;
+                for (const auto& Counter : Run.Counters)
+                    std::cerr << ' ' << Counter.first << '=' << Counter.second;
+                std::cerr << '\n';
+            }
+            Results.push_back(Run);
+        }
+
+        if (Repetitions > 1)
+        {
+            for (const char* AggregateName : {"mean", "median", "min"})
+                Results.emplace_back(ComputeAggregate(Runs, AggregateName));
+        }
+    }
+
+    if (Settings.OutputFile.empty())
+    {
+        WriteJson(std::cout, Settings, Results);
+        std::cout.flush();
+        return static_cast<bool>(std::cout);
+    }
+    else
+    {
+        std::ofstream File{Settings.OutputFile};
+        if (!File)
+        {
+            std::cerr << "Failed to open output file '" << Settings.OutputFile << "'\n";
+            return false;
+        }
+        WriteJson(File, Settings, Results);
+        return static_cast<bool>(File);
+    }
+}
+
+} // namespace Benchmark
+
+} // namespace Diligent
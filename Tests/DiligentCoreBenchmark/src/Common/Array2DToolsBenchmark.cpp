@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "Array2DTools.hpp"
+
+#include <thread>
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+std::vector<float> CreateHeightMap(Uint32 Size)
+{
+    FastRandFloat      Rnd{0, 0.f, 1000.f};
+    std::vector<float> Data(size_t{Size} * Size);
+    for (auto& Val : Data)
+        Val = Rnd();
+    return Data;
+}
+
+RefCntAutoPtr<IThreadPool> CreateBenchmarkThreadPool()
+{
+    return CreateThreadPool(ThreadPoolCreateInfo{std::max(std::thread::hardware_concurrency(), 1u)});
+}
+
+template <bool UseThreadPool>
+void Array2DTools_MinMax(Benchmark::State& State)
+{
+    const Uint32 Size        = static_cast<Uint32>(State.GetArg());
+    const auto   Data        = CreateHeightMap(Size);
+    const auto   pThreadPool = UseThreadPool ? CreateBenchmarkThreadPool() : RefCntAutoPtr<IThreadPool>{};
+    while (State.KeepRunning())
+    {
+        float Min = 0, Max = 0;
+        GetArray2DMinMaxValue(Data.data(), Size, Size, Size, Min, Max, pThreadPool);
+        Benchmark::DoNotOptimize(Min);
+        Benchmark::DoNotOptimize(Max);
+    }
+    State.SetItemsProcessed(State.GetIterations() * Data.size());
+}
+void Array2DTools_MinMax(Benchmark::State& State) { Array2DTools_MinMax<false>(State); }
+void Array2DTools_MinMaxThreadPool(Benchmark::State& State) { Array2DTools_MinMax<true>(State); }
+DILIGENT_BENCHMARK_ARGS(Array2DTools_MinMax, 1024, 4096);
+DILIGENT_BENCHMARK_ARGS(Array2DTools_MinMaxThreadPool, 4096);
+
+
+template <bool UseThreadPool>
+void Array2DTools_MinMaxPyramid(Benchmark::State& State)
+{
+    const Uint32 Size        = static_cast<Uint32>(State.GetArg());
+    const auto   Data        = CreateHeightMap(Size);
+    const auto   pThreadPool = UseThreadPool ? CreateBenchmarkThreadPool() : RefCntAutoPtr<IThreadPool>{};
+
+    Array2DMinMaxPyramid Pyramid;
+    while (State.KeepRunning())
+    {
+        Pyramid.Build(Data.data(), Size, Size, Size, pThreadPool);
+        Benchmark::DoNotOptimize(Pyramid.GetMinValues(0));
+    }
+    State.SetItemsProcessed(State.GetIterations() * Data.size());
+}
+void Array2DTools_MinMaxPyramid(Benchmark::State& State) { Array2DTools_MinMaxPyramid<false>(State); }
+void Array2DTools_MinMaxPyramidThreadPool(Benchmark::State& State) { Array2DTools_MinMaxPyramid<true>(State); }
+DILIGENT_BENCHMARK_ARGS(Array2DTools_MinMaxPyramid, 1024, 4096);
+DILIGENT_BENCHMARK_ARGS(Array2DTools_MinMaxPyramidThreadPool, 4096);
+
+} // namespace
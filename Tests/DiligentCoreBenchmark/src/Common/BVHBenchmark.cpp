@@ -0,0 +1,171 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BVH.hpp"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct BVHScene
+{
+    explicit BVHScene(Uint32 NumTriangles)
+    {
+        FastRandFloat Rnd{0, -100.f, 100.f};
+        FastRandFloat RndOffset{1, -2.f, 2.f};
+        for (Uint32 t = 0; t < NumTriangles; ++t)
+        {
+            const float3 Center{Rnd(), Rnd(), Rnd()};
+            for (Uint32 v = 0; v < 3; ++v)
+            {
+                Indices.push_back(static_cast<Uint32>(Vertices.size()));
+                Vertices.push_back(Center + float3{RndOffset(), RndOffset(), RndOffset()});
+            }
+        }
+
+        // Coherent primary rays from a pinhole camera
+        constexpr Uint32 Res = 64;
+        for (Uint32 y = 0; y < Res; ++y)
+        {
+            for (Uint32 x = 0; x < Res; ++x)
+            {
+                BVHRay Ray;
+                Ray.Origin    = float3{0, 0, -150};
+                Ray.Direction = normalize(float3{(x + 0.5f) / Res - 0.5f, (y + 0.5f) / Res - 0.5f, 1.f});
+                Rays.push_back(Ray);
+            }
+        }
+    }
+
+    Uint32 GetNumTriangles() const { return static_cast<Uint32>(Indices.size() / 3); }
+
+    std::vector<float3> Vertices;
+    std::vector<Uint32> Indices;
+    std::vector<BVHRay> Rays;
+};
+
+void BVH_Build(Benchmark::State& State)
+{
+    const BVHScene Scene{static_cast<Uint32>(State.GetArg())};
+    while (State.KeepRunning())
+    {
+        auto BVH = CreateTriangleMeshBVH(Scene.Vertices.data(), Scene.Indices.data(), Scene.GetNumTriangles());
+        Benchmark::DoNotOptimize(BVH.GetNodes().data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * State.GetArg());
+}
+DILIGENT_BENCHMARK_ARGS(BVH_Build, 10000, 100000);
+
+
+void BVH_BuildThreadPool(Benchmark::State& State)
+{
+    const BVHScene Scene{static_cast<Uint32>(State.GetArg())};
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{std::max(std::thread::hardware_concurrency(), 1u)});
+
+    BoundingVolumeHierarchy::CreateInfo CI;
+    CI.pThreadPool = pThreadPool;
+    while (State.KeepRunning())
+    {
+        auto BVH = CreateTriangleMeshBVH(Scene.Vertices.data(), Scene.Indices.data(), Scene.GetNumTriangles(), CI);
+        Benchmark::DoNotOptimize(BVH.GetNodes().data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * State.GetArg());
+}
+DILIGENT_BENCHMARK_ARGS(BVH_BuildThreadPool, 100000);
+
+
+void BVH_RayBruteForce(Benchmark::State& State)
+{
+    const BVHScene               Scene{static_cast<Uint32>(State.GetArg())};
+    const BVHTriangleIntersector Intersector{Scene.Vertices.data(), Scene.Indices.data()};
+    // Brute force is too slow to trace all rays
+    const size_t NumRays = 64;
+    while (State.KeepRunning())
+    {
+        for (size_t r = 0; r < NumRays; ++r)
+        {
+            const auto& Ray     = Scene.Rays[r * Scene.Rays.size() / NumRays];
+            float       Closest = +FLT_MAX;
+            for (Uint32 t = 0; t < Scene.GetNumTriangles(); ++t)
+            {
+                const float Dist = Intersector(t, Ray);
+                if (Dist >= 0 && Dist < Closest)
+                    Closest = Dist;
+            }
+            Benchmark::DoNotOptimize(Closest);
+        }
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumRays);
+}
+DILIGENT_BENCHMARK_ARGS(BVH_RayBruteForce, 10000);
+
+
+template <bool AnyHit>
+void BVH_Ray(Benchmark::State& State)
+{
+    const BVHScene               Scene{static_cast<Uint32>(State.GetArg())};
+    const BVHTriangleIntersector Intersector{Scene.Vertices.data(), Scene.Indices.data()};
+    const auto                   BVH = CreateTriangleMeshBVH(Scene.Vertices.data(), Scene.Indices.data(), Scene.GetNumTriangles());
+    while (State.KeepRunning())
+    {
+        for (const auto& Ray : Scene.Rays)
+            Benchmark::DoNotOptimize(AnyHit ? BVH.IntersectAny(Ray, Intersector) : BVH.IntersectClosest(Ray, Intersector));
+    }
+    State.SetItemsProcessed(State.GetIterations() * Scene.Rays.size());
+}
+void BVH_RayClosest(Benchmark::State& State) { BVH_Ray<false>(State); }
+void BVH_RayAny(Benchmark::State& State) { BVH_Ray<true>(State); }
+DILIGENT_BENCHMARK_ARGS(BVH_RayClosest, 10000, 100000);
+DILIGENT_BENCHMARK_ARGS(BVH_RayAny, 10000, 100000);
+
+
+void BVH_RayClosest4(Benchmark::State& State)
+{
+    const BVHScene               Scene{static_cast<Uint32>(State.GetArg())};
+    const BVHTriangleIntersector Intersector{Scene.Vertices.data(), Scene.Indices.data()};
+    const auto                   BVH = CreateTriangleMeshBVH(Scene.Vertices.data(), Scene.Indices.data(), Scene.GetNumTriangles());
+    while (State.KeepRunning())
+    {
+        for (size_t r = 0; r + 4 <= Scene.Rays.size(); r += 4)
+        {
+            BVHHit Hits[4];
+            BVH.IntersectClosest4(&Scene.Rays[r], Hits, Intersector);
+            Benchmark::DoNotOptimize(Hits);
+        }
+    }
+    State.SetItemsProcessed(State.GetIterations() * Scene.Rays.size());
+}
+DILIGENT_BENCHMARK_ARGS(BVH_RayClosest4, 10000, 100000);
+
+} // namespace
@@ -0,0 +1,168 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BasicMath.hpp"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr size_t NumElements = 1024;
+
+// Scalar reference implementations that match the generic BasicMath code.
+// They are used to measure the speedup of the SIMD kernels.
+float4x4 MulScalar(const float4x4& m1, const float4x4& m2)
+{
+    float4x4 mOut;
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            for (int k = 0; k < 4; k++)
+            {
+                mOut.m[i][j] += m1.m[i][k] * m2.m[k][j];
+            }
+        }
+    }
+    return mOut;
+}
+
+float4 MulScalar(const float4& v, const float4x4& m)
+{
+    float4 out;
+    out[0] = v.x * m[0][0] + v.y * m[1][0] + v.z * m[2][0] + v.w * m[3][0];
+    out[1] = v.x * m[0][1] + v.y * m[1][1] + v.z * m[2][1] + v.w * m[3][1];
+    out[2] = v.x * m[0][2] + v.y * m[1][2] + v.z * m[2][2] + v.w * m[3][2];
+    out[3] = v.x * m[0][3] + v.y * m[1][3] + v.z * m[2][3] + v.w * m[3][3];
+    return out;
+}
+
+std::vector<float4x4> GenerateMatrices()
+{
+    FastRandFloat         Rnd{0, -1.f, 1.f};
+    std::vector<float4x4> Matrices(NumElements);
+    for (auto& m : Matrices)
+    {
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                m[i][j] = Rnd();
+    }
+    return Matrices;
+}
+
+std::vector<float4> GenerateVectors()
+{
+    FastRandFloat       Rnd{1, -1.f, 1.f};
+    std::vector<float4> Vectors(NumElements);
+    for (auto& v : Vectors)
+        v = float4{Rnd(), Rnd(), Rnd(), 1};
+    return Vectors;
+}
+
+// Typical transform hierarchy update: every node's local matrix is multiplied by the parent's world matrix.
+template <bool UseSIMD>
+void float4x4_Mul(Benchmark::State& State)
+{
+    const auto            Local  = GenerateMatrices();
+    const auto            Parent = GenerateMatrices();
+    std::vector<float4x4> World(NumElements);
+    while (State.KeepRunning())
+    {
+        for (size_t i = 0; i < NumElements; ++i)
+        {
+            if (UseSIMD)
+                MathSIMD::MulMatrix4x4(Local[i].Data(), Parent[i].Data(), World[i].Data());
+            else
+                World[i] = MulScalar(Local[i], Parent[i]);
+        }
+        Benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumElements);
+}
+void float4x4_Mul_SIMD(Benchmark::State& State) { float4x4_Mul<true>(State); }
+void float4x4_Mul_Scalar(Benchmark::State& State) { float4x4_Mul<false>(State); }
+DILIGENT_BENCHMARK(float4x4_Mul_SIMD);
+DILIGENT_BENCHMARK(float4x4_Mul_Scalar);
+
+
+// Typical vertex transform (e.g. CPU skinning)
+template <bool UseSIMD>
+void float4_MulMatrix(Benchmark::State& State)
+{
+    const auto          Vectors = GenerateVectors();
+    const auto          Matrix  = GenerateMatrices()[0];
+    std::vector<float4> Out(NumElements);
+    while (State.KeepRunning())
+    {
+        for (size_t i = 0; i < NumElements; ++i)
+        {
+            if (UseSIMD)
+                MathSIMD::MulVector4Matrix4x4(Vectors[i].Data(), Matrix.Data(), Out[i].Data());
+            else
+                Out[i] = MulScalar(Vectors[i], Matrix);
+        }
+        Benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumElements);
+}
+void float4_MulMatrix_SIMD(Benchmark::State& State) { float4_MulMatrix<true>(State); }
+void float4_MulMatrix_Scalar(Benchmark::State& State) { float4_MulMatrix<false>(State); }
+DILIGENT_BENCHMARK(float4_MulMatrix_SIMD);
+DILIGENT_BENCHMARK(float4_MulMatrix_Scalar);
+
+
+template <bool UseSIMD>
+void float4x4_MulVector(Benchmark::State& State)
+{
+    const auto          Vectors = GenerateVectors();
+    const auto          Matrix  = GenerateMatrices()[0];
+    std::vector<float4> Out(NumElements);
+    while (State.KeepRunning())
+    {
+        for (size_t i = 0; i < NumElements; ++i)
+        {
+            if (UseSIMD)
+                MathSIMD::MulMatrix4x4Vector4(Matrix.Data(), Vectors[i].Data(), Out[i].Data());
+            else
+                Out[i] = Matrix * Vectors[i];
+        }
+        Benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumElements);
+}
+void float4x4_MulVector_SIMD(Benchmark::State& State) { float4x4_MulVector<true>(State); }
+void float4x4_MulVector_Scalar(Benchmark::State& State) { float4x4_MulVector<false>(State); }
+DILIGENT_BENCHMARK(float4x4_MulVector_SIMD);
+DILIGENT_BENCHMARK(float4x4_MulVector_Scalar);
+
+} // namespace
@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "DynamicLinearAllocator.hpp"
+
+#include "BenchmarkFramework.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr size_t NumAllocationsPerIteration = 1024;
+
+void DynamicLinearAllocator_Allocate(Benchmark::State& State)
+{
+    const auto AllocSize = static_cast<size_t>(State.GetArg());
+
+    DynamicLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 64 << 10};
+    while (State.KeepRunning())
+    {
+        for (size_t i = 0; i < NumAllocationsPerIteration; ++i)
+        {
+            void* Ptr = Allocator.Allocate(AllocSize, 16);
+            Benchmark::DoNotOptimize(Ptr);
+        }
+        // Discard keeps the blocks, so subsequent iterations do not hit the raw allocator
+        Allocator.Discard();
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumAllocationsPerIteration);
+    State.SetBytesProcessed(State.GetIterations() * NumAllocationsPerIteration * AllocSize);
+}
+DILIGENT_BENCHMARK_ARGS(DynamicLinearAllocator_Allocate, 16, 256);
+
+
+void DynamicLinearAllocator_AllocateFree(Benchmark::State& State)
+{
+    const auto AllocSize = static_cast<size_t>(State.GetArg());
+
+    while (State.KeepRunning())
+    {
+        // Every iteration starts with an empty allocator that requests new blocks
+        // from the raw allocator and releases them in the destructor.
+        DynamicLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 64 << 10};
+        for (size_t i = 0; i < NumAllocationsPerIteration; ++i)
+        {
+            void* Ptr = Allocator.Allocate(AllocSize, 16);
+            Benchmark::DoNotOptimize(Ptr);
+        }
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumAllocationsPerIteration);
+}
+DILIGENT_BENCHMARK_ARGS(DynamicLinearAllocator_AllocateFree, 16, 256);
+
+} // namespace
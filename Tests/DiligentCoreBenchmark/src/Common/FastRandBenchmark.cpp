@@ -0,0 +1,126 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FastRand.hpp"
+
+#include <random>
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+void FastRand_Float(Benchmark::State& State)
+{
+    std::vector<float> Values(static_cast<size_t>(State.GetArg()));
+
+    FastRandFloat Rnd{0, -1.f, 1.f};
+    while (State.KeepRunning())
+    {
+        for (auto& Val : Values)
+            Val = Rnd();
+        Benchmark::DoNotOptimize(Values.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * Values.size());
+}
+DILIGENT_BENCHMARK_ARGS(FastRand_Float, 1 << 16);
+
+void FastRandBatch_Uint(Benchmark::State& State)
+{
+    std::vector<Uint32> Values(static_cast<size_t>(State.GetArg()));
+
+    FastRandBatch Rnd{0};
+    while (State.KeepRunning())
+    {
+        Rnd.GenerateUint(Values.data(), Values.size());
+        Benchmark::DoNotOptimize(Values.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * Values.size());
+}
+DILIGENT_BENCHMARK_ARGS(FastRandBatch_Uint, 1 << 16);
+
+void FastRandBatch_Float(Benchmark::State& State)
+{
+    std::vector<float> Values(static_cast<size_t>(State.GetArg()));
+
+    FastRandBatch Rnd{0};
+    while (State.KeepRunning())
+    {
+        Rnd.GenerateFloat(Values.data(), Values.size(), -1.f, 1.f);
+        Benchmark::DoNotOptimize(Values.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * Values.size());
+}
+DILIGENT_BENCHMARK_ARGS(FastRandBatch_Float, 1 << 16);
+
+void FastRandBatch_Int(Benchmark::State& State)
+{
+    std::vector<int> Values(static_cast<size_t>(State.GetArg()));
+
+    FastRandBatch Rnd{0};
+    while (State.KeepRunning())
+    {
+        Rnd.GenerateInt(Values.data(), Values.size(), -100, 100);
+        Benchmark::DoNotOptimize(Values.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * Values.size());
+}
+DILIGENT_BENCHMARK_ARGS(FastRandBatch_Int, 1 << 16);
+
+void StdRandom_Normal(Benchmark::State& State)
+{
+    std::vector<float> Values(static_cast<size_t>(State.GetArg()));
+
+    std::mt19937                    Gen{0};
+    std::normal_distribution<float> Distr;
+    while (State.KeepRunning())
+    {
+        for (auto& Val : Values)
+            Val = Distr(Gen);
+        Benchmark::DoNotOptimize(Values.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * Values.size());
+}
+DILIGENT_BENCHMARK_ARGS(StdRandom_Normal, 1 << 16);
+
+void FastRandBatch_Normal(Benchmark::State& State)
+{
+    std::vector<float> Values(static_cast<size_t>(State.GetArg()));
+
+    FastRandBatch Rnd{0};
+    while (State.KeepRunning())
+    {
+        Rnd.GenerateNormal(Values.data(), Values.size());
+        Benchmark::DoNotOptimize(Values.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * Values.size());
+}
+DILIGENT_BENCHMARK_ARGS(FastRandBatch_Normal, 1 << 16);
+
+} // namespace
@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FilteringTools.hpp"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr Uint32 TextureSize = 256;
+
+struct FilteringBenchmarkData
+{
+    std::vector<float> Texture;
+    std::vector<float> U;
+    std::vector<float> V;
+    std::vector<float> Samples;
+
+    explicit FilteringBenchmarkData(size_t NumSamples) :
+        Texture(TextureSize * TextureSize),
+        U(NumSamples),
+        V(NumSamples),
+        Samples(NumSamples)
+    {
+        FastRandFloat Rnd{0, 0.f, 1.f};
+        for (auto& Val : Texture)
+            Val = Rnd();
+
+        FastRandFloat RndUV{1, -0.5f, 1.5f};
+        for (size_t i = 0; i < NumSamples; ++i)
+        {
+            U[i] = RndUV();
+            V[i] = RndUV();
+        }
+    }
+};
+
+template <TEXTURE_ADDRESS_MODE AddressMode>
+void FilteringTools_Bilinear(Benchmark::State& State)
+{
+    FilteringBenchmarkData Data{static_cast<size_t>(State.GetArg())};
+    while (State.KeepRunning())
+    {
+        for (size_t i = 0; i < Data.Samples.size(); ++i)
+        {
+            Data.Samples[i] = FilterTexture2DBilinear<float, float, AddressMode, AddressMode, true>(
+                TextureSize, TextureSize, Data.Texture.data(), TextureSize, Data.U[i], Data.V[i]);
+        }
+        Benchmark::DoNotOptimize(Data.Samples.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * Data.Samples.size());
+}
+
+template <TEXTURE_ADDRESS_MODE AddressMode>
+void FilteringTools_BilinearBatch(Benchmark::State& State)
+{
+    FilteringBenchmarkData Data{static_cast<size_t>(State.GetArg())};
+    while (State.KeepRunning())
+    {
+        FilterTexture2DBilinear<float, float, AddressMode, AddressMode, true>(
+            TextureSize, TextureSize, Data.Texture.data(), TextureSize, Data.U.data(), Data.V.data(), Data.Samples.size(), Data.Samples.data());
+        Benchmark::DoNotOptimize(Data.Samples.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * Data.Samples.size());
+}
+
+void FilteringTools_BilinearClamp(Benchmark::State& State) { FilteringTools_Bilinear<TEXTURE_ADDRESS_CLAMP>(State); }
+void FilteringTools_BilinearWrap(Benchmark::State& State) { FilteringTools_Bilinear<TEXTURE_ADDRESS_WRAP>(State); }
+void FilteringTools_BilinearMirror(Benchmark::State& State) { FilteringTools_Bilinear<TEXTURE_ADDRESS_MIRROR>(State); }
+void FilteringTools_BilinearBatchClamp(Benchmark::State& State) { FilteringTools_BilinearBatch<TEXTURE_ADDRESS_CLAMP>(State); }
+void FilteringTools_BilinearBatchWrap(Benchmark::State& State) { FilteringTools_BilinearBatch<TEXTURE_ADDRESS_WRAP>(State); }
+void FilteringTools_BilinearBatchMirror(Benchmark::State& State) { FilteringTools_BilinearBatch<TEXTURE_ADDRESS_MIRROR>(State); }
+DILIGENT_BENCHMARK_ARGS(FilteringTools_BilinearClamp, 1 << 16);
+DILIGENT_BENCHMARK_ARGS(FilteringTools_BilinearWrap, 1 << 16);
+DILIGENT_BENCHMARK_ARGS(FilteringTools_BilinearMirror, 1 << 16);
+DILIGENT_BENCHMARK_ARGS(FilteringTools_BilinearBatchClamp, 1 << 16);
+DILIGENT_BENCHMARK_ARGS(FilteringTools_BilinearBatchWrap, 1 << 16);
+DILIGENT_BENCHMARK_ARGS(FilteringTools_BilinearBatchMirror, 1 << 16);
+
+} // namespace
@@ -0,0 +1,78 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "FixedBlockMemoryAllocator.hpp"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr size_t NumAllocationsPerIteration = 256;
+
+template <typename AllocatorType>
+void AllocateAndFree(Benchmark::State& State, AllocatorType& Allocator, size_t BlockSize)
+{
+    std::vector<void*> Ptrs(NumAllocationsPerIteration);
+    while (State.KeepRunning())
+    {
+        for (auto& Ptr : Ptrs)
+            Ptr = Allocator.Allocate(BlockSize, "Benchmark", __FILE__, __LINE__);
+        Benchmark::ClobberMemory();
+        // Free every other block first to avoid the best case of LIFO reuse in the allocator
+        for (size_t i = 0; i < Ptrs.size(); i += 2)
+            Allocator.Free(Ptrs[i]);
+        for (size_t i = 1; i < Ptrs.size(); i += 2)
+            Allocator.Free(Ptrs[i]);
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumAllocationsPerIteration);
+}
+
+void FixedBlockMemoryAllocator_AllocateFree(Benchmark::State& State)
+{
+    const auto BlockSize = static_cast<size_t>(State.GetArg());
+
+    FixedBlockMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), BlockSize, 128};
+    AllocateAndFree(State, Allocator, BlockSize);
+}
+DILIGENT_BENCHMARK_ARGS(FixedBlockMemoryAllocator_AllocateFree, 16, 64, 256);
+
+
+// Baseline: the same allocation pattern served by the default raw allocator.
+void DefaultRawMemoryAllocator_AllocateFree(Benchmark::State& State)
+{
+    const auto BlockSize = static_cast<size_t>(State.GetArg());
+    AllocateAndFree(State, DefaultRawMemoryAllocator::GetAllocator(), BlockSize);
+}
+DILIGENT_BENCHMARK_ARGS(DefaultRawMemoryAllocator_AllocateFree, 16, 64, 256);
+
+} // namespace
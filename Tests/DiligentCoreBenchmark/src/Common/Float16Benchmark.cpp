@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "Float16.hpp"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+std::vector<float> CreateFloatData(size_t Count)
+{
+    FastRandFloat      Rnd{0, -1000.f, 1000.f};
+    std::vector<float> Data(Count);
+    for (auto& Val : Data)
+        Val = Rnd();
+    return Data;
+}
+
+template <bool Bulk>
+void Float16_FromFloat32(Benchmark::State& State)
+{
+    const auto          Src = CreateFloatData(static_cast<size_t>(State.GetArg()));
+    std::vector<Uint16> Dst(Src.size());
+    while (State.KeepRunning())
+    {
+        if (Bulk)
+        {
+            Float32ToFloat16(Src.data(), Dst.data(), Src.size());
+        }
+        else
+        {
+            for (size_t i = 0; i < Src.size(); ++i)
+                Dst[i] = Float32ToFloat16(Src[i]);
+        }
+        Benchmark::DoNotOptimize(Dst.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * Src.size());
+}
+
+template <bool Bulk>
+void Float16_ToFloat32(Benchmark::State& State)
+{
+    const auto          Data = CreateFloatData(static_cast<size_t>(State.GetArg()));
+    std::vector<Uint16> Src(Data.size());
+    Float32ToFloat16(Data.data(), Src.data(), Data.size());
+
+    std::vector<float> Dst(Src.size());
+    while (State.KeepRunning())
+    {
+        if (Bulk)
+        {
+            Float16ToFloat32(Src.data(), Dst.data(), Src.size());
+        }
+        else
+        {
+            for (size_t i = 0; i < Src.size(); ++i)
+                Dst[i] = Float16ToFloat32(Src[i]);
+        }
+        Benchmark::DoNotOptimize(Dst.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * Src.size());
+}
+
+void Float16_FromFloat32Scalar(Benchmark::State& State) { Float16_FromFloat32<false>(State); }
+void Float16_FromFloat32Bulk(Benchmark::State& State) { Float16_FromFloat32<true>(State); }
+void Float16_ToFloat32Scalar(Benchmark::State& State) { Float16_ToFloat32<false>(State); }
+void Float16_ToFloat32Bulk(Benchmark::State& State) { Float16_ToFloat32<true>(State); }
+DILIGENT_BENCHMARK_ARGS(Float16_FromFloat32Scalar, 1 << 16);
+DILIGENT_BENCHMARK_ARGS(Float16_FromFloat32Bulk, 1 << 16);
+DILIGENT_BENCHMARK_ARGS(Float16_ToFloat32Scalar, 1 << 16);
+DILIGENT_BENCHMARK_ARGS(Float16_ToFloat32Bulk, 1 << 16);
+
+} // namespace
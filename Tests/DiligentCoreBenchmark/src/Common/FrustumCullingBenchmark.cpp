@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FrustumCulling.hpp"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct CullingScene
+{
+    explicit CullingScene(size_t NumBoxes)
+    {
+        const auto ViewProj = float4x4::Translation(0, 0, 100) * float4x4::Projection(PI_F / 3.f, 1.5f, 1.f, 500.f, false);
+        ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+
+        FastRandFloat Rnd{0, -500.f, 500.f};
+        FastRandFloat RndSize{1, 0.1f, 10.f};
+
+        Boxes.resize(NumBoxes);
+        for (auto& v : Coords)
+            v.resize(NumBoxes);
+        for (size_t i = 0; i < NumBoxes; ++i)
+        {
+            auto& Box = Boxes[i];
+            Box.Min   = float3{Rnd(), Rnd(), Rnd()};
+            Box.Max   = Box.Min + float3{RndSize(), RndSize(), RndSize()};
+            for (Uint32 c = 0; c < 3; ++c)
+            {
+                Coords[c][i]     = Box.Min[c];
+                Coords[3 + c][i] = Box.Max[c];
+            }
+        }
+
+        SOA.MinX = Coords[0].data();
+        SOA.MinY = Coords[1].data();
+        SOA.MinZ = Coords[2].data();
+        SOA.MaxX = Coords[3].data();
+        SOA.MaxY = Coords[4].data();
+        SOA.MaxZ = Coords[5].data();
+
+        VisibilityMask.resize((NumBoxes + 31) / 32);
+    }
+
+    ViewFrustumExt        Frustum;
+    std::vector<BoundBox> Boxes;
+    std::vector<float>    Coords[6];
+    BoundBoxSOA           SOA;
+    std::vector<Uint32>   VisibilityMask;
+};
+
+void FrustumCulling_Scalar(Benchmark::State& State)
+{
+    CullingScene Scene{static_cast<size_t>(State.GetArg())};
+    while (State.KeepRunning())
+    {
+        for (auto& Word : Scene.VisibilityMask)
+            Word = 0;
+        for (size_t i = 0; i < Scene.Boxes.size(); ++i)
+        {
+            if (GetBoxVisibility(Scene.Frustum, Scene.Boxes[i]) != BoxVisibility::Invisible)
+                Scene.VisibilityMask[i / 32] |= 1u << (i % 32);
+        }
+        Benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.GetIterations() * State.GetArg());
+}
+DILIGENT_BENCHMARK_ARGS(FrustumCulling_Scalar, 1024, 200000);
+
+
+void FrustumCulling_Batch(Benchmark::State& State)
+{
+    CullingScene Scene{static_cast<size_t>(State.GetArg())};
+
+    BatchBoxVisibilityAttribs Attribs;
+    Attribs.NumBoxes        = Scene.Boxes.size();
+    Attribs.pVisibilityMask = Scene.VisibilityMask.data();
+    while (State.KeepRunning())
+    {
+        Benchmark::DoNotOptimize(GetBoxVisibilityBatch(Scene.Frustum, Scene.SOA, Attribs));
+    }
+    State.SetItemsProcessed(State.GetIterations() * State.GetArg());
+}
+DILIGENT_BENCHMARK_ARGS(FrustumCulling_Batch, 1024, 200000);
+
+
+void FrustumCulling_BatchThreadPool(Benchmark::State& State)
+{
+    CullingScene Scene{static_cast<size_t>(State.GetArg())};
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{std::max(std::thread::hardware_concurrency(), 1u)});
+
+    BatchBoxVisibilityAttribs Attribs;
+    Attribs.NumBoxes        = Scene.Boxes.size();
+    Attribs.pVisibilityMask = Scene.VisibilityMask.data();
+    Attribs.pThreadPool     = pThreadPool;
+    while (State.KeepRunning())
+    {
+        Benchmark::DoNotOptimize(GetBoxVisibilityBatch(Scene.Frustum, Scene.SOA, Attribs));
+    }
+    State.SetItemsProcessed(State.GetIterations() * State.GetArg());
+}
+DILIGENT_BENCHMARK_ARGS(FrustumCulling_BatchThreadPool, 200000);
+
+} // namespace
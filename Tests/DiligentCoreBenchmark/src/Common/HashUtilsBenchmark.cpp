@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "HashUtils.hpp"
+
+#include <string>
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+void HashUtils_ComputeHashRaw(Benchmark::State& State)
+{
+    const auto Size = static_cast<size_t>(State.GetArg());
+
+    std::vector<Uint8> Data(Size);
+    FastRand           Rnd{0};
+    for (auto& Byte : Data)
+        Byte = static_cast<Uint8>(Rnd());
+
+    while (State.KeepRunning())
+    {
+        auto Hash = ComputeHashRaw(Data.data(), Data.size());
+        Benchmark::DoNotOptimize(Hash);
+    }
+    State.SetBytesProcessed(State.GetIterations() * Size);
+}
+DILIGENT_BENCHMARK_ARGS(HashUtils_ComputeHashRaw, 16, 256, 4096, 65536);
+
+
+void HashUtils_HashCombine(Benchmark::State& State)
+{
+    Uint32 a = 1;
+    float  b = 2.5f;
+    Uint64 c = 3;
+    bool   d = true;
+    while (State.KeepRunning())
+    {
+        size_t Seed = 0;
+        HashCombine(Seed, a, b, c, d);
+        Benchmark::DoNotOptimize(Seed);
+        ++a;
+    }
+    State.SetItemsProcessed(State.GetIterations());
+}
+DILIGENT_BENCHMARK(HashUtils_HashCombine);
+
+
+void HashUtils_HashMapStringKey(Benchmark::State& State)
+{
+    const auto Length = static_cast<size_t>(State.GetArg());
+
+    const std::string Str(Length, 'x');
+    while (State.KeepRunning())
+    {
+        // HashMapStringKey does not copy the string when constructed from const char*
+        HashMapStringKey Key{Str.c_str()};
+        auto             Hash = Key.GetHash();
+        Benchmark::DoNotOptimize(Hash);
+    }
+    State.SetBytesProcessed(State.GetIterations() * Length);
+}
+DILIGENT_BENCHMARK_ARGS(HashUtils_HashMapStringKey, 8, 64, 512);
+
+} // namespace
@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "LRUCache.hpp"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct CacheData
+{
+    Uint64 Value = 0;
+};
+
+// All keys fit into the cache: measures lookup cost.
+void LRUCache_GetHit(Benchmark::State& State)
+{
+    const auto NumKeys = static_cast<Uint32>(State.GetArg());
+
+    LRUCache<Uint32, CacheData> Cache{NumKeys};
+    for (Uint32 i = 0; i < NumKeys; ++i)
+    {
+        Cache.Get(i, [i](CacheData& Data, size_t& Size) {
+            Data.Value = i;
+            Size       = 1;
+        });
+    }
+
+    FastRandInt Rnd{0, 0, static_cast<int>(NumKeys) - 1};
+    while (State.KeepRunning())
+    {
+        const auto Key  = static_cast<Uint32>(Rnd());
+        auto       Data = Cache.Get(Key, [](CacheData&, size_t& Size) { Size = 1; });
+        Benchmark::DoNotOptimize(Data);
+    }
+    State.SetItemsProcessed(State.GetIterations());
+}
+DILIGENT_BENCHMARK_ARGS(LRUCache_GetHit, 64, 1024, 16384);
+
+
+// The key set is four times larger than the cache: most requests initialize
+// new data and evict the least recently used entries.
+void LRUCache_GetMiss(Benchmark::State& State)
+{
+    const auto CacheSize = static_cast<Uint32>(State.GetArg());
+
+    LRUCache<Uint32, CacheData> Cache{CacheSize};
+
+    FastRandInt Rnd{0, 0, static_cast<int>(CacheSize * 4) - 1};
+    while (State.KeepRunning())
+    {
+        const auto Key  = static_cast<Uint32>(Rnd());
+        auto       Data = Cache.Get(Key, [Key](CacheData& Data, size_t& Size) {
+            Data.Value = Key;
+            Size       = 1;
+        });
+        Benchmark::DoNotOptimize(Data);
+    }
+    State.SetItemsProcessed(State.GetIterations());
+}
+DILIGENT_BENCHMARK_ARGS(LRUCache_GetMiss, 64, 1024);
+
+} // namespace
@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ObjectsRegistry.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct RegistryData
+{
+    Uint32 Value = 0;
+};
+
+// Objects are kept alive by the strong references, so every request is a registry hit.
+void ObjectsRegistry_GetHit(Benchmark::State& State)
+{
+    const auto NumKeys = static_cast<Uint32>(State.GetArg());
+
+    ObjectsRegistry<Uint32, std::shared_ptr<RegistryData>> Registry;
+
+    std::vector<std::shared_ptr<RegistryData>> Objects(NumKeys);
+    for (Uint32 i = 0; i < NumKeys; ++i)
+    {
+        Objects[i] = Registry.Get(i, [i]() {
+            auto pData   = std::make_shared<RegistryData>();
+            pData->Value = i;
+            return pData;
+        });
+    }
+
+    FastRandInt Rnd{0, 0, static_cast<int>(NumKeys) - 1};
+    while (State.KeepRunning())
+    {
+        auto pObj = Registry.Get(static_cast<Uint32>(Rnd()), []() { return std::make_shared<RegistryData>(); });
+        Benchmark::DoNotOptimize(pObj);
+    }
+    State.SetItemsProcessed(State.GetIterations());
+}
+DILIGENT_BENCHMARK_ARGS(ObjectsRegistry_GetHit, 64, 1024, 16384);
+
+
+// Objects are not kept alive, so every request creates a new object and the
+// registry periodically purges expired entries.
+void ObjectsRegistry_GetCreate(Benchmark::State& State)
+{
+    ObjectsRegistry<Uint32, std::shared_ptr<RegistryData>> Registry;
+
+    Uint32 Key = 0;
+    while (State.KeepRunning())
+    {
+        auto pObj = Registry.Get(Key++, []() { return std::make_shared<RegistryData>(); });
+        Benchmark::DoNotOptimize(pObj);
+    }
+    State.SetItemsProcessed(State.GetIterations());
+}
+DILIGENT_BENCHMARK(ObjectsRegistry_GetCreate);
+
+} // namespace
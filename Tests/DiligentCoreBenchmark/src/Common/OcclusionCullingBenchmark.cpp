@@ -0,0 +1,133 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "OcclusionCulling.hpp"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct OcclusionScene
+{
+    explicit OcclusionScene(Uint32 NumOccluders)
+    {
+        ViewProj = float4x4::Projection(PI_F / 3.f, 2.f, 1.f, 500.f, false);
+
+        FastRandFloat RndXY{0, -100.f, 100.f};
+        FastRandFloat RndZ{1, 20.f, 200.f};
+        FastRandFloat RndSize{2, 1.f, 10.f};
+
+        // Cubes with front faces oriented outwards
+        for (Uint32 i = 0; i < NumOccluders; ++i)
+        {
+            const float3 Min{RndXY(), RndXY(), RndZ()};
+            const float3 Max = Min + float3{RndSize(), RndSize(), RndSize()};
+            for (Uint32 Axis = 0; Axis < 3; ++Axis)
+            {
+                for (Uint32 Side = 0; Side < 2; ++Side)
+                {
+                    float3 Normal;
+                    Normal[Axis] = Side == 0 ? -1.f : +1.f;
+
+                    float3 Corners[4];
+                    for (Uint32 c = 0; c < 4; ++c)
+                    {
+                        const Uint32 u = (Axis + 1) % 3;
+                        const Uint32 v = (Axis + 2) % 3;
+
+                        Corners[c][Axis] = Side == 0 ? Min[Axis] : Max[Axis];
+                        Corners[c][u]    = (c == 1 || c == 2) ? Max[u] : Min[u];
+                        Corners[c][v]    = (c >= 2) ? Max[v] : Min[v];
+                    }
+                    if (dot(cross(Corners[1] - Corners[0], Corners[2] - Corners[0]), Normal) < 0)
+                        std::swap(Corners[1], Corners[3]);
+
+                    for (Uint32 c : {0, 1, 2, 0, 2, 3})
+                        Vertices.push_back(Corners[c]);
+                }
+            }
+        }
+
+        FastRandFloat RndBoxSize{3, 0.5f, 5.f};
+        for (Uint32 i = 0; i < 10000; ++i)
+        {
+            const float3 Min{RndXY(), RndXY(), RndZ() + 10.f};
+            TestBoxes.emplace_back(BoundBox{Min, Min + float3{RndBoxSize(), RndBoxSize(), RndBoxSize()}});
+        }
+    }
+
+    void Rasterize(SoftwareOcclusionBuffer& Buffer) const
+    {
+        OccluderMeshAttribs Attribs;
+        Attribs.pVertices     = Vertices.data();
+        Attribs.NumVertices   = static_cast<Uint32>(Vertices.size());
+        Attribs.NumTriangles  = static_cast<Uint32>(Vertices.size() / 3);
+        Attribs.WorldViewProj = ViewProj;
+        Buffer.RasterizeOccluder(Attribs);
+    }
+
+    float4x4              ViewProj;
+    std::vector<float3>   Vertices;
+    std::vector<BoundBox> TestBoxes;
+};
+
+void OcclusionCulling_Rasterize(Benchmark::State& State)
+{
+    const OcclusionScene    Scene{static_cast<Uint32>(State.GetArg())};
+    SoftwareOcclusionBuffer Buffer{512, 256};
+    while (State.KeepRunning())
+    {
+        Buffer.Clear();
+        Scene.Rasterize(Buffer);
+    }
+    State.SetItemsProcessed(State.GetIterations() * Scene.Vertices.size() / 3);
+}
+DILIGENT_BENCHMARK_ARGS(OcclusionCulling_Rasterize, 100, 1000);
+
+
+void OcclusionCulling_TestBoxes(Benchmark::State& State)
+{
+    const OcclusionScene    Scene{static_cast<Uint32>(State.GetArg())};
+    SoftwareOcclusionBuffer Buffer{512, 256};
+    Scene.Rasterize(Buffer);
+    while (State.KeepRunning())
+    {
+        size_t NumVisible = 0;
+        for (const auto& Box : Scene.TestBoxes)
+            NumVisible += Buffer.IsBoxVisible(Scene.ViewProj, Box) ? 1 : 0;
+        Benchmark::DoNotOptimize(NumVisible);
+    }
+    State.SetItemsProcessed(State.GetIterations() * Scene.TestBoxes.size());
+}
+DILIGENT_BENCHMARK_ARGS(OcclusionCulling_TestBoxes, 100, 1000);
+
+} // namespace
@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "Serializer.hpp"
+
+#include "BenchmarkFramework.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct TestData
+{
+    Uint32      u32 = 0x12345678;
+    Uint64      u64 = 0x0123456789ABCDEF;
+    float       f   = 1.5f;
+    Uint16      u16 = 0xABCD;
+    Uint8       u8  = 0x42;
+    const char* Str = "Serializer benchmark string";
+    Uint32      Arr[16]{};
+};
+
+constexpr Uint32 NumElementsPerIteration = 64;
+
+template <SerializerMode Mode>
+bool SerializeData(Serializer<Mode>& Ser, typename Serializer<Mode>::template ConstQual<TestData>& Data)
+{
+    if (!Ser(Data.u32, Data.u64, Data.f, Data.u16, Data.u8, Data.Str))
+        return false;
+    for (auto& Elem : Data.Arr)
+    {
+        if (!Ser(Elem))
+            return false;
+    }
+    return true;
+}
+
+SerializedData SerializeTestData(const TestData& Data)
+{
+    Serializer<SerializerMode::Measure> MeasureSer;
+    for (Uint32 i = 0; i < NumElementsPerIteration; ++i)
+        SerializeData(MeasureSer, Data);
+
+    auto SerializedData = MeasureSer.AllocateData(DefaultRawMemoryAllocator::GetAllocator());
+
+    Serializer<SerializerMode::Write> WriteSer{SerializedData};
+    for (Uint32 i = 0; i < NumElementsPerIteration; ++i)
+        SerializeData(WriteSer, Data);
+    VERIFY_EXPR(WriteSer.IsEnded());
+
+    return SerializedData;
+}
+
+void Serializer_MeasureAndWrite(Benchmark::State& State)
+{
+    TestData Data;
+    size_t   Size = 0;
+    while (State.KeepRunning())
+    {
+        auto SerializedData = SerializeTestData(Data);
+        Size                = SerializedData.Size();
+        Benchmark::DoNotOptimize(SerializedData.Ptr());
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumElementsPerIteration);
+    State.SetBytesProcessed(State.GetIterations() * Size);
+}
+DILIGENT_BENCHMARK(Serializer_MeasureAndWrite);
+
+
+void Serializer_Read(Benchmark::State& State)
+{
+    const auto SerializedData = SerializeTestData(TestData{});
+    while (State.KeepRunning())
+    {
+        Serializer<SerializerMode::Read> ReadSer{SerializedData};
+        for (Uint32 i = 0; i < NumElementsPerIteration; ++i)
+        {
+            TestData Data;
+            SerializeData(ReadSer, Data);
+            Benchmark::DoNotOptimize(Data);
+        }
+        VERIFY_EXPR(ReadSer.IsEnded());
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumElementsPerIteration);
+    State.SetBytesProcessed(State.GetIterations() * SerializedData.Size());
+}
+DILIGENT_BENCHMARK(Serializer_Read);
+
+} // namespace
@@ -0,0 +1,88 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ThreadPool.hpp"
+
+#include <atomic>
+
+#include "BenchmarkFramework.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr Uint32 NumTasksPerIteration = 256;
+
+// Measures the overhead of enqueuing small tasks and waiting for their completion.
+void ThreadPool_EnqueueAndWait(Benchmark::State& State)
+{
+    const auto NumThreads = static_cast<Uint32>(State.GetArg());
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+
+    std::atomic<Uint32> Counter{0};
+    while (State.KeepRunning())
+    {
+        for (Uint32 i = 0; i < NumTasksPerIteration; ++i)
+        {
+            EnqueueAsyncWork(pThreadPool, [&Counter](Uint32) {
+                Counter.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        pThreadPool->WaitForAllTasks();
+    }
+    VERIFY_EXPR(Counter.load() == State.GetIterations() * NumTasksPerIteration);
+    State.SetItemsProcessed(State.GetIterations() * NumTasksPerIteration);
+}
+DILIGENT_BENCHMARK_ARGS(ThreadPool_EnqueueAndWait, 1, 2, 4, 8);
+
+
+// Measures throughput of tasks that perform a small amount of work each.
+void ThreadPool_ParallelWork(Benchmark::State& State)
+{
+    const auto NumThreads = static_cast<Uint32>(State.GetArg());
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+    while (State.KeepRunning())
+    {
+        for (Uint32 i = 0; i < NumTasksPerIteration; ++i)
+        {
+            EnqueueAsyncWork(pThreadPool, [i](Uint32) {
+                Uint32 Val = i;
+                for (Uint32 j = 0; j < 4096; ++j)
+                    Val = Val * 1664525u + 1013904223u;
+                Benchmark::DoNotOptimize(Val);
+            });
+        }
+        pThreadPool->WaitForAllTasks();
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumTasksPerIteration);
+}
+DILIGENT_BENCHMARK_ARGS(ThreadPool_ParallelWork, 1, 2, 4, 8);
+
+} // namespace
@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "AdvancedMath.hpp"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Slightly perturbed circle: most vertices are convex
+std::vector<float2> CreateNoisyCircle(Uint32 NumVerts)
+{
+    FastRandFloat       Rnd{0, 0.99f, 1.f};
+    std::vector<float2> Verts(NumVerts);
+    for (Uint32 i = 0; i < NumVerts; ++i)
+    {
+        const float Angle = 2.f * PI_F * static_cast<float>(i) / static_cast<float>(NumVerts);
+        Verts[i]          = float2{std::cos(Angle), std::sin(Angle)} * Rnd();
+    }
+    return Verts;
+}
+
+// Star with random spikes: every other vertex is reflex
+std::vector<float2> CreateStar(Uint32 NumVerts)
+{
+    FastRandFloat       Rnd{0, 0.5f, 1.f};
+    std::vector<float2> Verts(NumVerts);
+    for (Uint32 i = 0; i < NumVerts; ++i)
+    {
+        const float Angle = 2.f * PI_F * static_cast<float>(i) / static_cast<float>(NumVerts);
+        Verts[i]          = float2{std::cos(Angle), std::sin(Angle)} * (Rnd() * (i % 2 == 0 ? 1.f : 0.3f));
+    }
+    return Verts;
+}
+
+template <std::vector<float2> (*CreatePolygon)(Uint32)>
+void TriangulatePolygon(Benchmark::State& State)
+{
+    const auto Polygon = CreatePolygon(static_cast<Uint32>(State.GetArg()));
+    while (State.KeepRunning())
+    {
+        auto Tris = TriangulatePolygon<Uint32>(Polygon, /*VerifyEarAndConvexVerts = */ false);
+        Benchmark::DoNotOptimize(Tris.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * State.GetArg());
+}
+void TriangulatePolygon_NoisyCircle(Benchmark::State& State) { TriangulatePolygon<CreateNoisyCircle>(State); }
+void TriangulatePolygon_Star(Benchmark::State& State) { TriangulatePolygon<CreateStar>(State); }
+DILIGENT_BENCHMARK_ARGS(TriangulatePolygon_NoisyCircle, 16, 256, 4096, 65536);
+DILIGENT_BENCHMARK_ARGS(TriangulatePolygon_Star, 16, 256, 4096, 65536);
+
+} // namespace
@@ -0,0 +1,139 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ColorConversion.h"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr size_t NumValues = 1 << 20;
+
+std::vector<float> CreateFloats()
+{
+    FastRandFloat      Rnd{0, 0.f, 1.f};
+    std::vector<float> Values(NumValues);
+    for (float& Val : Values)
+        Val = Rnd();
+    return Values;
+}
+
+std::vector<Uint8> CreateBytes()
+{
+    FastRandInt        Rnd{0, 0, 255};
+    std::vector<Uint8> Values(NumValues);
+    for (Uint8& Val : Values)
+        Val = static_cast<Uint8>(Rnd());
+    return Values;
+}
+
+void ColorConversion_GammaToLinear8(Benchmark::State& State)
+{
+    const std::vector<Uint8> Src = CreateBytes();
+    std::vector<float>       Dst(NumValues);
+    while (State.KeepRunning())
+    {
+        GammaToLinear(Src.data(), Dst.data(), NumValues);
+        Benchmark::DoNotOptimize(Dst.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumValues);
+}
+DILIGENT_BENCHMARK(ColorConversion_GammaToLinear8);
+
+void ColorConversion_LinearToGamma8(Benchmark::State& State)
+{
+    const std::vector<float> Src = CreateFloats();
+    std::vector<Uint8>       Dst(NumValues);
+    while (State.KeepRunning())
+    {
+        LinearToGamma(Src.data(), Dst.data(), NumValues);
+        Benchmark::DoNotOptimize(Dst.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumValues);
+}
+DILIGENT_BENCHMARK(ColorConversion_LinearToGamma8);
+
+void ColorConversion_GammaToLinearFloat(Benchmark::State& State)
+{
+    const std::vector<float> Src = CreateFloats();
+    std::vector<float>       Dst(NumValues);
+    while (State.KeepRunning())
+    {
+        GammaToLinear(Src.data(), Dst.data(), NumValues);
+        Benchmark::DoNotOptimize(Dst.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumValues);
+}
+DILIGENT_BENCHMARK(ColorConversion_GammaToLinearFloat);
+
+void ColorConversion_LinearToGammaFloat(Benchmark::State& State)
+{
+    const std::vector<float> Src = CreateFloats();
+    std::vector<float>       Dst(NumValues);
+    while (State.KeepRunning())
+    {
+        LinearToGamma(Src.data(), Dst.data(), NumValues);
+        Benchmark::DoNotOptimize(Dst.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumValues);
+}
+DILIGENT_BENCHMARK(ColorConversion_LinearToGammaFloat);
+
+// Per-value conversion with std::pow, for comparison with ColorConversion_LinearToGammaFloat
+void ColorConversion_PerValueLinearToGamma(Benchmark::State& State)
+{
+    const std::vector<float> Src = CreateFloats();
+    std::vector<float>       Dst(NumValues);
+    while (State.KeepRunning())
+    {
+        for (size_t i = 0; i < NumValues; ++i)
+            Dst[i] = LinearToGamma(Src[i]);
+        Benchmark::DoNotOptimize(Dst.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumValues);
+}
+DILIGENT_BENCHMARK(ColorConversion_PerValueLinearToGamma);
+
+void ColorConversion_LinearToSRGBA8(Benchmark::State& State)
+{
+    const std::vector<float> Src = CreateFloats();
+    std::vector<Uint8>       Dst(NumValues);
+    while (State.KeepRunning())
+    {
+        LinearToSRGBA8(Src.data(), Dst.data(), NumValues / 4);
+        Benchmark::DoNotOptimize(Dst.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumValues / 4);
+}
+DILIGENT_BENCHMARK(ColorConversion_LinearToSRGBA8);
+
+} // namespace
@@ -0,0 +1,159 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "DynamicAtlasManager.hpp"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Fills the atlas with random-sized regions and releases them all.
+void DynamicAtlasManager_AllocateFree(Benchmark::State& State)
+{
+    const auto NumRegions = static_cast<size_t>(State.GetArg());
+
+    DynamicAtlasManager Mgr{2048, 2048};
+
+    FastRandInt RndSize{0, 4, 64};
+
+    std::vector<DynamicAtlasManager::Region> Regions;
+    Regions.reserve(NumRegions);
+    Uint64 NumAllocated = 0;
+    while (State.KeepRunning())
+    {
+        for (size_t i = 0; i < NumRegions; ++i)
+        {
+            auto R = Mgr.Allocate(static_cast<Uint32>(RndSize()), static_cast<Uint32>(RndSize()));
+            if (!R.IsEmpty())
+                Regions.emplace_back(std::move(R));
+        }
+        NumAllocated += Regions.size();
+
+        for (auto& R : Regions)
+            Mgr.Free(std::move(R));
+        Regions.clear();
+        VERIFY_EXPR(Mgr.IsEmpty());
+    }
+    State.SetItemsProcessed(NumAllocated);
+}
+DILIGENT_BENCHMARK_ARGS(DynamicAtlasManager_AllocateFree, 64, 1024);
+
+
+// Keeps the atlas populated and replaces one region per iteration.
+void DynamicAtlasManager_Fragmented(Benchmark::State& State)
+{
+    const auto NumRegions = static_cast<size_t>(State.GetArg());
+
+    DynamicAtlasManager Mgr{2048, 2048};
+
+    FastRandInt RndSize{0, 4, 64};
+    FastRand    RndIdx{1};
+
+    std::vector<DynamicAtlasManager::Region> Regions(NumRegions);
+    for (auto& R : Regions)
+        R = Mgr.Allocate(static_cast<Uint32>(RndSize()), static_cast<Uint32>(RndSize()));
+
+    while (State.KeepRunning())
+    {
+        auto& R = Regions[RndIdx() % NumRegions];
+        if (!R.IsEmpty())
+            Mgr.Free(std::move(R));
+        R = Mgr.Allocate(static_cast<Uint32>(RndSize()), static_cast<Uint32>(RndSize()));
+    }
+    State.SetItemsProcessed(State.GetIterations());
+
+    for (auto& R : Regions)
+    {
+        if (!R.IsEmpty())
+            Mgr.Free(std::move(R));
+    }
+}
+DILIGENT_BENCHMARK_ARGS(DynamicAtlasManager_Fragmented, 256, 1024);
+
+
+// Packs the same random set of regions into an empty atlas one by one or as a batch and reports
+// the fraction of the atlas area that was filled. The argument is the packing strategy.
+template <bool UseBatch>
+void DynamicAtlasManager_Occupancy(Benchmark::State& State)
+{
+    const auto Strategy = static_cast<DynamicAtlasManager::PackingStrategy>(State.GetArg());
+
+    constexpr Uint32 AtlasDim   = 1024;
+    constexpr size_t NumRegions = 2048;
+
+    FastRandInt RndSize{0, 4, 64};
+
+    std::vector<DynamicAtlasManager::Region> Requests(NumRegions);
+    for (auto& R : Requests)
+        R = DynamicAtlasManager::Region{0, 0, static_cast<Uint32>(RndSize()), static_cast<Uint32>(RndSize())};
+
+    std::vector<DynamicAtlasManager::Region> Regions;
+    Regions.reserve(NumRegions);
+    double Occupancy = 0;
+    while (State.KeepRunning())
+    {
+        DynamicAtlasManager Mgr{AtlasDim, AtlasDim, Strategy};
+        if (UseBatch)
+        {
+            Regions = Requests;
+            Mgr.Allocate(Regions.data(), static_cast<Uint32>(Regions.size()));
+        }
+        else
+        {
+            for (const auto& Req : Requests)
+                Regions.emplace_back(Mgr.Allocate(Req.width, Req.height));
+        }
+        Occupancy = 1.0 - static_cast<double>(Mgr.GetTotalFreeArea()) / (double{AtlasDim} * double{AtlasDim});
+
+        for (auto& R : Regions)
+        {
+            if (!R.IsEmpty())
+                Mgr.Free(std::move(R));
+        }
+        Regions.clear();
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumRegions);
+    State.SetCounter("Occupancy", Occupancy);
+}
+void DynamicAtlasManager_OccupancySingle(Benchmark::State& State)
+{
+    DynamicAtlasManager_Occupancy<false>(State);
+}
+void DynamicAtlasManager_OccupancyBatch(Benchmark::State& State)
+{
+    DynamicAtlasManager_Occupancy<true>(State);
+}
+DILIGENT_BENCHMARK_ARGS(DynamicAtlasManager_OccupancySingle, 0, 1, 2);
+DILIGENT_BENCHMARK_ARGS(DynamicAtlasManager_OccupancyBatch, 0, 1, 2);
+
+} // namespace
@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ResourceReleaseQueue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+enum RELEASE_MODE : Int64
+{
+    RELEASE_MODE_IMMEDIATE = 0,
+    RELEASE_MODE_BUDGET,
+    RELEASE_MODE_BACKGROUND
+};
+
+// Simulates the render thread releasing a steady stream of resources, with a burst of
+// resources released every 32 frames (e.g. when a level is unloaded).
+// The GPU lags two frames behind the CPU. MaxPurgeMs reports the longest time the render
+// thread spent in a single Purge() call.
+void ResourceReleaseQueue_Frame(Benchmark::State& State)
+{
+    const auto Mode = static_cast<RELEASE_MODE>(State.GetArg());
+
+    constexpr Uint32 ResourcesPerFrame = 64;
+    constexpr Uint32 BurstInterval     = 32;
+    constexpr Uint32 BurstSize         = ResourcesPerFrame * 256;
+    constexpr Uint64 FramesInFlight    = 2;
+
+    using ResourceType = std::unique_ptr<std::vector<Uint32>>;
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue{DefaultRawMemoryAllocator::GetAllocator()};
+    if (Mode == RELEASE_MODE_BUDGET)
+        Queue.SetMaxResourcesPerPurge(ResourcesPerFrame * 4);
+    else if (Mode == RELEASE_MODE_BACKGROUND)
+        Queue.EnableBackgroundRelease(true);
+
+    Uint64 FenceValue   = 0;
+    double MaxPurgeTime = 0;
+    while (State.KeepRunning())
+    {
+        const auto NumResources = (FenceValue % BurstInterval == BurstInterval - 1) ? BurstSize : ResourcesPerFrame;
+        for (Uint32 i = 0; i < NumResources; ++i)
+            Queue.DiscardResource(ResourceType{new std::vector<Uint32>(64)}, FenceValue + 1);
+
+        ++FenceValue;
+        if (FenceValue > FramesInFlight)
+        {
+            const auto PurgeStart = std::chrono::high_resolution_clock::now();
+            Queue.Purge(FenceValue - FramesInFlight);
+            MaxPurgeTime = std::max(MaxPurgeTime, std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - PurgeStart).count());
+        }
+    }
+    State.PauseTiming();
+    Queue.Flush(FenceValue);
+    State.SetItemsProcessed(State.GetIterations());
+    State.SetCounter("MaxPurgeMs", MaxPurgeTime);
+}
+DILIGENT_BENCHMARK_ARGS(ResourceReleaseQueue_Frame, RELEASE_MODE_IMMEDIATE, RELEASE_MODE_BUDGET, RELEASE_MODE_BACKGROUND);
+
+} // namespace
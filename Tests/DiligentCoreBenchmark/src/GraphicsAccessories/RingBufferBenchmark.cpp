@@ -0,0 +1,201 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "RingBuffer.hpp"
+#include "ConcurrentRingBuffer.hpp"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Simulates typical dynamic buffer usage: a number of allocations per frame,
+// with the GPU lagging two frames behind the CPU.
+template <typename RingBufferType>
+void AllocatePerFrame(Benchmark::State& State)
+{
+    const auto AllocationsPerFrame = static_cast<Uint32>(State.GetArg());
+
+    constexpr size_t AllocSize      = 256;
+    constexpr Uint64 FramesInFlight = 2;
+
+    // Reserve one extra frame for the space wasted when the head wraps around
+    RingBufferType RB{AllocSize * AllocationsPerFrame * (FramesInFlight + 2), DefaultRawMemoryAllocator::GetAllocator()};
+
+    Uint64 FenceValue = 0;
+    while (State.KeepRunning())
+    {
+        for (Uint32 i = 0; i < AllocationsPerFrame; ++i)
+        {
+            auto Offset = RB.Allocate(AllocSize, 16);
+            VERIFY_EXPR(Offset != RingBufferType::InvalidOffset);
+            Benchmark::DoNotOptimize(Offset);
+        }
+        RB.FinishCurrentFrame(++FenceValue);
+        if (FenceValue > FramesInFlight)
+            RB.ReleaseCompletedFrames(FenceValue - FramesInFlight);
+    }
+    // The ring buffer must be empty when destroyed
+    RB.ReleaseCompletedFrames(FenceValue);
+    State.SetItemsProcessed(State.GetIterations() * AllocationsPerFrame);
+}
+
+void RingBuffer_AllocatePerFrame(Benchmark::State& State)
+{
+    AllocatePerFrame<RingBuffer>(State);
+}
+DILIGENT_BENCHMARK_ARGS(RingBuffer_AllocatePerFrame, 16, 256, 4096);
+
+void ConcurrentRingBuffer_AllocatePerFrame(Benchmark::State& State)
+{
+    AllocatePerFrame<ConcurrentRingBuffer>(State);
+}
+DILIGENT_BENCHMARK_ARGS(ConcurrentRingBuffer_AllocatePerFrame, 16, 256, 4096);
+
+
+// Wraps RingBuffer with a mutex, which is how it has to be shared between threads.
+class LockedRingBuffer
+{
+public:
+    static constexpr const RingBuffer::OffsetType InvalidOffset = RingBuffer::InvalidOffset;
+
+    LockedRingBuffer(RingBuffer::OffsetType MaxSize, IMemoryAllocator& Allocator) :
+        m_RB{MaxSize, Allocator}
+    {}
+
+    RingBuffer::OffsetType Allocate(RingBuffer::OffsetType Size, RingBuffer::OffsetType Alignment)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_RB.Allocate(Size, Alignment);
+    }
+
+    void FinishCurrentFrame(Uint64 FenceValue)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_RB.FinishCurrentFrame(FenceValue);
+    }
+
+    void ReleaseCompletedFrames(Uint64 CompletedFenceValue)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_RB.ReleaseCompletedFrames(CompletedFenceValue);
+    }
+
+private:
+    std::mutex m_Mtx;
+    RingBuffer m_RB;
+};
+
+// Simulates parallel command recording: every frame, the argument number of threads
+// suballocate upload space from the shared ring buffer.
+template <typename RingBufferType>
+void AllocateParallel(Benchmark::State& State)
+{
+    const auto NumThreads = static_cast<size_t>(State.GetArg());
+
+    constexpr size_t AllocSize       = 256;
+    constexpr Uint32 AllocsPerThread = 4096;
+    constexpr Uint64 FramesInFlight  = 2;
+
+    RingBufferType RB{AllocSize * AllocsPerThread * NumThreads * (FramesInFlight + 2), DefaultRawMemoryAllocator::GetAllocator()};
+
+    // Worker threads are kept alive for the whole run and are released by the main thread for every frame
+    std::atomic<Uint64> Frame{0};
+    std::atomic<size_t> NumDone{0};
+    std::atomic<bool>   Stop{false};
+
+    std::vector<std::thread> Workers;
+    for (size_t t = 1; t < NumThreads; ++t)
+    {
+        Workers.emplace_back([&]() {
+            Uint64 LastFrame = 0;
+            while (true)
+            {
+                Uint64 CurrFrame = 0;
+                while ((CurrFrame = Frame.load()) == LastFrame && !Stop.load())
+                    std::this_thread::yield();
+                if (Stop.load())
+                    break;
+                LastFrame = CurrFrame;
+                for (Uint32 i = 0; i < AllocsPerThread; ++i)
+                {
+                    auto Offset = RB.Allocate(AllocSize, 16);
+                    VERIFY_EXPR(Offset != RingBufferType::InvalidOffset);
+                    Benchmark::DoNotOptimize(Offset);
+                }
+                NumDone.fetch_add(1);
+            }
+        });
+    }
+
+    Uint64 FenceValue = 0;
+    while (State.KeepRunning())
+    {
+        ++FenceValue;
+        NumDone.store(0);
+        Frame.store(FenceValue);
+        for (Uint32 i = 0; i < AllocsPerThread; ++i)
+        {
+            auto Offset = RB.Allocate(AllocSize, 16);
+            VERIFY_EXPR(Offset != RingBufferType::InvalidOffset);
+            Benchmark::DoNotOptimize(Offset);
+        }
+        while (NumDone.load() != NumThreads - 1)
+            std::this_thread::yield();
+
+        RB.FinishCurrentFrame(FenceValue);
+        if (FenceValue > FramesInFlight)
+            RB.ReleaseCompletedFrames(FenceValue - FramesInFlight);
+    }
+    Stop.store(true);
+    for (auto& Worker : Workers)
+        Worker.join();
+
+    RB.ReleaseCompletedFrames(FenceValue);
+    State.SetItemsProcessed(State.GetIterations() * AllocsPerThread * NumThreads);
+}
+
+void RingBuffer_AllocateParallelLocked(Benchmark::State& State)
+{
+    AllocateParallel<LockedRingBuffer>(State);
+}
+DILIGENT_BENCHMARK_ARGS(RingBuffer_AllocateParallelLocked, 1, 2, 4, 8);
+
+void ConcurrentRingBuffer_AllocateParallel(Benchmark::State& State)
+{
+    AllocateParallel<ConcurrentRingBuffer>(State);
+}
+DILIGENT_BENCHMARK_ARGS(ConcurrentRingBuffer_AllocateParallel, 1, 2, 4, 8);
+
+} // namespace
@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TextureFormatConverter.hpp"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "GraphicsAccessories.hpp"
+#include "ColorConversion.h"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr Uint32 TextureSize = 512;
+
+struct ConversionInfo
+{
+    TEXTURE_FORMAT SrcFormat;
+    TEXTURE_FORMAT DstFormat;
+};
+
+// clang-format off
+constexpr ConversionInfo Conversions[] =
+{
+    {TEX_FORMAT_RGBA8_UNORM,      TEX_FORMAT_BGRA8_UNORM},
+    {TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_RGBA32_FLOAT},
+    {TEX_FORMAT_RGBA32_FLOAT,     TEX_FORMAT_RGBA8_UNORM_SRGB},
+    {TEX_FORMAT_RGBA32_FLOAT,     TEX_FORMAT_RGBA16_FLOAT},
+    {TEX_FORMAT_RGBA16_FLOAT,     TEX_FORMAT_R11G11B10_FLOAT},
+    {TEX_FORMAT_RGBA32_FLOAT,     TEX_FORMAT_RGB10A2_UNORM},
+};
+// clang-format on
+
+std::vector<Uint8> CreateTextureData(TEXTURE_FORMAT Format)
+{
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(Format);
+
+    std::vector<Uint8> Data(size_t{TextureSize} * TextureSize * FmtAttribs.GetElementSize());
+    if (FmtAttribs.ComponentType == COMPONENT_TYPE_FLOAT && FmtAttribs.ComponentSize == 4)
+    {
+        FastRandFloat Rnd{0, 0.f, 1.f};
+        for (size_t i = 0; i < Data.size(); i += sizeof(float))
+        {
+            const float Val = Rnd();
+            memcpy(&Data[i], &Val, sizeof(float));
+        }
+    }
+    else if (FmtAttribs.ComponentType == COMPONENT_TYPE_FLOAT)
+    {
+        // Generate valid 16-bit floats
+        std::vector<Uint8> Float32Data = CreateTextureData(TEX_FORMAT_RGBA32_FLOAT);
+
+        ConvertTextureDataAttribs Attribs;
+        Attribs.Width     = TextureSize;
+        Attribs.Height    = TextureSize;
+        Attribs.SrcFormat = TEX_FORMAT_RGBA32_FLOAT;
+        Attribs.pSrcData  = Float32Data.data();
+        Attribs.SrcStride = size_t{TextureSize} * 16;
+        Attribs.DstFormat = Format;
+        Attribs.pDstData  = Data.data();
+        Attribs.DstStride = size_t{TextureSize} * FmtAttribs.GetElementSize();
+        ConvertTextureData(Attribs);
+    }
+    else
+    {
+        FastRandInt Rnd{0, 0, 255};
+        for (Uint8& Val : Data)
+            Val = static_cast<Uint8>(Rnd());
+    }
+    return Data;
+}
+
+void TextureFormatConverter_Convert(Benchmark::State& State)
+{
+    const ConversionInfo& Conversion = Conversions[State.GetArg()];
+
+    const std::vector<Uint8> Src = CreateTextureData(Conversion.SrcFormat);
+    std::vector<Uint8>       Dst(size_t{TextureSize} * TextureSize * GetTextureFormatAttribs(Conversion.DstFormat).GetElementSize());
+
+    ConvertTextureDataAttribs Attribs;
+    Attribs.Width     = TextureSize;
+    Attribs.Height    = TextureSize;
+    Attribs.SrcFormat = Conversion.SrcFormat;
+    Attribs.pSrcData  = Src.data();
+    Attribs.SrcStride = Src.size() / TextureSize;
+    Attribs.DstFormat = Conversion.DstFormat;
+    Attribs.pDstData  = Dst.data();
+    Attribs.DstStride = Dst.size() / TextureSize;
+    while (State.KeepRunning())
+    {
+        ConvertTextureData(Attribs);
+        Benchmark::DoNotOptimize(Dst.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * TextureSize * TextureSize);
+}
+DILIGENT_BENCHMARK_ARGS(TextureFormatConverter_Convert, 0, 1, 2, 3, 4, 5);
+
+// Typical per-texel conversion of linear colors to sRGB, for comparison with TextureFormatConverter_Convert/2
+void TextureFormatConverter_PerTexelLinearToSRGB(Benchmark::State& State)
+{
+    const std::vector<Uint8> SrcData = CreateTextureData(TEX_FORMAT_RGBA32_FLOAT);
+    const float*             pSrc    = reinterpret_cast<const float*>(SrcData.data());
+    std::vector<Uint8>       Dst(size_t{TextureSize} * TextureSize * 4);
+    while (State.KeepRunning())
+    {
+        for (size_t i = 0; i < Dst.size(); i += 4)
+        {
+            const float4 Color = LinearToSRGBA(float4{pSrc[i], pSrc[i + 1], pSrc[i + 2], pSrc[i + 3]});
+            for (size_t c = 0; c < 4; ++c)
+                Dst[i + c] = static_cast<Uint8>(clamp(Color[c], 0.f, 1.f) * 255.f + 0.5f);
+        }
+        Benchmark::DoNotOptimize(Dst.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * TextureSize * TextureSize);
+}
+DILIGENT_BENCHMARK(TextureFormatConverter_PerTexelLinearToSRGB);
+
+} // namespace
@@ -0,0 +1,134 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "VariableSizeAllocationsManager.hpp"
+#include "TLSFAllocationsManager.hpp"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr size_t NumAllocationsPerIteration = 256;
+
+VariableSizeAllocationsManager::CreateInfo GetCreateInfo(size_t MaxSize)
+{
+    // Debug validation is O(N) per operation and would dominate the measurements
+    return VariableSizeAllocationsManager::CreateInfo{DefaultRawMemoryAllocator::GetAllocator(), MaxSize, true};
+}
+
+// Allocates blocks of random sizes and frees them in random order,
+// which exercises free block merging in the manager.
+template <typename AllocationsManagerType>
+void AllocationsManager_AllocateFree(Benchmark::State& State)
+{
+    const auto MaxAllocSize = static_cast<size_t>(State.GetArg());
+
+    AllocationsManagerType Mgr{GetCreateInfo(NumAllocationsPerIteration * MaxAllocSize * 2)};
+
+    FastRandInt RndSize{0, 1, static_cast<int>(MaxAllocSize)};
+    FastRand    RndOrder{1};
+
+    std::vector<typename AllocationsManagerType::Allocation> Allocations(NumAllocationsPerIteration);
+    while (State.KeepRunning())
+    {
+        for (auto& Alloc : Allocations)
+        {
+            Alloc = Mgr.Allocate(static_cast<size_t>(RndSize()), 16);
+            VERIFY_EXPR(Alloc.IsValid());
+        }
+
+        // Shuffle outside of the timed region
+        State.PauseTiming();
+        for (size_t i = Allocations.size() - 1; i > 0; --i)
+            std::swap(Allocations[i], Allocations[RndOrder() % (i + 1)]);
+        State.ResumeTiming();
+
+        for (auto& Alloc : Allocations)
+            Mgr.Free(std::move(Alloc));
+        VERIFY_EXPR(Mgr.IsEmpty());
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumAllocationsPerIteration);
+}
+
+
+// Keeps the manager partially filled with randomly sized blocks and replaces one block per iteration.
+// MaxSizePercent is the manager size relative to the expected total size of live blocks.
+template <typename AllocationsManagerType, size_t MaxSizePercent>
+void AllocationsManager_Fragmented(Benchmark::State& State)
+{
+    const auto       NumLiveAllocations = static_cast<size_t>(State.GetArg());
+    constexpr size_t MaxAllocSize       = 1024;
+
+    AllocationsManagerType Mgr{GetCreateInfo(NumLiveAllocations * MaxAllocSize / 2 * MaxSizePercent / 100)};
+
+    FastRandInt RndSize{0, 1, static_cast<int>(MaxAllocSize)};
+    FastRand    RndIdx{1};
+
+    std::vector<typename AllocationsManagerType::Allocation> Allocations(NumLiveAllocations);
+    for (auto& Alloc : Allocations)
+        Alloc = Mgr.Allocate(static_cast<size_t>(RndSize()), 16);
+
+    while (State.KeepRunning())
+    {
+        auto& Alloc = Allocations[RndIdx() % NumLiveAllocations];
+        if (Alloc.IsValid())
+            Mgr.Free(std::move(Alloc));
+        Alloc = Mgr.Allocate(static_cast<size_t>(RndSize()), 16);
+    }
+    State.SetItemsProcessed(State.GetIterations());
+
+    for (auto& Alloc : Allocations)
+    {
+        if (Alloc.IsValid())
+            Mgr.Free(std::move(Alloc));
+    }
+}
+
+// clang-format off
+void VariableSizeAllocationsManager_AllocateFree(Benchmark::State& State)      { AllocationsManager_AllocateFree<VariableSizeAllocationsManager>(State); }
+void TLSFAllocationsManager_AllocateFree(Benchmark::State& State)              { AllocationsManager_AllocateFree<TLSFAllocationsManager>(State); }
+void VariableSizeAllocationsManager_Fragmented(Benchmark::State& State)        { AllocationsManager_Fragmented<VariableSizeAllocationsManager, 200>(State); }
+void TLSFAllocationsManager_Fragmented(Benchmark::State& State)                { AllocationsManager_Fragmented<TLSFAllocationsManager, 200>(State); }
+// The manager is only 25% larger than the live set, so the free space is heavily fragmented
+void VariableSizeAllocationsManager_FragmentedTight(Benchmark::State& State)   { AllocationsManager_Fragmented<VariableSizeAllocationsManager, 125>(State); }
+void TLSFAllocationsManager_FragmentedTight(Benchmark::State& State)           { AllocationsManager_Fragmented<TLSFAllocationsManager, 125>(State); }
+// clang-format on
+DILIGENT_BENCHMARK_ARGS(VariableSizeAllocationsManager_AllocateFree, 256, 16384);
+DILIGENT_BENCHMARK_ARGS(TLSFAllocationsManager_AllocateFree, 256, 16384);
+DILIGENT_BENCHMARK_ARGS(VariableSizeAllocationsManager_Fragmented, 1024, 16384);
+DILIGENT_BENCHMARK_ARGS(TLSFAllocationsManager_Fragmented, 1024, 16384);
+DILIGENT_BENCHMARK_ARGS(VariableSizeAllocationsManager_FragmentedTight, 1024, 16384);
+DILIGENT_BENCHMARK_ARGS(TLSFAllocationsManager_FragmentedTight, 1024, 16384);
+
+} // namespace
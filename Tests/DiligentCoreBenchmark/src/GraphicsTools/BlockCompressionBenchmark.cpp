@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BlockCompression.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "GraphicsAccessories.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr Uint32 TextureSize = 256;
+
+constexpr TEXTURE_FORMAT Formats[] = {
+    TEX_FORMAT_BC1_UNORM,
+    TEX_FORMAT_BC3_UNORM,
+    TEX_FORMAT_BC5_UNORM,
+    TEX_FORMAT_BC7_UNORM,
+};
+
+// Smooth RGBA8 image with noise
+std::vector<Uint8> CreateTextureData()
+{
+    FastRandInt        Rnd{0, -4, 4};
+    std::vector<Uint8> Data(size_t{TextureSize} * TextureSize * 4);
+    for (Uint32 y = 0; y < TextureSize; ++y)
+    {
+        for (Uint32 x = 0; x < TextureSize; ++x)
+        {
+            for (Uint32 c = 0; c < 4; ++c)
+            {
+                const float u   = static_cast<float>(x) / 32.f;
+                const float v   = static_cast<float>(y) / 32.f;
+                const float Val = 127.5f + 127.5f * std::sin((1.f + 0.7f * static_cast<float>(c)) * u + 2.f * std::cos(v * (0.5f + static_cast<float>(c))));
+
+                Data[(size_t{y} * TextureSize + x) * 4 + c] = static_cast<Uint8>(std::min(std::max(static_cast<int>(Val) + Rnd(), 0), 255));
+            }
+        }
+    }
+    return Data;
+}
+
+size_t GetCompressedStride(TEXTURE_FORMAT Format)
+{
+    return size_t{TextureSize / 4} * GetTextureFormatAttribs(Format).GetElementSize();
+}
+
+// Argument is the format index times two plus the quality
+void BlockCompression_Compress(Benchmark::State& State)
+{
+    const TEXTURE_FORMAT Format = Formats[State.GetArg() / 2];
+
+    const std::vector<Uint8> Src = CreateTextureData();
+    std::vector<Uint8>       Dst(GetCompressedStride(Format) * (TextureSize / 4));
+
+    CompressTextureDataAttribs Attribs;
+    Attribs.Width     = TextureSize;
+    Attribs.Height    = TextureSize;
+    Attribs.SrcFormat = TEX_FORMAT_RGBA8_UNORM;
+    Attribs.pSrcData  = Src.data();
+    Attribs.SrcStride = size_t{TextureSize} * 4;
+    Attribs.DstFormat = Format;
+    Attribs.pDstData  = Dst.data();
+    Attribs.DstStride = GetCompressedStride(Format);
+    Attribs.Quality   = static_cast<BLOCK_COMPRESSION_QUALITY>(State.GetArg() % 2);
+    while (State.KeepRunning())
+    {
+        CompressTextureData(Attribs);
+        Benchmark::DoNotOptimize(Dst.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * TextureSize * TextureSize);
+}
+DILIGENT_BENCHMARK_ARGS(BlockCompression_Compress, 0, 1, 2, 3, 4, 5, 6, 7);
+
+void BlockCompression_Decompress(Benchmark::State& State)
+{
+    const TEXTURE_FORMAT Format = Formats[State.GetArg()];
+
+    const std::vector<Uint8> Src = CreateTextureData();
+    std::vector<Uint8>       Blocks(GetCompressedStride(Format) * (TextureSize / 4));
+
+    CompressTextureDataAttribs CompressAttribs;
+    CompressAttribs.Width     = TextureSize;
+    CompressAttribs.Height    = TextureSize;
+    CompressAttribs.SrcFormat = TEX_FORMAT_RGBA8_UNORM;
+    CompressAttribs.pSrcData  = Src.data();
+    CompressAttribs.SrcStride = size_t{TextureSize} * 4;
+    CompressAttribs.DstFormat = Format;
+    CompressAttribs.pDstData  = Blocks.data();
+    CompressAttribs.DstStride = GetCompressedStride(Format);
+    CompressTextureData(CompressAttribs);
+
+    std::vector<Uint8> Dst(Src.size());
+
+    DecompressTextureDataAttribs Attribs;
+    Attribs.Width     = TextureSize;
+    Attribs.Height    = TextureSize;
+    Attribs.SrcFormat = Format;
+    Attribs.pSrcData  = Blocks.data();
+    Attribs.SrcStride = GetCompressedStride(Format);
+    Attribs.DstFormat = TEX_FORMAT_RGBA8_UNORM;
+    Attribs.pDstData  = Dst.data();
+    Attribs.DstStride = size_t{TextureSize} * 4;
+    while (State.KeepRunning())
+    {
+        DecompressTextureData(Attribs);
+        Benchmark::DoNotOptimize(Dst.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * TextureSize * TextureSize);
+}
+DILIGENT_BENCHMARK_ARGS(BlockCompression_Decompress, 0, 1, 2, 3);
+
+} // namespace
@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ImageResampler.hpp"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+void ResampleImage(Benchmark::State& State, Uint32 SrcWidth, Uint32 SrcHeight, Uint32 DstWidth, Uint32 DstHeight)
+{
+    FastRandInt        Rnd{0, 0, 255};
+    std::vector<Uint8> Src(size_t{SrcWidth} * SrcHeight * 4);
+    for (Uint8& Val : Src)
+        Val = static_cast<Uint8>(Rnd());
+    std::vector<Uint8> Dst(size_t{DstWidth} * DstHeight * 4);
+
+    ResampleImageAttribs Attribs;
+    Attribs.SrcWidth  = SrcWidth;
+    Attribs.SrcHeight = SrcHeight;
+    Attribs.SrcFormat = TEX_FORMAT_RGBA8_UNORM_SRGB;
+    Attribs.pSrcData  = Src.data();
+    Attribs.SrcStride = size_t{SrcWidth} * 4;
+    Attribs.DstWidth  = DstWidth;
+    Attribs.DstHeight = DstHeight;
+    Attribs.DstFormat = TEX_FORMAT_RGBA8_UNORM_SRGB;
+    Attribs.pDstData  = Dst.data();
+    Attribs.DstStride = size_t{DstWidth} * 4;
+    Attribs.Filter    = static_cast<RESAMPLE_FILTER>(State.GetArg());
+    while (State.KeepRunning())
+    {
+        Diligent::ResampleImage(Attribs);
+        Benchmark::DoNotOptimize(Dst.data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * DstWidth * DstHeight);
+}
+
+// Argument is the filter
+void ImageResampler_Downscale(Benchmark::State& State)
+{
+    ResampleImage(State, 1920, 1080, 480, 270);
+}
+DILIGENT_BENCHMARK_ARGS(ImageResampler_Downscale, 0, 1, 2, 3, 4);
+
+// Argument is the filter
+void ImageResampler_Upscale(Benchmark::State& State)
+{
+    ResampleImage(State, 640, 360, 1280, 720);
+}
+DILIGENT_BENCHMARK_ARGS(ImageResampler_Upscale, 0, 1, 2, 3, 4);
+
+} // namespace
@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "MipChainGenerator.hpp"
+
+#include <vector>
+
+#include "BenchmarkFramework.hpp"
+#include "GraphicsAccessories.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr Uint32 TextureSize = 512;
+
+// Argument is the filter
+void MipChainGenerator_ComputeMipChain(Benchmark::State& State)
+{
+    FastRandInt        Rnd{0, 0, 255};
+    std::vector<Uint8> Src(size_t{TextureSize} * TextureSize * 4);
+    for (Uint8& Val : Src)
+        Val = static_cast<Uint8>(Rnd());
+
+    const Uint32 NumMipLevels = ComputeMipLevelsCount(TextureSize, TextureSize) - 1;
+
+    std::vector<std::vector<Uint8>> Levels(NumMipLevels);
+    std::vector<MipLevelData>       MipData(NumMipLevels);
+    size_t                          NumTexels = 0;
+    for (Uint32 Mip = 1; Mip <= NumMipLevels; ++Mip)
+    {
+        const Uint32 MipSize = TextureSize >> Mip;
+        Levels[Mip - 1].resize(size_t{MipSize} * MipSize * 4);
+        MipData[Mip - 1].pData  = Levels[Mip - 1].data();
+        MipData[Mip - 1].Stride = size_t{MipSize} * 4;
+        NumTexels += size_t{MipSize} * MipSize;
+    }
+
+    ComputeMipChainAttribs Attribs;
+    Attribs.Format       = TEX_FORMAT_RGBA8_UNORM_SRGB;
+    Attribs.Width        = TextureSize;
+    Attribs.Height       = TextureSize;
+    Attribs.pSrcData     = Src.data();
+    Attribs.SrcStride    = size_t{TextureSize} * 4;
+    Attribs.NumMipLevels = NumMipLevels;
+    Attribs.pMipLevels   = MipData.data();
+    Attribs.Filter       = static_cast<MIP_CHAIN_FILTER>(State.GetArg());
+    while (State.KeepRunning())
+    {
+        ComputeMipChain(Attribs);
+        Benchmark::DoNotOptimize(Levels.back().data());
+    }
+    State.SetItemsProcessed(State.GetIterations() * NumTexels);
+}
+DILIGENT_BENCHMARK_ARGS(MipChainGenerator_ComputeMipChain, 0, 1, 2);
+
+} // namespace
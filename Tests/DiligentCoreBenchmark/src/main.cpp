@@ -0,0 +1,107 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "BenchmarkFramework.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+void PrintUsage(const char* ExeName)
+{
+    std::cerr << "Usage: " << ExeName << " [options]\n"
+              << "  --filter=<str>       Only run benchmarks whose names contain <str>\n"
+              << "  --min_time=<sec>     Minimum time per benchmark run (default: 0.5)\n"
+              << "  --repetitions=<n>    Number of repetitions of each benchmark (default: 1)\n"
+              << "  --out=<file>         Write JSON results to <file> instead of stdout\n"
+              << "  --quiet              Do not print progress to stderr\n"
+              << "  --list               List registered benchmarks and exit\n";
+}
+
+bool ParseOption(const char* Arg, const char* Name, const char*& Value)
+{
+    const size_t NameLen = strlen(Name);
+    if (strncmp(Arg, Name, NameLen) == 0 && Arg[NameLen] == '=')
+    {
+        Value = Arg + NameLen + 1;
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Benchmark::RunSettings Settings;
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* Arg   = argv[i];
+        const char* Value = nullptr;
+        if (ParseOption(Arg, "--filter", Value))
+        {
+            Settings.Filter = Value;
+        }
+        else if (ParseOption(Arg, "--min_time", Value))
+        {
+            Settings.MinTime = std::atof(Value);
+        }
+        else if (ParseOption(Arg, "--repetitions", Value))
+        {
+            Settings.Repetitions = static_cast<Uint32>(std::atoi(Value));
+        }
+        else if (ParseOption(Arg, "--out", Value))
+        {
+            Settings.OutputFile = Value;
+        }
+        else if (strcmp(Arg, "--quiet") == 0)
+        {
+            Settings.Verbose = false;
+        }
+        else if (strcmp(Arg, "--list") == 0)
+        {
+            for (const auto& Name : Benchmark::GetBenchmarkNames())
+                std::cout << Name << '\n';
+            return 0;
+        }
+        else
+        {
+            if (strcmp(Arg, "--help") != 0)
+                std::cerr << "Unknown option: " << Arg << "\n";
+            PrintUsage(argv[0]);
+            return strcmp(Arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    return Benchmark::RunBenchmarks(Settings) ? 0 : 1;
+}
@@ -31,6 +31,7 @@
 #include "gtest/gtest.h"
 
 #include "FastRand.hpp"
+#include "ThreadPool.hpp"
 
 using namespace Diligent;
 
@@ -111,4 +112,93 @@ TEST(Common_Array2DTools, GetArray2DMinMaxValue)
     }
 }
 
+TEST(Common_Array2DTools, GetArray2DMinMaxValueParallel)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+
+    FastRandFloat Rnd{1, -100, +100};
+    for (Uint32 test = 0; test < 4; ++test)
+    {
+        const Uint32 Width  = 1000 + test * 37;
+        const Uint32 Height = 700 + test * 101;
+        const size_t Stride = Width + test * 3;
+
+        std::vector<float> Data(Stride * Height);
+        for (auto& Val : Data)
+            Val = Rnd();
+        // Put the extremes in different rows
+        Data[(test * 13) % Width + (Height - 1 - test) * Stride] = -1000.f - test;
+        Data[(test * 17) % Width + (test * 5) * Stride]          = +1000.f + test;
+
+        float Min = 0, Max = 0;
+        GetArray2DMinMaxValue(Data.data(), Stride, Width, Height, Min, Max, pThreadPool);
+        EXPECT_EQ(Min, -1000.f - test);
+        EXPECT_EQ(Max, +1000.f + test);
+    }
+}
+
+void TestMinMaxPyramid(Uint32 Width, Uint32 Height, IThreadPool* pThreadPool)
+{
+    const size_t Stride = Width + 3;
+
+    FastRandFloat      Rnd{Width * 1000 + Height, -100, +100};
+    std::vector<float> Data(Stride * Height);
+    for (auto& Val : Data)
+        Val = Rnd();
+
+    Array2DMinMaxPyramid Pyramid;
+    Pyramid.Build(Data.data(), Stride, Width, Height, pThreadPool);
+    ASSERT_GT(Pyramid.GetLevelCount(), 0u);
+    EXPECT_EQ(Pyramid.GetLevelWidth(Pyramid.GetLevelCount() - 1), 1u);
+    EXPECT_EQ(Pyramid.GetLevelHeight(Pyramid.GetLevelCount() - 1), 1u);
+
+    for (Uint32 Level = 0; Level < Pyramid.GetLevelCount(); ++Level)
+    {
+        const Uint32 LevelWidth  = Pyramid.GetLevelWidth(Level);
+        const Uint32 LevelHeight = Pyramid.GetLevelHeight(Level);
+        const Uint32 BlockSize   = 2u << Level;
+        EXPECT_EQ(LevelWidth, (Width + BlockSize - 1) / BlockSize);
+        EXPECT_EQ(LevelHeight, (Height + BlockSize - 1) / BlockSize);
+
+        const float* pMin = Pyramid.GetMinValues(Level);
+        const float* pMax = Pyramid.GetMaxValues(Level);
+        for (Uint32 y = 0; y < LevelHeight; ++y)
+        {
+            for (Uint32 x = 0; x < LevelWidth; ++x)
+            {
+                float RefMin = +FLT_MAX;
+                float RefMax = -FLT_MAX;
+                for (Uint32 row = y * BlockSize; row < std::min((y + 1) * BlockSize, Height); ++row)
+                {
+                    for (Uint32 col = x * BlockSize; col < std::min((x + 1) * BlockSize, Width); ++col)
+                    {
+                        RefMin = std::min(RefMin, Data[col + row * Stride]);
+                        RefMax = std::max(RefMax, Data[col + row * Stride]);
+                    }
+                }
+                ASSERT_EQ(pMin[x + y * LevelWidth], RefMin) << "Level " << Level << " (" << x << ", " << y << ")";
+                ASSERT_EQ(pMax[x + y * LevelWidth], RefMax) << "Level " << Level << " (" << x << ", " << y << ")";
+            }
+        }
+    }
+}
+
+TEST(Common_Array2DTools, MinMaxPyramid)
+{
+    TestMinMaxPyramid(1, 1, nullptr);
+    TestMinMaxPyramid(1, 7, nullptr);
+    TestMinMaxPyramid(13, 1, nullptr);
+    TestMinMaxPyramid(13, 5, nullptr);
+    TestMinMaxPyramid(64, 64, nullptr);
+    TestMinMaxPyramid(255, 129, nullptr);
+}
+
+TEST(Common_Array2DTools, MinMaxPyramidParallel)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    TestMinMaxPyramid(64, 64, pThreadPool);
+    TestMinMaxPyramid(1031, 517, pThreadPool);
+    TestMinMaxPyramid(3, 1025, pThreadPool);
+}
+
 } // namespace
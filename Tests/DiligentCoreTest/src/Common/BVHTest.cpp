@@ -0,0 +1,360 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BVH.hpp"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct TriangleSoup
+{
+    explicit TriangleSoup(Uint32 NumTriangles, float SceneSize = 100.f, float TriSize = 5.f)
+    {
+        FastRandFloat Rnd{0, -SceneSize, SceneSize};
+        FastRandFloat RndOffset{1, -TriSize, TriSize};
+        for (Uint32 t = 0; t < NumTriangles; ++t)
+        {
+            const float3 Center{Rnd(), Rnd(), Rnd()};
+            for (Uint32 v = 0; v < 3; ++v)
+            {
+                Indices.push_back(static_cast<Uint32>(Vertices.size()));
+                Vertices.push_back(Center + float3{RndOffset(), RndOffset(), RndOffset()});
+            }
+        }
+    }
+
+    Uint32 GetNumTriangles() const { return static_cast<Uint32>(Indices.size() / 3); }
+
+    BVHTriangleIntersector GetIntersector() const
+    {
+        return BVHTriangleIntersector{Vertices.data(), Indices.data()};
+    }
+
+    std::vector<float3> Vertices;
+    std::vector<Uint32> Indices;
+};
+
+std::vector<BVHRay> GenerateRays(Uint32 NumRays, float SceneSize = 100.f)
+{
+    FastRandFloat Rnd{2, -SceneSize * 1.5f, SceneSize * 1.5f};
+    FastRandFloat RndTarget{3, -SceneSize * 0.5f, SceneSize * 0.5f};
+
+    std::vector<BVHRay> Rays(NumRays);
+    for (auto& Ray : Rays)
+    {
+        Ray.Origin    = float3{Rnd(), Rnd(), Rnd()};
+        Ray.Direction = normalize(float3{RndTarget(), RndTarget(), RndTarget()} - Ray.Origin);
+    }
+    // Axis-aligned rays
+    if (NumRays >= 3)
+    {
+        Rays[0].Direction = float3{1, 0, 0};
+        Rays[1].Direction = float3{0, -1, 0};
+        Rays[2].Direction = float3{0, 0, 1};
+    }
+    return Rays;
+}
+
+template <typename IntersectorType>
+BVHHit IntersectBruteForce(Uint32 NumPrims, const BVHRay& Ray, const IntersectorType& Intersector)
+{
+    BVHHit Hit;
+    for (Uint32 i = 0; i < NumPrims; ++i)
+    {
+        const float Dist = Intersector(i, Ray);
+        if (Dist >= Ray.MinDist && Dist <= Ray.MaxDist && Dist < Hit.Distance)
+        {
+            Hit.PrimitiveIndex = i;
+            Hit.Distance       = Dist;
+        }
+    }
+    return Hit;
+}
+
+bool Contains(const BVHNode& Node, const float3& Min, const float3& Max)
+{
+    return (Node.Min.x <= Min.x && Node.Min.y <= Min.y && Node.Min.z <= Min.z &&
+            Max.x <= Node.Max.x && Max.y <= Node.Max.y && Max.z <= Node.Max.z);
+}
+
+void ValidateBVH(const BoundingVolumeHierarchy& BVH, const BoundBox* pBounds, Uint32 NumPrims, Uint32 MaxLeafSize)
+{
+    const auto& Nodes   = BVH.GetNodes();
+    const auto& Indices = BVH.GetPrimitiveIndices();
+    ASSERT_EQ(Indices.size(), NumPrims);
+    ASSERT_LE(Nodes.size(), size_t{NumPrims} * 2 - 1);
+    EXPECT_LE(BVH.GetDepth(), BoundingVolumeHierarchy::MaxDepth);
+
+    std::vector<Uint32> PrimRefs(NumPrims);
+    std::vector<Uint32> NodeRefs(Nodes.size());
+    for (size_t n = 0; n < Nodes.size(); ++n)
+    {
+        const auto& Node = Nodes[n];
+        if (Node.IsLeaf())
+        {
+            EXPECT_LE(Node.NumPrimitives, MaxLeafSize);
+            ASSERT_LE(Node.LeftOrFirst + Node.NumPrimitives, Indices.size());
+            for (Uint32 i = 0; i < Node.NumPrimitives; ++i)
+            {
+                const Uint32 PrimIdx = Indices[Node.LeftOrFirst + i];
+                ASSERT_LT(PrimIdx, NumPrims);
+                ++PrimRefs[PrimIdx];
+                EXPECT_TRUE(Contains(Node, pBounds[PrimIdx].Min, pBounds[PrimIdx].Max));
+            }
+        }
+        else
+        {
+            ASSERT_LT(Node.LeftOrFirst + 1, Nodes.size());
+            for (Uint32 c = 0; c < 2; ++c)
+            {
+                const auto& Child = Nodes[Node.LeftOrFirst + c];
+                ++NodeRefs[Node.LeftOrFirst + c];
+                EXPECT_TRUE(Contains(Node, Child.Min, Child.Max));
+            }
+        }
+    }
+
+    for (Uint32 i = 0; i < NumPrims; ++i)
+        EXPECT_EQ(PrimRefs[i], 1u) << "Primitive " << i;
+    EXPECT_EQ(NodeRefs[0], 0u);
+    for (size_t n = 1; n < NodeRefs.size(); ++n)
+        EXPECT_EQ(NodeRefs[n], 1u) << "Node " << n;
+}
+
+void TestRayQueries(const BoundingVolumeHierarchy& BVH, const TriangleSoup& Mesh, const std::vector<BVHRay>& Rays)
+{
+    const auto Intersector = Mesh.GetIntersector();
+
+    size_t NumHits = 0;
+    for (size_t r = 0; r < Rays.size(); ++r)
+    {
+        const auto& Ray = Rays[r];
+
+        const auto RefHit = IntersectBruteForce(Mesh.GetNumTriangles(), Ray, Intersector);
+        const auto Hit    = BVH.IntersectClosest(Ray, Intersector);
+        EXPECT_EQ(Hit.Distance, RefHit.Distance) << "Ray " << r;
+        if (Hit.PrimitiveIndex != RefHit.PrimitiveIndex)
+        {
+            // Two triangles may be hit at exactly the same distance
+            ASSERT_TRUE(Hit);
+            EXPECT_EQ(Intersector(Hit.PrimitiveIndex, Ray), RefHit.Distance) << "Ray " << r;
+        }
+
+        const auto AnyHit = BVH.IntersectAny(Ray, Intersector);
+        EXPECT_EQ(static_cast<bool>(AnyHit), static_cast<bool>(RefHit)) << "Ray " << r;
+        if (AnyHit)
+        {
+            EXPECT_EQ(Intersector(AnyHit.PrimitiveIndex, Ray), AnyHit.Distance);
+            EXPECT_GE(AnyHit.Distance, Ray.MinDist);
+            EXPECT_LE(AnyHit.Distance, Ray.MaxDist);
+            ++NumHits;
+        }
+    }
+    // Make sure that the test is meaningful
+    EXPECT_GT(NumHits, size_t{0});
+    EXPECT_LT(NumHits, Rays.size());
+
+    for (size_t r = 0; r + 4 <= Rays.size(); r += 4)
+    {
+        BVHHit Hits[4];
+        BVH.IntersectClosest4(&Rays[r], Hits, Intersector);
+        for (size_t i = 0; i < 4; ++i)
+        {
+            const auto RefHit = BVH.IntersectClosest(Rays[r + i], Intersector);
+            EXPECT_EQ(Hits[i].Distance, RefHit.Distance) << "Ray " << r + i;
+            EXPECT_EQ(Hits[i].PrimitiveIndex, RefHit.PrimitiveIndex) << "Ray " << r + i;
+        }
+
+        BVH.IntersectAny4(&Rays[r], Hits, Intersector);
+        for (size_t i = 0; i < 4; ++i)
+        {
+            const auto RefHit = BVH.IntersectAny(Rays[r + i], Intersector);
+            EXPECT_EQ(static_cast<bool>(Hits[i]), static_cast<bool>(RefHit)) << "Ray " << r + i;
+        }
+    }
+}
+
+std::vector<BoundBox> GetTriangleBounds(const TriangleSoup& Mesh)
+{
+    std::vector<BoundBox> Bounds(Mesh.GetNumTriangles());
+    for (Uint32 t = 0; t < Mesh.GetNumTriangles(); ++t)
+    {
+        Bounds[t] = BoundBox::Invalid();
+        for (Uint32 v = 0; v < 3; ++v)
+            Bounds[t] = Bounds[t].Enclose(Mesh.Vertices[Mesh.Indices[t * 3 + v]]);
+    }
+    return Bounds;
+}
+
+TEST(Common_BVH, Empty)
+{
+    BoundingVolumeHierarchy BVH{BoundingVolumeHierarchy::CreateInfo{}};
+    EXPECT_TRUE(BVH.IsEmpty());
+    EXPECT_FALSE(BVH.GetBounds().IsValid());
+
+    BVHRay Ray;
+    Ray.Direction = float3{0, 0, 1};
+    EXPECT_FALSE(BVH.IntersectClosest(Ray, [](Uint32, const BVHRay&) { return 0.f; }));
+    EXPECT_FALSE(BVH.IntersectAny(Ray, [](Uint32, const BVHRay&) { return 0.f; }));
+}
+
+TEST(Common_BVH, TriangleMesh)
+{
+    for (Uint32 NumTriangles : {1u, 2u, 5u, 100u, 3000u})
+    {
+        const TriangleSoup Mesh{NumTriangles};
+        const auto         Bounds = GetTriangleBounds(Mesh);
+        const auto         Rays   = GenerateRays(400);
+        for (Uint32 MaxLeafSize : {1u, 4u, 16u})
+        {
+            BoundingVolumeHierarchy::CreateInfo CI;
+            CI.MaxLeafSize = MaxLeafSize;
+
+            const auto BVH = CreateTriangleMeshBVH(Mesh.Vertices.data(), Mesh.Indices.data(), Mesh.GetNumTriangles(), CI);
+            ValidateBVH(BVH, Bounds.data(), NumTriangles, MaxLeafSize);
+            if (NumTriangles >= 100)
+                TestRayQueries(BVH, Mesh, Rays);
+        }
+    }
+}
+
+TEST(Common_BVH, RayRange)
+{
+    const TriangleSoup Mesh{2000};
+    const auto         BVH = CreateTriangleMeshBVH(Mesh.Vertices.data(), Mesh.Indices.data(), Mesh.GetNumTriangles());
+
+    auto Rays = GenerateRays(200);
+    for (auto& Ray : Rays)
+    {
+        Ray.MinDist = 50;
+        Ray.MaxDist = 150;
+    }
+    TestRayQueries(BVH, Mesh, Rays);
+}
+
+TEST(Common_BVH, ParallelBuild)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    const TriangleSoup Mesh{20000};
+    const auto         Bounds = GetTriangleBounds(Mesh);
+
+    BoundingVolumeHierarchy::CreateInfo CI;
+    CI.pThreadPool            = pThreadPool;
+    CI.MinParallelSubtreeSize = 256;
+
+    const auto BVH = CreateTriangleMeshBVH(Mesh.Vertices.data(), Mesh.Indices.data(), Mesh.GetNumTriangles(), CI);
+    ValidateBVH(BVH, Bounds.data(), Mesh.GetNumTriangles(), CI.MaxLeafSize);
+    TestRayQueries(BVH, Mesh, GenerateRays(200));
+
+    // The tree must be the same as the one built on a single thread, up to the node order
+    CI.pThreadPool       = nullptr;
+    const auto BVHSerial = CreateTriangleMeshBVH(Mesh.Vertices.data(), Mesh.Indices.data(), Mesh.GetNumTriangles(), CI);
+    EXPECT_EQ(BVH.GetNodes().size(), BVHSerial.GetNodes().size());
+    EXPECT_EQ(BVH.GetDepth(), BVHSerial.GetDepth());
+}
+
+TEST(Common_BVH, CoincidentPrimitives)
+{
+    // All primitives have the same bounds, so SAH can't split them
+    constexpr Uint32      NumPrims = 1000;
+    std::vector<BoundBox> Boxes(NumPrims, BoundBox{float3{1, 2, 3}, float3{4, 5, 6}});
+
+    BoundingVolumeHierarchy::CreateInfo CI;
+    CI.pPrimitiveBounds = Boxes.data();
+    CI.NumPrimitives    = NumPrims;
+    CI.MaxLeafSize      = 2;
+
+    BoundingVolumeHierarchy BVH{CI};
+    ValidateBVH(BVH, Boxes.data(), NumPrims, CI.MaxLeafSize);
+    EXPECT_EQ(BVH.GetBounds(), Boxes[0]);
+
+    BVHRay Ray;
+    Ray.Origin     = float3{0, 3, 4};
+    Ray.Direction  = float3{1, 0, 0};
+    const auto Hit = BVH.IntersectClosest(Ray, BVHBoxIntersector{Boxes.data()});
+    ASSERT_TRUE(Hit);
+    EXPECT_EQ(Hit.Distance, 1.f);
+
+    Ray.Direction = float3{-1, 0, 0};
+    EXPECT_FALSE(BVH.IntersectAny(Ray, BVHBoxIntersector{Boxes.data()}));
+}
+
+TEST(Common_BVH, Boxes)
+{
+    // Grid of unit boxes
+    std::vector<BoundBox> Boxes;
+    for (int x = 0; x < 20; ++x)
+    {
+        for (int y = 0; y < 20; ++y)
+        {
+            for (int z = 0; z < 20; ++z)
+            {
+                const float3 Min{x * 2.f, y * 2.f, z * 2.f};
+                Boxes.push_back(BoundBox{Min, Min + float3{1, 1, 1}});
+            }
+        }
+    }
+
+    BoundingVolumeHierarchy::CreateInfo CI;
+    CI.pPrimitiveBounds = Boxes.data();
+    CI.NumPrimitives    = static_cast<Uint32>(Boxes.size());
+
+    BoundingVolumeHierarchy BVH{CI};
+    ValidateBVH(BVH, Boxes.data(), CI.NumPrimitives, CI.MaxLeafSize);
+
+    const BVHBoxIntersector Intersector{Boxes.data()};
+    // Ray along the row of boxes hits the first one
+    {
+        BVHRay Ray;
+        Ray.Origin     = float3{-10, 4.5f, 6.5f};
+        Ray.Direction  = float3{1, 0, 0};
+        const auto Hit = BVH.IntersectClosest(Ray, Intersector);
+        ASSERT_TRUE(Hit);
+        EXPECT_EQ(Hit.Distance, 10.f);
+        EXPECT_EQ(Boxes[Hit.PrimitiveIndex].Min, (float3{0, 4, 6}));
+    }
+    // Ray between the rows misses all boxes
+    {
+        BVHRay Ray;
+        Ray.Origin    = float3{-10, 1.5f, 1.5f};
+        Ray.Direction = float3{1, 0, 0};
+        EXPECT_FALSE(BVH.IntersectClosest(Ray, Intersector));
+        EXPECT_FALSE(BVH.IntersectAny(Ray, Intersector));
+    }
+}
+
+} // namespace
@@ -0,0 +1,248 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "CPUProfiler.hpp"
+#include "PlatformDefinitions.h"
+
+#include <thread>
+#include <vector>
+#include <string>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_CPUProfiler, Disabled)
+{
+    CPUProfiler Profiler;
+    EXPECT_FALSE(Profiler.IsEnabled());
+    {
+        ScopedCPUProfilerZone Zone{"Zone", nullptr, Profiler};
+    }
+    EXPECT_EQ(Profiler.GetNumEvents(), size_t{0});
+}
+
+TEST(Common_CPUProfiler, RecordEvents)
+{
+    CPUProfiler Profiler;
+    Profiler.SetEnabled(true);
+    Profiler.SetThreadName("Main \"thread\"");
+
+    {
+        ScopedCPUProfilerZone Outer{"Outer", "Test", Profiler};
+        {
+            ScopedCPUProfilerZone Inner{"Inner", "Test", Profiler};
+        }
+    }
+    EXPECT_EQ(Profiler.GetNumEvents(), size_t{2});
+
+    Profiler.ProcessEvents([](Uint32 /*ThreadIdx*/, const std::string& ThreadName, const std::vector<CPUProfilerEvent>& Events) {
+        EXPECT_EQ(ThreadName, "Main \"thread\"");
+        ASSERT_EQ(Events.size(), size_t{2});
+        // Inner zone ends first
+        EXPECT_STREQ(Events[0].Name, "Inner");
+        EXPECT_STREQ(Events[1].Name, "Outer");
+        EXPECT_STREQ(Events[1].Category, "Test");
+        EXPECT_LE(Events[1].BeginTime, Events[0].BeginTime);
+        EXPECT_GE(Events[1].EndTime, Events[0].EndTime);
+    });
+
+    const auto Trace = Profiler.ExportChromeTrace();
+    EXPECT_NE(Trace.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(Trace.find("\"name\":\"Outer\""), std::string::npos);
+    EXPECT_NE(Trace.find("\"cat\":\"Test\""), std::string::npos);
+    EXPECT_NE(Trace.find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(Trace.find("Main \\\"thread\\\""), std::string::npos);
+
+    Profiler.Clear();
+    EXPECT_EQ(Profiler.GetNumEvents(), size_t{0});
+}
+
+TEST(Common_CPUProfiler, RingBuffer)
+{
+    CPUProfiler Profiler;
+    Profiler.SetEnabled(true);
+    Profiler.SetRingBufferSize(8);
+
+    static const char* Names[] = {"E0", "E1", "E2", "E3", "E4", "E5", "E6", "E7", "E8", "E9", "E10", "E11"};
+    for (Uint64 i = 0; i < _countof(Names); ++i)
+        Profiler.RecordEvent(Names[i], nullptr, i, i + 1);
+
+    Profiler.ProcessEvents([](Uint32 /*ThreadIdx*/, const std::string& /*ThreadName*/, const std::vector<CPUProfilerEvent>& Events) {
+        ASSERT_EQ(Events.size(), size_t{8});
+        for (size_t i = 0; i < Events.size(); ++i)
+        {
+            EXPECT_STREQ(Events[i].Name, Names[i + 4]);
+            EXPECT_EQ(Events[i].BeginTime, i + 4);
+        }
+    });
+}
+
+TEST(Common_CPUProfiler, MultipleThreads)
+{
+    CPUProfiler Profiler;
+    Profiler.SetEnabled(true);
+
+    constexpr Uint32 NumThreads = 4;
+    constexpr Uint32 NumEvents  = 1000;
+
+    std::vector<std::thread> Threads;
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        Threads.emplace_back([&Profiler]() {
+            for (Uint32 j = 0; j < NumEvents; ++j)
+            {
+                ScopedCPUProfilerZone Zone{"Work", "Thread", Profiler};
+            }
+        });
+    }
+
+    // Export concurrently with recording
+    const auto Trace = Profiler.ExportChromeTrace();
+    EXPECT_FALSE(Trace.empty());
+
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(Profiler.GetNumEvents(), size_t{NumThreads * NumEvents});
+
+    Uint32 NumThreadsWithEvents = 0;
+    Profiler.ProcessEvents([&](Uint32 /*ThreadIdx*/, const std::string& /*ThreadName*/, const std::vector<CPUProfilerEvent>& Events) {
+        EXPECT_EQ(Events.size(), size_t{NumEvents});
+        ++NumThreadsWithEvents;
+    });
+    EXPECT_EQ(NumThreadsWithEvents, NumThreads);
+}
+
+TEST(Common_CPUProfiler, ExitedThreads)
+{
+    CPUProfiler Profiler;
+    Profiler.SetEnabled(true);
+    Profiler.SetRingBufferSize(64);
+
+    constexpr Uint32 NumEvents = 10;
+
+    auto RunThread = [&Profiler]() {
+        std::thread Thread{[&Profiler]() {
+            for (Uint32 i = 0; i < NumEvents; ++i)
+            {
+                ScopedCPUProfilerZone Zone{"Work", "Thread", Profiler};
+            }
+        }};
+        Thread.join();
+    };
+
+    // The events of an exited thread are available until they are released
+    RunThread();
+    EXPECT_EQ(Profiler.GetNumEvents(), size_t{NumEvents});
+
+    // Threads that exited earliest are released when new threads start recording
+    for (Uint32 i = 0; i < 100; ++i)
+        RunThread();
+
+    Uint32 NumThreads = 0;
+    Profiler.ProcessEvents([&](Uint32 /*ThreadIdx*/, const std::string& /*ThreadName*/, const std::vector<CPUProfilerEvent>& Events) {
+        EXPECT_EQ(Events.size(), size_t{NumEvents});
+        ++NumThreads;
+    });
+    // All events of the exited threads fit into a single ring buffer, except for the last thread
+    EXPECT_GE(NumThreads, 64 / NumEvents);
+    EXPECT_LE(NumThreads, 64 / NumEvents + 1);
+
+    Profiler.Clear();
+    NumThreads = 0;
+    Profiler.ProcessEvents([&](Uint32, const std::string&, const std::vector<CPUProfilerEvent>&) { ++NumThreads; });
+    EXPECT_EQ(NumThreads, 0u);
+}
+
+TEST(Common_CPUProfiler, Callbacks)
+{
+    class TestCallbacks final : public CPUProfilerCallbacks
+    {
+    public:
+        virtual void OnZoneBegin(const Char* Name, const Char* /*Category*/) override final
+        {
+            Log += std::string{"+"} + Name;
+        }
+
+        virtual void OnZoneEnd(const Char* Name, const Char* /*Category*/, Uint64 BeginTime, Uint64 EndTime) override final
+        {
+            EXPECT_LE(BeginTime, EndTime);
+            Log += std::string{"-"} + Name;
+        }
+
+        std::string Log;
+    };
+
+    CPUProfiler   Profiler;
+    TestCallbacks Callbacks;
+    Profiler.SetCallbacks(&Callbacks);
+    EXPECT_FALSE(Profiler.IsEnabled());
+    EXPECT_TRUE(Profiler.IsActive());
+
+    {
+        ScopedCPUProfilerZone Outer{"A", nullptr, Profiler};
+        ScopedCPUProfilerZone Inner{"B", nullptr, Profiler};
+    }
+    EXPECT_EQ(Callbacks.Log, "+A+B-B-A");
+    // Callbacks are independent of recording
+    EXPECT_EQ(Profiler.GetNumEvents(), size_t{0});
+
+    Profiler.SetEnabled(true);
+    {
+        ScopedCPUProfilerZone Zone{"C", nullptr, Profiler};
+    }
+    EXPECT_EQ(Callbacks.Log, "+A+B-B-A+C-C");
+    EXPECT_EQ(Profiler.GetNumEvents(), size_t{1});
+
+    Profiler.SetCallbacks(nullptr);
+    {
+        ScopedCPUProfilerZone Zone{"D", nullptr, Profiler};
+    }
+    EXPECT_EQ(Callbacks.Log, "+A+B-B-A+C-C");
+    EXPECT_EQ(Profiler.GetNumEvents(), size_t{2});
+}
+
+TEST(Common_CPUProfiler, Macros)
+{
+    auto& Profiler = CPUProfiler::Get();
+    Profiler.Clear();
+    Profiler.SetEnabled(true);
+    {
+        DILIGENT_PROFILE_SCOPE("MacroZone");
+        DILIGENT_PROFILE_SCOPE_CAT("MacroZoneCat", "Test");
+        DILIGENT_PROFILE_FUNCTION();
+    }
+    Profiler.SetEnabled(false);
+    EXPECT_EQ(Profiler.GetNumEvents(), DILIGENT_CPU_PROFILER_ENABLED ? size_t{3} : size_t{0});
+    Profiler.Clear();
+}
+
+} // namespace
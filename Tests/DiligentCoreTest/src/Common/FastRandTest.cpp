@@ -29,6 +29,9 @@
 
 #include <vector>
 #include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 #include "gtest/gtest.h"
 
@@ -86,4 +89,155 @@ TEST(Common_FastRand, FastRandInt)
     }
 }
 
+TEST(Common_FastRandBatch, Streams)
+{
+    constexpr size_t NumValues = 1027;
+
+    std::vector<Uint32> Values0(NumValues), Values1(NumValues);
+    {
+        FastRandBatch Rnd0{123};
+        FastRandBatch Rnd1{123};
+        Rnd0.GenerateUint(Values0.data(), NumValues);
+        Rnd1.GenerateUint(Values1.data(), NumValues);
+        EXPECT_EQ(Values0, Values1);
+    }
+
+    {
+        FastRandBatch Rnd1{123, 1};
+        Rnd1.GenerateUint(Values1.data(), NumValues);
+        EXPECT_NE(Values0, Values1);
+    }
+
+    {
+        FastRandBatch Rnd1{124};
+        Rnd1.GenerateUint(Values1.data(), NumValues);
+        EXPECT_NE(Values0, Values1);
+    }
+
+    // The expected number of repeated values is about 0.5
+    {
+        FastRandBatch       Rnd{0};
+        std::vector<Uint32> Values(1 << 16);
+        Rnd.GenerateUint(Values.data(), Values.size());
+        std::sort(Values.begin(), Values.end());
+        const auto NumUnique = std::unique(Values.begin(), Values.end()) - Values.begin();
+        EXPECT_GE(NumUnique, static_cast<ptrdiff_t>(Values.size()) - 4);
+    }
+}
+
+TEST(Common_FastRandBatch, Tail)
+{
+    constexpr float Guard = -12345.f;
+    for (size_t Count = 0; Count < 20; ++Count)
+    {
+        FastRandBatch Rnd{Count};
+
+        std::vector<float> Values(Count + 1, Guard);
+        Rnd.GenerateFloat(Values.data(), Count);
+        EXPECT_EQ(Values[Count], Guard);
+        for (size_t i = 0; i < Count; ++i)
+            EXPECT_NE(Values[i], Guard);
+
+        Values.assign(Count + 1, Guard);
+        Rnd.GenerateNormal(Values.data(), Count);
+        EXPECT_EQ(Values[Count], Guard);
+
+        std::vector<int> IntValues(Count + 1, -1);
+        Rnd.GenerateInt(IntValues.data(), Count, 0, 10);
+        EXPECT_EQ(IntValues[Count], -1);
+        for (size_t i = 0; i < Count; ++i)
+            EXPECT_GE(IntValues[i], 0);
+    }
+}
+
+TEST(Common_FastRandBatch, GenerateFloat)
+{
+    constexpr size_t   NumValues = 1 << 20;
+    constexpr size_t   NumBins   = 64;
+    std::vector<float> Values(NumValues);
+    std::vector<int>   Bins(NumBins);
+
+    FastRandBatch Rnd{1};
+    Rnd.GenerateFloat(Values.data(), NumValues, -2.f, 6.f);
+
+    double Sum = 0;
+    for (float x : Values)
+    {
+        ASSERT_GE(x, -2.f);
+        ASSERT_LE(x, 6.f);
+        Sum += x;
+        ++Bins[std::min(static_cast<size_t>((x + 2.f) / 8.f * NumBins), NumBins - 1)];
+    }
+    EXPECT_NEAR(Sum / NumValues, 2.0, 0.02);
+
+    // Expected bin count is 16384 with the standard deviation of about 127
+    for (int Count : Bins)
+        EXPECT_NEAR(Count, static_cast<int>(NumValues / NumBins), 700);
+}
+
+TEST(Common_FastRandBatch, GenerateInt)
+{
+    constexpr int Min = -5;
+    constexpr int Max = 10;
+
+    constexpr size_t NumValues = 1 << 18;
+    std::vector<int> Values(NumValues);
+    std::vector<int> Counter(Max - Min + 1);
+
+    FastRandBatch Rnd{2};
+    Rnd.GenerateInt(Values.data(), NumValues, Min, Max);
+    for (int x : Values)
+    {
+        ASSERT_GE(x, Min);
+        ASSERT_LE(x, Max);
+        ++Counter[x - Min];
+    }
+
+    // Expected count is 16384 with the standard deviation of about 125
+    for (int Count : Counter)
+        EXPECT_NEAR(Count, static_cast<int>(NumValues) / (Max - Min + 1), 700);
+
+    // Full range
+    Rnd.GenerateInt(Values.data(), NumValues, std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    EXPECT_LT(*std::min_element(Values.begin(), Values.end()), std::numeric_limits<int>::min() / 2);
+    EXPECT_GT(*std::max_element(Values.begin(), Values.end()), std::numeric_limits<int>::max() / 2);
+
+    // Single value
+    Rnd.GenerateInt(Values.data(), 16, 7, 7);
+    for (size_t i = 0; i < 16; ++i)
+        EXPECT_EQ(Values[i], 7);
+}
+
+TEST(Common_FastRandBatch, GenerateNormal)
+{
+    constexpr size_t   NumValues = 1 << 20;
+    std::vector<float> Values(NumValues);
+
+    constexpr float Mean   = 3.f;
+    constexpr float StdDev = 2.f;
+
+    FastRandBatch Rnd{3};
+    Rnd.GenerateNormal(Values.data(), NumValues, Mean, StdDev);
+
+    double Sum = 0, SumSq = 0;
+    size_t Within1Sigma = 0, Within2Sigma = 0, Within3Sigma = 0;
+    for (float x : Values)
+    {
+        ASSERT_TRUE(std::isfinite(x));
+        Sum += x;
+        SumSq += double{x} * x;
+        const float d = std::abs(x - Mean) / StdDev;
+        Within1Sigma += d <= 1 ? 1 : 0;
+        Within2Sigma += d <= 2 ? 1 : 0;
+        Within3Sigma += d <= 3 ? 1 : 0;
+    }
+    const double SampleMean     = Sum / NumValues;
+    const double SampleVariance = SumSq / NumValues - SampleMean * SampleMean;
+    EXPECT_NEAR(SampleMean, Mean, 0.01);
+    EXPECT_NEAR(std::sqrt(SampleVariance), StdDev, 0.005);
+    EXPECT_NEAR(static_cast<double>(Within1Sigma) / NumValues, 0.6827, 0.003);
+    EXPECT_NEAR(static_cast<double>(Within2Sigma) / NumValues, 0.9545, 0.002);
+    EXPECT_NEAR(static_cast<double>(Within3Sigma) / NumValues, 0.9973, 0.001);
+}
+
 } // namespace
@@ -27,6 +27,10 @@
 
 #include "FilteringTools.hpp"
 
+#include <vector>
+
+#include "FastRand.hpp"
+
 #include "gtest/gtest.h"
 
 using namespace Diligent;
@@ -292,4 +296,111 @@ TEST(Common_FilteringTools, FilterTexture2DBilinear)
     }
 }
 
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void TestGetLinearTexFilterSampleInfoBatch(Uint32 Width, const std::vector<float>& Coords)
+{
+    std::vector<LinearTexFilterSampleInfo> SampleInfo(Coords.size());
+    GetLinearTexFilterSampleInfo<AddressMode, IsNormalizedCoord>(Width, Coords.data(), Coords.size(), SampleInfo.data());
+    for (size_t i = 0; i < Coords.size(); ++i)
+    {
+        const auto RefSampleInfo = GetLinearTexFilterSampleInfo<AddressMode, IsNormalizedCoord>(Width, Coords[i]);
+        EXPECT_EQ(SampleInfo[i], RefSampleInfo) << "u=" << Coords[i] << " width=" << Width << " normalized=" << IsNormalizedCoord;
+    }
+}
+
+TEST(Common_FilteringTools, GetLinearTexFilterSampleInfoBatch)
+{
+    FastRandFloat Rnd{0, -1000.f, +1000.f};
+
+    for (Uint32 Width : {1u, 3u, 4u, 128u, 1000u})
+    {
+        std::vector<float> Coords = {0.f, -0.5f, -1.f, -128.f, -129.f, -129.5f, -256.f, 0.75f, 1.f, 1.25f, 1.5f, 127.5f, 128.f, 128.5f, 255.f, 256.f, 257.f, 258.f};
+        for (size_t i = 0; i < 1001; ++i)
+            Coords.push_back(Rnd());
+
+        TestGetLinearTexFilterSampleInfoBatch<TEXTURE_ADDRESS_CLAMP, false>(Width, Coords);
+        TestGetLinearTexFilterSampleInfoBatch<TEXTURE_ADDRESS_WRAP, false>(Width, Coords);
+        TestGetLinearTexFilterSampleInfoBatch<TEXTURE_ADDRESS_MIRROR, false>(Width, Coords);
+
+        for (auto& u : Coords)
+            u /= 64.f;
+        TestGetLinearTexFilterSampleInfoBatch<TEXTURE_ADDRESS_CLAMP, true>(Width, Coords);
+        TestGetLinearTexFilterSampleInfoBatch<TEXTURE_ADDRESS_WRAP, true>(Width, Coords);
+        TestGetLinearTexFilterSampleInfoBatch<TEXTURE_ADDRESS_MIRROR, true>(Width, Coords);
+    }
+}
+
+template <typename SrcType, typename DstType, TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void TestFilterTexture2DBilinearBatch(Uint32 Width, Uint32 Height, float MinCoord, float MaxCoord)
+{
+    constexpr size_t Stride = 37;
+    VERIFY_EXPR(Width <= Stride);
+
+    FastRandFloat        Rnd{1, 0.f, 255.f};
+    std::vector<SrcType> Data(Stride * Height);
+    for (auto& Val : Data)
+        Val = static_cast<SrcType>(Rnd());
+
+    // Use the number of samples that is not a multiple of four to test the tail
+    constexpr size_t   NumSamples = 1023;
+    FastRandFloat      RndU{2, MinCoord * static_cast<float>(Width), MaxCoord * static_cast<float>(Width)};
+    FastRandFloat      RndV{3, MinCoord * static_cast<float>(Height), MaxCoord * static_cast<float>(Height)};
+    std::vector<float> U(NumSamples), V(NumSamples);
+    for (size_t i = 0; i < NumSamples; ++i)
+    {
+        U[i] = RndU();
+        V[i] = RndV();
+        if (IsNormalizedCoord)
+        {
+            U[i] /= static_cast<float>(Width);
+            V[i] /= static_cast<float>(Height);
+        }
+    }
+
+    std::vector<DstType> Samples(NumSamples);
+    FilterTexture2DBilinear<SrcType, DstType, AddressMode, AddressMode, IsNormalizedCoord>(Width, Height, Data.data(), Stride, U.data(), V.data(), NumSamples, Samples.data());
+    for (size_t i = 0; i < NumSamples; ++i)
+    {
+        const auto Ref = FilterTexture2DBilinear<SrcType, DstType, AddressMode, AddressMode, IsNormalizedCoord>(Width, Height, Data.data(), Stride, U[i], V[i]);
+        EXPECT_NEAR(Samples[i], Ref, 1e-4) << "u=" << U[i] << " v=" << V[i];
+    }
+}
+
+TEST(Common_FilteringTools, FilterTexture2DBilinearBatch)
+{
+    TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_CLAMP, false>(29, 17, -2.f, 3.f);
+    TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_WRAP, false>(29, 17, -2.f, 3.f);
+    TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_MIRROR, false>(29, 17, -2.f, 3.f);
+    TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_UNKNOWN, false>(29, 17, 0.1f, 0.9f);
+
+    TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_CLAMP, true>(37, 8, -2.f, 3.f);
+    TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_WRAP, true>(37, 8, -2.f, 3.f);
+    TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_MIRROR, true>(37, 8, -2.f, 3.f);
+    TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_UNKNOWN, true>(37, 8, 0.1f, 0.9f);
+
+    TestFilterTexture2DBilinearBatch<Uint8, float, TEXTURE_ADDRESS_WRAP, true>(16, 16, -2.f, 3.f);
+    TestFilterTexture2DBilinearBatch<Uint16, float, TEXTURE_ADDRESS_MIRROR, false>(1, 5, -2.f, 3.f);
+    TestFilterTexture2DBilinearBatch<float, double, TEXTURE_ADDRESS_CLAMP, true>(20, 20, -2.f, 3.f);
+    TestFilterTexture2DBilinearBatch<float, double, TEXTURE_ADDRESS_WRAP, false>(20, 20, -2.f, 3.f);
+
+    {
+        constexpr float Data[] = {1, 2, 3, 4};
+        const float     U[]    = {0.5f, 1.5f, 1.f, 0.25f, 1.f};
+        const float     V[]    = {0.5f, 0.5f, 1.f, 1.75f, 0.f};
+        float           Samples[5];
+        FilterTexture2DBilinearClampUC<float, float>(2, 2, Data, 2, U, V, 5, Samples);
+        EXPECT_EQ(Samples[0], 1.f);
+        EXPECT_EQ(Samples[1], 2.f);
+        EXPECT_EQ(Samples[2], 2.5f);
+        EXPECT_EQ(Samples[3], 3.f);
+        EXPECT_EQ(Samples[4], 1.5f);
+
+        const float UNorm[] = {0.25f, 0.75f, 0.5f, 0.125f, 0.5f};
+        const float VNorm[] = {0.25f, 0.25f, 0.5f, 0.875f, 0.f};
+        FilterTexture2DBilinearClamp<float, float>(2, 2, Data, 2, UNorm, VNorm, 5, Samples);
+        for (size_t i = 0; i < 5; ++i)
+            EXPECT_EQ(Samples[i], (FilterTexture2DBilinearClampUC<float, float>(2, 2, Data, 2, U[i], V[i])));
+    }
+}
+
 } // namespace
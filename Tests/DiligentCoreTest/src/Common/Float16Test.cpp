@@ -0,0 +1,160 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "Float16.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+bool IsFloat16NaN(Uint16 h)
+{
+    return (h & 0x7C00u) == 0x7C00u && (h & 0x03FFu) != 0;
+}
+
+float BitsToFloat(Uint32 x)
+{
+    float f;
+    std::memcpy(&f, &x, sizeof(f));
+    return f;
+}
+
+TEST(Common_Float16, Float32ToFloat16)
+{
+    EXPECT_EQ(Float32ToFloat16(0.f), 0x0000);
+    EXPECT_EQ(Float32ToFloat16(-0.f), 0x8000);
+    EXPECT_EQ(Float32ToFloat16(1.f), 0x3C00);
+    EXPECT_EQ(Float32ToFloat16(-2.f), 0xC000);
+    EXPECT_EQ(Float32ToFloat16(0.5f), 0x3800);
+    EXPECT_EQ(Float32ToFloat16(65504.f), 0x7BFF);
+    EXPECT_EQ(Float32ToFloat16(65519.f), 0x7BFF);
+    EXPECT_EQ(Float32ToFloat16(65520.f), 0x7C00);
+    EXPECT_EQ(Float32ToFloat16(1e10f), 0x7C00);
+    EXPECT_EQ(Float32ToFloat16(-1e10f), 0xFC00);
+    EXPECT_EQ(Float32ToFloat16(std::numeric_limits<float>::infinity()), 0x7C00);
+    EXPECT_EQ(Float32ToFloat16(-std::numeric_limits<float>::infinity()), 0xFC00);
+    EXPECT_TRUE(IsFloat16NaN(Float32ToFloat16(std::numeric_limits<float>::quiet_NaN())));
+
+    // Smallest normal and subnormal values
+    EXPECT_EQ(Float32ToFloat16(6.103515625e-05f), 0x0400);
+    EXPECT_EQ(Float32ToFloat16(5.9604644775390625e-08f), 0x0001);
+    // Half of the smallest subnormal rounds to even (zero), slightly more rounds up
+    EXPECT_EQ(Float32ToFloat16(2.98023223876953125e-08f), 0x0000);
+    EXPECT_EQ(Float32ToFloat16(2.99e-08f), 0x0001);
+
+    // Round to nearest even: 1 + 2^-11 is exactly between 1 and 1 + 2^-10
+    EXPECT_EQ(Float32ToFloat16(1.f + 1.f / 2048.f), 0x3C00);
+    EXPECT_EQ(Float32ToFloat16(1.f + 3.f / 2048.f), 0x3C02);
+}
+
+TEST(Common_Float16, Float16ToFloat32)
+{
+    EXPECT_EQ(Float16ToFloat32(0x0000), 0.f);
+    EXPECT_TRUE(std::signbit(Float16ToFloat32(0x8000)));
+    EXPECT_EQ(Float16ToFloat32(0x3C00), 1.f);
+    EXPECT_EQ(Float16ToFloat32(0xC000), -2.f);
+    EXPECT_EQ(Float16ToFloat32(0x7BFF), 65504.f);
+    EXPECT_EQ(Float16ToFloat32(0x0400), 6.103515625e-05f);
+    EXPECT_EQ(Float16ToFloat32(0x0001), 5.9604644775390625e-08f);
+    EXPECT_EQ(Float16ToFloat32(0x7C00), std::numeric_limits<float>::infinity());
+    EXPECT_EQ(Float16ToFloat32(0xFC00), -std::numeric_limits<float>::infinity());
+    EXPECT_TRUE(std::isnan(Float16ToFloat32(0x7E00)));
+
+    // All finite values must round-trip
+    for (Uint32 h = 0; h <= 0xFFFF; ++h)
+    {
+        if (IsFloat16NaN(static_cast<Uint16>(h)))
+            continue;
+        EXPECT_EQ(Float32ToFloat16(Float16ToFloat32(static_cast<Uint16>(h))), h);
+    }
+}
+
+TEST(Common_Float16, BulkFloat16ToFloat32)
+{
+    // Use the count that is not a multiple of the vector width to test the tail
+    std::vector<Uint16> Src(0x10000 + 5);
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = static_cast<Uint16>(i);
+
+    std::vector<float> Dst(Src.size());
+    Float16ToFloat32(Src.data(), Dst.data(), Src.size());
+    for (size_t i = 0; i < Src.size(); ++i)
+    {
+        const float Ref = Float16ToFloat32(Src[i]);
+        if (std::isnan(Ref))
+        {
+            EXPECT_TRUE(std::isnan(Dst[i])) << "h=" << Src[i];
+        }
+        else
+        {
+            EXPECT_EQ(std::memcmp(&Dst[i], &Ref, sizeof(float)), 0) << "h=" << Src[i] << " ref=" << Ref << " actual=" << Dst[i];
+        }
+    }
+}
+
+TEST(Common_Float16, BulkFloat32ToFloat16)
+{
+    // Sample the entire 32-bit range, including subnormals, specials and rounding boundaries
+    std::vector<float> Src;
+    for (Uint64 x = 0; x <= 0xFFFFFFFFull; x += 4093)
+        Src.push_back(BitsToFloat(static_cast<Uint32>(x)));
+    for (Uint32 h = 0; h < 0x7C00; ++h)
+    {
+        // Values halfway between two adjacent half-precision values
+        const float f0 = Float16ToFloat32(static_cast<Uint16>(h));
+        const float f1 = Float16ToFloat32(static_cast<Uint16>(h + 1));
+        Src.push_back((f0 + f1) * 0.5f);
+        Src.push_back(-(f0 + f1) * 0.5f);
+    }
+    Src.push_back(std::numeric_limits<float>::infinity());
+    Src.push_back(-std::numeric_limits<float>::infinity());
+    Src.push_back(std::numeric_limits<float>::max());
+
+    std::vector<Uint16> Dst(Src.size());
+    Float32ToFloat16(Src.data(), Dst.data(), Src.size());
+    for (size_t i = 0; i < Src.size(); ++i)
+    {
+        const Uint16 Ref = Float32ToFloat16(Src[i]);
+        if (IsFloat16NaN(Ref))
+        {
+            EXPECT_TRUE(IsFloat16NaN(Dst[i])) << "f=" << Src[i];
+        }
+        else
+        {
+            EXPECT_EQ(Dst[i], Ref) << "f=" << Src[i];
+        }
+    }
+}
+
+} // namespace
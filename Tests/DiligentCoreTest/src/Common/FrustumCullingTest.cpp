@@ -0,0 +1,243 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FrustumCulling.hpp"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+ViewFrustumExt MakeTestFrustum(bool IsGL)
+{
+    const auto View     = float4x4::Translation(3, -2, 5) * float4x4::RotationY(0.7f) * float4x4::RotationX(-0.3f);
+    const auto Proj     = float4x4::Projection(PI_F / 3.f, 1.5f, 1.f, 60.f, IsGL);
+    const auto ViewProj = View * Proj;
+
+    ViewFrustumExt Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, IsGL);
+    return Frustum;
+}
+
+struct TestBoundBoxes
+{
+    explicit TestBoundBoxes(size_t NumBoxes)
+    {
+        FastRandFloat Rnd{0, -80.f, 80.f};
+        FastRandFloat RndSize{1, 0.f, 20.f};
+
+        Boxes.resize(NumBoxes);
+        for (auto& v : Coords)
+            v.resize(NumBoxes);
+
+        for (size_t i = 0; i < NumBoxes; ++i)
+        {
+            auto& Box = Boxes[i];
+            Box.Min   = float3{Rnd(), Rnd(), Rnd()};
+            // Make some boxes very large so that they contain the whole frustum
+            const auto Size = (i % 97 == 0) ? 200.f : RndSize();
+            Box.Max         = Box.Min + float3{Size, Size * 0.5f, Size * 2.f};
+            for (Uint32 c = 0; c < 3; ++c)
+            {
+                Coords[c][i]     = Box.Min[c];
+                Coords[3 + c][i] = Box.Max[c];
+            }
+        }
+
+        SOA.MinX = Coords[0].data();
+        SOA.MinY = Coords[1].data();
+        SOA.MinZ = Coords[2].data();
+        SOA.MaxX = Coords[3].data();
+        SOA.MaxY = Coords[4].data();
+        SOA.MaxZ = Coords[5].data();
+    }
+
+    std::vector<BoundBox> Boxes;
+    std::vector<float>    Coords[6];
+    BoundBoxSOA           SOA;
+};
+
+struct TestOrientedBoxes
+{
+    explicit TestOrientedBoxes(size_t NumBoxes)
+    {
+        FastRandFloat Rnd{2, -80.f, 80.f};
+        FastRandFloat RndAngle{3, 0.f, 2.f * PI_F};
+        FastRandFloat RndSize{4, 0.f, 10.f};
+
+        Boxes.resize(NumBoxes);
+        for (auto& v : Data)
+            v.resize(NumBoxes);
+
+        for (size_t i = 0; i < NumBoxes; ++i)
+        {
+            auto& Box  = Boxes[i];
+            Box.Center = float3{Rnd(), Rnd(), Rnd()};
+
+            const auto Rotation = float3x3::RotationX(RndAngle()) * float3x3::RotationY(RndAngle());
+            for (Uint32 a = 0; a < 3; ++a)
+            {
+                Box.Axes[a]        = float3{Rotation[a][0], Rotation[a][1], Rotation[a][2]};
+                Box.HalfExtents[a] = RndSize();
+            }
+
+            for (Uint32 c = 0; c < 3; ++c)
+                Data[c][i] = Box.Center[c];
+            for (Uint32 a = 0; a < 3; ++a)
+            {
+                Data[3 + a][i]  = Box.Axes[a].x;
+                Data[6 + a][i]  = Box.Axes[a].y;
+                Data[9 + a][i]  = Box.Axes[a].z;
+                Data[12 + a][i] = Box.HalfExtents[a];
+            }
+        }
+
+        SOA.CenterX = Data[0].data();
+        SOA.CenterY = Data[1].data();
+        SOA.CenterZ = Data[2].data();
+        for (Uint32 a = 0; a < 3; ++a)
+        {
+            SOA.AxisX[a]       = Data[3 + a].data();
+            SOA.AxisY[a]       = Data[6 + a].data();
+            SOA.AxisZ[a]       = Data[9 + a].data();
+            SOA.HalfExtents[a] = Data[12 + a].data();
+        }
+    }
+
+    std::vector<OrientedBoundingBox> Boxes;
+    std::vector<float>               Data[15];
+    OrientedBoundingBoxSOA           SOA;
+};
+
+template <typename FrustumType, typename BoxType, typename SOAType>
+void TestBatch(const FrustumType&          Frustum,
+               const std::vector<BoxType>& Boxes,
+               const SOAType&              SOA,
+               FRUSTUM_PLANE_FLAGS         PlaneFlags,
+               IThreadPool*                pThreadPool,
+               Uint32                      ChunkSize)
+{
+    const size_t NumBoxes = Boxes.size();
+
+    // Fill the outputs with garbage to make sure that all values are written
+    std::vector<Uint32>        Mask((NumBoxes + 31) / 32, 0xDEADBEEFu);
+    std::vector<BoxVisibility> Visibility(NumBoxes, BoxVisibility::FullyVisible);
+
+    BatchBoxVisibilityAttribs Attribs;
+    Attribs.NumBoxes        = NumBoxes;
+    Attribs.pVisibilityMask = Mask.data();
+    Attribs.pVisibility     = Visibility.data();
+    Attribs.PlaneFlags      = PlaneFlags;
+    Attribs.pThreadPool     = pThreadPool;
+    Attribs.ChunkSize       = ChunkSize;
+
+    const auto NumVisible = GetBoxVisibilityBatch(Frustum, SOA, Attribs);
+
+    size_t RefNumVisible = 0;
+    for (size_t i = 0; i < NumBoxes; ++i)
+    {
+        const auto RefVisibility = GetBoxVisibility(Frustum, Boxes[i], PlaneFlags);
+        EXPECT_EQ(Visibility[i], RefVisibility) << "Box " << i;
+
+        const bool IsVisible = (Mask[i / 32] & (1u << (i % 32))) != 0;
+        EXPECT_EQ(IsVisible, RefVisibility != BoxVisibility::Invisible) << "Box " << i;
+        if (RefVisibility != BoxVisibility::Invisible)
+            ++RefNumVisible;
+    }
+    EXPECT_EQ(NumVisible, RefNumVisible);
+
+    if (NumBoxes % 32 != 0)
+    {
+        EXPECT_EQ(Mask.back() >> (NumBoxes % 32), 0u) << "Unused mask bits must be cleared";
+    }
+
+    // The mask alone
+    std::vector<Uint32> Mask2((NumBoxes + 31) / 32, 0xDEADBEEFu);
+    Attribs.pVisibilityMask = Mask2.data();
+    Attribs.pVisibility     = nullptr;
+    EXPECT_EQ(GetBoxVisibilityBatch(Frustum, SOA, Attribs), NumVisible);
+    EXPECT_EQ(Mask, Mask2);
+}
+
+TEST(Common_FrustumCulling, BoundBoxes)
+{
+    for (size_t NumBoxes : {size_t{1}, size_t{3}, size_t{8}, size_t{33}, size_t{10007}})
+    {
+        const TestBoundBoxes Boxes{NumBoxes};
+        for (bool IsGL : {false, true})
+        {
+            const auto  FrustumExt = MakeTestFrustum(IsGL);
+            const auto& Frustum    = static_cast<const ViewFrustum&>(FrustumExt);
+            for (auto PlaneFlags : {FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR, FRUSTUM_PLANE_FLAG_NONE})
+            {
+                TestBatch(Frustum, Boxes.Boxes, Boxes.SOA, PlaneFlags, nullptr, 8192);
+                TestBatch(FrustumExt, Boxes.Boxes, Boxes.SOA, PlaneFlags, nullptr, 8192);
+            }
+        }
+    }
+}
+
+TEST(Common_FrustumCulling, OrientedBoxes)
+{
+    for (size_t NumBoxes : {size_t{1}, size_t{5}, size_t{64}, size_t{10001}})
+    {
+        const TestOrientedBoxes Boxes{NumBoxes};
+        for (bool IsGL : {false, true})
+        {
+            const auto  FrustumExt = MakeTestFrustum(IsGL);
+            const auto& Frustum    = static_cast<const ViewFrustum&>(FrustumExt);
+            for (auto PlaneFlags : {FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR})
+                TestBatch(Frustum, Boxes.Boxes, Boxes.SOA, PlaneFlags, nullptr, 8192);
+        }
+    }
+}
+
+TEST(Common_FrustumCulling, ThreadPool)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    const auto  FrustumExt = MakeTestFrustum(false);
+    const auto& Frustum    = static_cast<const ViewFrustum&>(FrustumExt);
+
+    const TestBoundBoxes    Boxes{20011};
+    const TestOrientedBoxes OBBs{20011};
+    for (Uint32 ChunkSize : {1u, 64u, 1000u})
+    {
+        TestBatch(Frustum, Boxes.Boxes, Boxes.SOA, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, pThreadPool, ChunkSize);
+        TestBatch(FrustumExt, Boxes.Boxes, Boxes.SOA, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, pThreadPool, ChunkSize);
+        TestBatch(Frustum, OBBs.Boxes, OBBs.SOA, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, pThreadPool, ChunkSize);
+    }
+}
+
+} // namespace
@@ -30,6 +30,7 @@
 
 #include "BasicMath.hpp"
 #include "AdvancedMath.hpp"
+#include "FastRand.hpp"
 
 #include "gtest/gtest.h"
 
@@ -1177,6 +1178,122 @@ TEST(Common_BasicMath, MatrixMultiply)
     }
 }
 
+// Checks the float specializations and SIMD kernels against the generic double-precision implementation
+TEST(Common_BasicMath, MatrixVectorMultiplySIMD)
+{
+    FastRandFloat Rnd{0, -10.f, 10.f};
+
+    auto RandomMatrix = [&Rnd]() {
+        float4x4 m;
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                m[i][j] = Rnd();
+        return m;
+    };
+
+    // All results are sums of four products of values in [-10, 10]
+    constexpr double Tolerance = 1e-4;
+
+    auto ExpectNear = [](const auto& Val, const auto& Ref, size_t NumComponents) {
+        for (size_t i = 0; i < NumComponents; ++i)
+            EXPECT_NEAR(Val.Data()[i], Ref.Data()[i], Tolerance);
+    };
+
+    for (int test = 0; test < 64; ++test)
+    {
+        const float4x4 m1 = RandomMatrix();
+        const float4x4 m2 = RandomMatrix();
+        const float4   v{Rnd(), Rnd(), Rnd(), Rnd()};
+
+        const double4x4 m1d = m1.Recast<double>();
+        const double4x4 m2d = m2.Recast<double>();
+        const double4   vd  = v.Recast<double>();
+
+        ExpectNear(m1 * m2, m1d * m2d, 16);
+        ExpectNear(v * m1, vd * m1d, 4);
+        ExpectNear(m1 * v, m1d * vd, 4);
+
+        {
+            // The kernels are used directly by the CPU algorithms
+            float4x4 m;
+            MathSIMD::MulMatrix4x4(m1.Data(), m2.Data(), m.Data());
+            ExpectNear(m, m1d * m2d, 16);
+
+            float4 r;
+            MathSIMD::MulVector4Matrix4x4(v.Data(), m1.Data(), r.Data());
+            ExpectNear(r, vd * m1d, 4);
+            MathSIMD::MulMatrix4x4Vector4(m1.Data(), v.Data(), r.Data());
+            ExpectNear(r, m1d * vd, 4);
+        }
+
+        {
+            // In-place multiplication
+            float4x4 m = m1;
+            m *= m2;
+            EXPECT_EQ(m, m1 * m2);
+
+            m = m2;
+            m = m1 * m;
+            EXPECT_EQ(m, m1 * m2);
+        }
+
+        {
+            const float3  p{v.x, v.y, v.z};
+            const double3 pd{vd.x, vd.y, vd.z};
+
+            const float3  tp  = p * m1;
+            const double3 tpd = pd * m1d;
+            // Results are divided by w, so use relative tolerance
+            for (int i = 0; i < 3; ++i)
+                EXPECT_NEAR(tp[i], tpd[i], std::max(std::abs(tpd[i]), 1.0) * 1e-4);
+        }
+    }
+
+    // Products of small integers are exact, so the results must match exactly
+    {
+        const float4x4 m1{1, 2, 3, 4,
+                          5, 6, 7, 8,
+                          9, 10, 11, 12,
+                          13, 14, 15, 16};
+        const float4x4 m2 = m1.Transpose();
+        const float4   v{-1, 2, -3, 4};
+
+        EXPECT_EQ(m1 * m2, (m1.Recast<double>() * m2.Recast<double>()).Recast<float>());
+        EXPECT_EQ(v * m1, (v.Recast<double>() * m1.Recast<double>()).Recast<float>());
+        EXPECT_EQ(m1 * v, (m1.Recast<double>() * v.Recast<double>()).Recast<float>());
+    }
+}
+
+TEST(Common_BasicMath, SinCosSIMD)
+{
+    constexpr int    NumSteps  = 1 << 16;
+    constexpr double Tolerance = 1e-6;
+
+    double MaxSinErr = 0, MaxCosErr = 0;
+    for (int i = 0; i <= NumSteps; i += 4)
+    {
+        float Angles[4];
+        for (int j = 0; j < 4; ++j)
+            Angles[j] = static_cast<float>(-PI + 2.0 * PI * std::min(i + j, NumSteps) / NumSteps);
+
+        float Sin[4], Cos[4];
+        {
+            MathSIMD::VecF4 SinF4, CosF4;
+            MathSIMD::SinCosF4(MathSIMD::LoadF4(Angles), SinF4, CosF4);
+            MathSIMD::StoreF4(Sin, SinF4);
+            MathSIMD::StoreF4(Cos, CosF4);
+        }
+
+        for (int j = 0; j < 4; ++j)
+        {
+            MaxSinErr = std::max(MaxSinErr, std::abs(Sin[j] - std::sin(double{Angles[j]})));
+            MaxCosErr = std::max(MaxCosErr, std::abs(Cos[j] - std::cos(double{Angles[j]})));
+        }
+    }
+    EXPECT_LT(MaxSinErr, Tolerance);
+    EXPECT_LT(MaxCosErr, Tolerance);
+}
+
 TEST(Common_BasicMath, VectorRecast)
 {
     EXPECT_EQ(float2(1, 2).Recast<int>(), Vector2<int>(1, 2));
@@ -3260,6 +3377,65 @@ TEST(Common_AdvancedMath, TriangulatePolygon2D)
     }
 }
 
+template <typename ComponentType>
+static void TestTriangulateLargePolygon(Uint32 NumVerts, bool Clockwise, Uint32 Seed)
+{
+    // Star-shaped polygon with alternating long and short spikes of random length
+    FastRandFloat Rnd{Seed, 0.5f, 1.f};
+
+    std::vector<Vector2<ComponentType>> Verts(NumVerts);
+    for (Uint32 i = 0; i < NumVerts; ++i)
+    {
+        const float Angle  = (Clockwise ? -2.f : 2.f) * PI_F * static_cast<float>(i) / static_cast<float>(NumVerts);
+        const float Radius = Rnd() * (i % 2 == 0 ? 10000.f : 3000.f);
+        Verts[i]           = Vector2<ComponentType>{static_cast<ComponentType>(std::cos(Angle) * Radius), static_cast<ComponentType>(std::sin(Angle) * Radius)};
+    }
+
+    auto GetDoubleArea = [&](Uint32 i0, Uint32 i1, Uint32 i2) {
+        const double x0 = static_cast<double>(Verts[i0].x), y0 = static_cast<double>(Verts[i0].y);
+        const double x1 = static_cast<double>(Verts[i1].x), y1 = static_cast<double>(Verts[i1].y);
+        const double x2 = static_cast<double>(Verts[i2].x), y2 = static_cast<double>(Verts[i2].y);
+        return (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0);
+    };
+
+    double PolygonArea = 0;
+    for (Uint32 i = 1; i + 1 < NumVerts; ++i)
+        PolygonArea += GetDoubleArea(0, i, i + 1);
+
+    // Debug verification of convex vertices is quadratic, so only enable it for smaller polygons
+    const auto Tris = TriangulatePolygon<Uint32>(Verts, /*VerifyEarAndConvexVerts = */ NumVerts <= 1000);
+    ASSERT_EQ(Tris.size(), size_t{NumVerts - 2} * 3);
+
+    double TrisArea = 0;
+    for (size_t t = 0; t < Tris.size(); t += 3)
+    {
+        ASSERT_LT(Tris[t + 0], NumVerts);
+        ASSERT_LT(Tris[t + 1], NumVerts);
+        ASSERT_LT(Tris[t + 2], NumVerts);
+
+        // All triangles must have the same winding as the polygon
+        const auto Area = GetDoubleArea(Tris[t + 0], Tris[t + 1], Tris[t + 2]);
+        EXPECT_GE(Area * PolygonArea, 0) << "Triangle " << t / 3;
+        TrisArea += Area;
+    }
+    EXPECT_NEAR(TrisArea, PolygonArea, std::abs(PolygonArea) * 1e-6);
+}
+
+TEST(Common_AdvancedMath, TriangulateLargePolygon2D)
+{
+    for (Uint32 NumVerts : {64u, 1000u, 20000u})
+    {
+        for (bool Clockwise : {false, true})
+        {
+            TestTriangulateLargePolygon<float>(NumVerts, Clockwise, NumVerts);
+            TestTriangulateLargePolygon<double>(NumVerts, Clockwise, NumVerts + 1);
+            // Rounding to integers would make dense polygons self-intersecting
+            if (NumVerts <= 1000)
+                TestTriangulateLargePolygon<int>(NumVerts, Clockwise, NumVerts + 2);
+        }
+    }
+}
+
 TEST(Common_AdvancedMath, TriangulatePolygon3D)
 {
     for (size_t proj = 0; proj < 3; ++proj)
@@ -0,0 +1,185 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <vector>
+
+#include "MemoryFileStream.hpp"
+#include "DataBlobImpl.hpp"
+#include "BasicFileStream.hpp"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
+#include "FastRand.hpp"
+#include "TempDirectory.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+std::vector<Uint8> MakeTestData(size_t Size)
+{
+    std::vector<Uint8> Data(Size);
+
+    FastRandInt rnd{0, 0, 255};
+    for (auto& Byte : Data)
+        Byte = static_cast<Uint8>(rnd());
+    return Data;
+}
+
+TEST(Common_MemoryFileStream, BlobMode)
+{
+    const auto RefData = MakeTestData(1000);
+
+    auto pStream = MemoryFileStream::Create(DataBlobImpl::Create());
+    EXPECT_FALSE(pStream->IsChunked());
+    EXPECT_TRUE(pStream->IsValid());
+    EXPECT_TRUE(pStream->Write(RefData.data(), 300));
+    EXPECT_TRUE(pStream->Write(RefData.data() + 300, RefData.size() - 300));
+    EXPECT_EQ(pStream->GetSize(), RefData.size());
+
+    EXPECT_TRUE(pStream->SetPos(0));
+    std::vector<Uint8> Data(RefData.size());
+    EXPECT_TRUE(pStream->Read(Data.data(), Data.size()));
+    EXPECT_EQ(Data, RefData);
+
+    auto pBlob = pStream->GetDataBlob();
+    ASSERT_EQ(pBlob->GetSize(), RefData.size());
+    EXPECT_EQ(memcmp(pBlob->GetConstDataPtr(), RefData.data(), RefData.size()), 0);
+}
+
+TEST(Common_MemoryFileStream, ChunkedMode)
+{
+    constexpr size_t ChunkSize = 64;
+
+    const auto RefData = MakeTestData(ChunkSize * 10 + 17);
+
+    auto pStream = MemoryFileStream::CreateChunked(ChunkSize);
+    EXPECT_TRUE(pStream->IsChunked());
+    EXPECT_TRUE(pStream->IsValid());
+    EXPECT_EQ(pStream->GetSize(), size_t{0});
+
+    // Write with sizes that do not align with chunk boundaries
+    for (size_t Offset = 0; Offset < RefData.size();)
+    {
+        const auto Size = std::min<size_t>(Offset % 3 == 0 ? 100 : 29, RefData.size() - Offset);
+        EXPECT_TRUE(pStream->Write(RefData.data() + Offset, Size));
+        Offset += Size;
+        EXPECT_EQ(pStream->GetSize(), Offset);
+        EXPECT_EQ(pStream->GetPos(), Offset);
+    }
+
+    // Read back
+    EXPECT_TRUE(pStream->SetPos(0));
+    {
+        std::vector<Uint8> Data(RefData.size());
+        EXPECT_TRUE(pStream->Read(Data.data(), 10));
+        EXPECT_TRUE(pStream->Read(Data.data() + 10, Data.size() - 10));
+        EXPECT_EQ(Data, RefData);
+
+        Uint8 Byte = 0;
+        EXPECT_FALSE(pStream->Read(&Byte, 1));
+    }
+
+    // Overwrite across a chunk boundary
+    auto RefData2 = RefData;
+    {
+        const Uint8 Patch[] = {1, 2, 3, 4, 5, 6, 7, 8};
+        EXPECT_TRUE(pStream->SetPos(ChunkSize - 4));
+        EXPECT_TRUE(pStream->Write(Patch, sizeof(Patch)));
+        memcpy(&RefData2[ChunkSize - 4], Patch, sizeof(Patch));
+        EXPECT_EQ(pStream->GetSize(), RefData.size());
+    }
+
+    EXPECT_FALSE(pStream->SetPos(RefData.size() + 1));
+    EXPECT_TRUE(pStream->SetPos(100));
+    {
+        auto pBlob = DataBlobImpl::Create();
+        pStream->ReadBlob(pBlob);
+        ASSERT_EQ(pBlob->GetSize(), RefData2.size() - 100);
+        EXPECT_EQ(memcmp(pBlob->GetConstDataPtr(), &RefData2[100], pBlob->GetSize()), 0);
+    }
+
+    // Write to another stream without flattening
+    {
+        auto pDstStream = MemoryFileStream::Create(DataBlobImpl::Create());
+        EXPECT_TRUE(pStream->WriteTo(pDstStream));
+        EXPECT_TRUE(pStream->IsChunked());
+
+        auto pBlob = pDstStream->GetDataBlob();
+        ASSERT_EQ(pBlob->GetSize(), RefData2.size());
+        EXPECT_EQ(memcmp(pBlob->GetConstDataPtr(), RefData2.data(), RefData2.size()), 0);
+    }
+
+    // Flatten
+    {
+        auto pBlob = pStream->GetDataBlob();
+        EXPECT_FALSE(pStream->IsChunked());
+        ASSERT_EQ(pBlob->GetSize(), RefData2.size());
+        EXPECT_EQ(memcmp(pBlob->GetConstDataPtr(), RefData2.data(), RefData2.size()), 0);
+
+        // The stream remains usable in blob mode
+        EXPECT_EQ(pStream->GetSize(), RefData2.size());
+        EXPECT_TRUE(pStream->SetPos(pStream->GetSize()));
+        EXPECT_TRUE(pStream->Write(RefData.data(), 5));
+        EXPECT_EQ(pStream->GetSize(), RefData2.size() + 5);
+    }
+}
+
+TEST(Common_MemoryFileStream, WriteToFile)
+{
+    TempDirectory TmpDir;
+    const auto    FilePath = TmpDir.Get() + FileSystem::SlashSymbol + "MemoryFileStream.bin";
+
+    const auto RefData = MakeTestData(5000);
+
+    auto pStream = MemoryFileStream::CreateChunked(1024);
+    EXPECT_TRUE(pStream->Write(RefData.data(), RefData.size()));
+    EXPECT_TRUE(pStream->WriteToFile(FilePath.c_str()));
+    EXPECT_TRUE(pStream->IsChunked());
+
+    std::vector<Uint8> Data;
+    EXPECT_TRUE(FileWrapper::ReadWholeFile(FilePath.c_str(), Data));
+    EXPECT_EQ(Data, RefData);
+}
+
+TEST(Common_MemoryFileStream, EmptyChunkedStream)
+{
+    auto pStream = MemoryFileStream::CreateChunked();
+
+    auto pDstStream = MemoryFileStream::Create(DataBlobImpl::Create());
+    EXPECT_TRUE(pStream->WriteTo(pDstStream));
+    EXPECT_EQ(pDstStream->GetSize(), size_t{0});
+
+    auto pBlob = pStream->GetDataBlob();
+    ASSERT_NE(pBlob, nullptr);
+    EXPECT_EQ(pBlob->GetSize(), size_t{0});
+}
+
+} // namespace
@@ -0,0 +1,304 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "OcclusionCulling.hpp"
+
+#include <vector>
+
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Two triangles forming a quad in the z = Z plane, front-facing for a camera looking along +Z
+std::vector<float3> CreateQuad(float MinX, float MinY, float MaxX, float MaxY, float Z)
+{
+    return {
+        float3{MinX, MinY, Z},
+        float3{MinX, MaxY, Z},
+        float3{MaxX, MaxY, Z},
+        float3{MinX, MinY, Z},
+        float3{MaxX, MaxY, Z},
+        float3{MaxX, MinY, Z},
+    };
+}
+
+void RasterizeVertices(SoftwareOcclusionBuffer& Buffer, const std::vector<float3>& Verts, const float4x4& WorldViewProj, bool CullBackFaces = true)
+{
+    OccluderMeshAttribs Attribs;
+    Attribs.pVertices     = Verts.data();
+    Attribs.NumVertices   = static_cast<Uint32>(Verts.size());
+    Attribs.NumTriangles  = static_cast<Uint32>(Verts.size() / 3);
+    Attribs.WorldViewProj = WorldViewProj;
+    Attribs.CullBackFaces = CullBackFaces;
+    Buffer.RasterizeOccluder(Attribs);
+}
+
+std::vector<float> ReadDepth(const SoftwareOcclusionBuffer& Buffer)
+{
+    std::vector<float> Depth(size_t{Buffer.GetWidth()} * Buffer.GetHeight());
+    Buffer.ReadDepth(Depth.data());
+    return Depth;
+}
+
+TEST(Common_OcclusionCulling, Clear)
+{
+    SoftwareOcclusionBuffer Buffer{37, 21};
+    for (float d : ReadDepth(Buffer))
+        EXPECT_EQ(d, 1.f);
+
+    const auto Proj = float4x4::Projection(PI_F / 4.f, 1.f, 1.f, 100.f, false);
+    EXPECT_TRUE(Buffer.IsBoxVisible(Proj, BoundBox{float3{-1, -1, 50}, float3{1, 1, 51}}));
+    // Outside of the screen
+    EXPECT_FALSE(Buffer.IsBoxVisible(Proj, BoundBox{float3{100, -1, 10}, float3{101, 1, 11}}));
+    // Behind the camera
+    EXPECT_FALSE(Buffer.IsBoxVisible(Proj, BoundBox{float3{-1, -1, -10}, float3{1, 1, -5}}));
+    // Intersects the near plane
+    EXPECT_TRUE(Buffer.IsBoxVisible(Proj, BoundBox{float3{-1, -1, -10}, float3{1, 1, 10}}));
+}
+
+// Compares coverage with RasterizeTriangle() that enumerates the samples inside the triangle
+TEST(Common_OcclusionCulling, Coverage)
+{
+    constexpr Uint32 Width  = 64;
+    constexpr Uint32 Height = 32;
+
+    auto ScreenToNDC = [&](const float2& Pos) {
+        return float3{Pos.x / Width * 2.f - 1.f, 1.f - Pos.y / Height * 2.f, 0.5f};
+    };
+
+    FastRandFloat Rnd{0, -8.f, Width + 8.f};
+    for (Uint32 test = 0; test < 100; ++test)
+    {
+        float2 Verts[3];
+        for (auto& Vert : Verts)
+        {
+            // Avoid pixel centers exactly on the edges
+            Vert.x = std::floor(Rnd()) + 0.25f;
+            Vert.y = std::floor(Rnd() * Height / Width) + 0.125f;
+        }
+        // RasterizeTriangle conservatively enumerates all samples in the bounding box
+        // when the triangle covers a single row.
+        if (std::ceil(std::min(std::min(Verts[0].y, Verts[1].y), Verts[2].y) - 0.5f) ==
+            std::floor(std::max(std::max(Verts[0].y, Verts[1].y), Verts[2].y) - 0.5f))
+            continue;
+
+        SoftwareOcclusionBuffer Buffer{Width, Height};
+        RasterizeVertices(Buffer, {ScreenToNDC(Verts[0]), ScreenToNDC(Verts[1]), ScreenToNDC(Verts[2])}, float4x4::Identity(), /*CullBackFaces = */ false);
+
+        std::vector<bool> RefCoverage(Width * Height);
+        // RasterizeTriangle enumerates integer samples, so shift pixel centers to integer coordinates
+        RasterizeTriangle(Verts[0] - float2{0.5f, 0.5f}, Verts[1] - float2{0.5f, 0.5f}, Verts[2] - float2{0.5f, 0.5f},
+                          [&](const int2& Sample) {
+                              if (Sample.x >= 0 && Sample.x < static_cast<int>(Width) && Sample.y >= 0 && Sample.y < static_cast<int>(Height))
+                                  RefCoverage[Sample.x + Sample.y * Width] = true;
+                          });
+
+        const auto Depth = ReadDepth(Buffer);
+        for (Uint32 i = 0; i < Width * Height; ++i)
+        {
+            EXPECT_EQ(Depth[i] < 1.f, RefCoverage[i]) << "Test " << test << ", pixel " << i % Width << ", " << i / Width;
+            if (RefCoverage[i])
+            {
+                EXPECT_NEAR(Depth[i], 0.5f, 1e-6f);
+            }
+        }
+    }
+}
+
+TEST(Common_OcclusionCulling, DepthInterpolation)
+{
+    SoftwareOcclusionBuffer Buffer{32, 32};
+    // Quad that covers the whole screen with depth increasing from 0.25 on the left to 0.75 on the right
+    const std::vector<float3> Verts = {
+        float3{-1, -1, 0.25f},
+        float3{-1, +1, 0.25f},
+        float3{+1, +1, 0.75f},
+        float3{-1, -1, 0.25f},
+        float3{+1, +1, 0.75f},
+        float3{+1, -1, 0.75f},
+    };
+    RasterizeVertices(Buffer, Verts, float4x4::Identity());
+
+    const auto Depth = ReadDepth(Buffer);
+    for (Uint32 y = 0; y < 32; ++y)
+    {
+        for (Uint32 x = 0; x < 32; ++x)
+            EXPECT_NEAR(Depth[x + y * 32], 0.25f + 0.5f * (x + 0.5f) / 32.f, 1e-5f);
+    }
+}
+
+void TestOccludedBoxes(Uint32 Width, Uint32 Height, bool NegativeOneToOneZ)
+{
+    SoftwareOcclusionBuffer Buffer{Width, Height, NegativeOneToOneZ};
+
+    const auto Proj = float4x4::Projection(PI_F / 4.f, static_cast<float>(Width) / static_cast<float>(Height), 1.f, 100.f, NegativeOneToOneZ);
+    RasterizeVertices(Buffer, CreateQuad(-5, -5, 5, 5, 10), Proj);
+
+    // Behind the occluder
+    EXPECT_FALSE(Buffer.IsBoxVisible(Proj, BoundBox{float3{-1, -1, 20}, float3{1, 1, 22}}));
+    EXPECT_FALSE(Buffer.IsBoxVisible(Proj, BoundBox{float3{-9, -9, 30}, float3{9, 9, 32}}));
+    // In front of the occluder
+    EXPECT_TRUE(Buffer.IsBoxVisible(Proj, BoundBox{float3{-1, -1, 5}, float3{1, 1, 6}}));
+    // Intersects the occluder
+    EXPECT_TRUE(Buffer.IsBoxVisible(Proj, BoundBox{float3{-1, -1, 9}, float3{1, 1, 11}}));
+    // Behind the occluder, but extends past its edge
+    EXPECT_TRUE(Buffer.IsBoxVisible(Proj, BoundBox{float3{-1, -1, 20}, float3{11, 1, 22}}));
+
+    // Box that becomes visible when the camera moves to the side
+    const auto View = float4x4::Translation(-20, 0, 0);
+    EXPECT_FALSE(Buffer.IsBoxVisible(Proj, BoundBox{float3{-1, -1, 20}, float3{1, 1, 22}}));
+    Buffer.Clear();
+    RasterizeVertices(Buffer, CreateQuad(-5, -5, 5, 5, 10), View * Proj);
+    EXPECT_TRUE(Buffer.IsBoxVisible(View * Proj, BoundBox{float3{19, -1, 20}, float3{21, 1, 22}}));
+}
+
+TEST(Common_OcclusionCulling, OccludedBoxes)
+{
+    TestOccludedBoxes(128, 64, false);
+    TestOccludedBoxes(128, 64, true);
+    // Dimensions that are not multiples of the tile size
+    TestOccludedBoxes(61, 37, false);
+}
+
+TEST(Common_OcclusionCulling, BackfaceCulling)
+{
+    const auto     Proj = float4x4::Projection(PI_F / 4.f, 1.f, 1.f, 100.f, false);
+    const BoundBox Box{float3{-1, -1, 20}, float3{1, 1, 22}};
+
+    auto Quad = CreateQuad(-5, -5, 5, 5, 10);
+    {
+        SoftwareOcclusionBuffer Buffer{64, 64};
+        RasterizeVertices(Buffer, Quad, Proj);
+        EXPECT_FALSE(Buffer.IsBoxVisible(Proj, Box));
+    }
+
+    // Reverse the winding
+    for (size_t i = 0; i < Quad.size(); i += 3)
+        std::swap(Quad[i + 1], Quad[i + 2]);
+    {
+        SoftwareOcclusionBuffer Buffer{64, 64};
+        RasterizeVertices(Buffer, Quad, Proj);
+        EXPECT_TRUE(Buffer.IsBoxVisible(Proj, Box));
+
+        RasterizeVertices(Buffer, Quad, Proj, /*CullBackFaces = */ false);
+        EXPECT_FALSE(Buffer.IsBoxVisible(Proj, Box));
+    }
+    {
+        SoftwareOcclusionBuffer Buffer{64, 64};
+
+        OccluderMeshAttribs Attribs;
+        Attribs.pVertices             = Quad.data();
+        Attribs.NumVertices           = static_cast<Uint32>(Quad.size());
+        Attribs.NumTriangles          = 2;
+        Attribs.WorldViewProj         = Proj;
+        Attribs.FrontCounterClockwise = true;
+        Buffer.RasterizeOccluder(Attribs);
+        EXPECT_FALSE(Buffer.IsBoxVisible(Proj, Box));
+    }
+}
+
+TEST(Common_OcclusionCulling, NearPlaneClipping)
+{
+    SoftwareOcclusionBuffer Buffer{64, 64};
+
+    // Camera is 2 units above the floor, looking along the +Z axis.
+    const auto Proj = float4x4::Projection(PI_F / 4.f, 1.f, 1.f, 100.f, false);
+    const auto View = float4x4::Translation(0, -2, 0);
+
+    // Wall that starts behind the camera and extends far to the left, right and forward
+    const std::vector<float3> Wall = {
+        float3{-1000, -10, -50},
+        float3{-1000, +10, -50},
+        float3{-1000, +10, +500},
+        float3{-1000, -10, -50},
+        float3{-1000, +10, +500},
+        float3{-1000, -10, +500},
+    };
+    // Floor that passes under the camera
+    const std::vector<float3> Floor = {
+        float3{-1000, 0, -1000},
+        float3{-1000, 0, +1000},
+        float3{+1000, 0, +1000},
+        float3{-1000, 0, -1000},
+        float3{+1000, 0, +1000},
+        float3{+1000, 0, -1000},
+    };
+    RasterizeVertices(Buffer, Wall, View * Proj, /*CullBackFaces = */ false);
+    RasterizeVertices(Buffer, Floor, View * Proj);
+
+    // Under the floor
+    EXPECT_FALSE(Buffer.IsBoxVisible(View * Proj, BoundBox{float3{-1, -5, 10}, float3{1, -3, 12}}));
+    // Above the floor
+    EXPECT_TRUE(Buffer.IsBoxVisible(View * Proj, BoundBox{float3{-1, 1, 10}, float3{1, 3, 12}}));
+}
+
+TEST(Common_OcclusionCulling, TestBoxes)
+{
+    const auto Proj = float4x4::Projection(PI_F / 4.f, 1.f, 1.f, 100.f, false);
+
+    SoftwareOcclusionBuffer Buffer{64, 64};
+    RasterizeVertices(Buffer, CreateQuad(-2, -2, 2, 2, 10), Proj);
+
+    // Row of boxes behind the occluder: only the ones outside of its shadow are visible
+    constexpr size_t   NumBoxes = 40;
+    std::vector<float> MinX, MinY, MinZ, MaxX, MaxY, MaxZ;
+    for (size_t i = 0; i < NumBoxes; ++i)
+    {
+        const float x = (static_cast<float>(i) - NumBoxes / 2.f) * 2.f;
+        MinX.push_back(x);
+        MaxX.push_back(x + 1.f);
+        MinY.push_back(-0.5f);
+        MaxY.push_back(0.5f);
+        MinZ.push_back(20.f);
+        MaxZ.push_back(21.f);
+    }
+    const BoundBoxSOA Boxes{MinX.data(), MinY.data(), MinZ.data(), MaxX.data(), MaxY.data(), MaxZ.data()};
+
+    // Box 3 is not tested
+    Uint32 Mask[2] = {~(1u << 3), 0xFFu};
+
+    const auto NumVisible = Buffer.TestBoxes(Proj, Boxes, NumBoxes, Mask);
+
+    size_t RefNumVisible = 0;
+    for (size_t i = 0; i < NumBoxes; ++i)
+    {
+        const bool IsVisible = i != 3 && Buffer.IsBoxVisible(Proj, BoundBox{float3{MinX[i], MinY[i], MinZ[i]}, float3{MaxX[i], MaxY[i], MaxZ[i]}});
+        EXPECT_EQ((Mask[i / 32] & (1u << (i % 32))) != 0, IsVisible) << i;
+        if (IsVisible)
+            ++RefNumVisible;
+    }
+    EXPECT_EQ(NumVisible, RefNumVisible);
+    EXPECT_GT(NumVisible, size_t{0});
+    EXPECT_LT(NumVisible, NumBoxes - 1);
+    EXPECT_EQ(Mask[1] & ~0xFFu, 0u);
+}
+
+} // namespace
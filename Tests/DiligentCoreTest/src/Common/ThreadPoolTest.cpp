@@ -30,6 +30,7 @@
 
 #include <array>
 #include <cmath>
+#include <vector>
 
 #include "ThreadSignal.hpp"
 
@@ -356,4 +357,36 @@ TEST(Common_ThreadPool, Priorities)
     }
 }
 
+TEST(Common_ThreadPool, ParallelFor)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    for (Uint32 NumChunks : {0u, 1u, 2u, 7u, 100u, 1000u})
+    {
+        std::vector<std::atomic<Uint32>> Counters(NumChunks);
+        for (auto& Counter : Counters)
+            Counter.store(0);
+
+        ParallelFor(pThreadPool, NumChunks, [&Counters](Uint32 Chunk) {
+            Counters[Chunk].fetch_add(1);
+        });
+
+        for (Uint32 i = 0; i < NumChunks; ++i)
+            EXPECT_EQ(Counters[i].load(), 1u) << "Chunk " << i << " of " << NumChunks;
+    }
+
+    // Without the thread pool
+    {
+        std::vector<Uint32> Counters(16);
+        ParallelFor(nullptr, static_cast<Uint32>(Counters.size()), [&Counters](Uint32 Chunk) {
+            ++Counters[Chunk];
+        });
+        for (auto Count : Counters)
+            EXPECT_EQ(Count, 1u);
+    }
+
+    pThreadPool->WaitForAllTasks();
+}
+
 } // namespace
@@ -0,0 +1,189 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ColorConversion.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Values in [-0.25, 1.25] and some special values
+std::vector<float> GenerateFloats()
+{
+    std::vector<float> Values;
+    for (int i = -25000; i <= 125000; ++i)
+        Values.push_back(static_cast<float>(i) / 100000.f);
+    Values.push_back(std::numeric_limits<float>::quiet_NaN());
+    Values.push_back(std::numeric_limits<float>::infinity());
+    Values.push_back(-std::numeric_limits<float>::infinity());
+    Values.push_back(10.f);
+    return Values;
+}
+
+TEST(ColorConversionTest, GammaToLinear8)
+{
+    std::vector<Uint8> Gamma(256);
+    for (Uint32 i = 0; i < Gamma.size(); ++i)
+        Gamma[i] = static_cast<Uint8>(i);
+
+    std::vector<float> Linear(Gamma.size());
+    GammaToLinear(Gamma.data(), Linear.data(), Gamma.size());
+    for (Uint32 i = 0; i < Gamma.size(); ++i)
+        EXPECT_EQ(Linear[i], GammaToLinear(static_cast<float>(i) / 255.f)) << i;
+}
+
+TEST(ColorConversionTest, LinearToGamma8)
+{
+    // Every code is restored exactly
+    {
+        std::vector<float> Linear(256);
+        for (Uint32 i = 0; i < Linear.size(); ++i)
+            Linear[i] = GammaToLinear(static_cast<Uint8>(i));
+
+        std::vector<Uint8> Gamma(Linear.size());
+        LinearToGamma(Linear.data(), Gamma.data(), Linear.size());
+        for (Uint32 i = 0; i < Gamma.size(); ++i)
+            EXPECT_EQ(Gamma[i], i);
+    }
+
+    const std::vector<float> Linear = GenerateFloats();
+
+    // Odd count to test the tail
+    std::vector<Uint8> Gamma(Linear.size() - 1);
+    LinearToGamma(Linear.data(), Gamma.data(), Gamma.size());
+    for (size_t i = 0; i < Gamma.size(); ++i)
+    {
+        const float x = Linear[i];
+        if (std::isnan(x) || x <= 0)
+        {
+            EXPECT_EQ(Gamma[i], 0) << x;
+        }
+        else if (x >= 1)
+        {
+            EXPECT_EQ(Gamma[i], 255) << x;
+        }
+        else
+        {
+            EXPECT_NEAR(Gamma[i], LinearToGamma(x) * 255.f, 0.501f) << x;
+        }
+    }
+
+    const Uint8 Last = Gamma.back();
+    LinearToGamma(&Linear[Gamma.size() - 1], &Gamma.back(), 1);
+    EXPECT_EQ(Last, Gamma.back());
+}
+
+TEST(ColorConversionTest, GammaToLinearFloat)
+{
+    const std::vector<float> Gamma = GenerateFloats();
+
+    std::vector<float> Linear(Gamma.size() - 1);
+    GammaToLinear(Gamma.data(), Linear.data(), Linear.size());
+    for (size_t i = 0; i < Linear.size(); ++i)
+    {
+        const float x   = Gamma[i];
+        const float Ref = GammaToLinear(x);
+        if (x >= 0 && x <= 1)
+        {
+            EXPECT_NEAR(Linear[i], Ref, Ref * 1e-5f) << x;
+        }
+        else if (std::isnan(x))
+        {
+            EXPECT_TRUE(std::isnan(Linear[i]));
+        }
+        else
+        {
+            EXPECT_EQ(Linear[i], Ref) << x;
+        }
+    }
+}
+
+TEST(ColorConversionTest, LinearToGammaFloat)
+{
+    const std::vector<float> Linear = GenerateFloats();
+
+    std::vector<float> Gamma(Linear.size() - 1);
+    LinearToGamma(Linear.data(), Gamma.data(), Gamma.size());
+    for (size_t i = 0; i < Gamma.size(); ++i)
+    {
+        const float x   = Linear[i];
+        const float Ref = LinearToGamma(x);
+        if (x >= 0 && x <= 1)
+            EXPECT_NEAR(Gamma[i], Ref, 1e-5f) << x;
+        else if (std::isnan(x))
+            EXPECT_TRUE(std::isnan(Gamma[i]));
+        else
+            EXPECT_EQ(Gamma[i], Ref) << x;
+    }
+}
+
+TEST(ColorConversionTest, RGBA8)
+{
+    constexpr size_t NumTexels = 1023;
+
+    FastRandInt        Rnd{0, 0, 255};
+    std::vector<Uint8> SRGBA(NumTexels * 4);
+    for (Uint8& Val : SRGBA)
+        Val = static_cast<Uint8>(Rnd());
+
+    std::vector<float> Linear(NumTexels * 4);
+    SRGBA8ToLinear(SRGBA.data(), Linear.data(), NumTexels);
+    for (size_t i = 0; i < SRGBA.size(); ++i)
+    {
+        if (i % 4 < 3)
+            EXPECT_EQ(Linear[i], GammaToLinear(SRGBA[i]));
+        else
+            EXPECT_EQ(Linear[i], static_cast<float>(SRGBA[i]) / 255.f);
+    }
+
+    std::vector<Uint8> RoundTrip(SRGBA.size());
+    LinearToSRGBA8(Linear.data(), RoundTrip.data(), NumTexels);
+    EXPECT_EQ(SRGBA, RoundTrip);
+
+    // Alpha is not gamma-encoded and is clamped
+    const float Texels[] = {0.5f, 0.5f, 0.5f, 0.5f, -1.f, 2.f, std::numeric_limits<float>::quiet_NaN(), 2.f};
+    Uint8       Encoded[8];
+    LinearToSRGBA8(Texels, Encoded, 2);
+    EXPECT_EQ(Encoded[0], 188);
+    EXPECT_EQ(Encoded[1], 188);
+    EXPECT_EQ(Encoded[2], 188);
+    EXPECT_EQ(Encoded[3], 128);
+    EXPECT_EQ(Encoded[4], 0);
+    EXPECT_EQ(Encoded[5], 255);
+    EXPECT_EQ(Encoded[6], 0);
+    EXPECT_EQ(Encoded[7], 255);
+}
+
+} // namespace
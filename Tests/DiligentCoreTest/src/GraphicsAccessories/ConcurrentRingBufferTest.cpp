@@ -0,0 +1,221 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ConcurrentRingBuffer.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, AllocDealloc)
+{
+    // Need to define local variable to avoid vexing linker errors
+    const auto InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
+    using OffsetType         = ConcurrentRingBuffer::OffsetType;
+
+    ConcurrentRingBuffer RB{1024, DefaultRawMemoryAllocator::GetAllocator()};
+    EXPECT_TRUE(RB.IsEmpty());
+    EXPECT_EQ(RB.GetMaxSize(), OffsetType{1024});
+
+    EXPECT_EQ(RB.Allocate(120, 16), OffsetType{0});
+    EXPECT_EQ(RB.Allocate(10, 1), OffsetType{128});
+    EXPECT_EQ(RB.Allocate(10, 32), OffsetType{160});
+    EXPECT_EQ(RB.Allocate(17, 1), OffsetType{192});
+    EXPECT_EQ(RB.Allocate(65, 64), OffsetType{256});
+    //
+    //  t                                    h
+    //  |                                    |            |
+    //  0         128 138 160 192 209  256  384         1024
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{384});
+    RB.FinishCurrentFrame(1);
+
+    EXPECT_EQ(RB.Allocate(100, 256), OffsetType{512});
+    EXPECT_EQ(RB.Allocate(128, 1), OffsetType{768});
+    EXPECT_EQ(RB.Allocate(129, 1), InvalidOffset);
+    EXPECT_EQ(RB.Allocate(128, 1), OffsetType{896});
+    EXPECT_TRUE(RB.IsFull());
+    EXPECT_EQ(RB.Allocate(1, 1), InvalidOffset);
+    RB.FinishCurrentFrame(2);
+    // Zero-size frames are ignored
+    RB.FinishCurrentFrame(3);
+
+    RB.ReleaseCompletedFrames(1);
+    //
+    //             t                                      h
+    //  |          |                                      |
+    //  0         384                                   1024
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{1024 - 384});
+
+    // The allocation wraps around to the beginning of the buffer
+    EXPECT_EQ(RB.Allocate(256, 1), OffsetType{0});
+    EXPECT_EQ(RB.Allocate(129, 1), InvalidOffset);
+    EXPECT_EQ(RB.Allocate(128, 1), OffsetType{256});
+    EXPECT_TRUE(RB.IsFull());
+    RB.FinishCurrentFrame(4);
+
+    RB.ReleaseCompletedFrames(3);
+    //
+    //           h   t
+    //  |        |   |                                    |
+    //  0       384 384                                 1024
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{384});
+
+    // The space at the end of the buffer is skipped when the allocation does not fit
+    EXPECT_EQ(RB.Allocate(512, 1), OffsetType{384});
+    EXPECT_EQ(RB.Allocate(256, 1), InvalidOffset);
+    EXPECT_EQ(RB.Allocate(128, 1), OffsetType{896});
+    RB.FinishCurrentFrame(5);
+
+    RB.ReleaseCompletedFrames(4);
+    EXPECT_EQ(RB.Allocate(256, 1), OffsetType{0});
+    RB.FinishCurrentFrame(6);
+
+    RB.ReleaseCompletedFrames(6);
+    EXPECT_TRUE(RB.IsEmpty());
+}
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, Concurrent)
+{
+    const auto InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
+    using OffsetType         = ConcurrentRingBuffer::OffsetType;
+
+    constexpr size_t     BufferSize      = 1 << 16;
+    constexpr Uint32     NumFrames       = 64;
+    constexpr Uint64     FramesInFlight  = 2;
+    constexpr size_t     NumThreads      = 4;
+    constexpr OffsetType MaxAllocSize    = 64;
+    constexpr Uint32     AllocsPerThread = BufferSize / (FramesInFlight + 1) / NumThreads / (MaxAllocSize * 2);
+
+    ConcurrentRingBuffer RB{BufferSize, DefaultRawMemoryAllocator::GetAllocator()};
+
+    struct AllocInfo
+    {
+        OffsetType Offset;
+        OffsetType Size;
+    };
+    // Live allocations of every frame
+    std::vector<std::vector<AllocInfo>> FrameAllocs(NumFrames);
+    for (Uint32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        std::vector<std::vector<AllocInfo>> ThreadAllocs(NumThreads);
+        std::vector<std::thread>            Threads;
+        for (size_t t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back(
+                [&RB, InvalidOffset, &Allocs = ThreadAllocs[t], Seed = Frame * NumThreads + t]() {
+                    for (Uint32 i = 0; i < AllocsPerThread; ++i)
+                    {
+                        const OffsetType Size      = 1 + (Seed * 31 + i * 17) % MaxAllocSize;
+                        const OffsetType Alignment = OffsetType{1} << ((Seed + i) % 6);
+
+                        const auto Offset = RB.Allocate(Size, Alignment);
+                        EXPECT_NE(Offset, InvalidOffset);
+                        if (Offset == InvalidOffset)
+                            continue;
+                        EXPECT_EQ(Offset % Alignment, OffsetType{0});
+                        EXPECT_LE(Offset + Size, RB.GetMaxSize());
+                        Allocs.push_back({Offset, Size});
+                    }
+                });
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        for (const auto& Allocs : ThreadAllocs)
+            FrameAllocs[Frame].insert(FrameAllocs[Frame].end(), Allocs.begin(), Allocs.end());
+        RB.FinishCurrentFrame(Frame + 1);
+
+        // Check that allocations of all frames that are still in flight do not overlap
+        std::vector<AllocInfo> Live;
+        for (Uint32 f = Frame >= FramesInFlight ? Frame - static_cast<Uint32>(FramesInFlight) : 0; f <= Frame; ++f)
+            Live.insert(Live.end(), FrameAllocs[f].begin(), FrameAllocs[f].end());
+        std::sort(Live.begin(), Live.end(), [](const AllocInfo& lhs, const AllocInfo& rhs) { return lhs.Offset < rhs.Offset; });
+        for (size_t i = 1; i < Live.size(); ++i)
+        {
+            ASSERT_LE(Live[i - 1].Offset + Live[i - 1].Size, Live[i].Offset) << "Frame " << Frame;
+        }
+
+        if (Frame >= FramesInFlight)
+            RB.ReleaseCompletedFrames(Frame + 1 - FramesInFlight);
+    }
+
+    RB.ReleaseCompletedFrames(NumFrames);
+    EXPECT_TRUE(RB.IsEmpty());
+}
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, ReleaseWhileAllocating)
+{
+    using OffsetType = ConcurrentRingBuffer::OffsetType;
+
+    constexpr size_t NumThreads = 4;
+    constexpr Uint32 NumAllocs  = 10000;
+
+    ConcurrentRingBuffer RB{4096, DefaultRawMemoryAllocator::GetAllocator()};
+
+    std::atomic<Uint32>      NumRunning{static_cast<Uint32>(NumThreads)};
+    std::vector<std::thread> Threads;
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&]() {
+                for (Uint32 i = 0; i < NumAllocs; ++i)
+                {
+                    const auto Offset = RB.Allocate(16, 16);
+                    if (Offset != ConcurrentRingBuffer::InvalidOffset)
+                    {
+                        EXPECT_EQ(Offset % 16, OffsetType{0});
+                        EXPECT_LE(Offset + 16, RB.GetMaxSize());
+                    }
+                }
+                NumRunning.fetch_sub(1);
+            });
+    }
+
+    // Finish and release frames while other threads are allocating
+    Uint64 FenceValue = 0;
+    while (NumRunning.load() != 0)
+    {
+        RB.FinishCurrentFrame(++FenceValue);
+        EXPECT_LE(RB.GetUsedSize(), RB.GetMaxSize());
+        RB.ReleaseCompletedFrames(FenceValue > 1 ? FenceValue - 1 : 0);
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    RB.FinishCurrentFrame(++FenceValue);
+    RB.ReleaseCompletedFrames(FenceValue);
+    EXPECT_TRUE(RB.IsEmpty());
+}
+
+} // namespace
@@ -29,6 +29,7 @@
 
 #include <array>
 #include <algorithm>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -465,4 +466,153 @@ TEST(GraphicsAccessories_DynamicAtlasManager, AllocateRandom)
     }
 }
 
+// Checks that regions are inside the atlas and do not overlap
+void VerifyRegions(const DynamicAtlasManager& Mgr, const std::vector<Region>& Regions)
+{
+    std::vector<Uint8> Coverage(size_t{Mgr.GetWidth()} * size_t{Mgr.GetHeight()});
+    for (const auto& R : Regions)
+    {
+        if (R.IsEmpty())
+            continue;
+
+        ASSERT_LE(R.x + R.width, Mgr.GetWidth()) << R;
+        ASSERT_LE(R.y + R.height, Mgr.GetHeight()) << R;
+        for (Uint32 y = R.y; y < R.y + R.height; ++y)
+        {
+            for (Uint32 x = R.x; x < R.x + R.width; ++x)
+            {
+                auto& Covered = Coverage[size_t{y} * Mgr.GetWidth() + x];
+                ASSERT_EQ(Covered, 0) << R << " overlaps another region";
+                Covered = 1;
+            }
+        }
+    }
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, PackingStrategies)
+{
+    for (Uint32 s = 0; s < static_cast<Uint32>(DynamicAtlasManager::PackingStrategy::Count); ++s)
+    {
+        const auto Strategy = static_cast<DynamicAtlasManager::PackingStrategy>(s);
+
+        DynamicAtlasManager Mgr{256, 256, Strategy};
+        EXPECT_EQ(Mgr.GetPackingStrategy(), Strategy);
+        for (Uint32 i = 0; i < 10; ++i)
+        {
+            FastRandInt         rnd{i, 1, 32};
+            std::vector<Region> Regions(i * 16);
+            for (auto& R : Regions)
+                R = Mgr.Allocate(rnd(), rnd());
+            VerifyRegions(Mgr, Regions);
+
+            // Release every other region and allocate again to exercise merging
+            for (size_t r = 0; r < Regions.size(); r += 2)
+            {
+                if (!Regions[r].IsEmpty())
+                    Mgr.Free(std::move(Regions[r]));
+            }
+            for (size_t r = 0; r < Regions.size(); r += 2)
+                Regions[r] = Mgr.Allocate(rnd(), rnd());
+            VerifyRegions(Mgr, Regions);
+
+            for (auto& R : Regions)
+            {
+                if (!R.IsEmpty())
+                    Mgr.Free(std::move(R));
+            }
+            EXPECT_TRUE(Mgr.IsEmpty());
+            EXPECT_EQ(Mgr.GetFreeRegionCount(), 1U);
+        }
+    }
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, BottomLeft)
+{
+    DynamicAtlasManager Mgr{128, 128, DynamicAtlasManager::PackingStrategy::BottomLeft};
+
+    auto R0 = Mgr.Allocate(32, 16);
+    auto R1 = Mgr.Allocate(32, 16);
+    auto R2 = Mgr.Allocate(64, 8);
+    auto R3 = Mgr.Allocate(64, 16);
+    EXPECT_EQ(R0, Region(0, 0, 32, 16));
+    EXPECT_EQ(R1, Region(32, 0, 32, 16));
+    EXPECT_EQ(R2, Region(64, 0, 64, 8));
+    // The lowest position for a 64x16 region is above the first row
+    EXPECT_EQ(R3, Region(0, 16, 64, 16));
+
+    Mgr.Free(std::move(R0));
+    Mgr.Free(std::move(R1));
+    Mgr.Free(std::move(R2));
+    Mgr.Free(std::move(R3));
+    EXPECT_TRUE(Mgr.IsEmpty());
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, AllocateBatch)
+{
+    for (Uint32 s = 0; s < static_cast<Uint32>(DynamicAtlasManager::PackingStrategy::Count); ++s)
+    {
+        const auto Strategy = static_cast<DynamicAtlasManager::PackingStrategy>(s);
+
+        // The regions cover the atlas exactly when allocated in the order of decreasing size
+        {
+            DynamicAtlasManager Mgr{128, 128, Strategy};
+
+            std::vector<Region> Regions;
+            for (Uint32 i = 0; i < 16; ++i)
+                Regions.emplace_back(0, 0, 16, 16);
+            for (Uint32 i = 0; i < 2; ++i)
+                Regions.emplace_back(0, 0, 64, 32);
+            for (Uint32 i = 0; i < 2; ++i)
+                Regions.emplace_back(0, 0, 64, 64);
+            // Empty requests must be ignored
+            Regions.emplace_back(0, 0, 0, 16);
+
+            const auto Requests = Regions;
+            EXPECT_EQ(Mgr.Allocate(Regions.data(), static_cast<Uint32>(Regions.size())), static_cast<Uint32>(Regions.size() - 1)) << "Strategy: " << s;
+            EXPECT_EQ(Mgr.GetTotalFreeArea(), 0U) << "Strategy: " << s;
+            for (size_t i = 0; i + 1 < Regions.size(); ++i)
+            {
+                EXPECT_EQ(Regions[i].width, Requests[i].width) << "Strategy: " << s;
+                EXPECT_EQ(Regions[i].height, Requests[i].height) << "Strategy: " << s;
+            }
+            EXPECT_TRUE(Regions.back().IsEmpty());
+            VerifyRegions(Mgr, Regions);
+
+            for (auto& R : Regions)
+            {
+                if (!R.IsEmpty())
+                    Mgr.Free(std::move(R));
+            }
+            EXPECT_TRUE(Mgr.IsEmpty());
+        }
+
+        // Requests that do not fit are returned as empty regions
+        {
+            DynamicAtlasManager Mgr{64, 64, Strategy};
+
+            FastRandInt         rnd{s, 1, 24};
+            std::vector<Region> Regions(64);
+            for (auto& R : Regions)
+                R = Region{0, 0, static_cast<Uint32>(rnd()), static_cast<Uint32>(rnd())};
+
+            const auto NumAllocated = Mgr.Allocate(Regions.data(), static_cast<Uint32>(Regions.size()));
+            EXPECT_GT(NumAllocated, 0U);
+            EXPECT_LT(NumAllocated, static_cast<Uint32>(Regions.size()));
+            VerifyRegions(Mgr, Regions);
+
+            Uint32 NumNonEmpty = 0;
+            for (auto& R : Regions)
+            {
+                if (!R.IsEmpty())
+                {
+                    Mgr.Free(std::move(R));
+                    ++NumNonEmpty;
+                }
+            }
+            EXPECT_EQ(NumNonEmpty, NumAllocated);
+            EXPECT_TRUE(Mgr.IsEmpty());
+        }
+    }
+}
+
 } // namespace
@@ -28,6 +28,7 @@
 #include "GraphicsUtilities.h"
 #include "FastRand.hpp"
 #include "ColorConversion.h"
+#include "Float16.hpp"
 
 #include <vector>
 #include <array>
@@ -469,6 +470,92 @@ TEST(GraphicsTools_CalculateMipLevel, FLOAT32)
     }
 }
 
+TEST(GraphicsTools_CalculateMipLevel, FLOAT16)
+{
+    // clang-format off
+    const Float32 FineData[] =
+        {
+             0,      1,      128.50f,   129.25f,  2000,
+             4,      6,      130.25f,   131.50f, -1000,
+            -1.50f, -3.25f,   61,        62,       6500,
+            -2.25f, -4.50f,   63,        64,      -1600,
+            -3.50f,  4.25f, -110,     -1270,        31
+        };
+
+    const Float32 RefCoarseData[] =
+        {
+             2.75f,  129.875f,
+           -2.875f,     62.5f
+        };
+    // clang-format on
+
+    Uint16 FineData16[_countof(FineData)];
+    Float32ToFloat16(FineData, FineData16, _countof(FineData));
+
+    const auto fmt = TEX_FORMAT_R16_FLOAT;
+    for (Uint32 width = 4; width <= 5; ++width)
+    {
+        for (Uint32 height = 4; height <= 5; ++height)
+        {
+            Uint16 CoarseData[4] = {};
+            ComputeMipLevel({fmt, width, height, FineData16, 10, CoarseData, 4, MIP_FILTER_TYPE_BOX_AVERAGE});
+            EXPECT_EQ(Float16ToFloat32(CoarseData[0]), RefCoarseData[0]);
+            EXPECT_EQ(Float16ToFloat32(CoarseData[1]), RefCoarseData[1]);
+            EXPECT_EQ(Float16ToFloat32(CoarseData[2]), RefCoarseData[2]);
+            EXPECT_EQ(Float16ToFloat32(CoarseData[3]), RefCoarseData[3]);
+        }
+    }
+
+    for (Uint32 width = 4; width <= 5; ++width)
+    {
+        Uint16 CoarseData[2] = {};
+        ComputeMipLevel({fmt, width, 1, FineData16, 0, CoarseData, 0, MIP_FILTER_TYPE_BOX_AVERAGE});
+        EXPECT_EQ(Float16ToFloat32(CoarseData[0]), 0.5f);
+        EXPECT_EQ(Float16ToFloat32(CoarseData[1]), 128.875f);
+    }
+
+    for (Uint32 height = 4; height <= 5; ++height)
+    {
+        Uint16 CoarseData[2] = {};
+        ComputeMipLevel({fmt, 1, height, FineData16, 10, CoarseData, 2, MIP_FILTER_TYPE_BOX_AVERAGE});
+        EXPECT_EQ(Float16ToFloat32(CoarseData[0]), 2.f);
+        EXPECT_EQ(Float16ToFloat32(CoarseData[1]), -1.875f);
+    }
+}
+
+TEST(GraphicsTools_CalculateMipLevel, RGBA16_FLOAT)
+{
+    // The results must match the 32-bit float path rounded to half precision
+    constexpr Uint32 NumChannels  = 4;
+    constexpr Uint32 FineWidth    = 37;
+    constexpr Uint32 FineHeight   = 15;
+    constexpr Uint32 CoarseWidth  = FineWidth / 2;
+    constexpr Uint32 CoarseHeight = FineHeight / 2;
+
+    FastRandFloat        Rnd{0, -100.f, 100.f};
+    std::vector<Float32> FineData(FineWidth * FineHeight * NumChannels);
+    for (auto& Val : FineData)
+        Val = Float16ToFloat32(Float32ToFloat16(Rnd()));
+
+    std::vector<Uint16> FineData16(FineData.size());
+    Float32ToFloat16(FineData.data(), FineData16.data(), FineData.size());
+
+    // The most frequent selector picks the texel based on the row index when all values differ
+    for (MIP_FILTER_TYPE FilterType : {MIP_FILTER_TYPE_BOX_AVERAGE, MIP_FILTER_TYPE_MOST_FREQUENT})
+    {
+        std::vector<Float32> RefCoarseData(CoarseWidth * CoarseHeight * NumChannels);
+        ComputeMipLevel({TEX_FORMAT_RGBA32_FLOAT, FineWidth, FineHeight, FineData.data(), FineWidth * NumChannels * sizeof(Float32),
+                         RefCoarseData.data(), CoarseWidth * NumChannels * sizeof(Float32), FilterType});
+
+        std::vector<Uint16> CoarseData(RefCoarseData.size());
+        ComputeMipLevel({TEX_FORMAT_RGBA16_FLOAT, FineWidth, FineHeight, FineData16.data(), FineWidth * NumChannels * sizeof(Uint16),
+                         CoarseData.data(), CoarseWidth * NumChannels * sizeof(Uint16), FilterType});
+
+        for (size_t i = 0; i < CoarseData.size(); ++i)
+            EXPECT_EQ(CoarseData[i], Float32ToFloat16(RefCoarseData[i])) << "Filter " << FilterType << ", element " << i;
+    }
+}
+
 TEST(GraphicsTools_CalculateMipLevel, RGBA_BOX_AVE)
 {
     for (Uint32 NumChannels = 1; NumChannels <= 4; NumChannels *= 2)
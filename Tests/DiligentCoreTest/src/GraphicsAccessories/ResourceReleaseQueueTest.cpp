@@ -26,6 +26,9 @@
  */
 
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "ResourceReleaseQueue.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
@@ -128,4 +131,200 @@ TEST(GraphicsAccessories_ResourceReleaseQueue, GetFilterTypeLiteralName)
     }
 }
 
+
+// Records the order and the thread in which resources are destroyed
+class ReleaseLog
+{
+public:
+    class Resource
+    {
+    public:
+        Resource(ReleaseLog& Log, int Id) :
+            m_pLog{&Log},
+            m_Id{Id}
+        {}
+
+        Resource(Resource&& rhs) noexcept :
+            m_pLog{rhs.m_pLog},
+            m_Id{rhs.m_Id}
+        {
+            rhs.m_pLog = nullptr;
+        }
+
+        // clang-format off
+        Resource             (const Resource&) = delete;
+        Resource& operator = (const Resource&) = delete;
+        Resource& operator = (Resource&&)      = delete;
+        // clang-format on
+
+        ~Resource()
+        {
+            if (m_pLog != nullptr)
+                m_pLog->Add(m_Id);
+        }
+
+    private:
+        ReleaseLog* m_pLog;
+        int         m_Id;
+    };
+
+    void Add(int Id)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_Ids.push_back(Id);
+        m_ThreadIds.push_back(std::this_thread::get_id());
+    }
+
+    size_t GetCount()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_Ids.size();
+    }
+
+    // Checks that resources 0..Count-1 have been destroyed in order
+    void Verify(size_t Count)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        ASSERT_EQ(m_Ids.size(), Count);
+        for (size_t i = 0; i < Count; ++i)
+            EXPECT_EQ(m_Ids[i], static_cast<int>(i));
+    }
+
+    std::vector<std::thread::id> GetThreadIds()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_ThreadIds;
+    }
+
+private:
+    std::mutex                   m_Mtx;
+    std::vector<int>             m_Ids;
+    std::vector<std::thread::id> m_ThreadIds;
+};
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, PurgeBudget)
+{
+    ReleaseLog Log;
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+    Queue.SetMaxResourcesPerPurge(4);
+
+    for (int i = 0; i < 10; ++i)
+        Queue.SafeReleaseResource(ReleaseLog::Resource{Log, i}, 0);
+    Queue.DiscardStaleResources(0, 1);
+    for (int i = 10; i < 15; ++i)
+        Queue.DiscardResource(ReleaseLog::Resource{Log, i}, 2);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 15u);
+
+    Queue.Purge(1);
+    Log.Verify(4);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 11u);
+
+    Queue.Purge(1);
+    Log.Verify(8);
+
+    // Resources with fence value 2 must not be released
+    Queue.Purge(1);
+    Log.Verify(10);
+    Queue.Purge(1);
+    Log.Verify(10);
+
+    Queue.Purge(2);
+    Log.Verify(14);
+
+    // Flush ignores the budget
+    Queue.DiscardResource(ReleaseLog::Resource{Log, 15}, 2);
+    Queue.Flush(2);
+    Log.Verify(16);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 0u);
+
+    const auto Stats = Queue.GetStats();
+    EXPECT_EQ(Stats.StaleResourceCount, 0u);
+    EXPECT_EQ(Stats.PendingReleaseResourceCount, 0u);
+    EXPECT_EQ(Stats.BackgroundReleaseResourceCount, 0u);
+    EXPECT_EQ(Stats.ReleasedResourceCount, 16u);
+    EXPECT_GE(Stats.AvgReleaseLatency, 0.0);
+    EXPECT_GE(Stats.MaxReleaseLatency, Stats.AvgReleaseLatency);
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, BackgroundRelease)
+{
+    constexpr int NumResources = 1000;
+    constexpr int NumFrames    = 10;
+
+    ReleaseLog Log;
+    {
+        ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+        Queue.EnableBackgroundRelease(true);
+        EXPECT_TRUE(Queue.IsBackgroundReleaseEnabled());
+        // The budget only applies to the calling thread
+        Queue.SetMaxResourcesPerPurge(1);
+
+        for (int i = 0; i < NumResources; ++i)
+            Queue.DiscardResource(ReleaseLog::Resource{Log, i}, 1 + i * NumFrames / NumResources);
+
+        // Resources whose fence value has not been reached must stay in the queue
+        Queue.Purge(NumFrames / 2);
+        EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), static_cast<size_t>(NumResources / 2));
+
+        Queue.Flush(NumFrames / 2);
+        Log.Verify(NumResources / 2);
+        for (const auto& ThreadId : Log.GetThreadIds())
+            EXPECT_NE(ThreadId, std::this_thread::get_id());
+
+        // Disabling the worker waits until all handed-off resources are destroyed
+        Queue.Purge(NumFrames - 1);
+        Queue.EnableBackgroundRelease(false);
+        EXPECT_FALSE(Queue.IsBackgroundReleaseEnabled());
+        Log.Verify(NumResources - NumResources / NumFrames);
+
+        auto Stats = Queue.GetStats();
+        EXPECT_EQ(Stats.PendingReleaseResourceCount, static_cast<size_t>(NumResources / NumFrames));
+        EXPECT_EQ(Stats.BackgroundReleaseResourceCount, 0u);
+        EXPECT_EQ(Stats.ReleasedResourceCount, static_cast<Uint64>(NumResources - NumResources / NumFrames));
+
+        // Re-enable the worker and destroy the queue with resources handed to the worker
+        Queue.EnableBackgroundRelease(true);
+        Queue.Purge(NumFrames);
+    }
+    Log.Verify(NumResources);
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, BackgroundReleaseConcurrent)
+{
+    constexpr int NumThreads         = 4;
+    constexpr int ResourcesPerThread = 1000;
+
+    ReleaseLog Log;
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+    Queue.EnableBackgroundRelease(true);
+
+    std::atomic<Uint64>      CmdBufferNumber{0};
+    std::vector<std::thread> Threads;
+    for (int t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&, t]() {
+            for (int i = 0; i < ResourcesPerThread; ++i)
+                Queue.SafeReleaseResource(ReleaseLog::Resource{Log, t * ResourcesPerThread + i}, CmdBufferNumber.load());
+        });
+    }
+
+    // Simulate frames while other threads release resources
+    Uint64 FenceValue = 0;
+    for (int Frame = 0; Frame < 100; ++Frame)
+    {
+        const auto CmdBuffNumber = CmdBufferNumber.fetch_add(1);
+        Queue.DiscardStaleResources(CmdBuffNumber, ++FenceValue);
+        Queue.Purge(FenceValue - 1);
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    Queue.DiscardStaleResources(CmdBufferNumber.load(), ++FenceValue);
+    Queue.Flush(FenceValue);
+    EXPECT_EQ(Log.GetCount(), static_cast<size_t>(NumThreads * ResourcesPerThread));
+    EXPECT_EQ(Queue.GetStats().ReleasedResourceCount, static_cast<Uint64>(NumThreads * ResourcesPerThread));
+}
+
 } // namespace
@@ -0,0 +1,379 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TextureFormatConverter.hpp"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "ColorConversion.h"
+#include "Float16.hpp"
+#include "ThreadPool.hpp"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+template <typename DstType, typename SrcType>
+std::vector<DstType> Convert(const std::vector<SrcType>& Src,
+                             TEXTURE_FORMAT              SrcFormat,
+                             TEXTURE_FORMAT              DstFormat,
+                             Uint32                      Width,
+                             Uint32                      Height,
+                             size_t                      DstElementsPerTexel,
+                             IThreadPool*                pThreadPool = nullptr)
+{
+    std::vector<DstType> Dst(size_t{Width} * Height * DstElementsPerTexel);
+
+    ConvertTextureDataAttribs Attribs;
+    Attribs.Width       = Width;
+    Attribs.Height      = Height;
+    Attribs.SrcFormat   = SrcFormat;
+    Attribs.pSrcData    = Src.data();
+    Attribs.SrcStride   = Src.size() * sizeof(SrcType) / Height;
+    Attribs.DstFormat   = DstFormat;
+    Attribs.pDstData    = Dst.data();
+    Attribs.DstStride   = Dst.size() * sizeof(DstType) / Height;
+    Attribs.pThreadPool = pThreadPool;
+    EXPECT_TRUE(ConvertTextureData(Attribs));
+
+    return Dst;
+}
+
+TEST(GraphicsAccessories_TextureFormatConverter, IsConversionSupported)
+{
+    EXPECT_TRUE(IsTextureFormatConversionSupported(TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_BGRA8_UNORM));
+    EXPECT_TRUE(IsTextureFormatConversionSupported(TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_RGBA16_FLOAT));
+    EXPECT_TRUE(IsTextureFormatConversionSupported(TEX_FORMAT_R11G11B10_FLOAT, TEX_FORMAT_RGB10A2_UNORM));
+    EXPECT_TRUE(IsTextureFormatConversionSupported(TEX_FORMAT_D32_FLOAT, TEX_FORMAT_R16_UNORM));
+    EXPECT_TRUE(IsTextureFormatConversionSupported(TEX_FORMAT_RGBA8_UINT, TEX_FORMAT_RG32_SINT));
+    EXPECT_TRUE(IsTextureFormatConversionSupported(TEX_FORMAT_BC1_UNORM, TEX_FORMAT_BC1_UNORM));
+    EXPECT_TRUE(IsTextureFormatConversionSupported(TEX_FORMAT_D24_UNORM_S8_UINT, TEX_FORMAT_D24_UNORM_S8_UINT));
+
+    EXPECT_FALSE(IsTextureFormatConversionSupported(TEX_FORMAT_UNKNOWN, TEX_FORMAT_RGBA8_UNORM));
+    EXPECT_FALSE(IsTextureFormatConversionSupported(TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UINT));
+    EXPECT_FALSE(IsTextureFormatConversionSupported(TEX_FORMAT_RGBA8_TYPELESS, TEX_FORMAT_RGBA8_UNORM));
+    EXPECT_FALSE(IsTextureFormatConversionSupported(TEX_FORMAT_BC1_UNORM, TEX_FORMAT_RGBA8_UNORM));
+    EXPECT_FALSE(IsTextureFormatConversionSupported(TEX_FORMAT_D24_UNORM_S8_UINT, TEX_FORMAT_R32_FLOAT));
+
+    ConvertTextureDataAttribs Attribs;
+    Attribs.SrcFormat = TEX_FORMAT_RGBA8_UNORM;
+    Attribs.DstFormat = TEX_FORMAT_RGBA8_SINT;
+    EXPECT_FALSE(ConvertTextureData(Attribs));
+}
+
+TEST(GraphicsAccessories_TextureFormatConverter, Copy)
+{
+    constexpr Uint32 Width     = 5;
+    constexpr Uint32 Height    = 3;
+    constexpr size_t SrcStride = 32;
+    constexpr size_t DstStride = 24;
+
+    std::vector<Uint8> Src(SrcStride * Height);
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = static_cast<Uint8>(i);
+    std::vector<Uint8> Dst(DstStride * Height, 0xCD);
+
+    ConvertTextureDataAttribs Attribs;
+    Attribs.Width     = Width;
+    Attribs.Height    = Height;
+    Attribs.SrcFormat = TEX_FORMAT_RGBA8_UNORM;
+    Attribs.pSrcData  = Src.data();
+    Attribs.SrcStride = SrcStride;
+    Attribs.DstFormat = TEX_FORMAT_RGBA8_UNORM;
+    Attribs.pDstData  = Dst.data();
+    Attribs.DstStride = DstStride;
+    EXPECT_TRUE(ConvertTextureData(Attribs));
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 i = 0; i < Width * 4; ++i)
+            EXPECT_EQ(Dst[y * DstStride + i], Src[y * SrcStride + i]);
+        // Padding must not be touched
+        for (size_t i = Width * 4; i < DstStride; ++i)
+            EXPECT_EQ(Dst[y * DstStride + i], 0xCD);
+    }
+
+    // D32_FLOAT and R32_FLOAT have the same layout
+    const std::vector<float> Depth = {0.f, 0.25f, 1.f, 0.125f};
+    EXPECT_EQ((Convert<float>(Depth, TEX_FORMAT_D32_FLOAT, TEX_FORMAT_R32_FLOAT, 4, 1, 1)), Depth);
+}
+
+TEST(GraphicsAccessories_TextureFormatConverter, RGBA8Swizzle)
+{
+    const std::vector<Uint8> RGBA = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+
+    EXPECT_EQ((Convert<Uint8>(RGBA, TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_BGRA8_UNORM, 3, 1, 4)),
+              (std::vector<Uint8>{3, 2, 1, 4, 7, 6, 5, 8, 11, 10, 9, 12}));
+    EXPECT_EQ((Convert<Uint8>(RGBA, TEX_FORMAT_BGRA8_UNORM, TEX_FORMAT_RGBA8_UNORM, 3, 1, 4)),
+              (std::vector<Uint8>{3, 2, 1, 4, 7, 6, 5, 8, 11, 10, 9, 12}));
+    EXPECT_EQ((Convert<Uint8>(RGBA, TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_BGRX8_UNORM_SRGB, 3, 1, 4)),
+              (std::vector<Uint8>{3, 2, 1, 255, 7, 6, 5, 255, 11, 10, 9, 255}));
+    EXPECT_EQ((Convert<Uint8>(RGBA, TEX_FORMAT_BGRX8_UNORM, TEX_FORMAT_BGRA8_UNORM, 3, 1, 4)),
+              (std::vector<Uint8>{1, 2, 3, 255, 5, 6, 7, 255, 9, 10, 11, 255}));
+
+    // The general path must produce the same result
+    const std::vector<Uint16> RGBA16 = Convert<Uint16>(RGBA, TEX_FORMAT_BGRX8_UNORM, TEX_FORMAT_RGBA16_UNORM, 3, 1, 4);
+    EXPECT_EQ((Convert<Uint8>(RGBA16, TEX_FORMAT_RGBA16_UNORM, TEX_FORMAT_RGBA8_UNORM, 3, 1, 4)),
+              (Convert<Uint8>(RGBA, TEX_FORMAT_BGRX8_UNORM, TEX_FORMAT_RGBA8_UNORM, 3, 1, 4)));
+}
+
+TEST(GraphicsAccessories_TextureFormatConverter, UNorm)
+{
+    std::vector<Uint8> Src(256);
+    for (Uint32 i = 0; i < 256; ++i)
+        Src[i] = static_cast<Uint8>(i);
+
+    const std::vector<float> Float = Convert<float>(Src, TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA32_FLOAT, 64, 1, 4);
+    for (Uint32 i = 0; i < 256; ++i)
+        EXPECT_EQ(Float[i], static_cast<float>(i) / 255.f);
+
+    EXPECT_EQ((Convert<Uint8>(Float, TEX_FORMAT_RGBA32_FLOAT, TEX_FORMAT_RGBA8_UNORM, 64, 1, 4)), Src);
+
+    const std::vector<Uint16> UNorm16 = Convert<Uint16>(Src, TEX_FORMAT_RG8_UNORM, TEX_FORMAT_RG16_UNORM, 128, 1, 2);
+    for (Uint32 i = 0; i < 256; ++i)
+        EXPECT_EQ(UNorm16[i], i * 257);
+    EXPECT_EQ((Convert<Uint8>(UNorm16, TEX_FORMAT_RG16_UNORM, TEX_FORMAT_RG8_UNORM, 128, 1, 2)), Src);
+
+    // Out-of-range values are clamped, values are rounded to the nearest
+    const std::vector<float> Values = {-1.f, 2.f, 0.5f, 1.f / 255.f * 0.49f, 1.f / 255.f * 0.51f, 0.f, 1.f};
+    EXPECT_EQ((Convert<Uint8>(Values, TEX_FORMAT_R32_FLOAT, TEX_FORMAT_R8_UNORM, 7, 1, 1)),
+              (std::vector<Uint8>{0, 255, 128, 0, 1, 0, 255}));
+}
+
+TEST(GraphicsAccessories_TextureFormatConverter, SNorm)
+{
+    const std::vector<Int8> Src = {-128, -127, -64, 0, 64, 127};
+
+    const std::vector<float> Float = Convert<float>(Src, TEX_FORMAT_R8_SNORM, TEX_FORMAT_R32_FLOAT, 6, 1, 1);
+    EXPECT_EQ(Float, (std::vector<float>{-1.f, -1.f, -64.f / 127.f, 0.f, 64.f / 127.f, 1.f}));
+
+    const std::vector<float> Values = {-2.f, -1.f, -0.5f, 0.f, 0.5f, 1.f, 2.f};
+    EXPECT_EQ((Convert<Int8>(Values, TEX_FORMAT_R32_FLOAT, TEX_FORMAT_R8_SNORM, 7, 1, 1)),
+              (std::vector<Int8>{-127, -127, -64, 0, 64, 127, 127}));
+    EXPECT_EQ((Convert<Int16>(Values, TEX_FORMAT_R32_FLOAT, TEX_FORMAT_R16_SNORM, 7, 1, 1)),
+              (std::vector<Int16>{-32767, -32767, -16384, 0, 16384, 32767, 32767}));
+}
+
+TEST(GraphicsAccessories_TextureFormatConverter, SRGB)
+{
+    std::vector<Uint8> Src(256);
+    for (Uint32 i = 0; i < 256; ++i)
+        Src[i] = static_cast<Uint8>(i);
+
+    const std::vector<float> Linear = Convert<float>(Src, TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_RGBA32_FLOAT, 64, 1, 4);
+    for (Uint32 i = 0; i < 256; ++i)
+    {
+        // Alpha is not gamma-encoded
+        const float Expected = (i % 4) < 3 ? GammaToLinear(static_cast<Uint8>(i)) : static_cast<float>(i) / 255.f;
+        EXPECT_EQ(Linear[i], Expected);
+    }
+
+    // Round trip must be exact
+    EXPECT_EQ((Convert<Uint8>(Linear, TEX_FORMAT_RGBA32_FLOAT, TEX_FORMAT_RGBA8_UNORM_SRGB, 64, 1, 4)), Src);
+
+    FastRandFloat      Rnd{0, 0.f, 1.f};
+    std::vector<float> Values(4096);
+    for (float& Val : Values)
+        Val = Rnd();
+    const std::vector<Uint8> SRGB = Convert<Uint8>(Values, TEX_FORMAT_RGBA32_FLOAT, TEX_FORMAT_BGRA8_UNORM_SRGB, 1024, 1, 4);
+    for (size_t i = 0; i < Values.size(); i += 4)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            const float Expected = c < 3 ? LinearToGamma(Values[i + c]) : Values[i + c];
+            EXPECT_NEAR(SRGB[i + (c < 3 ? 2 - c : 3)], Expected * 255.f, 0.5001f);
+        }
+    }
+
+    // sRGB to linear UNORM conversion
+    const std::vector<Uint8> Gray = {188, 188, 188, 255};
+    const std::vector<Uint8> Lin  = Convert<Uint8>(Gray, TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_RGBA8_UNORM, 1, 1, 4);
+    EXPECT_EQ(Lin, (std::vector<Uint8>{128, 128, 128, 255}));
+}
+
+TEST(GraphicsAccessories_TextureFormatConverter, Float)
+{
+    const std::vector<float> Values = {0.f, 1.f, -2.5f, 65504.f, 0.333f, 1e-5f, 100.f, 0.5f};
+
+    std::vector<Uint16> Expected(Values.size());
+    for (size_t i = 0; i < Values.size(); ++i)
+        Expected[i] = Float32ToFloat16(Values[i]);
+
+    const std::vector<Uint16> Half = Convert<Uint16>(Values, TEX_FORMAT_RGBA32_FLOAT, TEX_FORMAT_RGBA16_FLOAT, 2, 1, 4);
+    EXPECT_EQ(Half, Expected);
+
+    const std::vector<float> Float = Convert<float>(Half, TEX_FORMAT_RG16_FLOAT, TEX_FORMAT_RG32_FLOAT, 4, 1, 2);
+    for (size_t i = 0; i < Values.size(); ++i)
+        EXPECT_EQ(Float[i], Float16ToFloat32(Expected[i]));
+
+    // Missing channels are set to (0, 0, 0, 1)
+    EXPECT_EQ((Convert<float>(Values, TEX_FORMAT_RG32_FLOAT, TEX_FORMAT_RGBA32_FLOAT, 1, 1, 4)),
+              (std::vector<float>{0.f, 1.f, 0.f, 1.f}));
+    EXPECT_EQ((Convert<float>(Half, TEX_FORMAT_R16_FLOAT, TEX_FORMAT_RGB32_FLOAT, 2, 1, 3)),
+              (std::vector<float>{0.f, 0.f, 0.f, 1.f, 0.f, 0.f}));
+}
+
+TEST(GraphicsAccessories_TextureFormatConverter, MissingChannels)
+{
+    const std::vector<Uint8> Src = {10, 20};
+    EXPECT_EQ((Convert<Uint8>(Src, TEX_FORMAT_R8_UNORM, TEX_FORMAT_RGBA8_UNORM, 2, 1, 4)),
+              (std::vector<Uint8>{10, 0, 0, 255, 20, 0, 0, 255}));
+    EXPECT_EQ((Convert<Uint8>(Src, TEX_FORMAT_A8_UNORM, TEX_FORMAT_RGBA8_UNORM, 2, 1, 4)),
+              (std::vector<Uint8>{0, 0, 0, 10, 0, 0, 0, 20}));
+    EXPECT_EQ((Convert<Uint8>(Src, TEX_FORMAT_RG8_UNORM, TEX_FORMAT_BGRX8_UNORM, 1, 1, 4)),
+              (std::vector<Uint8>{0, 20, 10, 255}));
+
+    const std::vector<Uint8> RGBA = {1, 2, 3, 4};
+    EXPECT_EQ((Convert<Uint8>(RGBA, TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_A8_UNORM, 1, 1, 1)), (std::vector<Uint8>{4}));
+    EXPECT_EQ((Convert<Uint8>(RGBA, TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RG8_UNORM, 1, 1, 2)), (std::vector<Uint8>{1, 2}));
+}
+
+TEST(GraphicsAccessories_TextureFormatConverter, PackedFormats)
+{
+    // clang-format off
+    const std::vector<float> Values =
+    {
+        0.f,   0.5f,  1.f,  1.f,
+        0.25f, 0.75f, 0.f,  0.f,
+        1.f,   0.f,   0.5f, 1.f / 3.f,
+    };
+    // clang-format on
+
+    {
+        const std::vector<Uint32> RGB10A2 = Convert<Uint32>(Values, TEX_FORMAT_RGBA32_FLOAT, TEX_FORMAT_RGB10A2_UNORM, 3, 1, 1);
+        EXPECT_EQ(RGB10A2[0], (0u) | (512u << 10) | (1023u << 20) | (3u << 30));
+        EXPECT_EQ(RGB10A2[1], (256u) | (767u << 10));
+        EXPECT_EQ(RGB10A2[2], (1023u) | (512u << 20) | (1u << 30));
+
+        const std::vector<float> Float = Convert<float>(RGB10A2, TEX_FORMAT_RGB10A2_UNORM, TEX_FORMAT_RGBA32_FLOAT, 3, 1, 4);
+        for (size_t i = 0; i < Values.size(); ++i)
+            EXPECT_NEAR(Float[i], Values[i], 0.5f / 1023.f);
+    }
+
+    {
+        const std::vector<Uint16> B5G6R5 = Convert<Uint16>(Values, TEX_FORMAT_RGBA32_FLOAT, TEX_FORMAT_B5G6R5_UNORM, 3, 1, 1);
+        EXPECT_EQ(B5G6R5[0], (0u << 11) | (32u << 5) | 31u);
+        EXPECT_EQ(B5G6R5[1], (8u << 11) | (47u << 5) | 0u);
+        EXPECT_EQ(B5G6R5[2], (31u << 11) | (0u << 5) | 16u);
+
+        const std::vector<Uint8> RGBA8 = Convert<Uint8>(B5G6R5, TEX_FORMAT_B5G6R5_UNORM, TEX_FORMAT_RGBA8_UNORM, 3, 1, 4);
+        EXPECT_EQ(RGBA8[0], 0);
+        EXPECT_EQ(RGBA8[2], 255);
+        EXPECT_EQ(RGBA8[3], 255);
+        EXPECT_EQ(RGBA8[8], 255);
+
+        const std::vector<Uint16> B5G5R5A1 = Convert<Uint16>(Values, TEX_FORMAT_RGBA32_FLOAT, TEX_FORMAT_B5G5R5A1_UNORM, 3, 1, 1);
+        EXPECT_EQ(B5G5R5A1[0], (1u << 15) | (0u << 10) | (16u << 5) | 31u);
+        EXPECT_EQ(B5G5R5A1[1], (0u << 15) | (8u << 10) | (23u << 5) | 0u);
+        EXPECT_EQ(B5G5R5A1[2], (0u << 15) | (31u << 10) | (0u << 5) | 16u);
+    }
+
+    {
+        // clang-format off
+        const std::vector<float> HDR =
+        {
+            1.f,      0.5f,    2.f,     1.f,
+            0.f,      100.f,   0.0625f, 1.f,
+            65024.f,  -1.f,    64512.f, 1.f,
+        };
+        // clang-format on
+
+        const std::vector<Uint32> R11G11B10 = Convert<Uint32>(HDR, TEX_FORMAT_RGBA32_FLOAT, TEX_FORMAT_R11G11B10_FLOAT, 3, 1, 1);
+        EXPECT_EQ(R11G11B10[0], 0x3C0u | (0x380u << 11) | (0x200u << 22));
+        // Negative values are clamped to zero
+        EXPECT_EQ(R11G11B10[2] & (0x7FFu << 11), 0u);
+
+        const std::vector<float> Float = Convert<float>(R11G11B10, TEX_FORMAT_R11G11B10_FLOAT, TEX_FORMAT_RGBA32_FLOAT, 3, 1, 4);
+        EXPECT_EQ(Float, (std::vector<float>{1.f, 0.5f, 2.f, 1.f, 0.f, 100.f, 0.0625f, 1.f, 65024.f, 0.f, 64512.f, 1.f}));
+
+        // Values are rounded to the nearest representable value
+        const std::vector<float> Inexact = {1.f + 1.f / 64.f * 0.4f, 1.f + 1.f / 64.f * 0.6f, 1.f + 1.f / 32.f * 0.6f, 0.f};
+        const std::vector<float> Rounded = Convert<float>(Convert<Uint32>(Inexact, TEX_FORMAT_RGBA32_FLOAT, TEX_FORMAT_R11G11B10_FLOAT, 1, 1, 1),
+                                                          TEX_FORMAT_R11G11B10_FLOAT, TEX_FORMAT_RGBA32_FLOAT, 1, 1, 4);
+        EXPECT_EQ(Rounded, (std::vector<float>{1.f, 1.f + 1.f / 64.f, 1.f + 1.f / 32.f, 1.f}));
+    }
+
+    {
+        // clang-format off
+        const std::vector<float> HDR =
+        {
+            1.f,      0.5f,    2.f,     1.f,
+            0.f,      100.f,   0.25f,   1.f,
+            65408.f,  -1.f,    1e10f,   1.f,
+        };
+        // clang-format on
+        const std::vector<Uint32> RGB9E5 = Convert<Uint32>(HDR, TEX_FORMAT_RGBA32_FLOAT, TEX_FORMAT_RGB9E5_SHAREDEXP, 3, 1, 1);
+        const std::vector<float>  Float  = Convert<float>(RGB9E5, TEX_FORMAT_RGB9E5_SHAREDEXP, TEX_FORMAT_RGBA32_FLOAT, 3, 1, 4);
+        EXPECT_EQ(Float, (std::vector<float>{1.f, 0.5f, 2.f, 1.f, 0.f, 100.f, 0.25f, 1.f, 65408.f, 0.f, 65408.f, 1.f}));
+    }
+}
+
+TEST(GraphicsAccessories_TextureFormatConverter, Integer)
+{
+    const std::vector<Int16> Src = {-300, -1, 0, 1, 200, 300, 32767, -32768};
+
+    EXPECT_EQ((Convert<Uint8>(Src, TEX_FORMAT_RG16_SINT, TEX_FORMAT_RG8_UINT, 4, 1, 2)),
+              (std::vector<Uint8>{0, 0, 0, 1, 200, 255, 255, 0}));
+    EXPECT_EQ((Convert<Int8>(Src, TEX_FORMAT_RG16_SINT, TEX_FORMAT_RG8_SINT, 4, 1, 2)),
+              (std::vector<Int8>{-128, -1, 0, 1, 127, 127, 127, -128}));
+    EXPECT_EQ((Convert<Int32>(Src, TEX_FORMAT_RGBA16_SINT, TEX_FORMAT_RGBA32_SINT, 2, 1, 4)),
+              (std::vector<Int32>{-300, -1, 0, 1, 200, 300, 32767, -32768}));
+
+    // Missing alpha is set to 1
+    const std::vector<Uint32> UInt32 = {0xFFFFFFFFu, 7u};
+    EXPECT_EQ((Convert<Uint32>(UInt32, TEX_FORMAT_R32_UINT, TEX_FORMAT_RGB10A2_UINT, 2, 1, 1)),
+              (std::vector<Uint32>{1023u | (1u << 30), 7u | (1u << 30)}));
+    EXPECT_EQ((Convert<Uint32>(UInt32, TEX_FORMAT_RG32_UINT, TEX_FORMAT_RGBA32_UINT, 1, 1, 4)),
+              (std::vector<Uint32>{0xFFFFFFFFu, 7u, 0u, 1u}));
+}
+
+TEST(GraphicsAccessories_TextureFormatConverter, Parallel)
+{
+    constexpr Uint32 Width  = 517;
+    constexpr Uint32 Height = 389;
+
+    FastRandInt        Rnd{0, 0, 255};
+    std::vector<Uint8> Src(size_t{Width} * Height * 4);
+    for (Uint8& Val : Src)
+        Val = static_cast<Uint8>(Rnd());
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+
+    const TEXTURE_FORMAT DstFormats[] = {TEX_FORMAT_BGRA8_UNORM_SRGB, TEX_FORMAT_RGBA16_FLOAT, TEX_FORMAT_R11G11B10_FLOAT};
+    for (TEXTURE_FORMAT DstFormat : DstFormats)
+    {
+        const std::vector<Uint8> Ref = Convert<Uint8>(Src, TEX_FORMAT_RGBA8_UNORM_SRGB, DstFormat, Width, Height, 8);
+        const std::vector<Uint8> Par = Convert<Uint8>(Src, TEX_FORMAT_RGBA8_UNORM_SRGB, DstFormat, Width, Height, 8, pThreadPool);
+        EXPECT_EQ(Ref, Par);
+    }
+}
+
+} // namespace
@@ -26,8 +26,14 @@
  */
 
 #include "VariableSizeGPUAllocationsManager.hpp"
+#include "TLSFAllocationsManager.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
 #include "PlatformDefinitions.h"
+#include "FastRand.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -36,14 +42,15 @@ using namespace Diligent;
 namespace
 {
 
-TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree)
+template <typename AllocationsManagerType>
+void TestAllocateFree()
 {
     auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
 
     using OffsetType = VariableSizeAllocationsManager::OffsetType;
 
     {
-        VariableSizeAllocationsManager ListMgr(128, Allocator);
+        AllocationsManagerType ListMgr(128, Allocator);
         EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
         EXPECT_EQ(ListMgr.GetFreeSize(), size_t{128});
         EXPECT_EQ(ListMgr.GetUsedSize(), size_t{0});
@@ -137,7 +144,7 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree)
     }
 
     {
-        VariableSizeAllocationsManager ListMgr(128, Allocator);
+        AllocationsManagerType ListMgr(128, Allocator);
 
         auto a1 = ListMgr.Allocate(64, 1);
         EXPECT_EQ(a1.UnalignedOffset, OffsetType{0});
@@ -178,7 +185,8 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree)
     }
 }
 
-TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
+template <typename AllocationsManagerType>
+void TestFreeOrder()
 {
     auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
     using OffsetType = VariableSizeAllocationsManager::OffsetType;
@@ -192,7 +200,7 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
         do
         {
             ++NumPerms;
-            VariableSizeAllocationsManager ListMgr(NumAllocs * 4, Allocator);
+            AllocationsManagerType ListMgr(NumAllocs * 4, Allocator);
 
             VariableSizeAllocationsManager::Allocation allocs[NumAllocs];
             for (size_t a = 0; a < NumAllocs; ++a)
@@ -210,13 +218,14 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
     }
 }
 
-TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Free)
+template <typename GPUAllocationsManagerType>
+void TestFree()
 {
     auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
     {
-        VariableSizeGPUAllocationsManager ListMgr(128, Allocator);
+        GPUAllocationsManagerType ListMgr(128, Allocator);
 
-        VariableSizeGPUAllocationsManager::Allocation al[16];
+        VariableSizeAllocationsManager::Allocation al[16];
         for (size_t o = 0; o < _countof(al); ++o)
             al[o] = ListMgr.Allocate(8, 4);
         EXPECT_TRUE(ListMgr.IsFull());
@@ -249,4 +258,334 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Free)
     }
 }
 
+template <typename AllocationsManagerType>
+void TestPlanDefragmentation()
+{
+    auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+    using Allocation = VariableSizeAllocationsManager::Allocation;
+
+    constexpr size_t NumBlocks = 16;
+    constexpr size_t BlockSize = 64;
+
+    // Creates a manager with every other block allocated
+    auto CreateFragmentedManager = [&](std::vector<Allocation>& LiveAllocs) {
+        std::unique_ptr<AllocationsManagerType> pMgr{new AllocationsManagerType{NumBlocks * BlockSize, Allocator}};
+
+        std::vector<Allocation> Allocs(NumBlocks);
+        for (auto& Alloc : Allocs)
+            Alloc = pMgr->Allocate(BlockSize, 1);
+        LiveAllocs.clear();
+        for (size_t i = 0; i < NumBlocks; ++i)
+        {
+            if (i % 2 == 0)
+                pMgr->Free(std::move(Allocs[i]));
+            else
+                LiveAllocs.push_back(Allocs[i]);
+        }
+        EXPECT_EQ(pMgr->GetNumFreeBlocks(), NumBlocks / 2);
+        return pMgr;
+    };
+
+    {
+        std::vector<Allocation> LiveAllocs;
+        auto                    pMgr = CreateFragmentedManager(LiveAllocs);
+
+        typename AllocationsManagerType::DefragmentationAttribs Attribs;
+        Attribs.pAllocations   = LiveAllocs.data();
+        Attribs.NumAllocations = LiveAllocs.size();
+
+        const auto Moves = pMgr->PlanDefragmentation(Attribs);
+        // The four allocations in the upper half are moved to the holes in the lower half
+        ASSERT_EQ(Moves.size(), size_t{4});
+        for (size_t i = 0; i < Moves.size(); ++i)
+        {
+            const auto& Move     = Moves[i];
+            const auto& SrcAlloc = LiveAllocs[Move.AllocationIndex];
+            EXPECT_EQ(Move.AllocationIndex, LiveAllocs.size() - 1 - i);
+            EXPECT_EQ(Move.NewAllocation.UnalignedOffset, OffsetType{i * 2 * BlockSize});
+            EXPECT_EQ(Move.NewAllocation.Size, OffsetType{BlockSize});
+            EXPECT_EQ(Move.SrcOffset, SrcAlloc.UnalignedOffset);
+            EXPECT_EQ(Move.DstOffset, Move.NewAllocation.UnalignedOffset);
+            EXPECT_EQ(Move.CopySize, OffsetType{BlockSize});
+            EXPECT_LE(Move.DstOffset + Move.CopySize, Move.SrcOffset);
+        }
+
+        for (const auto& Move : Moves)
+        {
+            pMgr->Free(LiveAllocs[Move.AllocationIndex].UnalignedOffset, LiveAllocs[Move.AllocationIndex].Size);
+            LiveAllocs[Move.AllocationIndex] = Move.NewAllocation;
+        }
+        EXPECT_EQ(pMgr->GetNumFreeBlocks(), size_t{1});
+        EXPECT_EQ(pMgr->GetMaxFreeBlockSize(), pMgr->GetFreeSize());
+        EXPECT_EQ(pMgr->GetMaxFreeBlockSize(), OffsetType{NumBlocks / 2 * BlockSize});
+
+        // The space is compacted
+        EXPECT_TRUE(pMgr->PlanDefragmentation(Attribs).empty());
+
+        for (auto& Alloc : LiveAllocs)
+            pMgr->Free(std::move(Alloc));
+        EXPECT_TRUE(pMgr->IsEmpty());
+    }
+
+    // Bounded plans
+    {
+        std::vector<Allocation> LiveAllocs;
+        auto                    pMgr = CreateFragmentedManager(LiveAllocs);
+
+        typename AllocationsManagerType::DefragmentationAttribs Attribs;
+        Attribs.pAllocations   = LiveAllocs.data();
+        Attribs.NumAllocations = LiveAllocs.size();
+        Attribs.MaxMoves       = 2;
+
+        auto ApplyMoves = [&](const std::vector<typename AllocationsManagerType::DefragmentationMove>& Moves) {
+            for (const auto& Move : Moves)
+            {
+                pMgr->Free(std::move(LiveAllocs[Move.AllocationIndex]));
+                LiveAllocs[Move.AllocationIndex] = Move.NewAllocation;
+            }
+        };
+
+        auto Moves = pMgr->PlanDefragmentation(Attribs);
+        EXPECT_EQ(Moves.size(), size_t{2});
+        ApplyMoves(Moves);
+
+        Attribs.MaxMoves       = ~size_t{0};
+        Attribs.MaxBytesToMove = BlockSize + BlockSize / 2;
+
+        Moves = pMgr->PlanDefragmentation(Attribs);
+        EXPECT_EQ(Moves.size(), size_t{1});
+        ApplyMoves(Moves);
+
+        // Two holes in the middle and the merged free space at the end
+        EXPECT_EQ(pMgr->GetNumFreeBlocks(), size_t{3});
+        EXPECT_EQ(pMgr->GetMaxFreeBlockSize(), OffsetType{6 * BlockSize});
+
+        for (auto& Alloc : LiveAllocs)
+            pMgr->Free(std::move(Alloc));
+        EXPECT_TRUE(pMgr->IsEmpty());
+    }
+
+    // Aligned allocations
+    {
+        AllocationsManagerType Mgr{1024, Allocator};
+
+        const OffsetType Sizes[]      = {24, 40, 8, 100, 36, 64, 20, 48};
+        const OffsetType Alignments[] = {8, 32, 4, 16, 4, 64, 4, 16};
+
+        std::vector<Allocation> Allocs;
+        for (size_t i = 0; i < _countof(Sizes); ++i)
+            Allocs.push_back(Mgr.Allocate(Sizes[i], Alignments[i]));
+
+        std::vector<Allocation> LiveAllocs;
+        std::vector<OffsetType> LiveAlignments;
+        for (size_t i = 0; i < Allocs.size(); ++i)
+        {
+            if (i < 3)
+            {
+                Mgr.Free(std::move(Allocs[i]));
+            }
+            else
+            {
+                LiveAllocs.push_back(Allocs[i]);
+                LiveAlignments.push_back(Alignments[i]);
+            }
+        }
+
+        typename AllocationsManagerType::DefragmentationAttribs Attribs;
+        Attribs.pAllocations   = LiveAllocs.data();
+        Attribs.pAlignments    = LiveAlignments.data();
+        Attribs.NumAllocations = LiveAllocs.size();
+
+        const auto Moves = Mgr.PlanDefragmentation(Attribs);
+        EXPECT_FALSE(Moves.empty());
+        for (const auto& Move : Moves)
+        {
+            const auto& SrcAlloc  = LiveAllocs[Move.AllocationIndex];
+            const auto  Alignment = LiveAlignments[Move.AllocationIndex];
+            EXPECT_EQ(Move.SrcOffset % Alignment, OffsetType{0});
+            EXPECT_EQ(Move.DstOffset % Alignment, OffsetType{0});
+            EXPECT_EQ(Move.CopySize, AlignUp(Sizes[Move.AllocationIndex + 3], Alignment));
+            EXPECT_EQ(Move.SrcOffset + Move.CopySize, SrcAlloc.UnalignedOffset + SrcAlloc.Size);
+            EXPECT_EQ(Move.DstOffset + Move.CopySize, Move.NewAllocation.UnalignedOffset + Move.NewAllocation.Size);
+            EXPECT_LE(Move.NewAllocation.UnalignedOffset + Move.NewAllocation.Size, SrcAlloc.UnalignedOffset);
+        }
+
+        for (const auto& Move : Moves)
+        {
+            Mgr.Free(std::move(LiveAllocs[Move.AllocationIndex]));
+            LiveAllocs[Move.AllocationIndex] = Move.NewAllocation;
+        }
+        for (auto& Alloc : LiveAllocs)
+            Mgr.Free(std::move(Alloc));
+        EXPECT_TRUE(Mgr.IsEmpty());
+    }
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree)
+{
+    TestAllocateFree<VariableSizeAllocationsManager>();
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
+{
+    TestFreeOrder<VariableSizeAllocationsManager>();
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Free)
+{
+    TestFree<VariableSizeGPUAllocationsManager>();
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, PlanDefragmentation)
+{
+    TestPlanDefragmentation<VariableSizeAllocationsManager>();
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, AllocateFree)
+{
+    TestAllocateFree<TLSFAllocationsManager>();
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, FreeOrder)
+{
+    TestFreeOrder<TLSFAllocationsManager>();
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, Free)
+{
+    TestFree<TLSFGPUAllocationsManager>();
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, PlanDefragmentation)
+{
+    TestPlanDefragmentation<TLSFAllocationsManager>();
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, Fragmentation)
+{
+    auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
+    using OffsetType = TLSFAllocationsManager::OffsetType;
+
+    constexpr size_t NumBlocks = 64;
+    constexpr size_t BlockSize = 96;
+
+    TLSFAllocationsManager Mgr{NumBlocks * BlockSize, Allocator};
+
+    std::vector<TLSFAllocationsManager::Allocation> Allocs(NumBlocks);
+    for (auto& Alloc : Allocs)
+    {
+        Alloc = Mgr.Allocate(BlockSize, 1);
+        ASSERT_TRUE(Alloc.IsValid());
+    }
+    EXPECT_TRUE(Mgr.IsFull());
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{0});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), OffsetType{0});
+
+    // Free every other block to create holes that cannot be merged
+    for (size_t i = 0; i < NumBlocks; i += 2)
+        Mgr.Free(std::move(Allocs[i]));
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), NumBlocks / 2);
+    EXPECT_EQ(Mgr.GetFreeSize(), NumBlocks / 2 * BlockSize);
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), OffsetType{BlockSize});
+
+    // Half of the memory is free, but there is no contiguous range to accommodate the request
+    EXPECT_FALSE(Mgr.Allocate(BlockSize + 1, 1).IsValid());
+
+    // Requests that exactly match the hole size must be satisfied even though
+    // no size class above the one of the request is populated
+    for (size_t i = 0; i < NumBlocks; i += 2)
+    {
+        Allocs[i] = Mgr.Allocate(BlockSize, 1);
+        ASSERT_TRUE(Allocs[i].IsValid());
+        EXPECT_EQ(Allocs[i].Size, OffsetType{BlockSize});
+    }
+    EXPECT_TRUE(Mgr.IsFull());
+
+    // Freeing the blocks in the middle merges the neighbors into a single block
+    for (size_t i = 1; i < NumBlocks - 1; ++i)
+        Mgr.Free(std::move(Allocs[i]));
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), OffsetType{(NumBlocks - 2) * BlockSize});
+
+    Mgr.Free(std::move(Allocs.back()));
+    Mgr.Free(std::move(Allocs.front()));
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+}
+
+// Performs a random sequence of allocations and deallocations and
+// checks that live allocations are properly sized and do not overlap.
+TEST(GraphicsAccessories_TLSFAllocationsManager, Random)
+{
+    auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
+    using OffsetType = TLSFAllocationsManager::OffsetType;
+
+    constexpr OffsetType MaxSize = 1 << 16;
+
+    TLSFAllocationsManager TLSFMgr{MaxSize, Allocator};
+
+    struct AllocationInfo
+    {
+        TLSFAllocationsManager::Allocation Alloc;
+        OffsetType                         Size;
+        OffsetType                         Alignment;
+    };
+    std::vector<AllocationInfo> Allocs;
+
+    FastRandInt RndSize{0, 1, 1024};
+    FastRandInt RndAlignLog2{1, 0, 6};
+    FastRandInt RndOp{2, 0, 99};
+    FastRand    RndIdx{3};
+
+    for (size_t i = 0; i < 20000; ++i)
+    {
+        if (Allocs.empty() || RndOp() < 55)
+        {
+            const auto Size      = static_cast<OffsetType>(RndSize());
+            const auto Alignment = OffsetType{1} << RndAlignLog2();
+
+            const auto Alloc = TLSFMgr.Allocate(Size, Alignment);
+            if (!Alloc.IsValid())
+            {
+                // Allocation may only fail if there is no block that can accommodate the request
+                EXPECT_LT(TLSFMgr.GetMaxFreeBlockSize(), AlignUp(Size, Alignment) + Alignment);
+                continue;
+            }
+            EXPECT_GE(Alloc.Size, AlignUp(Size, Alignment));
+            EXPECT_LE(AlignUp(Alloc.UnalignedOffset, Alignment) + Size, Alloc.UnalignedOffset + Alloc.Size);
+
+            Allocs.push_back({Alloc, Size, Alignment});
+        }
+        else
+        {
+            const auto Idx = RndIdx() % Allocs.size();
+            TLSFMgr.Free(std::move(Allocs[Idx].Alloc));
+            std::swap(Allocs[Idx], Allocs.back());
+            Allocs.pop_back();
+        }
+    }
+
+    std::sort(Allocs.begin(), Allocs.end(),
+              [](const AllocationInfo& lhs, const AllocationInfo& rhs) {
+                  return lhs.Alloc.UnalignedOffset < rhs.Alloc.UnalignedOffset;
+              });
+    OffsetType UsedSize = 0;
+    for (size_t i = 0; i < Allocs.size(); ++i)
+    {
+        const auto& Alloc = Allocs[i].Alloc;
+        EXPECT_LE(Alloc.UnalignedOffset + Alloc.Size, MaxSize);
+        if (i + 1 < Allocs.size())
+            EXPECT_LE(Alloc.UnalignedOffset + Alloc.Size, Allocs[i + 1].Alloc.UnalignedOffset) << "Overlapping allocations";
+        UsedSize += Alloc.Size;
+    }
+    EXPECT_EQ(TLSFMgr.GetUsedSize(), UsedSize);
+
+    for (auto& Alloc : Allocs)
+        TLSFMgr.Free(std::move(Alloc.Alloc));
+    EXPECT_TRUE(TLSFMgr.IsEmpty());
+    EXPECT_EQ(TLSFMgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(TLSFMgr.GetMaxFreeBlockSize(), MaxSize);
+}
+
 } // namespace
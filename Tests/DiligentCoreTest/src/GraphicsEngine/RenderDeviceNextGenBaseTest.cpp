@@ -0,0 +1,213 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "RenderDeviceNextGenBase.hpp"
+#include "GraphicsTypes.h"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include <atomic>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class TestRenderDeviceBase
+{
+public:
+    TestRenderDeviceBase(IReferenceCounters*,
+                         IMemoryAllocator& RawMemAllocator,
+                         IEngineFactory*,
+                         const EngineCreateInfo&,
+                         const GraphicsAdapterInfo&) :
+        m_RawMemAllocator{RawMemAllocator}
+    {}
+
+protected:
+    IMemoryAllocator& m_RawMemAllocator;
+};
+
+// Command queue whose fence is only signaled when the test says so.
+class TestCommandQueue
+{
+public:
+    void AddRef() {}
+    void Release() {}
+
+    Uint64 Submit()
+    {
+        return m_NextFenceValue++;
+    }
+
+    Uint64 WaitForIdle()
+    {
+        m_CompletedFenceValue = m_NextFenceValue - 1;
+        return m_CompletedFenceValue;
+    }
+
+    Uint64 GetCompletedFenceValue() const
+    {
+        return m_CompletedFenceValue;
+    }
+
+    Uint64 GetNextFenceValue() const
+    {
+        return m_NextFenceValue;
+    }
+
+    void SignalAll()
+    {
+        m_CompletedFenceValue = m_NextFenceValue - 1;
+    }
+
+private:
+    Uint64 m_NextFenceValue      = 1;
+    Uint64 m_CompletedFenceValue = 0;
+};
+
+class TestRenderDevice final : public RenderDeviceNextGenBase<TestRenderDeviceBase, TestCommandQueue>
+{
+public:
+    using TBase = RenderDeviceNextGenBase<TestRenderDeviceBase, TestCommandQueue>;
+
+    TestRenderDevice(size_t CmdQueueCount, TestCommandQueue** Queues) :
+        TBase{nullptr, DefaultRawMemoryAllocator::GetAllocator(), nullptr, CmdQueueCount, Queues, EngineCreateInfo{}, GraphicsAdapterInfo{}}
+    {}
+};
+
+class TestResource
+{
+public:
+    explicit TestResource(std::atomic<Uint32>& NumDestroyed) :
+        m_pNumDestroyed{&NumDestroyed}
+    {}
+
+    TestResource(TestResource&& Other) noexcept :
+        m_pNumDestroyed{Other.m_pNumDestroyed}
+    {
+        Other.m_pNumDestroyed = nullptr;
+    }
+
+    // clang-format off
+    TestResource           (const TestResource&) = delete;
+    TestResource& operator=(const TestResource&) = delete;
+    TestResource& operator=(TestResource&&)      = delete;
+    // clang-format on
+
+    ~TestResource()
+    {
+        if (m_pNumDestroyed != nullptr)
+            m_pNumDestroyed->fetch_add(1);
+    }
+
+private:
+    std::atomic<Uint32>* m_pNumDestroyed;
+};
+
+TEST(RenderDeviceNextGenBaseTest, ReleaseQueuePurgeBudget)
+{
+    TestCommandQueue  Queue;
+    TestCommandQueue* pQueues[] = {&Queue};
+    TestRenderDevice  Device{1, pQueues};
+
+    Device.ConfigureReleaseQueues(2, false);
+
+    std::atomic<Uint32> NumDestroyed{0};
+    for (Uint32 i = 0; i < 5; ++i)
+        Device.SafeReleaseDeviceObject(TestResource{NumDestroyed}, 1);
+
+    auto Stats = Device.GetReleaseQueueStats();
+    EXPECT_EQ(Stats.StaleResourceCount, size_t{5});
+    EXPECT_EQ(Stats.PendingReleaseResourceCount, size_t{0});
+
+    Device.SubmitCommandBuffer(SoftwareQueueIndex{0}, true);
+    Stats = Device.GetReleaseQueueStats();
+    EXPECT_EQ(Stats.StaleResourceCount, size_t{0});
+    EXPECT_EQ(Stats.PendingReleaseResourceCount, size_t{5});
+
+    // The fence has not been reached yet
+    Device.PurgeReleaseQueues();
+    EXPECT_EQ(NumDestroyed.load(), Uint32{0});
+
+    Queue.SignalAll();
+    Device.PurgeReleaseQueues();
+    EXPECT_EQ(NumDestroyed.load(), Uint32{2});
+    Device.PurgeReleaseQueues();
+    EXPECT_EQ(NumDestroyed.load(), Uint32{4});
+
+    Stats = Device.GetReleaseQueueStats();
+    EXPECT_EQ(Stats.PendingReleaseResourceCount, size_t{1});
+    EXPECT_EQ(Stats.ReleasedResourceCount, Uint64{4});
+
+    // Forced release ignores the budget
+    Device.ConfigureReleaseQueues(1, false);
+    Device.PurgeReleaseQueues(true);
+    EXPECT_EQ(NumDestroyed.load(), Uint32{5});
+
+    Stats = Device.GetReleaseQueueStats();
+    EXPECT_EQ(Stats.PendingReleaseResourceCount, size_t{0});
+    EXPECT_EQ(Stats.ReleasedResourceCount, Uint64{5});
+    EXPECT_GE(Stats.MaxReleaseLatency, Stats.AvgReleaseLatency);
+}
+
+TEST(RenderDeviceNextGenBaseTest, BackgroundRelease)
+{
+    TestCommandQueue  Queue0;
+    TestCommandQueue  Queue1;
+    TestCommandQueue* pQueues[] = {&Queue0, &Queue1};
+    TestRenderDevice  Device{2, pQueues};
+
+    Device.ConfigureReleaseQueues(0, true);
+    for (Uint32 q = 0; q < 2; ++q)
+        EXPECT_TRUE(Device.GetReleaseQueue(SoftwareQueueIndex{q}).IsBackgroundReleaseEnabled());
+
+    constexpr Uint32    NumResources = 64;
+    std::atomic<Uint32> NumDestroyed{0};
+    for (Uint32 i = 0; i < NumResources; ++i)
+    {
+        // Every other resource is shared by both queues
+        Device.SafeReleaseDeviceObject(TestResource{NumDestroyed}, (i % 2) == 0 ? 3 : 1);
+    }
+
+    // Idling the queues waits for the background worker
+    Device.IdleAllCommandQueues(true);
+    EXPECT_EQ(NumDestroyed.load(), NumResources);
+
+    const auto Stats = Device.GetReleaseQueueStats();
+    EXPECT_EQ(Stats.StaleResourceCount, size_t{0});
+    EXPECT_EQ(Stats.PendingReleaseResourceCount, size_t{0});
+    EXPECT_EQ(Stats.BackgroundReleaseResourceCount, size_t{0});
+    // Shared resources are released once by each queue
+    EXPECT_EQ(Stats.ReleasedResourceCount, Uint64{NumResources + NumResources / 2});
+
+    Device.ConfigureReleaseQueues(0, false);
+    for (Uint32 q = 0; q < 2; ++q)
+        EXPECT_FALSE(Device.GetReleaseQueue(SoftwareQueueIndex{q}).IsBackgroundReleaseEnabled());
+}
+
+} // namespace
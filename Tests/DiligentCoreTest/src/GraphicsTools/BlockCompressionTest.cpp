@@ -0,0 +1,789 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BlockCompression.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "GraphicsAccessories.hpp"
+#include "ThreadPool.hpp"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr TEXTURE_FORMAT RGBAFormats[] = {
+    TEX_FORMAT_BC1_UNORM,
+    TEX_FORMAT_BC2_UNORM,
+    TEX_FORMAT_BC3_UNORM,
+    TEX_FORMAT_BC7_UNORM,
+};
+
+size_t GetCompressedStride(TEXTURE_FORMAT Format, Uint32 Width)
+{
+    return size_t{(Width + 3) / 4} * GetTextureFormatAttribs(Format).GetElementSize();
+}
+
+size_t GetCompressedSize(TEXTURE_FORMAT Format, Uint32 Width, Uint32 Height)
+{
+    return GetCompressedStride(Format, Width) * ((Height + 3) / 4);
+}
+
+std::vector<Uint8> Compress(TEXTURE_FORMAT            Format,
+                            const std::vector<Uint8>& Texels,
+                            TEXTURE_FORMAT            TexelFormat,
+                            Uint32                    Width,
+                            Uint32                    Height,
+                            BLOCK_COMPRESSION_QUALITY Quality,
+                            IThreadPool*              pThreadPool = nullptr)
+{
+    std::vector<Uint8> Blocks(GetCompressedSize(Format, Width, Height));
+
+    CompressTextureDataAttribs Attribs;
+    Attribs.Width       = Width;
+    Attribs.Height      = Height;
+    Attribs.SrcFormat   = TexelFormat;
+    Attribs.pSrcData    = Texels.data();
+    Attribs.SrcStride   = size_t{Width} * GetTextureFormatAttribs(TexelFormat).GetElementSize();
+    Attribs.DstFormat   = Format;
+    Attribs.pDstData    = Blocks.data();
+    Attribs.DstStride   = GetCompressedStride(Format, Width);
+    Attribs.Quality     = Quality;
+    Attribs.pThreadPool = pThreadPool;
+    EXPECT_TRUE(CompressTextureData(Attribs));
+    return Blocks;
+}
+
+std::vector<Uint8> Decompress(TEXTURE_FORMAT            Format,
+                              const std::vector<Uint8>& Blocks,
+                              TEXTURE_FORMAT            TexelFormat,
+                              Uint32                    Width,
+                              Uint32                    Height)
+{
+    const size_t       Stride = size_t{Width} * GetTextureFormatAttribs(TexelFormat).GetElementSize();
+    std::vector<Uint8> Texels(Stride * Height);
+
+    DecompressTextureDataAttribs Attribs;
+    Attribs.Width     = Width;
+    Attribs.Height    = Height;
+    Attribs.SrcFormat = Format;
+    Attribs.pSrcData  = Blocks.data();
+    Attribs.SrcStride = GetCompressedStride(Format, Width);
+    Attribs.DstFormat = TexelFormat;
+    Attribs.pDstData  = Texels.data();
+    Attribs.DstStride = Stride;
+    EXPECT_TRUE(DecompressTextureData(Attribs));
+    return Texels;
+}
+
+// Smooth RGBA image with some noise
+std::vector<Uint8> GenerateImage(Uint32 Width, Uint32 Height, Uint32 NumChannels, int Noise)
+{
+    FastRandInt        Rnd{0, -std::max(Noise, 1), std::max(Noise, 1)};
+    std::vector<Uint8> Texels(size_t{Width} * Height * NumChannels);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                const float u   = static_cast<float>(x) / static_cast<float>(Width);
+                const float v   = static_cast<float>(y) / static_cast<float>(Height);
+                const float Val = 127.5f + 127.5f * std::sin((2.f + 0.5f * static_cast<float>(c)) * u + 1.5f * v + static_cast<float>(c));
+
+                Texels[(size_t{y} * Width + x) * NumChannels + c] = static_cast<Uint8>(std::min(std::max(static_cast<int>(Val) + (Noise > 0 ? Rnd() : 0), 0), 255));
+            }
+        }
+    }
+    return Texels;
+}
+
+double ComputeRMSE(const std::vector<Uint8>& Ref, const std::vector<Uint8>& Data, Uint32 NumChannels, Uint32 Channel)
+{
+    double Sum   = 0;
+    size_t Count = 0;
+    for (size_t i = Channel; i < Ref.size(); i += NumChannels)
+    {
+        const double Diff = static_cast<double>(Ref[i]) - static_cast<double>(Data[i]);
+        Sum += Diff * Diff;
+        ++Count;
+    }
+    return std::sqrt(Sum / static_cast<double>(Count));
+}
+
+// Writes bit fields of a block starting with the least significant bit
+class BlockBuilder
+{
+public:
+    BlockBuilder& Write(Uint32 Value, Uint32 NumBits)
+    {
+        for (Uint32 i = 0; i < NumBits; ++i, ++m_Pos)
+            Block[m_Pos / 8] |= static_cast<Uint8>(((Value >> i) & 0x01) << (m_Pos % 8));
+        return *this;
+    }
+
+    std::vector<Uint8> Block = std::vector<Uint8>(16);
+
+private:
+    Uint32 m_Pos = 0;
+};
+
+TEST(BlockCompressionTest, IsSupported)
+{
+    for (TEXTURE_FORMAT Format : {TEX_FORMAT_BC1_UNORM, TEX_FORMAT_BC1_UNORM_SRGB, TEX_FORMAT_BC2_UNORM, TEX_FORMAT_BC2_UNORM_SRGB,
+                                  TEX_FORMAT_BC3_UNORM, TEX_FORMAT_BC3_UNORM_SRGB, TEX_FORMAT_BC4_UNORM, TEX_FORMAT_BC4_SNORM,
+                                  TEX_FORMAT_BC5_UNORM, TEX_FORMAT_BC5_SNORM, TEX_FORMAT_BC7_UNORM, TEX_FORMAT_BC7_UNORM_SRGB})
+    {
+        EXPECT_TRUE(IsBlockCompressionSupported(Format)) << GetTextureFormatAttribs(Format).Name;
+    }
+
+    for (TEXTURE_FORMAT Format : {TEX_FORMAT_UNKNOWN, TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_BC1_TYPELESS, TEX_FORMAT_BC6H_UF16, TEX_FORMAT_BC6H_SF16})
+    {
+        EXPECT_FALSE(IsBlockCompressionSupported(Format)) << GetTextureFormatAttribs(Format).Name;
+    }
+
+    // BC6H can only be decompressed
+    for (TEXTURE_FORMAT Format : {TEX_FORMAT_BC1_UNORM, TEX_FORMAT_BC4_SNORM, TEX_FORMAT_BC7_UNORM_SRGB, TEX_FORMAT_BC6H_UF16, TEX_FORMAT_BC6H_SF16})
+    {
+        EXPECT_TRUE(IsBlockDecompressionSupported(Format)) << GetTextureFormatAttribs(Format).Name;
+    }
+
+    for (TEXTURE_FORMAT Format : {TEX_FORMAT_UNKNOWN, TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_BC1_TYPELESS, TEX_FORMAT_BC6H_TYPELESS})
+    {
+        EXPECT_FALSE(IsBlockDecompressionSupported(Format)) << GetTextureFormatAttribs(Format).Name;
+    }
+
+    // Integer formats can't be converted to the block texel format
+    std::vector<Uint8>         Texels(64);
+    std::vector<Uint8>         Blocks(8);
+    CompressTextureDataAttribs Attribs;
+    Attribs.Width     = 4;
+    Attribs.Height    = 4;
+    Attribs.SrcFormat = TEX_FORMAT_RGBA8_UINT;
+    Attribs.pSrcData  = Texels.data();
+    Attribs.SrcStride = 16;
+    Attribs.DstFormat = TEX_FORMAT_BC1_UNORM;
+    Attribs.pDstData  = Blocks.data();
+    Attribs.DstStride = 8;
+    EXPECT_FALSE(CompressTextureData(Attribs));
+
+    Attribs.SrcFormat = TEX_FORMAT_RGBA8_UNORM;
+    Attribs.DstFormat = TEX_FORMAT_BC6H_UF16;
+    EXPECT_FALSE(CompressTextureData(Attribs));
+}
+
+TEST(BlockCompressionTest, DecodeBC1)
+{
+    // c0 = pure red, c1 = pure blue
+    const Uint32 Red  = 0xF800;
+    const Uint32 Blue = 0x001F;
+
+    // Four-color mode: indices 0, 1, 2, 3 repeated
+    std::vector<Uint8> Block = {
+        static_cast<Uint8>(Red & 0xFF), static_cast<Uint8>(Red >> 8),
+        static_cast<Uint8>(Blue & 0xFF), static_cast<Uint8>(Blue >> 8),
+        0xE4, 0xE4, 0xE4, 0xE4};
+
+    const std::array<std::array<Uint8, 4>, 4> FourColors = {{
+        {255, 0, 0, 255},
+        {0, 0, 255, 255},
+        {170, 0, 85, 255},
+        {85, 0, 170, 255},
+    }};
+
+    std::vector<Uint8> Texels = Decompress(TEX_FORMAT_BC1_UNORM, Block, TEX_FORMAT_RGBA8_UNORM, 4, 4);
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            EXPECT_EQ(Texels[i * 4 + c], FourColors[i % 4][c]) << "texel " << i << " channel " << c;
+    }
+
+    // Three-color mode: swap the endpoints
+    std::swap(Block[0], Block[2]);
+    std::swap(Block[1], Block[3]);
+
+    const std::array<std::array<Uint8, 4>, 4> ThreeColors = {{
+        {0, 0, 255, 255},
+        {255, 0, 0, 255},
+        {128, 0, 128, 255},
+        {0, 0, 0, 0},
+    }};
+
+    Texels = Decompress(TEX_FORMAT_BC1_UNORM, Block, TEX_FORMAT_RGBA8_UNORM, 4, 4);
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            EXPECT_EQ(Texels[i * 4 + c], ThreeColors[i % 4][c]) << "texel " << i << " channel " << c;
+    }
+
+    // BC2 color blocks always use four colors
+    std::vector<Uint8> BC2Block(16, 0xFF);
+    std::copy(Block.begin(), Block.end(), BC2Block.begin() + 8);
+    Texels = Decompress(TEX_FORMAT_BC2_UNORM, BC2Block, TEX_FORMAT_RGBA8_UNORM, 4, 4);
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        EXPECT_EQ(Texels[i * 4 + 0], FourColors[i % 4][2]) << "texel " << i;
+        EXPECT_EQ(Texels[i * 4 + 2], FourColors[i % 4][0]) << "texel " << i;
+        EXPECT_EQ(Texels[i * 4 + 3], 255) << "texel " << i;
+    }
+}
+
+TEST(BlockCompressionTest, DecodeBC4)
+{
+    // Eight-value mode: e0 = 210 > e1 = 0
+    BlockBuilder Builder;
+    Builder.Write(210, 8).Write(0, 8);
+    for (Uint32 i = 0; i < 16; ++i)
+        Builder.Write(i % 8, 3);
+
+    const Uint8 EightValues[] = {210, 0, 180, 150, 120, 90, 60, 30};
+
+    std::vector<Uint8> Texels = Decompress(TEX_FORMAT_BC4_UNORM, std::vector<Uint8>(Builder.Block.begin(), Builder.Block.begin() + 8), TEX_FORMAT_R8_UNORM, 4, 4);
+    for (Uint32 i = 0; i < 16; ++i)
+        EXPECT_EQ(Texels[i], EightValues[i % 8]) << "texel " << i;
+
+    // Six-value mode: e0 = 50 <= e1 = 100
+    BlockBuilder Builder6;
+    Builder6.Write(50, 8).Write(100, 8);
+    for (Uint32 i = 0; i < 16; ++i)
+        Builder6.Write(i % 8, 3);
+
+    const Uint8 SixValues[] = {50, 100, 60, 70, 80, 90, 0, 255};
+
+    Texels = Decompress(TEX_FORMAT_BC4_UNORM, std::vector<Uint8>(Builder6.Block.begin(), Builder6.Block.begin() + 8), TEX_FORMAT_R8_UNORM, 4, 4);
+    for (Uint32 i = 0; i < 16; ++i)
+        EXPECT_EQ(Texels[i], SixValues[i % 8]) << "texel " << i;
+
+    // Signed six-value mode: e0 = -128 (maps to -127), e1 = 3
+    BlockBuilder BuilderS;
+    BuilderS.Write(0x80, 8).Write(3, 8);
+    for (Uint32 i = 0; i < 16; ++i)
+        BuilderS.Write(i % 8, 3);
+
+    const Int8 SignedValues[] = {-127, 3, -101, -75, -49, -23, -127, 127};
+
+    Texels = Decompress(TEX_FORMAT_BC4_SNORM, std::vector<Uint8>(BuilderS.Block.begin(), BuilderS.Block.begin() + 8), TEX_FORMAT_R8_SNORM, 4, 4);
+    for (Uint32 i = 0; i < 16; ++i)
+        EXPECT_EQ(static_cast<Int8>(Texels[i]), SignedValues[i % 8]) << "texel " << i;
+}
+
+TEST(BlockCompressionTest, DecodeBC7)
+{
+    // Mode 6: one subset, RGBA 7-bit endpoints with p-bits, 4-bit indices
+    {
+        BlockBuilder Builder;
+        Builder.Write(1 << 6, 7);
+        Builder.Write(0, 7).Write(127, 7); // R
+        Builder.Write(64, 7).Write(64, 7); // G
+        Builder.Write(127, 7).Write(0, 7); // B
+        Builder.Write(127, 7).Write(0, 7); // A
+        Builder.Write(0, 1).Write(1, 1);   // P-bits
+        // Anchor index has 3 bits
+        Builder.Write(0, 3);
+        for (Uint32 i = 1; i < 16; ++i)
+            Builder.Write(i, 4);
+
+        const std::vector<Uint8> Texels = Decompress(TEX_FORMAT_BC7_UNORM, Builder.Block, TEX_FORMAT_RGBA8_UNORM, 4, 4);
+
+        static constexpr Uint32 Weights[] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            // E0 = (0, 128, 254, 254), E1 = (255, 129, 1, 1)
+            const Uint32 w = Weights[i];
+            EXPECT_EQ(Texels[i * 4 + 0], ((64 - w) * 0 + w * 255 + 32) >> 6) << "texel " << i;
+            EXPECT_EQ(Texels[i * 4 + 1], ((64 - w) * 128 + w * 129 + 32) >> 6) << "texel " << i;
+            EXPECT_EQ(Texels[i * 4 + 2], ((64 - w) * 254 + w * 1 + 32) >> 6) << "texel " << i;
+            EXPECT_EQ(Texels[i * 4 + 3], ((64 - w) * 254 + w * 1 + 32) >> 6) << "texel " << i;
+        }
+    }
+
+    // Mode 1, partition 13: the lower two rows belong to subset 1
+    {
+        BlockBuilder Builder;
+        Builder.Write(1 << 1, 2);
+        Builder.Write(13, 6);
+        // Subset 0 is red, subset 1 is green. Endpoints are the same within a subset.
+        Builder.Write(63, 6).Write(63, 6).Write(0, 6).Write(0, 6); // R
+        Builder.Write(0, 6).Write(0, 6).Write(32, 6).Write(32, 6); // G
+        Builder.Write(0, 6).Write(0, 6).Write(0, 6).Write(0, 6);   // B
+        Builder.Write(1, 1).Write(0, 1);                           // Shared p-bits
+        for (Uint32 i = 0; i < 16; ++i)
+            Builder.Write(0, (i == 0 || i == 15) ? 2 : 3); // Anchors are 0 and 15
+
+        const std::vector<Uint8> Texels = Decompress(TEX_FORMAT_BC7_UNORM, Builder.Block, TEX_FORMAT_RGBA8_UNORM, 4, 4);
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            if (i < 8)
+            {
+                // P-bit applies to all channels: (0 << 1 | 1) = 1 in 7 bits expands to 2
+                EXPECT_EQ(Texels[i * 4 + 0], 255) << "texel " << i;
+                EXPECT_EQ(Texels[i * 4 + 1], 2) << "texel " << i;
+                EXPECT_EQ(Texels[i * 4 + 2], 2) << "texel " << i;
+            }
+            else
+            {
+                // (32 << 1 | 0) = 64 in 7 bits expands to 129
+                EXPECT_EQ(Texels[i * 4 + 0], 0) << "texel " << i;
+                EXPECT_EQ(Texels[i * 4 + 1], 129) << "texel " << i;
+                EXPECT_EQ(Texels[i * 4 + 2], 0) << "texel " << i;
+            }
+            EXPECT_EQ(Texels[i * 4 + 3], 255) << "texel " << i;
+        }
+    }
+
+    // Mode 5 with rotation 1 (swap R and A): one subset, 7-bit color, 8-bit alpha, separate 2-bit indices
+    {
+        BlockBuilder Builder;
+        Builder.Write(1 << 5, 6);
+        Builder.Write(1, 2);                 // Rotation
+        Builder.Write(127, 7).Write(127, 7); // R
+        Builder.Write(0, 7).Write(0, 7);     // G
+        Builder.Write(0, 7).Write(0, 7);     // B
+        Builder.Write(10, 8).Write(10, 8);   // A
+        Builder.Write(0, 1);                 // Color anchor index
+        for (Uint32 i = 1; i < 16; ++i)
+            Builder.Write(0, 2);
+        Builder.Write(0, 1); // Alpha anchor index
+        for (Uint32 i = 1; i < 16; ++i)
+            Builder.Write(0, 2);
+
+        const std::vector<Uint8> Texels = Decompress(TEX_FORMAT_BC7_UNORM, Builder.Block, TEX_FORMAT_RGBA8_UNORM, 4, 4);
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            EXPECT_EQ(Texels[i * 4 + 0], 10) << "texel " << i;
+            EXPECT_EQ(Texels[i * 4 + 1], 0) << "texel " << i;
+            EXPECT_EQ(Texels[i * 4 + 2], 0) << "texel " << i;
+            EXPECT_EQ(Texels[i * 4 + 3], 255) << "texel " << i;
+        }
+    }
+
+    // Reserved mode decodes to transparent black
+    {
+        std::vector<Uint8> Block(16, 0);
+        Block[1] = 0xFF;
+
+        const std::vector<Uint8> Texels = Decompress(TEX_FORMAT_BC7_UNORM, Block, TEX_FORMAT_RGBA8_UNORM, 4, 4);
+        for (Uint8 Val : Texels)
+            EXPECT_EQ(Val, 0);
+    }
+}
+
+TEST(BlockCompressionTest, DecodeBC6H)
+{
+    const auto Decode = [](TEXTURE_FORMAT Format, const std::vector<Uint8>& Block) {
+        const std::vector<Uint8> Texels = Decompress(Format, Block, TEX_FORMAT_RGBA16_FLOAT, 4, 4);
+
+        std::vector<Uint16> Halfs(Texels.size() / 2);
+        std::memcpy(Halfs.data(), Texels.data(), Texels.size());
+        return Halfs;
+    };
+
+    // Mode 0x03, unsigned: one region, 10-bit endpoints that are not transformed, 4-bit indices
+    {
+        BlockBuilder Builder;
+        Builder.Write(0x03, 5);
+        Builder.Write(0, 10).Write(512, 10).Write(1023, 10); // E0
+        Builder.Write(1023, 10).Write(512, 10).Write(0, 10); // E1
+        // Anchor index has 3 bits
+        Builder.Write(0, 3);
+        for (Uint32 i = 1; i < 16; ++i)
+            Builder.Write(i, 4);
+
+        const std::vector<Uint16> Texels = Decode(TEX_FORMAT_BC6H_UF16, Builder.Block);
+
+        // 0 and 1023 are unquantized to 0 and 0xFFFF, 512 is unquantized to 32800
+        static constexpr Uint32 Weights[] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            const Uint32 w = Weights[i];
+            EXPECT_EQ(Texels[i * 4 + 0], ((((64 - w) * 0 + w * 0xFFFF + 32) >> 6) * 31) >> 6) << "texel " << i;
+            EXPECT_EQ(Texels[i * 4 + 1], 0x3E0F) << "texel " << i;
+            EXPECT_EQ(Texels[i * 4 + 2], ((((64 - w) * 0xFFFF + w * 0 + 32) >> 6) * 31) >> 6) << "texel " << i;
+            EXPECT_EQ(Texels[i * 4 + 3], 0x3C00) << "texel " << i;
+        }
+        EXPECT_EQ(Texels[0], 0);
+        EXPECT_EQ(Texels[2], 0x7BFF);
+        EXPECT_EQ(Texels[15 * 4 + 0], 0x7BFF);
+        EXPECT_EQ(Texels[15 * 4 + 2], 0);
+
+        const std::vector<Uint8> Floats = Decompress(TEX_FORMAT_BC6H_UF16, Builder.Block, TEX_FORMAT_RGBA32_FLOAT, 4, 4);
+
+        const float* pFloats = reinterpret_cast<const float*>(Floats.data());
+        EXPECT_EQ(pFloats[0], 0.f);
+        EXPECT_EQ(pFloats[2], 65504.f);
+        EXPECT_EQ(pFloats[3], 1.f);
+    }
+
+    // Mode 0x03, signed: endpoints are sign-extended
+    {
+        BlockBuilder Builder;
+        Builder.Write(0x03, 5);
+        Builder.Write(0x200, 10).Write(0, 10).Write(100, 10);     // E0 = (-512, 0, 100)
+        Builder.Write(0x1FF, 10).Write(0x3FF, 10).Write(100, 10); // E1 = (511, -1, 100)
+        // Texel 15 uses E1, all other texels use E0
+        Builder.Write(0, 3);
+        for (Uint32 i = 1; i < 16; ++i)
+            Builder.Write(i == 15 ? 15 : 0, 4);
+
+        const std::vector<Uint16> Texels = Decode(TEX_FORMAT_BC6H_SF16, Builder.Block);
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            // -512 and 511 are unquantized to -0x7FFF and 0x7FFF, -1 to -96, 100 to 6432
+            EXPECT_EQ(Texels[i * 4 + 0], i == 15 ? 0x7BFF : 0xFBFF) << "texel " << i;
+            EXPECT_EQ(Texels[i * 4 + 1], i == 15 ? 0x805D : 0x0000) << "texel " << i;
+            EXPECT_EQ(Texels[i * 4 + 2], 0x1857) << "texel " << i;
+            EXPECT_EQ(Texels[i * 4 + 3], 0x3C00) << "texel " << i;
+        }
+    }
+
+    // Mode 0x00, unsigned: two regions, 10-bit base endpoint and 5-bit deltas
+    {
+        BlockBuilder Builder;
+        Builder.Write(0x00, 2);
+        Builder.Write(1, 1).Write(0, 1).Write(0, 1);                            // g2[4], b2[4], b3[4]
+        Builder.Write(100, 10).Write(0, 10).Write(1023, 10);                    // w
+        Builder.Write(5, 5).Write(0, 1).Write(0xF, 4).Write(0, 5);              // r1, g3[4], g2[3:0], g1
+        Builder.Write(0, 1).Write(0, 4).Write(0, 5).Write(0, 1);                // b3[0], g3[3:0], b1, b3[1]
+        Builder.Write(1, 4).Write(0x1D, 5).Write(0, 1).Write(0, 5).Write(0, 1); // b2[3:0], r2, b3[2], r3, b3[3]
+        Builder.Write(0, 5);                                                    // Partition 0: the right two columns belong to region 1
+        // Texel 1 uses x, region 1 texels use y. Anchors are 0 and 15.
+        for (Uint32 i = 0; i < 16; ++i)
+            Builder.Write(i == 1 ? 7 : 0, (i == 0 || i == 15) ? 2 : 3);
+
+        // w = (100, 0, 1023), x = w + (5, 0, 0), y = w + (-3, -1, 1) wrapped to 10 bits = (97, 1023, 0)
+        const std::vector<Uint16> Texels = Decode(TEX_FORMAT_BC6H_UF16, Builder.Block);
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            if ((i % 4) >= 2)
+            {
+                EXPECT_EQ(Texels[i * 4 + 0], 0x0BCE) << "texel " << i;
+                EXPECT_EQ(Texels[i * 4 + 1], 0x7BFF) << "texel " << i;
+                EXPECT_EQ(Texels[i * 4 + 2], 0) << "texel " << i;
+            }
+            else
+            {
+                EXPECT_EQ(Texels[i * 4 + 0], i == 1 ? 0x0CC6 : 0x0C2B) << "texel " << i;
+                EXPECT_EQ(Texels[i * 4 + 1], 0) << "texel " << i;
+                EXPECT_EQ(Texels[i * 4 + 2], 0x7BFF) << "texel " << i;
+            }
+            EXPECT_EQ(Texels[i * 4 + 3], 0x3C00) << "texel " << i;
+        }
+    }
+
+    // Reserved mode decodes to opaque black
+    {
+        BlockBuilder Builder;
+        Builder.Write(0x13, 5);
+        for (TEXTURE_FORMAT Format : {TEX_FORMAT_BC6H_UF16, TEX_FORMAT_BC6H_SF16})
+        {
+            const std::vector<Uint16> Texels = Decode(Format, Builder.Block);
+            for (Uint32 i = 0; i < 16; ++i)
+            {
+                EXPECT_EQ(Texels[i * 4 + 0], 0) << "texel " << i;
+                EXPECT_EQ(Texels[i * 4 + 1], 0) << "texel " << i;
+                EXPECT_EQ(Texels[i * 4 + 2], 0) << "texel " << i;
+                EXPECT_EQ(Texels[i * 4 + 3], 0x3C00) << "texel " << i;
+            }
+        }
+    }
+}
+
+TEST(BlockCompressionTest, SolidColor)
+{
+    const std::array<Uint8, 4> Color = {{200, 100, 50, 255}};
+
+    std::vector<Uint8> Texels(4 * 4 * 4);
+    for (size_t i = 0; i < Texels.size(); ++i)
+        Texels[i] = Color[i % 4];
+
+    for (TEXTURE_FORMAT Format : RGBAFormats)
+    {
+        for (BLOCK_COMPRESSION_QUALITY Quality : {BLOCK_COMPRESSION_QUALITY_FAST, BLOCK_COMPRESSION_QUALITY_HIGH})
+        {
+            const std::vector<Uint8> Blocks  = Compress(Format, Texels, TEX_FORMAT_RGBA8_UNORM, 4, 4, Quality);
+            const std::vector<Uint8> Decoded = Decompress(Format, Blocks, TEX_FORMAT_RGBA8_UNORM, 4, 4);
+
+            // 5:6:5 endpoints can't represent the color exactly
+            const int Tolerance = Format == TEX_FORMAT_BC7_UNORM ? 1 : 4;
+            for (size_t i = 0; i < Texels.size(); ++i)
+                EXPECT_NEAR(Decoded[i], Texels[i], Tolerance) << GetTextureFormatAttribs(Format).Name << " texel " << i / 4;
+        }
+    }
+}
+
+TEST(BlockCompressionTest, RoundTripRGBA)
+{
+    // Non-multiple of the block size
+    constexpr Uint32 Width  = 37;
+    constexpr Uint32 Height = 22;
+
+    const std::vector<Uint8> Texels = GenerateImage(Width, Height, 4, 2);
+
+    for (TEXTURE_FORMAT Format : RGBAFormats)
+    {
+        double FastRMSE = 0;
+        for (BLOCK_COMPRESSION_QUALITY Quality : {BLOCK_COMPRESSION_QUALITY_FAST, BLOCK_COMPRESSION_QUALITY_HIGH})
+        {
+            std::vector<Uint8> Src = Texels;
+            if (Format == TEX_FORMAT_BC1_UNORM)
+            {
+                // BC1 only supports 1-bit alpha
+                for (size_t i = 3; i < Src.size(); i += 4)
+                    Src[i] = 255;
+            }
+
+            const std::vector<Uint8> Blocks  = Compress(Format, Src, TEX_FORMAT_RGBA8_UNORM, Width, Height, Quality);
+            const std::vector<Uint8> Decoded = Decompress(Format, Blocks, TEX_FORMAT_RGBA8_UNORM, Width, Height);
+
+            double RMSE = 0;
+            for (Uint32 c = 0; c < 3; ++c)
+                RMSE = std::max(RMSE, ComputeRMSE(Src, Decoded, 4, c));
+
+            const double AlphaRMSE = ComputeRMSE(Src, Decoded, 4, 3);
+
+            const double MaxRMSE      = Format == TEX_FORMAT_BC7_UNORM ? 3.0 : 5.0;
+            const double MaxAlphaRMSE = Format == TEX_FORMAT_BC2_UNORM ? 5.0 : 3.0;
+            EXPECT_LT(RMSE, MaxRMSE) << GetTextureFormatAttribs(Format).Name << " quality " << Quality;
+            EXPECT_LT(AlphaRMSE, MaxAlphaRMSE) << GetTextureFormatAttribs(Format).Name << " quality " << Quality;
+
+            if (Quality == BLOCK_COMPRESSION_QUALITY_FAST)
+                FastRMSE = RMSE;
+            else
+                EXPECT_LE(RMSE, FastRMSE * 1.01) << GetTextureFormatAttribs(Format).Name;
+        }
+    }
+}
+
+TEST(BlockCompressionTest, BC1Transparency)
+{
+    std::vector<Uint8> Texels = GenerateImage(32, 32, 4, 0);
+    for (size_t i = 0; i < Texels.size() / 4; ++i)
+        Texels[i * 4 + 3] = (i % 3 == 0) ? 0 : 255;
+
+    for (BLOCK_COMPRESSION_QUALITY Quality : {BLOCK_COMPRESSION_QUALITY_FAST, BLOCK_COMPRESSION_QUALITY_HIGH})
+    {
+        const std::vector<Uint8> Blocks  = Compress(TEX_FORMAT_BC1_UNORM, Texels, TEX_FORMAT_RGBA8_UNORM, 32, 32, Quality);
+        const std::vector<Uint8> Decoded = Decompress(TEX_FORMAT_BC1_UNORM, Blocks, TEX_FORMAT_RGBA8_UNORM, 32, 32);
+        for (size_t i = 0; i < Texels.size() / 4; ++i)
+        {
+            if (Texels[i * 4 + 3] == 0)
+            {
+                for (Uint32 c = 0; c < 4; ++c)
+                    EXPECT_EQ(Decoded[i * 4 + c], 0) << "texel " << i;
+            }
+            else
+            {
+                EXPECT_EQ(Decoded[i * 4 + 3], 255) << "texel " << i;
+                for (Uint32 c = 0; c < 3; ++c)
+                    EXPECT_NEAR(Decoded[i * 4 + c], Texels[i * 4 + c], 24) << "texel " << i;
+            }
+        }
+    }
+}
+
+TEST(BlockCompressionTest, RoundTripBC4BC5)
+{
+    constexpr Uint32 Width  = 30;
+    constexpr Uint32 Height = 17;
+
+    struct TestInfo
+    {
+        TEXTURE_FORMAT Format;
+        TEXTURE_FORMAT TexelFormat;
+        Uint32         NumChannels;
+    };
+    for (const TestInfo& Info : {TestInfo{TEX_FORMAT_BC4_UNORM, TEX_FORMAT_R8_UNORM, 1},
+                                 TestInfo{TEX_FORMAT_BC4_SNORM, TEX_FORMAT_R8_SNORM, 1},
+                                 TestInfo{TEX_FORMAT_BC5_UNORM, TEX_FORMAT_RG8_UNORM, 2},
+                                 TestInfo{TEX_FORMAT_BC5_SNORM, TEX_FORMAT_RG8_SNORM, 2}})
+    {
+        std::vector<Uint8> Texels = GenerateImage(Width, Height, Info.NumChannels, 3);
+        if (Info.TexelFormat == TEX_FORMAT_R8_SNORM || Info.TexelFormat == TEX_FORMAT_RG8_SNORM)
+        {
+            // -128 is decoded as -127
+            for (Uint8& Val : Texels)
+                Val = static_cast<Uint8>(std::max(static_cast<int>(Val) - 128, -127));
+        }
+
+        double FastRMSE = 0;
+        for (BLOCK_COMPRESSION_QUALITY Quality : {BLOCK_COMPRESSION_QUALITY_FAST, BLOCK_COMPRESSION_QUALITY_HIGH})
+        {
+            const std::vector<Uint8> Blocks  = Compress(Info.Format, Texels, Info.TexelFormat, Width, Height, Quality);
+            const std::vector<Uint8> Decoded = Decompress(Info.Format, Blocks, Info.TexelFormat, Width, Height);
+
+            double RMSE = 0;
+            for (Uint32 c = 0; c < Info.NumChannels; ++c)
+            {
+                if (Info.TexelFormat == TEX_FORMAT_R8_SNORM || Info.TexelFormat == TEX_FORMAT_RG8_SNORM)
+                {
+                    double Sum = 0;
+                    for (size_t i = c; i < Texels.size(); i += Info.NumChannels)
+                    {
+                        const double Diff = static_cast<double>(static_cast<Int8>(Texels[i])) - static_cast<double>(static_cast<Int8>(Decoded[i]));
+                        Sum += Diff * Diff;
+                    }
+                    RMSE = std::max(RMSE, std::sqrt(Sum / static_cast<double>(Texels.size() / Info.NumChannels)));
+                }
+                else
+                {
+                    RMSE = std::max(RMSE, ComputeRMSE(Texels, Decoded, Info.NumChannels, c));
+                }
+            }
+            EXPECT_LT(RMSE, 2.5) << GetTextureFormatAttribs(Info.Format).Name << " quality " << Quality;
+
+            if (Quality == BLOCK_COMPRESSION_QUALITY_FAST)
+                FastRMSE = RMSE;
+            else
+                EXPECT_LE(RMSE, FastRMSE * 1.01) << GetTextureFormatAttribs(Info.Format).Name;
+        }
+    }
+
+    // Two distinct values are encoded exactly
+    std::vector<Uint8> Texels(16);
+    for (size_t i = 0; i < Texels.size(); ++i)
+        Texels[i] = (i % 5 == 0) ? 17 : 231;
+
+    const std::vector<Uint8> Decoded = Decompress(TEX_FORMAT_BC4_UNORM, Compress(TEX_FORMAT_BC4_UNORM, Texels, TEX_FORMAT_R8_UNORM, 4, 4, BLOCK_COMPRESSION_QUALITY_FAST), TEX_FORMAT_R8_UNORM, 4, 4);
+    EXPECT_EQ(Decoded, Texels);
+}
+
+TEST(BlockCompressionTest, BC7TwoColorBlocks)
+{
+    // Blocks with two distinct colors in an arbitrary split can't be encoded well with one subset.
+    constexpr Uint32 Width  = 16;
+    constexpr Uint32 Height = 16;
+
+    FastRandInt        Rnd{1, 0, 255};
+    std::vector<Uint8> Texels(Width * Height * 4);
+    for (Uint32 by = 0; by < Height / 4; ++by)
+    {
+        for (Uint32 bx = 0; bx < Width / 4; ++bx)
+        {
+            const Uint8 Colors[2][3] = {
+                {static_cast<Uint8>(Rnd()), static_cast<Uint8>(Rnd()), static_cast<Uint8>(Rnd())},
+                {static_cast<Uint8>(Rnd()), static_cast<Uint8>(Rnd()), static_cast<Uint8>(Rnd())},
+            };
+            for (Uint32 y = 0; y < 4; ++y)
+            {
+                for (Uint32 x = 0; x < 4; ++x)
+                {
+                    const Uint32 Subset = (x + y >= 3) ? 1 : 0;
+                    Uint8*       pTexel = &Texels[((by * 4 + y) * Width + bx * 4 + x) * 4];
+                    pTexel[0]           = Colors[Subset][0];
+                    pTexel[1]           = Colors[Subset][1];
+                    pTexel[2]           = Colors[Subset][2];
+                    pTexel[3]           = 255;
+                }
+            }
+        }
+    }
+
+    double RMSE[2] = {};
+    for (BLOCK_COMPRESSION_QUALITY Quality : {BLOCK_COMPRESSION_QUALITY_FAST, BLOCK_COMPRESSION_QUALITY_HIGH})
+    {
+        const std::vector<Uint8> Blocks  = Compress(TEX_FORMAT_BC7_UNORM, Texels, TEX_FORMAT_RGBA8_UNORM, Width, Height, Quality);
+        const std::vector<Uint8> Decoded = Decompress(TEX_FORMAT_BC7_UNORM, Blocks, TEX_FORMAT_RGBA8_UNORM, Width, Height);
+        for (Uint32 c = 0; c < 4; ++c)
+            RMSE[Quality] = std::max(RMSE[Quality], ComputeRMSE(Texels, Decoded, 4, c));
+    }
+    EXPECT_LT(RMSE[BLOCK_COMPRESSION_QUALITY_HIGH], 2.0);
+    EXPECT_LT(RMSE[BLOCK_COMPRESSION_QUALITY_HIGH], RMSE[BLOCK_COMPRESSION_QUALITY_FAST]);
+}
+
+TEST(BlockCompressionTest, FloatData)
+{
+    // Compress floating-point data, e.g. a mip level computed in RGBA32_FLOAT, and decompress it back to float.
+    constexpr Uint32 Width  = 12;
+    constexpr Uint32 Height = 8;
+
+    std::vector<float> Texels(Width * Height * 4);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            for (Uint32 c = 0; c < 4; ++c)
+                Texels[(y * Width + x) * 4 + c] = static_cast<float>(x * (c + 1) + y) / static_cast<float>(Width * 4 + Height);
+        }
+    }
+
+    std::vector<Uint8> Src(Texels.size() * sizeof(float));
+    std::memcpy(Src.data(), Texels.data(), Src.size());
+
+    const std::vector<Uint8> Blocks  = Compress(TEX_FORMAT_BC7_UNORM, Src, TEX_FORMAT_RGBA32_FLOAT, Width, Height, BLOCK_COMPRESSION_QUALITY_HIGH);
+    const std::vector<Uint8> Decoded = Decompress(TEX_FORMAT_BC7_UNORM, Blocks, TEX_FORMAT_RGBA32_FLOAT, Width, Height);
+
+    const float* pDecoded = reinterpret_cast<const float*>(Decoded.data());
+    double       Sum      = 0;
+    for (size_t i = 0; i < Texels.size(); ++i)
+    {
+        EXPECT_GE(pDecoded[i], 0.f);
+        EXPECT_LE(pDecoded[i], 1.f);
+        Sum += (pDecoded[i] - Texels[i]) * (pDecoded[i] - Texels[i]);
+    }
+    EXPECT_LT(std::sqrt(Sum / static_cast<double>(Texels.size())), 0.01);
+}
+
+TEST(BlockCompressionTest, Parallel)
+{
+    constexpr Uint32 Width  = 509;
+    constexpr Uint32 Height = 130;
+
+    const std::vector<Uint8> Texels = GenerateImage(Width, Height, 4, 8);
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_TRUE(pThreadPool);
+
+    for (TEXTURE_FORMAT Format : RGBAFormats)
+    {
+        const std::vector<Uint8> Serial   = Compress(Format, Texels, TEX_FORMAT_RGBA8_UNORM, Width, Height, BLOCK_COMPRESSION_QUALITY_FAST);
+        const std::vector<Uint8> Parallel = Compress(Format, Texels, TEX_FORMAT_RGBA8_UNORM, Width, Height, BLOCK_COMPRESSION_QUALITY_FAST, pThreadPool);
+        EXPECT_EQ(Serial, Parallel) << GetTextureFormatAttribs(Format).Name;
+
+        std::vector<Uint8> ParallelDecoded(Texels.size());
+
+        DecompressTextureDataAttribs Attribs;
+        Attribs.Width       = Width;
+        Attribs.Height      = Height;
+        Attribs.SrcFormat   = Format;
+        Attribs.pSrcData    = Parallel.data();
+        Attribs.SrcStride   = GetCompressedStride(Format, Width);
+        Attribs.DstFormat   = TEX_FORMAT_RGBA8_UNORM;
+        Attribs.pDstData    = ParallelDecoded.data();
+        Attribs.DstStride   = Width * 4;
+        Attribs.pThreadPool = pThreadPool;
+        EXPECT_TRUE(DecompressTextureData(Attribs));
+        EXPECT_EQ(ParallelDecoded, Decompress(Format, Serial, TEX_FORMAT_RGBA8_UNORM, Width, Height)) << GetTextureFormatAttribs(Format).Name;
+    }
+}
+
+} // namespace
@@ -0,0 +1,520 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ETCDecompression.hpp"
+
+#include <vector>
+
+#include "GraphicsAccessories.hpp"
+#include "ThreadPool.hpp"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Builds a big-endian 64-bit ETC block from bit fields
+class ETCBlockBuilder
+{
+public:
+    ETCBlockBuilder& Set(Uint32 Offset, Uint32 NumBits, Uint32 Value)
+    {
+        m_Bits |= (Uint64{Value} & ((Uint64{1} << NumBits) - 1)) << Offset;
+        return *this;
+    }
+
+    // Sets the 2-bit color index of texel (x, y)
+    ETCBlockBuilder& SetIndex(Uint32 x, Uint32 y, Uint32 Index)
+    {
+        const Uint32 k = x * 4 + y;
+        return Set(k + 16, 1, Index >> 1).Set(k, 1, Index & 0x01);
+    }
+
+    // Sets the 3-bit EAC index of texel (x, y)
+    ETCBlockBuilder& SetEACIndex(Uint32 x, Uint32 y, Uint32 Index)
+    {
+        return Set(45 - (x * 4 + y) * 3, 3, Index);
+    }
+
+    std::vector<Uint8> Get() const
+    {
+        std::vector<Uint8> Block(8);
+        for (Uint32 i = 0; i < 8; ++i)
+            Block[i] = static_cast<Uint8>(m_Bits >> (56 - i * 8));
+        return Block;
+    }
+
+private:
+    Uint64 m_Bits = 0;
+};
+
+std::vector<Uint8> Decompress(ETC_FORMAT                Format,
+                              const std::vector<Uint8>& Blocks,
+                              TEXTURE_FORMAT            DstFormat,
+                              Uint32                    Width,
+                              Uint32                    Height,
+                              IThreadPool*              pThreadPool = nullptr)
+{
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(DstFormat);
+
+    const bool   IsCompressed = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED;
+    const size_t DstStride    = IsCompressed ? size_t{(Width + 3) / 4} * FmtAttribs.GetElementSize() : size_t{Width} * FmtAttribs.GetElementSize();
+    const size_t NumDstRows   = IsCompressed ? (Height + 3) / 4 : Height;
+
+    std::vector<Uint8> Texels(DstStride * NumDstRows);
+
+    DecompressETCDataAttribs Attribs;
+    Attribs.Width       = Width;
+    Attribs.Height      = Height;
+    Attribs.SrcFormat   = Format;
+    Attribs.pSrcData    = Blocks.data();
+    Attribs.SrcStride   = size_t{(Width + 3) / 4} * GetETCBlockSize(Format);
+    Attribs.DstFormat   = DstFormat;
+    Attribs.pDstData    = Texels.data();
+    Attribs.DstStride   = DstStride;
+    Attribs.pThreadPool = pThreadPool;
+    EXPECT_TRUE(DecompressETCData(Attribs));
+    return Texels;
+}
+
+std::vector<Uint8> GenerateRandomBlocks(ETC_FORMAT Format, Uint32 Width, Uint32 Height)
+{
+    FastRandInt        Rnd{0, 0, 255};
+    std::vector<Uint8> Blocks(size_t{(Width + 3) / 4} * ((Height + 3) / 4) * GetETCBlockSize(Format));
+    for (Uint8& Byte : Blocks)
+        Byte = static_cast<Uint8>(Rnd());
+    return Blocks;
+}
+
+void CheckTexel(const std::vector<Uint8>& Texels, Uint32 x, Uint32 y, int R, int G, int B, int A = 255)
+{
+    const Uint8* pTexel = &Texels[(y * 4 + x) * 4];
+    EXPECT_EQ(pTexel[0], R) << "(" << x << ", " << y << ")";
+    EXPECT_EQ(pTexel[1], G) << "(" << x << ", " << y << ")";
+    EXPECT_EQ(pTexel[2], B) << "(" << x << ", " << y << ")";
+    EXPECT_EQ(pTexel[3], A) << "(" << x << ", " << y << ")";
+}
+
+TEST(ETCDecompressionTest, BlockSize)
+{
+    EXPECT_EQ(GetETCBlockSize(ETC_FORMAT_UNKNOWN), 0u);
+    EXPECT_EQ(GetETCBlockSize(ETC_FORMAT_ETC2_RGB8), 8u);
+    EXPECT_EQ(GetETCBlockSize(ETC_FORMAT_ETC2_RGB8A1_SRGB), 8u);
+    EXPECT_EQ(GetETCBlockSize(ETC_FORMAT_ETC2_RGBA8), 16u);
+    EXPECT_EQ(GetETCBlockSize(ETC_FORMAT_EAC_R11_SNORM), 8u);
+    EXPECT_EQ(GetETCBlockSize(ETC_FORMAT_EAC_RG11_UNORM), 16u);
+}
+
+TEST(ETCDecompressionTest, IndividualMode)
+{
+    // Left subblock: (8, 4, 2) with table 0, right subblock: (1, 2, 3) with table 1
+    ETCBlockBuilder Builder;
+    Builder.Set(60, 4, 8).Set(52, 4, 4).Set(44, 4, 2);
+    Builder.Set(56, 4, 1).Set(48, 4, 2).Set(40, 4, 3);
+    Builder.Set(37, 3, 0).Set(34, 3, 1);
+    for (Uint32 y = 0; y < 4; ++y)
+        Builder.SetIndex(3, y, 3);
+
+    const std::vector<Uint8> Texels = Decompress(ETC_FORMAT_ETC2_RGB8, Builder.Get(), TEX_FORMAT_RGBA8_UNORM, 4, 4);
+    for (Uint32 y = 0; y < 4; ++y)
+    {
+        CheckTexel(Texels, 0, y, 136 + 2, 68 + 2, 34 + 2);
+        CheckTexel(Texels, 1, y, 136 + 2, 68 + 2, 34 + 2);
+        CheckTexel(Texels, 2, y, 17 + 5, 34 + 5, 51 + 5);
+        CheckTexel(Texels, 3, y, 0, 34 - 17, 51 - 17);
+    }
+}
+
+TEST(ETCDecompressionTest, DifferentialMode)
+{
+    // Top subblock: (10, 20, 30) with table 2, bottom subblock: (11, 18, 30) with table 3
+    ETCBlockBuilder Builder;
+    Builder.Set(59, 5, 10).Set(51, 5, 20).Set(43, 5, 30);
+    Builder.Set(56, 3, 1).Set(48, 3, 6).Set(40, 3, 0);
+    Builder.Set(37, 3, 2).Set(34, 3, 3);
+    Builder.Set(33, 1, 1).Set(32, 1, 1);
+    for (Uint32 x = 0; x < 4; ++x)
+        Builder.SetIndex(x, 1, 1);
+
+    const std::vector<Uint8> Texels = Decompress(ETC_FORMAT_ETC2_RGB8, Builder.Get(), TEX_FORMAT_RGBA8_UNORM, 4, 4);
+    for (Uint32 x = 0; x < 4; ++x)
+    {
+        CheckTexel(Texels, x, 0, 82 + 9, 165 + 9, 255);
+        CheckTexel(Texels, x, 1, 82 + 29, 165 + 29, 255);
+        CheckTexel(Texels, x, 2, 90 + 13, 148 + 13, 255);
+        CheckTexel(Texels, x, 3, 90 + 13, 148 + 13, 255);
+    }
+}
+
+TEST(ETCDecompressionTest, TMode)
+{
+    // The red channel overflows: R = 1, dR = -3
+    ETCBlockBuilder Builder;
+    Builder.Set(59, 2, 1).Set(58, 1, 1).Set(56, 2, 1);
+    Builder.Set(52, 4, 8).Set(48, 4, 12);
+    Builder.Set(44, 4, 2).Set(40, 4, 4).Set(36, 4, 6);
+    Builder.Set(34, 2, 2).Set(33, 1, 1).Set(32, 1, 1);
+    for (Uint32 y = 0; y < 4; ++y)
+    {
+        for (Uint32 x = 0; x < 4; ++x)
+            Builder.SetIndex(x, y, (x + y) % 4);
+    }
+
+    // Distance index 5
+    const int PaintColors[4][3] = {
+        {85, 136, 204},
+        {34 + 32, 68 + 32, 102 + 32},
+        {34, 68, 102},
+        {34 - 32, 68 - 32, 102 - 32},
+    };
+
+    const std::vector<Uint8> Texels = Decompress(ETC_FORMAT_ETC2_RGB8, Builder.Get(), TEX_FORMAT_RGBA8_UNORM, 4, 4);
+    for (Uint32 y = 0; y < 4; ++y)
+    {
+        for (Uint32 x = 0; x < 4; ++x)
+        {
+            const int* Color = PaintColors[(x + y) % 4];
+            CheckTexel(Texels, x, y, Color[0], Color[1], Color[2]);
+        }
+    }
+}
+
+TEST(ETCDecompressionTest, HMode)
+{
+    // The green channel overflows: G = 0, dG = -2
+    ETCBlockBuilder Builder;
+    Builder.Set(59, 4, 8).Set(56, 3, 1).Set(52, 1, 0).Set(51, 1, 0).Set(50, 1, 1).Set(47, 3, 4);
+    Builder.Set(43, 4, 3).Set(39, 4, 5).Set(35, 4, 7);
+    Builder.Set(34, 1, 0).Set(33, 1, 1).Set(32, 1, 1);
+    for (Uint32 y = 0; y < 4; ++y)
+    {
+        for (Uint32 x = 0; x < 4; ++x)
+            Builder.SetIndex(x, y, (x + y * 2) % 4);
+    }
+
+    // The first base color is greater than the second one, so the distance index is 3
+    const int PaintColors[4][3] = {
+        {136 + 16, 34 + 16, 68 + 16},
+        {136 - 16, 34 - 16, 68 - 16},
+        {51 + 16, 85 + 16, 119 + 16},
+        {51 - 16, 85 - 16, 119 - 16},
+    };
+
+    const std::vector<Uint8> Texels = Decompress(ETC_FORMAT_ETC2_RGB8, Builder.Get(), TEX_FORMAT_RGBA8_UNORM, 4, 4);
+    for (Uint32 y = 0; y < 4; ++y)
+    {
+        for (Uint32 x = 0; x < 4; ++x)
+        {
+            const int* Color = PaintColors[(x + y * 2) % 4];
+            CheckTexel(Texels, x, y, Color[0], Color[1], Color[2]);
+        }
+    }
+}
+
+TEST(ETCDecompressionTest, PlanarMode)
+{
+    // The blue channel overflows: B = 0, dB = -4
+    ETCBlockBuilder Builder;
+    Builder.Set(57, 6, 32).Set(49, 6, 32).Set(48, 1, 1).Set(42, 1, 1).Set(39, 3, 1);
+    Builder.Set(34, 5, 42 >> 1).Set(33, 1, 1).Set(32, 1, 42 & 0x01).Set(25, 7, 100).Set(19, 6, 10);
+    Builder.Set(13, 6, 20).Set(6, 7, 30).Set(0, 6, 63);
+
+    const int O[3] = {130, 64, 134};
+    const int H[3] = {170, 201, 40};
+    const int V[3] = {81, 60, 255};
+
+    const std::vector<Uint8> Texels = Decompress(ETC_FORMAT_ETC2_RGB8, Builder.Get(), TEX_FORMAT_RGBA8_UNORM, 4, 4);
+    for (int y = 0; y < 4; ++y)
+    {
+        for (int x = 0; x < 4; ++x)
+        {
+            int Color[3];
+            for (int c = 0; c < 3; ++c)
+                Color[c] = std::min(std::max((x * (H[c] - O[c]) + y * (V[c] - O[c]) + 4 * O[c] + 2) >> 2, 0), 255);
+            CheckTexel(Texels, x, y, Color[0], Color[1], Color[2]);
+        }
+    }
+    CheckTexel(Texels, 0, 0, 130, 64, 134);
+}
+
+TEST(ETCDecompressionTest, PunchThroughAlpha)
+{
+    // Differential block with base color (10, 20, 30) and table 2
+    ETCBlockBuilder Builder;
+    Builder.Set(59, 5, 10).Set(51, 5, 20).Set(43, 5, 30);
+    Builder.Set(37, 3, 2).Set(34, 3, 2);
+    for (Uint32 y = 0; y < 4; ++y)
+    {
+        for (Uint32 x = 0; x < 4; ++x)
+            Builder.SetIndex(x, y, x);
+    }
+
+    // The opaque bit is not set: index 0 has no modifier and index 2 is transparent black
+    {
+        const std::vector<Uint8> Texels = Decompress(ETC_FORMAT_ETC2_RGB8A1, Builder.Get(), TEX_FORMAT_RGBA8_UNORM, 4, 4);
+        for (Uint32 y = 0; y < 4; ++y)
+        {
+            CheckTexel(Texels, 0, y, 82, 165, 247);
+            CheckTexel(Texels, 1, y, 82 + 29, 165 + 29, 255);
+            CheckTexel(Texels, 2, y, 0, 0, 0, 0);
+            CheckTexel(Texels, 3, y, 82 - 29, 165 - 29, 247 - 29);
+        }
+    }
+
+    // The opaque bit is set
+    {
+        Builder.Set(33, 1, 1);
+        const std::vector<Uint8> Texels = Decompress(ETC_FORMAT_ETC2_RGB8A1, Builder.Get(), TEX_FORMAT_RGBA8_UNORM, 4, 4);
+        for (Uint32 y = 0; y < 4; ++y)
+        {
+            CheckTexel(Texels, 0, y, 82 + 9, 165 + 9, 255);
+            CheckTexel(Texels, 1, y, 82 + 29, 165 + 29, 255);
+            CheckTexel(Texels, 2, y, 82 - 9, 165 - 9, 247 - 9);
+            CheckTexel(Texels, 3, y, 82 - 29, 165 - 29, 247 - 29);
+        }
+    }
+}
+
+TEST(ETCDecompressionTest, EACAlpha)
+{
+    // Base 128, multiplier 2, table 0
+    ETCBlockBuilder Alpha;
+    Alpha.Set(56, 8, 128).Set(52, 4, 2).Set(48, 4, 0);
+    for (Uint32 y = 0; y < 4; ++y)
+    {
+        for (Uint32 x = 0; x < 4; ++x)
+            Alpha.SetEACIndex(x, y, (x * 4 + y) % 8);
+    }
+
+    // Individual block with color (8, 4, 2)
+    ETCBlockBuilder Color;
+    Color.Set(60, 4, 8).Set(52, 4, 4).Set(44, 4, 2);
+    Color.Set(56, 4, 8).Set(48, 4, 4).Set(40, 4, 2);
+
+    std::vector<Uint8> Block = Alpha.Get();
+    for (Uint8 Byte : Color.Get())
+        Block.push_back(Byte);
+
+    static constexpr int Modifiers[8] = {-3, -6, -9, -15, 2, 5, 8, 14};
+
+    const std::vector<Uint8> Texels = Decompress(ETC_FORMAT_ETC2_RGBA8, Block, TEX_FORMAT_RGBA8_UNORM, 4, 4);
+    for (Uint32 y = 0; y < 4; ++y)
+    {
+        for (Uint32 x = 0; x < 4; ++x)
+            CheckTexel(Texels, x, y, 136 + 2, 68 + 2, 34 + 2, 128 + Modifiers[(x * 4 + y) % 8] * 2);
+    }
+}
+
+TEST(ETCDecompressionTest, EAC11)
+{
+    static constexpr int Modifiers[8] = {-4, -6, -8, -9, 3, 5, 7, 8};
+
+    ETCBlockBuilder Builder;
+    Builder.Set(48, 4, 14);
+    for (Uint32 y = 0; y < 4; ++y)
+    {
+        for (Uint32 x = 0; x < 4; ++x)
+            Builder.SetEACIndex(x, y, (x + y * 4) % 8);
+    }
+
+    auto GetValues = [](const std::vector<Uint8>& Texels) {
+        std::vector<int> Values(Texels.size() / 2);
+        for (size_t i = 0; i < Values.size(); ++i)
+            Values[i] = reinterpret_cast<const Int16*>(Texels.data())[i];
+        return Values;
+    };
+
+    // Unsigned: base 100, multiplier 3
+    {
+        ETCBlockBuilder Unorm = Builder;
+        Unorm.Set(56, 8, 100).Set(52, 4, 3);
+
+        const std::vector<Uint8> Texels = Decompress(ETC_FORMAT_EAC_R11_UNORM, Unorm.Get(), TEX_FORMAT_R16_UNORM, 4, 4);
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            const int Value = 100 * 8 + 4 + Modifiers[i % 8] * 24;
+            EXPECT_EQ(reinterpret_cast<const Uint16*>(Texels.data())[i], (Value << 5) | (Value >> 6));
+        }
+    }
+
+    // Unsigned with zero multiplier: the modifiers are not scaled
+    {
+        ETCBlockBuilder Unorm = Builder;
+        Unorm.Set(56, 8, 255);
+
+        const std::vector<Uint8> Texels = Decompress(ETC_FORMAT_EAC_R11_UNORM, Unorm.Get(), TEX_FORMAT_R16_UNORM, 4, 4);
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            const int Value = std::min(255 * 8 + 4 + Modifiers[i % 8], 2047);
+            EXPECT_EQ(reinterpret_cast<const Uint16*>(Texels.data())[i], (Value << 5) | (Value >> 6));
+        }
+    }
+
+    // Signed: base -128 is clamped to -127, and the values are clamped to -1023
+    {
+        ETCBlockBuilder Snorm = Builder;
+        Snorm.Set(56, 8, 0x80).Set(52, 4, 3);
+
+        const std::vector<int> Values = GetValues(Decompress(ETC_FORMAT_EAC_R11_SNORM, Snorm.Get(), TEX_FORMAT_R16_SNORM, 4, 4));
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            const int Value = std::max(-127 * 8 + Modifiers[i % 8] * 24, -1023);
+            EXPECT_EQ(Values[i], -(((-Value) << 5) | ((-Value) >> 5)));
+        }
+        EXPECT_EQ(Values[0], -32767);
+    }
+
+    // Two channels
+    {
+        ETCBlockBuilder R = Builder;
+        R.Set(56, 8, 20).Set(52, 4, 1);
+        ETCBlockBuilder G = Builder;
+        G.Set(56, 8, 0xF0).Set(52, 4, 2);
+
+        std::vector<Uint8> Block = R.Get();
+        for (Uint8 Byte : G.Get())
+            Block.push_back(Byte);
+
+        const std::vector<int> Values = GetValues(Decompress(ETC_FORMAT_EAC_RG11_SNORM, Block, TEX_FORMAT_RG16_SNORM, 4, 4));
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            const int RValue = 20 * 8 + Modifiers[i % 8] * 8;
+            const int GValue = -16 * 8 + Modifiers[i % 8] * 16;
+            EXPECT_EQ(Values[i * 2 + 0], (RValue << 5) | (RValue >> 5));
+            EXPECT_EQ(Values[i * 2 + 1], -(((-GValue) << 5) | ((-GValue) >> 5)));
+        }
+    }
+}
+
+TEST(ETCDecompressionTest, Conversion)
+{
+    constexpr Uint32 Width  = 13;
+    constexpr Uint32 Height = 7;
+
+    // RGBA8 data is converted to other formats
+    {
+        const std::vector<Uint8> Blocks = GenerateRandomBlocks(ETC_FORMAT_ETC2_RGBA8, Width, Height);
+        const std::vector<Uint8> RGBA8  = Decompress(ETC_FORMAT_ETC2_RGBA8, Blocks, TEX_FORMAT_RGBA8_UNORM, Width, Height);
+        const std::vector<Uint8> RGBA32 = Decompress(ETC_FORMAT_ETC2_RGBA8, Blocks, TEX_FORMAT_RGBA32_FLOAT, Width, Height);
+        for (size_t i = 0; i < RGBA8.size(); ++i)
+            EXPECT_EQ(RGBA8[i], static_cast<Uint8>(reinterpret_cast<const float*>(RGBA32.data())[i] * 255.f + 0.5f));
+    }
+
+    // R11 data is converted to 8 bits
+    {
+        const std::vector<Uint8> Blocks = GenerateRandomBlocks(ETC_FORMAT_EAC_R11_UNORM, Width, Height);
+        const std::vector<Uint8> R16    = Decompress(ETC_FORMAT_EAC_R11_UNORM, Blocks, TEX_FORMAT_R16_UNORM, Width, Height);
+        const std::vector<Uint8> R8     = Decompress(ETC_FORMAT_EAC_R11_UNORM, Blocks, TEX_FORMAT_R8_UNORM, Width, Height);
+        for (size_t i = 0; i < R8.size(); ++i)
+            EXPECT_NEAR(R8[i], reinterpret_cast<const Uint16*>(R16.data())[i] / 257.0, 0.51);
+    }
+
+    // Unsupported formats
+    std::vector<Uint8>       Blocks(8);
+    std::vector<Uint8>       Texels(64);
+    DecompressETCDataAttribs Attribs;
+    Attribs.Width     = 4;
+    Attribs.Height    = 4;
+    Attribs.SrcFormat = ETC_FORMAT_UNKNOWN;
+    Attribs.pSrcData  = Blocks.data();
+    Attribs.SrcStride = 8;
+    Attribs.DstFormat = TEX_FORMAT_RGBA8_UNORM;
+    Attribs.pDstData  = Texels.data();
+    Attribs.DstStride = 16;
+    EXPECT_FALSE(DecompressETCData(Attribs));
+
+    Attribs.SrcFormat = ETC_FORMAT_ETC2_RGB8;
+    Attribs.DstFormat = TEX_FORMAT_RGBA8_UINT;
+    EXPECT_FALSE(DecompressETCData(Attribs));
+
+    Attribs.DstFormat = TEX_FORMAT_BC6H_UF16;
+    EXPECT_FALSE(DecompressETCData(Attribs));
+}
+
+TEST(ETCDecompressionTest, TranscodeToBC7)
+{
+    constexpr Uint32 Width  = 30;
+    constexpr Uint32 Height = 22;
+
+    for (ETC_FORMAT Format : {ETC_FORMAT_ETC2_RGB8, ETC_FORMAT_ETC2_RGBA8_SRGB})
+    {
+        const bool IsSRGB = Format == ETC_FORMAT_ETC2_RGBA8_SRGB;
+
+        const TEXTURE_FORMAT TexelFormat = IsSRGB ? TEX_FORMAT_RGBA8_UNORM_SRGB : TEX_FORMAT_RGBA8_UNORM;
+        const TEXTURE_FORMAT BC7Format   = IsSRGB ? TEX_FORMAT_BC7_UNORM_SRGB : TEX_FORMAT_BC7_UNORM;
+
+        const std::vector<Uint8> Blocks = GenerateRandomBlocks(Format, Width, Height);
+        const std::vector<Uint8> Texels = Decompress(Format, Blocks, TexelFormat, Width, Height);
+        const std::vector<Uint8> BC7    = Decompress(Format, Blocks, BC7Format, Width, Height);
+
+        // Transcoding must be equivalent to compressing the decoded texels
+        std::vector<Uint8>         RefBC7(BC7.size());
+        CompressTextureDataAttribs Attribs;
+        Attribs.Width     = Width;
+        Attribs.Height    = Height;
+        Attribs.SrcFormat = TexelFormat;
+        Attribs.pSrcData  = Texels.data();
+        Attribs.SrcStride = Width * 4;
+        Attribs.DstFormat = BC7Format;
+        Attribs.pDstData  = RefBC7.data();
+        Attribs.DstStride = (Width + 3) / 4 * 16;
+        EXPECT_TRUE(CompressTextureData(Attribs));
+        EXPECT_EQ(BC7, RefBC7);
+    }
+}
+
+TEST(ETCDecompressionTest, Parallel)
+{
+    constexpr Uint32 Width  = 1021;
+    constexpr Uint32 Height = 70;
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_TRUE(pThreadPool);
+
+    for (ETC_FORMAT Format : {ETC_FORMAT_ETC2_RGB8, ETC_FORMAT_ETC2_RGB8A1, ETC_FORMAT_ETC2_RGBA8, ETC_FORMAT_EAC_RG11_SNORM})
+    {
+        const std::vector<Uint8> Blocks = GenerateRandomBlocks(Format, Width, Height);
+
+        const TEXTURE_FORMAT DstFormat = Format == ETC_FORMAT_EAC_RG11_SNORM ? TEX_FORMAT_RG16_SNORM : TEX_FORMAT_RGBA8_UNORM;
+        EXPECT_EQ(Decompress(Format, Blocks, DstFormat, Width, Height), Decompress(Format, Blocks, DstFormat, Width, Height, pThreadPool));
+    }
+}
+
+TEST(ETCDecompressionTest, FallbackFormat)
+{
+    EXPECT_EQ(GetETCFallbackFormat(ETC_FORMAT_ETC2_RGB8, nullptr), TEX_FORMAT_RGBA8_UNORM);
+    EXPECT_EQ(GetETCFallbackFormat(ETC_FORMAT_ETC2_RGB8A1, nullptr), TEX_FORMAT_RGBA8_UNORM);
+    EXPECT_EQ(GetETCFallbackFormat(ETC_FORMAT_ETC2_RGBA8_SRGB, nullptr), TEX_FORMAT_RGBA8_UNORM_SRGB);
+    EXPECT_EQ(GetETCFallbackFormat(ETC_FORMAT_EAC_R11_UNORM, nullptr), TEX_FORMAT_R16_UNORM);
+    EXPECT_EQ(GetETCFallbackFormat(ETC_FORMAT_EAC_R11_SNORM, nullptr), TEX_FORMAT_R16_SNORM);
+    EXPECT_EQ(GetETCFallbackFormat(ETC_FORMAT_EAC_RG11_UNORM, nullptr), TEX_FORMAT_RG16_UNORM);
+    EXPECT_EQ(GetETCFallbackFormat(ETC_FORMAT_EAC_RG11_SNORM, nullptr), TEX_FORMAT_RG16_SNORM);
+}
+
+} // namespace
@@ -0,0 +1,274 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ImageResampler.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "GraphicsAccessories.hpp"
+#include "ThreadPool.hpp"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr RESAMPLE_FILTER AllFilters[] = {
+    RESAMPLE_FILTER_BOX,
+    RESAMPLE_FILTER_BILINEAR,
+    RESAMPLE_FILTER_BICUBIC,
+    RESAMPLE_FILTER_LANCZOS,
+    RESAMPLE_FILTER_KAISER,
+};
+
+template <typename DstType, typename SrcType>
+std::vector<DstType> Resample(TEXTURE_FORMAT              SrcFormat,
+                              Uint32                      SrcWidth,
+                              Uint32                      SrcHeight,
+                              const std::vector<SrcType>& Src,
+                              TEXTURE_FORMAT              DstFormat,
+                              Uint32                      DstWidth,
+                              Uint32                      DstHeight,
+                              RESAMPLE_FILTER             Filter,
+                              IThreadPool*                pThreadPool = nullptr)
+{
+    const Uint32 SrcTexelSize = GetTextureFormatAttribs(SrcFormat).GetElementSize();
+    const Uint32 DstTexelSize = GetTextureFormatAttribs(DstFormat).GetElementSize();
+
+    std::vector<DstType> Dst(size_t{DstWidth} * DstHeight * DstTexelSize / sizeof(DstType));
+
+    ResampleImageAttribs Attribs;
+    Attribs.SrcWidth    = SrcWidth;
+    Attribs.SrcHeight   = SrcHeight;
+    Attribs.SrcFormat   = SrcFormat;
+    Attribs.pSrcData    = Src.data();
+    Attribs.SrcStride   = size_t{SrcWidth} * SrcTexelSize;
+    Attribs.DstWidth    = DstWidth;
+    Attribs.DstHeight   = DstHeight;
+    Attribs.DstFormat   = DstFormat;
+    Attribs.pDstData    = Dst.data();
+    Attribs.DstStride   = size_t{DstWidth} * DstTexelSize;
+    Attribs.Filter      = Filter;
+    Attribs.pThreadPool = pThreadPool;
+    EXPECT_TRUE(ResampleImage(Attribs));
+
+    return Dst;
+}
+
+std::vector<Uint8> GenerateImage(Uint32 Width, Uint32 Height, Uint32 NumComponents, unsigned int Seed)
+{
+    FastRandInt        Rnd{Seed, 0, 255};
+    std::vector<Uint8> Image(size_t{Width} * Height * NumComponents);
+    for (Uint8& Val : Image)
+        Val = static_cast<Uint8>(Rnd());
+    return Image;
+}
+
+TEST(ImageResamplerTest, SameSize)
+{
+    const std::vector<Uint8> Src = GenerateImage(19, 7, 4, 0);
+    for (RESAMPLE_FILTER Filter : AllFilters)
+    {
+        const auto Dst = Resample<Uint8>(TEX_FORMAT_RGBA8_UNORM, 19, 7, Src, TEX_FORMAT_RGBA8_UNORM, 19, 7, Filter);
+        EXPECT_EQ(Dst, Src) << "Filter " << Filter;
+
+        const auto DstFloat = Resample<float>(TEX_FORMAT_RGBA8_UNORM, 19, 7, Src, TEX_FORMAT_RGBA32_FLOAT, 19, 7, Filter);
+        ASSERT_EQ(DstFloat.size(), Src.size());
+        for (size_t i = 0; i < Src.size(); ++i)
+            EXPECT_FLOAT_EQ(DstFloat[i], static_cast<float>(Src[i]) / 255.f) << "Filter " << Filter;
+    }
+}
+
+TEST(ImageResamplerTest, SolidColor)
+{
+    std::vector<Uint8> Src(23 * 17 * 4);
+    for (size_t i = 0; i < Src.size(); i += 4)
+    {
+        Src[i + 0] = 10;
+        Src[i + 1] = 100;
+        Src[i + 2] = 200;
+        Src[i + 3] = 255;
+    }
+
+    const Uint32 Sizes[][2] = {{5, 3}, {11, 40}, {64, 64}, {1, 1}};
+    for (RESAMPLE_FILTER Filter : AllFilters)
+    {
+        for (const auto& Size : Sizes)
+        {
+            const auto Dst = Resample<Uint8>(TEX_FORMAT_RGBA8_UNORM_SRGB, 23, 17, Src, TEX_FORMAT_RGBA8_UNORM_SRGB, Size[0], Size[1], Filter);
+            for (size_t i = 0; i < Dst.size(); ++i)
+                EXPECT_EQ(Dst[i], Src[i % 4]) << "Filter " << Filter << ", size " << Size[0] << "x" << Size[1];
+        }
+    }
+}
+
+TEST(ImageResamplerTest, BoxMinification)
+{
+    // 6x1 -> 2x1: every destination texel is the average of three source texels
+    const std::vector<float> Src = {1, 2, 3, 4, 5, 6};
+
+    const auto Dst = Resample<float>(TEX_FORMAT_R32_FLOAT, 6, 1, Src, TEX_FORMAT_R32_FLOAT, 2, 1, RESAMPLE_FILTER_BOX);
+    ASSERT_EQ(Dst.size(), 2u);
+    EXPECT_FLOAT_EQ(Dst[0], 2);
+    EXPECT_FLOAT_EQ(Dst[1], 5);
+
+    // 5x1 -> 2x1: destination texels cover 2.5 source texels
+    const std::vector<float> Src5 = {1, 2, 3, 4, 5};
+
+    const auto Dst5 = Resample<float>(TEX_FORMAT_R32_FLOAT, 5, 1, Src5, TEX_FORMAT_R32_FLOAT, 2, 1, RESAMPLE_FILTER_BOX);
+    ASSERT_EQ(Dst5.size(), 2u);
+    EXPECT_FLOAT_EQ(Dst5[0], (1.f + 2.f + 3.f * 0.5f) / 2.5f);
+    EXPECT_FLOAT_EQ(Dst5[1], (3.f * 0.5f + 4.f + 5.f) / 2.5f);
+}
+
+TEST(ImageResamplerTest, Magnification)
+{
+    const std::vector<float> Src = {0, 1};
+
+    const auto Box = Resample<float>(TEX_FORMAT_R32_FLOAT, 2, 1, Src, TEX_FORMAT_R32_FLOAT, 4, 1, RESAMPLE_FILTER_BOX);
+    EXPECT_EQ(Box, (std::vector<float>{0, 0, 1, 1}));
+
+    const auto Bilinear = Resample<float>(TEX_FORMAT_R32_FLOAT, 2, 1, Src, TEX_FORMAT_R32_FLOAT, 4, 1, RESAMPLE_FILTER_BILINEAR);
+    ASSERT_EQ(Bilinear.size(), 4u);
+    EXPECT_FLOAT_EQ(Bilinear[0], 0);
+    EXPECT_FLOAT_EQ(Bilinear[1], 0.25f);
+    EXPECT_FLOAT_EQ(Bilinear[2], 0.75f);
+    EXPECT_FLOAT_EQ(Bilinear[3], 1);
+
+    // Catmull-Rom spline reproduces linear gradients
+    std::vector<float> Gradient(16);
+    for (size_t i = 0; i < Gradient.size(); ++i)
+        Gradient[i] = static_cast<float>(i);
+    const auto Bicubic = Resample<float>(TEX_FORMAT_R32_FLOAT, 16, 1, Gradient, TEX_FORMAT_R32_FLOAT, 48, 1, RESAMPLE_FILTER_BICUBIC);
+    ASSERT_EQ(Bicubic.size(), 48u);
+    for (Uint32 x = 6; x < 42; ++x)
+        EXPECT_NEAR(Bicubic[x], (static_cast<float>(x) + 0.5f) / 3.f - 0.5f, 1e-4f) << x;
+}
+
+TEST(ImageResamplerTest, FormatConversion)
+{
+    const std::vector<Uint8> Src = GenerateImage(30, 20, 4, 1);
+
+    // BGRA8 -> RGBA32F must match RGBA8 -> RGBA8 up to quantization
+    std::vector<Uint8> SrcBGRA = Src;
+    for (size_t i = 0; i < SrcBGRA.size(); i += 4)
+        std::swap(SrcBGRA[i], SrcBGRA[i + 2]);
+
+    const auto Ref = Resample<Uint8>(TEX_FORMAT_RGBA8_UNORM, 30, 20, Src, TEX_FORMAT_RGBA8_UNORM, 13, 9, RESAMPLE_FILTER_LANCZOS);
+    const auto Dst = Resample<float>(TEX_FORMAT_BGRA8_UNORM, 30, 20, SrcBGRA, TEX_FORMAT_RGBA32_FLOAT, 13, 9, RESAMPLE_FILTER_LANCZOS);
+    ASSERT_EQ(Ref.size(), Dst.size());
+    for (size_t i = 0; i < Ref.size(); ++i)
+        EXPECT_NEAR(std::min(std::max(Dst[i], 0.f), 1.f) * 255.f, static_cast<float>(Ref[i]), 0.5f + 1e-3f) << i;
+
+    // Single-channel formats
+    const std::vector<Uint8> SrcR8 = GenerateImage(30, 20, 1, 2);
+    const auto               DstR8 = Resample<Uint8>(TEX_FORMAT_R8_UNORM, 30, 20, SrcR8, TEX_FORMAT_R8_UNORM, 10, 10, RESAMPLE_FILTER_BOX);
+    ASSERT_EQ(DstR8.size(), 100u);
+    // Destination texel (0, 0) covers 3x2 source texels
+    float Sum = 0;
+    for (Uint32 y = 0; y < 2; ++y)
+    {
+        for (Uint32 x = 0; x < 3; ++x)
+            Sum += SrcR8[y * 30 + x];
+    }
+    EXPECT_NEAR(DstR8[0], Sum / 6.f, 0.5f + 1e-3f);
+}
+
+TEST(ImageResamplerTest, GammaCorrect)
+{
+    // Black and white texels
+    const std::vector<Uint8> Src = {0, 0, 0, 255, 255, 255, 255, 255};
+
+    ResampleImageAttribs Attribs;
+    Attribs.SrcWidth  = 2;
+    Attribs.SrcHeight = 1;
+    Attribs.SrcFormat = TEX_FORMAT_RGBA8_UNORM_SRGB;
+    Attribs.pSrcData  = Src.data();
+    Attribs.SrcStride = 8;
+    Attribs.DstWidth  = 1;
+    Attribs.DstHeight = 1;
+    Attribs.DstFormat = TEX_FORMAT_RGBA8_UNORM_SRGB;
+    Attribs.Filter    = RESAMPLE_FILTER_BOX;
+
+    Uint8 Dst[4]      = {};
+    Attribs.pDstData  = Dst;
+    Attribs.DstStride = 4;
+    EXPECT_TRUE(ResampleImage(Attribs));
+    // Linear 0.5 is encoded as 188
+    EXPECT_EQ(Dst[0], 188);
+    EXPECT_EQ(Dst[3], 255);
+
+    Attribs.GammaCorrect = false;
+    EXPECT_TRUE(ResampleImage(Attribs));
+    EXPECT_EQ(Dst[0], 128);
+    EXPECT_EQ(Dst[3], 255);
+}
+
+TEST(ImageResamplerTest, Parallel)
+{
+    const std::vector<Uint8> Src = GenerateImage(640, 480, 4, 3);
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    for (RESAMPLE_FILTER Filter : AllFilters)
+    {
+        const auto Serial   = Resample<Uint8>(TEX_FORMAT_RGBA8_UNORM_SRGB, 640, 480, Src, TEX_FORMAT_RGBA8_UNORM_SRGB, 1000, 300, Filter);
+        const auto Parallel = Resample<Uint8>(TEX_FORMAT_RGBA8_UNORM_SRGB, 640, 480, Src, TEX_FORMAT_RGBA8_UNORM_SRGB, 1000, 300, Filter, pThreadPool);
+        EXPECT_EQ(Serial, Parallel) << "Filter " << Filter;
+    }
+}
+
+TEST(ImageResamplerTest, UnsupportedFormats)
+{
+    EXPECT_TRUE(IsImageResamplingSupported(TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM));
+    EXPECT_TRUE(IsImageResamplingSupported(TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_RGBA16_FLOAT));
+    EXPECT_TRUE(IsImageResamplingSupported(TEX_FORMAT_R32_FLOAT, TEX_FORMAT_RGBA32_FLOAT));
+    EXPECT_FALSE(IsImageResamplingSupported(TEX_FORMAT_RGBA8_UINT, TEX_FORMAT_RGBA8_UNORM));
+    EXPECT_FALSE(IsImageResamplingSupported(TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_R32_SINT));
+    EXPECT_FALSE(IsImageResamplingSupported(TEX_FORMAT_BC1_UNORM, TEX_FORMAT_RGBA8_UNORM));
+    EXPECT_FALSE(IsImageResamplingSupported(TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_TYPELESS));
+
+    std::vector<Uint8>   Src(16 * 16 * 4);
+    std::vector<Uint8>   Dst(8 * 8 * 4);
+    ResampleImageAttribs Attribs;
+    Attribs.SrcWidth  = 16;
+    Attribs.SrcHeight = 16;
+    Attribs.SrcFormat = TEX_FORMAT_RGBA8_UINT;
+    Attribs.pSrcData  = Src.data();
+    Attribs.SrcStride = 16 * 4;
+    Attribs.DstWidth  = 8;
+    Attribs.DstHeight = 8;
+    Attribs.DstFormat = TEX_FORMAT_RGBA8_UINT;
+    Attribs.pDstData  = Dst.data();
+    Attribs.DstStride = 8 * 4;
+    EXPECT_FALSE(ResampleImage(Attribs));
+}
+
+} // namespace
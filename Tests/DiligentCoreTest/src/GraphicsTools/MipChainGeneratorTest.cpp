@@ -0,0 +1,345 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "MipChainGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "GraphicsAccessories.hpp"
+#include "ColorConversion.h"
+#include "ThreadPool.hpp"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+template <typename T>
+std::vector<std::vector<T>> ComputeChain(TEXTURE_FORMAT        Format,
+                                         Uint32                Width,
+                                         Uint32                Height,
+                                         const std::vector<T>& Src,
+                                         MIP_CHAIN_FILTER      Filter,
+                                         bool                  GammaCorrect = true,
+                                         float                 AlphaCutoff  = 0,
+                                         IThreadPool*          pThreadPool  = nullptr)
+{
+    const Uint32 TexelSize = GetTextureFormatAttribs(Format).GetElementSize();
+
+    const Uint32 NumMipLevels = ComputeMipLevelsCount(Width, Height) - 1;
+
+    std::vector<std::vector<T>> Levels(NumMipLevels);
+    std::vector<MipLevelData>   MipData(NumMipLevels);
+    for (Uint32 Mip = 1; Mip <= NumMipLevels; ++Mip)
+    {
+        const Uint32 MipWidth  = std::max(Width >> Mip, 1u);
+        const Uint32 MipHeight = std::max(Height >> Mip, 1u);
+        Levels[Mip - 1].resize(size_t{MipWidth} * MipHeight * TexelSize / sizeof(T));
+        MipData[Mip - 1].pData  = Levels[Mip - 1].data();
+        MipData[Mip - 1].Stride = size_t{MipWidth} * TexelSize;
+    }
+
+    ComputeMipChainAttribs Attribs;
+    Attribs.Format       = Format;
+    Attribs.Width        = Width;
+    Attribs.Height       = Height;
+    Attribs.pSrcData     = Src.data();
+    Attribs.SrcStride    = size_t{Width} * TexelSize;
+    Attribs.NumMipLevels = NumMipLevels;
+    Attribs.pMipLevels   = MipData.data();
+    Attribs.Filter       = Filter;
+    Attribs.GammaCorrect = GammaCorrect;
+    Attribs.AlphaCutoff  = AlphaCutoff;
+    Attribs.pThreadPool  = pThreadPool;
+    EXPECT_TRUE(ComputeMipChain(Attribs));
+
+    return Levels;
+}
+
+std::vector<float> GenerateFloatImage(Uint32 Width, Uint32 Height, unsigned int Seed)
+{
+    FastRandFloat      Rnd{Seed, 0, 1};
+    std::vector<float> Image(size_t{Width} * Height * 4);
+    for (float& Val : Image)
+        Val = Rnd();
+    return Image;
+}
+
+TEST(MipChainGeneratorTest, BoxEvenSize)
+{
+    constexpr Uint32         Width  = 16;
+    constexpr Uint32         Height = 8;
+    const std::vector<float> Src    = GenerateFloatImage(Width, Height, 0);
+
+    const auto Levels = ComputeChain(TEX_FORMAT_RGBA32_FLOAT, Width, Height, Src, MIP_CHAIN_FILTER_BOX);
+    ASSERT_EQ(Levels.size(), 4u);
+
+    // Every level of a power-of-two texture is the 2x2 average of the previous level
+    const std::vector<float>* pFine = &Src;
+    for (Uint32 Mip = 1; Mip <= Levels.size(); ++Mip)
+    {
+        const Uint32 FineWidth  = std::max(Width >> (Mip - 1), 1u);
+        const Uint32 FineHeight = std::max(Height >> (Mip - 1), 1u);
+        const Uint32 MipWidth   = std::max(Width >> Mip, 1u);
+        const Uint32 MipHeight  = std::max(Height >> Mip, 1u);
+
+        const auto& Coarse = Levels[Mip - 1];
+        for (Uint32 y = 0; y < MipHeight; ++y)
+        {
+            for (Uint32 x = 0; x < MipWidth; ++x)
+            {
+                for (Uint32 c = 0; c < 4; ++c)
+                {
+                    const Uint32 x0 = std::min(x * 2, FineWidth - 1), x1 = std::min(x * 2 + 1, FineWidth - 1);
+                    const Uint32 y0 = std::min(y * 2, FineHeight - 1), y1 = std::min(y * 2 + 1, FineHeight - 1);
+
+                    const auto Fine = [&](Uint32 fx, Uint32 fy) {
+                        return (*pFine)[(fy * FineWidth + fx) * 4 + c];
+                    };
+                    const float Ref = (Fine(x0, y0) + Fine(x1, y0) + Fine(x0, y1) + Fine(x1, y1)) * 0.25f;
+                    EXPECT_NEAR(Coarse[(y * MipWidth + x) * 4 + c], Ref, 1e-5f) << "Mip " << Mip << " (" << x << ", " << y << ")";
+                }
+            }
+        }
+        pFine = &Coarse;
+    }
+}
+
+TEST(MipChainGeneratorTest, BoxOddSize)
+{
+    // 3x1 texture: the coarse texel covers 1.5 fine texels on each side
+    const std::vector<float> Src = {
+        0,
+        0,
+        0,
+        0,
+        1,
+        1,
+        1,
+        1,
+        3,
+        3,
+        3,
+        3,
+    };
+
+    const auto Levels = ComputeChain(TEX_FORMAT_RGBA32_FLOAT, 3, 1, Src, MIP_CHAIN_FILTER_BOX);
+    ASSERT_EQ(Levels.size(), 1u);
+    for (Uint32 c = 0; c < 4; ++c)
+        EXPECT_NEAR(Levels[0][c], 4.f / 3.f, 1e-5f);
+
+    // 5x5 texture: coarse texel (0, 0) covers fine texels [0, 2.5) in both directions
+    std::vector<float> Src5(5 * 5 * 4);
+    for (Uint32 y = 0; y < 5; ++y)
+    {
+        for (Uint32 x = 0; x < 5; ++x)
+        {
+            for (Uint32 c = 0; c < 4; ++c)
+                Src5[(y * 5 + x) * 4 + c] = static_cast<float>(x);
+        }
+    }
+    const auto Levels5 = ComputeChain(TEX_FORMAT_RGBA32_FLOAT, 5, 5, Src5, MIP_CHAIN_FILTER_BOX);
+    ASSERT_EQ(Levels5.size(), 2u);
+    ASSERT_EQ(Levels5[0].size(), 2u * 2u * 4u);
+    EXPECT_NEAR(Levels5[0][0], (0.f + 1.f + 2.f * 0.5f) / 2.5f, 1e-5f);
+    EXPECT_NEAR(Levels5[0][4], (2.f * 0.5f + 3.f + 4.f) / 2.5f, 1e-5f);
+    EXPECT_NEAR(Levels5[1][0], 2.f, 1e-5f);
+}
+
+TEST(MipChainGeneratorTest, SolidColor)
+{
+    constexpr Uint32   Width  = 37;
+    constexpr Uint32   Height = 20;
+    std::vector<Uint8> Src(size_t{Width} * Height * 4);
+    for (size_t i = 0; i < Src.size(); i += 4)
+    {
+        Src[i + 0] = 10;
+        Src[i + 1] = 100;
+        Src[i + 2] = 200;
+        Src[i + 3] = 255;
+    }
+
+    for (MIP_CHAIN_FILTER Filter : {MIP_CHAIN_FILTER_BOX, MIP_CHAIN_FILTER_KAISER, MIP_CHAIN_FILTER_LANCZOS})
+    {
+        for (TEXTURE_FORMAT Format : {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB})
+        {
+            const auto Levels = ComputeChain(Format, Width, Height, Src, Filter);
+            ASSERT_EQ(Levels.size(), 5u);
+            for (const auto& Level : Levels)
+            {
+                for (size_t i = 0; i < Level.size(); ++i)
+                    EXPECT_EQ(Level[i], Src[i % 4]) << "Filter " << Filter << " format " << Format;
+            }
+        }
+    }
+}
+
+TEST(MipChainGeneratorTest, SharpFilters)
+{
+    // Kaiser and Lanczos filters must preserve linear gradients away from the edges
+    // and approximate the box filter on average.
+    constexpr Uint32   Width  = 32;
+    constexpr Uint32   Height = 4;
+    std::vector<float> Src(size_t{Width} * Height * 4);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            for (Uint32 c = 0; c < 4; ++c)
+                Src[(y * Width + x) * 4 + c] = static_cast<float>(x);
+        }
+    }
+
+    for (MIP_CHAIN_FILTER Filter : {MIP_CHAIN_FILTER_KAISER, MIP_CHAIN_FILTER_LANCZOS})
+    {
+        const auto Levels = ComputeChain(TEX_FORMAT_RGBA32_FLOAT, Width, Height, Src, Filter);
+        ASSERT_EQ(Levels.size(), 5u);
+        // Mip 1 is 16x2
+        for (Uint32 x = 3; x < 13; ++x)
+            EXPECT_NEAR(Levels[0][x * 4], x * 2.f + 0.5f, 1e-2f) << "Filter " << Filter << " x " << x;
+    }
+}
+
+TEST(MipChainGeneratorTest, GammaCorrect)
+{
+    // Checkerboard of black and white texels
+    constexpr Uint32   Width  = 8;
+    constexpr Uint32   Height = 8;
+    std::vector<Uint8> Src(size_t{Width} * Height * 4);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            const Uint8 Val = ((x + y) & 0x01) ? 255 : 0;
+            for (Uint32 c = 0; c < 4; ++c)
+                Src[(y * Width + x) * 4 + c] = Val;
+        }
+    }
+
+    // Linear average of black and white is 0.5, which is encoded as 188
+    const float Half   = 0.5f;
+    Uint8       Linear = 0;
+    LinearToGamma(&Half, &Linear, 1);
+    const auto Levels = ComputeChain(TEX_FORMAT_RGBA8_UNORM_SRGB, Width, Height, Src, MIP_CHAIN_FILTER_BOX, true);
+    for (const auto& Level : Levels)
+    {
+        for (size_t i = 0; i < Level.size(); ++i)
+            EXPECT_EQ(Level[i], (i % 4) == 3 ? 128 : Linear);
+    }
+
+    const auto GammaLevels = ComputeChain(TEX_FORMAT_RGBA8_UNORM_SRGB, Width, Height, Src, MIP_CHAIN_FILTER_BOX, false);
+    for (const auto& Level : GammaLevels)
+    {
+        for (size_t i = 0; i < Level.size(); ++i)
+            EXPECT_EQ(Level[i], 128);
+    }
+}
+
+TEST(MipChainGeneratorTest, AlphaCoverage)
+{
+    // Mostly transparent noise whose coverage collapses with averaging
+    constexpr Uint32   Width  = 64;
+    constexpr Uint32   Height = 64;
+    constexpr float    Cutoff = 0.5f;
+    std::vector<float> Src(size_t{Width} * Height * 4);
+    FastRandFloat      Rnd{1, 0, 1};
+    for (size_t i = 0; i < Src.size(); i += 4)
+    {
+        Src[i + 0] = Src[i + 1] = Src[i + 2] = 1;
+        Src[i + 3]                           = std::pow(Rnd(), 3.f);
+    }
+
+    auto ComputeCoverage = [](const std::vector<float>& Level, float AlphaCutoff) {
+        size_t NumCovered = 0;
+        for (size_t i = 3; i < Level.size(); i += 4)
+            NumCovered += Level[i] > AlphaCutoff ? 1 : 0;
+        return static_cast<float>(NumCovered) / static_cast<float>(Level.size() / 4);
+    };
+    const float SrcCoverage = ComputeCoverage(Src, Cutoff);
+
+    const auto Levels         = ComputeChain(TEX_FORMAT_RGBA32_FLOAT, Width, Height, Src, MIP_CHAIN_FILTER_BOX, true, 0.f);
+    const auto ScaledLevels   = ComputeChain(TEX_FORMAT_RGBA32_FLOAT, Width, Height, Src, MIP_CHAIN_FILTER_BOX, true, Cutoff);
+    const auto KaiserLevels   = ComputeChain(TEX_FORMAT_RGBA32_FLOAT, Width, Height, Src, MIP_CHAIN_FILTER_KAISER, true, Cutoff);
+    const auto UnscaledRegion = ComputeCoverage(Levels[2], Cutoff);
+    // Without scaling, the coverage of the 8x8 level collapses
+    EXPECT_LT(UnscaledRegion, SrcCoverage * 0.5f);
+
+    for (size_t Mip = 0; Mip < 4; ++Mip)
+    {
+        const float Tolerance = 1.5f / static_cast<float>(ScaledLevels[Mip].size() / 4);
+        EXPECT_NEAR(ComputeCoverage(ScaledLevels[Mip], Cutoff), SrcCoverage, Tolerance) << "Mip " << Mip + 1;
+        EXPECT_NEAR(ComputeCoverage(KaiserLevels[Mip], Cutoff), SrcCoverage, Tolerance) << "Mip " << Mip + 1;
+        for (size_t i = 3; i < ScaledLevels[Mip].size(); i += 4)
+            EXPECT_LE(ScaledLevels[Mip][i], 1.f);
+    }
+}
+
+TEST(MipChainGeneratorTest, Parallel)
+{
+    constexpr Uint32   Width  = 1024;
+    constexpr Uint32   Height = 300;
+    std::vector<Uint8> Src(size_t{Width} * Height * 4);
+    FastRandInt        Rnd{2, 0, 255};
+    for (Uint8& Val : Src)
+        Val = static_cast<Uint8>(Rnd());
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    for (MIP_CHAIN_FILTER Filter : {MIP_CHAIN_FILTER_BOX, MIP_CHAIN_FILTER_LANCZOS})
+    {
+        const auto Serial   = ComputeChain(TEX_FORMAT_RGBA8_UNORM_SRGB, Width, Height, Src, Filter, true, 0.5f);
+        const auto Parallel = ComputeChain(TEX_FORMAT_RGBA8_UNORM_SRGB, Width, Height, Src, Filter, true, 0.5f, pThreadPool);
+        EXPECT_EQ(Serial, Parallel) << "Filter " << Filter;
+    }
+}
+
+TEST(MipChainGeneratorTest, UnsupportedFormats)
+{
+    std::vector<Uint8>        Src(64 * 64 * 16);
+    std::vector<Uint8>        Dst(32 * 32 * 16);
+    std::vector<MipLevelData> MipData(1);
+    MipData[0].pData  = Dst.data();
+    MipData[0].Stride = 32 * 16;
+
+    for (TEXTURE_FORMAT Format : {TEX_FORMAT_RGBA8_UINT, TEX_FORMAT_R32_SINT, TEX_FORMAT_BC1_UNORM, TEX_FORMAT_RGBA8_TYPELESS})
+    {
+        ComputeMipChainAttribs Attribs;
+        Attribs.Format       = Format;
+        Attribs.Width        = 64;
+        Attribs.Height       = 64;
+        Attribs.pSrcData     = Src.data();
+        Attribs.SrcStride    = 64 * 16;
+        Attribs.NumMipLevels = 1;
+        Attribs.pMipLevels   = MipData.data();
+        EXPECT_FALSE(ComputeMipChain(Attribs)) << GetTextureFormatAttribs(Format).Name;
+    }
+}
+
+} // namespace
@@ -0,0 +1,302 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "PlatformDefinitions.h"
+
+#if PLATFORM_LINUX
+
+#    include <vector>
+#    include <algorithm>
+#    include <chrono>
+#    include <thread>
+#    include <set>
+
+#    include <dirent.h>
+#    include <fcntl.h>
+#    include <unistd.h>
+
+#    include "gtest/gtest.h"
+
+#    include "LinuxAsyncFileReader.hpp"
+#    include "FileSystem.hpp"
+#    include "FileWrapper.hpp"
+#    include "FastRand.hpp"
+#    include "TempDirectory.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+void TestAsyncFileReader(bool ForceThreadFallback, Uint32 QueueDepth)
+{
+    TempDirectory TmpDir;
+    const auto&   TmpDirPath = TmpDir.Get();
+
+    constexpr Uint32 NumFiles = 37;
+
+    std::vector<std::vector<Uint8>> RefData(NumFiles);
+    std::vector<std::string>        FilePaths(NumFiles);
+
+    FastRandInt rnd{0, 0, 255};
+    for (Uint32 i = 0; i < NumFiles; ++i)
+    {
+        // Include an empty file and a file that is larger than a typical page
+        RefData[i].resize(i == 0 ? 0 : (i * 7919) % 100000 + i);
+        for (auto& Byte : RefData[i])
+            Byte = static_cast<Uint8>(rnd());
+
+        FilePaths[i] = TmpDirPath + FileSystem::SlashSymbol + "AsyncFile" + std::to_string(i) + ".bin";
+        FileWrapper File{FilePaths[i].c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        if (!RefData[i].empty())
+        {
+            EXPECT_TRUE(File->Write(RefData[i].data(), RefData[i].size()));
+        }
+    }
+
+    AsyncFileReaderCreateInfo CI;
+    CI.QueueDepth          = QueueDepth;
+    CI.NumFallbackThreads  = 3;
+    CI.ForceThreadFallback = ForceThreadFallback;
+    LinuxAsyncFileReader Reader{CI};
+    if (ForceThreadFallback)
+    {
+        EXPECT_FALSE(Reader.IsUsingIOUring());
+    }
+
+    std::vector<AsyncFileReadRequest> Requests(NumFiles);
+    for (Uint32 i = 0; i < NumFiles; ++i)
+    {
+        Requests[i].FilePath = FilePaths[i].c_str();
+        Requests[i].UserData = i;
+    }
+
+    // Partial read from an offset
+    const Uint32 PartialFile = NumFiles - 1;
+    {
+        AsyncFileReadRequest Request;
+        Request.FilePath = FilePaths[PartialFile].c_str();
+        Request.Offset   = 100;
+        Request.Size     = 1000;
+        Request.UserData = NumFiles;
+        Requests.push_back(Request);
+    }
+
+    // Read past the end of the file
+    {
+        AsyncFileReadRequest Request;
+        Request.FilePath = FilePaths[1].c_str();
+        Request.Offset   = 1;
+        Request.Size     = RefData[1].size() + 100;
+        Request.UserData = NumFiles + 1;
+        Requests.push_back(Request);
+    }
+
+    // Missing file
+    const auto MissingPath = TmpDirPath + FileSystem::SlashSymbol + "Missing.bin";
+    {
+        AsyncFileReadRequest Request;
+        Request.FilePath = MissingPath.c_str();
+        Request.UserData = NumFiles + 2;
+        Requests.push_back(Request);
+    }
+
+    Reader.Submit(Requests.data(), Requests.size() / 2);
+    Reader.Submit(Requests.data() + Requests.size() / 2, Requests.size() - Requests.size() / 2);
+    EXPECT_LE(Reader.GetNumPendingRequests(), Requests.size());
+
+    std::vector<AsyncFileReadResult> Results;
+    Reader.Poll(Results);
+    Reader.Wait(Results, 5);
+    EXPECT_GE(Results.size(), std::min(size_t{5}, Requests.size()));
+    Reader.WaitAll(Results);
+    EXPECT_EQ(Reader.GetNumPendingRequests(), size_t{0});
+    ASSERT_EQ(Results.size(), Requests.size());
+
+    std::sort(Results.begin(), Results.end(), [](const AsyncFileReadResult& R0, const AsyncFileReadResult& R1) { return R0.UserData < R1.UserData; });
+    for (Uint32 i = 0; i < NumFiles; ++i)
+    {
+        EXPECT_TRUE(Results[i].Succeeded()) << FilePaths[i];
+        EXPECT_EQ(Results[i].FilePath, FilePaths[i]);
+        EXPECT_EQ(Results[i].Data, RefData[i]) << FilePaths[i];
+    }
+
+    {
+        const auto& Result = Results[NumFiles];
+        EXPECT_TRUE(Result.Succeeded());
+        const auto& Ref = RefData[PartialFile];
+        EXPECT_EQ(Result.Data, std::vector<Uint8>(Ref.begin() + 100, Ref.begin() + 1100));
+    }
+
+    {
+        const auto& Result = Results[NumFiles + 1];
+        EXPECT_TRUE(Result.Succeeded());
+        EXPECT_EQ(Result.Data, std::vector<Uint8>(RefData[1].begin() + 1, RefData[1].end()));
+    }
+
+    {
+        const auto& Result = Results[NumFiles + 2];
+        EXPECT_FALSE(Result.Succeeded());
+        EXPECT_TRUE(Result.Data.empty());
+    }
+
+    Results.clear();
+    EXPECT_EQ(Reader.Poll(Results), size_t{0});
+    EXPECT_EQ(Reader.Wait(Results), size_t{0});
+}
+
+// Destroys the reader while completed reads have not been collected yet
+void TestDestroyWithUncollectedReads(bool ForceThreadFallback)
+{
+    TempDirectory TmpDir;
+
+    const auto         FilePath = TmpDir.Get() + FileSystem::SlashSymbol + "AsyncFile.bin";
+    std::vector<Uint8> Data(4096, Uint8{42});
+    {
+        FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        EXPECT_TRUE(File->Write(Data.data(), Data.size()));
+    }
+
+    AsyncFileReaderCreateInfo CI;
+    CI.ForceThreadFallback = ForceThreadFallback;
+    LinuxAsyncFileReader Reader{CI};
+
+    std::vector<AsyncFileReadRequest> Requests(8);
+    for (auto& Request : Requests)
+        Request.FilePath = FilePath.c_str();
+    Reader.Submit(Requests.data(), Requests.size());
+
+    // Let the reads complete without reaping them
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+}
+
+// Returns the descriptors of all io_uring instances open in the process
+std::set<int> GetIOUringDescriptors()
+{
+    std::set<int> Fds;
+    if (DIR* pDir = opendir("/proc/self/fd"))
+    {
+        while (const dirent* pEntry = readdir(pDir))
+        {
+            const auto Path = std::string{"/proc/self/fd/"} + pEntry->d_name;
+
+            char          Target[64] = {};
+            const ssize_t Len        = readlink(Path.c_str(), Target, sizeof(Target) - 1);
+            if (Len > 0 && std::string{Target, static_cast<size_t>(Len)} == "anon_inode:[io_uring]")
+                Fds.insert(std::stoi(pEntry->d_name));
+        }
+        closedir(pDir);
+    }
+    return Fds;
+}
+
+TEST(Platforms_LinuxAsyncFileReader, IOUring)
+{
+    TestAsyncFileReader(false, 64);
+}
+
+TEST(Platforms_LinuxAsyncFileReader, IOUring_SmallQueue)
+{
+    TestAsyncFileReader(false, 2);
+}
+
+TEST(Platforms_LinuxAsyncFileReader, ThreadFallback)
+{
+    TestAsyncFileReader(true, 64);
+}
+
+TEST(Platforms_LinuxAsyncFileReader, IOUring_DestroyWithUncollectedReads)
+{
+    TestDestroyWithUncollectedReads(false);
+}
+
+TEST(Platforms_LinuxAsyncFileReader, ThreadFallback_DestroyWithUncollectedReads)
+{
+    TestDestroyWithUncollectedReads(true);
+}
+
+TEST(Platforms_LinuxAsyncFileReader, IOUring_SubmitFailure)
+{
+    TempDirectory TmpDir;
+
+    const auto         FilePath = TmpDir.Get() + FileSystem::SlashSymbol + "AsyncFile.bin";
+    std::vector<Uint8> Data(4096, Uint8{42});
+    {
+        FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        EXPECT_TRUE(File->Write(Data.data(), Data.size()));
+    }
+
+    const auto FdsBefore = GetIOUringDescriptors();
+
+    AsyncFileReaderCreateInfo CI;
+    CI.QueueDepth = 4;
+    LinuxAsyncFileReader Reader{CI};
+    if (!Reader.IsUsingIOUring())
+        GTEST_SKIP() << "io_uring is not available";
+
+    int RingFd = -1;
+    for (int Fd : GetIOUringDescriptors())
+    {
+        if (FdsBefore.find(Fd) == FdsBefore.end())
+            RingFd = Fd;
+    }
+    ASSERT_GE(RingFd, 0);
+
+    // Replace the ring descriptor with a regular file, so that io_uring_enter fails with
+    // a non-retryable error while the rings remain mapped.
+    const int NullFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    ASSERT_GE(NullFd, 0);
+    ASSERT_EQ(dup2(NullFd, RingFd), RingFd);
+    close(NullFd);
+
+    std::vector<AsyncFileReadRequest> Requests(10);
+    for (size_t i = 0; i < Requests.size(); ++i)
+    {
+        Requests[i].FilePath = FilePath.c_str();
+        Requests[i].UserData = i;
+    }
+    Reader.Submit(Requests.data(), Requests.size());
+
+    // All requests must complete with an error rather than block forever
+    std::vector<AsyncFileReadResult> Results;
+    EXPECT_EQ(Reader.WaitAll(Results), Requests.size());
+    EXPECT_EQ(Reader.GetNumPendingRequests(), size_t{0});
+    ASSERT_EQ(Results.size(), Requests.size());
+    for (const auto& Result : Results)
+    {
+        EXPECT_FALSE(Result.Succeeded());
+        EXPECT_TRUE(Result.Data.empty());
+    }
+}
+
+} // namespace
+
+#endif // PLATFORM_LINUX